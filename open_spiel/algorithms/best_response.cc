@@ -14,11 +14,15 @@
 
 #include "open_spiel/algorithms/best_response.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <map>
 #include <unordered_set>
 
 #include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/get_legal_actions_map.h"
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -38,7 +42,8 @@ TabularBestResponse::TabularBestResponse(const Game& game,
       infosets_(GetAllInfoSets(game.NewInitialState(), best_responder, policy,
                                &tree_)),
       root_(game.NewInitialState()),
-      dummy_policy_(new TabularPolicy(GetUniformPolicy(game))) {
+      dummy_policy_(new TabularPolicy(
+          UniformPolicyFromIndex(*GetLegalActionsIndex(game)))) {
   if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
@@ -55,7 +60,27 @@ TabularBestResponse::TabularBestResponse(
       infosets_(GetAllInfoSets(game.NewInitialState(), best_responder, policy_,
                                &tree_)),
       root_(game.NewInitialState()),
-      dummy_policy_(new TabularPolicy(GetUniformPolicy(game))) {
+      dummy_policy_(new TabularPolicy(
+          UniformPolicyFromIndex(*GetLegalActionsIndex(game)))) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("The game must be turn-based.");
+  }
+}
+
+TabularBestResponse::TabularBestResponse(const Game& game,
+                                         Player best_responder,
+                                         const Policy* policy,
+                                         const SharedGameTree& shared_tree)
+    : best_responder_(best_responder),
+      tabular_policy_container_(),
+      policy_(policy),
+      tree_(HistoryTree(shared_tree, best_responder_)),
+      num_players_(game.NumPlayers()),
+      infosets_(GetAllInfoSets(game.NewInitialState(), best_responder, policy,
+                               &tree_)),
+      root_(game.NewInitialState()),
+      dummy_policy_(new TabularPolicy(
+          UniformPolicyFromIndex(*GetLegalActionsIndex(game)))) {
   if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
@@ -73,7 +98,7 @@ double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
     Action action = BestResponseAction(node->GetInfoState());
     HistoryNode* child = node->GetChild(action).second;
     if (child == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
-    return Value(child->GetHistory());
+    return Value(child);
   }
   // If the other player is playing, then we can recursively compute the
   // expected utility of that node by looking at their policy.
@@ -120,7 +145,7 @@ double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
     // Finally, we update value by the policy weighted value of the child.
     const double prob = GetProb(state_policy, action);
     SPIEL_CHECK_GE(prob, 0);
-    value += prob * Value(child->GetHistory());
+    value += prob * Value(child);
   }
   return value;
 }
@@ -138,7 +163,7 @@ double TabularBestResponse::HandleChanceCase(HistoryNode* node) {
     // Verify that the probability is valid. This should always be true.
     SPIEL_CHECK_GE(prob, 0.);
     SPIEL_CHECK_LE(prob, 1.);
-    value += prob * Value(child->GetHistory());
+    value += prob * Value(child);
   }
 
   // Verify that the sum of the probabilities is 1, within tolerance.
@@ -146,11 +171,68 @@ double TabularBestResponse::HandleChanceCase(HistoryNode* node) {
   return value;
 }
 
+std::pair<double, double> TabularBestResponse::SubtreeBounds(
+    HistoryNode* node) {
+  auto it = bounds_cache_.find(node->GetHistoryId());
+  if (it != bounds_cache_.end()) return it->second;
+  std::pair<double, double> bounds;
+  switch (node->GetType()) {
+    case StateType::kTerminal: {
+      const double value = node->GetValue();
+      bounds = {value, value};
+      break;
+    }
+    case StateType::kChance: {
+      // Chance probabilities are fixed, so the mixture of the child bounds
+      // holds under any policy.
+      double lower = 0;
+      double upper = 0;
+      for (const auto& action : node->GetChildActions()) {
+        std::pair<double, HistoryNode*> prob_and_child = node->GetChild(action);
+        if (prob_and_child.second == nullptr)
+          SpielFatalError("SubtreeBounds: child is null.");
+        const std::pair<double, double> child =
+            SubtreeBounds(prob_and_child.second);
+        lower += prob_and_child.first * child.first;
+        upper += prob_and_child.first * child.second;
+      }
+      bounds = {lower, upper};
+      break;
+    }
+    case StateType::kDecision: {
+      // The responder picks the best child, so it is guaranteed at least
+      // the best of the child lower bounds; any other player's mixture
+      // can realize as little as the worst of them.
+      const bool responder_node =
+          node->GetState()->CurrentPlayer() == best_responder_;
+      double lower = responder_node ? -std::numeric_limits<double>::infinity()
+                                    : std::numeric_limits<double>::infinity();
+      double upper = -std::numeric_limits<double>::infinity();
+      for (const auto& action : node->GetChildActions()) {
+        HistoryNode* child = node->GetChild(action).second;
+        if (child == nullptr) SpielFatalError("SubtreeBounds: child is null.");
+        const std::pair<double, double> child_bounds = SubtreeBounds(child);
+        lower = responder_node ? std::max(lower, child_bounds.first)
+                               : std::min(lower, child_bounds.first);
+        upper = std::max(upper, child_bounds.second);
+      }
+      bounds = {lower, upper};
+      break;
+    }
+  }
+  bounds_cache_[node->GetHistoryId()] = bounds;
+  return bounds;
+}
+
 double TabularBestResponse::Value(const std::string& history) {
-  auto it = value_cache_.find(history);
-  if (it != value_cache_.end()) return it->second;
   HistoryNode* node = tree_.GetByHistory(history);
   if (node == nullptr) SpielFatalError("node returned is null.");
+  return Value(node);
+}
+
+double TabularBestResponse::Value(HistoryNode* node) {
+  auto it = value_cache_.find(node->GetHistoryId());
+  if (it != value_cache_.end()) return it->second;
   double cache_value = 0;
   switch (node->GetType()) {
     case StateType::kTerminal: {
@@ -166,8 +248,300 @@ double TabularBestResponse::Value(const std::string& history) {
       break;
     }
   }
-  value_cache_[history] = cache_value;
-  return value_cache_[history];
+  value_cache_[node->GetHistoryId()] = cache_value;
+  return cache_value;
+}
+
+void TabularBestResponse::SetPolicy(
+    const Policy* policy,
+    const std::unordered_set<std::string>& changed_infostates) {
+  policy_ = policy;
+  if (changed_infostates.empty()) return;
+
+  // Find every opponent decision node whose policy lookup key changed, by
+  // walking the tree (infosets_ only holds the best responder's decisions).
+  // The best responder's own infostates never feed into the cached values,
+  // so entries for them in the delta are ignored.
+  std::unordered_set<HistoryNode*> changed_nodes;
+  std::function<void(HistoryNode*)> collect_changed = [&](HistoryNode* node) {
+    if (node->GetType() == StateType::kDecision &&
+        node->GetState()->CurrentPlayer() != best_responder_ &&
+        changed_infostates.count(node->GetInfoState()) > 0) {
+      changed_nodes.insert(node);
+    }
+    for (Action action : node->GetChildActions()) {
+      collect_changed(node->GetChild(action).second);
+    }
+  };
+  collect_changed(tree_.Root());
+  if (changed_nodes.empty()) return;
+
+  // The counter-factual probability of reaching a history depends on the
+  // opponent policy at its strict ancestors, so members below a changed
+  // decision get theirs recomputed by walking down from the root. A best
+  // response aggregates over its infoset's members weighted by these
+  // probabilities, so the responder's infosets touched here seed the
+  // invalidation below.
+  std::vector<std::vector<Action>> changed_histories;
+  changed_histories.reserve(changed_nodes.size());
+  for (HistoryNode* changed : changed_nodes) {
+    changed_histories.push_back(changed->GetState()->History());
+  }
+  auto recompute_prob = [this](HistoryNode* target) {
+    double prob = 1.0;
+    HistoryNode* node = tree_.Root();
+    for (Action action : target->GetState()->History()) {
+      if (node->GetType() == StateType::kChance) {
+        prob *= node->GetChild(action).first;
+      } else if (node->GetState()->CurrentPlayer() != best_responder_) {
+        prob *= policy_->GetActionProbability(node->GetInfoState(), action);
+      }  // The best responder's own actions count as 1 (counter-factual).
+      node = node->GetChild(action).second;
+    }
+    return prob;
+  };
+  std::unordered_set<std::string> affected_infosets;
+  for (auto& infostate_and_set : infosets_) {
+    for (auto& node_and_prob : infostate_and_set.second) {
+      const std::vector<Action>& history =
+          node_and_prob.first->GetState()->History();
+      for (const std::vector<Action>& changed : changed_histories) {
+        if (changed.size() < history.size() &&
+            std::equal(changed.begin(), changed.end(), history.begin())) {
+          node_and_prob.second = recompute_prob(node_and_prob.first);
+          HistoryNode* node = node_and_prob.first;
+          if (node->GetType() == StateType::kDecision &&
+              node->GetState()->CurrentPlayer() == best_responder_) {
+            affected_infosets.insert(infostate_and_set.first);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  // A cached history value is stale if the policy changed at the node
+  // itself, if the node is a responder decision whose infoset's best
+  // response may change, or if any descendant's value is stale. A
+  // responder infoset's best response may in turn change when a member's
+  // reach probability changed (seeded above) or a member's child value is
+  // stale, which can reach members that are nowhere near the changed
+  // nodes, so the two sets are grown together to a fixpoint.
+  std::unordered_set<int64_t> stale;
+  while (true) {
+    stale.clear();
+    std::function<bool(HistoryNode*)> mark = [&](HistoryNode* node) {
+      bool is_stale = changed_nodes.count(node) > 0;
+      if (node->GetType() == StateType::kDecision &&
+          node->GetState()->CurrentPlayer() == best_responder_ &&
+          affected_infosets.count(node->GetInfoState()) > 0) {
+        is_stale = true;
+      }
+      for (Action action : node->GetChildActions()) {
+        if (mark(node->GetChild(action).second)) is_stale = true;
+      }
+      if (is_stale) stale.insert(node->GetHistoryId());
+      return is_stale;
+    };
+    mark(tree_.Root());
+
+    const size_t num_affected_before = affected_infosets.size();
+    for (const auto& infostate_and_set : infosets_) {
+      if (affected_infosets.count(infostate_and_set.first) > 0) continue;
+      HistoryNode* first = infostate_and_set.second[0].first;
+      if (first->GetType() != StateType::kDecision ||
+          first->GetState()->CurrentPlayer() != best_responder_) {
+        continue;
+      }
+      for (const auto& node_and_prob : infostate_and_set.second) {
+        HistoryNode* node = node_and_prob.first;
+        bool child_stale = false;
+        for (Action action : node->GetChildActions()) {
+          if (stale.count(node->GetChild(action).second->GetHistoryId()) > 0) {
+            child_stale = true;
+            break;
+          }
+        }
+        if (child_stale) {
+          affected_infosets.insert(infostate_and_set.first);
+          break;
+        }
+      }
+    }
+    if (affected_infosets.size() == num_affected_before) break;
+  }
+
+  for (int64_t history_id : stale) value_cache_.erase(history_id);
+  for (const std::string& infostate : affected_infosets) {
+    best_response_actions_.erase(infostate);
+  }
+}
+
+double TabularBestResponse::LocalValue(
+    HistoryNode* node, std::unordered_map<int64_t, double>* local_values) {
+  const int64_t history_id = node->GetHistoryId();
+  auto it = value_cache_.find(history_id);
+  if (it != value_cache_.end()) return it->second;
+  auto local_it = local_values->find(history_id);
+  if (local_it != local_values->end()) return local_it->second;
+  double value = 0;
+  switch (node->GetType()) {
+    case StateType::kTerminal: {
+      value = HandleTerminalCase(*node);
+      break;
+    }
+    case StateType::kDecision: {
+      if (node->GetState()->CurrentPlayer() == best_responder_) {
+        // The best response for this information set comes from a deeper
+        // wave, so it must already be in the shared cache.
+        auto action_it = best_response_actions_.find(node->GetInfoState());
+        if (action_it == best_response_actions_.end()) {
+          SpielFatalError(absl::StrCat("LocalValue: no best response for ",
+                                       node->GetInfoState()));
+        }
+        HistoryNode* child = node->GetChild(action_it->second).second;
+        if (child == nullptr) SpielFatalError("LocalValue: child is null.");
+        value = LocalValue(child, local_values);
+      } else {
+        ActionsAndProbs state_policy =
+            policy_->GetStatePolicy(node->GetInfoState());
+        if (state_policy.empty())
+          SpielFatalError(absl::StrCat("InfoState ", node->GetInfoState(),
+                                       " not found in policy."));
+        for (const auto& action : node->GetState()->LegalActions()) {
+          HistoryNode* child = node->GetChild(action).second;
+          if (child == nullptr) SpielFatalError("LocalValue: child is null.");
+          const double prob = GetProb(state_policy, action);
+          SPIEL_CHECK_GE(prob, 0);
+          value += prob * LocalValue(child, local_values);
+        }
+      }
+      break;
+    }
+    case StateType::kChance: {
+      for (const auto& action : node->GetChildActions()) {
+        std::pair<double, HistoryNode*> prob_and_child = node->GetChild(action);
+        HistoryNode* child = prob_and_child.second;
+        if (child == nullptr) SpielFatalError("LocalValue: child is null.");
+        value += prob_and_child.first * LocalValue(child, local_values);
+      }
+      break;
+    }
+  }
+  (*local_values)[history_id] = value;
+  return value;
+}
+
+Action TabularBestResponse::LocalBestResponseAction(
+    const std::string& infostate,
+    std::unordered_map<int64_t, double>* local_values) {
+  const std::vector<std::pair<HistoryNode*, double>>& infoset =
+      infosets_.at(infostate);
+
+  const std::vector<Action> actions = infoset[0].first->GetChildActions();
+
+  // Same bound pruning as BestResponseAction. The bounds cache was filled
+  // for the whole tree before the waves started (see ComputeBestResponses),
+  // so this only reads it, which is safe from several threads at once.
+  std::vector<std::pair<double, double>> action_bounds(actions.size(), {0, 0});
+  double best_lower_bound = std::numeric_limits<double>::lowest();
+  for (int i = 0; i < actions.size(); ++i) {
+    for (const auto& state_and_prob : infoset) {
+      HistoryNode* child_node =
+          state_and_prob.first->GetChild(actions[i]).second;
+      SPIEL_CHECK_TRUE(child_node != nullptr);
+      const std::pair<double, double>& bounds =
+          bounds_cache_.at(child_node->GetHistoryId());
+      action_bounds[i].first += state_and_prob.second * bounds.first;
+      action_bounds[i].second += state_and_prob.second * bounds.second;
+    }
+    best_lower_bound = std::max(best_lower_bound, action_bounds[i].first);
+  }
+
+  Action best_action = -1;
+  double best_value = std::numeric_limits<double>::lowest();
+  for (int i = 0; i < actions.size(); ++i) {
+    if (action_bounds[i].second < best_lower_bound ||
+        action_bounds[i].second < best_value) {
+      continue;
+    }
+    double value = 0;
+    for (const auto& state_and_prob : infoset) {
+      HistoryNode* child_node =
+          state_and_prob.first->GetChild(actions[i]).second;
+      value += state_and_prob.second * LocalValue(child_node, local_values);
+    }
+    if (value > best_value) {
+      best_value = value;
+      best_action = actions[i];
+    }
+  }
+  if (best_action == -1) SpielFatalError("No action was chosen.");
+  return best_action;
+}
+
+void TabularBestResponse::ComputeBestResponses(int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (num_threads == 1) {
+    Value(root_->ToString());
+    return;
+  }
+
+  // Group the best responder's information sets into waves by history
+  // depth, processed deepest first. All histories in an information set
+  // have the same depth under perfect recall.
+  std::map<int, std::vector<const std::string*>, std::greater<int>> waves;
+  for (const auto& infostate_and_set : infosets_) {
+    HistoryNode* node = infostate_and_set.second[0].first;
+    if (node->GetType() == StateType::kDecision &&
+        node->GetState()->CurrentPlayer() == best_responder_) {
+      waves[node->GetState()->History().size()].push_back(
+          &infostate_and_set.first);
+    }
+  }
+
+  // Fill the bounds cache for the whole tree up front so that the workers
+  // never write to it; on every run after the first this finds the cached
+  // root entry and returns immediately.
+  SubtreeBounds(tree_.Root());
+
+  TaskPool* pool = TaskPool::Global();
+  for (const auto& wave : waves) {
+    const std::vector<const std::string*>& wave_infostates = wave.second;
+    // One task per information set on the shared pool; the local caches
+    // are per pool slot, so tasks that land on the same worker keep
+    // sharing subtree values within the wave.
+    std::vector<std::unordered_map<int64_t, double>> slot_values(
+        pool->NumSlots());
+    std::vector<std::vector<std::pair<const std::string*, Action>>>
+        slot_actions(pool->NumSlots());
+    {
+      TaskGroup group(pool);
+      for (const std::string* infostate : wave_infostates) {
+        group.Spawn([this, pool, infostate, &slot_values, &slot_actions]() {
+          const int slot = pool->CurrentSlot();
+          slot_actions[slot].push_back(
+              {infostate,
+               LocalBestResponseAction(*infostate, &slot_values[slot])});
+        });
+      }
+      group.Sync();
+    }
+
+    // Merge this wave's results into the shared caches before the next,
+    // shallower wave reads them.
+    for (int slot = 0; slot < pool->NumSlots(); ++slot) {
+      value_cache_.insert(slot_values[slot].begin(), slot_values[slot].end());
+      for (const auto& infostate_and_action : slot_actions[slot]) {
+        best_response_actions_[*infostate_and_action.first] =
+            infostate_and_action.second;
+      }
+    }
+  }
+
+  // Everything below the root's first decisions is now cached; this fills
+  // in the values of the remaining shallow chance/opponent histories.
+  Value(root_->ToString());
 }
 
 Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
@@ -175,22 +549,47 @@ Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
   if (it != best_response_actions_.end()) return it->second;
   std::vector<std::pair<HistoryNode*, double>> infoset = infosets_[infostate];
 
+  // The legal actions are the same for all children, so we arbitrarily pick
+  // the first one to get the legal actions from.
+  const std::vector<Action> actions = infoset[0].first->GetChildActions();
+
+  // Reach-weighted subtree bounds per action. An action whose upper bound
+  // falls strictly below another action's lower bound can never be the
+  // best response, whatever the opponent plays below it, so its subtrees
+  // are skipped entirely; the winner is unaffected because the original
+  // loop only switches actions on a strict improvement.
+  std::vector<std::pair<double, double>> action_bounds(actions.size(), {0, 0});
+  double best_lower_bound = std::numeric_limits<double>::lowest();
+  for (int i = 0; i < actions.size(); ++i) {
+    for (const auto& state_and_prob : infoset) {
+      HistoryNode* child_node =
+          state_and_prob.first->GetChild(actions[i]).second;
+      SPIEL_CHECK_TRUE(child_node != nullptr);
+      const std::pair<double, double> bounds = SubtreeBounds(child_node);
+      action_bounds[i].first += state_and_prob.second * bounds.first;
+      action_bounds[i].second += state_and_prob.second * bounds.second;
+    }
+    best_lower_bound = std::max(best_lower_bound, action_bounds[i].first);
+  }
+
   Action best_action = -1;
   double best_value = std::numeric_limits<double>::lowest();
-  // The legal actions are the same for all children, so we arbitrarily pick the
-  // first one to get the legal actions from.
-  for (const auto& action : infoset[0].first->GetChildActions()) {
+  for (int i = 0; i < actions.size(); ++i) {
+    if (action_bounds[i].second < best_lower_bound ||
+        action_bounds[i].second < best_value) {
+      ++num_pruned_actions_;
+      continue;
+    }
     double value = 0;
     // Prob here is the counterfactual reach-weighted probability.
     for (const auto& state_and_prob : infoset) {
-      HistoryNode* state_node = state_and_prob.first;
-      HistoryNode* child_node = state_node->GetChild(action).second;
-      SPIEL_CHECK_TRUE(child_node != nullptr);
-      value += state_and_prob.second * Value(child_node->GetHistory());
+      HistoryNode* child_node =
+          state_and_prob.first->GetChild(actions[i]).second;
+      value += state_and_prob.second * Value(child_node);
     }
     if (value > best_value) {
       best_value = value;
-      best_action = action;
+      best_action = actions[i];
     }
   }
   if (best_action == -1) SpielFatalError("No action was chosen.");
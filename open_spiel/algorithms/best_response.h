@@ -40,6 +40,14 @@ class TabularBestResponse {
       const Game& game, Player best_responder,
       const std::unordered_map<std::string, ActionsAndProbs>& policy_table);
 
+  // As the first constructor, but stamps the per-player tree out of a
+  // prebuilt SharedGameTree (typically from GetSharedGameTree, which caches
+  // one per game) instead of replaying the game engine. Use this when
+  // constructing best responses repeatedly against the same game.
+  TabularBestResponse(const Game& game, Player best_responder,
+                      const Policy* policy,
+                      const SharedGameTree& shared_tree);
+
   TabularBestResponse(TabularBestResponse&&) = default;
   TabularBestResponse(const TabularBestResponse&) = default;
   TabularBestResponse& operator=(const TabularBestResponse&) = default;
@@ -55,9 +63,11 @@ class TabularBestResponse {
   // When two actions have the same value, we
   // return the action with the lowest number (as an int).
   std::unordered_map<std::string, Action> GetBestResponseActions() {
-    // If the best_response_actions_ cache is empty, we fill it by calculating
-    // all best responses, starting at the root.
-    if (best_response_actions_.empty()) Value(root_->ToString());
+    // A Value call from the root fills in whatever the caches are missing:
+    // everything on the first call, only the entries invalidated by the
+    // incremental SetPolicy after one, and nothing (a single cache lookup)
+    // when they are already warm.
+    Value(root_->ToString());
     return best_response_actions_;
   }
 
@@ -71,6 +81,15 @@ class TabularBestResponse {
   // beginning at history.
   double Value(const std::string& history);
 
+  // Computes the best responses for every information set using num_threads
+  // workers, filling the same caches as the serial computation (so
+  // GetBestResponseActions and Value afterwards are lookups). The best
+  // responder's information sets are processed deepest-first in depth waves:
+  // the sets within a wave only depend on values of strictly deeper
+  // histories, which earlier waves have already cached, so they are
+  // independent of each other and are distributed across the thread pool.
+  void ComputeBestResponses(int num_threads);
+
   // Changes the policy that we are calculating a best response to. This is
   // useful as a large amount of the data structures can be reused, causing
   // the calculation to be quicker than if we had to re-initialize the class.
@@ -91,6 +110,24 @@ class TabularBestResponse {
     SetPolicy(&tabular_policy_container_);
   }
 
+  // Incremental variant of SetPolicy: `changed_infostates` lists the
+  // information states (the keys given to Policy::GetStatePolicy) whose
+  // probabilities differ between the old and the new policy. A cached
+  // history value depends only on the policy inside its subtree, so only
+  // the values and best responses at the changed nodes and their ancestors
+  // are invalidated, and only the counter-factual probabilities below a
+  // changed opponent decision are recomputed. Between consecutive CFR
+  // iterations the delta is typically a handful of infostates, making this
+  // much cheaper than the full reset. Oracle loops built on OverlayPolicy
+  // (see policy.h) can pass the overlay's override keys directly.
+  void SetPolicy(const Policy* policy,
+                 const std::unordered_set<std::string>& changed_infostates);
+
+  // Number of candidate actions whose evaluation was skipped by bound
+  // pruning (see SubtreeBounds) in serial traversals since construction.
+  // For tests and profiling.
+  int64_t NumPrunedActions() const { return num_pruned_actions_; }
+
  private:
   // For chance nodes, we recursively calculate the value of each child node,
   // and weight them by the probability of reaching each child.
@@ -107,6 +144,36 @@ class TabularBestResponse {
   // have nothing to do.
   double HandleTerminalCase(const HistoryNode& node) const;
 
+  // The value of the history at the given node. The recursion runs on
+  // nodes, keying the cache on their interned history ids (see
+  // HistoryNode::GetHistoryId), so the history strings are hashed at most
+  // once per run, at the public Value() entry point.
+  double Value(HistoryNode* node);
+
+  // The value of a node as in Value(), but safe to call from several
+  // threads at once: reads the shared caches and writes what it computes
+  // into *local_values instead, which the wave driver merges afterwards.
+  // Best responses at decision nodes for best_responder must already be in
+  // best_response_actions_ (they come from deeper waves).
+  double LocalValue(HistoryNode* node,
+                    std::unordered_map<int64_t, double>* local_values);
+
+  // BestResponseAction computed via LocalValue; same thread-safety contract.
+  Action LocalBestResponseAction(
+      const std::string& infostate,
+      std::unordered_map<int64_t, double>* local_values);
+
+  // Bounds on the value of the subtree rooted at node, as a (lower, upper)
+  // pair, valid against *any* opponent policy: terminals bound themselves,
+  // chance nodes mix the child bounds by their fixed probabilities, opponent
+  // decisions can realize anything between the smallest child lower bound
+  // and the largest child upper bound, and responder decisions take the
+  // maximum of both (the responder picks the best child). Because they do
+  // not depend on policy_, the bounds are computed once per node and kept
+  // across SetPolicy calls, so every best-response recomputation inside an
+  // iterative solver (e.g. CFR-BR) reuses them.
+  std::pair<double, double> SubtreeBounds(HistoryNode* node);
+
   Player best_responder_;
 
   // Used to store a specific policy if not passed in from the caller.
@@ -133,8 +200,20 @@ class TabularBestResponse {
   // Caches all best responses calculated so far (for each infostate).
   std::unordered_map<std::string, Action> best_response_actions_;
 
-  // Caches all values calculated so far (for each history).
-  std::unordered_map<std::string, double> value_cache_;
+  // Caches all values calculated so far, keyed on the interned history ids
+  // from the tree rather than the history strings themselves.
+  std::unordered_map<int64_t, double> value_cache_;
+
+  // Policy-independent (lower, upper) value bounds per subtree, keyed on
+  // the interned history ids. Never invalidated: SetPolicy (both variants)
+  // leaves it intact, which is what makes the pruning pay off across the
+  // iterations of a solver.
+  std::unordered_map<int64_t, std::pair<double, double>> bounds_cache_;
+
+  // Counts actions skipped by bound pruning; only maintained by the serial
+  // traversals (the parallel path would race on it).
+  int64_t num_pruned_actions_ = 0;
+
   std::unique_ptr<State> root_;
 
   // Keep a cache of an empty policy to avoid recomputing it.
@@ -498,6 +498,139 @@ void KuhnPokerOptimalValueTestPid1() {
       *game, /*best_responder=*/Player{1}, policy, histories_and_values);
 }
 
+
+// After perturbing a single opponent infostate, the incremental SetPolicy
+// must agree with the full reset.
+void KuhnPokerIncrementalSetPolicy() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::string root_history = game->NewInitialState()->ToString();
+  TabularBestResponse full(*game, /*best_responder=*/Player{0}, &policy);
+  TabularBestResponse incremental(*game, /*best_responder=*/Player{0},
+                                  &policy);
+  // Warm both caches fully before the policy changes.
+  full.GetBestResponseActions();
+  incremental.GetBestResponseActions();
+
+  // Change the opponent's play after a pass holding the jack.
+  TabularPolicy new_policy = policy;
+  new_policy.PolicyTable()["0p"] = {{0, 0.25}, {1, 0.75}};
+  full.SetPolicy(&new_policy);
+  incremental.SetPolicy(&new_policy, /*changed_infostates=*/{"0p"});
+
+  SPIEL_CHECK_FLOAT_EQ(full.Value(root_history),
+                       incremental.Value(root_history));
+  auto full_actions = full.GetBestResponseActions();
+  auto incremental_actions = incremental.GetBestResponseActions();
+  SPIEL_CHECK_EQ(full_actions.size(), incremental_actions.size());
+  for (const auto& infostate_and_action : full_actions) {
+    SPIEL_CHECK_EQ(infostate_and_action.second,
+                   incremental_actions.at(infostate_and_action.first));
+  }
+}
+
+// An oracle loop that mutates a sparse overlay over a fixed base policy
+// must see the same values and best responses as one that rewrites a
+// complete table for every candidate.
+void KuhnPokerOverlayPolicyOracleLoop() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::string root_history = game->NewInitialState()->ToString();
+  TabularPolicy base = GetUniformPolicy(*game);
+  OverlayPolicy overlay(&base);
+  TabularBestResponse persistent(*game, /*best_responder=*/Player{0},
+                                 &overlay);
+  persistent.GetBestResponseActions();
+
+  // Enumerate deterministic deviations at the opponent's "0p" infostate,
+  // passing the touched override key as the incremental delta each time.
+  const std::string info_state = "0p";
+  const std::vector<Action> legal_actions = {0, 1};
+  for (Action action : legal_actions) {
+    overlay.SetOverride(info_state, action, legal_actions);
+    persistent.SetPolicy(&overlay, /*changed_infostates=*/{info_state});
+
+    TabularPolicy full = base;
+    full.PolicyTable()[info_state] = overlay.GetStatePolicy(info_state);
+    TabularBestResponse fresh(*game, /*best_responder=*/Player{0}, &full);
+    SPIEL_CHECK_FLOAT_EQ(persistent.Value(root_history),
+                         fresh.Value(root_history));
+    auto persistent_actions = persistent.GetBestResponseActions();
+    auto fresh_actions = fresh.GetBestResponseActions();
+    SPIEL_CHECK_EQ(persistent_actions.size(), fresh_actions.size());
+    for (const auto& infostate_and_action : fresh_actions) {
+      SPIEL_CHECK_EQ(infostate_and_action.second,
+                     persistent_actions.at(infostate_and_action.first));
+    }
+  }
+}
+
+// The subtree value bounds are kept across SetPolicy calls, so a responder
+// reused over a sequence of policies (as CFR-BR does) prunes against bounds
+// computed under earlier policies. This must not change any value or best
+// response compared to a responder built fresh for each policy.
+void BoundPruningConsistentAcrossPolicies() {
+  for (const std::string& game_name : {"kuhn_poker", "leduc_poker"}) {
+    std::shared_ptr<const Game> game = LoadGame(game_name);
+    std::string root_history = game->NewInitialState()->ToString();
+    TabularPolicy policy = GetUniformPolicy(*game);
+    TabularBestResponse persistent(*game, /*best_responder=*/Player{0},
+                                   &policy);
+    for (int iteration = 0; iteration < 4; ++iteration) {
+      // Skew every infostate's probabilities a little more each iteration.
+      for (auto& infostate_and_probs : policy.PolicyTable()) {
+        double total = 0;
+        for (int i = 0; i < infostate_and_probs.second.size(); ++i) {
+          infostate_and_probs.second[i].second += 0.1 * (i % 2);
+          total += infostate_and_probs.second[i].second;
+        }
+        for (auto& action_and_prob : infostate_and_probs.second) {
+          action_and_prob.second /= total;
+        }
+      }
+      persistent.SetPolicy(&policy);
+      TabularBestResponse fresh(*game, /*best_responder=*/Player{0}, &policy);
+      SPIEL_CHECK_EQ(persistent.Value(root_history),
+                     fresh.Value(root_history));
+      auto persistent_actions = persistent.GetBestResponseActions();
+      auto fresh_actions = fresh.GetBestResponseActions();
+      SPIEL_CHECK_EQ(persistent_actions.size(), fresh_actions.size());
+      for (const auto& infostate_and_action : fresh_actions) {
+        SPIEL_CHECK_EQ(infostate_and_action.second,
+                       persistent_actions.at(infostate_and_action.first));
+      }
+    }
+    // The bounds must actually have pruned something in leduc, where many
+    // subtrees are dominated.
+    if (game_name == "leduc_poker") {
+      SPIEL_CHECK_GT(persistent.NumPrunedActions(), 0);
+    }
+  }
+}
+
+// Verifies that the parallel computation produces exactly the serial best
+// responses and root value, on both players of kuhn and leduc.
+void ParallelBestResponseMatchesSerial() {
+  for (const std::string& game_name : {"kuhn_poker", "leduc_poker"}) {
+    std::shared_ptr<const Game> game = LoadGame(game_name);
+    TabularPolicy policy = GetUniformPolicy(*game);
+    std::string root_history = game->NewInitialState()->ToString();
+    for (auto p = Player{0}; p < 2; ++p) {
+      TabularBestResponse serial(*game, p, &policy);
+      TabularBestResponse parallel(*game, p, &policy);
+      parallel.ComputeBestResponses(/*num_threads=*/4);
+      SPIEL_CHECK_EQ(serial.Value(root_history),
+                     parallel.Value(root_history));
+      auto serial_actions = serial.GetBestResponseActions();
+      auto parallel_actions = parallel.GetBestResponseActions();
+      SPIEL_CHECK_EQ(serial_actions.size(), parallel_actions.size());
+      for (const auto& infostate_and_action : serial_actions) {
+        SPIEL_CHECK_EQ(infostate_and_action.second,
+                       parallel_actions.at(infostate_and_action.first));
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -520,4 +653,8 @@ int main(int argc, char** argv) {
   // Verifies that the code automatically generates the best response actions
   // after swapping policies.
   open_spiel::algorithms::KuhnPokerUniformBestResponseAfterSwitchingPolicies();
+  open_spiel::algorithms::ParallelBestResponseMatchesSerial();
+  open_spiel::algorithms::KuhnPokerIncrementalSetPolicy();
+  open_spiel::algorithms::KuhnPokerOverlayPolicyOracleLoop();
+  open_spiel::algorithms::BoundPruningConsistentAcrossPolicies();
 }
@@ -15,8 +15,16 @@
 #include "open_spiel/algorithms/cfr.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <thread>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/algorithms/get_legal_actions_map.h"
+#include "open_spiel/algorithms/tree_traversal.h"
+#include "open_spiel/algorithms/vector_kernels.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
@@ -62,6 +70,18 @@ ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
   return actions_and_probs;
 }
 
+void ExportAveragePolicyToFile(const CFRInfoStateValuesTable& info_states,
+                               const std::string& filename,
+                               const PolicyExportOptions& options) {
+  CFRAveragePolicy average_policy(info_states, nullptr);
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  table.reserve(info_states.size());
+  for (const auto& entry : info_states) {
+    table.emplace(entry.first, average_policy.GetStatePolicy(entry.first));
+  }
+  ExportPolicyToFile(table, filename, options);
+}
+
 CFRCurrentPolicy::CFRCurrentPolicy(
     const CFRInfoStateValuesTable& info_states,
     std::shared_ptr<TabularPolicy> default_policy)
@@ -87,15 +107,80 @@ ActionsAndProbs CFRCurrentPolicy::GetStatePolicy(
   return actions_and_probs;
 }
 
+namespace {
+
+// See MakeRolloutLeafValueOracle in the header.
+class RolloutLeafValueOracle : public LeafValueOracle {
+ public:
+  RolloutLeafValueOracle(int num_rollouts, int seed)
+      : num_rollouts_(num_rollouts), seed_(seed) {
+    SPIEL_CHECK_GE(num_rollouts_, 1);
+  }
+
+  std::vector<double> LeafValues(const State& state) override {
+    // Each leaf gets its own stream, derived from the seed and the leaf's
+    // history, so the values do not depend on the order (or the thread)
+    // in which a traversal reaches the leaves.
+    std::mt19937 rng(seed_ ^ state.HistoryHash());
+    std::vector<double> values(state.NumPlayers(), 0.0);
+    for (int rollout = 0; rollout < num_rollouts_; ++rollout) {
+      std::unique_ptr<State> playout = state.Clone();
+      while (!playout->IsTerminal()) {
+        if (playout->IsChanceNode()) {
+          playout->ApplyAction(SampleChanceOutcome(*playout, &rng));
+        } else {
+          std::vector<Action> legal_actions = playout->LegalActions();
+          playout->ApplyAction(legal_actions[std::uniform_int_distribution<
+              int>(0, legal_actions.size() - 1)(rng)]);
+        }
+      }
+      const std::vector<double> returns = playout->Returns();
+      for (int p = 0; p < returns.size(); ++p) values[p] += returns[p];
+    }
+    for (double& value : values) value /= num_rollouts_;
+    return values;
+  }
+
+ private:
+  Action SampleChanceOutcome(const State& state, std::mt19937* rng) {
+    const ActionsAndProbs outcomes = state.ChanceOutcomes();
+    double z = std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+    for (const auto& outcome_and_prob : outcomes) {
+      z -= outcome_and_prob.second;
+      if (z <= 0.0) return outcome_and_prob.first;
+    }
+    return outcomes.back().first;
+  }
+
+  const int num_rollouts_;
+  const uint64_t seed_;
+};
+
+}  // namespace
+
+std::unique_ptr<LeafValueOracle> MakeRolloutLeafValueOracle(int num_rollouts,
+                                                            int seed) {
+  return std::unique_ptr<LeafValueOracle>(
+      new RolloutLeafValueOracle(num_rollouts, seed));
+}
+
 CFRSolverBase::CFRSolverBase(const Game& game, bool alternating_updates,
-                             bool linear_averaging, bool regret_matching_plus)
+                             bool linear_averaging, bool regret_matching_plus,
+                             int depth_limit, LeafValueOracle* leaf_oracle,
+                             const std::string& skeleton_filename)
     : game_(game),
       root_state_(game.NewInitialState()),
       root_reach_probs_(game_.NumPlayers() + 1, 1.0),
+      use_info_state_keys_(game.ProvidesInformationStateKey()),
       regret_matching_plus_(regret_matching_plus),
       alternating_updates_(alternating_updates),
       linear_averaging_(linear_averaging),
-      chance_player_(game.NumPlayers()) {
+      chance_player_(game.NumPlayers()),
+      traversal_depth_limit_(depth_limit),
+      leaf_oracle_(leaf_oracle) {
+  if (traversal_depth_limit_ >= 0 && leaf_oracle_ == nullptr) {
+    SpielFatalError("Depth-limited CFR requires a LeafValueOracle.");
+  }
   if (game_.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError(
         "CFR requires sequential games. If you're trying to run it "
@@ -103,35 +188,357 @@ CFRSolverBase::CFRSolverBase(const Game& game, bool alternating_updates,
         "using turn_based_simultaneous_game.");
   }
 
-  InitializeInfostateNodes(*root_state_);
+  if (!skeleton_filename.empty()) {
+    LoadTableSkeleton(skeleton_filename);
+  } else if (use_info_state_keys_ || traversal_depth_limit_ >= 0) {
+    // The integer key index needs live states, and the cached index covers
+    // the full game while a depth limit must not, so walk the tree.
+    DiscoverInfostateNodes();
+  } else {
+    InitializeInfostateNodesFromIndex();
+  }
+  CompactTableStorage();
+}
+
+namespace {
+// Format markers for binary checkpoints and table skeletons; bump when the
+// layouts change.
+constexpr char kCheckpointMagic[8] = {'O', 'S', 'C', 'F', 'R', 'v', '0', '1'};
+constexpr char kSkeletonMagic[8] = {'O', 'S', 'C', 'F', 'R', 'S', 'K', '1'};
+
+// Checkpoint rows are always written and read as double, whatever CFRValue
+// the build stores, so files move between float32 and double builds.
+void WriteValueRow(std::ofstream& file, const CFRValueRow& row,
+                   std::vector<double>* scratch) {
+  scratch->assign(row.begin(), row.end());
+  file.write(reinterpret_cast<const char*>(scratch->data()),
+             scratch->size() * sizeof(double));
 }
 
-void CFRSolverBase::InitializeInfostateNodes(const State& state) {
+void ReadValueRow(std::ifstream& file, CFRValueRow* row,
+                  std::vector<double>* scratch) {
+  scratch->resize(row->size());
+  file.read(reinterpret_cast<char*>(scratch->data()),
+            scratch->size() * sizeof(double));
+  for (int i = 0; i < row->size(); ++i) (*row)[i] = (*scratch)[i];
+}
+}  // namespace
+
+void CFRSolverBase::SaveCheckpoint(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open checkpoint file: ", filename));
+  }
+  file.write(kCheckpointMagic, sizeof(kCheckpointMagic));
+  const int64_t iteration = iteration_;
+  file.write(reinterpret_cast<const char*>(&iteration), sizeof(iteration));
+  const uint64_t num_entries = info_states_.size();
+  file.write(reinterpret_cast<const char*>(&num_entries), sizeof(num_entries));
+
+  std::vector<double> scratch;
+  for (const auto& entry : info_states_) {
+    const uint64_t key_size = entry.first.size();
+    file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    file.write(entry.first.data(), key_size);
+    const CFRInfoStateValues& is_vals = entry.second;
+    const uint64_t num_actions = is_vals.num_actions();
+    file.write(reinterpret_cast<const char*>(&num_actions),
+               sizeof(num_actions));
+    WriteValueRow(file, is_vals.cumulative_regrets, &scratch);
+    WriteValueRow(file, is_vals.cumulative_policy, &scratch);
+    WriteValueRow(file, is_vals.current_policy, &scratch);
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing checkpoint to: ", filename));
+  }
+}
+
+void CFRSolverBase::LoadCheckpoint(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open checkpoint file: ", filename));
+  }
+  char magic[sizeof(kCheckpointMagic)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), kCheckpointMagic)) {
+    SpielFatalError(absl::StrCat("Not a CFR checkpoint file: ", filename));
+  }
+  int64_t iteration;
+  file.read(reinterpret_cast<char*>(&iteration), sizeof(iteration));
+  iteration_ = iteration;
+  uint64_t num_entries;
+  file.read(reinterpret_cast<char*>(&num_entries), sizeof(num_entries));
+
+  std::string key;
+  std::vector<double> scratch;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    uint64_t key_size;
+    file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+    key.resize(key_size);
+    file.read(&key[0], key_size);
+    uint64_t num_actions;
+    file.read(reinterpret_cast<char*>(&num_actions), sizeof(num_actions));
+    if (!file) {
+      SpielFatalError(absl::StrCat("Truncated checkpoint file: ", filename));
+    }
+
+    auto entry = info_states_.find(key);
+    if (entry == info_states_.end()) {
+      SpielFatalError(absl::StrCat(
+          "Checkpoint information state not present in this game: ", key));
+    }
+    CFRInfoStateValues& is_vals = entry->second;
+    SPIEL_CHECK_EQ(num_actions, is_vals.num_actions());
+    ReadValueRow(file, &is_vals.cumulative_regrets, &scratch);
+    ReadValueRow(file, &is_vals.cumulative_policy, &scratch);
+    ReadValueRow(file, &is_vals.current_policy, &scratch);
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Truncated checkpoint file: ", filename));
+  }
+}
+
+void CFRSolverBase::SaveTableSkeleton(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open skeleton file: ", filename));
+  }
+  file.write(kSkeletonMagic, sizeof(kSkeletonMagic));
+  const uint8_t has_keys = use_info_state_keys_ ? 1 : 0;
+  file.write(reinterpret_cast<const char*>(&has_keys), sizeof(has_keys));
+  const uint64_t num_entries = info_states_.size();
+  file.write(reinterpret_cast<const char*>(&num_entries), sizeof(num_entries));
+
+  // The key index maps integer key to entry; invert it so each entry can be
+  // written next to its key.
+  std::unordered_map<const CFRInfoStateValues*, uint64_t> entry_keys;
+  if (use_info_state_keys_) {
+    entry_keys.reserve(key_index_.size());
+    for (const auto& key_and_entry : key_index_) {
+      entry_keys[key_and_entry.second] = key_and_entry.first;
+    }
+  }
+
+  for (const auto& entry : info_states_) {
+    const uint64_t key_size = entry.first.size();
+    file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    file.write(entry.first.data(), key_size);
+    const uint64_t num_actions = entry.second.num_actions();
+    file.write(reinterpret_cast<const char*>(&num_actions),
+               sizeof(num_actions));
+    file.write(reinterpret_cast<const char*>(entry.second.legal_actions.data()),
+               num_actions * sizeof(Action));
+    if (use_info_state_keys_) {
+      const uint64_t int_key = entry_keys.at(&entry.second);
+      file.write(reinterpret_cast<const char*>(&int_key), sizeof(int_key));
+    }
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing skeleton to: ", filename));
+  }
+}
+
+void CFRSolverBase::LoadTableSkeleton(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open skeleton file: ", filename));
+  }
+  char magic[sizeof(kSkeletonMagic)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), kSkeletonMagic)) {
+    SpielFatalError(absl::StrCat("Not a CFR skeleton file: ", filename));
+  }
+  uint8_t has_keys;
+  file.read(reinterpret_cast<char*>(&has_keys), sizeof(has_keys));
+  if (use_info_state_keys_ && !has_keys) {
+    SpielFatalError(absl::StrCat(
+        "Skeleton file lacks the information-state keys this game provides: ",
+        filename));
+  }
+  uint64_t num_entries;
+  file.read(reinterpret_cast<char*>(&num_entries), sizeof(num_entries));
+
+  std::string key;
+  std::vector<Action> legal_actions;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    uint64_t key_size;
+    file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+    key.resize(key_size);
+    file.read(&key[0], key_size);
+    uint64_t num_actions;
+    file.read(reinterpret_cast<char*>(&num_actions), sizeof(num_actions));
+    if (!file) {
+      SpielFatalError(absl::StrCat("Truncated skeleton file: ", filename));
+    }
+    legal_actions.resize(num_actions);
+    file.read(reinterpret_cast<char*>(legal_actions.data()),
+              num_actions * sizeof(Action));
+    CFRInfoStateValues* entry =
+        &(info_states_[key] = CFRInfoStateValues(legal_actions));
+    if (has_keys) {
+      uint64_t int_key;
+      file.read(reinterpret_cast<char*>(&int_key), sizeof(int_key));
+      if (use_info_state_keys_) key_index_[int_key] = entry;
+    }
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Truncated skeleton file: ", filename));
+  }
+}
+
+void CFRSolverBase::EnableRegretBasedPruning(double regret_threshold,
+                                             int revisit_interval) {
+  SPIEL_CHECK_LT(regret_threshold, 0);
+  SPIEL_CHECK_GE(revisit_interval, 1);
+  use_regret_based_pruning_ = true;
+  prune_regret_threshold_ = regret_threshold;
+  prune_revisit_interval_ = revisit_interval;
+}
+
+void CFRSolverBase::CompactTableStorage() {
+  // The buffer starts on a cache-line boundary and every entry's segment
+  // is rounded up to whole lines, so no two entries' accumulators share
+  // a line: threads updating or merging into different entries never
+  // write the same line, which is what turns parallel accumulation into
+  // actual speedup rather than coherence traffic.
+  constexpr std::size_t kValuesPerLine = kCacheLineBytes / sizeof(CFRValue);
+  const auto padded = [](std::size_t values) {
+    return (values + kValuesPerLine - 1) / kValuesPerLine * kValuesPerLine;
+  };
+  std::size_t total = 0;
+  for (const auto& entry : info_states_) {
+    total += padded(3 * entry.second.num_actions());
+  }
+  // Sized once; must never reallocate, since the entries point into it.
+  flat_values_.resize(total + kValuesPerLine - 1);
+  const std::uintptr_t addr =
+      reinterpret_cast<std::uintptr_t>(flat_values_.data());
+  CFRValue* base =
+      flat_values_.data() +
+      (kValuesPerLine - (addr / sizeof(CFRValue)) % kValuesPerLine) %
+          kValuesPerLine;
+  std::size_t offset = 0;
+  for (auto& entry : info_states_) {
+    entry.second.RebindTo(base + offset);
+    offset += padded(3 * entry.second.num_actions());
+  }
+}
+
+int64_t CFRSolverBase::TableMemoryBytes() const {
+  int64_t bytes = info_states_.bucket_count() * sizeof(void*) +
+                  flat_values_.capacity() * sizeof(CFRValue);
+  for (const auto& entry : info_states_) {
+    bytes += sizeof(entry) + entry.first.capacity() +
+             entry.second.MemoryBytes();
+  }
+  stats::SetGauge(stats::kCfrTableBytes, bytes);
+  return bytes;
+}
+
+void CFRSolverBase::InitializeInfostateNodesFromIndex() {
+  // The cached per-game index already holds every information state with
+  // its legal actions, so the table can be filled without walking the game.
+  std::shared_ptr<const LegalActionsIndex> index = GetLegalActionsIndex(game_);
+  for (int id = 0; id < index->NumInfoStates(); ++id) {
+    info_states_[index->InfoState(id)] =
+        CFRInfoStateValues(index->LegalActions(id));
+  }
+}
+
+void CFRSolverBase::InitializeInfostateNodes(
+    const State& state, int depth, CFRInfoStateValuesTable* table,
+    std::vector<std::pair<uint64_t, std::string>>* keys) {
   if (state.IsTerminal()) {
     return;
   }
+  // Depth-limited traversals never look below the frontier, so the table
+  // does not cover it either.
+  if (traversal_depth_limit_ >= 0 && depth >= traversal_depth_limit_) {
+    return;
+  }
   if (state.IsChanceNode()) {
     for (const auto& action_prob : state.ChanceOutcomes()) {
-      InitializeInfostateNodes(*state.Child(action_prob.first));
+      InitializeInfostateNodes(*state.Child(action_prob.first), depth + 1,
+                               table, keys);
     }
     return;
   }
 
   int current_player = state.CurrentPlayer();
+  SPIEL_STATS_INCREMENT(kInfoStateBuilds);
   std::string info_state = state.InformationState(current_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
-  CFRInfoStateValues is_vals(legal_actions);
-  info_states_[info_state] = is_vals;
+  if (table->emplace(info_state, CFRInfoStateValues(legal_actions)).second &&
+      use_info_state_keys_) {
+    keys->emplace_back(state.InformationStateKey(current_player),
+                       std::move(info_state));
+  }
 
   for (const Action& action : legal_actions) {
-    InitializeInfostateNodes(*state.Child(action));
+    InitializeInfostateNodes(*state.Child(action), depth + 1, table, keys);
+  }
+}
+
+void CFRSolverBase::DiscoverInfostateNodes() {
+  std::vector<std::pair<uint64_t, std::string>> key_pairs;
+  if (!root_state_->IsChanceNode()) {
+    // The clones made while walking the tree are transient, so they can be
+    // arena-allocated and reclaimed in bulk once the walk is done.
+    ScopedStateArena scoped_arena(&state_arena_);
+    InitializeInfostateNodes(*root_state_, /*depth=*/0, &info_states_,
+                             &key_pairs);
+    state_arena_.Reset();
+  } else {
+    // The subtrees below the root chance outcomes are independent, so walk
+    // them as one task each on the shared pool, every task filling its own
+    // partial table. Merging in outcome order keeps the result independent
+    // of scheduling; duplicate discoveries of an information state shared
+    // across outcomes are identical fresh entries, so the first insert
+    // wins. As in ParallelUpdatePhase, the arenas are per pool slot.
+    const ActionsAndProbs outcomes = root_state_->ChanceOutcomes();
+    TaskPool* pool = TaskPool::Global();
+    std::vector<CFRInfoStateValuesTable> tables(outcomes.size());
+    std::vector<std::vector<std::pair<uint64_t, std::string>>> keys(
+        outcomes.size());
+    std::vector<StateArena> arenas(pool->NumSlots());
+    {
+      TaskGroup group(pool);
+      for (int oidx = 0; oidx < outcomes.size(); ++oidx) {
+        group.Spawn([this, oidx, pool, &outcomes, &tables, &keys, &arenas]() {
+          StateArena& arena = arenas[pool->CurrentSlot()];
+          ScopedStateArena scoped_arena(&arena);
+          {
+            std::unique_ptr<State> subtree_root =
+                root_state_->Child(outcomes[oidx].first);
+            InitializeInfostateNodes(*subtree_root, /*depth=*/1, &tables[oidx],
+                                     &keys[oidx]);
+          }
+          arena.Reset();
+        });
+      }
+      group.Sync();
+    }
+    for (CFRInfoStateValuesTable& table : tables) {
+      for (auto& entry : table) {
+        info_states_.emplace(entry.first, std::move(entry.second));
+      }
+    }
+    for (std::vector<std::pair<uint64_t, std::string>>& pairs : keys) {
+      for (auto& pair : pairs) key_pairs.push_back(std::move(pair));
+    }
+  }
+  if (use_info_state_keys_) {
+    for (const auto& pair : key_pairs) {
+      key_index_[pair.first] = &info_states_.at(pair.second);
+    }
   }
 }
 
 void CFRSolverBase::EvaluateAndUpdatePolicy() {
   ++iteration_;
   if (alternating_updates_) {
+    ScopedStateArena scoped_arena(&state_arena_);
     for (int player = 0; player < game_.NumPlayers(); player++) {
       ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_,
                                   nullptr);
@@ -140,9 +547,9 @@ void CFRSolverBase::EvaluateAndUpdatePolicy() {
       }
       ApplyRegretMatching();
     }
+    state_arena_.Reset();
   } else {
-    ComputeCounterFactualRegret(*root_state_, std::nullopt, root_reach_probs_,
-                                nullptr);
+    SimultaneousUpdatePhase();
     if (regret_matching_plus_) {
       ApplyRegretMatchingPlusReset();
     }
@@ -150,6 +557,44 @@ void CFRSolverBase::EvaluateAndUpdatePolicy() {
   }
 }
 
+int CFRSolverBase::RunIterations(int num_iterations, TimeBudget* budget) {
+  int done = 0;
+  for (; done < num_iterations; ++done) {
+    if (budget != nullptr && budget->ExpiredNow()) break;
+    EvaluateAndUpdatePolicy();
+  }
+  return done;
+}
+
+void CFRSolverBase::SimultaneousUpdatePhase() {
+  const int num_players = game_.NumPlayers();
+  if (num_players == 1 || leaf_oracle_ != nullptr) {
+    ScopedStateArena scoped_arena(&state_arena_);
+    ComputeCounterFactualRegret(*root_state_, std::nullopt, root_reach_probs_,
+                                nullptr);
+    state_arena_.Reset();
+    return;
+  }
+
+  // One traversal per player; see the declaration for why this is safe.
+  // The arenas are per task here, since each task is one whole traversal.
+  std::vector<CFRDeltaTable> deltas(num_players);
+  std::vector<StateArena> arenas(num_players);
+  {
+    TaskGroup group(TaskPool::Global());
+    for (int player = 0; player < num_players; ++player) {
+      group.Spawn([this, player, &deltas, &arenas]() {
+        ScopedStateArena scoped_arena(&arenas[player]);
+        ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_,
+                                    nullptr, &deltas[player]);
+        arenas[player].Reset();
+      });
+    }
+    group.Sync();
+  }
+  for (CFRDeltaTable& delta : deltas) MergeDeltaTable(&delta);
+}
+
 static double CounterFactualReachProb(
     const std::vector<double>& reach_probabilities, const int player) {
   double cfr_reach_prob = 1.0;
@@ -161,11 +606,38 @@ static double CounterFactualReachProb(
   return cfr_reach_prob;
 }
 
-// Compute counterfactual regrets. Alternates recursively with
-// ComputeCounterFactualRegretForActionProbs.
+namespace {
+
+// One frame of the iterative counterfactual-regret traversal: the state,
+// the per-action probabilities to descend with, the values accumulated so
+// far, and everything the regret/average-policy update needs once all
+// children are done. Chance nodes store their outcomes and distribution in
+// legal_actions/info_state_policy and leave is_vals null.
+struct CFRTraversalFrame {
+  std::unique_ptr<State> state;
+  const State* state_ptr;  // `state`, or the caller's root state.
+  std::vector<double> reach_probabilities;
+  std::vector<double> state_value;
+  std::vector<double> child_utilities;
+  std::vector<double> info_state_policy;
+  std::vector<Action> legal_actions;
+  CFRInfoStateValues* is_vals;
+  const CFRInfoStateValues* prune_entry;
+  int current_player;
+  int next_aidx;
+  int parent;  // Frame index of the parent, or -1 at the root.
+  double prob_into_parent;
+  bool updating_here;
+};
+
+}  // namespace
+
+// Compute counterfactual regrets, iteratively over an explicit frame stack
+// so that the supported game depth is not bounded by the thread stack and
+// the per-node vectors reuse their buffers across the whole traversal.
 //
 // Args:
-// - state: The state to start the recursion.
+// - state: The state to start the traversal.
 // - alternating_player: Optionally only update this player.
 // - reach_probabilities: The reach probabilities of this state for each
 //      player, ending with the chance player.
@@ -175,87 +647,202 @@ static double CounterFactualReachProb(
 std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
     const State& state, const std::optional<int>& alternating_player,
     const std::vector<double>& reach_probabilities,
-    const std::vector<const Policy*>* policy_overrides) {
-  if (state.IsTerminal()) {
-    return state.Returns();
-  }
-  if (state.IsChanceNode()) {
-    ActionsAndProbs actions_and_probs = state.ChanceOutcomes();
-    std::vector<double> dist(actions_and_probs.size(), 0);
-    std::vector<Action> outcomes(actions_and_probs.size(), 0);
-    for (int oidx = 0; oidx < actions_and_probs.size(); ++oidx) {
-      outcomes[oidx] = actions_and_probs[oidx].first;
-      dist[oidx] = actions_and_probs[oidx].second;
+    const std::vector<const Policy*>* policy_overrides,
+    CFRDeltaTable* delta_table) {
+  // Traversals never nest on one thread (parallel updates run one task per
+  // worker, and Sync is only called outside the walk), so the frame storage
+  // can persist per thread and stay warm across iterations.
+  thread_local FrameStack<CFRTraversalFrame> stack;
+  SPIEL_CHECK_TRUE(stack.Empty());
+  std::vector<double> root_value;
+
+  // Classifies the state in the freshly pushed top frame and fills in its
+  // children, mirroring the entry of the former recursion.
+  auto enter = [this, &alternating_player, policy_overrides](
+                   CFRTraversalFrame* frame, int depth) {
+    const State& state = *frame->state_ptr;
+    frame->state_value.assign(game_.NumPlayers(), 0.0);
+    frame->child_utilities.clear();
+    frame->legal_actions.clear();
+    frame->info_state_policy.clear();
+    frame->is_vals = nullptr;
+    frame->prune_entry = nullptr;
+    frame->next_aidx = 0;
+    frame->updating_here = false;
+    if (state.IsTerminal()) {
+      frame->state_value = state.Returns();
+      return;
+    }
+    if (traversal_depth_limit_ >= 0 && depth >= traversal_depth_limit_) {
+      // Depth-limited frontier: the oracle stands in for the unexpanded
+      // subtree. Skipped when no player can reach here, where the value
+      // would be unused anyway.
+      if (!AllPlayersHaveZeroReachProb(frame->reach_probabilities)) {
+        frame->state_value = leaf_oracle_->LeafValues(state);
+        SPIEL_CHECK_EQ(frame->state_value.size(), game_.NumPlayers());
+      }
+      return;
+    }
+    if (state.IsChanceNode()) {
+      ActionsAndProbs actions_and_probs = state.ChanceOutcomes();
+      frame->legal_actions.reserve(actions_and_probs.size());
+      frame->info_state_policy.reserve(actions_and_probs.size());
+      for (const auto& outcome_and_prob : actions_and_probs) {
+        frame->legal_actions.push_back(outcome_and_prob.first);
+        frame->info_state_policy.push_back(outcome_and_prob.second);
+      }
+      frame->current_player = chance_player_;
+      return;
+    }
+    if (AllPlayersHaveZeroReachProb(frame->reach_probabilities)) {
+      // The value is not used: if the reach probability for all players is
+      // 0, then the last taken action has probability 0, so the value does
+      // not impact the parent node value. Leave no children to visit.
+      return;
     }
-    return ComputeCounterFactualRegretForActionProbs(
-        state, alternating_player, reach_probabilities, chance_player_, dist,
-        outcomes, nullptr, policy_overrides);
-  }
-  if (AllPlayersHaveZeroReachProb(reach_probabilities)) {
-    // The value returned is not used: if the reach probability for all players
-    // is 0, then the last taken action has probability 0, so the
-    // returned value is not impacting the parent node value.
-    return std::vector<double>(game_.NumPlayers(), 0.0);
-  }
 
-  int current_player = state.CurrentPlayer();
-  std::string info_state = state.InformationState();
-  std::vector<Action> legal_actions = state.LegalActions(current_player);
+    frame->current_player = state.CurrentPlayer();
+    frame->legal_actions = state.LegalActions(frame->current_player);
+    frame->is_vals = LookupInfoStateValues(state, frame->legal_actions);
+    SPIEL_CHECK_FALSE(frame->is_vals->empty());
 
-  // Load current policy.
-  std::vector<double> info_state_policy;
-  if (policy_overrides && policy_overrides->at(current_player)) {
-    GetInfoStatePolicyFromPolicy(&info_state_policy, legal_actions,
-                                 policy_overrides->at(current_player),
-                                 info_state);
-  } else {
-    info_state_policy = GetPolicy(info_state, legal_actions);
+    // Load current policy.
+    if (policy_overrides && policy_overrides->at(frame->current_player)) {
+      GetInfoStatePolicyFromPolicy(
+          &frame->info_state_policy, frame->legal_actions,
+          policy_overrides->at(frame->current_player),
+          state.InformationState(frame->current_player));
+    } else {
+      frame->info_state_policy.assign(frame->is_vals->current_policy.begin(),
+                                      frame->is_vals->current_policy.end());
+    }
+
+    // Pruning is sound only where the update below happens (the updating
+    // player's own nodes): elsewhere a zero-probability action still carries
+    // average-policy mass for the updating player underneath it. Overridden
+    // policies (CFR-BR) bypass the table regrets, so pruning is disabled, as
+    // it is on the periodic full-revisit iterations.
+    frame->updating_here = !alternating_player ||
+                           *alternating_player == frame->current_player;
+    if (use_regret_based_pruning_ && frame->updating_here &&
+        policy_overrides == nullptr &&
+        iteration_ % prune_revisit_interval_ != 0) {
+      frame->prune_entry = frame->is_vals;
+    }
+    frame->child_utilities.reserve(frame->legal_actions.size());
+  };
+
+  {
+    CFRTraversalFrame& root = stack[stack.Push()];
+    root.state.reset();
+    root.state_ptr = &state;
+    root.reach_probabilities = reach_probabilities;
+    root.parent = -1;
+    root.prob_into_parent = 1.0;
+    enter(&root, /*depth=*/0);
   }
 
-  std::vector<double> child_utilities;
-  child_utilities.reserve(legal_actions.size());
-  const std::vector<double> state_value =
-      ComputeCounterFactualRegretForActionProbs(
-          state, alternating_player, reach_probabilities, current_player,
-          info_state_policy, legal_actions, &child_utilities, policy_overrides);
-
-  // Perform regret and average strategy updates.
-  if (!alternating_player || *alternating_player == current_player) {
-    CFRInfoStateValues is_vals = info_states_[info_state];
-    SPIEL_CHECK_FALSE(is_vals.empty());
-
-    const double self_reach_prob = reach_probabilities[current_player];
-    const double cfr_reach_prob =
-        CounterFactualReachProb(reach_probabilities, current_player);
-
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      // Update regrets.
-      double cfr_regret = cfr_reach_prob *
-                          (child_utilities[aidx] - state_value[current_player]);
+  while (!stack.Empty()) {
+    CFRTraversalFrame& frame = stack.Top();
+    if (frame.next_aidx < frame.legal_actions.size()) {
+      const int aidx = frame.next_aidx++;
+      const double prob = frame.info_state_policy[aidx];
+      if (frame.prune_entry != nullptr &&
+          IsPrunableAction(*frame.prune_entry, frame.info_state_policy,
+                           aidx)) {
+        // Skip the dominated subtree entirely; with zero policy mass it
+        // contributes nothing to the state value. The placeholder child
+        // value is overwritten before updating regrets below.
+        frame.child_utilities.push_back(0);
+        continue;
+      }
+      std::unique_ptr<State> child_state =
+          frame.state_ptr->Child(frame.legal_actions[aidx]);
+      // Push may grow the stack and invalidate `frame`; re-resolve the
+      // parent through its index.
+      const int parent_index = stack.Depth() - 1;
+      CFRTraversalFrame& child = stack[stack.Push()];
+      CFRTraversalFrame& parent = stack[parent_index];
+      child.state = std::move(child_state);
+      child.state_ptr = child.state.get();
+      child.reach_probabilities.assign(parent.reach_probabilities.begin(),
+                                       parent.reach_probabilities.end());
+      child.reach_probabilities[parent.current_player] *= prob;
+      child.parent = parent_index;
+      child.prob_into_parent = prob;
+      // A frame's index in the stack is its ply below the traversal root.
+      enter(&child, /*depth=*/parent_index + 1);
+      continue;
+    }
 
-      is_vals.cumulative_regrets[aidx] += cfr_regret;
+    // All children evaluated; perform regret and average strategy updates.
+    if (frame.updating_here) {
+      // Pruned actions were not evaluated; give them the state value so the
+      // regret update below leaves their cumulative regret unchanged.
+      if (frame.prune_entry != nullptr) {
+        for (int aidx = 0; aidx < frame.legal_actions.size(); ++aidx) {
+          if (IsPrunableAction(*frame.prune_entry, frame.info_state_policy,
+                               aidx)) {
+            frame.child_utilities[aidx] =
+                frame.state_value[frame.current_player];
+          }
+        }
+      }
+      CFRInfoStateValues* is_vals = frame.is_vals;
+      if (delta_table != nullptr) {
+        // Accumulate into this worker's private delta for the entry instead.
+        CFRInfoStateValues& delta = (*delta_table)[is_vals];
+        if (delta.empty()) delta = CFRInfoStateValues(frame.legal_actions);
+        is_vals = &delta;
+      }
+      const double self_reach_prob =
+          frame.reach_probabilities[frame.current_player];
+      const double cfr_reach_prob = CounterFactualReachProb(
+          frame.reach_probabilities, frame.current_player);
+
+      // Update regrets.
+      AccumulateShiftedScaled(
+          is_vals->cumulative_regrets.data(), frame.child_utilities.data(),
+          /*baseline=*/frame.state_value[frame.current_player],
+          /*scale=*/cfr_reach_prob, frame.legal_actions.size());
 
       // Update average policy.
-      if (linear_averaging_) {
-        is_vals.cumulative_policy[aidx] +=
-            iteration_ * self_reach_prob * info_state_policy[aidx];
-      } else {
-        is_vals.cumulative_policy[aidx] +=
-            self_reach_prob * info_state_policy[aidx];
-      }
+      const double policy_scale = linear_averaging_
+                                      ? iteration_ * self_reach_prob
+                                      : self_reach_prob;
+      AccumulateScaled(is_vals->cumulative_policy.data(),
+                       frame.info_state_policy.data(), policy_scale,
+                       frame.legal_actions.size());
     }
 
-    info_states_[info_state] = is_vals;
+    // Fold the state value into the parent and close the frame.
+    frame.state.reset();
+    if (frame.parent < 0) {
+      root_value = std::move(frame.state_value);
+      stack.Pop();
+    } else {
+      CFRTraversalFrame& parent = stack[frame.parent];
+      for (int i = 0; i < frame.state_value.size(); ++i) {
+        parent.state_value[i] += frame.prob_into_parent * frame.state_value[i];
+      }
+      if (parent.is_vals != nullptr) {
+        parent.child_utilities.push_back(
+            frame.state_value[parent.current_player]);
+      }
+      stack.Pop();
+    }
   }
-
-  return state_value;
+  return root_value;
 }
 
 void CFRSolverBase::GetInfoStatePolicyFromPolicy(
     std::vector<double>* info_state_policy,
     const std::vector<Action>& legal_actions, const Policy* policy,
     const std::string& info_state) const {
-  ActionsAndProbs actions_and_probs = policy->GetStatePolicy(info_state);
+  // Reused across calls on this thread, so the lookup stops paying a heap
+  // allocation per node visit.
+  thread_local ActionsAndProbs actions_and_probs;
+  policy->GetStatePolicyInto(info_state, &actions_and_probs);
   info_state_policy->reserve(legal_actions.size());
 
   // The policy may have extra ones not at this infostate
@@ -271,45 +858,28 @@ void CFRSolverBase::GetInfoStatePolicyFromPolicy(
   SPIEL_CHECK_EQ(info_state_policy->size(), legal_actions.size());
 }
 
-// Compute counterfactual regrets given certain action probabilities.
-// Alternates recursively with ComputeCounterFactualRegret.
-//
-// Args:
-// - state: The state to start the recursion.
-// - alternating_player: Optionally only update this player.
-// - reach_probabilities: The reach probabilities of this state.
-// - current_player: Either a player or chance_player_.
-// - action_probs: The action probabilities to use frp this state.
-// - child_values_out: optional output parameter which is filled with the child
-//           utilities for each action, for current_player.
-// Returns:
-//   The value of the state for each player (excluding the chance player).
-std::vector<double> CFRSolverBase::ComputeCounterFactualRegretForActionProbs(
-    const State& state, const std::optional<int>& alternating_player,
-    const std::vector<double>& reach_probabilities, const int current_player,
-    const std::vector<double>& info_state_policy,
-    const std::vector<Action>& legal_actions,
-    std::vector<double>* child_values_out,
-    const std::vector<const Policy*>* policy_overrides) {
-  std::vector<double> state_value(game_.NumPlayers());
-
-  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-    const Action action = legal_actions[aidx];
-    const double prob = info_state_policy[aidx];
-    const std::unique_ptr<State> new_state = state.Child(action);
-    std::vector<double> new_reach_probabilities(reach_probabilities);
-    new_reach_probabilities[current_player] *= prob;
-    std::vector<double> child_value =
-        ComputeCounterFactualRegret(*new_state, alternating_player,
-                                    new_reach_probabilities, policy_overrides);
-    for (int i = 0; i < state_value.size(); ++i) {
-      state_value[i] += prob * child_value[i];
-    }
-    if (child_values_out != nullptr) {
-      child_values_out->push_back(child_value[current_player]);
-    }
+void CFRSolverBase::MergeDeltaTable(CFRDeltaTable* delta_table) {
+  // Merge in the shared entries' address order: after CompactTableStorage
+  // the targets live consecutively in the flat buffer, so this turns the
+  // merge into one sequential stream over it instead of hash-order
+  // random access.
+  std::vector<CFRDeltaTable::value_type*> merge_order;
+  merge_order.reserve(delta_table->size());
+  for (auto& entry : *delta_table) merge_order.push_back(&entry);
+  std::sort(merge_order.begin(), merge_order.end(),
+            [](const CFRDeltaTable::value_type* a,
+               const CFRDeltaTable::value_type* b) {
+              return std::less<CFRInfoStateValues*>()(a->first, b->first);
+            });
+  for (CFRDeltaTable::value_type* entry : merge_order) {
+    CFRInfoStateValues* shared = entry->first;
+    const CFRInfoStateValues& delta = entry->second;
+    Accumulate(shared->cumulative_regrets.data(),
+               delta.cumulative_regrets.data(), shared->num_actions());
+    Accumulate(shared->cumulative_policy.data(),
+               delta.cumulative_policy.data(), shared->num_actions());
   }
-  return state_value;
+  delta_table->clear();
 }
 
 bool CFRSolverBase::AllPlayersHaveZeroReachProb(
@@ -322,6 +892,32 @@ bool CFRSolverBase::AllPlayersHaveZeroReachProb(
   return true;
 }
 
+CFRInfoStateValues* CFRSolverBase::LookupInfoStateValues(
+    const State& state, const std::vector<Action>& legal_actions) {
+  if (use_info_state_keys_) {
+    const uint64_t key = state.InformationStateKey();
+    auto entry = key_index_.find(key);
+    if (entry != key_index_.end()) {
+      return entry->second;
+    }
+    CFRInfoStateValues* is_vals =
+        &(info_states_[state.InformationState()] =
+              CFRInfoStateValues(legal_actions));
+    key_index_[key] = is_vals;
+    return is_vals;
+  }
+
+  SPIEL_STATS_INCREMENT(kInfoStateBuilds);
+  std::string info_state = state.InformationState();
+  auto entry = info_states_.find(info_state);
+  if (entry == info_states_.end()) {
+    entry = info_states_
+                .emplace(std::move(info_state), CFRInfoStateValues(legal_actions))
+                .first;
+  }
+  return &entry->second;
+}
+
 std::vector<double> CFRSolverBase::GetPolicy(
     const std::string& info_state, const std::vector<Action>& legal_actions) {
   auto entry = info_states_.find(info_state);
@@ -333,27 +929,23 @@ std::vector<double> CFRSolverBase::GetPolicy(
   SPIEL_CHECK_FALSE(entry == info_states_.end());
   SPIEL_CHECK_FALSE(entry->second.empty());
   SPIEL_CHECK_FALSE(entry->second.current_policy.empty());
-  return entry->second.current_policy;
+  return std::vector<double>(entry->second.current_policy.begin(),
+                             entry->second.current_policy.end());
 }
 
 void CFRInfoStateValues::ApplyRegretMatching() {
-  double sum_positive_regrets = 0.0;
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (cumulative_regrets[aidx] > 0) {
-      sum_positive_regrets += cumulative_regrets[aidx];
-    }
-  }
+  SPIEL_STATS_INCREMENT(kRegretMatchingCalls);
+  RegretMatchingPolicy(cumulative_regrets.data(), num_actions(),
+                       current_policy.data());
+}
 
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (sum_positive_regrets > 0) {
-      current_policy[aidx] =
-          cumulative_regrets[aidx] > 0
-              ? cumulative_regrets[aidx] / sum_positive_regrets
-              : 0;
-    } else {
-      current_policy[aidx] = 1.0 / legal_actions.size();
-    }
+void CFRInfoStateValues::RebindTo(CFRValue* data) {
+  const int n = num_actions();
+  for (int i = 0; i < 3 * n; ++i) {
+    data[i] = storage_[i];
   }
+  BindRows(data);
+  std::vector<CFRValue>().swap(storage_);
 }
 
 int CFRInfoStateValues::SampleActionIndex(double epsilon, double z) {
@@ -369,6 +961,68 @@ int CFRInfoStateValues::SampleActionIndex(double epsilon, double z) {
   SpielFatalError(absl::StrCat("SampleActionIndex: sum of probs is ", sum));
 }
 
+ParallelCFRSolver::ParallelCFRSolver(const Game& game, int num_threads,
+                                     bool pin_threads)
+    : CFRSolverBase(game,
+                    /*alternating_updates=*/true,
+                    /*linear_averaging=*/false,
+                    /*regret_matching_plus=*/false),
+      num_threads_(num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (pin_threads) TaskPool::Global()->PinWorkers();
+}
+
+void ParallelCFRSolver::EvaluateAndUpdatePolicy() {
+  ++iteration_;
+  for (int player = 0; player < game_.NumPlayers(); player++) {
+    ParallelUpdatePhase(player);
+    ApplyRegretMatching();
+  }
+}
+
+void ParallelCFRSolver::ParallelUpdatePhase(
+    const std::optional<int>& alternating_player) {
+  if (!root_state_->IsChanceNode() || num_threads_ == 1) {
+    ScopedStateArena scoped_arena(&state_arena_);
+    ComputeCounterFactualRegret(*root_state_, alternating_player,
+                                root_reach_probs_, nullptr);
+    state_arena_.Reset();
+    return;
+  }
+
+  // One task per root chance outcome on the shared pool; each accumulates
+  // into its own delta table, merged in outcome order afterwards so the
+  // result does not depend on which worker ran what. The arenas are per
+  // pool slot (one task runs on a slot at a time), so their blocks are
+  // reused across the outcomes a worker processes.
+  const ActionsAndProbs outcomes = root_state_->ChanceOutcomes();
+  const int chance_player = game_.NumPlayers();
+  TaskPool* pool = TaskPool::Global();
+  std::vector<CFRDeltaTable> deltas(outcomes.size());
+  std::vector<StateArena> arenas(pool->NumSlots());
+  {
+    TaskGroup group(pool);
+    for (int oidx = 0; oidx < outcomes.size(); ++oidx) {
+      group.Spawn([this, oidx, pool, &outcomes, &deltas, &arenas,
+                   chance_player, &alternating_player]() {
+        StateArena& arena = arenas[pool->CurrentSlot()];
+        ScopedStateArena scoped_arena(&arena);
+        {
+          std::unique_ptr<State> subtree_root =
+              root_state_->Child(outcomes[oidx].first);
+          std::vector<double> reach_probs = root_reach_probs_;
+          reach_probs[chance_player] *= outcomes[oidx].second;
+          ComputeCounterFactualRegret(*subtree_root, alternating_player,
+                                      reach_probs, nullptr, &deltas[oidx]);
+        }
+        arena.Reset();
+      });
+    }
+    group.Sync();
+  }
+  for (CFRDeltaTable& delta : deltas) MergeDeltaTable(&delta);
+}
+
 //  Resets negative cumulative regrets to 0.
 //
 //  Regret Matching+ corresponds to the following cumulative regrets update:
@@ -393,5 +1047,31 @@ void CFRSolverBase::ApplyRegretMatching() {
   }
 }
 
+void DCFRSolver::EvaluateAndUpdatePolicy() {
+  CFRSolverBase::EvaluateAndUpdatePolicy();
+  ApplyDiscounting();
+}
+
+// Scales the table after iteration t so that iteration t's (undiscounted)
+// contribution ends up with the DCFR weight relative to later iterations.
+// All positive regrets at an information state share one factor, so the
+// current policy already computed by regret matching stays valid.
+void DCFRSolver::ApplyDiscounting() {
+  const double t = iteration_;
+  const double positive_scale =
+      std::pow(t, alpha_) / (std::pow(t, alpha_) + 1.0);
+  const double negative_scale = std::pow(t, beta_) / (std::pow(t, beta_) + 1.0);
+  const double policy_scale = std::pow(t / (t + 1.0), gamma_);
+  for (auto& entry : info_states_) {
+    CFRInfoStateValues& is_vals = entry.second;
+    for (int aidx = 0; aidx < is_vals.num_actions(); ++aidx) {
+      is_vals.cumulative_regrets[aidx] *=
+          is_vals.cumulative_regrets[aidx] > 0 ? positive_scale
+                                               : negative_scale;
+      is_vals.cumulative_policy[aidx] *= policy_scale;
+    }
+  }
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -21,16 +21,83 @@
 namespace open_spiel {
 namespace algorithms {
 
+// Storage type of the solver tables. Compiling with
+// -DOPEN_SPIEL_CFR_FLOAT32_VALUES stores regrets and policies as float32,
+// halving the table footprint and the memory traffic of the per-iteration
+// sweeps (which is what limits iteration speed on huge tables); all
+// arithmetic still happens in double, only the stored values round.
+// Checkpoints are written in double either way, so files move between the
+// two builds.
+#ifdef OPEN_SPIEL_CFR_FLOAT32_VALUES
+using CFRValue = float;
+#else
+using CFRValue = double;
+#endif
+
+// Cache-line size assumed by the value-table layouts: the flat backing
+// store pads entries to line boundaries and the parallel solvers pad
+// their lock stripes, so that threads updating different entries never
+// write the same line.
+inline constexpr int kCacheLineBytes = 64;
+
+// A view of one contiguous row of values inside a backing store. Indexable
+// and sized like the std::vector it replaces, but not owning.
+class CFRValueRow {
+ public:
+  CFRValueRow() {}
+  CFRValueRow(CFRValue* data, int size) : data_(data), size_(size) {}
+
+  CFRValue& operator[](int i) { return data_[i]; }
+  CFRValue operator[](int i) const { return data_[i]; }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  CFRValue* data() { return data_; }
+  const CFRValue* data() const { return data_; }
+  CFRValue* begin() { return data_; }
+  CFRValue* end() { return data_ + size_; }
+  const CFRValue* begin() const { return data_; }
+  const CFRValue* end() const { return data_ + size_; }
+
+ private:
+  CFRValue* data_ = nullptr;
+  int size_ = 0;
+};
+
 // A basic structure to store the relevant quantities.
+//
+// The three value rows (cumulative regrets, cumulative policy, current
+// policy) live back-to-back in a single buffer: by default a per-entry
+// allocation, or a slice of a table-wide flat backing store after
+// RebindTo() (see CFRSolverBase). Copies always own their storage.
 struct CFRInfoStateValues {
   CFRInfoStateValues() {}
   CFRInfoStateValues(std::vector<Action> la, double init_value)
-      : legal_actions(la),
-        cumulative_regrets(la.size(), init_value),
-        cumulative_policy(la.size(), init_value),
-        current_policy(la.size(), 1.0 / la.size()) {}
+      : legal_actions(la), storage_(3 * la.size(), init_value) {
+    BindRows(storage_.data());
+    for (int aidx = 0; aidx < num_actions(); ++aidx) {
+      current_policy[aidx] = 1.0 / num_actions();
+    }
+  }
   CFRInfoStateValues(std::vector<Action> la) : CFRInfoStateValues(la, 0) {}
 
+  CFRInfoStateValues(const CFRInfoStateValues& other)
+      : legal_actions(other.legal_actions),
+        storage_(3 * other.legal_actions.size()) {
+    BindRows(storage_.data());
+    CopyValuesFrom(other);
+  }
+  CFRInfoStateValues& operator=(const CFRInfoStateValues& other) {
+    if (this == &other) return *this;
+    legal_actions = other.legal_actions;
+    storage_.assign(3 * legal_actions.size(), 0);
+    BindRows(storage_.data());
+    CopyValuesFrom(other);
+    return *this;
+  }
+  // Moving transfers the buffer (or the external binding) as-is.
+  CFRInfoStateValues(CFRInfoStateValues&&) = default;
+  CFRInfoStateValues& operator=(CFRInfoStateValues&&) = default;
+
   void ApplyRegretMatching();  // Fills current_policy.
   bool empty() const { return legal_actions.empty(); }
   int num_actions() const { return legal_actions.size(); }
@@ -39,16 +106,70 @@ struct CFRInfoStateValues {
   // exploration (mixing in uniform).
   int SampleActionIndex(double epsilon, double z);
 
-  std::vector<Action> legal_actions;
-  std::vector<double> cumulative_regrets;
-  std::vector<double> cumulative_policy;
-  std::vector<double> current_policy;
+  // Re-points this entry's rows at `data` (3 * num_actions() values),
+  // copying the current values there and releasing the entry's own buffer.
+  // The caller keeps `data` alive for the lifetime of the entry.
+  void RebindTo(CFRValue* data);
+
+  // Estimated heap bytes this entry holds beyond the object itself: the
+  // owned value buffer (empty after RebindTo) and any heap spill of the
+  // legal-actions vector.
+  int64_t MemoryBytes() const {
+    return storage_.capacity() * sizeof(CFRValue) +
+           update_ema.capacity() * sizeof(CFRValue) +
+           legal_actions.HeapBytes();
+  }
+
+  // Inline storage for the common case of a handful of legal actions; see
+  // SmallVector in spiel_utils.h.
+  SmallVector<Action, 8> legal_actions;
+  CFRValueRow cumulative_regrets;
+  CFRValueRow cumulative_policy;
+  CFRValueRow current_policy;
+
+  // Exponential moving average, per action, of how much regret the
+  // action's subtree has recently moved. Only the adaptive sampling mode
+  // of ExternalSamplingMCCFRSolver allocates and maintains it; it is a
+  // sampling heuristic, not part of the solution, so it is not
+  // checkpointed or synchronized.
+  std::vector<CFRValue> update_ema;
+
+ private:
+  void BindRows(CFRValue* data) {
+    const int n = legal_actions.size();
+    cumulative_regrets = CFRValueRow(data, n);
+    cumulative_policy = CFRValueRow(data + n, n);
+    current_policy = CFRValueRow(data + 2 * n, n);
+  }
+  void CopyValuesFrom(const CFRInfoStateValues& other) {
+    for (int aidx = 0; aidx < num_actions(); ++aidx) {
+      cumulative_regrets[aidx] = other.cumulative_regrets[aidx];
+      cumulative_policy[aidx] = other.cumulative_policy[aidx];
+      current_policy[aidx] = other.current_policy[aidx];
+    }
+    update_ema = other.update_ema;
+  }
+
+  std::vector<CFRValue> storage_;
 };
 
 // A type for tables holding CFR values.
 using CFRInfoStateValuesTable =
     std::unordered_map<std::string, CFRInfoStateValues>;
 
+// An index over a CFRInfoStateValuesTable keyed on the compact integer keys
+// from State::InformationStateKey, avoiding the string construction and
+// hashing otherwise paid at every node visit. The mapped pointers refer to
+// entries owned by the string-keyed table, which is node-stable.
+using CFRInfoStateKeyTable = std::unordered_map<uint64_t, CFRInfoStateValues*>;
+
+// A private accumulation table for one worker thread of a parallel solver,
+// keyed on the shared table entry it will be merged into. Regret and average
+// policy updates are additive within an iteration, so workers can accumulate
+// into deltas and merge at the end of the phase without locking.
+using CFRDeltaTable =
+    std::unordered_map<CFRInfoStateValues*, CFRInfoStateValues>;
+
 // A policy that extracts the average policy from the CFR table values, which
 // can be passed to tabular exploitability.
 class CFRAveragePolicy : public Policy {
@@ -67,6 +188,14 @@ class CFRAveragePolicy : public Policy {
   std::shared_ptr<TabularPolicy> default_policy_;
 };
 
+// Writes the average policy for every info state in the table to `filename`
+// in the ExportPolicyToFile container (see policy.h), normalizing the
+// cumulative policy the same way CFRAveragePolicy does. Read it back on
+// the other machine with ImportPolicyFromFile.
+void ExportAveragePolicyToFile(const CFRInfoStateValuesTable& info_states,
+                               const std::string& filename,
+                               const PolicyExportOptions& options = {});
+
 // A policy that extracts the current policy from the CFR table values.
 class CFRCurrentPolicy : public Policy {
  public:
@@ -82,6 +211,25 @@ class CFRCurrentPolicy : public Policy {
   std::shared_ptr<TabularPolicy> default_policy_;
 };
 
+// Supplies values for the depth-limited frontier of a CFR traversal: an
+// estimate of the expected returns (one per player) of `state` when play
+// continues below it under both players' current strategies. Implementations
+// range from tabular caches over rollout estimates to batched neural
+// evaluators; MakeRolloutLeafValueOracle is a simple built-in.
+class LeafValueOracle {
+ public:
+  virtual ~LeafValueOracle() = default;
+  virtual std::vector<double> LeafValues(const State& state) = 0;
+};
+
+// A LeafValueOracle averaging the returns of `num_rollouts` playouts per
+// leaf, sampling chance by its outcome probabilities and decisions
+// uniformly. Every leaf's rollouts use a stream derived from the seed and
+// the leaf's history, so the values are reproducible regardless of the
+// order or concurrency of the traversal that queries them.
+std::unique_ptr<LeafValueOracle> MakeRolloutLeafValueOracle(int num_rollouts,
+                                                            int seed);
+
 // Base class supporting different flavours of the Counterfactual Regret
 // Minimization (CFR) algorithm.
 //
@@ -99,13 +247,62 @@ class CFRCurrentPolicy : public Policy {
 //
 class CFRSolverBase {
  public:
+  // With `depth_limit >= 0`, traversals walk at most that many moves
+  // (counting chance) below the root and ask `leaf_oracle` for the value of
+  // each non-terminal frontier state instead of recursing; regrets and
+  // average policy below the frontier are neither created nor updated, so
+  // the table only covers the truncated game. The oracle must outlive the
+  // solver.
+  //
+  // With a non-empty `skeleton_filename`, the information-state table is
+  // read from a file written by SaveTableSkeleton instead of being
+  // discovered by walking the game, so repeat runs skip the discovery pass
+  // entirely. The file must come from a solver constructed for the same
+  // game and depth limit.
   CFRSolverBase(const Game& game, bool alternating_updates,
-                bool linear_averaging, bool regret_matching_plus);
+                bool linear_averaging, bool regret_matching_plus,
+                int depth_limit = -1, LeafValueOracle* leaf_oracle = nullptr,
+                const std::string& skeleton_filename = "");
   virtual ~CFRSolverBase() = default;
 
   // Performs one step of the CFR algorithm.
   virtual void EvaluateAndUpdatePolicy();
 
+  // Runs up to `num_iterations` steps, checking `budget` between them
+  // and stopping early once it expires. A CFR step is one full tree
+  // pass, so expiry granularity is one iteration; the table then simply
+  // holds the progress so far and a later call resumes from it. Returns
+  // the number of steps actually run.
+  int RunIterations(int num_iterations, TimeBudget* budget = nullptr);
+
+  // Writes the complete solver state (iteration counter plus the cumulative
+  // regrets, cumulative policy and current policy of every information
+  // state) to `filename` in a compact binary format, using bulk writes of
+  // the value arrays so that checkpointing large tables is I/O-bound.
+  void SaveCheckpoint(const std::string& filename) const;
+
+  // Restores the state written by SaveCheckpoint. The solver must have been
+  // constructed for the same game and parameters; unknown information states
+  // or mismatched action counts are fatal errors.
+  void LoadCheckpoint(const std::string& filename);
+
+  // Writes the table skeleton (every information state with its legal
+  // actions and, where the game provides them, its compact integer key) to
+  // `filename`. Unlike a checkpoint this holds no values; pass the file as
+  // `skeleton_filename` when constructing a solver for the same game to
+  // skip the discovery walk.
+  void SaveTableSkeleton(const std::string& filename) const;
+
+  // Enables regret-based pruning: while updating a player, actions at their
+  // information states whose current policy mass is zero and whose cumulative
+  // regret is below `regret_threshold` (a negative value) are not recursed
+  // into. Every `revisit_interval` iterations a full traversal is performed
+  // so that actions whose regret recovers re-enter the policy. This is an
+  // approximation: regrets below a pruned branch go stale until the next
+  // revisit, but dominated actions rarely return and the average policy
+  // still converges in practice, at a fraction of the per-iteration cost.
+  void EnableRegretBasedPruning(double regret_threshold, int revisit_interval);
+
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
   // the CFRSolver object.
@@ -113,6 +310,26 @@ class CFRSolverBase {
     return std::unique_ptr<Policy>(new CFRAveragePolicy(info_states_, nullptr));
   }
 
+  // As above, but information states absent from the table fall back to
+  // `default_policy`. A depth-limited solver's table only covers states above
+  // the traversal frontier, so evaluators that walk the full game (e.g.
+  // exploitability) need a fallback for the states below it.
+  std::unique_ptr<Policy> AveragePolicy(
+      std::shared_ptr<TabularPolicy> default_policy) const {
+    return std::unique_ptr<Policy>(
+        new CFRAveragePolicy(info_states_, std::move(default_policy)));
+  }
+
+  // Writes the average policy to `filename` in the ExportPolicyToFile
+  // container, for analysis on another machine; see
+  // ExportAveragePolicyToFile. Unlike SaveCheckpoint this drops the
+  // regrets, so the result can be imported as a plain TabularPolicy but
+  // cannot resume training.
+  void ExportAveragePolicy(const std::string& filename,
+                           const PolicyExportOptions& options = {}) const {
+    ExportAveragePolicyToFile(info_states_, filename, options);
+  }
+
   // Computes the current policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
   // the CFRSolver object.
@@ -120,12 +337,30 @@ class CFRSolverBase {
     return std::unique_ptr<Policy>(new CFRCurrentPolicy(info_states_, nullptr));
   }
 
+  // As above, with a fallback for information states absent from the table.
+  std::unique_ptr<Policy> CurrentPolicy(
+      std::shared_ptr<TabularPolicy> default_policy) const {
+    return std::unique_ptr<Policy>(
+        new CFRCurrentPolicy(info_states_, std::move(default_policy)));
+  }
+
+  // Estimated bytes held by the information-state table: keys, entries,
+  // value rows, and the flat backing store when the values have been moved
+  // there. Publishes the figure to the kCfrTableBytes gauge (spiel_utils.h)
+  // so capacity planning has ground truth without polling the solver.
+  int64_t TableMemoryBytes() const;
+
  protected:
   const Game& game_;
 
   // Iteration to support linear_policy.
   int iteration_ = 0;
   CFRInfoStateValuesTable info_states_;
+
+  // Arena that the transient state clones made during tree traversals are
+  // allocated from; bulk-reset after every iteration.
+  StateArena state_arena_;
+
   const std::unique_ptr<State> root_state_;
   const std::vector<double> root_reach_probs_;
 
@@ -136,24 +371,77 @@ class CFRSolverBase {
   // will disable this feature. Otherwise it should be a [num_players] vector,
   // and if `policy_overrides[p] != nullptr` it will be used instead of the
   // current policy. This feature exists to support CFR-BR.
+  // If `delta_table` is non-null, regret and average-policy updates are
+  // accumulated there instead of in the shared table; current policies are
+  // still read (but never written) from the shared table, so concurrent
+  // traversals over disjoint subtrees are safe provided all information
+  // states were created up front (which InitializeInfostateNodes does).
   std::vector<double> ComputeCounterFactualRegret(
       const State& state, const std::optional<int>& alternating_player,
       const std::vector<double>& reach_probabilities,
-      const std::vector<const Policy*>* policy_overrides);
+      const std::vector<const Policy*>* policy_overrides,
+      CFRDeltaTable* delta_table = nullptr);
+
+  // Adds the accumulated updates in `delta_table` into the shared table and
+  // clears it.
+  void MergeDeltaTable(CFRDeltaTable* delta_table);
 
   // Update the current policy for all information states.
   void ApplyRegretMatching();
 
+  // One simultaneous-updates traversal phase. The per-player traversals
+  // only write their own player's (disjoint) regret and average-policy
+  // entries and all read the same current policy, which nothing writes
+  // until the regret matching that follows the phase; they therefore run
+  // concurrently, one task per player on the shared TaskPool, each
+  // accumulating into a private delta table merged in player order. Single
+  // player games and depth-limited solvers (whose leaf oracle need not be
+  // thread-safe) use one serial traversal instead.
+  void SimultaneousUpdatePhase();
+
  private:
-  std::vector<double> ComputeCounterFactualRegretForActionProbs(
-      const State& state, const std::optional<int>& alternating_player,
-      const std::vector<double>& reach_probabilities, const int current_player,
-      const std::vector<double>& info_state_policy,
-      const std::vector<Action>& legal_actions,
-      std::vector<double>* child_values_out,
-      const std::vector<const Policy*>* policy_overrides);
+  // Returns whether action index `aidx` of `entry` may be pruned this
+  // traversal: zero current policy mass and cumulative regret below the
+  // pruning threshold.
+  bool IsPrunableAction(const CFRInfoStateValues& entry,
+                        const std::vector<double>& info_state_policy,
+                        int aidx) const {
+    return info_state_policy[aidx] == 0.0 &&
+           entry.cumulative_regrets[aidx] < prune_regret_threshold_;
+  }
 
-  void InitializeInfostateNodes(const State& state);
+  // Walks the subtree below `state`, adding every information state found
+  // to `table` and, when the game provides integer keys, recording
+  // (integer key, info state) pairs in `keys`. Writing to caller-supplied
+  // containers lets independent subtrees be walked concurrently.
+  void InitializeInfostateNodes(
+      const State& state, int depth, CFRInfoStateValuesTable* table,
+      std::vector<std::pair<uint64_t, std::string>>* keys);
+
+  // Discovers the information-state table by walking the game, with the
+  // root chance outcomes (when the root is a chance node) walked as
+  // independent tasks on the shared TaskPool and their partial tables
+  // merged afterwards.
+  void DiscoverInfostateNodes();
+
+  // Fills the table from the cached per-game LegalActionsIndex instead of
+  // walking the game; used when the integer key index is not needed.
+  void InitializeInfostateNodesFromIndex();
+
+  // Fills the table from a file written by SaveTableSkeleton.
+  void LoadTableSkeleton(const std::string& filename);
+
+  // Moves the values of every table entry into one contiguous flat buffer
+  // (structure-of-arrays across entries), replacing the per-entry
+  // allocations. Called once the discovery pass has sized the table; entries
+  // created later fall back to owning their storage.
+  void CompactTableStorage();
+
+  // Returns the table entry for the state's current information state,
+  // creating it if missing. Looks up by integer key when the game provides
+  // one, and by InformationState() string otherwise.
+  CFRInfoStateValues* LookupInfoStateValues(
+      const State& state, const std::vector<Action>& legal_actions);
 
   // Fills `info_state_policy` to be a [num_actions] vector of the probabilities
   // found in `policy` at the given `info_state`.
@@ -175,11 +463,28 @@ class CFRSolverBase {
   bool AllPlayersHaveZeroReachProb(
       const std::vector<double>& reach_probabilities) const;
 
+  // Integer-keyed index into info_states_, populated only when the game
+  // provides compact information-state keys.
+  CFRInfoStateKeyTable key_index_;
+
+  // Flat backing store for the table values; see CompactTableStorage().
+  std::vector<CFRValue> flat_values_;
+  const bool use_info_state_keys_;
+
+  // Regret-based pruning parameters; see EnableRegretBasedPruning().
+  bool use_regret_based_pruning_ = false;
+  double prune_regret_threshold_ = 0.0;
+  int prune_revisit_interval_ = 1;
+
   const bool regret_matching_plus_;
   const bool alternating_updates_;
   const bool linear_averaging_;
 
   const int chance_player_;
+
+  // Depth-limited mode; see the constructor comment.
+  const int traversal_depth_limit_;
+  LeafValueOracle* const leaf_oracle_;
 };
 
 // Standard CFR implementation.
@@ -187,11 +492,27 @@ class CFRSolverBase {
 // See https://poker.cs.ualberta.ca/publications/NIPS07-cfr.pdf
 class CFRSolver : public CFRSolverBase {
  public:
-  explicit CFRSolver(const Game& game)
+  // With `alternating_updates` false the solver uses simultaneous updates,
+  // whose per-player traversals run concurrently over an immutable snapshot
+  // of the current policy; see SimultaneousUpdatePhase.
+  explicit CFRSolver(const Game& game, bool alternating_updates = true)
+      : CFRSolverBase(game, alternating_updates,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {}
+
+  // Depth-limited CFR; see the CFRSolverBase constructor.
+  CFRSolver(const Game& game, int depth_limit, LeafValueOracle* leaf_oracle)
       : CFRSolverBase(game,
                       /*alternating_updates=*/true,
                       /*linear_averaging=*/false,
-                      /*regret_matching_plus=*/false) {}
+                      /*regret_matching_plus=*/false, depth_limit,
+                      leaf_oracle) {}
+
+  // Resumes from a checkpoint written by SaveCheckpoint.
+  CFRSolver(const Game& game, const std::string& checkpoint_filename)
+      : CFRSolver(game) {
+    LoadCheckpoint(checkpoint_filename);
+  }
 };
 
 // CFR+ implementation.
@@ -209,6 +530,97 @@ class CFRPlusSolver : public CFRSolverBase {
                       /*alternating_updates=*/true,
                       /*linear_averaging=*/true,
                       /*regret_matching_plus=*/true) {}
+
+  // Depth-limited CFR+; see the CFRSolverBase constructor.
+  CFRPlusSolver(const Game& game, int depth_limit,
+                LeafValueOracle* leaf_oracle)
+      : CFRSolverBase(game,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/true,
+                      /*regret_matching_plus=*/true, depth_limit,
+                      leaf_oracle) {}
+
+  // Resumes from a checkpoint written by SaveCheckpoint.
+  CFRPlusSolver(const Game& game, const std::string& checkpoint_filename)
+      : CFRPlusSolver(game) {
+    LoadCheckpoint(checkpoint_filename);
+  }
+};
+
+// Discounted CFR (DCFR).
+//
+// See https://arxiv.org/abs/1809.04040
+//
+// Vanilla CFR weighs every iteration equally, so the poor early iterations
+// linger in the cumulative regrets and average policy. DCFR discounts them:
+// after iteration t, positive cumulative regrets are scaled by
+// t^alpha / (t^alpha + 1), negative ones by t^beta / (t^beta + 1), and the
+// cumulative policy by (t / (t + 1))^gamma. The defaults (alpha = 3/2,
+// beta = 0, gamma = 2) are the paper's recommended variant; alpha = beta =
+// gamma = 1 recovers Linear CFR. Positive regrets share one scale factor per
+// iteration, so the current policy regret matching produces is unchanged by
+// the discounting itself.
+class DCFRSolver : public CFRSolverBase {
+ public:
+  explicit DCFRSolver(const Game& game, double alpha = 1.5, double beta = 0.0,
+                      double gamma = 2.0)
+      : CFRSolverBase(game,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false),
+        alpha_(alpha),
+        beta_(beta),
+        gamma_(gamma) {}
+
+  // Resumes from a checkpoint written by SaveCheckpoint.
+  DCFRSolver(const Game& game, const std::string& checkpoint_filename)
+      : DCFRSolver(game) {
+    LoadCheckpoint(checkpoint_filename);
+  }
+
+  void EvaluateAndUpdatePolicy() override;
+
+ private:
+  void ApplyDiscounting();
+
+  const double alpha_;
+  const double beta_;
+  const double gamma_;
+};
+
+// Linear CFR: every iteration's contribution to the cumulative regrets and
+// average policy is weighted by the iteration number, implemented as
+// DCFR with alpha = beta = gamma = 1.
+class LinearCFRSolver : public DCFRSolver {
+ public:
+  explicit LinearCFRSolver(const Game& game)
+      : DCFRSolver(game, /*alpha=*/1.0, /*beta=*/1.0, /*gamma=*/1.0) {}
+};
+
+// Standard CFR with the per-iteration tree walk parallelized across the root
+// chance outcomes, scheduled as one task per outcome on the shared
+// TaskPool. Each task accumulates its regret and average-policy updates
+// into a private CFRDeltaTable; the deltas are merged into the shared
+// table in outcome order at the end of each update phase, so the result
+// does not depend on scheduling and matches CFRSolver up to
+// floating-point summation order. Games whose root is not a chance node,
+// and num_threads == 1, fall back to the serial walk.
+class ParallelCFRSolver : public CFRSolverBase {
+ public:
+  // With `pin_threads` the shared pool's workers are pinned to their CPUs
+  // (TaskPool::PinWorkers), so on multi-socket machines the per-slot delta
+  // tables and arenas stay on each worker's own memory node across
+  // iterations instead of migrating with the scheduler. Leave it off on
+  // shared machines.
+  ParallelCFRSolver(const Game& game, int num_threads,
+                    bool pin_threads = false);
+
+  void EvaluateAndUpdatePolicy() override;
+
+ private:
+  void ParallelUpdatePhase(const std::optional<int>& alternating_player);
+
+  const int num_threads_;
 };
 
 }  // namespace algorithms
@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/cfr_br.h"
 
+#include <string>
+#include <unordered_set>
+
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/policy.h"
 
@@ -33,6 +36,41 @@ CFRBRSolver::CFRBRSolver(const Game& game)
   }
 }
 
+std::unordered_set<std::string> CFRBRSolver::ChangedInfostates() {
+  std::unordered_set<std::string> changed;
+  for (const auto& infostate_and_values : info_states_) {
+    const CFRValueRow& current = infostate_and_values.second.current_policy;
+    auto it = previous_policies_.find(infostate_and_values.first);
+    bool differs = false;
+    if (it == previous_policies_.end()) {
+      // Never seen by the responders except as uniform (both the policy
+      // they were constructed with and the value regret matching assigns
+      // before any regret accumulates).
+      const double uniform = 1.0 / current.size();
+      for (int aidx = 0; aidx < current.size(); ++aidx) {
+        if (current[aidx] != uniform) {
+          differs = true;
+          break;
+        }
+      }
+      if (differs) {
+        previous_policies_[infostate_and_values.first].assign(current.begin(),
+                                                              current.end());
+      }
+    } else {
+      for (int aidx = 0; aidx < current.size(); ++aidx) {
+        if (current[aidx] != it->second[aidx]) {
+          differs = true;
+          break;
+        }
+      }
+      if (differs) it->second.assign(current.begin(), current.end());
+    }
+    if (differs) changed.insert(infostate_and_values.first);
+  }
+  return changed;
+}
+
 void CFRBRSolver::EvaluateAndUpdatePolicy() {
   ++iteration_;
 
@@ -40,12 +78,16 @@ void CFRBRSolver::EvaluateAndUpdatePolicy() {
   std::unique_ptr<Policy> current_policy = CurrentPolicy();
 
   // Set all the player's policies first.
-  for (int p = 0; p < game_.NumPlayers(); ++p) {
-    // Need to have an exception here because the CFR policy objects are
-    // wrappers around information that is contained in a table, and those do
-    // not exist until there's been a tree traversal to compute regrets below.
-    if (iteration_ > 1) {
-      best_response_computers_[p]->SetPolicy(current_policy.get());
+  // Need to have an exception here because the CFR policy objects are
+  // wrappers around information that is contained in a table, and those do
+  // not exist until there's been a tree traversal to compute regrets below.
+  if (iteration_ > 1) {
+    // The responders keep their trees, infoset maps and cached values; only
+    // the infostates whose policy actually moved since they last looked are
+    // invalidated (see the incremental SetPolicy in best_response.h).
+    const std::unordered_set<std::string> changed = ChangedInfostates();
+    for (int p = 0; p < game_.NumPlayers(); ++p) {
+      best_response_computers_[p]->SetPolicy(current_policy.get(), changed);
     }
   }
 
@@ -16,6 +16,10 @@
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_BR_H_
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
@@ -37,11 +41,24 @@ class CFRBRSolver : public CFRSolverBase {
   void EvaluateAndUpdatePolicy() override;
 
  private:
+  // Returns the information states whose current policy differs from the
+  // one the best responders last saw, updating the snapshot as it goes.
+  std::unordered_set<std::string> ChangedInfostates();
+
   // Policies that are used instead of the current policy for some the opponent
   // players.
   std::vector<const Policy*> policy_overrides_;
   TabularPolicy uniform_policy_;
+
+  // One persistent best responder per player; their trees, infoset maps and
+  // subtree bounds are built once and refreshed between iterations through
+  // the incremental SetPolicy, driven by the snapshot below.
   std::vector<std::unique_ptr<TabularBestResponse>> best_response_computers_;
+
+  // Current-policy rows as of the last SetPolicy on the best responders.
+  // Information states absent from the map were last seen with the uniform
+  // policy the responders were constructed against.
+  std::unordered_map<std::string, std::vector<double>> previous_policies_;
 };
 
 }  // namespace algorithms
@@ -15,6 +15,7 @@
 #include "open_spiel/algorithms/cfr.h"
 
 #include <cmath>
+#include <cstdio>
 #include <iostream>
 
 #include "open_spiel/algorithms/expected_returns.h"
@@ -61,6 +62,20 @@ void CFRTest_KuhnPoker() {
   CheckExploitabilityKuhnPoker(*game, *average_policy);
 }
 
+void CFRTest_KuhnPokerTimeBudget() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  // An expired budget runs nothing; an unlimited one runs everything, and
+  // the split runs land on the same policy as one unbudgeted loop.
+  TimeBudget expired(/*seconds=*/0.0);
+  SPIEL_CHECK_EQ(solver.RunIterations(300, &expired), 0);
+  SPIEL_CHECK_EQ(solver.RunIterations(100), 100);
+  SPIEL_CHECK_EQ(solver.RunIterations(200), 200);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
 void CFRPlusTest_KuhnPoker() {
   std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
   CFRPlusSolver solver(*game);
@@ -72,6 +87,185 @@ void CFRPlusTest_KuhnPoker() {
   CheckExploitabilityKuhnPoker(*game, *average_policy);
 }
 
+void DCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  DCFRSolver solver(*game);
+  // Discounting converges in far fewer iterations than vanilla CFR's 300.
+  for (int i = 0; i < 100; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void LinearCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  LinearCFRSolver solver(*game);
+  for (int i = 0; i < 200; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void ParallelCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ParallelCFRSolver solver(*game, /*num_threads=*/2, /*pin_threads=*/true);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void DeterministicParallelCFRTest_KuhnPoker() {
+  // In the task pool's deterministic mode, two identical parallel runs
+  // must produce bit-identical average policies.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TaskPool::Global()->SetDeterministic(true);
+  std::vector<std::unique_ptr<ParallelCFRSolver>> solvers;
+  std::vector<std::unique_ptr<Policy>> average_policies;
+  for (int run = 0; run < 2; ++run) {
+    solvers.push_back(std::make_unique<ParallelCFRSolver>(
+        *game, /*num_threads=*/2));
+    for (int i = 0; i < 50; ++i) solvers.back()->EvaluateAndUpdatePolicy();
+    average_policies.push_back(solvers.back()->AveragePolicy());
+  }
+  TaskPool::Global()->SetDeterministic(false);
+  for (const auto& entry : GetUniformPolicy(*game).PolicyTable()) {
+    SPIEL_CHECK_TRUE(average_policies[0]->GetStatePolicy(entry.first) ==
+                     average_policies[1]->GetStatePolicy(entry.first));
+  }
+}
+
+void CFRTest_KuhnPokerRegretBasedPruning() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  solver.EnableRegretBasedPruning(/*regret_threshold=*/-2.0,
+                                  /*revisit_interval=*/10);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CFRTest_KuhnPokerDepthLimitNeverReached() {
+  // A depth limit beyond the longest history never consults the oracle, so
+  // the run must match full CFR exactly.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<LeafValueOracle> oracle = MakeRolloutLeafValueOracle(1, 42);
+  CFRSolver full(*game);
+  CFRSolver limited(*game, /*depth_limit=*/game->MaxGameLength() + 3,
+                    oracle.get());
+  for (int i = 0; i < 100; i++) {
+    full.EvaluateAndUpdatePolicy();
+    limited.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_EQ(NashConv(*game, *full.AveragePolicy()),
+                 NashConv(*game, *limited.AveragePolicy()));
+}
+
+void CFRTest_KuhnPokerDepthLimitedRollouts() {
+  // Truncating at depth 4 (both cards dealt plus two decisions) with a
+  // rollout oracle at the frontier must still end well below the uniform
+  // policy's NashConv of ~0.92. It cannot reach 0: the states below the
+  // frontier are never updated and play uniformly under the fallback.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<LeafValueOracle> oracle =
+      MakeRolloutLeafValueOracle(/*num_rollouts=*/32, /*seed=*/937);
+  CFRSolver solver(*game, /*depth_limit=*/4, oracle.get());
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  // The table stops at the frontier; evaluate with a uniform fallback below.
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy(
+      std::make_shared<TabularPolicy>(GetUniformPolicy(*game)));
+  SPIEL_CHECK_LT(NashConv(*game, *average_policy), 0.7);
+}
+
+void CFRTest_KuhnPokerSimultaneousUpdates() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game, /*alternating_updates=*/false);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CFRCheckpointTest_KuhnPoker() {
+  const std::string filename = "/tmp/open_spiel_cfr_test_checkpoint.bin";
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  {
+    CFRSolver solver(*game);
+    for (int i = 0; i < 150; i++) {
+      solver.EvaluateAndUpdatePolicy();
+    }
+    solver.SaveCheckpoint(filename);
+  }
+
+  // Resuming from the checkpoint must be equivalent to having run all 300
+  // iterations in one process.
+  CFRSolver solver(*game, filename);
+  for (int i = 0; i < 150; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+  std::remove(filename.c_str());
+}
+
+void CFRSkeletonTest_KuhnPoker() {
+  const std::string filename = "/tmp/open_spiel_cfr_test_skeleton.bin";
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  {
+    CFRSolver solver(*game);
+    solver.SaveTableSkeleton(filename);
+  }
+
+  // A solver built from the skeleton skips discovery but must behave as if
+  // it had walked the game itself.
+  CFRSolverBase solver(*game, /*alternating_updates=*/true,
+                       /*linear_averaging=*/false,
+                       /*regret_matching_plus=*/false, /*depth_limit=*/-1,
+                       /*leaf_oracle=*/nullptr, filename);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+  std::remove(filename.c_str());
+}
+
+void CFRExportTest_KuhnPoker() {
+  const std::string filename = "/tmp/open_spiel_cfr_test_export.bin";
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  solver.ExportAveragePolicy(filename);
+
+  // The imported table must serve the same policy the solver does.
+  const TabularPolicy imported = ImportPolicyFromFile(filename);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  for (const auto& entry : imported.PolicyTable()) {
+    SPIEL_CHECK_TRUE(average_policy->GetStatePolicy(entry.first) ==
+                     entry.second);
+  }
+  CheckNashKuhnPoker(*game, imported);
+  CheckExploitabilityKuhnPoker(*game, imported);
+  std::remove(filename.c_str());
+}
+
 void CFRTest_KuhnPokerRunsWithThreePlayers(
                                            bool linear_averaging,
                                            bool regret_matching_plus,
@@ -162,7 +356,19 @@ namespace algorithms = open_spiel::algorithms;
 
 int main(int argc, char** argv) {
   algorithms::CFRTest_KuhnPoker();
+  algorithms::CFRTest_KuhnPokerTimeBudget();
+  algorithms::CFRTest_KuhnPokerSimultaneousUpdates();
   algorithms::CFRPlusTest_KuhnPoker();
+  algorithms::DCFRTest_KuhnPoker();
+  algorithms::LinearCFRTest_KuhnPoker();
+  algorithms::ParallelCFRTest_KuhnPoker();
+  algorithms::DeterministicParallelCFRTest_KuhnPoker();
+  algorithms::CFRTest_KuhnPokerRegretBasedPruning();
+  algorithms::CFRTest_KuhnPokerDepthLimitNeverReached();
+  algorithms::CFRTest_KuhnPokerDepthLimitedRollouts();
+  algorithms::CFRCheckpointTest_KuhnPoker();
+  algorithms::CFRSkeletonTest_KuhnPoker();
+  algorithms::CFRExportTest_KuhnPoker();
   algorithms::CFRTest_KuhnPokerRunsWithThreePlayers(
       /*linear_averaging=*/false,
       /*regret_matching_plus=*/false,
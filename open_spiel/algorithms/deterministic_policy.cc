@@ -22,28 +22,35 @@ namespace algorithms {
 DeterministicTabularPolicy::DeterministicTabularPolicy(
     const Game& game, Player player,
     const std::unordered_map<std::string, Action> policy)
-    : table_(), player_(player) {
+    : player_(player) {
   CreateTable(game, player);
   for (const auto& info_state_action : policy) {
-    auto iter = table_.find(info_state_action.first);
-    SPIEL_CHECK_TRUE(iter != table_.end());
-    iter->second.SetAction(info_state_action.second);
+    auto iter = info_state_index_.find(info_state_action.first);
+    SPIEL_CHECK_TRUE(iter != info_state_index_.end());
+    const std::vector<Action>& legals = legal_actions_[iter->second];
+    auto action_iter =
+        std::find(legals.begin(), legals.end(), info_state_action.second);
+    SPIEL_CHECK_TRUE(action_iter != legals.end());
+    action_index_[iter->second] =
+        std::distance(legals.begin(), action_iter);
   }
 }
 
 DeterministicTabularPolicy::DeterministicTabularPolicy(const Game& game,
                                                        Player player)
-    : table_(), player_(player) {
+    : player_(player) {
   CreateTable(game, player);
 }
 
 ActionsAndProbs DeterministicTabularPolicy::GetStatePolicy(
     const std::string& info_state) const {
-  auto iter = table_.find(info_state);
-  SPIEL_CHECK_TRUE(iter != table_.end());
+  auto iter = info_state_index_.find(info_state);
+  SPIEL_CHECK_TRUE(iter != info_state_index_.end());
+  const std::vector<Action>& legals = legal_actions_[iter->second];
+  Action policy_action = legals[action_index_[iter->second]];
   ActionsAndProbs state_policy;
-  Action policy_action = iter->second.GetAction();
-  for (const auto& action : iter->second.legal_actions_) {
+  state_policy.reserve(legals.size());
+  for (const auto& action : legals) {
     state_policy.push_back(
         std::pair<Action, double>(action, action == policy_action ? 1.0 : 0.0));
   }
@@ -52,22 +59,21 @@ ActionsAndProbs DeterministicTabularPolicy::GetStatePolicy(
 
 Action DeterministicTabularPolicy::GetAction(
     const std::string& info_state) const {
-  auto iter = table_.find(info_state);
-  SPIEL_CHECK_TRUE(iter != table_.end());
-  return iter->second.GetAction();
+  auto iter = info_state_index_.find(info_state);
+  SPIEL_CHECK_TRUE(iter != info_state_index_.end());
+  return legal_actions_[iter->second][action_index_[iter->second]];
 }
 
 bool DeterministicTabularPolicy::NextPolicy() {
   // Treat the current indices as digits in a mixed base. Starting at the
-  // beginning of the table, add 1. If can't, continue trying. If we reach the
-  // end without being able to add 1, then this is the end of the order.
-  // Otherwise, increment the digit we land on by 1, and reset all the ones
-  // we skipped over earlier in the order.
-  for (auto iter = table_.begin(); iter != table_.end(); ++iter) {
-    if (iter->second.TryIncIndex()) {
-      for (auto iter2 = table_.begin(); iter2 != iter; ++iter2) {
-        iter2->second.index = 0;
-      }
+  // beginning of the digit array, add 1. If can't, continue trying. If we
+  // reach the end without being able to add 1, then this is the end of the
+  // order. Otherwise, increment the digit we land on by 1, and reset all
+  // the ones we skipped over earlier in the order.
+  for (int i = 0; i < static_cast<int>(action_index_.size()); ++i) {
+    if (action_index_[i] + 1 < static_cast<int>(legal_actions_[i].size())) {
+      action_index_[i] += 1;
+      std::fill(action_index_.begin(), action_index_.begin() + i, 0);
       return true;
     }
   }
@@ -75,26 +81,33 @@ bool DeterministicTabularPolicy::NextPolicy() {
 }
 
 void DeterministicTabularPolicy::ResetDefaultPolicy() {
-  for (auto& info_state_entry : table_) {
-    info_state_entry.second.index = 0;
-  }
+  std::fill(action_index_.begin(), action_index_.end(), 0);
 }
 
 void DeterministicTabularPolicy::CreateTable(const Game& game, Player player) {
   std::unordered_map<std::string, std::vector<Action>> legal_actions_map =
       GetLegalActionsMap(game, -1, player);
+  // Number the information states once, in sorted order so that the
+  // enumeration order is reproducible across runs.
+  info_states_.reserve(legal_actions_map.size());
   for (const auto& info_state_actions : legal_actions_map) {
-    table_[info_state_actions.first] =
-        LegalsWithIndex(info_state_actions.second);
+    info_states_.push_back(info_state_actions.first);
+  }
+  std::sort(info_states_.begin(), info_states_.end());
+  legal_actions_.reserve(info_states_.size());
+  for (int i = 0; i < static_cast<int>(info_states_.size()); ++i) {
+    info_state_index_[info_states_[i]] = i;
+    legal_actions_.push_back(std::move(legal_actions_map[info_states_[i]]));
   }
+  action_index_.assign(info_states_.size(), 0);
 }
 
 std::string DeterministicTabularPolicy::ToString(
     const std::string& delimiter) const {
   std::string str = "";
-  for (const auto& info_state_entry : table_) {
-    absl::StrAppend(&str, info_state_entry.first, " ", delimiter, " ",
-                    "action = ", info_state_entry.second.GetAction(), "\n");
+  for (int i = 0; i < static_cast<int>(info_states_.size()); ++i) {
+    absl::StrAppend(&str, info_states_[i], " ", delimiter, " ", "action = ",
+                    legal_actions_[i][action_index_[i]], "\n");
   }
   return str;
 }
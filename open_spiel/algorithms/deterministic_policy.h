@@ -28,36 +28,6 @@
 namespace open_spiel {
 namespace algorithms {
 
-// An simple container object used to store the legal actions (and chosen
-// action) for each information state.
-struct LegalsWithIndex {
-  LegalsWithIndex() {}
-  LegalsWithIndex(const std::vector<Action>& legal_actions)
-      : legal_actions_(legal_actions), index(0) {}
-
-  void SetAction(Action action) {
-    auto iter = std::find(legal_actions_.begin(), legal_actions_.end(), action);
-    SPIEL_CHECK_TRUE(iter != legal_actions_.end());
-    index = std::distance(legal_actions_.begin(), iter);
-  }
-
-  Action GetAction() const { return legal_actions_[index]; }
-
-  // Try to increment the index of the action. Used by the enumerator over
-  // deterministic policies (DeterministicPolicy::NextPolicy) below.
-  bool TryIncIndex() {
-    if (index + 1 < legal_actions_.size()) {
-      index += 1;
-      return true;
-    } else {
-      return false;
-    }
-  }
-
-  std::vector<Action> legal_actions_;
-  int index;
-};
-
 class DeterministicTabularPolicy : public Policy {
  public:
   // Creates a deterministic policy and sets it to the specified policy.
@@ -73,8 +43,8 @@ class DeterministicTabularPolicy : public Policy {
   Action GetAction(const std::string& info_state) const;
 
   // Determinstic policies are ordered. First, we define some order to the
-  // information states (which is the order defined by the legal_actions_map
-  // for the game). Then the total order over policies is defined in a
+  // information states (they are numbered once at construction, in sorted
+  // order). Then the total order over policies is defined in a
   // "counting order according to their associated tuple (
   // legal_action_index[state] for state in ordered_states). The first
   // deterministic policy in the order is the one whose action is set is the
@@ -100,7 +70,15 @@ class DeterministicTabularPolicy : public Policy {
  private:
   void CreateTable(const Game& game, Player player);
 
-  std::unordered_map<std::string, LegalsWithIndex> table_;
+  // Information states are numbered once at construction. String lookups
+  // (the Policy interface) go through info_state_index_; the enumeration
+  // itself only touches the flat digit array action_index_, so NextPolicy
+  // is an odometer increment over contiguous ints rather than a walk over
+  // string-keyed map nodes.
+  std::vector<std::string> info_states_;
+  std::vector<std::vector<Action>> legal_actions_;
+  std::vector<int> action_index_;
+  std::unordered_map<std::string, int> info_state_index_;
   Player player_;
 };
 
@@ -0,0 +1,195 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/disk_transposition_table.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The on-disk record layout is the struct itself.
+static_assert(sizeof(DiskTTEntry) == 32,
+              "DiskTTEntry must stay a fixed 32-byte record");
+
+// Lockless-hashing signature folded into the on-disk key: a torn read (the
+// flusher rewriting a bucket while the search thread reads it) garbles some
+// field, the recomputed signature no longer cancels, and the record reads
+// as a miss instead of returning a corrupt value. An all-zero record
+// signs to 0, so untouched (sparse) buckets decode to the empty key.
+uint64_t EntrySignature(const DiskTTEntry& entry) {
+  constexpr uint64_t kMul = 0x9e3779b97f4a7c15ULL;
+  uint64_t value_bits;
+  std::memcpy(&value_bits, &entry.value, sizeof(value_bits));
+  uint64_t signature = value_bits;
+  signature = signature * kMul ^ static_cast<uint64_t>(entry.best_action);
+  signature = signature * kMul ^ static_cast<uint64_t>(entry.depth);
+  signature = signature * kMul ^ static_cast<uint64_t>(entry.bound);
+  return signature;
+}
+
+}  // namespace
+
+DiskTranspositionTable::DiskTranspositionTable(const std::string& filename,
+                                               int64_t memory_bytes,
+                                               int64_t disk_bytes) {
+  SPIEL_CHECK_GE(memory_bytes,
+                 kProbeRun * static_cast<int64_t>(sizeof(DiskTTEntry)));
+  SPIEL_CHECK_GE(disk_bytes,
+                 kBucketEntries * static_cast<int64_t>(sizeof(DiskTTEntry)));
+
+  // Round the memory tier down to a power of two so probing can mask.
+  int64_t num_slots = kProbeRun;
+  while (num_slots * 2 * static_cast<int64_t>(sizeof(DiskTTEntry)) <=
+         memory_bytes) {
+    num_slots *= 2;
+  }
+  slots_.assign(num_slots, DiskTTEntry());
+  slot_mask_ = num_slots - 1;
+
+  num_buckets_ = disk_bytes /
+                 (kBucketEntries * static_cast<int64_t>(sizeof(DiskTTEntry)));
+  fd_ = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    SpielFatalError(
+        absl::StrCat("Cannot open transposition file: ", filename));
+  }
+  if (ftruncate(fd_, num_buckets_ * kBucketEntries * sizeof(DiskTTEntry)) !=
+      0) {
+    close(fd_);
+    SpielFatalError(
+        absl::StrCat("Cannot size transposition file: ", filename));
+  }
+
+  flusher_ = std::thread(&DiskTranspositionTable::FlusherLoop, this);
+}
+
+DiskTranspositionTable::~DiskTranspositionTable() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_flusher_.notify_one();
+  flusher_.join();
+  close(fd_);
+}
+
+bool DiskTranspositionTable::Lookup(uint64_t key, DiskTTEntry* entry) {
+  if (key == 0) return false;
+  const uint64_t home = key & slot_mask_;
+  for (int i = 0; i < kProbeRun; ++i) {
+    const DiskTTEntry& slot = slots_[(home + i) & slot_mask_];
+    if (slot.key == key) {
+      *entry = slot;
+      return true;
+    }
+  }
+
+  // Miss in memory: read the key's bucket. Entries still queued for
+  // write-behind are not consulted; missing one only costs a re-search.
+  DiskTTEntry bucket[kBucketEntries];
+  const int64_t offset = (key % num_buckets_) * kBucketEntries *
+                         static_cast<int64_t>(sizeof(DiskTTEntry));
+  if (pread(fd_, bucket, sizeof(bucket), offset) !=
+      static_cast<ssize_t>(sizeof(bucket))) {
+    return false;
+  }
+  for (const DiskTTEntry& record : bucket) {
+    if ((record.key ^ EntrySignature(record)) == key) {
+      *entry = record;
+      entry->key = key;
+      ++num_disk_hits_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void DiskTranspositionTable::Insert(const DiskTTEntry& entry) {
+  if (entry.key == 0) return;
+  const uint64_t home = entry.key & slot_mask_;
+  int victim = -1;
+  for (int i = 0; i < kProbeRun; ++i) {
+    const uint64_t slot_index = (home + i) & slot_mask_;
+    DiskTTEntry& slot = slots_[slot_index];
+    if (slot.key == entry.key) {
+      // Deepest-search-wins replacement, as in the in-memory table.
+      if (entry.depth >= slot.depth) slot = entry;
+      return;
+    }
+    if (slot.key == 0) {
+      slot = entry;
+      return;
+    }
+    if (victim < 0 || slot.depth < slots_[(home + victim) & slot_mask_].depth) {
+      victim = i;
+    }
+  }
+  DiskTTEntry& evicted = slots_[(home + victim) & slot_mask_];
+  EvictToDisk(evicted);
+  evicted = entry;
+}
+
+void DiskTranspositionTable::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  flush_done_.wait(lock, [this]() { return pending_.empty() && !flushing_; });
+}
+
+void DiskTranspositionTable::EvictToDisk(const DiskTTEntry& entry) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.push_back(entry);
+  }
+  ++num_evictions_;
+  wake_flusher_.notify_one();
+}
+
+void DiskTranspositionTable::FlusherLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_flusher_.wait(lock, [this]() { return !pending_.empty() || stop_; });
+    if (pending_.empty() && stop_) return;
+
+    // Take the whole queue and write it outside the lock, so the search
+    // thread never waits on the disk.
+    std::deque<DiskTTEntry> batch;
+    batch.swap(pending_);
+    flushing_ = true;
+    lock.unlock();
+    for (const DiskTTEntry& entry : batch) {
+      DiskTTEntry record = entry;
+      record.key = entry.key ^ EntrySignature(entry);
+      const int64_t bucket = entry.key % num_buckets_;
+      const int64_t slot = (entry.key / num_buckets_) % kBucketEntries;
+      const int64_t offset =
+          (bucket * kBucketEntries + slot) *
+          static_cast<int64_t>(sizeof(DiskTTEntry));
+      if (pwrite(fd_, &record, sizeof(record), offset) !=
+          static_cast<ssize_t>(sizeof(record))) {
+        SpielFatalError("Error writing transposition file.");
+      }
+    }
+    lock.lock();
+    flushing_ = false;
+    if (pending_.empty()) flush_done_.notify_all();
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
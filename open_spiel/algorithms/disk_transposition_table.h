@@ -0,0 +1,119 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISK_TRANSPOSITION_TABLE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISK_TRANSPOSITION_TABLE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// The quality of a stored search value: exact, or a bound left by an
+// alpha-beta cut-off that can still narrow the window on a later visit.
+enum class TTBound : uint8_t { kExact = 0, kLower = 1, kUpper = 2 };
+
+// One transposition entry; also the fixed-size on-disk record. A key of 0
+// marks an empty slot, so the (rare) position hashing to 0 is simply never
+// cached.
+struct DiskTTEntry {
+  uint64_t key = 0;
+  double value = 0;
+  Action best_action = kInvalidAction;
+  int32_t depth = 0;
+  TTBound bound = TTBound::kExact;
+  uint8_t padding[3] = {0, 0, 0};
+};
+
+// A transposition table sized by disk rather than RAM, for strong solvers
+// whose position counts far exceed memory (connect-four and friends). Two
+// tiers: a fixed in-memory open-addressing array absorbs the hot working
+// set, and entries it evicts are appended to a write-behind queue that a
+// background thread flushes into a bucketed file. Lookups that miss in
+// memory read the key's bucket from disk, so old entries stay reachable
+// through the page cache at the cost of one read.
+//
+// Entries are advisory: a dropped or overwritten entry only costs a
+// re-search, never correctness, which is why the write-behind queue is
+// allowed to race with disk lookups. Torn bucket reads are rejected by the
+// lockless-hashing signature folded into each on-disk key. Single search
+// thread assumed; only the flusher runs concurrently.
+class DiskTranspositionTable {
+ public:
+  // Creates (or truncates) `filename` sized to `disk_bytes` and an in-memory
+  // tier of `memory_bytes`. The file is written sparse, so unused buckets
+  // cost no space.
+  DiskTranspositionTable(const std::string& filename, int64_t memory_bytes,
+                         int64_t disk_bytes);
+  ~DiskTranspositionTable();
+  DiskTranspositionTable(const DiskTranspositionTable&) = delete;
+  DiskTranspositionTable& operator=(const DiskTranspositionTable&) = delete;
+
+  // Fills *entry and returns true if the key is present in either tier.
+  bool Lookup(uint64_t key, DiskTTEntry* entry);
+
+  // Inserts the entry into the memory tier; within a probe run the
+  // shallowest entry is evicted to disk to make room, and a same-key entry
+  // is only replaced by an equal or deeper search.
+  void Insert(const DiskTTEntry& entry);
+
+  // Blocks until every evicted entry so far has reached the disk file.
+  void Flush();
+
+  int64_t NumEvictions() const { return num_evictions_.load(); }
+  int64_t NumDiskHits() const { return num_disk_hits_.load(); }
+
+ private:
+  static constexpr int kProbeRun = 8;      // Memory-tier probe window.
+  static constexpr int kBucketEntries = 8;  // Entries per disk bucket.
+
+  void EvictToDisk(const DiskTTEntry& entry);
+  void FlusherLoop();
+
+  // Memory tier: power-of-two slot array, linear probing within kProbeRun.
+  std::vector<DiskTTEntry> slots_;
+  uint64_t slot_mask_;
+
+  // Disk tier: `num_buckets_` buckets of kBucketEntries records; an entry
+  // lives in bucket key % num_buckets_, slot (key / num_buckets_) % entries.
+  int fd_ = -1;
+  int64_t num_buckets_;
+
+  // Write-behind queue, drained by the flusher thread.
+  std::mutex mutex_;
+  std::condition_variable wake_flusher_;
+  std::condition_variable flush_done_;
+  std::deque<DiskTTEntry> pending_;
+  bool flushing_ = false;  // A batch is being written outside the lock.
+  bool stop_ = false;
+  std::thread flusher_;
+
+  std::atomic<int64_t> num_evictions_{0};
+  std::atomic<int64_t> num_disk_hits_{0};
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISK_TRANSPOSITION_TABLE_H_
@@ -0,0 +1,162 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/disk_transposition_table.h"
+
+#include <cstdio>
+#include <memory>
+
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void InsertLookupTest() {
+  const std::string filename = "/tmp/open_spiel_disk_tt_test_basic.bin";
+  {
+    DiskTranspositionTable table(filename, /*memory_bytes=*/1 << 16,
+                                 /*disk_bytes=*/1 << 16);
+    DiskTTEntry entry;
+    entry.key = 123;
+    entry.value = 1.5;
+    entry.best_action = 7;
+    entry.depth = 3;
+    entry.bound = TTBound::kLower;
+    table.Insert(entry);
+
+    DiskTTEntry found;
+    SPIEL_CHECK_TRUE(table.Lookup(123, &found));
+    SPIEL_CHECK_EQ(found.value, 1.5);
+    SPIEL_CHECK_EQ(found.best_action, 7);
+    SPIEL_CHECK_EQ(found.depth, 3);
+    SPIEL_CHECK_TRUE(found.bound == TTBound::kLower);
+    SPIEL_CHECK_FALSE(table.Lookup(456, &found));
+
+    // A shallower same-key entry is ignored; a deeper one replaces.
+    entry.depth = 2;
+    entry.value = -1.0;
+    table.Insert(entry);
+    SPIEL_CHECK_TRUE(table.Lookup(123, &found));
+    SPIEL_CHECK_EQ(found.depth, 3);
+    SPIEL_CHECK_EQ(found.value, 1.5);
+    entry.depth = 5;
+    entry.value = 2.5;
+    table.Insert(entry);
+    SPIEL_CHECK_TRUE(table.Lookup(123, &found));
+    SPIEL_CHECK_EQ(found.depth, 5);
+    SPIEL_CHECK_EQ(found.value, 2.5);
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+// Overflow a tiny memory tier and read everything back: evicted entries
+// must come out of the disk tier unchanged.
+void EvictionRoundTripTest() {
+  const std::string filename = "/tmp/open_spiel_disk_tt_test_evict.bin";
+  const int64_t num_entries = 4096;
+  {
+    // 64 memory slots; sequential keys land in distinct disk buckets, so
+    // nothing is lost to bucket collisions and every key must be found.
+    DiskTranspositionTable table(
+        filename, /*memory_bytes=*/64 * sizeof(DiskTTEntry),
+        /*disk_bytes=*/num_entries * 8 * sizeof(DiskTTEntry));
+    for (int64_t i = 1; i <= num_entries; ++i) {
+      DiskTTEntry entry;
+      entry.key = i;
+      entry.value = static_cast<double>(i);
+      entry.best_action = i % 7;
+      entry.depth = i % 20;
+      entry.bound = TTBound::kExact;
+      table.Insert(entry);
+    }
+    SPIEL_CHECK_GT(table.NumEvictions(), 0);
+    table.Flush();
+
+    for (int64_t i = 1; i <= num_entries; ++i) {
+      DiskTTEntry found;
+      SPIEL_CHECK_TRUE(table.Lookup(i, &found));
+      SPIEL_CHECK_EQ(found.value, static_cast<double>(i));
+      SPIEL_CHECK_EQ(found.best_action, i % 7);
+      SPIEL_CHECK_EQ(found.depth, i % 20);
+    }
+    SPIEL_CHECK_GT(table.NumDiskHits(), 0);
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+// A full-depth solve through the two-tier table gives the exact values,
+// with a memory tier far too small for the game's transposition set.
+void SolverIntegrationTest() {
+  const std::string filename = "/tmp/open_spiel_disk_tt_test_solve.bin";
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  {
+    DiskTranspositionTable table(filename,
+                                 /*memory_bytes=*/128 * sizeof(DiskTTEntry),
+                                 /*disk_bytes=*/1 << 22);
+    std::pair<double, Action> value_and_action = IterativeDeepeningSearch(
+        *game, nullptr, {}, -1, kInvalidPlayer,
+        /*canonical_transpositions=*/false, &table);
+    SPIEL_CHECK_EQ(0.0, value_and_action.first);
+    SPIEL_CHECK_GT(table.NumEvictions(), 0);
+
+    // The same table serves a follow-up search on a nearby position.
+    std::unique_ptr<State> state = game->NewInitialState();
+    state->ApplyAction(4);
+    state->ApplyAction(1);
+    value_and_action = IterativeDeepeningSearch(
+        *game, state.get(), {}, -1, kInvalidPlayer,
+        /*canonical_transpositions=*/false, &table);
+    SPIEL_CHECK_EQ(1.0, value_and_action.first);
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+// Connect-four now carries a position hash; a depth-limited search must
+// give the same value through the disk-backed table as through the
+// in-memory map.
+void ConnectFourDepthLimitedTest() {
+  const std::string filename = "/tmp/open_spiel_disk_tt_test_c4.bin";
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  auto value_function = [](const State&) { return 0.0; };
+  const double in_memory_value =
+      IterativeDeepeningSearch(*game, nullptr, value_function,
+                               /*depth_limit=*/6, kInvalidPlayer)
+          .first;
+  {
+    DiskTranspositionTable table(filename,
+                                 /*memory_bytes=*/256 * sizeof(DiskTTEntry),
+                                 /*disk_bytes=*/1 << 24);
+    const double disk_value = IterativeDeepeningSearch(
+                                  *game, nullptr, value_function,
+                                  /*depth_limit=*/6, kInvalidPlayer,
+                                  /*canonical_transpositions=*/false, &table)
+                                  .first;
+    SPIEL_CHECK_EQ(in_memory_value, disk_value);
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::InsertLookupTest();
+  open_spiel::algorithms::EvictionRoundTripTest();
+  open_spiel::algorithms::SolverIntegrationTest();
+  open_spiel::algorithms::ConnectFourDepthLimitedTest();
+}
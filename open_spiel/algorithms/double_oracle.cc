@@ -0,0 +1,241 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/double_oracle.h"
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "open_spiel/algorithms/best_response.h"
+#include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/algorithms/matrix_game_dynamics.h"
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Samples from a fixed policy; the tournament constructs one per seat per
+// episode, so the policy pointer is only read, never shared mutable state.
+class TabularPolicyBot : public Bot {
+ public:
+  TabularPolicyBot(const Game& game, Player player_id, int seed,
+                   const Policy* policy)
+      : Bot(game, player_id), rng_(seed), policy_(policy) {}
+
+  std::pair<ActionsAndProbs, Action> Step(const State& state) override {
+    ActionsAndProbs actions_and_probs =
+        policy_->GetStatePolicy(state.InformationState(player_id_));
+    Action action = SampleChanceOutcome(
+        actions_and_probs,
+        std::uniform_real_distribution<double>(0.0, 1.0)(rng_));
+    return {std::move(actions_and_probs), action};
+  }
+
+ private:
+  std::mt19937 rng_;
+  const Policy* policy_;
+};
+
+// Accumulates, for every infostate of `player` under `state`, each pool
+// policy's action probabilities weighted by mixture weight times the
+// player's own reach under that policy. `reaches[j]` carries weight times
+// reach for pool member j along the current history; with perfect recall the
+// contribution is identical for every history in an infostate, so visiting
+// an infostate through several histories only rescales all of its sums.
+void AccumulateMixture(
+    const State& state, Player player,
+    const std::vector<const Policy*>& policies, std::vector<double> reaches,
+    std::unordered_map<std::string, std::map<Action, double>>* sums) {
+  if (state.IsTerminal()) return;
+  if (state.CurrentPlayer() == player) {
+    const std::string info_state = state.InformationState(player);
+    std::map<Action, double>& state_sums = (*sums)[info_state];
+    for (Action action : state.LegalActions()) {
+      std::vector<double> child_reaches = reaches;
+      double weight = 0;
+      for (int j = 0; j < policies.size(); ++j) {
+        const double prob = GetProb(
+            policies[j]->GetStatePolicy(info_state), action);
+        child_reaches[j] *= prob;
+        weight += child_reaches[j];
+      }
+      state_sums[action] += weight;
+      AccumulateMixture(*state.Child(action), player, policies,
+                        std::move(child_reaches), sums);
+    }
+  } else {
+    // Chance and opponent moves do not contribute to the player's own reach.
+    for (Action action : state.LegalActions()) {
+      AccumulateMixture(*state.Child(action), player, policies, reaches,
+                        sums);
+    }
+  }
+}
+
+}  // namespace
+
+DoubleOracleSolver::DoubleOracleSolver(const Game& game,
+                                       DoubleOracleParams params)
+    : game_(game),
+      params_(params),
+      root_history_(game.NewInitialState()->ToString()),
+      rng_(params.seed) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  GameType type = game.GetType();
+  if (type.utility != GameType::Utility::kZeroSum &&
+      type.utility != GameType::Utility::kConstantSum) {
+    SpielFatalError(
+        "DoubleOracleSolver requires a zero- or constant-sum game.");
+  }
+  SPIEL_CHECK_TRUE(type.dynamics == GameType::Dynamics::kSequential);
+  TabularPolicy uniform = GetUniformPolicy(game);
+  pools_[0].push_back(uniform);
+  pools_[1].push_back(std::move(uniform));
+  meta_strategies_[0] = {1.0};
+  meta_strategies_[1] = {1.0};
+  meta_values_[0] = 0;
+  meta_values_[1] = 0;
+}
+
+void DoubleOracleSolver::EvaluateNewCells() {
+  const int num_rows = pools_[0].size();
+  const int num_cols = pools_[1].size();
+  for (int player = 0; player < 2; ++player) {
+    utilities_[player].resize(num_rows);
+    for (std::vector<double>& row : utilities_[player]) row.resize(num_cols);
+  }
+
+  // One tournament pairing per un-estimated cell; the bot pool is the row
+  // policies followed by the column policies.
+  std::vector<std::vector<int>> pairings;
+  std::vector<std::pair<int, int>> cells;
+  for (int i = 0; i < num_rows; ++i) {
+    for (int j = 0; j < num_cols; ++j) {
+      if (i >= evaluated_rows_ || j >= evaluated_cols_) {
+        pairings.push_back({i, num_rows + j});
+        cells.push_back({i, j});
+      }
+    }
+  }
+  if (!pairings.empty()) {
+    std::vector<BotFactory> factories;
+    factories.reserve(num_rows + num_cols);
+    for (int player = 0; player < 2; ++player) {
+      for (const TabularPolicy& policy : pools_[player]) {
+        const Policy* policy_ptr = &policy;
+        factories.push_back(
+            [policy_ptr](const Game& game, Player player_id, int seed) {
+              return std::unique_ptr<Bot>(
+                  new TabularPolicyBot(game, player_id, seed, policy_ptr));
+            });
+      }
+    }
+    TournamentResults results = RunTournament(
+        game_, factories, params_.games_per_pairing,
+        static_cast<int>(rng_()), params_.num_threads, std::move(pairings));
+    for (int c = 0; c < cells.size(); ++c) {
+      utilities_[0][cells[c].first][cells[c].second] =
+          results.pairing_avg_returns[c][0];
+      utilities_[1][cells[c].first][cells[c].second] =
+          results.pairing_avg_returns[c][1];
+    }
+  }
+  evaluated_rows_ = num_rows;
+  evaluated_cols_ = num_cols;
+}
+
+void DoubleOracleSolver::SolveMetaGame() {
+  std::shared_ptr<const matrix_game::MatrixGame> meta_game =
+      matrix_game::CreateMatrixGame(utilities_[0], utilities_[1]);
+  MatrixFictitiousPlaySolver solver(*meta_game);
+  solver.Iterate(params_.meta_solver_iterations);
+  for (auto player : {Player{0}, Player{1}}) {
+    meta_strategies_[player] = solver.Strategy(player);
+  }
+  for (auto player : {Player{0}, Player{1}}) {
+    meta_values_[player] = meta_game->ExpectedUtility(
+        player, meta_strategies_[0], meta_strategies_[1]);
+  }
+}
+
+TabularPolicy DoubleOracleSolver::MixturePolicy(Player player) const {
+  std::vector<const Policy*> policies;
+  policies.reserve(pools_[player].size());
+  for (const TabularPolicy& policy : pools_[player]) {
+    policies.push_back(&policy);
+  }
+  std::unordered_map<std::string, std::map<Action, double>> sums;
+  AccumulateMixture(*game_.NewInitialState(), player, policies,
+                    meta_strategies_[player], &sums);
+
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (const auto& infostate_and_sums : sums) {
+    ActionsAndProbs& probs = table[infostate_and_sums.first];
+    double total = 0;
+    for (const auto& action_and_sum : infostate_and_sums.second) {
+      total += action_and_sum.second;
+    }
+    for (const auto& action_and_sum : infostate_and_sums.second) {
+      // Infostates the player's own mixture never reaches get the uniform
+      // policy; nothing downstream depends on their probabilities.
+      probs.push_back(
+          {action_and_sum.first,
+           total > 0 ? action_and_sum.second / total
+                     : 1.0 / infostate_and_sums.second.size()});
+    }
+  }
+  return TabularPolicy(table);
+}
+
+TabularPolicy DoubleOracleSolver::JointMixturePolicy() const {
+  TabularPolicy joint = MixturePolicy(Player{0});
+  TabularPolicy other = MixturePolicy(Player{1});
+  for (auto& infostate_and_probs : other.PolicyTable()) {
+    joint.PolicyTable()[infostate_and_probs.first] =
+        std::move(infostate_and_probs.second);
+  }
+  return joint;
+}
+
+bool DoubleOracleSolver::Iterate() {
+  EvaluateNewCells();
+  SolveMetaGame();
+  bool improved = false;
+  // Both mixtures are fixed before either pool grows: each player responds
+  // to the mixture this epoch's meta-solve produced, not to the opponent's
+  // freshly added response.
+  TabularPolicy mixtures[2] = {MixturePolicy(Player{0}),
+                               MixturePolicy(Player{1})};
+  for (auto player : {Player{0}, Player{1}}) {
+    TabularBestResponse best_response(game_, player, &mixtures[1 - player]);
+    if (params_.num_threads > 1) {
+      best_response.ComputeBestResponses(params_.num_threads);
+    }
+    if (best_response.Value(root_history_) >
+        meta_values_[player] + params_.best_response_tolerance) {
+      pools_[player].push_back(best_response.GetBestResponsePolicy());
+      improved = true;
+    }
+  }
+  ++num_epochs_;
+  return improved;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
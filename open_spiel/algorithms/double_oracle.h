@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DOUBLE_ORACLE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DOUBLE_ORACLE_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// Double oracle (the two-player PSRO special case): each player maintains a
+// pool of tabular policies, the empirical meta-game over the pools is solved
+// for a mixture, and each player adds an exact best response to the
+// opponent's mixture; when neither best response improves on the meta-game
+// value, the mixtures are an equilibrium of the restricted game. The three
+// stages map onto existing machinery: the meta-game payoff matrix is
+// estimated with the tournament runner (only cells involving a new pool
+// member are played, earlier cells are cached), the restricted matrix game
+// is solved with MatrixFictitiousPlaySolver, and the best responses come
+// from TabularBestResponse. Payoff estimation dominates the cost and
+// parallelizes over episodes via the tournament's workers.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct DoubleOracleParams {
+  // Episodes played to estimate each new payoff-matrix cell. This is the
+  // one sampled quantity in the loop: the meta-game (and through it the
+  // convergence test) is only accurate to the resulting standard error.
+  int games_per_pairing = 1000;
+
+  // Fictitious play iterations on the restricted matrix game per epoch.
+  int meta_solver_iterations = 2000;
+
+  // A best response must beat the meta-game value by more than this to be
+  // added to the pool. Set it above the payoff estimation noise, or the
+  // loop will keep adding responses to sampling error.
+  double best_response_tolerance = 0.01;
+
+  // Workers for the tournament episodes and the best-response computation.
+  int num_threads = 1;
+
+  int seed = 0;
+};
+
+// The engine. Only two-player zero- or constant-sum sequential games are
+// supported (the restriction comes from TabularBestResponse).
+class DoubleOracleSolver {
+ public:
+  // The game must outlive the solver. Both pools start from the uniform
+  // random policy.
+  DoubleOracleSolver(const Game& game, DoubleOracleParams params = {});
+
+  // Runs one epoch: estimates the payoff-matrix cells added by the previous
+  // epoch's responses, re-solves the meta-game, and computes both players'
+  // best responses against the opponent's new mixture. Returns true if
+  // either response was added to a pool, i.e. false once converged (to
+  // within the payoff estimation noise).
+  bool Iterate();
+
+  int NumEpochs() const { return num_epochs_; }
+
+  // The policy pool of `player`, in insertion order.
+  const std::vector<TabularPolicy>& Pool(Player player) const {
+    return pools_[player];
+  }
+
+  // The latest meta-game mixture over `player`'s pool.
+  const std::vector<double>& MetaStrategy(Player player) const {
+    return meta_strategies_[player];
+  }
+
+  // The meta-game value for `player` under the latest mixtures.
+  double MetaGameValue(Player player) const { return meta_values_[player]; }
+
+  // The behavioral policy realization-equivalent to `player` mixing over
+  // their pool with the meta-game mixture: at each of the player's
+  // infostates, the pool policies' action probabilities weighted by mixture
+  // weight times the player's own reach probability under that policy.
+  TabularPolicy MixturePolicy(Player player) const;
+
+  // Both players' mixture policies in one joint table, for NashConv,
+  // Exploitability and other joint-policy consumers.
+  TabularPolicy JointMixturePolicy() const;
+
+ private:
+  // Plays out the payoff-matrix cells not yet estimated (one tournament
+  // pairing per cell) and stores their returns.
+  void EvaluateNewCells();
+
+  // Solves the restricted matrix game over the current payoff estimates,
+  // updating the meta mixtures and values.
+  void SolveMetaGame();
+
+  const Game& game_;
+  const DoubleOracleParams params_;
+  const std::string root_history_;
+  std::mt19937 rng_;  // Draws the per-tournament seeds.
+  int num_epochs_ = 0;
+
+  std::vector<TabularPolicy> pools_[2];
+  std::vector<double> meta_strategies_[2];
+  double meta_values_[2];
+
+  // Row-major payoff estimates over pools_[0] x pools_[1]; cells beyond
+  // evaluated_rows_/cols_ have not been played yet.
+  std::vector<std::vector<double>> utilities_[2];
+  int evaluated_rows_ = 0;
+  int evaluated_cols_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DOUBLE_ORACLE_H_
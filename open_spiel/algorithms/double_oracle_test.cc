@@ -0,0 +1,97 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/double_oracle.h"
+
+#include <iostream>
+#include <memory>
+
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void DoubleOracleKuhnPokerTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  DoubleOracleParams params;
+  params.games_per_pairing = 2000;
+  params.best_response_tolerance = 0.05;
+  params.num_threads = 2;
+  params.seed = 83;
+  DoubleOracleSolver solver(*game, params);
+
+  // The initial "mixture" is the single uniform pool member.
+  double uniform_nash_conv = NashConv(*game, solver.JointMixturePolicy());
+
+  int epochs = 0;
+  while (solver.Iterate() && epochs < 20) ++epochs;
+  SPIEL_CHECK_EQ(solver.NumEpochs(), epochs + 1);
+  // Convergence means both best responses stopped beating the meta-game
+  // value, which takes at least one response per player beyond the uniform
+  // seed policy.
+  SPIEL_CHECK_LT(epochs, 20);
+  SPIEL_CHECK_GT(solver.Pool(Player{0}).size(), 1);
+  SPIEL_CHECK_GT(solver.Pool(Player{1}).size(), 1);
+  for (auto player : {Player{0}, Player{1}}) {
+    SPIEL_CHECK_EQ(solver.MetaStrategy(player).size(),
+                   solver.Pool(player).size());
+    double total = 0;
+    for (double prob : solver.MetaStrategy(player)) {
+      SPIEL_CHECK_GE(prob, 0);
+      total += prob;
+    }
+    SPIEL_CHECK_FLOAT_NEAR(total, 1.0, 1e-9);
+  }
+
+  // The converged mixtures must be far less exploitable than the uniform
+  // seed (0.9166 NashConv); the residual is bounded by the payoff sampling
+  // noise and the best-response tolerance, not zero.
+  double nash_conv = NashConv(*game, solver.JointMixturePolicy());
+  std::cout << "Double oracle on kuhn_poker: " << solver.NumEpochs()
+            << " epochs, pool sizes " << solver.Pool(Player{0}).size() << "/"
+            << solver.Pool(Player{1}).size() << ", NashConv " << nash_conv
+            << " (uniform " << uniform_nash_conv << ")" << std::endl;
+  SPIEL_CHECK_LT(nash_conv, 0.5 * uniform_nash_conv);
+}
+
+void DoubleOracleDeterministicTest() {
+  // Same seed, same run: the tournament seeds, meta-solves and best
+  // responses are all deterministic.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  DoubleOracleParams params;
+  params.games_per_pairing = 200;
+  params.seed = 7;
+  DoubleOracleSolver first(*game, params);
+  DoubleOracleSolver second(*game, params);
+  for (int epoch = 0; epoch < 3; ++epoch) {
+    SPIEL_CHECK_EQ(first.Iterate(), second.Iterate());
+    for (auto player : {Player{0}, Player{1}}) {
+      SPIEL_CHECK_EQ(first.Pool(player).size(), second.Pool(player).size());
+      SPIEL_CHECK_EQ(first.MetaGameValue(player),
+                     second.MetaGameValue(player));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::DoubleOracleKuhnPokerTest();
+  open_spiel::algorithms::DoubleOracleDeterministicTest();
+}
@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/algorithms/evaluate_bots.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>  // NOLINT
+
 #include "open_spiel/spiel_bots.h"
 
 namespace open_spiel {
@@ -25,8 +31,7 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
   for (auto bot : bots) bot->Restart(*state);
   while (!state->IsTerminal()) {
     if (state->IsChanceNode()) {
-      state->ApplyAction(
-          SampleChanceOutcome(state->ChanceOutcomes(), uniform(rng)));
+      state->ApplyAction(state->SampleChanceOutcome(uniform(rng)).first);
     } else if (state->IsSimultaneousNode()) {
       for (auto p = Player{0}; p < num_players; ++p) {
         if (state->LegalActions(p).empty()) {
@@ -37,7 +42,7 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
       }
       state->ApplyActions(joint_actions);
     } else {
-      state->ApplyAction(bots[state->CurrentPlayer()]->Step(*state).second);
+      state->ApplyAction(bots[state->CurrentPlayer()]->StepAction(*state));
     }
   }
 
@@ -45,4 +50,163 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
   return state->Returns();
 }
 
+namespace {
+
+// Sums of one bot's outcomes; enough to recover means and normal-
+// approximation confidence intervals after merging across threads.
+struct BotAccumulator {
+  int num_games = 0;
+  double return_sum = 0;
+  double return_sum_squared = 0;
+  double win_sum = 0;
+  double win_sum_squared = 0;
+};
+
+// Appends every assignment of distinct bots to the remaining seats.
+void AppendRoundRobinPairings(int num_bots, int num_players,
+                              std::vector<int>* pairing,
+                              std::vector<std::vector<int>>* pairings) {
+  if (pairing->size() == num_players) {
+    pairings->push_back(*pairing);
+    return;
+  }
+  for (int bot = 0; bot < num_bots; ++bot) {
+    if (std::find(pairing->begin(), pairing->end(), bot) != pairing->end()) {
+      continue;
+    }
+    pairing->push_back(bot);
+    AppendRoundRobinPairings(num_bots, num_players, pairing, pairings);
+    pairing->pop_back();
+  }
+}
+
+// Half-width of the 95% confidence interval of the mean, from the sums of
+// the samples and of their squares.
+double ConfidenceInterval95(int n, double sum, double sum_squared) {
+  if (n < 2) return 0;
+  const double mean = sum / n;
+  const double variance = (sum_squared - n * mean * mean) / (n - 1);
+  return 1.96 * std::sqrt(std::max(variance, 0.) / n);
+}
+
+}  // namespace
+
+TournamentResults RunTournament(const Game& game,
+                                const std::vector<BotFactory>& bots,
+                                int games_per_pairing, int seed,
+                                int num_threads,
+                                std::vector<std::vector<int>> pairings) {
+  const int num_players = game.NumPlayers();
+  const int num_bots = bots.size();
+  SPIEL_CHECK_GT(games_per_pairing, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (pairings.empty()) {
+    SPIEL_CHECK_GE(num_bots, num_players);
+    std::vector<int> pairing;
+    AppendRoundRobinPairings(num_bots, num_players, &pairing, &pairings);
+  }
+  for (const std::vector<int>& pairing : pairings) {
+    SPIEL_CHECK_EQ(pairing.size(), num_players);
+    for (int bot : pairing) {
+      SPIEL_CHECK_GE(bot, 0);
+      SPIEL_CHECK_LT(bot, num_bots);
+    }
+  }
+
+  // One episode seed and one seed per seat for every scheduled game, drawn
+  // up front so the outcome does not depend on the number of workers.
+  const int num_games = pairings.size() * games_per_pairing;
+  const int seeds_per_game = 1 + num_players;
+  std::mt19937 master_rng(seed);
+  std::vector<uint32_t> seeds(num_games * seeds_per_game);
+  for (uint32_t& game_seed : seeds) game_seed = master_rng();
+
+  // Workers accumulate into their own slots and the sums are merged after
+  // the join, so no synchronisation is needed while playing.
+  std::vector<std::vector<BotAccumulator>> thread_bot_sums(
+      num_threads, std::vector<BotAccumulator>(num_bots));
+  std::vector<std::vector<std::vector<double>>> thread_pairing_sums(
+      num_threads, std::vector<std::vector<double>>(
+                       pairings.size(), std::vector<double>(num_players, 0.)));
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([t, num_threads, num_games, num_players,
+                            games_per_pairing, seeds_per_game, &seeds, &game,
+                            &bots, &pairings, &thread_bot_sums,
+                            &thread_pairing_sums]() {
+        for (int i = t; i < num_games; i += num_threads) {
+          const std::vector<int>& pairing = pairings[i / games_per_pairing];
+          const uint32_t* game_seeds = &seeds[i * seeds_per_game];
+          std::vector<std::unique_ptr<Bot>> players;
+          std::vector<Bot*> player_ptrs;
+          players.reserve(num_players);
+          player_ptrs.reserve(num_players);
+          for (auto p = Player{0}; p < num_players; ++p) {
+            players.push_back(bots[pairing[p]](game, p, game_seeds[1 + p]));
+            player_ptrs.push_back(players.back().get());
+          }
+          std::vector<double> returns = EvaluateBots(
+              game.NewInitialState().get(), player_ptrs, game_seeds[0]);
+
+          const double max_return =
+              *std::max_element(returns.begin(), returns.end());
+          const int num_winners =
+              std::count(returns.begin(), returns.end(), max_return);
+          for (auto p = Player{0}; p < num_players; ++p) {
+            BotAccumulator& sums = thread_bot_sums[t][pairing[p]];
+            const double win = returns[p] == max_return ? 1. / num_winners : 0;
+            ++sums.num_games;
+            sums.return_sum += returns[p];
+            sums.return_sum_squared += returns[p] * returns[p];
+            sums.win_sum += win;
+            sums.win_sum_squared += win * win;
+            thread_pairing_sums[t][i / games_per_pairing][p] += returns[p];
+          }
+        }
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+  }
+
+  TournamentResults results;
+  results.num_games.assign(num_bots, 0);
+  results.avg_returns.assign(num_bots, 0.);
+  results.avg_return_ci95.assign(num_bots, 0.);
+  results.win_rates.assign(num_bots, 0.);
+  results.win_rate_ci95.assign(num_bots, 0.);
+  for (int bot = 0; bot < num_bots; ++bot) {
+    BotAccumulator sums;
+    for (int t = 0; t < num_threads; ++t) {
+      const BotAccumulator& thread_sums = thread_bot_sums[t][bot];
+      sums.num_games += thread_sums.num_games;
+      sums.return_sum += thread_sums.return_sum;
+      sums.return_sum_squared += thread_sums.return_sum_squared;
+      sums.win_sum += thread_sums.win_sum;
+      sums.win_sum_squared += thread_sums.win_sum_squared;
+    }
+    results.num_games[bot] = sums.num_games;
+    if (sums.num_games == 0) continue;
+    results.avg_returns[bot] = sums.return_sum / sums.num_games;
+    results.avg_return_ci95[bot] = ConfidenceInterval95(
+        sums.num_games, sums.return_sum, sums.return_sum_squared);
+    results.win_rates[bot] = sums.win_sum / sums.num_games;
+    results.win_rate_ci95[bot] = ConfidenceInterval95(
+        sums.num_games, sums.win_sum, sums.win_sum_squared);
+  }
+  results.pairing_avg_returns.assign(pairings.size(),
+                                     std::vector<double>(num_players, 0.));
+  for (int p = 0; p < pairings.size(); ++p) {
+    for (auto seat = Player{0}; seat < num_players; ++seat) {
+      for (int t = 0; t < num_threads; ++t) {
+        results.pairing_avg_returns[p][seat] += thread_pairing_sums[t][p][seat];
+      }
+      results.pairing_avg_returns[p][seat] /= games_per_pairing;
+    }
+  }
+  results.pairings = std::move(pairings);
+  return results;
+}
+
 }  // namespace open_spiel
@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -27,6 +29,49 @@ namespace open_spiel {
 std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
                                  int seed);
 
+// Creates a fresh bot playing as player_id. The tournament below constructs
+// the bots it plays with through these factories — a new set for every
+// episode — so no Bot instance is ever shared between worker threads and the
+// results do not depend on episode ordering.
+using BotFactory = std::function<std::unique_ptr<Bot>(
+    const Game& game, Player player_id, int seed)>;
+
+// Aggregated outcome of a tournament. The per-bot vectors are indexed by the
+// bot's position in the factory pool passed to RunTournament.
+struct TournamentResults {
+  // Number of episodes each bot played, over all seats.
+  std::vector<int> num_games;
+
+  // Mean return per bot, and the half-width of its 95% confidence interval
+  // (normal approximation, 1.96 * stderr of the mean).
+  std::vector<double> avg_returns;
+  std::vector<double> avg_return_ci95;
+
+  // A bot scores a win when its return is the episode's maximum; ties share
+  // the win equally. Same confidence interval convention as above.
+  std::vector<double> win_rates;
+  std::vector<double> win_rate_ci95;
+
+  // The schedule that was played: pairings[p][seat] is the bot seated at
+  // `seat` in pairing p, and pairing_avg_returns[p][seat] is that seat's
+  // mean return over the pairing's episodes.
+  std::vector<std::vector<int>> pairings;
+  std::vector<std::vector<double>> pairing_avg_returns;
+};
+
+// Plays games_per_pairing episodes of every pairing and aggregates the
+// results. A pairing assigns one bot from the pool to each seat; if
+// `pairings` is empty, a round-robin schedule is generated: every assignment
+// of distinct bots to the game's seats, so each matchup is played from every
+// seat. Episodes are spread over num_threads workers; seeds are drawn up
+// front from `seed`, so the results are reproducible and independent of the
+// number of workers.
+TournamentResults RunTournament(const Game& game,
+                                const std::vector<BotFactory>& bots,
+                                int games_per_pairing, int seed,
+                                int num_threads = 1,
+                                std::vector<std::vector<int>> pairings = {});
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
@@ -42,7 +42,59 @@ void BotTest_RandomVsRandom() {
   SPIEL_CHECK_FLOAT_NEAR(average_results[1], -0.125, 0.01);
 }
 
+void TournamentTest_RoundRobinRandomBots() {
+  auto game = LoadGame("kuhn_poker");
+  std::vector<BotFactory> bots(3, MakeUniformRandomBot);
+  constexpr int games_per_pairing = 10000;
+  TournamentResults results =
+      RunTournament(*game, bots, games_per_pairing, /*seed=*/8263487);
+
+  // Round-robin over 3 bots and 2 seats: 6 ordered pairings, and each bot
+  // sits in 4 of them.
+  SPIEL_CHECK_EQ(results.pairings.size(), 6);
+  for (int bot = 0; bot < bots.size(); ++bot) {
+    SPIEL_CHECK_EQ(results.num_games[bot], 4 * games_per_pairing);
+    // All bots are uniform random, so everyone's average return is near the
+    // game value averaged over seats (zero) and inside its interval.
+    SPIEL_CHECK_GT(results.avg_return_ci95[bot], 0);
+    SPIEL_CHECK_LE(std::abs(results.avg_returns[bot]),
+                   results.avg_return_ci95[bot] * 3);
+    SPIEL_CHECK_FLOAT_NEAR(results.win_rates[bot], 0.5, 0.02);
+    SPIEL_CHECK_GT(results.win_rate_ci95[bot], 0);
+  }
+  for (int p = 0; p < results.pairings.size(); ++p) {
+    // Kuhn poker is zero-sum, and random-vs-random favours the first mover
+    // by 0.125 (see BotTest_RandomVsRandom above).
+    SPIEL_CHECK_FLOAT_NEAR(results.pairing_avg_returns[p][0] +
+                               results.pairing_avg_returns[p][1],
+                           0., 1e-9);
+    SPIEL_CHECK_FLOAT_NEAR(results.pairing_avg_returns[p][0], 0.125, 0.05);
+  }
+}
+
+void TournamentTest_SameResultsForAnyNumberOfThreads() {
+  auto game = LoadGame("kuhn_poker");
+  std::vector<BotFactory> bots(2, MakeUniformRandomBot);
+  std::vector<std::vector<int>> pairings = {{0, 1}, {1, 0}};
+  TournamentResults one_worker =
+      RunTournament(*game, bots, /*games_per_pairing=*/500, /*seed=*/271,
+                    /*num_threads=*/1, pairings);
+  TournamentResults four_workers =
+      RunTournament(*game, bots, /*games_per_pairing=*/500, /*seed=*/271,
+                    /*num_threads=*/4, pairings);
+  SPIEL_CHECK_TRUE(one_worker.pairings == four_workers.pairings);
+  SPIEL_CHECK_TRUE(one_worker.num_games == four_workers.num_games);
+  SPIEL_CHECK_TRUE(one_worker.avg_returns == four_workers.avg_returns);
+  SPIEL_CHECK_TRUE(one_worker.win_rates == four_workers.win_rates);
+  SPIEL_CHECK_TRUE(one_worker.pairing_avg_returns ==
+                   four_workers.pairing_avg_returns);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::BotTest_RandomVsRandom(); }
+int main(int argc, char** argv) {
+  open_spiel::BotTest_RandomVsRandom();
+  open_spiel::TournamentTest_RoundRobinRandomBots();
+  open_spiel::TournamentTest_SameResultsForAnyNumberOfThreads();
+}
@@ -15,9 +15,11 @@
 #include "open_spiel/algorithms/expected_returns.h"
 
 #include <functional>
+#include <mutex>   // NOLINT
 #include <string>
 #include <vector>
 
+#include "open_spiel/algorithms/tree_traversal.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
 
@@ -25,41 +27,46 @@ namespace open_spiel {
 namespace algorithms {
 namespace {
 
-// Implements the recursive traversal using a general way to access the
-// player's policies via a function that takes as arguments the player id and
-// information state.
-std::vector<double> ExpectedReturnsImpl(
-    const State& state,
+// A cache shared between the worker threads of one evaluation; lookups and
+// insertions are brief, so one mutex suffices.
+struct SharedCache {
+  ExpectedReturnsCache* values;
+  std::mutex mutex;
+};
+
+// Collects the weighted subtrees under `state` — its chance outcomes, its
+// positive-probability joint actions, or its positive-probability actions —
+// and returns the value contribution of the state itself (its rewards, or
+// zero at a chance node). `key` is the structure-cache key of `state`; the
+// keys of the collected subtrees are appended to `child_keys` in step.
+std::vector<double> CollectSubtrees(
+    const State& state, uint64_t key, TreeStructureCache* structure,
     const std::function<ActionsAndProbs(Player, const std::string&)>&
         policy_func,
-    int depth_limit) {
-  if (state.IsTerminal() || depth_limit == 0) {
-    return state.Rewards();
-  }
-
-  int num_players = state.NumPlayers();
-  std::vector<double> values(num_players, 0.0);
+    std::vector<std::unique_ptr<State>>* subtrees,
+    std::vector<double>* weights, std::vector<uint64_t>* child_keys) {
+  const int num_players = state.NumPlayers();
   if (state.IsChanceNode()) {
-    ActionsAndProbs action_and_probs = state.ChanceOutcomes();
-    for (const auto& action_and_prob : action_and_probs) {
-      std::unique_ptr<State> child = state.Child(action_and_prob.first);
-      std::vector<double> child_values =
-          ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
-      for (auto p = Player{0}; p < num_players; ++p) {
-        values[p] += action_and_prob.second * child_values[p];
-      }
+    ActionsAndProbs fresh_outcomes;
+    if (structure == nullptr) fresh_outcomes = state.ChanceOutcomes();
+    const ActionsAndProbs& outcomes = structure != nullptr
+                                          ? structure->ChanceOutcomes(key, state)
+                                          : fresh_outcomes;
+    for (const auto& action_and_prob : outcomes) {
+      subtrees->push_back(state.Child(action_and_prob.first));
+      weights->push_back(action_and_prob.second);
+      child_keys->push_back(
+          TreeStructureCache::ChildKey(key, action_and_prob.first));
     }
+    return std::vector<double>(num_players, 0.0);
   } else if (state.IsSimultaneousNode()) {
-    // Walk over all the joint actions, and weight by the product of
-    // probabilities to choose them.
-    values = state.Rewards();
     auto smstate = dynamic_cast<const SimMoveState*>(&state);
     SPIEL_CHECK_TRUE(smstate != nullptr);
     std::vector<ActionsAndProbs> state_policies(num_players);
     for (auto p = Player{0}; p < num_players; ++p) {
       state_policies[p] = policy_func(p, state.InformationState(p));
       if (state_policies[p].empty()) {
-        SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
+        SpielFatalError("Error in ExpectedReturns; infostate not found.");
       }
     }
     for (const Action flat_action : smstate->LegalActions()) {
@@ -67,73 +74,256 @@ std::vector<double> ExpectedReturnsImpl(
           smstate->FlatJointActionToActions(flat_action);
       double joint_action_prob = 1.0;
       for (auto p = Player{0}; p < num_players; ++p) {
-        double player_action_prob = GetProb(state_policies[p], actions[p]);
-        SPIEL_CHECK_GE(player_action_prob, 0.0);
-        SPIEL_CHECK_LE(player_action_prob, 1.0);
-        joint_action_prob *= player_action_prob;
-        if (player_action_prob == 0.0) {
-          break;
-        }
+        joint_action_prob *= GetProb(state_policies[p], actions[p]);
+        if (joint_action_prob == 0.0) break;
       }
-
       if (joint_action_prob > 0.0) {
         std::unique_ptr<State> child = state.Clone();
         child->ApplyActions(actions);
-        std::vector<double> child_values =
-            ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
-        for (auto p = Player{0}; p < num_players; ++p) {
-          values[p] += joint_action_prob * child_values[p];
-        }
+        subtrees->push_back(std::move(child));
+        weights->push_back(joint_action_prob);
+        child_keys->push_back(TreeStructureCache::ChildKey(key, flat_action));
       }
     }
   } else {
-    // Turn-based decision node.
-    Player player = state.CurrentPlayer();
     ActionsAndProbs state_policy =
-        policy_func(player, state.InformationState());
+        policy_func(state.CurrentPlayer(), state.InformationState());
     if (state_policy.empty()) {
-      SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
+      SpielFatalError("Error in ExpectedReturns; infostate not found.");
     }
-    values = state.Rewards();
     for (const Action action : state.LegalActions()) {
-      std::unique_ptr<State> child = state.Child(action);
-      double action_prob = GetProb(state_policy, action);
+      const double action_prob = GetProb(state_policy, action);
       SPIEL_CHECK_GE(action_prob, 0.0);
       SPIEL_CHECK_LE(action_prob, 1.0);
       if (action_prob > 0.0) {
-        std::vector<double> child_values =
-            ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
-        for (auto p = Player{0}; p < num_players; ++p) {
-          values[p] += action_prob * child_values[p];
-        }
+        subtrees->push_back(state.Child(action));
+        weights->push_back(action_prob);
+        child_keys->push_back(TreeStructureCache::ChildKey(key, action));
       }
     }
   }
-  SPIEL_CHECK_EQ(values.size(), state.NumPlayers());
+  return state.Rewards();
+}
+
+// One frame of the iterative traversal: the weighted subtrees of one state,
+// the values accumulated for it so far, and where to fold the result once
+// all subtrees are done.
+struct ReturnsFrame {
+  std::vector<std::unique_ptr<State>> subtrees;
+  std::vector<double> weights;
+  std::vector<uint64_t> child_keys;  // Structure-cache keys of the subtrees.
+  std::vector<double> values;
+  int next_child;
+  int depth_limit;
+  int parent;  // Frame index of the parent, or -1 at the root.
+  double weight_into_parent;
+  uint64_t cache_key;
+  bool cache_store;
+};
+
+// Implements the traversal using a general way to access the player's
+// policies via a function that takes as arguments the player id and
+// information state. The walk is iterative over a FrameStack so that the
+// supported game depth is not bounded by the thread stack.
+std::vector<double> ExpectedReturnsImpl(
+    const State& state, uint64_t structure_key, TreeStructureCache* structure,
+    const std::function<ActionsAndProbs(Player, const std::string&)>&
+        policy_func,
+    int depth_limit, SharedCache* cache) {
+  std::vector<double> root_values;
+  FrameStack<ReturnsFrame> stack;
+
+  // Opens the frame for `state` on top of the stack: terminal, depth-capped
+  // and cached states get their values directly and no subtrees; everything
+  // else gets its base contribution and weighted subtrees to descend into.
+  auto open_frame = [&stack, &policy_func, cache, structure](
+                        const State& state, uint64_t structure_key,
+                        int depth_limit, int parent, double weight) {
+    ReturnsFrame& frame = stack[stack.Push()];
+    frame.subtrees.clear();
+    frame.weights.clear();
+    frame.child_keys.clear();
+    frame.next_child = 0;
+    frame.depth_limit = depth_limit;
+    frame.parent = parent;
+    frame.weight_into_parent = weight;
+    frame.cache_key = 0;
+    frame.cache_store = false;
+    if (state.IsTerminal()) {
+      frame.values = structure != nullptr
+                         ? structure->TerminalRewards(structure_key, state)
+                         : state.Rewards();
+      return;
+    }
+    if (depth_limit == 0) {
+      frame.values = state.Rewards();
+      return;
+    }
+    if (cache != nullptr) {
+      frame.cache_key = state.HashValue();
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      auto it = cache->values->find(frame.cache_key);
+      if (it != cache->values->end()) {
+        frame.values = it->second;
+        return;
+      }
+      frame.cache_store = true;
+    }
+    frame.values =
+        CollectSubtrees(state, structure_key, structure, policy_func,
+                        &frame.subtrees, &frame.weights, &frame.child_keys);
+  };
+
+  open_frame(state, structure_key, depth_limit, /*parent=*/-1, 1.0);
+  while (!stack.Empty()) {
+    ReturnsFrame& frame = stack.Top();
+    if (frame.next_child < frame.subtrees.size()) {
+      const int child = frame.next_child++;
+      // The previous child's subtree is fully evaluated; free its state.
+      if (child > 0) frame.subtrees[child - 1].reset();
+      // open_frame may grow the stack and invalidate `frame`; the child
+      // state itself is heap-owned by the parent frame and stays put.
+      open_frame(*frame.subtrees[child], frame.child_keys[child],
+                 frame.depth_limit - 1,
+                 /*parent=*/stack.Depth() - 1, frame.weights[child]);
+      continue;
+    }
+    // All subtrees folded in; close the frame.
+    if (frame.cache_store) {
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      cache->values->emplace(frame.cache_key, frame.values);
+    }
+    frame.subtrees.clear();
+    if (frame.parent < 0) {
+      root_values = std::move(frame.values);
+      stack.Pop();
+    } else {
+      ReturnsFrame& parent_frame = stack[frame.parent];
+      SPIEL_CHECK_EQ(frame.values.size(), parent_frame.values.size());
+      for (int p = 0; p < frame.values.size(); ++p) {
+        parent_frame.values[p] += frame.weight_into_parent * frame.values[p];
+      }
+      stack.Pop();
+    }
+  }
+  return root_values;
+}
+
+// Entry point shared by the public overloads: dispatches between the serial
+// recursion and the parallel fan-out of the top-level subtrees.
+std::vector<double> ExpectedReturnsTopLevel(
+    const State& state,
+    const std::function<ActionsAndProbs(Player, const std::string&)>&
+        policy_func,
+    int depth_limit, int num_threads, ExpectedReturnsCache* cache_values,
+    TreeStructureCache* structure) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  // Cached values depend on the remaining depth, so the cache is only used
+  // for full traversals.
+  SharedCache cache{depth_limit < 0 ? cache_values : nullptr};
+  SharedCache* cache_ptr = cache.values == nullptr ? nullptr : &cache;
+  if (num_threads == 1) {
+    return ExpectedReturnsImpl(state, TreeStructureCache::kRootKey, structure,
+                               policy_func, depth_limit, cache_ptr);
+  }
+  if (state.IsTerminal() || depth_limit == 0) {
+    return state.Rewards();
+  }
+
+  std::vector<std::unique_ptr<State>> subtrees;
+  std::vector<double> weights;
+  std::vector<uint64_t> child_keys;
+  std::vector<double> values =
+      CollectSubtrees(state, TreeStructureCache::kRootKey, structure,
+                      policy_func, &subtrees, &weights, &child_keys);
+
+  // One task per subtree on the shared pool; the per-subtree values are
+  // reduced in subtree order afterwards, so the result does not depend on
+  // which worker ran what.
+  const int num_players = state.NumPlayers();
+  std::vector<std::vector<double>> subtree_values(subtrees.size());
+  {
+    TaskGroup group(TaskPool::Global());
+    for (int i = 0; i < subtrees.size(); ++i) {
+      group.Spawn([i, depth_limit, cache_ptr, structure, &subtrees,
+                   &child_keys, &policy_func, &subtree_values]() {
+        subtree_values[i] =
+            ExpectedReturnsImpl(*subtrees[i], child_keys[i], structure,
+                                policy_func, depth_limit - 1, cache_ptr);
+      });
+    }
+    group.Sync();
+  }
+  for (int i = 0; i < subtrees.size(); ++i) {
+    for (auto p = Player{0}; p < num_players; ++p) {
+      values[p] += weights[i] * subtree_values[i][p];
+    }
+  }
   return values;
 }
 }  // namespace
 
+uint64_t TreeStructureCache::ChildKey(uint64_t parent_key, Action action) {
+  // splitmix64 finalizer over the parent key combined with the action.
+  uint64_t key =
+      parent_key ^ (static_cast<uint64_t>(action) + 0x9e3779b97f4a7c15ULL);
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+const std::vector<double>& TreeStructureCache::TerminalRewards(
+    uint64_t key, const State& state) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = terminal_rewards_.find(key);
+    if (it != terminal_rewards_.end()) return it->second;
+  }
+  // Compute outside the lock; the game engine may be slow here.
+  std::vector<double> rewards = state.Rewards();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return terminal_rewards_.emplace(key, std::move(rewards)).first->second;
+}
+
+const ActionsAndProbs& TreeStructureCache::ChanceOutcomes(uint64_t key,
+                                                          const State& state) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = chance_outcomes_.find(key);
+    if (it != chance_outcomes_.end()) return it->second;
+  }
+  ActionsAndProbs outcomes = state.ChanceOutcomes();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return chance_outcomes_.emplace(key, std::move(outcomes)).first->second;
+}
+
 std::vector<double> ExpectedReturns(const State& state,
                                     const std::vector<const Policy*>& policies,
-                                    int depth_limit) {
-  return ExpectedReturnsImpl(
+                                    int depth_limit, int num_threads,
+                                    ExpectedReturnsCache* cache,
+                                    TreeStructureCache* structure) {
+  return ExpectedReturnsTopLevel(
       state,
       [&policies](Player player, const std::string& info_state) {
         return policies[player]->GetStatePolicy(info_state);
       },
-      depth_limit);
+      depth_limit, num_threads, cache, structure);
 }
 
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit) {
-  return ExpectedReturnsImpl(
+                                    int depth_limit, int num_threads,
+                                    ExpectedReturnsCache* cache,
+                                    TreeStructureCache* structure) {
+  return ExpectedReturnsTopLevel(
       state,
       [&joint_policy](Player player, const std::string& info_state) {
         return joint_policy.GetStatePolicy(info_state);
       },
-      depth_limit);
+      depth_limit, num_threads, cache, structure);
 }
 
 }  // namespace algorithms
@@ -15,7 +15,11 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 
+#include <cstdint>
+#include <mutex>  // NOLINT
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -23,18 +27,71 @@
 namespace open_spiel {
 namespace algorithms {
 
+// A reusable value cache for ExpectedReturns, keyed on State::HashValue(), so
+// transpositions are evaluated once. The cached values are only valid for the
+// policy they were computed under: reuse the cache across calls that evaluate
+// the same policy (e.g. from many start states) and discard it when the
+// policy changes. Only usable with games whose states implement HashValue
+// (see Game::ProvidesHashValue); it is ignored for depth-limited traversals,
+// whose values depend on the remaining depth.
+using ExpectedReturnsCache = std::unordered_map<uint64_t, std::vector<double>>;
+
+// A cache of tree structure — terminal rewards and chance outcome
+// distributions — for repeated evaluations of the same game tree. Unlike the
+// value cache above, the contents do not depend on the policy, so one
+// instance serves every pass of a sweep that evaluates many policies (e.g.
+// exploitability across training checkpoints): the game engine computes each
+// terminal and each chance distribution once, on the first pass. Entries are
+// keyed by a hash of the action path from the root state, built up by the
+// traversal itself, so any game can use it; only share an instance across
+// calls rooted at the same state, since the paths are relative to that root.
+// Thread-safe; usable with depth limits, since neither quantity depends on
+// the remaining depth.
+class TreeStructureCache {
+ public:
+  // The key of the root state, and the key of the child reached by applying
+  // `action` (the flat joint action at simultaneous nodes) to the state with
+  // key `parent_key`. Keys are 64-bit hashes of the action path; distinct
+  // paths collide with negligible probability.
+  static constexpr uint64_t kRootKey = 0;
+  static uint64_t ChildKey(uint64_t parent_key, Action action);
+
+  // Return the rewards of the terminal state / the chance outcomes of the
+  // chance node with the given key, computing and retaining them from `state`
+  // on first sight. Entries are never removed, so the references stay valid
+  // for the lifetime of the cache.
+  const std::vector<double>& TerminalRewards(uint64_t key, const State& state);
+  const ActionsAndProbs& ChanceOutcomes(uint64_t key, const State& state);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<double>> terminal_rewards_;
+  std::unordered_map<uint64_t, ActionsAndProbs> chance_outcomes_;
+};
+
 // Computes the (undiscounted) expected returns from a depth-limited search
 // starting at the state and following each player's policy. Using a negative
 // depth will do a full tree traversal (from the specified state).
 //
+// With num_threads > 1, the subtrees under the given state — its chance
+// outcomes or its positive-probability actions — are evaluated across that
+// many worker threads and the weighted results summed. An optional cache (see
+// above) deduplicates transpositions within and across calls, and an optional
+// structure cache reuses terminal rewards and chance distributions across
+// calls, including calls under different policies.
+//
 // The second overloaded function acts the same way, except assumes that all of
 // the players' policies are encapsulated in one joint policy.
 std::vector<double> ExpectedReturns(const State& state,
                                     const std::vector<const Policy*>& policies,
-                                    int depth_limit);
+                                    int depth_limit, int num_threads = 1,
+                                    ExpectedReturnsCache* cache = nullptr,
+                                    TreeStructureCache* structure = nullptr);
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit);
+                                    int depth_limit, int num_threads = 1,
+                                    ExpectedReturnsCache* cache = nullptr,
+                                    TreeStructureCache* structure = nullptr);
 
 }  // namespace algorithms
 }  // namespace open_spiel
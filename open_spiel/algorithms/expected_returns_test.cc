@@ -0,0 +1,101 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/expected_returns.h"
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The parallel fan-out must agree with the serial recursion.
+void ParallelMatchesSerial(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<double> serial = ExpectedReturns(*state, policy, -1);
+  std::vector<double> parallel =
+      ExpectedReturns(*state, policy, -1, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(serial.size(), parallel.size());
+  for (int p = 0; p < serial.size(); ++p) {
+    SPIEL_CHECK_FLOAT_NEAR(parallel[p], serial[p], 1e-12);
+  }
+}
+
+// A transposition's subtree is identical wherever it is reached, so caching
+// its value must not change the result — serially or in parallel, within a
+// call or across calls under the same policy.
+void CachedMatchesUncached() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<double> uncached = ExpectedReturns(*state, policy, -1);
+
+  ExpectedReturnsCache cache;
+  std::vector<double> cached =
+      ExpectedReturns(*state, policy, -1, /*num_threads=*/1, &cache);
+  SPIEL_CHECK_FALSE(cache.empty());
+  for (int p = 0; p < uncached.size(); ++p) {
+    SPIEL_CHECK_FLOAT_NEAR(cached[p], uncached[p], 1e-12);
+  }
+
+  // Reusing the warm cache, serially or in parallel, gives the same values.
+  for (int num_threads : {1, 4}) {
+    std::vector<double> warm =
+        ExpectedReturns(*state, policy, -1, num_threads, &cache);
+    for (int p = 0; p < uncached.size(); ++p) {
+      SPIEL_CHECK_FLOAT_NEAR(warm[p], uncached[p], 1e-12);
+    }
+  }
+}
+
+// The structure cache holds only terminal rewards and chance distributions,
+// so one instance must give the same values as no cache under every policy
+// it is shared across — the sweep it exists for.
+void StructureCacheSharedAcrossPolicies(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies = {GetUniformPolicy(*game),
+                                         GetFirstActionPolicy(*game)};
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  TreeStructureCache structure;
+  for (const TabularPolicy& policy : policies) {
+    std::vector<double> uncached = ExpectedReturns(*state, policy, -1);
+    // The second policy runs against the cache warmed by the first.
+    for (int num_threads : {1, 4}) {
+      std::vector<double> with_structure =
+          ExpectedReturns(*state, policy, -1, num_threads,
+                          /*cache=*/nullptr, &structure);
+      SPIEL_CHECK_EQ(uncached.size(), with_structure.size());
+      for (int p = 0; p < uncached.size(); ++p) {
+        SPIEL_CHECK_FLOAT_NEAR(with_structure[p], uncached[p], 1e-12);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::ParallelMatchesSerial("kuhn_poker");
+  open_spiel::algorithms::ParallelMatchesSerial("tic_tac_toe");
+  open_spiel::algorithms::CachedMatchesUncached();
+  open_spiel::algorithms::StructureCacheSharedAcrossPolicies("kuhn_poker");
+  open_spiel::algorithms::StructureCacheSharedAcrossPolicies("leduc_poker");
+}
@@ -0,0 +1,186 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/exploitability_estimator.h"
+
+#include <cmath>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+double RandomUniform(std::mt19937* rng) {
+  return std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+}
+
+// Samples an action for the current player from the policy, falling back
+// to uniform over the legal actions for information states the policy
+// does not cover yet (e.g. ones not published to a live view).
+Action SamplePolicyAction(const State& state, const Policy& policy,
+                          std::mt19937* rng) {
+  ActionsAndProbs actions_and_probs =
+      policy.GetStatePolicy(state.InformationState());
+  if (actions_and_probs.empty()) {
+    std::vector<Action> legal_actions = state.LegalActions();
+    return legal_actions[static_cast<int>(RandomUniform(rng) *
+                                          legal_actions.size())];
+  }
+  return SampleChanceOutcome(actions_and_probs, RandomUniform(rng));
+}
+
+}  // namespace
+
+ExploitabilityEstimator::ExploitabilityEstimator(
+    std::shared_ptr<const Game> game, std::shared_ptr<const Policy> policy,
+    int seed)
+    : game_(std::move(game)),
+      policy_(std::move(policy)),
+      rng_(seed),
+      response_tables_(game_->NumPlayers()) {}
+
+ExploitabilityEstimator::~ExploitabilityEstimator() { Stop(); }
+
+void ExploitabilityEstimator::RunSamples(int num_samples) {
+  for (int i = 0; i < num_samples; ++i) {
+    SampleOnce(&rng_);
+  }
+}
+
+void ExploitabilityEstimator::Start() {
+  SPIEL_CHECK_FALSE(worker_.joinable());
+  stop_ = false;
+  worker_ = std::thread([this]() {
+    std::mt19937 rng(rng_());
+    while (!stop_.load(std::memory_order_relaxed)) {
+      SampleOnce(&rng);
+    }
+  });
+}
+
+void ExploitabilityEstimator::Stop() {
+  if (!worker_.joinable()) return;
+  stop_ = true;
+  worker_.join();
+}
+
+ExploitabilityEstimator::Estimate ExploitabilityEstimator::GetEstimate()
+    const {
+  std::lock_guard<std::mutex> lock(estimate_mutex_);
+  return estimate_;
+}
+
+void ExploitabilityEstimator::SampleOnce(std::mt19937* rng) {
+  // One on-policy rollout gives every player's baseline value at once.
+  std::unique_ptr<State> state = game_->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(RandomUniform(rng)).first);
+    } else if (state->IsSimultaneousNode()) {
+      SpielFatalError(
+          "Simultaneous moves not supported. Use "
+          "TurnBasedSimultaneousGame to convert the game first.");
+    } else {
+      state->ApplyAction(SamplePolicyAction(*state, *policy_, rng));
+    }
+  }
+  const std::vector<double> on_policy_returns = state->Returns();
+
+  double nash_conv_sample = 0;
+  for (Player p = 0; p < game_->NumPlayers(); ++p) {
+    nash_conv_sample += BestResponseValue(*game_->NewInitialState(), p, rng) -
+                        on_policy_returns[p];
+  }
+
+  ++total_samples_;
+  ++window_count_;
+  const double delta = nash_conv_sample - window_mean_;
+  window_mean_ += delta / window_count_;
+  window_m2_ += delta * (nash_conv_sample - window_mean_);
+  if (window_count_ >= kSamplesPerWindow) PublishWindow();
+}
+
+double ExploitabilityEstimator::BestResponseValue(const State& state,
+                                                  Player best_responder,
+                                                  std::mt19937* rng) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(best_responder);
+  } else if (state.IsChanceNode()) {
+    const Action outcome =
+        state.SampleChanceOutcome(RandomUniform(rng)).first;
+    return BestResponseValue(*state.Child(outcome), best_responder, rng);
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  if (state.CurrentPlayer() != best_responder) {
+    return BestResponseValue(
+        *state.Child(SamplePolicyAction(state, *policy_, rng)),
+        best_responder, rng);
+  }
+
+  const std::vector<Action> legal_actions = state.LegalActions();
+  ResponseEntry& entry =
+      response_tables_[best_responder][state.InformationState()];
+  if (entry.value.empty()) {
+    entry.value.resize(legal_actions.size(), 0);
+    entry.count.resize(legal_actions.size(), 0);
+  }
+
+  // Epsilon-greedy over the running action values, trying each action
+  // once before trusting any estimate.
+  int aidx = -1;
+  if (RandomUniform(rng) < kExploreProb) {
+    aidx = static_cast<int>(RandomUniform(rng) * legal_actions.size());
+  } else {
+    for (int i = 0; i < static_cast<int>(legal_actions.size()); ++i) {
+      if (entry.count[i] == 0) {
+        aidx = i;
+        break;
+      }
+      if (aidx < 0 || entry.value[i] > entry.value[aidx]) aidx = i;
+    }
+  }
+
+  const double value = BestResponseValue(*state.Child(legal_actions[aidx]),
+                                         best_responder, rng);
+  ++entry.count[aidx];
+  entry.value[aidx] += (value - entry.value[aidx]) / entry.count[aidx];
+  return value;
+}
+
+void ExploitabilityEstimator::PublishWindow() {
+  const double std_error =
+      window_count_ > 1
+          ? std::sqrt(window_m2_ / (window_count_ - 1) / window_count_)
+          : 0;
+  {
+    std::lock_guard<std::mutex> lock(estimate_mutex_);
+    estimate_.nash_conv = window_mean_;
+    estimate_.std_error = std_error;
+    estimate_.num_samples = total_samples_;
+  }
+  stats::SetGauge(stats::kNashConvEstimateMicros,
+                  std::llround(window_mean_ * 1e6));
+  window_count_ = 0;
+  window_mean_ = 0;
+  window_m2_ = 0;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
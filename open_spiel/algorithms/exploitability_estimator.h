@@ -0,0 +1,147 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_ESTIMATOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_ESTIMATOR_H_
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A continuous, sampling-based NashConv estimate for a policy that is
+// still training. The exact computation (tabular_exploitability.h) walks
+// the whole tree and is far too slow to run per iteration; this class
+// instead maintains an approximate best response per player — a table of
+// running action-value estimates, improved by epsilon-greedy sampled
+// traversals against the current policy — and treats the traversal
+// returns as samples of each player's best-response value. Together with
+// on-policy rollouts for the baseline values, every sample yields a
+// one-shot NashConv estimate; the published figure is the mean of the
+// most recent window of samples, with its standard error as the error
+// bar. Windowing matters because the target moves: both the policy under
+// evaluation and the approximate best response improve over time, so old
+// samples describe a policy that no longer exists.
+//
+// The estimate approaches NashConv from below (the sampled best response
+// never beats the exact one, and exploration costs it a little more), so
+// it is a cheap early-stopping signal rather than a certificate:
+// continue training while it is clearly above the target, and pay for
+// the exact computation only when it drops under.
+//
+// The estimator reads the policy through the Policy interface only, so
+// handing it the solver's LiveAveragePolicy view lets the background
+// thread run concurrently with training. GetEstimate() is safe from any
+// thread; Start/Stop/RunSamples must not race each other. Each published
+// estimate is also pushed to the stats::kNashConvEstimateMicros gauge.
+class ExploitabilityEstimator {
+ public:
+  // Probability of a uniform exploration step at the best responder's
+  // nodes, so the response tables keep up with a changing policy.
+  static inline constexpr double kExploreProb = 0.1;
+
+  // Samples folded into each published estimate.
+  static inline constexpr int kSamplesPerWindow = 1000;
+
+  struct Estimate {
+    // NaN until the first window completes.
+    double nash_conv = std::numeric_limits<double>::quiet_NaN();
+    double std_error = std::numeric_limits<double>::quiet_NaN();
+    // Cumulative samples over the estimator's lifetime, across windows.
+    int64_t num_samples = 0;
+  };
+
+  // The game and policy must outlive the estimator. The policy is only
+  // read, one information state at a time; pass the training solver's
+  // live view to estimate during training, or any fixed policy to
+  // estimate it offline.
+  ExploitabilityEstimator(std::shared_ptr<const Game> game,
+                          std::shared_ptr<const Policy> policy, int seed = 0);
+
+  // Stops the background thread, if running.
+  ~ExploitabilityEstimator();
+
+  // Runs `num_samples` estimation samples on the calling thread. For
+  // deterministic use (e.g. tests) or callers with their own scheduling;
+  // must not overlap a started background thread.
+  void RunSamples(int num_samples);
+
+  // Starts the background estimation thread, which samples continuously
+  // until Stop() (or destruction). It costs roughly one core.
+  void Start();
+
+  // Stops and joins the background thread. No-op if not running.
+  void Stop();
+
+  // The most recently published estimate.
+  Estimate GetEstimate() const;
+
+ private:
+  // Running action-value estimates for the best responder at one
+  // information state, indexed like the state's legal actions.
+  struct ResponseEntry {
+    std::vector<double> value;
+    std::vector<int> count;
+  };
+
+  // One estimation sample: an on-policy rollout for the baseline values
+  // plus one best-response traversal per player.
+  void SampleOnce(std::mt19937* rng);
+
+  // Samples one traversal where `best_responder` plays epsilon-greedily
+  // against its response table (updated along the way) and everyone else
+  // follows the policy; returns the responder's sampled return.
+  double BestResponseValue(const State& state, Player best_responder,
+                           std::mt19937* rng);
+
+  // Publishes the current window's mean and standard error, then resets
+  // the window accumulators.
+  void PublishWindow();
+
+  std::shared_ptr<const Game> game_;
+  std::shared_ptr<const Policy> policy_;
+  std::mt19937 rng_;
+
+  // One approximate best-response table per player.
+  std::vector<std::unordered_map<std::string, ResponseEntry>>
+      response_tables_;
+
+  // Welford accumulators for the current window.
+  int window_count_ = 0;
+  double window_mean_ = 0;
+  double window_m2_ = 0;
+  int64_t total_samples_ = 0;
+
+  mutable std::mutex estimate_mutex_;
+  Estimate estimate_;
+
+  std::thread worker_;
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_ESTIMATOR_H_
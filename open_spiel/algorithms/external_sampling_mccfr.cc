@@ -14,8 +14,16 @@
 
 #include "open_spiel/algorithms/external_sampling_mccfr.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <numeric>
 #include <random>
+#include <sstream>
+#include <string>
+#include <thread>
 
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/spiel.h"
@@ -23,6 +31,230 @@
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
+
+// Returns a locked guard on `mutex` when `threaded`, and an unlocked (and
+// therefore free) one otherwise, so the single-threaded paths pay nothing.
+std::unique_lock<std::mutex> MaybeLock(std::mutex& mutex, bool threaded) {
+  if (threaded) return std::unique_lock<std::mutex>(mutex);
+  return std::unique_lock<std::mutex>(mutex, std::defer_lock);
+}
+
+// Draws a uniform sample in [0, 1) from `rng`. The distribution object is
+// local so sampling is safe from multiple threads with distinct generators.
+double RandomUniform(std::mt19937* rng) {
+  return std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+}
+
+constexpr char kMCCFRCheckpointMagic[8] = {'O', 'S', 'M', 'C', 'C', 'v', '0',
+                                           '1'};
+constexpr char kMCCFRDeltaMagic[8] = {'O', 'S', 'M', 'C', 'D', 'v', '0', '1'};
+
+// Appends the raw bytes of `value` to `out`.
+template <typename T>
+void AppendRaw(const T& value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// A bounds-checked cursor over a serialized delta message.
+struct ByteReader {
+  const char* pos;
+  const char* end;
+
+  template <typename T>
+  T Read() {
+    if (end - pos < static_cast<int64_t>(sizeof(T))) {
+      SpielFatalError("Truncated MCCFR delta message.");
+    }
+    T value;
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString(uint64_t size) {
+    if (end - pos < static_cast<int64_t>(size)) {
+      SpielFatalError("Truncated MCCFR delta message.");
+    }
+    std::string value(pos, size);
+    pos += size;
+    return value;
+  }
+};
+
+// Appends one table in the checkpoint record layout: per entry, the key,
+// the legal actions (so a restarted worker can rebuild entries the game
+// has not revisited yet) and the three value rows.
+void AppendTable(const CFRInfoStateValuesTable& table, std::string* out) {
+  AppendRaw(static_cast<uint64_t>(table.size()), out);
+  for (const auto& entry : table) {
+    AppendRaw(static_cast<uint64_t>(entry.first.size()), out);
+    out->append(entry.first);
+    const CFRInfoStateValues& is_vals = entry.second;
+    const uint64_t num_actions = is_vals.num_actions();
+    AppendRaw(num_actions, out);
+    out->append(reinterpret_cast<const char*>(is_vals.legal_actions.data()),
+                num_actions * sizeof(Action));
+    out->append(
+        reinterpret_cast<const char*>(is_vals.cumulative_regrets.data()),
+        num_actions * sizeof(double));
+    out->append(
+        reinterpret_cast<const char*>(is_vals.cumulative_policy.data()),
+        num_actions * sizeof(double));
+    out->append(reinterpret_cast<const char*>(is_vals.current_policy.data()),
+                num_actions * sizeof(double));
+  }
+}
+
+// Writes `bytes` to `filename`, replacing any existing file. Returns an
+// empty string on success and a description of the failure otherwise.
+std::string WriteCheckpointBytes(const std::string& bytes,
+                                 const std::string& filename) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return absl::StrCat("Cannot open checkpoint file: ", filename);
+  }
+  file.write(bytes.data(), bytes.size());
+  file.close();
+  if (!file) {
+    return absl::StrCat("Error writing checkpoint to: ", filename);
+  }
+  return "";
+}
+
+// Reads a table written by WriteTable, replacing the contents of `table`.
+void ReadTable(std::ifstream* file, const std::string& filename,
+               CFRInfoStateValuesTable* table) {
+  uint64_t num_entries;
+  file->read(reinterpret_cast<char*>(&num_entries), sizeof(num_entries));
+  table->clear();
+  std::string key;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    uint64_t key_size;
+    file->read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+    key.resize(key_size);
+    file->read(&key[0], key_size);
+    uint64_t num_actions;
+    file->read(reinterpret_cast<char*>(&num_actions), sizeof(num_actions));
+    if (!*file) {
+      SpielFatalError(absl::StrCat("Truncated checkpoint file: ", filename));
+    }
+    std::vector<Action> legal_actions(num_actions);
+    file->read(reinterpret_cast<char*>(legal_actions.data()),
+               num_actions * sizeof(Action));
+    CFRInfoStateValues is_vals(legal_actions, 0);
+    file->read(reinterpret_cast<char*>(is_vals.cumulative_regrets.data()),
+               num_actions * sizeof(double));
+    file->read(reinterpret_cast<char*>(is_vals.cumulative_policy.data()),
+               num_actions * sizeof(double));
+    file->read(reinterpret_cast<char*>(is_vals.current_policy.data()),
+               num_actions * sizeof(double));
+    table->insert({key, std::move(is_vals)});
+  }
+  if (!*file) {
+    SpielFatalError(absl::StrCat("Truncated checkpoint file: ", filename));
+  }
+}
+
+}  // namespace
+
+ActionsAndProbs LiveAveragePolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  ActionsAndProbs actions_and_probs;
+  GetStatePolicyInto(info_state, &actions_and_probs);
+  return actions_and_probs;
+}
+
+void LiveAveragePolicy::GetStatePolicyInto(const std::string& info_state,
+                                           ActionsAndProbs* out) const {
+  out->clear();
+  const IndexedEntry* indexed = FindEntry(info_state);
+  if (indexed == nullptr) {
+    if (default_policy_) {
+      default_policy_->GetStatePolicyInto(info_state, out);
+    }
+    return;
+  }
+
+  // Read each cumulative value exactly once, so the normalization below is
+  // consistent with the values handed back. The values come from the
+  // atomic mirror row, never from the entry the training thread mutates.
+  const int num_actions = indexed->entry->num_actions();
+  double sum_prob = 0.0;
+  out->reserve(num_actions);
+  for (int aidx = 0; aidx < num_actions; ++aidx) {
+    const double cumulative =
+        indexed->row[aidx].load(std::memory_order_relaxed);
+    sum_prob += cumulative;
+    out->push_back({indexed->entry->legal_actions[aidx], cumulative});
+  }
+
+  if (sum_prob == 0.0) {
+    // Return a uniform policy at this node, matching CFRAveragePolicy.
+    const double prob = 1.0 / num_actions;
+    for (auto& action_and_prob : *out) action_and_prob.second = prob;
+  } else {
+    for (auto& action_and_prob : *out) action_and_prob.second /= sum_prob;
+  }
+}
+
+const LiveAveragePolicy::IndexedEntry* LiveAveragePolicy::FindEntry(
+    const std::string& info_state) const {
+  const Index* index = index_.load(std::memory_order_acquire);
+  if (index == nullptr) return nullptr;
+  auto iter = std::lower_bound(
+      index->begin(), index->end(), info_state,
+      [](const IndexedEntry& entry, const std::string& key) {
+        return entry.key < key;
+      });
+  if (iter == index->end() || iter->key != info_state) return nullptr;
+  return &*iter;
+}
+
+void LiveAveragePolicy::Publish(const CFRInfoStateValuesTable& table) {
+  auto index = std::make_unique<Index>();
+  index->reserve(table.size());
+  for (const auto& [key, values] : table) {
+    const int num_actions = values.num_actions();
+    MirrorRow& row = rows_[&values];
+    if (row.values == nullptr || row.num_actions != num_actions) {
+      row.values.reset(new std::atomic<double>[num_actions]);
+      row.num_actions = num_actions;
+    }
+    // Re-sync the mirror with the table, the authoritative copy: updates
+    // that bypass Accumulate (merged shard deltas, loaded checkpoints)
+    // become visible to readers here.
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      row.values[aidx].store(values.cumulative_policy[aidx],
+                             std::memory_order_relaxed);
+    }
+    index->push_back(
+        {absl::string_view(key), &values, row.values.get()});
+  }
+  std::sort(index->begin(), index->end(),
+            [](const IndexedEntry& a, const IndexedEntry& b) {
+              return a.key < b.key;
+            });
+  published_size_ = table.size();
+  indices_.push_back(std::move(index));
+  index_.store(indices_.back().get(), std::memory_order_release);
+}
+
+void LiveAveragePolicy::Accumulate(const CFRInfoStateValues* entry, int aidx,
+                                   double delta) {
+  const auto iter = rows_.find(entry);
+  if (iter == rows_.end()) return;  // Not yet published.
+  std::atomic<double>& cell = iter->second.values[aidx];
+  cell.store(cell.load(std::memory_order_relaxed) + delta,
+             std::memory_order_relaxed);
+}
+
+void LiveAveragePolicy::MaybePublish(const CFRInfoStateValuesTable& table) {
+  const int64_t grown = static_cast<int64_t>(table.size()) - published_size_;
+  if (grown >= std::max(kMinPublishGrowth, published_size_ / 8)) {
+    Publish(table);
+  }
+}
 
 ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
                                                          int seed,
@@ -30,7 +262,6 @@ ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
     : game_(game.Clone()),
       rng_(new std::mt19937(seed)),
       avg_type_(avg_type),
-      dist_(0.0, 1.0),
       uniform_policy_(std::shared_ptr<TabularPolicy>(
           new TabularPolicy(GetUniformPolicy(game)))) {
   if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
@@ -41,27 +272,317 @@ ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
   }
 }
 
+ExternalSamplingMCCFRSolver::~ExternalSamplingMCCFRSolver() {
+  if (checkpoint_writer_.joinable()) checkpoint_writer_.join();
+}
+
 void ExternalSamplingMCCFRSolver::RunIteration() { RunIteration(rng_.get()); }
 
 void ExternalSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
   for (auto p = Player{0}; p < game_->NumPlayers(); ++p) {
-    UpdateRegrets(*game_->NewInitialState(), p, rng);
+    UpdateRegrets(*game_->NewInitialState(), p, rng, /*threaded=*/false,
+                  /*correction=*/1.0, /*subtree_movement=*/nullptr);
   }
 
   if (avg_type_ == AverageType::kFull) {
     std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
-    FullUpdateAverage(*game_->NewInitialState(), reach_probs);
+    FullUpdateAverage(*game_->NewInitialState(), reach_probs,
+                      /*threaded=*/false);
+  }
+
+  if (live_policy_ != nullptr) live_policy_->MaybePublish(info_states_);
+}
+
+int ExternalSamplingMCCFRSolver::RunIterations(int num_iterations,
+                                               int num_threads,
+                                               TimeBudget* budget) {
+  SPIEL_CHECK_GE(num_iterations, 1);
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (num_threads == 1) {
+    int done = 0;
+    for (; done < num_iterations; ++done) {
+      if (budget != nullptr && budget->ExpiredNow()) break;
+      RunIteration();
+    }
+    if (live_policy_ != nullptr) live_policy_->Publish(info_states_);
+    return done;
+  }
+
+  // Independent streams: each worker gets its own generator seeded from the
+  // solver's, so results do not depend on scheduling beyond update order.
+  std::vector<uint32_t> seeds(num_threads);
+  for (int t = 0; t < num_threads; ++t) seeds[t] = (*rng_)();
+
+  std::atomic<int> total_done{0};
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    const int count =
+        num_iterations / num_threads + (t < num_iterations % num_threads);
+    threads.emplace_back([this, t, count, budget, &seeds, &total_done]() {
+      std::mt19937 rng(seeds[t]);
+      for (int i = 0; i < count; ++i) {
+        // ExpiredNow is const, so the one budget is safe to poll from
+        // every worker.
+        if (budget != nullptr && budget->ExpiredNow()) break;
+        for (auto p = Player{0}; p < game_->NumPlayers(); ++p) {
+          UpdateRegrets(*game_->NewInitialState(), p, &rng, /*threaded=*/true,
+                        /*correction=*/1.0, /*subtree_movement=*/nullptr);
+        }
+        if (avg_type_ == AverageType::kFull) {
+          std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
+          FullUpdateAverage(*game_->NewInitialState(), reach_probs,
+                            /*threaded=*/true);
+        }
+        ++total_done;
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  // The index cannot be refreshed while the sampling threads mutate the
+  // table, so readers see entries discovered during this run only now.
+  if (live_policy_ != nullptr) live_policy_->Publish(info_states_);
+  return total_done.load();
+}
+
+std::shared_ptr<LiveAveragePolicy> ExternalSamplingMCCFRSolver::LivePolicy() {
+  if (live_policy_ == nullptr) {
+    live_policy_.reset(new LiveAveragePolicy(uniform_policy_));
+    live_policy_->Publish(info_states_);
+  }
+  return live_policy_;
+}
+
+int ExternalSamplingMCCFRSolver::ShardOf(const std::string& is_key,
+                                         int num_shards) {
+  SPIEL_CHECK_GE(num_shards, 1);
+  // FNV-1a, so the assignment is stable across processes and platforms
+  // (std::hash is not).
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : is_key) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<int>(hash % static_cast<uint64_t>(num_shards));
+}
+
+std::string ExternalSamplingMCCFRSolver::ExtractShardDelta(int shard,
+                                                           int num_shards) {
+  SPIEL_CHECK_GE(shard, 0);
+  SPIEL_CHECK_LT(shard, num_shards);
+  std::string out;
+  out.append(kMCCFRDeltaMagic, sizeof(kMCCFRDeltaMagic));
+  uint64_t num_records = 0;
+  AppendRaw(num_records, &out);  // Placeholder, patched below.
+
+  for (const auto& entry : info_states_) {
+    if (ShardOf(entry.first, num_shards) != shard) continue;
+    const CFRInfoStateValues& is_vals = entry.second;
+    const int num_actions = is_vals.num_actions();
+    auto baseline_iter = synced_values_.find(entry.first);
+    if (baseline_iter == synced_values_.end()) {
+      // Never synchronized: the baseline is a freshly initialized entry,
+      // matching what LookupEntry inserts.
+      baseline_iter =
+          synced_values_
+              .insert({entry.first,
+                       CFRInfoStateValues(
+                           std::vector<Action>(is_vals.legal_actions.begin(),
+                                               is_vals.legal_actions.end()),
+                           kInitialTableValues)})
+              .first;
+    }
+    CFRInfoStateValues& baseline = baseline_iter->second;
+    SPIEL_CHECK_EQ(num_actions, baseline.num_actions());
+
+    bool changed = false;
+    for (int aidx = 0; aidx < num_actions && !changed; ++aidx) {
+      changed = is_vals.cumulative_regrets[aidx] !=
+                    baseline.cumulative_regrets[aidx] ||
+                is_vals.cumulative_policy[aidx] !=
+                    baseline.cumulative_policy[aidx];
+    }
+    if (!changed) continue;
+
+    ++num_records;
+    AppendRaw(static_cast<uint64_t>(entry.first.size()), &out);
+    out.append(entry.first);
+    AppendRaw(static_cast<uint64_t>(num_actions), &out);
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      AppendRaw(is_vals.legal_actions[aidx], &out);
+    }
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      AppendRaw(is_vals.cumulative_regrets[aidx] -
+                    baseline.cumulative_regrets[aidx],
+                &out);
+      baseline.cumulative_regrets[aidx] = is_vals.cumulative_regrets[aidx];
+    }
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      AppendRaw(
+          is_vals.cumulative_policy[aidx] - baseline.cumulative_policy[aidx],
+          &out);
+      baseline.cumulative_policy[aidx] = is_vals.cumulative_policy[aidx];
+    }
+  }
+
+  std::memcpy(&out[sizeof(kMCCFRDeltaMagic)], &num_records,
+              sizeof(num_records));
+  return out;
+}
+
+void ExternalSamplingMCCFRSolver::MergeShardDelta(const std::string& bytes) {
+  if (bytes.size() < sizeof(kMCCFRDeltaMagic) ||
+      std::memcmp(bytes.data(), kMCCFRDeltaMagic, sizeof(kMCCFRDeltaMagic)) !=
+          0) {
+    SpielFatalError("Not an MCCFR delta message.");
+  }
+  ByteReader reader{bytes.data() + sizeof(kMCCFRDeltaMagic),
+                    bytes.data() + bytes.size()};
+  const uint64_t num_records = reader.Read<uint64_t>();
+  for (uint64_t i = 0; i < num_records; ++i) {
+    const uint64_t key_size = reader.Read<uint64_t>();
+    const std::string key = reader.ReadString(key_size);
+    const uint64_t num_actions = reader.Read<uint64_t>();
+    std::vector<Action> legal_actions(num_actions);
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      legal_actions[aidx] = reader.Read<Action>();
+    }
+
+    CFRInfoStateValues* entry =
+        LookupEntry(key, legal_actions, /*threaded=*/false);
+    SPIEL_CHECK_EQ(num_actions, entry->num_actions());
+    auto baseline_iter = synced_values_.find(key);
+    if (baseline_iter == synced_values_.end()) {
+      baseline_iter =
+          synced_values_
+              .insert({key,
+                       CFRInfoStateValues(legal_actions, kInitialTableValues)})
+              .first;
+    }
+    CFRInfoStateValues& baseline = baseline_iter->second;
+    SPIEL_CHECK_EQ(num_actions, baseline.num_actions());
+
+    // Fold the delta into the baseline too, so it is not echoed back to
+    // the sender on this worker's next extraction.
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      const double delta = reader.Read<double>();
+      entry->cumulative_regrets[aidx] += delta;
+      baseline.cumulative_regrets[aidx] += delta;
+    }
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      const double delta = reader.Read<double>();
+      entry->cumulative_policy[aidx] += delta;
+      baseline.cumulative_policy[aidx] += delta;
+    }
   }
+
+  // Merged values bypass Accumulate; a republish re-syncs the live view's
+  // mirror rows (and indexes any entries the delta created).
+  if (live_policy_ != nullptr) live_policy_->Publish(info_states_);
+}
+
+std::string ExternalSamplingMCCFRSolver::SerializeCheckpoint() const {
+  std::string bytes;
+  bytes.append(kMCCFRCheckpointMagic, sizeof(kMCCFRCheckpointMagic));
+
+  // The random stream, in its standard text form, so a restarted worker
+  // resamples exactly the iterations it would have run.
+  std::ostringstream rng_stream;
+  rng_stream << *rng_;
+  const std::string rng_state = rng_stream.str();
+  AppendRaw(static_cast<uint64_t>(rng_state.size()), &bytes);
+  bytes.append(rng_state);
+
+  AppendTable(info_states_, &bytes);
+  AppendTable(synced_values_, &bytes);
+  return bytes;
+}
+
+void ExternalSamplingMCCFRSolver::SaveCheckpoint(
+    const std::string& filename) const {
+  const std::string error = WriteCheckpointBytes(SerializeCheckpoint(),
+                                                 filename);
+  if (!error.empty()) SpielFatalError(error);
+}
+
+void ExternalSamplingMCCFRSolver::SaveCheckpointAsync(
+    const std::string& filename) {
+  WaitForCheckpoint();
+  // Serialization is memory-bound and brief next to the file write, and
+  // the table must not change underneath it, so it stays on this thread;
+  // the writer owns a frozen copy of the bytes and races with nothing.
+  std::string bytes = SerializeCheckpoint();
+  checkpoint_writer_ =
+      std::thread([this, bytes = std::move(bytes), filename]() {
+        const std::string staging = filename + ".tmp";
+        checkpoint_error_ = WriteCheckpointBytes(bytes, staging);
+        if (!checkpoint_error_.empty()) return;
+        if (std::rename(staging.c_str(), filename.c_str()) != 0) {
+          checkpoint_error_ =
+              absl::StrCat("Cannot rename checkpoint into place: ", filename);
+        }
+      });
+}
+
+void ExternalSamplingMCCFRSolver::WaitForCheckpoint() {
+  if (!checkpoint_writer_.joinable()) return;
+  checkpoint_writer_.join();
+  if (!checkpoint_error_.empty()) SpielFatalError(checkpoint_error_);
+}
+
+void ExternalSamplingMCCFRSolver::LoadCheckpoint(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open checkpoint file: ", filename));
+  }
+  char magic[sizeof(kMCCFRCheckpointMagic)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic),
+                           kMCCFRCheckpointMagic)) {
+    SpielFatalError(absl::StrCat("Not an MCCFR checkpoint file: ", filename));
+  }
+
+  uint64_t rng_size;
+  file.read(reinterpret_cast<char*>(&rng_size), sizeof(rng_size));
+  std::string rng_state(rng_size, '\0');
+  file.read(&rng_state[0], rng_size);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Truncated checkpoint file: ", filename));
+  }
+  std::istringstream rng_stream(rng_state);
+  rng_stream >> *rng_;
+
+  ReadTable(&file, filename, &info_states_);
+  ReadTable(&file, filename, &synced_values_);
+  if (live_policy_ != nullptr) live_policy_->Publish(info_states_);
+}
+
+CFRInfoStateValues* ExternalSamplingMCCFRSolver::LookupEntry(
+    const std::string& is_key, const std::vector<Action>& legal_actions,
+    bool threaded) {
+  std::unique_lock<std::mutex> lock = MaybeLock(table_mutex_, threaded);
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map. Entries are node-stable, so the
+  // returned pointer outlives the lock.
+  auto iter_and_result = info_states_.insert(
+      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+  return &iter_and_result.first->second;
 }
 
 double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
                                                   Player player,
-                                                  std::mt19937* rng) {
+                                                  std::mt19937* rng,
+                                                  bool threaded,
+                                                  double correction,
+                                                  double* subtree_movement) {
   if (state.IsTerminal()) {
     return state.PlayerReturn(player);
   } else if (state.IsChanceNode()) {
-    Action action = SampleChanceOutcome(state.ChanceOutcomes(), dist_(*rng));
-    return UpdateRegrets(*state.Child(action), player, rng);
+    Action action = state.SampleChanceOutcome(RandomUniform(rng)).first;
+    return UpdateRegrets(*state.Child(action), player, rng, threaded,
+                         correction, subtree_movement);
   } else if (state.IsSimultaneousNode()) {
     SpielFatalError(
         "Simultaneous moves not supported. Use "
@@ -72,38 +593,87 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   std::string is_key = state.InformationState(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+  CFRInfoStateValues* info_state = LookupEntry(is_key, legal_actions, threaded);
 
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy;
+  {
+    std::unique_lock<std::mutex> lock =
+        MaybeLock(EntryMutex(info_state), threaded);
+    info_state_copy = *info_state;
+  }
   info_state_copy.ApplyRegretMatching();
 
   double value = 0;
   std::vector<double> child_values(legal_actions.size(), 0);
+  int sampled_aidx = -1;
+  double sampled_movement = 0;
 
   if (cur_player != player) {
-    // Sample at opponent nodes.
-    int aidx = info_state_copy.SampleActionIndex(0.0, dist_(*rng));
-    value = UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+    // Sample at opponent nodes: from the current policy, or - in adaptive
+    // mode, once movement averages exist - from a blend biased toward the
+    // actions whose subtrees still move regret, with the policy/sampling
+    // ratio folded into the correction so the updates stay unbiased.
+    double ratio = 1.0;
+    if (adaptive_sampling_ && !info_state_copy.update_ema.empty()) {
+      double total_movement = 0;
+      for (double movement : info_state_copy.update_ema) {
+        total_movement += movement;
+      }
+      if (total_movement > 0) {
+        const double z = RandomUniform(rng);
+        double cumulative = 0;
+        double sampled_prob = 0;
+        for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+          const double prob =
+              (1.0 - kAdaptiveBias) * info_state_copy.current_policy[aidx] +
+              kAdaptiveBias * info_state_copy.update_ema[aidx] / total_movement;
+          if (prob <= 0) continue;
+          sampled_aidx = aidx;
+          sampled_prob = prob;
+          cumulative += prob;
+          if (z < cumulative) break;
+        }
+        ratio = info_state_copy.current_policy[sampled_aidx] / sampled_prob;
+      }
+    }
+    if (sampled_aidx < 0) {
+      sampled_aidx = info_state_copy.SampleActionIndex(0.0, RandomUniform(rng));
+    }
+    const double child_value =
+        UpdateRegrets(*state.Child(legal_actions[sampled_aidx]), player, rng,
+                      threaded, correction * ratio, &sampled_movement);
+    value = ratio * child_value;
+    if (subtree_movement != nullptr) *subtree_movement += sampled_movement;
   } else {
     // Walk over all actions at my nodes
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
       child_values[aidx] =
-          UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+          UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng,
+                        threaded, correction, subtree_movement);
       value += info_state_copy.current_policy[aidx] * child_values[aidx];
     }
   }
 
-  // Now the regret and avg strategy updates.
-  CFRInfoStateValues& info_state = info_states_[is_key];
+  // Now the regret and avg strategy updates, on the entry itself.
+  std::unique_lock<std::mutex> lock =
+      MaybeLock(EntryMutex(info_state), threaded);
 
   if (cur_player == player) {
     // Update regrets
+    double movement = 0;
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      info_state.cumulative_regrets[aidx] += (child_values[aidx] - value);
+      const double regret_delta = correction * (child_values[aidx] - value);
+      info_state->cumulative_regrets[aidx] += regret_delta;
+      movement += std::abs(regret_delta);
+    }
+    if (subtree_movement != nullptr) *subtree_movement += movement;
+  } else if (adaptive_sampling_) {
+    if (info_state->update_ema.empty()) {
+      info_state->update_ema.resize(legal_actions.size(), 0);
     }
+    info_state->update_ema[sampled_aidx] +=
+        kMovementEmaWeight *
+        (sampled_movement - info_state->update_ema[sampled_aidx]);
   }
 
   // Simple average does averaging on the opponent node. To do this in a game
@@ -112,8 +682,11 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   if (avg_type_ == AverageType::kSimple &&
       cur_player == ((player + 1) % game_->NumPlayers())) {
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      info_state.cumulative_policy[aidx] +=
-          info_state_copy.current_policy[aidx];
+      const double delta = correction * info_state_copy.current_policy[aidx];
+      info_state->cumulative_policy[aidx] += delta;
+      if (live_policy_ != nullptr) {
+        live_policy_->Accumulate(info_state, aidx, delta);
+      }
     }
   }
 
@@ -121,12 +694,13 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
 }
 
 void ExternalSamplingMCCFRSolver::FullUpdateAverage(
-    const State& state, const std::vector<double>& reach_probs) {
+    const State& state, const std::vector<double>& reach_probs,
+    bool threaded) {
   if (state.IsTerminal()) {
     return;
   } else if (state.IsChanceNode()) {
     for (Action action : state.LegalActions()) {
-      FullUpdateAverage(*state.Child(action), reach_probs);
+      FullUpdateAverage(*state.Child(action), reach_probs, threaded);
     }
     return;
   } else if (state.IsSimultaneousNode()) {
@@ -143,25 +717,33 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   std::string is_key = state.InformationState(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+  CFRInfoStateValues* info_state = LookupEntry(is_key, legal_actions, threaded);
 
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy;
+  {
+    std::unique_lock<std::mutex> lock =
+        MaybeLock(EntryMutex(info_state), threaded);
+    info_state_copy = *info_state;
+  }
   info_state_copy.ApplyRegretMatching();
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
     std::vector<double> new_reach_probs = reach_probs;
     new_reach_probs[cur_player] *= info_state_copy.current_policy[aidx];
-    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
+    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs,
+                      threaded);
   }
 
   // Now update the cumulative policy.
-  CFRInfoStateValues& info_state = info_states_[is_key];
+  std::unique_lock<std::mutex> lock =
+      MaybeLock(EntryMutex(info_state), threaded);
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-    info_state.cumulative_policy[aidx] +=
-        (reach_probs[cur_player] * info_state_copy.current_policy[aidx]);
+    const double delta =
+        reach_probs[cur_player] * info_state_copy.current_policy[aidx];
+    info_state->cumulative_policy[aidx] += delta;
+    if (live_policy_ != nullptr) {
+      live_policy_->Accumulate(info_state, aidx, delta);
+    }
   }
 }
 
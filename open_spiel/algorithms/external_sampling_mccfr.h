@@ -15,10 +15,18 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -54,6 +62,97 @@ enum class AverageType {
   kFull,
 };
 
+// A read view of the solver's live average policy, safe to query from
+// evaluation threads while the training thread keeps running iterations.
+// Readers never touch the solver's unordered_map (which rehashes as it
+// grows); instead the training thread periodically publishes an immutable
+// sorted index of (key, entry pointer) pairs — both node-stable in the
+// table — and readers atomically load the current index and binary-search
+// it. Retired indices are kept alive until the view is destroyed, so
+// readers take no locks and need no epochs at all; publication is
+// throttled to table-growth steps so the retired memory stays
+// proportional to one index.
+//
+// Value reads go through per-entry mirror rows of std::atomic<double>
+// owned by the view: the training thread folds every cumulative-policy
+// update into the mirror as well (Accumulate, called under the entry's
+// value mutex, so each element has one writer at a time), and readers
+// load the mirror with relaxed ordering. A reader that races an update
+// thus observes a row somewhere between two consecutive iterations'
+// averages — which still normalizes to a valid distribution — without
+// ever racing a plain double. Information states published after the
+// last index refresh fall back to the default policy until the next one.
+class LiveAveragePolicy : public Policy {
+ public:
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicyInto(const std::string& info_state,
+                          ActionsAndProbs* out) const override;
+
+  // Number of information states currently visible to readers.
+  int64_t NumIndexedEntries() const {
+    const Index* index = index_.load(std::memory_order_acquire);
+    return index == nullptr ? 0 : static_cast<int64_t>(index->size());
+  }
+
+ private:
+  friend class ExternalSamplingMCCFRSolver;
+
+  // The key and entry pointer refer to the solver's table, whose nodes
+  // are stable; `row` is the entry's cumulative-policy mirror (one atomic
+  // per legal action), owned by rows_ below.
+  struct IndexedEntry {
+    absl::string_view key;
+    const CFRInfoStateValues* entry;
+    const std::atomic<double>* row;
+  };
+  // Sorted by key.
+  using Index = std::vector<IndexedEntry>;
+
+  // Publish at least this much growth before rebuilding the index.
+  static constexpr int64_t kMinPublishGrowth = 256;
+
+  explicit LiveAveragePolicy(std::shared_ptr<TabularPolicy> default_policy)
+      : default_policy_(default_policy) {}
+
+  // Writer side, called only from the training thread while no sampling
+  // threads are running: rebuilds the index from the table, re-syncs the
+  // mirror rows (covering updates that bypass Accumulate, such as merged
+  // shard deltas), and publishes the result (Publish), or does so only if
+  // the table has grown enough since the last publication (MaybePublish).
+  void Publish(const CFRInfoStateValuesTable& table);
+  void MaybePublish(const CFRInfoStateValuesTable& table);
+
+  // Folds one cumulative-policy update into the entry's mirror row; a
+  // no-op for entries that have never been published. Called by the
+  // solver wherever it adds to cumulative_policy, under the entry's value
+  // mutex when threaded, so each element has at most one writer and the
+  // relaxed operations only have to be tear-free for readers.
+  void Accumulate(const CFRInfoStateValues* entry, int aidx, double delta);
+
+  // Returns the indexed entry for the info state, or nullptr if absent.
+  const IndexedEntry* FindEntry(const std::string& info_state) const;
+
+  std::shared_ptr<TabularPolicy> default_policy_;
+  std::atomic<const Index*> index_{nullptr};
+
+  // Owns every index ever published, current one last. Only the writer
+  // touches this; readers hold only the atomic pointer above.
+  std::vector<std::unique_ptr<const Index>> indices_;
+  int64_t published_size_ = 0;
+
+  // The mirror rows, keyed by table entry. Grown and re-synced only in
+  // Publish (when no sampling threads are running); between publishes the
+  // map is read-only, so Accumulate may run from several sampling threads
+  // at once. Rows are sized to num_actions at publication; the size is
+  // kept so a row is rebuilt if its address is ever reused by a new entry
+  // (LoadCheckpoint replaces the table wholesale).
+  struct MirrorRow {
+    std::unique_ptr<std::atomic<double>[]> values;
+    int num_actions = 0;
+  };
+  std::unordered_map<const CFRInfoStateValues*, MirrorRow> rows_;
+};
+
 class ExternalSamplingMCCFRSolver {
  public:
   static inline constexpr double kInitialTableValues = 0.000001;
@@ -62,6 +161,9 @@ class ExternalSamplingMCCFRSolver {
   ExternalSamplingMCCFRSolver(const Game& game, int seed = 0,
                               AverageType avg_type = AverageType::kSimple);
 
+  // Joins a pending asynchronous checkpoint write, if any.
+  ~ExternalSamplingMCCFRSolver();
+
   // Performs one iteration of external sampling MCCFR, updating the regrets
   // and average strategy for all players. This method uses the internal random
   // number generator.
@@ -70,6 +172,20 @@ class ExternalSamplingMCCFRSolver {
   // Same as above, but uses the specified random number generator instead.
   void RunIteration(std::mt19937* rng);
 
+  // Runs `num_iterations` iterations split across `num_threads` sampling
+  // threads, each with an independent random number stream seeded from the
+  // solver's generator. Access to the shared table is lock-striped: one
+  // mutex guards lookups and insertions into the map (whose entries are
+  // node-stable), and value updates on an entry take one of a fixed set of
+  // mutexes chosen by the entry's address, so threads only contend when
+  // they touch the same information state at the same time.
+  //
+  // Returns the number of iterations actually run. With a `budget`, each
+  // thread checks it between iterations and stops once it expires; the
+  // work done so far stays in the table, so a later call simply resumes.
+  int RunIterations(int num_iterations, int num_threads,
+                    TimeBudget* budget = nullptr);
+
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
   // the CFRSolver object.
@@ -78,17 +194,136 @@ class ExternalSamplingMCCFRSolver {
         new CFRAveragePolicy(info_states_, uniform_policy_));
   }
 
+  // Building blocks for running MCCFR across worker processes. The
+  // information-state space is sharded by a stable hash of the key; each
+  // worker samples the whole game and accumulates locally, then
+  // periodically extracts per-shard deltas — the table changes since the
+  // values were last extracted or merged — as opaque bytes, and ships
+  // them to its peers over whatever transport the deployment provides
+  // (TCP, MPI, shared files); the transport itself is out of scope here.
+  // Regret and average-policy updates are additive, so once every delta
+  // has reached every worker the tables agree regardless of message
+  // order. Deltas merged from peers are folded into the baseline as well,
+  // so they are never echoed back.
+
+  // Returns the shard owning `is_key`, in [0, num_shards). Stable across
+  // runs, processes and platforms.
+  static int ShardOf(const std::string& is_key, int num_shards);
+
+  // Serializes the changes since the last extraction for the info states
+  // of `shard` and advances their baselines. Must not run concurrently
+  // with RunIterations sampling threads.
+  std::string ExtractShardDelta(int shard, int num_shards);
+
+  // Adds a delta produced by a peer's ExtractShardDelta into the table,
+  // creating entries as needed.
+  void MergeShardDelta(const std::string& bytes);
+
+  // Writes the complete solver state (table, sync baselines and the
+  // random stream) to `filename` so a failed worker can be restarted
+  // deterministically; LoadCheckpoint restores it exactly.
+  void SaveCheckpoint(const std::string& filename) const;
+  void LoadCheckpoint(const std::string& filename);
+
+  // Like SaveCheckpoint, but only the in-memory serialization of the
+  // solver state runs on the calling thread; the file write - which
+  // dominates checkpoint cost on large tables - happens on a background
+  // thread while iterations continue. The bytes are staged to
+  // `filename`.tmp and renamed into place, so a crash mid-write leaves
+  // any previous checkpoint intact. At most one write is in flight: a
+  // new call first waits for the previous one. Like ExtractShardDelta,
+  // must not run concurrently with RunIterations sampling threads.
+  void SaveCheckpointAsync(const std::string& filename);
+
+  // Blocks until the pending asynchronous checkpoint write, if any, has
+  // finished, and fails hard if the write did. The destructor also joins
+  // a pending write, but silently; call this to observe errors.
+  void WaitForCheckpoint();
+
+  // Returns a view of the live average policy that other threads may
+  // query concurrently with training; see LiveAveragePolicy. Created (and
+  // first published) on the calling thread; the view is refreshed after
+  // each RunIteration and at the end of each RunIterations, and remains
+  // valid for the lifetime of the solver.
+  std::shared_ptr<LiveAveragePolicy> LivePolicy();
+
+  // Adaptive sampling: each information state tracks an exponential
+  // moving average, per action, of how much regret the action's subtree
+  // recently moved (CFRInfoStateValues::update_ema), and opponent actions
+  // are sampled from a blend of the current policy and those averages
+  // instead of the policy alone, so late in a solve - when most of the
+  // tree has converged and uniform trajectories mostly touch dead regions
+  // - samples concentrate where regret is still moving. Every update made
+  // under the biased trajectory is importance-weighted by the product of
+  // (policy probability / sampling probability) over the opponent choices
+  // above it, so the expected updates are exactly those of plain external
+  // sampling and convergence is unaffected. Off by default; toggle only
+  // between iterations.
+  void SetAdaptiveSampling(bool enabled) { adaptive_sampling_ = enabled; }
+
  private:
-  double UpdateRegrets(const State& state, Player player, std::mt19937* rng);
+  static constexpr int kNumValueStripes = 64;
+
+  // Fraction of the sampling distribution taken from the movement
+  // averages in adaptive mode, and the weight of a new observation in
+  // those averages.
+  static constexpr double kAdaptiveBias = 0.5;
+  static constexpr double kMovementEmaWeight = 0.1;
+
+  // `correction` is the importance weight accumulated over the sampled
+  // opponent choices above `state` (1.0 outside adaptive mode), applied
+  // to every table update. If `subtree_movement` is non-null, the total
+  // regret movement observed in this subtree is added to it.
+  double UpdateRegrets(const State& state, Player player, std::mt19937* rng,
+                       bool threaded, double correction,
+                       double* subtree_movement);
   void FullUpdateAverage(const State& state,
-                         const std::vector<double>& reach_probs);
+                         const std::vector<double>& reach_probs, bool threaded);
+
+  // Serializes the complete solver state in the checkpoint file layout.
+  std::string SerializeCheckpoint() const;
+
+  // Returns the table entry for `is_key`, inserting a fresh one if missing.
+  // Takes the table mutex when `threaded`.
+  CFRInfoStateValues* LookupEntry(const std::string& is_key,
+                                  const std::vector<Action>& legal_actions,
+                                  bool threaded);
+
+  // One stripe per cache line: std::mutex is smaller than a line, so
+  // packing the stripes back-to-back would put independent stripes on
+  // shared lines and serialize them through the coherence protocol even
+  // when threads hold different locks.
+  struct alignas(kCacheLineBytes) PaddedMutex {
+    std::mutex mutex;
+  };
+
+  std::mutex& EntryMutex(const CFRInfoStateValues* entry) {
+    return value_mutexes_[std::hash<const CFRInfoStateValues*>()(entry) %
+                          kNumValueStripes]
+        .mutex;
+  }
 
   std::shared_ptr<const Game> game_;
   std::unique_ptr<std::mt19937> rng_;
   AverageType avg_type_;
+  bool adaptive_sampling_ = false;
   CFRInfoStateValuesTable info_states_;
-  std::uniform_real_distribution<double> dist_;
   std::shared_ptr<TabularPolicy> uniform_policy_;
+  std::shared_ptr<LiveAveragePolicy> live_policy_;
+
+  // Last-synchronized snapshot of each entry's cumulative values; entries
+  // absent here have never been extracted or merged, and their implicit
+  // baseline is a freshly initialized entry. See ExtractShardDelta.
+  CFRInfoStateValuesTable synced_values_;
+
+  // Lock striping for RunIterations; unused in the single-threaded paths.
+  std::mutex table_mutex_;
+  std::array<PaddedMutex, kNumValueStripes> value_mutexes_;
+
+  // In-flight asynchronous checkpoint write, if any; the error string is
+  // set by the writer thread and read only after joining it.
+  std::thread checkpoint_writer_;
+  std::string checkpoint_error_;
 };
 
 }  // namespace algorithms
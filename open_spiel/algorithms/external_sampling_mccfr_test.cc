@@ -14,9 +14,12 @@
 
 #include "open_spiel/algorithms/external_sampling_mccfr.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <random>
+#include <thread>
 
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/games/kuhn_poker.h"
@@ -44,6 +47,192 @@ void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
   SPIEL_CHECK_LE(nash_conv, nashconv_upperbound);
 }
 
+void MCCFR_AdaptiveSamplingTest(const std::string& game_name, std::mt19937* rng,
+                                int iterations, double nashconv_upperbound) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  ExternalSamplingMCCFRSolver solver(*game);
+  solver.SetAdaptiveSampling(true);
+  for (int i = 0; i < iterations; i++) {
+    solver.RunIteration(rng);
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  double nash_conv = NashConv(*game, *average_policy);
+  std::cout << "Game: " << game_name << " (adaptive sampling), iters = "
+            << iterations << ", NashConv: " << nash_conv << std::endl;
+  SPIEL_CHECK_LE(nash_conv, nashconv_upperbound);
+}
+
+void MCCFR_ParallelKuhnTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  solver.RunIterations(/*num_iterations=*/10000, /*num_threads=*/4);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  double nash_conv = NashConv(*game, *average_policy);
+  std::cout << "Kuhn 2P (4 threads) NashConv = " << nash_conv << std::endl;
+  SPIEL_CHECK_LE(nash_conv, 0.05);
+}
+
+// Plays random episodes, querying the live view at every decision node and
+// checking that each answer is a valid distribution, until `done` is set.
+void HammerLivePolicy(const Game& game, const LiveAveragePolicy& live,
+                      std::atomic<bool>* done, int seed) {
+  std::mt19937 rng(seed);
+  while (!done->load()) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> legal_actions = state->LegalActions();
+      if (!state->IsChanceNode()) {
+        ActionsAndProbs probs = live.GetStatePolicy(state->InformationState());
+        SPIEL_CHECK_EQ(probs.size(), legal_actions.size());
+        double sum_prob = 0.0;
+        for (const auto& action_and_prob : probs) {
+          SPIEL_CHECK_GE(action_and_prob.second, 0.0);
+          SPIEL_CHECK_LE(action_and_prob.second, 1.0);
+          sum_prob += action_and_prob.second;
+        }
+        SPIEL_CHECK_LE(std::abs(sum_prob - 1.0), 1e-9);
+      }
+      state->ApplyAction(
+          legal_actions[std::uniform_int_distribution<int>(
+              0, legal_actions.size() - 1)(rng)]);
+    }
+  }
+}
+
+// Checks that two policies agree exactly at every decision node.
+void CheckPoliciesMatch(const State& state, const Policy& a, const Policy& b) {
+  if (state.IsTerminal()) return;
+  if (!state.IsChanceNode()) {
+    std::string info_state = state.InformationState();
+    SPIEL_CHECK_TRUE(a.GetStatePolicy(info_state) ==
+                     b.GetStatePolicy(info_state));
+  }
+  for (Action action : state.LegalActions()) {
+    CheckPoliciesMatch(*state.Child(action), a, b);
+  }
+}
+
+void MCCFR_LiveAveragePolicyTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  std::shared_ptr<LiveAveragePolicy> live = solver.LivePolicy();
+
+  // Serve from reader threads while the training thread keeps iterating.
+  std::atomic<bool> done{false};
+  std::thread readers[2] = {
+      std::thread(HammerLivePolicy, std::cref(*game), std::cref(*live), &done,
+                  1681),
+      std::thread(HammerLivePolicy, std::cref(*game), std::cref(*live), &done,
+                  9247)};
+  solver.RunIterations(/*num_iterations=*/20000, /*num_threads=*/1);
+  done = true;
+  for (std::thread& reader : readers) reader.join();
+
+  SPIEL_CHECK_GT(live->NumIndexedEntries(), 0);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckPoliciesMatch(*game->NewInitialState(), *live, *average_policy);
+}
+
+void MCCFR_ShardedDeltaSyncTest() {
+  constexpr int kNumShards = 4;
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver worker_a(*game, kSeed);
+  ExternalSamplingMCCFRSolver worker_b(*game, kSeed + 1);
+  for (int i = 0; i < 500; ++i) {
+    worker_a.RunIteration();
+    worker_b.RunIteration();
+  }
+
+  // All-to-all exchange of every shard's deltas; afterwards both workers
+  // hold the sum of both tables.
+  for (int shard = 0; shard < kNumShards; ++shard) {
+    std::string a_to_b = worker_a.ExtractShardDelta(shard, kNumShards);
+    std::string b_to_a = worker_b.ExtractShardDelta(shard, kNumShards);
+    worker_b.MergeShardDelta(a_to_b);
+    worker_a.MergeShardDelta(b_to_a);
+  }
+  CheckPoliciesMatch(*game->NewInitialState(), *worker_a.AveragePolicy(),
+                     *worker_b.AveragePolicy());
+
+  // Nothing changed since the exchange, so a second extraction is empty:
+  // merged deltas are folded into the baseline and never echoed back.
+  for (int shard = 0; shard < kNumShards; ++shard) {
+    std::string resend = worker_a.ExtractShardDelta(shard, kNumShards);
+    SPIEL_CHECK_EQ(resend.size(), 16);  // Magic plus a zero record count.
+  }
+
+  // The merged policy is still a sensible Kuhn policy.
+  double nash_conv = NashConv(*game, *worker_a.AveragePolicy());
+  std::cout << "Kuhn 2P (2 sharded workers) NashConv = " << nash_conv
+            << std::endl;
+  SPIEL_CHECK_LE(nash_conv, 0.2);
+}
+
+void MCCFR_CheckpointTest() {
+  const std::string filename = "/tmp/open_spiel_mccfr_test_checkpoint.bin";
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  for (int i = 0; i < 200; ++i) solver.RunIteration();
+  solver.SaveCheckpoint(filename);
+
+  // A recovered worker must replay the exact iterations the original
+  // would have run: same table, same random stream.
+  ExternalSamplingMCCFRSolver recovered(*game, /*seed=*/0);
+  recovered.LoadCheckpoint(filename);
+  for (int i = 0; i < 200; ++i) {
+    solver.RunIteration();
+    recovered.RunIteration();
+  }
+  CheckPoliciesMatch(*game->NewInitialState(), *solver.AveragePolicy(),
+                     *recovered.AveragePolicy());
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+void MCCFR_TimeBudgetTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+
+  // Without a budget, everything requested runs.
+  SPIEL_CHECK_EQ(solver.RunIterations(100, /*num_threads=*/1), 100);
+
+  // An expired budget stops before the first iteration, in both the
+  // single-threaded and threaded paths.
+  TimeBudget expired(/*seconds=*/0.0);
+  SPIEL_CHECK_EQ(solver.RunIterations(100, /*num_threads=*/1, &expired), 0);
+  SPIEL_CHECK_EQ(solver.RunIterations(100, /*num_threads=*/2, &expired), 0);
+
+  // A small budget yields partial progress; the table keeps it, so the
+  // next call just resumes.
+  TimeBudget small(/*seconds=*/0.05);
+  const int done = solver.RunIterations(1 << 30, /*num_threads=*/1, &small);
+  SPIEL_CHECK_GT(done, 0);
+  SPIEL_CHECK_LT(done, 1 << 30);
+}
+
+void MCCFR_AsyncCheckpointTest() {
+  const std::string filename = "/tmp/open_spiel_mccfr_test_async_checkpoint.bin";
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  for (int i = 0; i < 200; ++i) solver.RunIteration();
+
+  // The snapshot is frozen when the call returns: iterations that run
+  // while the write is in flight must not leak into the file.
+  solver.SaveCheckpointAsync(filename);
+  for (int i = 0; i < 200; ++i) solver.RunIteration();
+  solver.WaitForCheckpoint();
+
+  // A recovered worker starts at iteration 200 and replays to 400.
+  ExternalSamplingMCCFRSolver recovered(*game, /*seed=*/0);
+  recovered.LoadCheckpoint(filename);
+  for (int i = 0; i < 200; ++i) recovered.RunIteration();
+  CheckPoliciesMatch(*game->NewInitialState(), *solver.AveragePolicy(),
+                     *recovered.AveragePolicy());
+
+  // The staging file was renamed away.
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+  SPIEL_CHECK_NE(std::remove((filename + ".tmp").c_str()), 0);
+}
+
 void MCCFR_KuhnPoker3PTest(std::mt19937* rng) {
   std::shared_ptr<const Game> game = LoadGame("kuhn_poker(players=3)");
   ExternalSamplingMCCFRSolver solver(*game);
@@ -77,5 +266,15 @@ int main(int argc, char** argv) {
   algorithms::MCCFR_2PGameTest("kuhn_poker", &rng, 1000, 0.05);
   algorithms::MCCFR_2PGameTest("leduc_poker", &rng, 1000, 3.0);
   algorithms::MCCFR_2PGameTest("liars_dice", &rng, 1000, 1.0);
+  // The importance weighting keeps the adaptive updates unbiased but adds
+  // variance, so the bounds are a little looser than the plain runs above.
+  algorithms::MCCFR_AdaptiveSamplingTest("kuhn_poker", &rng, 1000, 0.15);
+  algorithms::MCCFR_AdaptiveSamplingTest("liars_dice", &rng, 1000, 1.5);
+  algorithms::MCCFR_ParallelKuhnTest();
+  algorithms::MCCFR_LiveAveragePolicyTest();
+  algorithms::MCCFR_ShardedDeltaSyncTest();
+  algorithms::MCCFR_CheckpointTest();
+  algorithms::MCCFR_AsyncCheckpointTest();
+  algorithms::MCCFR_TimeBudgetTest();
   algorithms::MCCFR_KuhnPoker3PTest(&rng);
 }
@@ -14,6 +14,13 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
@@ -28,7 +35,7 @@ namespace {
 void GetSubgameStates(State* state,
                       std::map<std::string, std::unique_ptr<State>>* all_states,
                       int depth_limit, int depth, bool include_terminals,
-                      bool include_chance_states) {
+                      bool include_chance_states, bool use_undo) {
   if (state->IsTerminal()) {
     if (include_terminals) {
       // Include if not already present and then terminate recursion.
@@ -52,16 +59,220 @@ void GetSubgameStates(State* state,
     }
   }
 
-  for (auto action : state->LegalActions()) {
-    auto next_state = state->Clone();
-    next_state->ApplyAction(action);
-    GetSubgameStates(next_state.get(), all_states, depth_limit, depth + 1,
-                     include_terminals, include_chance_states);
+  if (use_undo) {
+    // Traverse in place, undoing each action after its subtree is done.
+    const Player player = state->CurrentPlayer();
+    for (auto action : state->LegalActions()) {
+      state->ApplyAction(action);
+      GetSubgameStates(state, all_states, depth_limit, depth + 1,
+                       include_terminals, include_chance_states, use_undo);
+      state->UndoAction(player, action);
+    }
+  } else {
+    for (auto action : state->LegalActions()) {
+      auto next_state = state->Clone();
+      next_state->ApplyAction(action);
+      GetSubgameStates(next_state.get(), all_states, depth_limit, depth + 1,
+                       include_terminals, include_chance_states, use_undo);
+    }
   }
 }
 
+// The streaming analogue of GetSubgameStates: invokes the callback instead
+// of filling a map. When deduplicating, visited_depth records the
+// shallowest depth each state has been seen at; a state is re-expanded
+// (without re-firing the callback) when found again on a strictly shorter
+// path, since a depth limit may admit children there that the deeper visit
+// cut off.
+void VisitSubgameStates(State* state, int depth_limit, int depth,
+                        bool include_terminals, bool include_chance_states,
+                        bool use_undo,
+                        std::unordered_map<std::string, int>* visited_depth,
+                        const std::function<void(const State&)>& on_state) {
+  if (state->IsTerminal()) {
+    if (include_terminals) {
+      if (visited_depth == nullptr ||
+          visited_depth->emplace(state->ToString(), depth).second) {
+        on_state(*state);
+      }
+    }
+    return;
+  }
+
+  if (depth_limit >= 0 && depth > depth_limit) {
+    return;
+  }
+
+  bool first_visit = true;
+  if (visited_depth != nullptr) {
+    auto insert_result = visited_depth->emplace(state->ToString(), depth);
+    if (!insert_result.second) {
+      first_visit = false;
+      if (depth >= insert_result.first->second) return;
+      insert_result.first->second = depth;
+    }
+  }
+  if (first_visit &&
+      (!state->IsChanceNode() || include_chance_states)) {
+    on_state(*state);
+  }
+
+  if (use_undo) {
+    const Player player = state->CurrentPlayer();
+    for (auto action : state->LegalActions()) {
+      state->ApplyAction(action);
+      VisitSubgameStates(state, depth_limit, depth + 1, include_terminals,
+                         include_chance_states, use_undo, visited_depth,
+                         on_state);
+      state->UndoAction(player, action);
+    }
+  } else {
+    for (auto action : state->LegalActions()) {
+      auto next_state = state->Clone();
+      next_state->ApplyAction(action);
+      VisitSubgameStates(next_state.get(), depth_limit, depth + 1,
+                         include_terminals, include_chance_states, use_undo,
+                         visited_depth, on_state);
+    }
+  }
+}
+
+constexpr int kNumDedupShards = 64;
+
+// A lock-striped set of visited states, keyed either on state strings or
+// on State::HashValue()s. Striping keeps workers on different shards from
+// contending while still making each insertion an atomic test-and-set.
+class ShardedDedupSet {
+ public:
+  // Both return true if the key was newly inserted.
+  bool InsertString(const std::string& key) {
+    Shard& shard = shards_[std::hash<std::string>()(key) % kNumDedupShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.strings.insert(key).second;
+  }
+  bool InsertHash(uint64_t key) {
+    Shard& shard = shards_[key % kNumDedupShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.hashes.insert(key).second;
+  }
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_set<std::string> strings;
+    std::unordered_set<uint64_t> hashes;
+  };
+  Shard shards_[kNumDedupShards];
+};
+
 }  // namespace
 
+std::map<std::string, std::unique_ptr<State>> GetAllStatesParallel(
+    const Game& game, int depth_limit, bool include_terminals,
+    bool include_chance_states, int num_threads, bool key_states_by_hash,
+    bool key_states_by_canonical_hash) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (key_states_by_hash && !game.ProvidesHashValue()) {
+    SpielFatalError(
+        "GetAllStatesParallel: key_states_by_hash requires a game with "
+        "Game::ProvidesHashValue().");
+  }
+  if (key_states_by_canonical_hash && !game.ProvidesCanonicalForm()) {
+    SpielFatalError(
+        "GetAllStatesParallel: key_states_by_canonical_hash requires a game "
+        "with Game::ProvidesCanonicalForm().");
+  }
+
+  std::map<std::string, std::unique_ptr<State>> all_states;
+  ShardedDedupSet visited;
+  // Marks the state visited; returns false for a duplicate.
+  auto mark_visited = [&visited, key_states_by_hash,
+                       key_states_by_canonical_hash](const State& state) {
+    if (key_states_by_canonical_hash) {
+      return visited.InsertHash(state.CanonicalHash());
+    }
+    return key_states_by_hash ? visited.InsertHash(state.HashValue())
+                              : visited.InsertString(state.ToString());
+  };
+
+  // The frontier holds the unique, not-yet-expanded states at the current
+  // depth; the root is handled here and each further level in the loop.
+  std::vector<std::unique_ptr<State>> frontier;
+  std::unique_ptr<State> root = game.NewInitialState();
+  mark_visited(*root);
+  if (root->IsTerminal()) {
+    if (include_terminals) all_states[root->ToString()] = std::move(root);
+  } else {
+    if (!root->IsChanceNode() || include_chance_states) {
+      all_states[root->ToString()] = root->Clone();
+    }
+    frontier.push_back(std::move(root));
+  }
+
+  for (int depth = 0; !frontier.empty(); ++depth) {
+    // As in the serial walk, terminal states one past the depth limit are
+    // still recorded; other states there are neither kept nor expanded.
+    const bool keep_nonterminal_children =
+        depth_limit < 0 || depth + 1 <= depth_limit;
+    std::vector<std::vector<std::unique_ptr<State>>> next_frontiers(
+        num_threads);
+    std::vector<std::vector<std::pair<std::string, std::unique_ptr<State>>>>
+        collected(num_threads);
+    std::atomic<int> next_index(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back([&, t]() {
+        const int frontier_size = frontier.size();
+        for (int i = next_index++; i < frontier_size; i = next_index++) {
+          State* state = frontier[i].get();
+          for (Action action : state->LegalActions()) {
+            std::unique_ptr<State> child = state->Child(action);
+            if (child->IsTerminal()) {
+              if (include_terminals && mark_visited(*child)) {
+                collected[t].push_back({child->ToString(), std::move(child)});
+              }
+              continue;
+            }
+            if (!keep_nonterminal_children || !mark_visited(*child)) continue;
+            if (!child->IsChanceNode() || include_chance_states) {
+              collected[t].push_back({child->ToString(), child->Clone()});
+            }
+            next_frontiers[t].push_back(std::move(child));
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    frontier.clear();
+    for (int t = 0; t < num_threads; ++t) {
+      for (auto& key_and_state : collected[t]) {
+        all_states[std::move(key_and_state.first)] =
+            std::move(key_and_state.second);
+      }
+      for (auto& state : next_frontiers[t]) {
+        frontier.push_back(std::move(state));
+      }
+    }
+  }
+
+  if (all_states.empty()) {
+    SpielFatalError("GetAllStatesParallel returned 0 states!");
+  }
+  return all_states;
+}
+
+void ForAllStates(const Game& game, int depth_limit, bool include_terminals,
+                  bool include_chance_states, bool dedup,
+                  const std::function<void(const State&)>& on_state) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  std::unordered_map<std::string, int> visited_depth;
+  VisitSubgameStates(state.get(), depth_limit, 0, include_terminals,
+                     include_chance_states, game.ProvidesUndo(),
+                     dedup ? &visited_depth : nullptr, on_state);
+}
+
 std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
     bool include_chance_states) {
@@ -71,7 +282,7 @@ std::map<std::string, std::unique_ptr<State>> GetAllStates(
 
   // Then, do a recursive tree walk to fill up the map.
   GetSubgameStates(state.get(), &all_states, depth_limit, 0, include_terminals,
-                   include_chance_states);
+                   include_chance_states, game.ProvidesUndo());
 
   if (all_states.empty()) {
     SpielFatalError("GetSubgameStates returned 0 states!");
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 
+#include <functional>
 #include <string>
 
 #include "open_spiel/spiel.h"
@@ -39,6 +40,47 @@ std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
     bool include_chance_states);
 
+// Parallel variant of GetAllStates: expands the game breadth-first, one
+// depth level at a time, splitting each level's frontier across
+// num_threads workers. Duplicates are detected against a sharded set (one
+// mutex per shard), and - unlike the serial walk, which re-expands every
+// path to a state - each state is expanded only once, so transposition-
+// heavy games also do less work. Returns the same map as GetAllStates.
+//
+// With key_states_by_hash, deduplication uses State::HashValue() instead
+// of the state string, which avoids a string allocation per visited node;
+// requires Game::ProvidesHashValue(). States with equal hashes are treated
+// as duplicates, so a hash collision silently drops a state - acceptable
+// for enumeration workloads, not for exact solvers.
+//
+// With key_states_by_canonical_hash, deduplication uses
+// State::CanonicalHash() (requires Game::ProvidesCanonicalForm), so
+// rotated and reflected variants of a position count as one state and the
+// returned map holds the first-encountered representative of each
+// symmetry class, keyed by that representative's string. On games with
+// the full group of the square this shrinks the enumeration up to 8x.
+std::map<std::string, std::unique_ptr<State>> GetAllStatesParallel(
+    const Game& game, int depth_limit, bool include_terminals,
+    bool include_chance_states, int num_threads,
+    bool key_states_by_hash = false,
+    bool key_states_by_canonical_hash = false);
+
+// Streaming variant of GetAllStates: walks the same set of states but
+// invokes on_state for each one instead of materializing a map, so
+// consumers that only aggregate (legal-action maps, state counting,
+// tensor extraction) never hold the full state set. The state passed to
+// the callback is only valid for the duration of the call; clone it to
+// keep it.
+//
+// With dedup, the callback fires once per unique state at the cost of a
+// visited set holding one string per state (but no State clones). With
+// dedup false nothing is retained at all - memory stays constant in the
+// number of states - but the callback fires once per path to a state, so
+// it must tolerate duplicates.
+void ForAllStates(const Game& game, int depth_limit, bool include_terminals,
+                  bool include_chance_states, bool dedup,
+                  const std::function<void(const State&)>& on_state);
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
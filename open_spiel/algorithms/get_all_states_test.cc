@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <set>
+#include <string>
+
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -26,4 +29,48 @@ int main(int argc, char **argv) {
   auto states = algorithms::GetAllStates(*game, -1, /*include_terminals=*/true,
                                          /*include_chance_states=*/true);
   SPIEL_CHECK_EQ(states.size(), ttt::kNumberStates);
+
+  // The parallel enumeration must find exactly the same states.
+  auto parallel_states = algorithms::GetAllStatesParallel(
+      *game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/4);
+  SPIEL_CHECK_EQ(parallel_states.size(), states.size());
+  for (const auto &key_and_state : states) {
+    SPIEL_CHECK_TRUE(parallel_states.find(key_and_state.first) !=
+                     parallel_states.end());
+  }
+
+  // Tic-tac-toe's board string and its hash identify the same positions,
+  // so hash-keyed deduplication must give the same count.
+  auto hash_keyed_states = algorithms::GetAllStatesParallel(
+      *game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/4, /*key_states_by_hash=*/true);
+  SPIEL_CHECK_EQ(hash_keyed_states.size(), states.size());
+
+  // The streaming walk must visit each of those states exactly once.
+  int num_visited = 0;
+  algorithms::ForAllStates(
+      *game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*dedup=*/true, [&states, &num_visited](const open_spiel::State &state) {
+        ++num_visited;
+        SPIEL_CHECK_TRUE(states.find(state.ToString()) != states.end());
+      });
+  SPIEL_CHECK_EQ(num_visited, static_cast<int>(states.size()));
+
+  // Canonical-keyed deduplication must find one representative per
+  // symmetry class: exactly as many states as there are distinct canonical
+  // strings over the full enumeration.
+  std::set<std::string> canonical_forms;
+  for (const auto &key_and_state : states) {
+    canonical_forms.insert(key_and_state.second->CanonicalString());
+  }
+  auto canonical_states = algorithms::GetAllStatesParallel(
+      *game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/4, /*key_states_by_hash=*/false,
+      /*key_states_by_canonical_hash=*/true);
+  SPIEL_CHECK_EQ(canonical_states.size(), canonical_forms.size());
+  SPIEL_CHECK_LT(canonical_states.size(), states.size());
+  for (const auto &key_and_state : canonical_states) {
+    SPIEL_CHECK_TRUE(states.find(key_and_state.first) != states.end());
+  }
 }
@@ -14,63 +14,317 @@
 
 #include "open_spiel/algorithms/get_legal_actions_map.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
 
-// Do the tree traversal to fill the map. This function does a depth-first
-// search of all the subtrees to fill the map for all the information states.
-void FillMap(const State& state,
-             std::unordered_map<std::string, std::vector<Action>>* map,
-             int depth_limit, int depth, Player player) {
-  if (state.IsTerminal()) {
-    return;
-  }
+// Format marker for index files; bump when the layout changes.
+constexpr char kIndexFileMagic[8] = {'O', 'S', 'L', 'A', 'I', 'v', '0', '1'};
 
-  if (depth_limit >= 0 && depth > depth_limit) {
-    return;
+constexpr int kNumBuildShards = 64;
+
+// One shard of the claim set used by the parallel build: a worker that
+// wins the insertion of a key owns producing its entry, so every
+// information state lands in exactly one worker's output and the merge
+// never sees duplicates.
+struct BuildShard {
+  std::mutex mutex;
+  std::unordered_set<std::string> seen;
+};
+
+// An entry produced by a build worker, before the merge.
+struct PendingEntry {
+  std::string info_state;
+  Player player;
+  std::vector<Action> legal_actions;
+};
+
+int ShardOf(const std::string& key) {
+  // FNV-1a; same register as the other self-contained hashes here.
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : key) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
   }
+  return static_cast<int>(hash % kNumBuildShards);
+}
+
+// Claims the key in its shard; returns true when this caller is first.
+bool ClaimKey(const std::string& key, std::vector<BuildShard>* shards) {
+  BuildShard& shard = (*shards)[ShardOf(key)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.seen.insert(key).second;
+}
 
+// Appends the information states of one (non-terminal) state to `out`,
+// claiming each against the sharded set first.
+void CollectFromState(const State& state, std::vector<BuildShard>* shards,
+                      std::vector<PendingEntry>* out) {
   if (state.IsChanceNode()) {
-    // Do nothing at chance nodes (no information states).
+    // Nothing at chance nodes (no information states).
   } else if (state.IsSimultaneousNode()) {
     // Many players can play at this node.
     for (auto p = Player{0}; p < state.NumPlayers(); ++p) {
-      if (player == kInvalidPlayer || p == player) {
-        std::string info_state = state.InformationState(p);
-        if (map->find(info_state) == map->end()) {
-          // Only add it if we don't already have it.
-          std::vector<Action> legal_actions = state.LegalActions(p);
-          (*map)[info_state] = legal_actions;
-        }
+      std::string info_state = state.InformationState(p);
+      if (ClaimKey(info_state, shards)) {
+        out->push_back({std::move(info_state), p, state.LegalActions(p)});
       }
     }
   } else {
-    // Regular decision node.
-    if (player == kInvalidPlayer || state.CurrentPlayer() == player) {
-      std::string info_state = state.InformationState();
-      if (map->find(info_state) == map->end()) {
-        // Only add it if we don't already have it.
-        std::vector<Action> legal_actions = state.LegalActions();
-        (*map)[info_state] = legal_actions;
-      }
+    std::string info_state = state.InformationState();
+    if (ClaimKey(info_state, shards)) {
+      out->push_back(
+          {std::move(info_state), state.CurrentPlayer(), state.LegalActions()});
     }
   }
+}
 
-  // Recursively fill the map for each subtree below.
-  for (auto action : state.LegalActions()) {
-    std::unique_ptr<State> next_state = state.Child(action);
-    FillMap(*next_state, map, depth_limit, depth + 1, player);
+// One worker's streaming depth-first walk: nothing is retained per
+// visited node beyond the claimed entries.
+void WalkForEntries(const State& state, int depth, int depth_limit,
+                    std::vector<BuildShard>* shards,
+                    std::vector<PendingEntry>* out) {
+  if (state.IsTerminal()) {
+    return;
+  }
+  if (depth_limit >= 0 && depth > depth_limit) {
+    return;
+  }
+  CollectFromState(state, shards, out);
+  for (Action action : state.LegalActions()) {
+    WalkForEntries(*state.Child(action), depth + 1, depth_limit, shards, out);
   }
 }
 
 }  // namespace
 
+LegalActionsIndex::LegalActionsIndex(const Game& game, int depth_limit) {
+  TaskPool* pool = TaskPool::Global();
+  std::vector<BuildShard> shards(kNumBuildShards);
+  std::vector<std::vector<PendingEntry>> partials(pool->NumSlots());
+  std::unique_ptr<State> root = game.NewInitialState();
+
+  std::vector<PendingEntry> root_entries;
+  if (!root->IsTerminal() && depth_limit != 0) {
+    CollectFromState(*root, &shards, &root_entries);
+    // One task per top-level subtree; tasks sharing a worker run one
+    // after another, so the per-slot outputs need no locking.
+    TaskGroup group(pool);
+    for (Action action : root->LegalActions()) {
+      std::shared_ptr<State> child = root->Child(action);
+      group.Spawn([child, depth_limit, pool, &shards, &partials]() {
+        WalkForEntries(*child, /*depth=*/1, depth_limit, &shards,
+                       &partials[pool->CurrentSlot()]);
+      });
+    }
+    group.Sync();
+  } else if (!root->IsTerminal()) {
+    CollectFromState(*root, &shards, &root_entries);
+  }
+
+  for (const PendingEntry& entry : root_entries) {
+    AddEntry(entry.info_state, entry.player, entry.legal_actions);
+  }
+  for (const std::vector<PendingEntry>& partial : partials) {
+    for (const PendingEntry& entry : partial) {
+      AddEntry(entry.info_state, entry.player, entry.legal_actions);
+    }
+  }
+}
+
+void LegalActionsIndex::AddEntry(const std::string& info_state, Player player,
+                                 const std::vector<Action>& legal_actions) {
+  const int64_t id = keys_.Intern(info_state);
+  if (id != static_cast<int64_t>(players_.size())) return;  // Already indexed.
+  players_.push_back(player);
+  action_begin_.push_back(actions_.size());
+  actions_.insert(actions_.end(), legal_actions.begin(), legal_actions.end());
+  action_end_.push_back(actions_.size());
+}
+
+std::shared_ptr<const LegalActionsIndex> GetLegalActionsIndex(
+    const Game& game) {
+  static std::mutex cache_mutex;
+  // Leaked intentionally: the cache lives for the whole process.
+  static auto* cache = new std::unordered_map<
+      std::string, std::shared_ptr<const LegalActionsIndex>>();
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<const LegalActionsIndex>& index = (*cache)[game.ToString()];
+  if (index == nullptr) {
+    index = std::make_shared<const LegalActionsIndex>(game);
+  }
+  return index;
+}
+
+TabularPolicy UniformPolicyFromIndex(const LegalActionsIndex& index) {
+  std::unordered_map<std::string, ActionsAndProbs> policy_table;
+  policy_table.reserve(index.NumInfoStates());
+  for (int id = 0; id < index.NumInfoStates(); ++id) {
+    const int num_actions = index.NumLegalActions(id);
+    ActionsAndProbs actions_and_probs;
+    actions_and_probs.reserve(num_actions);
+    const Action* actions = index.LegalActionsBegin(id);
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      actions_and_probs.push_back({actions[aidx], 1.0 / num_actions});
+    }
+    policy_table[index.InfoState(id)] = std::move(actions_and_probs);
+  }
+  return TabularPolicy(policy_table);
+}
+
+void SaveLegalActionsIndexToFile(const LegalActionsIndex& index,
+                                 const std::string& filename) {
+  // The file serves binary search, so entries go out in sorted key order.
+  const int num_entries = index.NumInfoStates();
+  std::vector<int> sorted_ids(num_entries);
+  for (int id = 0; id < num_entries; ++id) sorted_ids[id] = id;
+  std::sort(sorted_ids.begin(), sorted_ids.end(), [&index](int a, int b) {
+    return index.InfoState(a) < index.InfoState(b);
+  });
+
+  int64_t num_key_bytes = 0;
+  int64_t num_actions = 0;
+  for (int id = 0; id < num_entries; ++id) {
+    num_key_bytes += index.InfoState(id).size();
+    num_actions += index.NumLegalActions(id);
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open index file: ", filename));
+  }
+  auto write_int64 = [&file](int64_t value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  file.write(kIndexFileMagic, sizeof(kIndexFileMagic));
+  write_int64(num_entries);
+  write_int64(num_actions);
+  write_int64(num_key_bytes);
+  int64_t key_offset = 0;
+  write_int64(key_offset);
+  for (int id : sorted_ids) {
+    key_offset += index.InfoState(id).size();
+    write_int64(key_offset);
+  }
+  int64_t action_offset = 0;
+  write_int64(action_offset);
+  for (int id : sorted_ids) {
+    action_offset += index.NumLegalActions(id);
+    write_int64(action_offset);
+  }
+  for (int id : sorted_ids) {
+    write_int64(index.GetPlayer(id));
+  }
+  for (int id : sorted_ids) {
+    file.write(reinterpret_cast<const char*>(index.LegalActionsBegin(id)),
+               index.NumLegalActions(id) * sizeof(Action));
+  }
+  for (int id : sorted_ids) {
+    const std::string& key = index.InfoState(id);
+    file.write(key.data(), key.size());
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing index file: ", filename));
+  }
+}
+
+MmapLegalActionsIndex::MmapLegalActionsIndex(const std::string& filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("Cannot open index file: ", filename));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Cannot stat index file: ", filename));
+  }
+  mapping_size_ = file_stat.st_size;
+  const uint64_t header_size = sizeof(kIndexFileMagic) + 3 * sizeof(int64_t);
+  if (mapping_size_ < header_size) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Index file too short: ", filename));
+  }
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Cannot map index file: ", filename));
+  }
+  const char* base = static_cast<const char*>(mapping_);
+  if (std::memcmp(base, kIndexFileMagic, sizeof(kIndexFileMagic)) != 0) {
+    SpielFatalError(absl::StrCat("Not a legal-actions index file: ", filename));
+  }
+  const int64_t* header =
+      reinterpret_cast<const int64_t*>(base + sizeof(kIndexFileMagic));
+  num_entries_ = header[0];
+  const int64_t num_actions = header[1];
+  const int64_t num_key_bytes = header[2];
+  key_offset_ = reinterpret_cast<const int64_t*>(base + header_size);
+  action_offset_ = key_offset_ + num_entries_ + 1;
+  players_ = action_offset_ + num_entries_ + 1;
+  actions_ = reinterpret_cast<const Action*>(players_ + num_entries_);
+  keys_ = reinterpret_cast<const char*>(actions_ + num_actions);
+  if (static_cast<uint64_t>((keys_ + num_key_bytes) - base) != mapping_size_) {
+    SpielFatalError(absl::StrCat("Truncated index file: ", filename));
+  }
+}
+
+MmapLegalActionsIndex::~MmapLegalActionsIndex() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+}
+
+int64_t MmapLegalActionsIndex::GetId(absl::string_view info_state) const {
+  int64_t lo = 0;
+  int64_t hi = num_entries_;
+  while (lo < hi) {
+    const int64_t mid = (lo + hi) / 2;
+    const int cmp = InfoState(mid).compare(info_state);
+    if (cmp == 0) {
+      return mid;
+    } else if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
 std::unordered_map<std::string, std::vector<Action>> GetLegalActionsMap(
     const Game& game, int depth_limit, Player player) {
   std::unordered_map<std::string, std::vector<Action>> map;
-  std::unique_ptr<State> initial_state = game.NewInitialState();
-  FillMap(*initial_state, &map, depth_limit, 0, player);
+  if (depth_limit < 0) {
+    // Full-depth maps are views of the cached index; only depth-limited
+    // requests still build their own (throwaway) one.
+    std::shared_ptr<const LegalActionsIndex> index = GetLegalActionsIndex(game);
+    for (int id = 0; id < index->NumInfoStates(); ++id) {
+      if (player == kInvalidPlayer || index->GetPlayer(id) == player) {
+        map[index->InfoState(id)] = index->LegalActions(id);
+      }
+    }
+    return map;
+  }
+  LegalActionsIndex index(game, depth_limit);
+  map.reserve(index.NumInfoStates());
+  for (int id = 0; id < index.NumInfoStates(); ++id) {
+    if (player == kInvalidPlayer || index.GetPlayer(id) == player) {
+      map[index.InfoState(id)] = index.LegalActions(id);
+    }
+  }
   return map;
 }
 
@@ -19,16 +19,148 @@
 #include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace algorithms {
 
+// An immutable index of every information state's legal actions, for all
+// players. Information states are numbered once and all actions live in
+// one contiguous buffer, so consumers iterate it without hashing strings
+// or chasing per-entry allocations; keys are interned, so each string is
+// stored exactly once and shared between the id lookup and InfoState.
+// The build streams the game tree in parallel (one task per top-level
+// subtree, deduplicated against a sharded claim set), retaining nothing
+// per visited node beyond the entries themselves. GetLegalActionsIndex
+// caches one per game; the CFR solvers, TabularBestResponse and
+// GetLegalActionsMap all consume the shared copy instead of each
+// re-walking the game.
+class LegalActionsIndex {
+ public:
+  // With `depth_limit >= 0` only information states reached within that
+  // many moves of the root (counting chance) are indexed; negative walks
+  // the full game.
+  explicit LegalActionsIndex(const Game& game, int depth_limit = -1);
+
+  // Built once, shared by const reference; never copied.
+  LegalActionsIndex(const LegalActionsIndex&) = delete;
+  LegalActionsIndex& operator=(const LegalActionsIndex&) = delete;
+
+  int NumInfoStates() const { return players_.size(); }
+
+  // Returns the id of the information state, or -1 if it is not in the
+  // index. Ids follow the (parallel) build's discovery order, which is
+  // not stable across runs; only the set of entries is.
+  int GetId(const std::string& info_state) const {
+    return static_cast<int>(keys_.Find(info_state));
+  }
+
+  const std::string& InfoState(int id) const { return keys_.Str(id); }
+
+  // The player whose information state this is.
+  Player GetPlayer(int id) const { return players_[id]; }
+
+  int NumLegalActions(int id) const {
+    return action_end_[id] - action_begin_[id];
+  }
+  const Action* LegalActionsBegin(int id) const {
+    return actions_.data() + action_begin_[id];
+  }
+  // Convenience copy of the id's slice of the action buffer.
+  std::vector<Action> LegalActions(int id) const {
+    return std::vector<Action>(actions_.begin() + action_begin_[id],
+                               actions_.begin() + action_end_[id]);
+  }
+
+ private:
+  void AddEntry(const std::string& info_state, Player player,
+                const std::vector<Action>& legal_actions);
+
+  StringInternPool keys_;
+  std::vector<Player> players_;
+  // Per-id [action_begin_, action_end_) ranges into the action buffer.
+  std::vector<int> action_begin_;
+  std::vector<int> action_end_;
+  std::vector<Action> actions_;
+};
+
+// Returns the process-wide index for the game, building it on first use.
+// Keyed on the game's string representation, like GetSharedGameTree.
+std::shared_ptr<const LegalActionsIndex> GetLegalActionsIndex(const Game& game);
+
+// Returns the uniform policy over the index's information states. Same
+// result as GetUniformPolicy, without the per-call game traversal.
+TabularPolicy UniformPolicyFromIndex(const LegalActionsIndex& index);
+
+// Writes the index in a flat, mmap-able layout - sorted interned keys,
+// offset arrays, players and one contiguous action buffer, preceded by a
+// magic marker and the section sizes - for MmapLegalActionsIndex to
+// serve from. This is the spill path for games whose index is too large
+// (or too slow) to rebuild in memory per process: build and save once,
+// then map it from every pipeline stage that needs it.
+void SaveLegalActionsIndexToFile(const LegalActionsIndex& index,
+                                 const std::string& filename);
+
+// A read-only view over a file written by SaveLegalActionsIndexToFile.
+// The file is memory-mapped rather than loaded: construction costs one
+// mmap regardless of size, GetId binary-searches the key buffer directly
+// in the mapping, and the pages are demand-paged and shared by the OS
+// across every process serving the same file. Ids follow the file's
+// sorted key order, not the building index's discovery order.
+class MmapLegalActionsIndex {
+ public:
+  explicit MmapLegalActionsIndex(const std::string& filename);
+  ~MmapLegalActionsIndex();
+
+  // The mapping is owned; no copies.
+  MmapLegalActionsIndex(const MmapLegalActionsIndex&) = delete;
+  MmapLegalActionsIndex& operator=(const MmapLegalActionsIndex&) = delete;
+
+  int64_t NumInfoStates() const { return num_entries_; }
+
+  // Returns the id of the information state, or -1 if absent.
+  int64_t GetId(absl::string_view info_state) const;
+
+  absl::string_view InfoState(int64_t id) const {
+    return absl::string_view(keys_ + key_offset_[id],
+                             key_offset_[id + 1] - key_offset_[id]);
+  }
+  Player GetPlayer(int64_t id) const {
+    return static_cast<Player>(players_[id]);
+  }
+  int NumLegalActions(int64_t id) const {
+    return action_offset_[id + 1] - action_offset_[id];
+  }
+  const Action* LegalActionsBegin(int64_t id) const {
+    return actions_ + action_offset_[id];
+  }
+
+ private:
+  void* mapping_ = nullptr;
+  uint64_t mapping_size_ = 0;
+
+  // Pointers into the mapping.
+  int64_t num_entries_ = 0;
+  const int64_t* key_offset_ = nullptr;
+  const int64_t* action_offset_ = nullptr;
+  const int64_t* players_ = nullptr;
+  const Action* actions_ = nullptr;
+  const char* keys_ = nullptr;
+};
+
 // Gets a map of information state (string) to vector of legal actions, by doing
 // (depth-limited) tree traversal through the game, for a specific player. To
 // do a tree traversal over the entire game, use a negative depth limit. To
 // bundle all the legal actions for all players in the same map, use
 // kInvalidPlayer.
+// With a negative depth limit the map is served from the cached
+// LegalActionsIndex rather than a fresh traversal; depth-limited calls
+// run the same parallel build on a throwaway index. For games whose map
+// does not fit in memory, build a LegalActionsIndex and spill it with
+// SaveLegalActionsIndexToFile instead.
 std::unordered_map<std::string, std::vector<Action>> GetLegalActionsMap(
     const Game& game, int depth_limit, Player player);
 
@@ -14,6 +14,7 @@
 
 #include "open_spiel/algorithms/get_legal_actions_map.h"
 
+#include <cstdio>
 #include <unordered_map>
 
 #include "open_spiel/games/goofspiel.h"
@@ -69,10 +70,81 @@ void GoofspielTest() {
   SPIEL_CHECK_GT(map_both.size(), 0);
 }
 
+void IndexTest() {
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame("kuhn_poker");
+  std::shared_ptr<const algorithms::LegalActionsIndex> index =
+      algorithms::GetLegalActionsIndex(*game);
+  // The cache must hand out the same index on repeated lookups.
+  SPIEL_CHECK_TRUE(algorithms::GetLegalActionsIndex(*game) == index);
+
+  // The index must agree entry-for-entry with the traversal-built map.
+  LegalActionsMap map_both = algorithms::GetLegalActionsMap(
+      *game, /*depth_limit=*/-1, open_spiel::kInvalidPlayer);
+  SPIEL_CHECK_EQ(index->NumInfoStates(), static_cast<int>(map_both.size()));
+  for (int id = 0; id < index->NumInfoStates(); ++id) {
+    SPIEL_CHECK_TRUE(map_both.at(index->InfoState(id)) ==
+                     index->LegalActions(id));
+    SPIEL_CHECK_TRUE(index->GetId(index->InfoState(id)) == id);
+  }
+}
+
+void DepthLimitTest() {
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame("kuhn_poker");
+  // Depth 0 and 1 are chance nodes, so nothing is indexed; the first
+  // decision nodes appear at depth 2, one information state per card.
+  LegalActionsMap map_d1 = algorithms::GetLegalActionsMap(
+      *game, /*depth_limit=*/1, open_spiel::kInvalidPlayer);
+  SPIEL_CHECK_EQ(map_d1.size(), 0);
+  LegalActionsMap map_d2 = algorithms::GetLegalActionsMap(
+      *game, /*depth_limit=*/2, open_spiel::kInvalidPlayer);
+  SPIEL_CHECK_EQ(map_d2.size(), 3);
+  // A limit beyond the game's depth matches the full map.
+  LegalActionsMap map_full = algorithms::GetLegalActionsMap(
+      *game, /*depth_limit=*/-1, open_spiel::kInvalidPlayer);
+  LegalActionsMap map_deep = algorithms::GetLegalActionsMap(
+      *game, /*depth_limit=*/100, open_spiel::kInvalidPlayer);
+  SPIEL_CHECK_TRUE(map_deep == map_full);
+}
+
+void MmapIndexTest() {
+  const std::string filename = "/tmp/open_spiel_legal_actions_index_test.bin";
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame("leduc_poker");
+  std::shared_ptr<const algorithms::LegalActionsIndex> index =
+      algorithms::GetLegalActionsIndex(*game);
+  algorithms::SaveLegalActionsIndexToFile(*index, filename);
+
+  // The mapped file must agree entry-for-entry with the in-memory index
+  // (ids are the file's sorted order, so match through the keys).
+  algorithms::MmapLegalActionsIndex mapped(filename);
+  SPIEL_CHECK_EQ(mapped.NumInfoStates(), index->NumInfoStates());
+  for (int id = 0; id < index->NumInfoStates(); ++id) {
+    const std::string& info_state = index->InfoState(id);
+    const int64_t mapped_id = mapped.GetId(info_state);
+    SPIEL_CHECK_GE(mapped_id, 0);
+    SPIEL_CHECK_TRUE(mapped.InfoState(mapped_id) == info_state);
+    SPIEL_CHECK_EQ(mapped.GetPlayer(mapped_id), index->GetPlayer(id));
+    SPIEL_CHECK_EQ(mapped.NumLegalActions(mapped_id),
+                   index->NumLegalActions(id));
+    const open_spiel::Action* actions = mapped.LegalActionsBegin(mapped_id);
+    const std::vector<open_spiel::Action> expected = index->LegalActions(id);
+    for (int aidx = 0; aidx < mapped.NumLegalActions(mapped_id); ++aidx) {
+      SPIEL_CHECK_EQ(actions[aidx], expected[aidx]);
+    }
+  }
+  SPIEL_CHECK_EQ(mapped.GetId("not an info state"), -1);
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
   KuhnTest();
   LeducTest();
   GoofspielTest();
+  IndexTest();
+  DepthLimitTest();
+  MmapIndexTest();
 }
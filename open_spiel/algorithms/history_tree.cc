@@ -14,10 +14,15 @@
 
 #include "open_spiel/algorithms/history_tree.h"
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <limits>
+#include <mutex>
 #include <unordered_set>
+#include <utility>
 
+#include "open_spiel/algorithms/tree_traversal.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -25,59 +30,467 @@ namespace open_spiel {
 namespace algorithms {
 namespace {
 
-std::unique_ptr<HistoryNode> RecursivelyBuildGameTree(
+// One frame of the iterative game-tree build: the node under construction,
+// the (action, probability) pairs still to descend into, and where to attach
+// the finished node.
+struct BuildFrame {
+  std::unique_ptr<HistoryNode> node;
+  ActionsAndProbs children;
+  int next_child;
+  double probability_sum;
+  bool chance;
+  int parent;  // Frame index of the parent, or -1 at the root.
+  Action action_into_parent;
+  double prob_into_parent;
+};
+
+std::unique_ptr<HistoryNode> BuildGameTree(
     std::unique_ptr<State> state, Player player_id,
     std::unordered_map<std::string, HistoryNode*>* state_to_node) {
+  if (state_to_node == nullptr) SpielFatalError("state_to_node is null.");
+  std::unique_ptr<HistoryNode> root;
+  FrameStack<BuildFrame> stack;
+
+  // Opens the frame for `state` on top of the stack. Mirrors the entry of
+  // the former recursion: create the node, register it, and enumerate the
+  // children to visit.
+  auto open_frame = [&stack, player_id, state_to_node](
+                        std::unique_ptr<State> state, int parent, Action action,
+                        double prob) {
+    BuildFrame& frame = stack[stack.Push()];
+    frame.node.reset(new HistoryNode(player_id, std::move(state)));
+    (*state_to_node)[frame.node->GetHistory()] = frame.node.get();
+    frame.children.clear();
+    frame.next_child = 0;
+    frame.probability_sum = 0;
+    frame.chance = false;
+    frame.parent = parent;
+    frame.action_into_parent = action;
+    frame.prob_into_parent = prob;
+    State* state_ptr = frame.node->GetState();
+    switch (frame.node->GetType()) {
+      case StateType::kChance: {
+        frame.chance = true;
+        frame.children = state_ptr->ChanceOutcomes();
+        break;
+      }
+      case StateType::kDecision: {
+        // Note: The probabilities here are meaningless if state.CurrentPlayer()
+        // != player_id, as we'll be getting the probabilities from the policy
+        // during the call to Value. For state.CurrentPlayer() == player_id,
+        // the probabilities are equal to 1. for every action as these are
+        // *counter-factual* probabilities, which ignore the probability of
+        // the player that we are playing as.
+        for (const auto& legal_action : state_ptr->LegalActions()) {
+          frame.children.emplace_back(legal_action, 1.);
+        }
+        break;
+      }
+      case StateType::kTerminal: {
+        // As we assign terminal utilities to node.value in the constructor of
+        // HistoryNode, we don't have anything to do here.
+        break;
+      }
+    }
+  };
+
+  open_frame(std::move(state), /*parent=*/-1, kInvalidAction, 1.);
+  while (!stack.Empty()) {
+    BuildFrame& frame = stack.Top();
+    if (frame.next_child < frame.children.size()) {
+      const std::pair<Action, double>& action_and_prob =
+          frame.children[frame.next_child++];
+      std::unique_ptr<State> child =
+          frame.node->GetState()->Child(action_and_prob.first);
+      if (child == nullptr) {
+        SpielFatalError("Can't add child; child is null.");
+      }
+      if (frame.chance) frame.probability_sum += action_and_prob.second;
+      // open_frame may grow the stack and invalidate `frame`.
+      open_frame(std::move(child), /*parent=*/stack.Depth() - 1,
+                 action_and_prob.first, action_and_prob.second);
+      continue;
+    }
+    // All children attached; close the frame and hand the node to its parent.
+    if (frame.chance) SPIEL_CHECK_FLOAT_EQ(frame.probability_sum, 1.0);
+    std::unique_ptr<HistoryNode> node = std::move(frame.node);
+    const int parent = frame.parent;
+    const Action action = frame.action_into_parent;
+    const double prob = frame.prob_into_parent;
+    stack.Pop();
+    if (parent < 0) {
+      root = std::move(node);
+    } else {
+      stack[parent].node->AddChild(action, {prob, std::move(node)});
+    }
+  }
+  return root;
+}
+
+// Stamps out the per-player nodes for the subtree at index by walking the
+// prebuilt enumeration, cloning the stored states instead of replaying the
+// game.
+std::unique_ptr<HistoryNode> BuildFromSharedTree(
+    const SharedGameTree& shared_tree, int index, Player player_id,
+    std::unordered_map<std::string, HistoryNode*>* state_to_node) {
+  const SharedGameTree::Node& shared_node = shared_tree.GetNode(index);
   std::unique_ptr<HistoryNode> node(
-      new HistoryNode(player_id, std::move(state)));
+      new HistoryNode(player_id, shared_node.state->Clone()));
   if (state_to_node == nullptr) SpielFatalError("state_to_node is null.");
   (*state_to_node)[node->GetHistory()] = node.get();
-  State* state_ptr = node->GetState();
-  switch (node->GetType()) {
+  for (const SharedGameTree::Child& child : shared_node.children) {
+    node->AddChild(child.action,
+                   {child.prob, BuildFromSharedTree(shared_tree, child.node,
+                                                    player_id, state_to_node)});
+  }
+  return node;
+}
+
+}  // namespace
+
+SharedGameTree::SharedGameTree(std::unique_ptr<State> root) {
+  AddSubtree(std::move(root));
+}
+
+int SharedGameTree::AddSubtree(std::unique_ptr<State> state) {
+  const int index = nodes_.size();
+  nodes_.emplace_back();
+  State* state_ptr = state.get();
+  // Recursive AddSubtree calls below may reallocate nodes_, so the node is
+  // always re-addressed through its (stable) index. The State itself never
+  // moves: only the unique_ptr owning it does.
+  nodes_[index].state = std::move(state);
+  switch (state_ptr->GetType()) {
     case StateType::kChance: {
       double probability_sum = 0;
       for (const auto& outcome_and_prob : state_ptr->ChanceOutcomes()) {
         Action outcome = outcome_and_prob.first;
         double prob = outcome_and_prob.second;
-        std::unique_ptr<State> child = state_ptr->Child(outcome);
-        if (child == nullptr) {
-          SpielFatalError("Can't add child; child is null.");
-        }
         probability_sum += prob;
-        std::unique_ptr<HistoryNode> child_node = RecursivelyBuildGameTree(
-            std::move(child), player_id, state_to_node);
-        node->AddChild(outcome, {prob, std::move(child_node)});
+        int child = AddSubtree(state_ptr->Child(outcome));
+        nodes_[index].children.push_back({outcome, prob, child});
       }
       SPIEL_CHECK_FLOAT_EQ(probability_sum, 1.0);
       break;
     }
     case StateType::kDecision: {
-      for (const auto& legal_action : state_ptr->LegalActions()) {
-        std::unique_ptr<State> child = state_ptr->Child(legal_action);
-
-        // Note: The probabilities here are meaningless if state.CurrentPlayer()
-        // != player_id, as we'll be getting the probabilities from the policy
-        // during the call to Value. For state.CurrentPlayer() == player_id,
-        // the probabilities are equal to 1. for every action as these are
-        // *counter-factual* probabilities, which ignore the probability of
-        // the player that we are playing as.
-        node->AddChild(legal_action,
-                       {1., RecursivelyBuildGameTree(
-                                std::move(child), player_id, state_to_node)});
+      for (Action legal_action : state_ptr->LegalActions()) {
+        int child = AddSubtree(state_ptr->Child(legal_action));
+        nodes_[index].children.push_back({legal_action, 1., child});
       }
       break;
     }
     case StateType::kTerminal: {
-      // As we assign terminal utilities to node.value in the constructor of
-      // HistoryNode, we don't have anything to do here.
       break;
     }
   }
-  return node;
+  return index;
+}
+
+CompactHistoryTree::CompactHistoryTree(std::unique_ptr<State> state,
+                                       Player player_id) {
+  root_state_ = state->Clone();
+  player_id_ = player_id;
+  AddSubtree(*state, /*parent=*/-1, kInvalidAction, player_id);
+  IndexInfoStates();
+}
+
+int CompactHistoryTree::AddSubtree(const State& state, int parent,
+                                   Action action, Player player_id) {
+  const int index = nodes_.size();
+  nodes_.emplace_back();
+  // Recursive AddSubtree calls below may reallocate nodes_ and children_,
+  // so both are always re-addressed through their (stable) indices.
+  nodes_[index].type = state.GetType();
+  nodes_[index].current_player = state.CurrentPlayer();
+  nodes_[index].value =
+      state.IsTerminal() ? state.PlayerReturn(player_id) : 0.;
+  nodes_[index].action = action;
+  nodes_[index].parent = parent;
+
+  const std::string history = state.ToString();
+  nodes_[index].history_offset = Intern(history);
+  nodes_[index].history_length = history.size();
+  // Mirrors HistoryNode: the opposing player's decisions are viewed from
+  // their own perspective, everything else from player_id's.
+  const std::string infostate =
+      (state.GetType() == StateType::kDecision &&
+       state.CurrentPlayer() != player_id)
+          ? state.InformationState()
+          : state.InformationState(player_id);
+  nodes_[index].infostate_offset = Intern(infostate);
+  nodes_[index].infostate_length = infostate.size();
+
+  ActionsAndProbs successors;
+  if (state.IsChanceNode()) {
+    successors = state.ChanceOutcomes();
+  } else if (!state.IsTerminal()) {
+    for (Action legal_action : state.LegalActions()) {
+      successors.push_back({legal_action, 1.});
+    }
+  }
+  const int first_child = children_.size();
+  nodes_[index].first_child = first_child;
+  nodes_[index].num_children = successors.size();
+  // Reserve this node's contiguous child range up front; the recursion
+  // below appends the grandchildren's ranges after it.
+  for (const auto& action_and_prob : successors) {
+    children_.push_back({action_and_prob.first, action_and_prob.second, -1});
+  }
+  for (int i = 0; i < static_cast<int>(successors.size()); ++i) {
+    std::unique_ptr<State> child = state.Child(successors[i].first);
+    children_[first_child + i].node =
+        AddSubtree(*child, index, successors[i].first, player_id);
+  }
+  return index;
+}
+
+int64_t CompactHistoryTree::Intern(const std::string& str) {
+  const int64_t offset = strings_.size();
+  strings_.append(str);
+  return offset;
+}
+
+std::string CompactHistoryTree::History(int index) const {
+  return strings_.substr(nodes_[index].history_offset,
+                         nodes_[index].history_length);
+}
+
+std::string CompactHistoryTree::InfoState(int index) const {
+  return strings_.substr(nodes_[index].infostate_offset,
+                         nodes_[index].infostate_length);
+}
+
+void CompactHistoryTree::IndexInfoStates() {
+  // Interning appends duplicates, so equal strings only share an id, not
+  // an offset; key on the characters instead.
+  std::unordered_map<std::string, int> ids;
+  for (Node& node : nodes_) {
+    auto insert_result = ids.emplace(
+        strings_.substr(node.infostate_offset, node.infostate_length),
+        static_cast<int>(ids.size()));
+    node.infostate_id = insert_result.first->second;
+  }
+  num_info_states_ = ids.size();
+}
+
+namespace {
+
+constexpr char kCompactTreeFileMagic[] = "ospiel-compact-tree-v1";
+
+static_assert(std::is_trivially_copyable<CompactHistoryTree::Node>::value,
+              "Node is written to disk as raw bytes.");
+static_assert(std::is_trivially_copyable<CompactHistoryTree::Child>::value,
+              "Child is written to disk as raw bytes.");
+
+template <typename T>
+void WriteVector(std::ofstream* file, const std::vector<T>& vec) {
+  const int64_t size = vec.size();
+  file->write(reinterpret_cast<const char*>(&size), sizeof(size));
+  file->write(reinterpret_cast<const char*>(vec.data()), size * sizeof(T));
+}
+
+template <typename T>
+void ReadVector(std::ifstream* file, std::vector<T>* vec) {
+  int64_t size = 0;
+  file->read(reinterpret_cast<char*>(&size), sizeof(size));
+  vec->resize(size);
+  file->read(reinterpret_cast<char*>(vec->data()), size * sizeof(T));
 }
 
 }  // namespace
 
+void CompactHistoryTree::SaveToFile(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open tree file: ", filename));
+  }
+  file.write(kCompactTreeFileMagic, sizeof(kCompactTreeFileMagic));
+  const std::string game_string = root_state_->GetGame()->ToString();
+  const int64_t game_string_size = game_string.size();
+  file.write(reinterpret_cast<const char*>(&game_string_size),
+             sizeof(game_string_size));
+  file.write(game_string.data(), game_string_size);
+  file.write(reinterpret_cast<const char*>(&player_id_), sizeof(player_id_));
+  file.write(reinterpret_cast<const char*>(&num_info_states_),
+             sizeof(num_info_states_));
+  WriteVector(&file, nodes_);
+  WriteVector(&file, children_);
+  const int64_t strings_size = strings_.size();
+  file.write(reinterpret_cast<const char*>(&strings_size),
+             sizeof(strings_size));
+  file.write(strings_.data(), strings_size);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing tree file: ", filename));
+  }
+}
+
+std::unique_ptr<CompactHistoryTree> CompactHistoryTree::LoadFromFile(
+    const std::string& filename, const Game& game) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open tree file: ", filename));
+  }
+  char magic[sizeof(kCompactTreeFileMagic)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic),
+                           kCompactTreeFileMagic)) {
+    SpielFatalError(absl::StrCat("Not a compact tree file: ", filename));
+  }
+  int64_t game_string_size = 0;
+  file.read(reinterpret_cast<char*>(&game_string_size),
+            sizeof(game_string_size));
+  std::string game_string(game_string_size, '\0');
+  file.read(&game_string[0], game_string_size);
+  if (game_string != game.ToString()) {
+    SpielFatalError(absl::StrCat("Tree file ", filename, " was built for ",
+                                 game_string, ", not ", game.ToString()));
+  }
+  std::unique_ptr<CompactHistoryTree> tree(new CompactHistoryTree());
+  file.read(reinterpret_cast<char*>(&tree->player_id_),
+            sizeof(tree->player_id_));
+  file.read(reinterpret_cast<char*>(&tree->num_info_states_),
+            sizeof(tree->num_info_states_));
+  ReadVector(&file, &tree->nodes_);
+  ReadVector(&file, &tree->children_);
+  int64_t strings_size = 0;
+  file.read(reinterpret_cast<char*>(&strings_size), sizeof(strings_size));
+  tree->strings_.resize(strings_size);
+  file.read(&tree->strings_[0], strings_size);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Truncated tree file: ", filename));
+  }
+  tree->root_state_ = game.NewInitialState();
+  return tree;
+}
+
+std::unique_ptr<State> CompactHistoryTree::MakeState(int index) const {
+  std::vector<Action> actions;
+  for (int node = index; node != Root(); node = nodes_[node].parent) {
+    actions.push_back(nodes_[node].action);
+  }
+  std::unique_ptr<State> state = root_state_->Clone();
+  for (auto it = actions.rbegin(); it != actions.rend(); ++it) {
+    state->ApplyAction(*it);
+  }
+  return state;
+}
+
+std::shared_ptr<const SharedGameTree> GetSharedGameTree(const Game& game) {
+  static std::mutex cache_mutex;
+  // Leaked intentionally: the cache lives for the whole process.
+  static auto* cache = new std::unordered_map<
+      std::string, std::shared_ptr<const SharedGameTree>>();
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<const SharedGameTree>& tree = (*cache)[game.ToString()];
+  if (tree == nullptr) {
+    tree = std::make_shared<const SharedGameTree>(game.NewInitialState());
+  }
+  return tree;
+}
+
+LazyHistoryTree::LazyHistoryTree(std::unique_ptr<State> state,
+                                 Player player_id, int initial_depth) {
+  root_state_ = state->Clone();
+  player_id_ = player_id;
+  AddNode(*state, /*parent=*/-1, kInvalidAction);
+  ExpandSubtree(Root(), *state, initial_depth);
+}
+
+int LazyHistoryTree::AddNode(const State& state, int parent, Action action) {
+  const int index = nodes_.size();
+  nodes_.emplace_back();
+  Node& node = nodes_.back();
+  node.type = state.GetType();
+  node.current_player = state.CurrentPlayer();
+  node.value = state.IsTerminal() ? state.PlayerReturn(player_id_) : 0.;
+  node.action = action;
+  node.parent = parent;
+  node.depth = parent < 0 ? 0 : nodes_[parent].depth + 1;
+  return index;
+}
+
+void LazyHistoryTree::ExpandNode(int index, const State& state) {
+  if (nodes_[index].expanded) return;
+  ActionsAndProbs successors;
+  if (state.IsChanceNode()) {
+    successors = state.ChanceOutcomes();
+    double probability_sum = 0;
+    for (const auto& outcome_and_prob : successors) {
+      probability_sum += outcome_and_prob.second;
+    }
+    SPIEL_CHECK_FLOAT_EQ(probability_sum, 1.0);
+  } else if (!state.IsTerminal()) {
+    for (Action legal_action : state.LegalActions()) {
+      successors.push_back({legal_action, 1.});
+    }
+  }
+  // AddNode below grows nodes_, so the node is re-addressed per append.
+  std::vector<Child> children;
+  children.reserve(successors.size());
+  for (const auto& action_and_prob : successors) {
+    std::unique_ptr<State> child = state.Child(action_and_prob.first);
+    children.push_back({action_and_prob.first, action_and_prob.second,
+                        AddNode(*child, index, action_and_prob.first)});
+  }
+  nodes_[index].children = std::move(children);
+  nodes_[index].expanded = true;
+}
+
+int LazyHistoryTree::NumChildren(int index) {
+  if (!nodes_[index].expanded) ExpandNode(index, *MakeState(index));
+  return nodes_[index].children.size();
+}
+
+const LazyHistoryTree::Child& LazyHistoryTree::GetChild(int index, int child) {
+  if (!nodes_[index].expanded) ExpandNode(index, *MakeState(index));
+  return nodes_[index].children[child];
+}
+
+void LazyHistoryTree::Prefetch(int index, int depth) {
+  if (depth <= 0) return;
+  ExpandSubtree(index, *MakeState(index), depth);
+}
+
+void LazyHistoryTree::ExpandSubtree(int index, const State& state, int depth) {
+  if (depth <= 0 || state.IsTerminal()) return;
+  ExpandNode(index, state);
+  // Copy the child list: ExpandNode below grows nodes_ and may move it.
+  const std::vector<Child> children = nodes_[index].children;
+  for (const Child& child : children) {
+    std::unique_ptr<State> child_state = state.Child(child.action);
+    ExpandSubtree(child.node, *child_state, depth - 1);
+  }
+}
+
+std::unique_ptr<State> LazyHistoryTree::MakeState(int index) const {
+  std::vector<Action> actions;
+  for (int node = index; node != Root(); node = nodes_[node].parent) {
+    actions.push_back(nodes_[node].action);
+  }
+  std::unique_ptr<State> state = root_state_->Clone();
+  for (auto it = actions.rbegin(); it != actions.rend(); ++it) {
+    state->ApplyAction(*it);
+  }
+  return state;
+}
+
+std::shared_ptr<const CompactHistoryTree> GetCompactHistoryTree(
+    const Game& game, Player player_id) {
+  static std::mutex cache_mutex;
+  // Leaked intentionally: the cache lives for the whole process.
+  static auto* cache = new std::unordered_map<
+      std::string, std::shared_ptr<const CompactHistoryTree>>();
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<const CompactHistoryTree>& tree =
+      (*cache)[absl::StrCat(game.ToString(), " player=", player_id)];
+  if (tree == nullptr) {
+    tree = std::make_shared<const CompactHistoryTree>(game.NewInitialState(),
+                                                      player_id);
+  }
+  return tree;
+}
+
 HistoryNode::HistoryNode(Player player_id, std::unique_ptr<State> game_state)
     : state_(std::move(game_state)),
       history_(state_->ToString()),
@@ -139,26 +552,46 @@ std::vector<Action> HistoryNode::GetChildActions() const {
 }
 
 HistoryNode* HistoryTree::GetByHistory(const std::string& history) {
-  HistoryNode* node = state_to_node_[history];
-  if (node == nullptr) {
+  const int64_t id = history_pool_.Find(history);
+  if (id < 0) {
     SpielFatalError(absl::StrCat("Node is null for history: '", history, "'"));
   }
-  return node;
+  return nodes_by_id_[id];
 }
 
 std::vector<std::string> HistoryTree::GetHistories() {
   std::vector<std::string> histories;
-  histories.reserve(state_to_node_.size());
-  for (const auto& kv : state_to_node_) {
-    histories.push_back(kv.first);
+  histories.reserve(nodes_by_id_.size());
+  for (HistoryNode* node : nodes_by_id_) {
+    histories.push_back(node->GetHistory());
   }
   return histories;
 }
 
+void HistoryTree::IndexNodes(
+    const std::unordered_map<std::string, HistoryNode*>& state_to_node) {
+  nodes_by_id_.reserve(state_to_node.size());
+  for (const auto& kv : state_to_node) {
+    // Histories are unique, so ids come out sequentially.
+    const int64_t id = history_pool_.Intern(kv.first);
+    SPIEL_CHECK_EQ(id, static_cast<int64_t>(nodes_by_id_.size()));
+    kv.second->SetHistoryId(id);
+    nodes_by_id_.push_back(kv.second);
+  }
+}
+
 // Builds game tree consisting of all decision nodes for player_id.
 HistoryTree::HistoryTree(std::unique_ptr<State> state, Player player_id) {
-  root_ =
-      RecursivelyBuildGameTree(std::move(state), player_id, &state_to_node_);
+  std::unordered_map<std::string, HistoryNode*> state_to_node;
+  root_ = BuildGameTree(std::move(state), player_id, &state_to_node);
+  IndexNodes(state_to_node);
+}
+
+HistoryTree::HistoryTree(const SharedGameTree& shared_tree, Player player_id) {
+  std::unordered_map<std::string, HistoryNode*> state_to_node;
+  root_ = BuildFromSharedTree(shared_tree, shared_tree.Root(), player_id,
+                              &state_to_node);
+  IndexNodes(state_to_node);
 }
 
 ActionsAndProbs GetSuccessorsWithProbs(const State& state,
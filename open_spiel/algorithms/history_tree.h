@@ -40,6 +40,12 @@ class HistoryNode {
 
   const std::string& GetHistory() { return history_; }
 
+  // Dense id of this node's history in the owning tree's intern pool,
+  // assigned when the tree is built. Caches keyed on it hash an integer
+  // instead of the history string on every probe.
+  int64_t GetHistoryId() const { return history_id_; }
+  void SetHistoryId(int64_t history_id) { history_id_ = history_id; }
+
   const StateType& GetType() { return type_; }
 
   double GetValue() const { return value_; }
@@ -57,6 +63,7 @@ class HistoryNode {
   std::unique_ptr<State> state_;
   std::string infostate_;
   std::string history_;
+  int64_t history_id_ = -1;
   StateType type_;
   double value_;
 
@@ -66,6 +73,53 @@ class HistoryNode {
   std::map<Action, std::pair<double, std::unique_ptr<HistoryNode>>> child_info_;
 };
 
+// A player-independent enumeration of every history in a game, built by
+// walking the game engine once and immutable afterwards. Per-player
+// HistoryTrees are stamped out of it by cloning the stored states, which
+// skips the Child()/ChanceOutcomes() engine work that otherwise dominates
+// tree construction; all per-call mutable data (values, reach
+// probabilities) lives in the structures built from it, so a single
+// SharedGameTree can back any number of concurrent best-response and
+// exploitability computations.
+class SharedGameTree {
+ public:
+  explicit SharedGameTree(std::unique_ptr<State> root);
+
+  // Built once, shared by const reference; never copied.
+  SharedGameTree(const SharedGameTree&) = delete;
+  SharedGameTree& operator=(const SharedGameTree&) = delete;
+
+  struct Child {
+    Action action;
+    // The chance probability of the action at chance nodes, 1. elsewhere
+    // (decision probabilities come from the policy, or are counter-factual).
+    double prob;
+    // Index of the child node.
+    int node;
+  };
+  struct Node {
+    std::unique_ptr<State> state;
+    std::vector<Child> children;
+  };
+
+  const Node& GetNode(int index) const { return nodes_[index]; }
+  int Root() const { return 0; }
+  int NumNodes() const { return nodes_.size(); }
+
+ private:
+  // Appends the subtree rooted at state and returns its node's index.
+  int AddSubtree(std::unique_ptr<State> state);
+
+  std::vector<Node> nodes_;
+};
+
+// Returns the process-wide shared tree for the game, building it on first
+// use. Keyed on the game's string representation, so games loaded with the
+// same parameters share one tree. Our training loops construct best
+// responses thousands of times against the same game; with this cache the
+// game engine is only walked on the first construction.
+std::shared_ptr<const SharedGameTree> GetSharedGameTree(const Game& game);
+
 // History here refers to the fact that we're using histories- i.e.
 // representations of all players private information in addition to the public
 // information- as the underlying abstraction. Other trees are possible, such as
@@ -79,22 +133,220 @@ class HistoryTree {
   // viewed from the perspective of the player making the decision.
   HistoryTree(std::unique_ptr<State> state, Player player_id);
 
+  // Builds the same tree from a prebuilt SharedGameTree, cloning its stored
+  // states instead of replaying the game. The shared tree is not retained.
+  HistoryTree(const SharedGameTree& shared_tree, Player player_id);
+
   HistoryNode* Root() { return root_.get(); }
 
   HistoryNode* GetByHistory(const std::string& history);
 
+  // O(1) lookup by the id assigned to the node at construction (see
+  // HistoryNode::GetHistoryId).
+  HistoryNode* GetByHistoryId(int64_t history_id) {
+    return nodes_by_id_[history_id];
+  }
+
   // For test use only.
   std::vector<std::string> GetHistories();
 
-  Action NumHistories() { return state_to_node_.size(); }
+  Action NumHistories() { return nodes_by_id_.size(); }
 
  private:
+  // Interns every history string into history_pool_, assigns the resulting
+  // ids to the nodes, and fills nodes_by_id_.
+  void IndexNodes(
+      const std::unordered_map<std::string, HistoryNode*>& state_to_node);
+
   std::unique_ptr<HistoryNode> root_;
 
-  // Maps histories to HistoryNodes.
-  std::unordered_map<std::string, HistoryNode*> state_to_node_;
+  // Index over the nodes' history strings; lookups by string go through
+  // the pool (hashing the characters in place, no per-query allocation),
+  // lookups by id are an array index.
+  StringInternPool history_pool_;
+  std::vector<HistoryNode*> nodes_by_id_;
 };
 
+// A compact, read-only encoding of the tree HistoryTree builds. All nodes
+// live in one contiguous array, the history and information state strings
+// are interned into a single buffer, and a node's children are an index
+// range into one child array, so traversals touch a few flat arrays
+// instead of chasing per-node heap allocations. No State clones are kept:
+// a state is reconstructed on demand by replaying the node's action path
+// from the root. On games like liars_dice this is the difference between
+// gigabytes of stored clones and a few flat megabytes.
+//
+// As with HistoryTree, chance and terminal nodes are viewed from
+// player_id's perspective and decision nodes from the mover's.
+class CompactHistoryTree {
+ public:
+  CompactHistoryTree(std::unique_ptr<State> state, Player player_id);
+
+  struct Node {
+    StateType type;
+    Player current_player;
+    // Terminal return for player_id; 0 at non-terminal nodes.
+    double value;
+    // Action leading here from the parent; kInvalidAction at the root.
+    Action action;
+    // Index of the parent node; -1 at the root.
+    int parent;
+    // Range [first_child, first_child + num_children) into the child array.
+    int first_child;
+    int num_children;
+    // Positions of the interned strings in the string buffer.
+    int64_t history_offset;
+    int history_length;
+    int64_t infostate_offset;
+    int infostate_length;
+    // Dense id of the node's information state string: nodes with equal
+    // strings share an id, ids cover [0, NumInfoStates()). Tabular
+    // consumers key their per-infostate tables on it instead of hashing
+    // the string.
+    int infostate_id;
+  };
+  struct Child {
+    Action action;
+    // The chance probability of the action at chance nodes, 1. elsewhere.
+    double prob;
+    // Index of the child node.
+    int node;
+  };
+
+  int Root() const { return 0; }
+  int NumNodes() const { return nodes_.size(); }
+  const Node& GetNode(int index) const { return nodes_[index]; }
+  const Child& GetChild(int index, int child) const {
+    return children_[nodes_[index].first_child + child];
+  }
+
+  // The perspective the tree was built for.
+  Player PlayerId() const { return player_id_; }
+
+  // Number of distinct information state strings across all nodes; the
+  // range of Node::infostate_id.
+  int NumInfoStates() const { return num_info_states_; }
+
+  // Materialize copies of the interned strings for the given node.
+  std::string History(int index) const;
+  std::string InfoState(int index) const;
+
+  // Reconstructs the state at the given node by replaying its action path
+  // from the root.
+  std::unique_ptr<State> MakeState(int index) const;
+
+  // Writes the flat arrays to a binary file so later processes skip the
+  // game walk. The format is tied to this build (raw struct layout); the
+  // header records the game string and player, which LoadFromFile checks
+  // against the game it is given before trusting the payload.
+  void SaveToFile(const std::string& filename) const;
+  static std::unique_ptr<CompactHistoryTree> LoadFromFile(
+      const std::string& filename, const Game& game);
+
+ private:
+  CompactHistoryTree() = default;  // For LoadFromFile.
+
+  // Appends the subtree rooted at state and returns its node's index.
+  int AddSubtree(const State& state, int parent, Action action,
+                 Player player_id);
+
+  // Appends the string to the buffer and returns its offset.
+  int64_t Intern(const std::string& str);
+
+  // Assigns Node::infostate_id over the finished nodes and sets
+  // num_info_states_.
+  void IndexInfoStates();
+
+  std::unique_ptr<State> root_state_;
+  Player player_id_;
+  int num_info_states_ = 0;
+  std::vector<Node> nodes_;
+  std::vector<Child> children_;
+  std::string strings_;
+};
+
+// A lazily materialized game tree for depth-limited and interactive
+// analyses, where HistoryTree's eager full construction would pay the
+// whole game's cost up front. Construction expands only a shell to
+// initial_depth; deeper nodes are materialized the first time their
+// parent's children are requested, by replaying the parent's stored
+// action path from the root (no State clones are retained, as in
+// CompactHistoryTree). Node indices are stable once handed out.
+//
+// Callers that know their access pattern can call Prefetch to expand a
+// subtree ahead of use with one replay instead of one per node.
+class LazyHistoryTree {
+ public:
+  LazyHistoryTree(std::unique_ptr<State> state, Player player_id,
+                  int initial_depth);
+
+  struct Child {
+    Action action;
+    // The chance probability of the action at chance nodes, 1. elsewhere.
+    double prob;
+    // Index of the child node.
+    int node;
+  };
+
+  int Root() const { return 0; }
+
+  // Number of nodes materialized so far; grows as the tree is explored.
+  int NumMaterializedNodes() const { return nodes_.size(); }
+
+  StateType Type(int index) const { return nodes_[index].type; }
+  Player CurrentPlayer(int index) const {
+    return nodes_[index].current_player;
+  }
+  // Terminal return for player_id; 0 at non-terminal nodes.
+  double Value(int index) const { return nodes_[index].value; }
+  int Depth(int index) const { return nodes_[index].depth; }
+
+  // Materializes the node's children if this is their first access.
+  int NumChildren(int index);
+  const Child& GetChild(int index, int child);
+
+  // Expands the subtree below index to the given additional depth.
+  void Prefetch(int index, int depth);
+
+  // Reconstructs the state at the given node by replaying its action path
+  // from the root.
+  std::unique_ptr<State> MakeState(int index) const;
+
+ private:
+  struct Node {
+    StateType type;
+    Player current_player;
+    double value;
+    // Action leading here from the parent; kInvalidAction at the root.
+    Action action;
+    // Index of the parent node; -1 at the root.
+    int parent;
+    int depth;
+    bool expanded = false;
+    std::vector<Child> children;
+  };
+
+  // Appends a node for the state and returns its index.
+  int AddNode(const State& state, int parent, Action action);
+
+  // Creates the node's children (one level) from its state.
+  void ExpandNode(int index, const State& state);
+
+  // Expands the subtree below index to the given additional depth,
+  // descending through child states instead of replaying paths.
+  void ExpandSubtree(int index, const State& state, int depth);
+
+  std::unique_ptr<State> root_state_;
+  Player player_id_;
+  std::vector<Node> nodes_;
+};
+
+// Returns the process-wide compact tree for the (game, player) pair,
+// building it on first use. Keyed like GetSharedGameTree, so pipelines
+// that evaluate the same game hundreds of times pay for the walk once.
+std::shared_ptr<const CompactHistoryTree> GetCompactHistoryTree(
+    const Game& game, Player player_id);
+
 // Returns a map of infostate strings to a vector of history nodes with
 // corresponding counter-factual probabilities, where counter-factual
 // probabilities are calculatd using the passed policy for the opponent's
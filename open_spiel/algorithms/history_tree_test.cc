@@ -446,6 +446,162 @@ void TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid1() {
                            /*best_responder=*/Player{1});
 }
 
+void TestCompactHistoryTreeMatchesHistoryTree() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  for (Player player_id : {Player{0}, Player{1}}) {
+    HistoryTree tree(game->NewInitialState(), player_id);
+    CompactHistoryTree compact_tree(game->NewInitialState(), player_id);
+    SPIEL_CHECK_EQ(tree.NumHistories(), compact_tree.NumNodes());
+    for (int index = 0; index < compact_tree.NumNodes(); ++index) {
+      const CompactHistoryTree::Node& compact_node =
+          compact_tree.GetNode(index);
+      HistoryNode* node = tree.GetByHistory(compact_tree.History(index));
+      SPIEL_CHECK_EQ(node->GetInfoState(), compact_tree.InfoState(index));
+      SPIEL_CHECK_TRUE(node->GetType() == compact_node.type);
+      if (compact_node.type == StateType::kTerminal) {
+        SPIEL_CHECK_EQ(node->GetValue(), compact_node.value);
+      }
+      SPIEL_CHECK_EQ(node->NumChildren(),
+                     static_cast<Action>(compact_node.num_children));
+      for (int i = 0; i < compact_node.num_children; ++i) {
+        const CompactHistoryTree::Child& child = compact_tree.GetChild(index, i);
+        SPIEL_CHECK_EQ(node->GetChild(child.action).first, child.prob);
+      }
+      // The state must be reconstructible from the stored action path.
+      SPIEL_CHECK_EQ(compact_tree.MakeState(index)->ToString(),
+                     compact_tree.History(index));
+    }
+  }
+}
+
+void TestCompactHistoryTreeInfoStateIds() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CompactHistoryTree tree(game->NewInitialState(), Player{0});
+  // Ids are dense, and two nodes share an id exactly when they share an
+  // information state string.
+  std::unordered_map<int, std::string> strings_by_id;
+  for (int index = 0; index < tree.NumNodes(); ++index) {
+    const int id = tree.GetNode(index).infostate_id;
+    SPIEL_CHECK_GE(id, 0);
+    SPIEL_CHECK_LT(id, tree.NumInfoStates());
+    auto insert_result = strings_by_id.emplace(id, tree.InfoState(index));
+    SPIEL_CHECK_EQ(insert_result.first->second, tree.InfoState(index));
+  }
+  SPIEL_CHECK_EQ(strings_by_id.size(), tree.NumInfoStates());
+}
+
+void TestCompactHistoryTreeSaveLoad() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CompactHistoryTree tree(game->NewInitialState(), Player{1});
+  const std::string filename = "/tmp/open_spiel_compact_tree_test";
+  tree.SaveToFile(filename);
+  std::unique_ptr<CompactHistoryTree> loaded =
+      CompactHistoryTree::LoadFromFile(filename, *game);
+  SPIEL_CHECK_EQ(loaded->PlayerId(), tree.PlayerId());
+  SPIEL_CHECK_EQ(loaded->NumNodes(), tree.NumNodes());
+  SPIEL_CHECK_EQ(loaded->NumInfoStates(), tree.NumInfoStates());
+  for (int index = 0; index < tree.NumNodes(); ++index) {
+    SPIEL_CHECK_EQ(loaded->History(index), tree.History(index));
+    SPIEL_CHECK_EQ(loaded->InfoState(index), tree.InfoState(index));
+    SPIEL_CHECK_EQ(loaded->GetNode(index).infostate_id,
+                   tree.GetNode(index).infostate_id);
+    SPIEL_CHECK_EQ(loaded->GetNode(index).value, tree.GetNode(index).value);
+    SPIEL_CHECK_EQ(loaded->GetNode(index).num_children,
+                   tree.GetNode(index).num_children);
+  }
+  // The loaded tree replays states through the game it was given.
+  SPIEL_CHECK_EQ(loaded->MakeState(tree.NumNodes() - 1)->ToString(),
+                 tree.History(tree.NumNodes() - 1));
+  std::remove(filename.c_str());
+}
+
+// Walks the lazy tree to the bottom, counting nodes and checking
+// terminal values against replayed states.
+int WalkLazyTree(LazyHistoryTree* tree, int index) {
+  if (tree->Type(index) == StateType::kTerminal) {
+    SPIEL_CHECK_EQ(tree->Value(index),
+                   tree->MakeState(index)->PlayerReturn(Player{0}));
+    return 1;
+  }
+  int count = 1;
+  for (int i = 0; i < tree->NumChildren(index); ++i) {
+    count += WalkLazyTree(tree, tree->GetChild(index, i).node);
+  }
+  return count;
+}
+
+void TestLazyHistoryTree() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+
+  // A zero-depth shell is just the root, regardless of game size.
+  LazyHistoryTree shell(game->NewInitialState(), Player{0},
+                        /*initial_depth=*/0);
+  SPIEL_CHECK_EQ(shell.NumMaterializedNodes(), 1);
+
+  // A depth-1 shell holds the root and its children.
+  LazyHistoryTree one_level(game->NewInitialState(), Player{0},
+                            /*initial_depth=*/1);
+  SPIEL_CHECK_EQ(one_level.NumMaterializedNodes(),
+                 1 + game->NewInitialState()->ChanceOutcomes().size());
+
+  // Prefetching expands ahead of access without changing the structure.
+  one_level.Prefetch(one_level.Root(), 2);
+  const int prefetched = one_level.NumMaterializedNodes();
+  SPIEL_CHECK_GT(prefetched, 1 + 3);
+
+  // On-demand deepening reaches the full tree, and it matches the eager
+  // HistoryTree node for node.
+  HistoryTree eager_tree(game->NewInitialState(), Player{0});
+  SPIEL_CHECK_EQ(WalkLazyTree(&one_level, one_level.Root()),
+                 eager_tree.NumHistories());
+  SPIEL_CHECK_EQ(WalkLazyTree(&shell, shell.Root()),
+                 eager_tree.NumHistories());
+}
+
+void TestGetCompactHistoryTreeCaches() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::shared_ptr<const CompactHistoryTree> tree =
+      GetCompactHistoryTree(*game, Player{0});
+  if (GetCompactHistoryTree(*game, Player{0}) != tree) {
+    SpielFatalError("GetCompactHistoryTree rebuilt the tree.");
+  }
+  // Different perspectives get different trees.
+  if (GetCompactHistoryTree(*game, Player{1}) == tree) {
+    SpielFatalError("GetCompactHistoryTree shared a tree across players.");
+  }
+}
+
+void TestSharedGameTreeMatchesDirectConstruction() {
+  for (const std::string& game_name : {"kuhn_poker", "leduc_poker"}) {
+    std::shared_ptr<const Game> game = LoadGame(game_name);
+    std::shared_ptr<const SharedGameTree> shared_tree =
+        GetSharedGameTree(*game);
+
+    // The cache must hand out the same tree on repeated lookups.
+    if (GetSharedGameTree(*game) != shared_tree) {
+      SpielFatalError(absl::StrCat("In the game ", game_name,
+                                   ", GetSharedGameTree rebuilt the tree."));
+    }
+
+    for (Player player_id : {Player{0}, Player{1}}) {
+      HistoryTree direct_tree(game->NewInitialState(), player_id);
+      HistoryTree stamped_tree(*shared_tree, player_id);
+      SPIEL_CHECK_EQ(direct_tree.NumHistories(), stamped_tree.NumHistories());
+      for (const std::string& history : direct_tree.GetHistories()) {
+        HistoryNode* direct_node = direct_tree.GetByHistory(history);
+        HistoryNode* stamped_node = stamped_tree.GetByHistory(history);
+        SPIEL_CHECK_EQ(direct_node->GetInfoState(),
+                       stamped_node->GetInfoState());
+        SPIEL_CHECK_EQ(direct_node->GetChildActions(),
+                       stamped_node->GetChildActions());
+        if (direct_node->GetType() == StateType::kTerminal) {
+          SPIEL_CHECK_EQ(direct_node->GetValue(), stamped_node->GetValue());
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -467,4 +623,10 @@ int main(int argc, char** argv) {
       TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid0();
   open_spiel::algorithms::
       TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid1();
+  open_spiel::algorithms::TestSharedGameTreeMatchesDirectConstruction();
+  open_spiel::algorithms::TestCompactHistoryTreeMatchesHistoryTree();
+  open_spiel::algorithms::TestCompactHistoryTreeInfoStateIds();
+  open_spiel::algorithms::TestCompactHistoryTreeSaveLoad();
+  open_spiel::algorithms::TestGetCompactHistoryTreeCaches();
+  open_spiel::algorithms::TestLazyHistoryTree();
 }
@@ -0,0 +1,152 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/ladder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+Ladder::Ladder(std::shared_ptr<const Game> game, LadderOptions options)
+    : game_(std::move(game)), options_(std::move(options)) {
+  // Elo and the pairing schemes are pairwise comparisons.
+  SPIEL_CHECK_EQ(game_->NumPlayers(), 2);
+}
+
+void Ladder::RegisterBot(const std::string& name, BotFactory factory) {
+  for (const LadderEntry& entry : entries_) {
+    if (entry.name == name) {
+      SpielFatalError(absl::StrCat("Ladder: duplicate bot name: ", name));
+    }
+  }
+  entries_.push_back(LadderEntry{name});
+  factories_.push_back(std::move(factory));
+}
+
+std::vector<std::pair<int, int>> Ladder::SchedulePairings() {
+  const int num_bots = entries_.size();
+  // Seats alternate between rounds so recurring pairings swap colors.
+  const bool swap_seats = rounds_played_ % 2 == 1;
+  std::vector<std::pair<int, int>> pairings;
+  if (options_.pairing == LadderPairing::kRoundRobin) {
+    for (int i = 0; i < num_bots; ++i) {
+      for (int j = i + 1; j < num_bots; ++j) {
+        pairings.emplace_back(swap_seats ? j : i, swap_seats ? i : j);
+      }
+    }
+  } else {  // Swiss: neighbours in the current standings meet.
+    std::vector<int> order(num_bots);
+    for (int i = 0; i < num_bots; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+      if (entries_[a].score != entries_[b].score) {
+        return entries_[a].score > entries_[b].score;
+      }
+      return entries_[a].elo > entries_[b].elo;
+    });
+    for (int i = 0; i + 1 < num_bots; i += 2) {
+      pairings.emplace_back(swap_seats ? order[i + 1] : order[i],
+                            swap_seats ? order[i] : order[i + 1]);
+    }
+    if (num_bots % 2 == 1) {
+      // The bot ranked last sits the round out with a half-point bye.
+      entries_[order[num_bots - 1]].score += 0.5;
+    }
+  }
+  return pairings;
+}
+
+void Ladder::UpdateRatings(int home, int away, double home_score) {
+  LadderEntry& home_entry = entries_[home];
+  LadderEntry& away_entry = entries_[away];
+  const double expected =
+      1.0 / (1.0 + std::pow(10.0, (away_entry.elo - home_entry.elo) / 400.0));
+  home_entry.elo += options_.elo_k * (home_score - expected);
+  away_entry.elo -= options_.elo_k * (home_score - expected);
+  home_entry.score += home_score;
+  away_entry.score += 1 - home_score;
+  home_entry.games_played += 1;
+  away_entry.games_played += 1;
+  home_entry.elo_stddev = 400.0 / std::sqrt(home_entry.games_played);
+  away_entry.elo_stddev = 400.0 / std::sqrt(away_entry.games_played);
+}
+
+void Ladder::PlayRounds(int num_rounds) {
+  SPIEL_CHECK_GE(entries_.size(), 2);
+  for (int round = 0; round < num_rounds; ++round) {
+    const std::vector<std::pair<int, int>> pairings = SchedulePairings();
+    std::vector<LadderGameResult> round_results(pairings.size());
+
+    // Each game gets its own task and its own slot, and fresh bots built on
+    // the worker that plays it. Seeds are derived from the schedule
+    // position, so results don't depend on the pool's worker count.
+    TaskGroup group(TaskPool::Global());
+    for (int g = 0; g < pairings.size(); ++g) {
+      const auto [home, away] = pairings[g];
+      const int base_seed = options_.seed + 3 * games_scheduled_++;
+      LadderGameResult* result = &round_results[g];
+      result->round = rounds_played_;
+      result->home = entries_[home].name;
+      result->away = entries_[away].name;
+      group.Spawn([this, home, away, base_seed, result]() {
+        std::unique_ptr<Bot> home_bot =
+            factories_[home](*game_, Player{0}, base_seed + 1);
+        std::unique_ptr<Bot> away_bot =
+            factories_[away](*game_, Player{1}, base_seed + 2);
+        result->returns = EvaluateBots(game_->NewInitialState().get(),
+                                       {home_bot.get(), away_bot.get()},
+                                       base_seed);
+        result->home_score = result->returns[0] > result->returns[1] ? 1.0
+                             : result->returns[0] < result->returns[1] ? 0.0
+                                                                       : 0.5;
+      });
+    }
+    group.Sync();
+
+    // Ratings fold in sequentially, in schedule order.
+    for (int g = 0; g < pairings.size(); ++g) {
+      UpdateRatings(pairings[g].first, pairings[g].second,
+                    round_results[g].home_score);
+      results_.push_back(std::move(round_results[g]));
+    }
+    ++rounds_played_;
+  }
+}
+
+std::vector<LadderEntry> Ladder::Standings() const {
+  std::vector<LadderEntry> standings = entries_;
+  std::stable_sort(standings.begin(), standings.end(),
+                   [](const LadderEntry& a, const LadderEntry& b) {
+                     return a.elo > b.elo;
+                   });
+  return standings;
+}
+
+std::string Ladder::ToString() const {
+  std::string out = absl::StrFormat("%-20s %6s %6s %6s %8s\n", "bot", "games",
+                                    "score", "elo", "+-");
+  for (const LadderEntry& entry : Standings()) {
+    absl::StrAppendFormat(&out, "%-20s %6d %6.1f %6.0f %8.0f\n", entry.name,
+                          entry.games_played, entry.score, entry.elo,
+                          entry.elo_stddev);
+  }
+  return out;
+}
+
+}  // namespace open_spiel
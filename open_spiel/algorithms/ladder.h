@@ -0,0 +1,114 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_LADDER_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_LADDER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+// A ladder for tracking the relative strength of a pool of bots over many
+// games of a two-player game. Bots are registered as factories (see
+// evaluate_bots.h): every scheduled game constructs its own pair of bots on
+// the worker that plays it, so nothing is shared between concurrent games.
+// Each round schedules one game per pairing -- full round-robin, or Swiss
+// (neighbours in the current standings) -- plays the round's games
+// concurrently on the shared TaskPool, and folds the outcomes into
+// incremental Elo ratings. Scheduling and rating updates follow a fixed
+// order, so the standings do not depend on how many workers the pool has.
+
+namespace open_spiel {
+
+// How each round's games are paired.
+enum class LadderPairing {
+  kRoundRobin,  // Every pair of bots meets once per round.
+  kSwiss,       // Bots adjacent in the standings meet: 1v2, 3v4, ...
+};
+
+struct LadderOptions {
+  LadderPairing pairing = LadderPairing::kRoundRobin;
+  double elo_k = 32;  // Step size of the incremental Elo update.
+  int seed = 42;      // Seeds the per-game bot and chance streams.
+};
+
+// One finished game, in the order it was scheduled.
+struct LadderGameResult {
+  int round;
+  std::string home;  // The bot seated as player 0.
+  std::string away;  // The bot seated as player 1.
+  std::vector<double> returns;
+  double home_score;  // 1 for a home win, 0.5 for a draw, 0 for a loss.
+};
+
+// A bot's standing on the ladder.
+struct LadderEntry {
+  std::string name;
+  int games_played = 0;
+  double score = 0;   // Wins plus half a point per draw (and per bye).
+  double elo = 1500;  // Incremental Elo, anchored at 1500.
+  // Rough one-sigma bound on the rating, 400 / sqrt(games_played): the
+  // standard error of an estimate from that many comparable games.
+  double elo_stddev = 400;
+};
+
+class Ladder {
+ public:
+  Ladder(std::shared_ptr<const Game> game,
+         LadderOptions options = LadderOptions());
+
+  // Adds a bot to the pool. Names must be unique; registering after games
+  // have been played is allowed, and the newcomer starts at 1500.
+  void RegisterBot(const std::string& name, BotFactory factory);
+
+  // Schedules and plays `num_rounds` rounds of pairings. Seats alternate
+  // between rounds so both bots of a recurring pairing get each color. With
+  // Swiss pairing and an odd pool, the bot ranked last gets a half-point
+  // bye. Games within a round run concurrently on the global TaskPool.
+  void PlayRounds(int num_rounds);
+
+  // Standings sorted by Elo, best first.
+  std::vector<LadderEntry> Standings() const;
+
+  // Every game played so far, in schedule order.
+  const std::vector<LadderGameResult>& Results() const { return results_; }
+
+  int NumRoundsPlayed() const { return rounds_played_; }
+
+  // The standings as a readable table, for logs.
+  std::string ToString() const;
+
+ private:
+  // The round's schedule as (home, away) entry indices.
+  std::vector<std::pair<int, int>> SchedulePairings();
+
+  // Folds one result into the two bots' ratings.
+  void UpdateRatings(int home, int away, double home_score);
+
+  std::shared_ptr<const Game> game_;
+  LadderOptions options_;
+  std::vector<LadderEntry> entries_;
+  std::vector<BotFactory> factories_;
+  std::vector<LadderGameResult> results_;
+  int rounds_played_ = 0;
+  int games_scheduled_ = 0;  // Drives per-game seed derivation.
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_LADDER_H_
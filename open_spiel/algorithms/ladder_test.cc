@@ -0,0 +1,119 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/ladder.h"
+
+#include <cmath>
+#include <memory>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+BotFactory RandomBotFactory() {
+  return [](const Game& game, Player player, int seed) {
+    return MakeUniformRandomBot(game, player, seed);
+  };
+}
+
+// The evaluator must outlive the bots; it is thread-safe, so one instance
+// serves all concurrent games.
+BotFactory MctsBotFactory(const algorithms::Evaluator* evaluator,
+                          int max_simulations) {
+  return [evaluator, max_simulations](const Game& game, Player player,
+                                      int seed) -> std::unique_ptr<Bot> {
+    return std::make_unique<algorithms::MCTSBot>(
+        game, player, *evaluator, /*uct_c=*/2.0, max_simulations,
+        /*max_memory_mb=*/10, /*solve=*/true, seed, /*verbose=*/false);
+  };
+}
+
+void RoundRobinLadderTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/11);
+  Ladder ladder(game);
+  ladder.RegisterBot("mcts", MctsBotFactory(&evaluator, 100));
+  ladder.RegisterBot("random", RandomBotFactory());
+  ladder.PlayRounds(6);
+
+  SPIEL_CHECK_EQ(ladder.NumRoundsPlayed(), 6);
+  SPIEL_CHECK_EQ(ladder.Results().size(), 6);  // One pairing per round.
+  std::vector<LadderEntry> standings = ladder.Standings();
+  SPIEL_CHECK_EQ(standings.size(), 2);
+  // The search bot must outrate the random one.
+  SPIEL_CHECK_TRUE(standings[0].name == "mcts");
+  SPIEL_CHECK_GT(standings[0].elo, standings[1].elo);
+  for (const LadderEntry& entry : standings) {
+    SPIEL_CHECK_EQ(entry.games_played, 6);
+    SPIEL_CHECK_FLOAT_NEAR(entry.elo_stddev, 400.0 / std::sqrt(6.0), 1e-9);
+  }
+  // The zero-sum updates conserve the rating pool.
+  SPIEL_CHECK_FLOAT_NEAR(standings[0].elo + standings[1].elo, 3000.0, 1e-9);
+}
+
+void SwissLadderTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/13);
+  LadderOptions options;
+  options.pairing = LadderPairing::kSwiss;
+  Ladder ladder(game, options);
+  ladder.RegisterBot("mcts", MctsBotFactory(&evaluator, 100));
+  ladder.RegisterBot("random_a", RandomBotFactory());
+  ladder.RegisterBot("random_b", RandomBotFactory());
+  ladder.PlayRounds(4);
+
+  // Three bots: one game and one half-point bye per round.
+  SPIEL_CHECK_EQ(ladder.Results().size(), 4);
+  double total_score = 0;
+  int total_games = 0;
+  for (const LadderEntry& entry : ladder.Standings()) {
+    total_score += entry.score;
+    total_games += entry.games_played;
+  }
+  SPIEL_CHECK_FLOAT_NEAR(total_score, 4 * 1.5, 1e-9);
+  SPIEL_CHECK_EQ(total_games, 8);
+  for (int g = 0; g < ladder.Results().size(); ++g) {
+    SPIEL_CHECK_EQ(ladder.Results()[g].round, g);  // One game per round.
+  }
+}
+
+void DeterministicResultsTest() {
+  // The same registrations and seed must reproduce the same ratings,
+  // whatever the pool's worker count happens to be.
+  auto game = LoadGame("tic_tac_toe");
+  std::vector<double> elos[2];
+  for (int run = 0; run < 2; ++run) {
+    Ladder ladder(game);
+    ladder.RegisterBot("random_a", RandomBotFactory());
+    ladder.RegisterBot("random_b", RandomBotFactory());
+    ladder.PlayRounds(10);
+    for (const LadderEntry& entry : ladder.Standings()) {
+      elos[run].push_back(entry.elo);
+    }
+  }
+  SPIEL_CHECK_TRUE(elos[0] == elos[1]);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::RoundRobinLadderTest();
+  open_spiel::SwissLadderTest();
+  open_spiel::DeterministicResultsTest();
+}
@@ -0,0 +1,123 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/matrix_game_dynamics.h"
+
+#include <algorithm>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using matrix_game::MatrixGame;
+
+std::vector<double> UniformStrategy(int num_actions) {
+  return std::vector<double>(num_actions, 1.0 / num_actions);
+}
+
+// NashConv of a strategy profile: each player's best-response value against
+// the other's mixture, minus their current expected utility, summed.
+double ProfileNashConv(const MatrixGame& game,
+                       const std::vector<std::vector<double>>& strategies,
+                       std::vector<double>* utilities) {
+  double nash_conv = 0;
+  for (Player player : {Player{0}, Player{1}}) {
+    game.BestResponseUtilities(player, strategies[1 - player], utilities);
+    nash_conv += *std::max_element(utilities->begin(), utilities->end()) -
+                 game.ExpectedUtility(player, strategies[0], strategies[1]);
+  }
+  return nash_conv;
+}
+
+}  // namespace
+
+MatrixFictitiousPlaySolver::MatrixFictitiousPlaySolver(const MatrixGame& game)
+    : game_(game),
+      strategies_({UniformStrategy(game.NumRows()),
+                   UniformStrategy(game.NumCols())}) {}
+
+void MatrixFictitiousPlaySolver::Iterate(int iterations) {
+  for (int i = 0; i < iterations; ++i) {
+    // Both responses are computed against the pre-update mixtures, then
+    // folded in simultaneously with weight 1/(t+1).
+    const Action row_response =
+        game_.BestResponse(Player{0}, strategies_[1]);
+    const Action col_response =
+        game_.BestResponse(Player{1}, strategies_[0]);
+    const double mix = 1.0 / (iterations_ + 2);  // Uniform start counts once.
+    for (Player player : {Player{0}, Player{1}}) {
+      const Action response = player == Player{0} ? row_response : col_response;
+      std::vector<double>& strategy = strategies_[player];
+      for (int a = 0; a < strategy.size(); ++a) {
+        strategy[a] += mix * ((a == response ? 1.0 : 0.0) - strategy[a]);
+      }
+    }
+    ++iterations_;
+  }
+}
+
+double MatrixFictitiousPlaySolver::NashConv() const {
+  std::vector<double> utilities;
+  return ProfileNashConv(game_, strategies_, &utilities);
+}
+
+ReplicatorDynamicsSolver::ReplicatorDynamicsSolver(const MatrixGame& game)
+    : game_(game),
+      // Shifting fitnesses by 1 - MinUtility() keeps them >= 1, so masses
+      // shrink by bounded factors and never hit zero in finite time.
+      fitness_offset_(1.0 - game.MinUtility()),
+      strategies_({UniformStrategy(game.NumRows()),
+                   UniformStrategy(game.NumCols())}),
+      averaged_sums_(strategies_),
+      averaged_strategies_(strategies_) {}
+
+void ReplicatorDynamicsSolver::Iterate(int iterations) {
+  for (int i = 0; i < iterations; ++i) {
+    // Both players are updated from the pre-update profile.
+    for (Player player : {Player{0}, Player{1}}) {
+      game_.BestResponseUtilities(player, strategies_[1 - player],
+                                  &utilities_);
+      std::vector<double>& strategy = averaged_strategies_[player];  // Scratch.
+      double mean_fitness = 0;
+      for (int a = 0; a < strategy.size(); ++a) {
+        strategy[a] = strategies_[player][a] * (utilities_[a] + fitness_offset_);
+        mean_fitness += strategy[a];
+      }
+      for (int a = 0; a < strategy.size(); ++a) strategy[a] /= mean_fitness;
+    }
+    for (Player player : {Player{0}, Player{1}}) {
+      strategies_[player].swap(averaged_strategies_[player]);
+      for (int a = 0; a < strategies_[player].size(); ++a) {
+        averaged_sums_[player][a] += strategies_[player][a];
+      }
+    }
+    ++iterations_;
+  }
+  for (Player player : {Player{0}, Player{1}}) {
+    for (int a = 0; a < averaged_sums_[player].size(); ++a) {
+      averaged_strategies_[player][a] =
+          averaged_sums_[player][a] / (iterations_ + 1);
+    }
+  }
+}
+
+double ReplicatorDynamicsSolver::NashConv() const {
+  std::vector<double> utilities;
+  return ProfileNashConv(game_, averaged_strategies_, &utilities);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
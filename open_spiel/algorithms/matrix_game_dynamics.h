@@ -0,0 +1,104 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_DYNAMICS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_DYNAMICS_H_
+
+#include <vector>
+
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel.h"
+
+// Learning dynamics that iterate directly over MatrixGame payoff arrays.
+// Updates run through the batch kernels on MatrixGame (ExpectedUtility,
+// BestResponseUtilities), which walk the row-major payoffs contiguously, so
+// an iteration costs one pass over each player's matrix. Both dynamics track
+// the empirical (time-averaged) mixture, which is what converges to
+// equilibrium in zero-sum games even when the iterates themselves cycle;
+// NashConv of that mixture is the convergence measure.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Fictitious play: each iteration both players simultaneously best respond
+// to the opponent's empirical mixture, and the response is folded into their
+// own. The empirical mixtures converge to equilibrium in two-player
+// zero-sum games (and to the pure equilibrium in dominance-solvable ones).
+class MatrixFictitiousPlaySolver {
+ public:
+  // The game must outlive the solver.
+  explicit MatrixFictitiousPlaySolver(const matrix_game::MatrixGame& game);
+
+  void Iterate(int iterations = 1);
+
+  // The empirical mixture of best responses played so far (initially
+  // uniform), over rows for kRowPlayer and columns for kColPlayer.
+  const std::vector<double>& Strategy(Player player) const {
+    return strategies_[player];
+  }
+
+  // NashConv of the empirical mixtures: the total gain available to the two
+  // players from deviating to a best response. Zero exactly at equilibrium.
+  double NashConv() const;
+
+  int NumIterations() const { return iterations_; }
+
+ private:
+  const matrix_game::MatrixGame& game_;
+  int iterations_ = 0;
+  std::vector<std::vector<double>> strategies_;
+};
+
+// Discrete-time replicator dynamics: each pure strategy's mass is rescaled
+// by its fitness against the opponent's current mixture,
+//   x_i <- x_i * (u(e_i, y) + c) / (u(x, y) + c),
+// with c chosen so fitnesses are strictly positive. Interior trajectories
+// cycle around the equilibrium of zero-sum games, so convergence is read
+// off the time-averaged mixture, as with fictitious play.
+class ReplicatorDynamicsSolver {
+ public:
+  // The game must outlive the solver.
+  explicit ReplicatorDynamicsSolver(const matrix_game::MatrixGame& game);
+
+  void Iterate(int iterations = 1);
+
+  // The current point of the dynamic (initially uniform).
+  const std::vector<double>& Strategy(Player player) const {
+    return strategies_[player];
+  }
+
+  // The time-averaged mixture over all iterations so far.
+  const std::vector<double>& AveragedStrategy(Player player) const {
+    return averaged_strategies_[player];
+  }
+
+  // NashConv of the time-averaged mixtures.
+  double NashConv() const;
+
+  int NumIterations() const { return iterations_; }
+
+ private:
+  const matrix_game::MatrixGame& game_;
+  const double fitness_offset_;
+  int iterations_ = 0;
+  std::vector<std::vector<double>> strategies_;
+  std::vector<std::vector<double>> averaged_sums_;
+  std::vector<std::vector<double>> averaged_strategies_;
+  std::vector<double> utilities_;  // Batch-kernel scratch.
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_DYNAMICS_H_
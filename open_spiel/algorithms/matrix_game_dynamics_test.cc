@@ -0,0 +1,83 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/matrix_game_dynamics.h"
+
+#include <memory>
+
+#include "open_spiel/algorithms/matrix_game_utils.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void FictitiousPlayRockPaperScissorsTest() {
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_rps");
+  MatrixFictitiousPlaySolver solver(*game);
+  solver.Iterate(10000);
+  // The empirical mixtures approach uniform; NashConv decays like 1/sqrt(T).
+  SPIEL_CHECK_LT(solver.NashConv(), 0.05);
+  for (Player player : {Player{0}, Player{1}}) {
+    for (double prob : solver.Strategy(player)) {
+      SPIEL_CHECK_FLOAT_NEAR(prob, 1.0 / 3.0, 0.05);
+    }
+  }
+}
+
+void FictitiousPlayPrisonersDilemmaTest() {
+  // Dominance-solvable: both empirical mixtures collapse onto defection.
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_pd");
+  MatrixFictitiousPlaySolver solver(*game);
+  solver.Iterate(2000);
+  SPIEL_CHECK_LT(solver.NashConv(), 0.01);
+  SPIEL_CHECK_GT(solver.Strategy(Player{0})[1], 0.99);
+  SPIEL_CHECK_GT(solver.Strategy(Player{1})[1], 0.99);
+}
+
+void ReplicatorDynamicsRockPaperScissorsTest() {
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_rps");
+  ReplicatorDynamicsSolver solver(*game);
+  solver.Iterate(10000);
+  // The trajectory orbits the equilibrium; its time average converges.
+  SPIEL_CHECK_LT(solver.NashConv(), 0.05);
+  for (Player player : {Player{0}, Player{1}}) {
+    for (double prob : solver.AveragedStrategy(player)) {
+      SPIEL_CHECK_FLOAT_NEAR(prob, 1.0 / 3.0, 0.05);
+    }
+  }
+}
+
+void ReplicatorDynamicsMatchingPenniesTest() {
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_mp");
+  ReplicatorDynamicsSolver solver(*game);
+  solver.Iterate(10000);
+  SPIEL_CHECK_LT(solver.NashConv(), 0.05);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::FictitiousPlayRockPaperScissorsTest();
+  open_spiel::algorithms::FictitiousPlayPrisonersDilemmaTest();
+  open_spiel::algorithms::ReplicatorDynamicsRockPaperScissorsTest();
+  open_spiel::algorithms::ReplicatorDynamicsMatchingPenniesTest();
+}
@@ -14,7 +14,15 @@
 
 #include "open_spiel/algorithms/matrix_game_utils.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <thread>
 
 #include "open_spiel/algorithms/deterministic_policy.h"
 #include "open_spiel/algorithms/expected_returns.h"
@@ -91,44 +99,160 @@ std::shared_ptr<const MatrixGame> AsMatrixGame(const NormalFormGame* game) {
       new MatrixGame(type, {}, row_names, col_names, row_utils, col_utils));
 }
 
-std::shared_ptr<const MatrixGame> ExtensiveToMatrixGame(const Game& game) {
-  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+namespace {
 
-  std::vector<std::string> row_names;
-  std::vector<std::string> col_names;
-  std::vector<std::vector<double>> row_player_utils;
-  std::vector<std::vector<double>> col_player_utils;
+// Number of deterministic policies `player` has; the row (or column) count of
+// the converted matrix.
+int64_t NumDeterministicPolicies(const Game& game, Player player) {
+  DeterministicTabularPolicy policy(game, player);
+  int64_t count = 0;
+  do {
+    ++count;
+  } while (policy.NextPolicy());
+  return count;
+}
 
-  GameType type = game.GetType();
+// Fills this worker's share of payoff rows (row indices congruent to `thread`
+// modulo num_threads). Each row is one row-player deterministic policy played
+// against every column-player deterministic policy; rows share nothing, so
+// workers only need their own policy enumerators. `emit` receives the row
+// index and the two utility rows.
+void FillPayoffRows(
+    const Game& game, int num_threads, int thread, int64_t num_cols,
+    const std::function<void(int64_t, const std::vector<double>&,
+                             const std::vector<double>&)>& emit) {
+  DeterministicTabularPolicy row_policy(game, 0);
+  DeterministicTabularPolicy col_policy(game, 1);
+  std::vector<double> row_utils(num_cols);
+  std::vector<double> col_utils(num_cols);
+  int64_t row = 0;
+  do {
+    if (row % num_threads == thread) {
+      col_policy.ResetDefaultPolicy();
+      int64_t col = 0;
+      do {
+        std::unique_ptr<State> state = game.NewInitialState();
+        std::vector<double> returns =
+            ExpectedReturns(*state, {&row_policy, &col_policy}, -1);
+        row_utils[col] = returns[0];
+        col_utils[col] = returns[1];
+        ++col;
+      } while (col_policy.NextPolicy());
+      SPIEL_CHECK_EQ(col, num_cols);
+      emit(row, row_utils, col_utils);
+    }
+    ++row;
+  } while (row_policy.NextPolicy());
+}
 
-  std::vector<DeterministicTabularPolicy> policies = {
-      DeterministicTabularPolicy(game, 0), DeterministicTabularPolicy(game, 1)};
+}  // namespace
 
-  bool first_row = true;
+std::shared_ptr<const MatrixGame> ExtensiveToMatrixGame(const Game& game,
+                                                        int num_threads) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  GameType type = game.GetType();
+
+  // Policy names, and the dimensions, come from one serial enumeration pass.
+  std::vector<std::string> row_names;
+  std::vector<std::string> col_names;
+  DeterministicTabularPolicy row_policy(game, 0);
+  DeterministicTabularPolicy col_policy(game, 1);
   do {
-    policies[1].ResetDefaultPolicy();
-    row_names.push_back(policies[0].ToString(" --- "));
-    std::vector<double> row_utils;
-    std::vector<double> col_utils;
-    do {
-      if (first_row) {
-        col_names.push_back(policies[1].ToString(" --- "));
-      }
-      std::unique_ptr<State> state = game.NewInitialState();
-      std::vector<double> returns =
-          ExpectedReturns(*state, {&policies[0], &policies[1]}, -1);
-      row_utils.push_back(returns[0]);
-      col_utils.push_back(returns[1]);
-    } while (policies[1].NextPolicy());
-    first_row = false;
-    row_player_utils.push_back(row_utils);
-    col_player_utils.push_back(col_utils);
-  } while (policies[0].NextPolicy());
+    row_names.push_back(row_policy.ToString(" --- "));
+  } while (row_policy.NextPolicy());
+  do {
+    col_names.push_back(col_policy.ToString(" --- "));
+  } while (col_policy.NextPolicy());
+  const int64_t num_rows = row_names.size();
+  const int64_t num_cols = col_names.size();
+
+  std::vector<std::vector<double>> row_player_utils(num_rows);
+  std::vector<std::vector<double>> col_player_utils(num_rows);
+  auto emit = [&](int64_t row, const std::vector<double>& row_utils,
+                  const std::vector<double>& col_utils) {
+    row_player_utils[row] = row_utils;
+    col_player_utils[row] = col_utils;
+  };
+  if (num_threads == 1) {
+    FillPayoffRows(game, 1, 0, num_cols, emit);
+  } else {
+    // Workers write disjoint rows, so no locking is needed.
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back(
+          [&, t]() { FillPayoffRows(game, num_threads, t, num_cols, emit); });
+    }
+    for (std::thread& thread : threads) thread.join();
+  }
 
   return matrix_game::CreateMatrixGame(type.short_name, type.long_name,
                                        row_names, col_names, row_player_utils,
                                        col_player_utils);
 }
 
+void ExtensiveToMatrixPayoffsFile(const Game& game, const std::string& filename,
+                                  int num_threads) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  const int64_t num_rows = NumDeterministicPolicies(game, 0);
+  const int64_t num_cols = NumDeterministicPolicies(game, 1);
+  const int64_t header_size = 2 * sizeof(int64_t);
+  const int64_t matrix_bytes = num_rows * num_cols * sizeof(double);
+  const int64_t file_size = header_size + 2 * matrix_bytes;
+
+  int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("Cannot open payoff file: ", filename));
+  }
+  if (ftruncate(fd, file_size) != 0) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Cannot size payoff file: ", filename));
+  }
+  void* mapping =
+      mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Cannot map payoff file: ", filename));
+  }
+
+  int64_t* header = reinterpret_cast<int64_t*>(mapping);
+  header[0] = num_rows;
+  header[1] = num_cols;
+  double* row_payoffs =
+      reinterpret_cast<double*>(static_cast<char*>(mapping) + header_size);
+  double* col_payoffs = row_payoffs + num_rows * num_cols;
+
+  // Workers stream their rows straight into the mapping; the kernel writes
+  // pages back as it pleases, so memory use tracks the touched pages, not
+  // the matrix.
+  auto emit = [&](int64_t row, const std::vector<double>& row_utils,
+                  const std::vector<double>& col_utils) {
+    std::memcpy(row_payoffs + row * num_cols, row_utils.data(),
+                num_cols * sizeof(double));
+    std::memcpy(col_payoffs + row * num_cols, col_utils.data(),
+                num_cols * sizeof(double));
+  };
+  if (num_threads == 1) {
+    FillPayoffRows(game, 1, 0, num_cols, emit);
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back(
+          [&, t]() { FillPayoffRows(game, num_threads, t, num_cols, emit); });
+    }
+    for (std::thread& thread : threads) thread.join();
+  }
+
+  if (msync(mapping, file_size, MS_SYNC) != 0) {
+    SpielFatalError(absl::StrCat("Cannot sync payoff file: ", filename));
+  }
+  munmap(mapping, file_size);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -51,8 +51,20 @@ std::shared_ptr<const matrix_game::MatrixGame> AsMatrixGame(const Game* game);
 //
 // Hence, this method should only be used for  small games! For example, Kuhn
 // poker has 64 deterministic policies, resulting in a 64-by-64 matrix.
+//
+// Rows are independent, so when num_threads > 1 the payoff fill is sharded
+// across that many workers; the result is identical to the serial one.
 std::shared_ptr<const matrix_game::MatrixGame> ExtensiveToMatrixGame(
-    const Game& game);
+    const Game& game, int num_threads = 1);
+
+// Streams the same payoff matrix into an mmap-backed file instead of RAM, for
+// games whose matrix does not fit in memory. The file holds two int64 header
+// fields (num_rows, num_cols) followed by the row player's utilities and then
+// the column player's, both as row-major double arrays; policy names are not
+// stored. Workers write their rows in place through the mapping, so resident
+// memory is bounded by the pages being touched rather than the matrix size.
+void ExtensiveToMatrixPayoffsFile(const Game& game, const std::string& filename,
+                                  int num_threads = 1);
 
 }  // namespace algorithms
 }  // namespace open_spiel
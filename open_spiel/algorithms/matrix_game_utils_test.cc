@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/matrix_game_utils.h"
 
+#include <cstdio>
+#include <random>
+
 #include "open_spiel/games/kuhn_poker.h"
 
 namespace open_spiel {
@@ -46,6 +49,126 @@ void ExtensiveToMatrixGameTest() {
   SPIEL_CHECK_EQ(kuhn_matrix_game->NumCols(), 64);
 }
 
+// The parallel fill shards rows across workers but must produce exactly the
+// serial matrix.
+void ParallelExtensiveToMatrixGameTest() {
+  std::shared_ptr<const Game> kuhn_game = LoadGame("kuhn_poker");
+  std::shared_ptr<const matrix_game::MatrixGame> serial =
+      ExtensiveToMatrixGame(*kuhn_game);
+  std::shared_ptr<const matrix_game::MatrixGame> parallel =
+      ExtensiveToMatrixGame(*kuhn_game, /*num_threads=*/3);
+  SPIEL_CHECK_EQ(serial->NumRows(), parallel->NumRows());
+  SPIEL_CHECK_EQ(serial->NumCols(), parallel->NumCols());
+  for (int r = 0; r < serial->NumRows(); ++r) {
+    SPIEL_CHECK_EQ(serial->RowActionName(r), parallel->RowActionName(r));
+    for (int c = 0; c < serial->NumCols(); ++c) {
+      SPIEL_CHECK_EQ(serial->RowUtility(r, c), parallel->RowUtility(r, c));
+      SPIEL_CHECK_EQ(serial->ColUtility(r, c), parallel->ColUtility(r, c));
+    }
+  }
+}
+
+// The streamed payoff file must hold the same matrix the in-memory
+// conversion builds.
+void ExtensiveToMatrixPayoffsFileTest() {
+  std::shared_ptr<const Game> kuhn_game = LoadGame("kuhn_poker");
+  std::shared_ptr<const matrix_game::MatrixGame> expected =
+      ExtensiveToMatrixGame(*kuhn_game);
+  const std::string filename =
+      "/tmp/open_spiel_matrix_game_utils_test_payoffs.bin";
+  ExtensiveToMatrixPayoffsFile(*kuhn_game, filename, /*num_threads=*/2);
+
+  std::FILE* file = std::fopen(filename.c_str(), "rb");
+  SPIEL_CHECK_TRUE(file != nullptr);
+  int64_t dims[2];
+  SPIEL_CHECK_EQ(std::fread(dims, sizeof(int64_t), 2, file), 2);
+  SPIEL_CHECK_EQ(dims[0], expected->NumRows());
+  SPIEL_CHECK_EQ(dims[1], expected->NumCols());
+  const int64_t num_entries = dims[0] * dims[1];
+  std::vector<double> row_payoffs(num_entries);
+  std::vector<double> col_payoffs(num_entries);
+  SPIEL_CHECK_EQ(
+      std::fread(row_payoffs.data(), sizeof(double), num_entries, file),
+      num_entries);
+  SPIEL_CHECK_EQ(
+      std::fread(col_payoffs.data(), sizeof(double), num_entries, file),
+      num_entries);
+  std::fclose(file);
+  for (int r = 0; r < dims[0]; ++r) {
+    for (int c = 0; c < dims[1]; ++c) {
+      SPIEL_CHECK_EQ(row_payoffs[r * dims[1] + c], expected->RowUtility(r, c));
+      SPIEL_CHECK_EQ(col_payoffs[r * dims[1] + c], expected->ColUtility(r, c));
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+// The vectorized expected-utility kernels must agree with naive scalar sums
+// over PlayerUtility.
+void ExpectedUtilityKernelsTest() {
+  std::shared_ptr<const Game> blotto = LoadGame("blotto");
+  std::shared_ptr<const matrix_game::MatrixGame> matrix =
+      AsMatrixGame(blotto.get());
+  const int num_rows = matrix->NumRows();
+  const int num_cols = matrix->NumCols();
+
+  // Random mixed strategies.
+  std::mt19937 rng(297363);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<double> row_strategy(num_rows);
+  std::vector<double> col_strategy(num_cols);
+  double row_sum = 0;
+  double col_sum = 0;
+  for (double& prob : row_strategy) row_sum += (prob = dist(rng));
+  for (double& prob : col_strategy) col_sum += (prob = dist(rng));
+  for (double& prob : row_strategy) prob /= row_sum;
+  for (double& prob : col_strategy) prob /= col_sum;
+
+  for (Player player : {Player{0}, Player{1}}) {
+    double expected = 0;
+    for (int r = 0; r < num_rows; ++r) {
+      for (int c = 0; c < num_cols; ++c) {
+        expected += row_strategy[r] * col_strategy[c] *
+                    matrix->PlayerUtility(player, r, c);
+      }
+    }
+    SPIEL_CHECK_FLOAT_NEAR(
+        matrix->ExpectedUtility(player, row_strategy, col_strategy), expected,
+        1e-10);
+  }
+
+  std::vector<double> utilities;
+  matrix->BestResponseUtilities(matrix_game::kRowPlayer, col_strategy,
+                                &utilities);
+  SPIEL_CHECK_EQ(utilities.size(), num_rows);
+  for (int r = 0; r < num_rows; ++r) {
+    double expected = 0;
+    for (int c = 0; c < num_cols; ++c) {
+      expected += col_strategy[c] * matrix->RowUtility(r, c);
+    }
+    SPIEL_CHECK_FLOAT_NEAR(utilities[r], expected, 1e-10);
+  }
+
+  matrix->BestResponseUtilities(matrix_game::kColPlayer, row_strategy,
+                                &utilities);
+  SPIEL_CHECK_EQ(utilities.size(), num_cols);
+  double best_value = -std::numeric_limits<double>::infinity();
+  Action best_action = 0;
+  for (int c = 0; c < num_cols; ++c) {
+    double expected = 0;
+    for (int r = 0; r < num_rows; ++r) {
+      expected += row_strategy[r] * matrix->ColUtility(r, c);
+    }
+    SPIEL_CHECK_FLOAT_NEAR(utilities[c], expected, 1e-10);
+    if (expected > best_value) {
+      best_value = expected;
+      best_action = c;
+    }
+  }
+  SPIEL_CHECK_EQ(matrix->BestResponse(matrix_game::kColPlayer, row_strategy),
+                 best_action);
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -53,4 +176,7 @@ void ExtensiveToMatrixGameTest() {
 int main(int argc, char** argv) {
   open_spiel::algorithms::ConvertToMatrixGameTest();
   open_spiel::algorithms::ExtensiveToMatrixGameTest();
+  open_spiel::algorithms::ParallelExtensiveToMatrixGameTest();
+  open_spiel::algorithms::ExtensiveToMatrixPayoffsFileTest();
+  open_spiel::algorithms::ExpectedUtilityKernelsTest();
 }
@@ -15,10 +15,13 @@
 #include "open_spiel/algorithms/mcts.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <map>
 #include <memory>
 #include <random>
+#include <thread>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
@@ -39,21 +42,34 @@ constexpr inline int VectorMemory(const std::vector<T>& vec) {
   return sizeof(T) * vec.capacity();
 }
 
+std::vector<std::vector<double>> Evaluator::EvaluateBatch(
+    const std::vector<const State*>& states) const {
+  std::vector<std::vector<double>> values;
+  values.reserve(states.size());
+  for (const State* state : states) {
+    values.push_back(evaluate(*state));
+  }
+  return values;
+}
+
 std::vector<double> RandomRolloutEvaluator::evaluate(const State& state) const {
+  SplittableRandom rng(0);
+  {
+    std::lock_guard<std::mutex> lock(rng_mutex_);
+    rng = rng_.Split();
+  }
   std::vector<double> result;
   for (int i = 0; i < n_rollouts_; ++i) {
     std::unique_ptr<State> working_state = state.Clone();
     while (!working_state->IsTerminal()) {
+      // Rollouts are the inner loop, so use the states' sampling fast
+      // paths, which need no per-step action or outcome lists.
       if (working_state->IsChanceNode()) {
-        ActionsAndProbs outcomes = working_state->ChanceOutcomes();
-        Action action = SampleChanceOutcome(
-            outcomes, std::uniform_real_distribution<double>(0.0, 1.0)(rng_));
-        working_state->ApplyAction(action);
+        working_state->ApplyAction(
+            working_state->SampleChanceOutcome(rng.NextDouble()).first);
       } else {
-        std::vector<Action> actions = working_state->LegalActions();
-        absl::uniform_int_distribution<int> dist(0, actions.size() - 1);
-        int index = dist(rng_);
-        working_state->ApplyAction(actions[index]);
+        working_state->ApplyAction(
+            working_state->SampleLegalAction(rng.NextDouble()));
       }
     }
 
@@ -88,13 +104,15 @@ ActionsAndProbs RandomRolloutEvaluator::Prior(const State& state) const {
   }
 }
 
-double SearchNode::Value(int parent_explore_count, double uct_c) const {
+double SearchNode::Value(int parent_explore_count, double uct_c,
+                         double first_play_urgency) const {
   // Returns the PUCT value of this node.
   if (!outcome.empty()) {
     return outcome[player];
   }
 
-  return ((explore_count != 0 ? total_reward / explore_count : 0) +
+  return ((explore_count != 0 ? total_reward / explore_count
+                              : first_play_urgency) +
           uct_c * prior * std::sqrt(parent_explore_count) /
           (explore_count + 1));
 }
@@ -111,7 +129,7 @@ bool SearchNode::CompareFinal(const SearchNode& b) const {
   return total_reward < b.total_reward;
 }
 
-const SearchNode& SearchNode::BestChild() const {
+const SearchNode& SearchNode::BestChild(const SearchNodePool& pool) const {
   // Returns the best action from this node, either proven or most visited.
   //
   // This ordering leads to choosing:
@@ -123,19 +141,29 @@ const SearchNode& SearchNode::BestChild() const {
   // - Hardest loss if everything is a loss
   // - Highest expected reward if explore counts are equal (unlikely).
   // - Longest win, if multiple are proven (unlikely due to early stopping).
-  return *std::max_element(
-      children.begin(), children.end(),
-      [](const SearchNode& a, const SearchNode& b) {
-          return a.CompareFinal(b); });
+  int best_index = first_child;
+  for (int idx = first_child + 1; idx < first_child + num_children; ++idx) {
+    // Compare the nodes carrying the statistics, but keep the edge (and its
+    // action) for the returned child.
+    if (pool[pool.Canonical(best_index)].CompareFinal(
+            pool[pool.Canonical(idx)])) {
+      best_index = idx;
+    }
+  }
+  return pool[best_index];
 }
 
-std::string SearchNode::ChildrenStr(const State& state) const {
+std::string SearchNode::ChildrenStr(const State& state,
+                                    const SearchNodePool& pool) const {
+  if (num_children == 0 && tt_node >= 0) {
+    return pool[tt_node].ChildrenStr(state, pool);
+  }
   std::string out;
-  if (!children.empty()) {
+  if (num_children > 0) {
     std::vector<const SearchNode*> refs;  // Sort a list of refs, not a copy.
-    refs.reserve(children.size());
-    for (const SearchNode& child : children) {
-      refs.push_back(&child);
+    refs.reserve(num_children);
+    for (int idx = first_child; idx < first_child + num_children; ++idx) {
+      refs.push_back(&pool[pool.Canonical(idx)]);
     }
     std::sort(refs.begin(), refs.end(),
               [](const SearchNode* a, const SearchNode* b) {
@@ -147,6 +175,44 @@ std::string SearchNode::ChildrenStr(const State& state) const {
   return out;
 }
 
+int SearchNodePool::CopySubtree(int index, SearchNodePool* dest,
+                                int min_explore_count) const {
+  const int new_root = dest->nodes_.size();
+  dest->nodes_.push_back(nodes_[Canonical(index)]);
+  dest->nodes_.back().tt_node = -1;
+  // Nodes still carrying child ranges into this pool, paired with their
+  // index in dest where the range gets rewritten.
+  std::vector<std::pair<int, int>> pending = {{Canonical(index), new_root}};
+  while (!pending.empty()) {
+    const auto [src, dst] = pending.back();
+    pending.pop_back();
+    const SearchNode& src_node = nodes_[src];
+    if (src_node.num_children == 0) continue;
+    if (src_node.explore_count < min_explore_count) {
+      // Drop the subtree: the copy becomes a leaf holding the aggregated
+      // statistics, expandable again by a later selection.
+      dest->nodes_[dst].first_child = -1;
+      dest->nodes_[dst].num_children = 0;
+      continue;
+    }
+    const int first_child = dest->nodes_.size();
+    for (int idx = src_node.first_child;
+         idx < src_node.first_child + src_node.num_children; ++idx) {
+      const int canonical = Canonical(idx);
+      dest->nodes_.push_back(nodes_[canonical]);
+      SearchNode& copy = dest->nodes_.back();
+      // Keep the edge's action and prior but the merged node's statistics.
+      copy.action = nodes_[idx].action;
+      copy.prior = nodes_[idx].prior;
+      copy.tt_node = -1;
+      pending.push_back({canonical, dest->nodes_.size() - 1});
+    }
+    dest->nodes_[dst].first_child = first_child;
+    dest->nodes_[dst].num_children = src_node.num_children;
+  }
+  return new_root;
+}
+
 std::string SearchNode::ToString(const State& state) const {
   return absl::StrFormat(
       "%6s: player: %d, prior: %5.3f, value: %6.3f, sims: %5d, outcome: %s, "
@@ -154,7 +220,7 @@ std::string SearchNode::ToString(const State& state) const {
       (action >= 0 ? state.ActionToString(player, action) : "none"), player,
       prior, (explore_count ? total_reward / explore_count : 0.), explore_count,
       (outcome.empty() ? "none" : absl::StrFormat("%4.1f", outcome[player])),
-      children.size());
+      num_children);
 }
 
 MCTSBot::MCTSBot(
@@ -166,7 +232,13 @@ MCTSBot::MCTSBot(
       int64_t max_memory_mb,
       bool solve,
       int seed,
-      bool verbose)
+      bool verbose,
+      int num_threads,
+      int batch_size,
+      bool use_transpositions,
+      bool reuse_tree,
+      bool recycle_when_full,
+      bool root_parallel)
       : Bot{game, player},
         uct_c_{uct_c},
         max_simulations_{max_simulations},
@@ -174,6 +246,13 @@ MCTSBot::MCTSBot(
         verbose_(verbose),
         solve_(solve),
         max_utility_(game.MaxUtility()),
+        min_utility_(game.MinUtility()),
+        num_threads_(num_threads),
+        batch_size_(batch_size),
+        use_transpositions_(use_transpositions),
+        reuse_tree_(reuse_tree),
+        recycle_when_full_(recycle_when_full),
+        root_parallel_(root_parallel),
         rng_(seed),
         evaluator_{evaluator} {
     GameType game_type = game.GetType();
@@ -181,12 +260,34 @@ MCTSBot::MCTSBot(
         game_type.dynamics != GameType::Dynamics::kSequential) {
       SpielFatalError("Game must have sequential turns and terminal rewards.");
     }
+    SPIEL_CHECK_GE(num_threads, 1);
+    SPIEL_CHECK_GE(batch_size, 1);
+    if (use_transpositions && !game.ProvidesHashValue()) {
+      SpielFatalError("use_transpositions requires a game with HashValue().");
+    }
+    if (num_threads > 1 && batch_size > 1 && !root_parallel) {
+      SpielFatalError(
+          "MCTSBot supports either tree-parallel search (num_threads > 1) or "
+          "batched evaluation (batch_size > 1), not both.");
+    }
+    if (root_parallel && reuse_tree) {
+      // The merged tree is one level deep, so there is no subtree to keep.
+      SpielFatalError("Tree reuse is not supported with root-parallel "
+                      "search; the workers' trees are discarded after the "
+                      "merge.");
+    }
+    if (recycle_when_full && num_threads > 1 && !root_parallel) {
+      // Recycling rewrites the node pool, invalidating the visit paths other
+      // workers hold while evaluating outside the tree lock.
+      SpielFatalError(
+          "Node recycling is not supported with tree-parallel search.");
+    }
   }
 
 std::pair<ActionsAndProbs, Action> MCTSBot::Step(const State& state) {
   absl::Time start = absl::Now();
-  std::unique_ptr<SearchNode> root = MCTSearch(state);
-  const SearchNode& best = root->BestChild();
+  SearchNode* root = MCTSearch(state);
+  const SearchNode& best = root->BestChild(node_pool_);
 
   if (verbose_) {
     double seconds = absl::ToDoubleSeconds(absl::Now() - start);
@@ -197,155 +298,667 @@ std::pair<ActionsAndProbs, Action> MCTSBot::Step(const State& state) {
     std::cerr << "Root:" << std::endl;
     std::cerr << root->ToString(state) << std::endl;
     std::cerr << "Children:" << std::endl;
-    std::cerr << root->ChildrenStr(state) << std::endl;
+    std::cerr << root->ChildrenStr(state, node_pool_) << std::endl;
     std::unique_ptr<State> chosen_state = state.Clone();
     chosen_state->ApplyAction(best.action);
     std::cerr << std::endl;
     std::cerr << "Children of chosen:" << std::endl;
-    std::cerr << best.ChildrenStr(*chosen_state) << std::endl;
+    std::cerr << best.ChildrenStr(*chosen_state, node_pool_) << std::endl;
+  }
+
+  if (reuse_tree_) {
+    // Retain the chosen child's subtree; the next search advances it along
+    // the actions observed since, and starts from its statistics.
+    reuse_root_ = node_pool_.Canonical(node_pool_.IndexOf(&best));
+    reuse_history_ = state.History();
+    reuse_history_.push_back(best.action);
   }
 
   return {{{best.action, 1.0}}, best.action};
 }
 
+MCTSBot::~MCTSBot() { StopPonder(); }
+
+int64_t MCTSBot::TreeMemoryBytes() const {
+  int64_t bytes = node_pool_.MemoryBytes();
+  stats::SetGauge(stats::kMctsTreeBytes, bytes);
+  return bytes;
+}
+
+void MCTSBot::Restart(const State& state) {
+  StopPonder();
+  reuse_root_ = -1;
+  reuse_history_.clear();
+  carryover_seconds_ = 0;
+}
+
+void MCTSBot::StartPonder(const State& state) {
+  if (!reuse_tree_) {
+    SpielFatalError("Pondering requires reuse_tree=true; the pondered tree "
+                    "is handed to the next search as the retained subtree.");
+  }
+  StopPonder();
+  ponder_stop_ = false;
+  pondering_ = true;
+  ponder_state_ = state.Clone();
+  ponder_thread_ = std::thread([this]() { PonderSearch(*ponder_state_); });
+}
+
+void MCTSBot::StopPonder() {
+  if (!pondering_) return;
+  ponder_stop_ = true;
+  ponder_thread_.join();
+  pondering_ = false;
+}
+
+void MCTSBot::PonderSearch(const State& state) {
+  int root_index = -1;
+  if (reuse_root_ >= 0) {
+    root_index = AdvanceRetainedTree(state);
+    reuse_root_ = -1;
+  }
+  if (root_index < 0) {
+    memory_used_ = 0;
+    node_pool_.Clear();
+    transposition_table_.clear();
+    root_index = node_pool_.Add(-1, state.CurrentPlayer(), 1);
+  }
+
+  std::vector<int> visit_path;
+  std::vector<double> returns;
+  visit_path.reserve(64);
+  while (!ponder_stop_.load(std::memory_order_relaxed)) {
+    visit_path.clear();
+    returns.clear();
+
+    std::unique_ptr<State> working_state =
+        ApplyTreePolicy(root_index, state, &visit_path);
+
+    bool solved;
+    if (working_state->IsTerminal()) {
+      returns = working_state->Returns();
+      node_pool_[visit_path[visit_path.size() - 1]].outcome = returns;
+      memory_used_ += VectorMemory(returns);
+      solved = solve_;
+    } else {
+      returns = evaluator_.evaluate(*working_state);
+      solved = false;
+    }
+    BackupPath(visit_path, returns, &solved, /*revert_virtual_loss=*/false);
+
+    if (!node_pool_[root_index].outcome.empty()) break;  // Tree is solved.
+    if (max_memory_ && memory_used_ >= max_memory_) {
+      if (!recycle_when_full_) break;
+      root_index = RecycleTree(root_index);
+      if (memory_used_ >= max_memory_) break;
+    }
+  }
+
+  // Park the tree for the next search to advance into.
+  reuse_root_ = root_index;
+  reuse_history_ = state.History();
+}
+
+bool MCTSBot::OutOfTime() const {
+  return search_budget_ > 0 &&
+         absl::ToDoubleSeconds(absl::Now() - search_start_) >= search_budget_;
+}
+
+int MCTSBot::WidenedChildCount(const SearchNode& node) const {
+  if (selection_policy_.widening_c <= 0) return node.num_children;
+  const int width = static_cast<int>(
+      std::ceil(selection_policy_.widening_c *
+                std::pow(node.explore_count, selection_policy_.widening_alpha)));
+  return std::min(node.num_children, std::max(1, width));
+}
+
+bool MCTSBot::BestChildDecided(int root_index, int simulations_done) const {
+  const SearchNode& root = node_pool_[root_index];
+  if (root.num_children == 0) return false;
+  if (root.num_children == 1) return true;  // Nothing to overtake.
+  int best = 0;
+  int second = 0;
+  for (int i = 0; i < root.num_children; ++i) {
+    const int count =
+        node_pool_[node_pool_.Canonical(root.first_child + i)].explore_count;
+    if (count > best) {
+      second = best;
+      best = count;
+    } else if (count > second) {
+      second = count;
+    }
+  }
+  double remaining = max_simulations_ - simulations_done;
+  if (search_budget_ > 0) {
+    const double elapsed = absl::ToDoubleSeconds(absl::Now() - search_start_);
+    if (elapsed > 0 && elapsed < search_budget_) {
+      // The clock may cut the simulation cap short; estimate how many more
+      // simulations fit from the rate achieved so far.
+      remaining = std::min(
+          remaining, (search_budget_ - elapsed) * (simulations_done / elapsed));
+    }
+  }
+  return best - second > remaining;
+}
+
 std::unique_ptr<State> MCTSBot::ApplyTreePolicy(
-    SearchNode* root, const State& state,
-    std::vector<SearchNode*>* visit_path) {
-  visit_path->push_back(root);
+    int root_index, const State& state,
+    std::vector<int>* visit_path) {
+  visit_path->push_back(root_index);
   std::unique_ptr<State> working_state = state.Clone();
-  SearchNode* current_node = root;
-  while (!working_state->IsTerminal() && current_node->explore_count > 0) {
-    if (current_node->children.empty()) {
+  int current_index = root_index;
+  while (!working_state->IsTerminal() &&
+         node_pool_[current_index].explore_count > 0) {
+    if (node_pool_[current_index].num_children == 0) {
       // For a new node, initialize its state, then choose a child as normal.
       ActionsAndProbs legal_actions = evaluator_.Prior(*working_state);
       // Reduce bias from move generation order.
       std::shuffle(legal_actions.begin(), legal_actions.end(), rng_);
+      if (selection_policy_.widening_c > 0) {
+        // Progressive widening admits children in pool order, so put the
+        // highest priors first (the shuffle above still breaks ties).
+        std::stable_sort(legal_actions.begin(), legal_actions.end(),
+                         [](const std::pair<Action, double>& a,
+                            const std::pair<Action, double>& b) {
+                           return a.second > b.second;
+                         });
+      }
       Player player = working_state->CurrentPlayer();
-      current_node->children.reserve(legal_actions.size());
+      // The children become one consecutive pool range; adding them can grow
+      // the pool, so the parent is re-resolved afterwards.
+      const int first_child = node_pool_.size();
       for (auto [action, prior] : legal_actions) {
-        current_node->children.emplace_back(action, player, prior);
+        node_pool_.Add(action, player, prior);
       }
-      memory_used_ += VectorMemory(legal_actions);
+      SearchNode& expanded = node_pool_[current_index];
+      expanded.first_child = first_child;
+      expanded.num_children = legal_actions.size();
+      memory_used_ += sizeof(SearchNode) * legal_actions.size();
+      SPIEL_STATS_INCREMENT(kMctsExpansions);
     }
 
-    SearchNode* chosen_child = nullptr;
+    SearchNode& current_node = node_pool_[current_index];
+    const int width = WidenedChildCount(current_node);
+    int chosen_index = -1;
     if (working_state->IsChanceNode()) {
-      // For chance nodes, rollout according to chance node's probability
-      // distribution
-      ActionsAndProbs outcomes = working_state->ChanceOutcomes();
-
-      double rand = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
-      int index = 0;
-      for (double sum = 0; sum < rand; ++index) {
-        sum += outcomes[index].second;
-      }
-      Action chosen_action = outcomes[index].first;
-
-      for (SearchNode& child : current_node->children) {
-        if (child.action == chosen_action) {
-          chosen_child = &child;
-          break;
+      if (width < current_node.num_children) {
+        // Widened: sample among the most likely outcomes only, using the
+        // child priors (the chance probabilities), renormalized.
+        double total = 0;
+        for (int idx = current_node.first_child;
+             idx < current_node.first_child + width; ++idx) {
+          total += node_pool_[idx].prior;
+        }
+        double rand = rng_.NextDouble() * total;
+        chosen_index = current_node.first_child;
+        for (double sum = node_pool_[chosen_index].prior;
+             sum < rand && chosen_index + 1 < current_node.first_child + width;
+             sum += node_pool_[chosen_index].prior) {
+          ++chosen_index;
+        }
+      } else {
+        // For chance nodes, rollout according to chance node's probability
+        // distribution. Games with a closed-form distribution sample without
+        // materializing the ChanceOutcomes() vector.
+        Action chosen_action =
+            working_state->SampleChanceOutcome(rng_.NextDouble()).first;
+
+        for (int idx = current_node.first_child;
+             idx < current_node.first_child + current_node.num_children;
+             ++idx) {
+          if (node_pool_[idx].action == chosen_action) {
+            chosen_index = idx;
+            break;
+          }
         }
       }
     } else {
-      // Otherwise choose node with largest UCT value.
+      // Otherwise choose node with largest UCT value, reading the shared
+      // statistics when the child was merged with a transposition.
       double max_value = -std::numeric_limits<double>::infinity();
-      for (SearchNode& child : current_node->children) {
-        double val = child.Value(current_node->explore_count, uct_c_);
+      for (int idx = current_node.first_child;
+           idx < current_node.first_child + width; ++idx) {
+        double val = node_pool_[node_pool_.Canonical(idx)].Value(
+            current_node.explore_count, uct_c_,
+            selection_policy_.first_play_urgency);
         if (val > max_value) {
           max_value = val;
-          chosen_child = &child;
+          chosen_index = idx;
         }
       }
     }
 
-    working_state->ApplyAction(chosen_child->action);
-    current_node = chosen_child;
-    visit_path->push_back(current_node);
+    working_state->ApplyAction(node_pool_[chosen_index].action);
+    current_index = node_pool_.Canonical(chosen_index);
+    visit_path->push_back(current_index);
+  }
+
+  if (use_transpositions_) {
+    // Register new leaves; a leaf whose position was seen before is merged
+    // into the earlier node so both move orders share its statistics and
+    // subtree, and neither expands or evaluates the position again.
+    const int leaf = visit_path->back();
+    SearchNode& leaf_node = node_pool_[leaf];
+    if (leaf_node.explore_count == 0 && leaf_node.tt_node < 0) {
+      auto insert =
+          transposition_table_.insert({working_state->HashValue(), leaf});
+      if (!insert.second && insert.first->second != leaf) {
+        leaf_node.tt_node = insert.first->second;
+        visit_path->back() = insert.first->second;
+      }
+    }
   }
 
   return working_state;
 }
 
-std::unique_ptr<SearchNode> MCTSBot::MCTSearch(const State& state) {
-  memory_used_ = 0;
-  auto root = std::make_unique<SearchNode>(-1, state.CurrentPlayer(), 1);
-  std::vector<SearchNode*> visit_path;
-  std::vector<double> returns;
-  visit_path.reserve(64);
-  for (int i = 0; i < max_simulations_; ++i) {
-    visit_path.clear();
-    returns.clear();
-
-    std::unique_ptr<State> working_state = ApplyTreePolicy(
-        root.get(), state, &visit_path);
+void MCTSBot::BackupPath(const std::vector<int>& visit_path,
+                         const std::vector<double>& returns, bool* solved,
+                         bool revert_virtual_loss) {
+  for (auto it = visit_path.rbegin(); it != visit_path.rend(); ++it) {
+    SearchNode* node = &node_pool_[*it];
 
-    bool solved;
-    if (working_state->IsTerminal()) {
-      returns = working_state->Returns();
-      visit_path[visit_path.size() - 1]->outcome = returns;
-      memory_used_ += VectorMemory(returns);
-      solved = solve_;
+    if (revert_virtual_loss) {
+      // The explore count was incremented and a virtual loss added when this
+      // path was selected; only the reward correction remains.
+      node->total_reward += returns[node->player] - min_utility_;
     } else {
-      returns = evaluator_.evaluate(*working_state);
-      solved = false;
-    }
-
-    // Propagate values back.
-    for (auto it = visit_path.rbegin(); it != visit_path.rend(); ++it) {
-      SearchNode* node = *it;
-
       node->total_reward += returns[node->player];
       node->explore_count += 1;
+    }
 
-      // Back up solved results as well.
-      if (solved && !node->children.empty()) {
-        Player player = node->children[0].player;
-        if (player == kChancePlayerId) {
-          // Only back up chance nodes if all have the same outcome.
-          // An alternative would be to back up the weighted average of
-          // outcomes if all children are solved, but that is less clear.
-          const std::vector<double>& outcome = node->children[0].outcome;
-          if (!outcome.empty() &&
-              std::all_of(node->children.begin() + 1, node->children.end(),
-                          [&outcome](const SearchNode& c) {
-                            return c.outcome == outcome; })) {
-            node->outcome = outcome;
-            memory_used_ += VectorMemory(node->outcome);
-          } else {
-            solved = false;
+    // Back up solved results as well.
+    if (*solved && node->num_children > 0) {
+      const int begin = node->first_child;
+      const int end = node->first_child + node->num_children;
+      Player player = node_pool_[begin].player;
+      if (player == kChancePlayerId) {
+        // Only back up chance nodes if all have the same outcome.
+        // An alternative would be to back up the weighted average of
+        // outcomes if all children are solved, but that is less clear.
+        const std::vector<double>& outcome =
+            node_pool_[node_pool_.Canonical(begin)].outcome;
+        bool all_same = !outcome.empty();
+        for (int idx = begin + 1; all_same && idx < end; ++idx) {
+          all_same = (node_pool_[node_pool_.Canonical(idx)].outcome == outcome);
+        }
+        if (all_same) {
+          node->outcome = outcome;
+          memory_used_ += VectorMemory(node->outcome);
+        } else {
+          *solved = false;
+        }
+      } else {
+        // If any have max utility (won?), or all children are solved,
+        // choose the one best for the player choosing.
+        const SearchNode* best = nullptr;
+        bool all_solved = true;
+        for (int idx = begin; idx < end; ++idx) {
+          const SearchNode& child = node_pool_[node_pool_.Canonical(idx)];
+          if (child.outcome.empty()) {
+            all_solved = false;
+          } else if (best == nullptr ||
+                     child.outcome[player] > best->outcome[player]) {
+            best = &child;
           }
+        }
+        if (best != nullptr &&
+            (all_solved || best->outcome[player] == max_utility_)) {
+          node->outcome = best->outcome;
+          memory_used_ += VectorMemory(node->outcome);
+        } else {
+          *solved = false;
+        }
+      }
+    }
+  }
+}
+
+void MCTSBot::ParallelMCTSearch(int root_index, const State& state) {
+  std::atomic<int> num_simulations(0);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    threads.emplace_back([this, root_index, &state, &num_simulations, &stop]() {
+      std::vector<int> visit_path;
+      std::vector<double> returns;
+      visit_path.reserve(64);
+      while (!stop && num_simulations.fetch_add(1) < max_simulations_) {
+        visit_path.clear();
+        returns.clear();
+
+        std::unique_ptr<State> working_state;
+        {
+          std::lock_guard<std::mutex> lock(tree_mutex_);
+          working_state = ApplyTreePolicy(root_index, state, &visit_path);
+          // Virtual loss: make the selected path look visited and losing so
+          // concurrent workers pick different leaves.
+          for (int node_index : visit_path) {
+            node_pool_[node_index].explore_count += 1;
+            node_pool_[node_index].total_reward += min_utility_;
+          }
+        }
+
+        bool solved;
+        if (working_state->IsTerminal()) {
+          returns = working_state->Returns();
+          solved = solve_;
         } else {
-          // If any have max utility (won?), or all children are solved,
-          // choose the one best for the player choosing.
-          const SearchNode* best = nullptr;
-          bool all_solved = true;
-          for (const SearchNode& child : node->children) {
-            if (child.outcome.empty()) {
-              all_solved = false;
-            } else if (best == nullptr ||
-                       child.outcome[player] > best->outcome[player]) {
-              best = &child;
-            }
+          returns = evaluator_.evaluate(*working_state);
+          solved = false;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(tree_mutex_);
+          if (working_state->IsTerminal()) {
+            node_pool_[visit_path[visit_path.size() - 1]].outcome = returns;
+            memory_used_ += VectorMemory(returns);
           }
-          if (best != nullptr &&
-              (all_solved || best->outcome[player] == max_utility_)) {
-            node->outcome = best->outcome;
-            memory_used_ += VectorMemory(node->outcome);
-          } else {
-            solved = false;
+          BackupPath(visit_path, returns, &solved,
+                     /*revert_virtual_loss=*/true);
+          if (!node_pool_[root_index].outcome.empty() ||  // Tree is solved.
+              (max_memory_ && memory_used_ >= max_memory_) || OutOfTime() ||
+              (time_control_.early_stop &&
+               BestChildDecided(root_index, num_simulations.load()))) {
+            stop = true;
           }
         }
       }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
+int MCTSBot::BatchedMCTSearch(int root_index, const State& state) {
+  std::vector<std::vector<int>> batch_paths;
+  std::vector<std::unique_ptr<State>> batch_states;
+  std::vector<const State*> batch_state_ptrs;
+  std::vector<int> visit_path;
+  std::vector<double> returns;
+  visit_path.reserve(64);
+
+  int simulations = 0;
+  bool stop = false;
+  while (!stop && simulations < max_simulations_) {
+    batch_paths.clear();
+    batch_states.clear();
+    batch_state_ptrs.clear();
+
+    // Collect a batch of unevaluated leaves. Terminal leaves are backed up
+    // on the spot; for the rest a virtual loss steers later selections in
+    // this batch towards different leaves.
+    while (batch_paths.size() < batch_size_ && simulations < max_simulations_) {
+      ++simulations;
+      visit_path.clear();
+      std::unique_ptr<State> working_state =
+          ApplyTreePolicy(root_index, state, &visit_path);
+
+      if (working_state->IsTerminal()) {
+        returns = working_state->Returns();
+        node_pool_[visit_path[visit_path.size() - 1]].outcome = returns;
+        memory_used_ += VectorMemory(returns);
+        bool solved = solve_;
+        BackupPath(visit_path, returns, &solved, /*revert_virtual_loss=*/false);
+      } else {
+        for (int node_index : visit_path) {
+          node_pool_[node_index].explore_count += 1;
+          node_pool_[node_index].total_reward += min_utility_;
+        }
+        batch_paths.push_back(visit_path);
+        batch_states.push_back(std::move(working_state));
+        batch_state_ptrs.push_back(batch_states.back().get());
+      }
+
+      if (!node_pool_[root_index].outcome.empty()) {
+        stop = true;
+        break;
+      }
+      if (max_memory_ && memory_used_ >= max_memory_) {
+        // Flush the collected batch; recycling (if enabled) happens once
+        // its paths have been backed up and no longer index the pool.
+        if (!recycle_when_full_) stop = true;
+        break;
+      }
+    }
+
+    if (!batch_state_ptrs.empty()) {
+      std::vector<std::vector<double>> values =
+          evaluator_.EvaluateBatch(batch_state_ptrs);
+      SPIEL_CHECK_EQ(values.size(), batch_paths.size());
+      for (int b = 0; b < batch_paths.size(); ++b) {
+        bool solved = false;
+        BackupPath(batch_paths[b], values[b], &solved,
+                   /*revert_virtual_loss=*/true);
+      }
+    }
+
+    if (recycle_when_full_ && max_memory_ && memory_used_ >= max_memory_) {
+      root_index = RecycleTree(root_index);
+      if (memory_used_ >= max_memory_) stop = true;
     }
 
-    if (!root->outcome.empty() ||  // Full game tree is solved.
-        (max_memory_ && memory_used_ >= max_memory_)) {
-      break;
+    // Budgets are checked at batch boundaries, once the virtual losses on
+    // the collected paths have been reverted.
+    if (OutOfTime() ||
+        (time_control_.early_stop &&
+         BestChildDecided(root_index, simulations))) {
+      stop = true;
     }
   }
+  return root_index;
+}
+
+int MCTSBot::AdvanceRetainedTree(const State& state) {
+  const std::vector<Action> history = state.History();
+  if (history.size() < reuse_history_.size() ||
+      !std::equal(reuse_history_.begin(), reuse_history_.end(),
+                  history.begin())) {
+    return -1;
+  }
+  int index = reuse_root_;
+  for (int i = reuse_history_.size(); i < history.size(); ++i) {
+    const SearchNode& node = node_pool_[index];
+    int next = -1;
+    for (int idx = node.first_child;
+         idx < node.first_child + node.num_children; ++idx) {
+      if (node_pool_[idx].action == history[i]) {
+        next = node_pool_.Canonical(idx);
+        break;
+      }
+    }
+    if (next < 0 || node_pool_[next].explore_count == 0) return -1;
+    index = next;
+  }
+  // Compact the kept subtree into a fresh pool, releasing the rest of the
+  // old tree. The transposition table indexes the old pool, so the new
+  // search starts with an empty one.
+  SearchNodePool compacted;
+  const int new_root = node_pool_.CopySubtree(index, &compacted);
+  node_pool_ = std::move(compacted);
+  transposition_table_.clear();
+  memory_used_ = sizeof(SearchNode) * node_pool_.size();
+  return new_root;
+}
+
+int MCTSBot::RecycleTree(int root_index) {
+  // The cut is the median explore count of the interior nodes, so one pass
+  // frees roughly half of the tree, from its least-visited regions.
+  std::vector<int> counts;
+  counts.reserve(node_pool_.size());
+  for (int i = 0; i < node_pool_.size(); ++i) {
+    if (node_pool_[i].num_children > 0) {
+      counts.push_back(node_pool_[i].explore_count);
+    }
+  }
+  if (counts.empty()) return root_index;
+  std::nth_element(counts.begin(), counts.begin() + counts.size() / 2,
+                   counts.end());
+  const int threshold = counts[counts.size() / 2];
+
+  SearchNodePool compacted;
+  const int new_root = node_pool_.CopySubtree(root_index, &compacted,
+                                              /*min_explore_count=*/threshold);
+  node_pool_ = std::move(compacted);
+  transposition_table_.clear();  // It indexes the old pool.
+  memory_used_ = sizeof(SearchNode) * node_pool_.size();
+  for (int i = 0; i < node_pool_.size(); ++i) {
+    memory_used_ += VectorMemory(node_pool_[i].outcome);
+  }
+  return new_root;
+}
+
+SearchNode* MCTSBot::RootParallelMCTSearch(const State& state) {
+  if (root_workers_.empty()) {
+    root_workers_.reserve(num_threads_);
+    for (int t = 0; t < num_threads_; ++t) {
+      root_workers_.push_back(std::make_unique<MCTSBot>(
+          game_, player_, evaluator_, uct_c_, max_simulations_,
+          max_memory_ >> 20, solve_,
+          /*seed=*/static_cast<int>(rng_.NextUInt64() >> 33),
+          /*verbose=*/false, /*num_threads=*/1, batch_size_,
+          use_transpositions_, /*reuse_tree=*/false, recycle_when_full_));
+      root_workers_.back()->SetTimeControl(time_control_);
+      root_workers_.back()->SetSelectionPolicy(selection_policy_);
+    }
+  }
+
+  std::vector<SearchNode*> roots(num_threads_);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    threads.emplace_back([this, t, &state, &roots]() {
+      roots[t] = root_workers_[t]->MCTSearch(state);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  // Collapse the worker trees into per-action totals. Child order differs
+  // per tree (expansion shuffles), so the merge matches on the action.
+  std::map<Action, SearchNode> merged;
+  int root_explore_count = 0;
+  double root_total_reward = 0;
+  std::vector<double> root_outcome;
+  for (int t = 0; t < num_threads_; ++t) {
+    MCTSBot& worker = *root_workers_[t];
+    const SearchNode& worker_root = *roots[t];
+    root_explore_count += worker_root.explore_count;
+    root_total_reward += worker_root.total_reward;
+    if (root_outcome.empty()) root_outcome = worker_root.outcome;
+    for (int i = 0; i < worker_root.num_children; ++i) {
+      const SearchNode& child = worker.node_pool_[
+          worker.node_pool_.Canonical(worker_root.first_child + i)];
+      auto [it, inserted] = merged.try_emplace(
+          child.action, child.action, child.player, child.prior);
+      it->second.explore_count += child.explore_count;
+      it->second.total_reward += child.total_reward;
+      if (it->second.outcome.empty()) it->second.outcome = child.outcome;
+    }
+  }
+
+  // Rebuild our pool as the merged one-level tree: the root, then one child
+  // per action carrying the summed statistics.
+  node_pool_.Clear();
+  transposition_table_.clear();
+  const int root_index = node_pool_.Add(-1, state.CurrentPlayer(), 1);
+  const int first_child = node_pool_.size();
+  for (auto& [action, child] : merged) {
+    const int idx = node_pool_.Add(child.action, child.player, child.prior);
+    node_pool_[idx].explore_count = child.explore_count;
+    node_pool_[idx].total_reward = child.total_reward;
+    node_pool_[idx].outcome = std::move(child.outcome);
+  }
+  SearchNode& merged_root = node_pool_[root_index];
+  merged_root.first_child = first_child;
+  merged_root.num_children = merged.size();
+  merged_root.explore_count = root_explore_count;
+  merged_root.total_reward = root_total_reward;
+  merged_root.outcome = std::move(root_outcome);
+
+  memory_used_ = sizeof(SearchNode) * node_pool_.size();
+  for (int i = 0; i < node_pool_.size(); ++i) {
+    memory_used_ += VectorMemory(node_pool_[i].outcome);
+  }
+  return &node_pool_[root_index];
+}
+
+SearchNode* MCTSBot::MCTSearch(const State& state) {
+  StopPonder();  // No-op unless the caller left a ponder running.
+
+  if (root_parallel_ && num_threads_ > 1) {
+    // The workers enforce the time control and budgets themselves.
+    return RootParallelMCTSearch(state);
+  }
+
+  search_start_ = absl::Now();
+  search_budget_ = 0;
+  if (time_control_.seconds_per_move > 0) {
+    search_budget_ = time_control_.seconds_per_move + carryover_seconds_;
+  }
+
+  int root_index = -1;
+  if (reuse_tree_ && reuse_root_ >= 0) {
+    root_index = AdvanceRetainedTree(state);
+    reuse_root_ = -1;
+  }
+  if (root_index < 0) {
+    memory_used_ = 0;
+    node_pool_.Clear();
+    transposition_table_.clear();
+    root_index = node_pool_.Add(-1, state.CurrentPlayer(), 1);
+  }
+
+  if (num_threads_ > 1) {
+    ParallelMCTSearch(root_index, state);
+  } else if (batch_size_ > 1) {
+    root_index = BatchedMCTSearch(root_index, state);
+  } else {
+    std::vector<int> visit_path;
+    std::vector<double> returns;
+    visit_path.reserve(64);
+    for (int i = 0; i < max_simulations_; ++i) {
+      visit_path.clear();
+      returns.clear();
+
+      std::unique_ptr<State> working_state = ApplyTreePolicy(
+          root_index, state, &visit_path);
+
+      bool solved;
+      if (working_state->IsTerminal()) {
+        returns = working_state->Returns();
+        node_pool_[visit_path[visit_path.size() - 1]].outcome = returns;
+        memory_used_ += VectorMemory(returns);
+        solved = solve_;
+      } else {
+        returns = evaluator_.evaluate(*working_state);
+        solved = false;
+      }
+
+      // Propagate values back.
+      BackupPath(visit_path, returns, &solved, /*revert_virtual_loss=*/false);
+
+      if (!node_pool_[root_index].outcome.empty()) break;  // Tree is solved.
+      if (max_memory_ && memory_used_ >= max_memory_) {
+        if (!recycle_when_full_) break;
+        root_index = RecycleTree(root_index);
+        if (memory_used_ >= max_memory_) break;  // Recycling freed too little.
+      }
+      if (OutOfTime() ||
+          (time_control_.early_stop && BestChildDecided(root_index, i + 1))) {
+        break;
+      }
+    }
+  }
+
+  if (search_budget_ > 0) {
+    carryover_seconds_ =
+        time_control_.carryover
+            ? std::max(0.0, search_budget_ - absl::ToDoubleSeconds(
+                                                 absl::Now() - search_start_))
+            : 0.0;
+  }
 
-  return root;
+  return &node_pool_[root_index];
 }
 
 }  // namespace algorithms
@@ -15,9 +15,14 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <thread>
+#include <unordered_map>
 
+#include "open_spiel/abseil-cpp/absl/time/time.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
 
@@ -78,6 +83,13 @@ class Evaluator {
   // Return a value of this state for each player.
   virtual std::vector<double> evaluate(const State& state) const = 0;
 
+  // Return a value for each player, for each of the given states. The
+  // default implementation evaluates the states one at a time; evaluators
+  // with batch-efficient backends (e.g. a neural network on an accelerator)
+  // should override this to issue a single inference call.
+  virtual std::vector<std::vector<double>> EvaluateBatch(
+      const std::vector<const State*>& states) const;
+
   // Return a policy: the probability of the current player playing each action.
   virtual ActionsAndProbs Prior(const State& state) const = 0;
 };
@@ -90,7 +102,9 @@ class RandomRolloutEvaluator : public Evaluator {
   explicit RandomRolloutEvaluator(int n_rollouts, int seed) :
     n_rollouts_(n_rollouts), rng_(seed) {}
 
-  // Runs random games, returning the average returns.
+  // Runs random games, returning the average returns. Safe to call from
+  // several search threads at once: each call splits its own stream off the
+  // shared generator under a lock and then rolls out with that.
   std::vector<double> evaluate(const State& state) const override;
 
   // Returns equal probability for each action.
@@ -98,35 +112,129 @@ class RandomRolloutEvaluator : public Evaluator {
 
  private:
   int n_rollouts_;
-  mutable std::mt19937 rng_;
+  mutable std::mutex rng_mutex_;
+  mutable SplittableRandom rng_;
 };
 
-// A node in the search tree for MCTS
+class SearchNodePool;
+
+// A node in the search tree for MCTS. Nodes live in a SearchNodePool; the
+// children of a node are one consecutive index range in the pool, so a node
+// only stores where that range starts and how long it is.
 struct SearchNode {
   Action action = 0;            // The action taken to get to this node.
   double prior = 0;             // The prior probability of playing this action.
   Player player = 0;            // Which player gets to make this action.
   int explore_count = 0;        // Number of times this node was explored.
+  int first_child = -1;         // Pool index of the first child, -1 if none.
+  int num_children = 0;         // Number of children in the pool range.
+  int tt_node = -1;             // Node owning this position's shared stats,
+                                // if merged via the transposition table.
   double total_reward = 0;      // Total reward passing through this node.
   std::vector<double> outcome;  // The reward if each players plays perfectly.
-  std::vector<SearchNode> children;  // The successors to this state.
 
   SearchNode(Action action_, Player player_, double prior_) :
     action(action_), prior(prior_), player(player_) {}
 
-  // The value as returned by the UCT formula.
-  double Value(int parent_explore_count, double uct_c) const;
+  // The value as returned by the UCT formula. An unvisited node's
+  // exploitation term is first_play_urgency instead of its (empty) mean.
+  double Value(int parent_explore_count, double uct_c,
+               double first_play_urgency = 0) const;
 
   // The sort order for the BestChild.
   bool CompareFinal(const SearchNode& b) const;
-  const SearchNode& BestChild() const;
+  const SearchNode& BestChild(const SearchNodePool& pool) const;
 
   // Return a string representation of this node, or all its children.
   // The state is needed to convert the action to a string.
   std::string ToString(const State& state) const;
-  std::string ChildrenStr(const State& state) const;
+  std::string ChildrenStr(const State& state, const SearchNodePool& pool) const;
 };
 
+// A contiguous pool holding an MCTS search tree. Creating a node is an
+// append, the children of a node are adjacent in memory (so UCT selection
+// walks a dense array rather than chasing heap pointers), and the tree is
+// addressed by index, which stays valid when the pool grows.
+class SearchNodePool {
+ public:
+  // Appends a node and returns its index. May grow the underlying storage,
+  // so references into the pool must be re-resolved afterwards.
+  int Add(Action action, Player player, double prior) {
+    nodes_.emplace_back(action, player, prior);
+    return nodes_.size() - 1;
+  }
+
+  SearchNode& operator[](int index) { return nodes_[index]; }
+  const SearchNode& operator[](int index) const { return nodes_[index]; }
+
+  int size() const { return nodes_.size(); }
+  void Clear() { nodes_.clear(); }
+
+  // Bytes of node storage currently reserved by the pool.
+  int64_t MemoryBytes() const {
+    return static_cast<int64_t>(nodes_.capacity()) * sizeof(SearchNode);
+  }
+
+  // Index of a node known to live in this pool.
+  int IndexOf(const SearchNode* node) const { return node - nodes_.data(); }
+
+  // Copies the subtree rooted at `index` into `dest` (appending to whatever
+  // it already holds) and returns the new root's index. Transposition
+  // redirects are resolved eagerly, so subtrees shared through the table are
+  // duplicated in the copy. Nodes explored fewer than `min_explore_count`
+  // times are copied without their children, turning them back into leaves
+  // that keep their aggregated statistics and can be expanded again.
+  int CopySubtree(int index, SearchNodePool* dest,
+                  int min_explore_count = 0) const;
+
+  // Returns the index of the node carrying the statistics for `index`:
+  // either the node itself, or the node it was merged into when the same
+  // position was reached through a different move order.
+  int Canonical(int index) const {
+    const int tt_node = nodes_[index].tt_node;
+    return tt_node >= 0 ? tt_node : index;
+  }
+
+ private:
+  std::vector<SearchNode> nodes_;
+};
+
+
+// Per-move wall-clock settings for MCTSBot, layered on top of
+// max_simulations: a search stops at whichever limit it hits first.
+struct TimeControl {
+  // Wall-clock budget per move, in seconds. Zero (or negative) disables the
+  // clock, leaving max_simulations as the only cap.
+  double seconds_per_move = 0;
+
+  // Stop as soon as the most-explored root child can no longer be overtaken
+  // within the remaining budget, since extra simulations can't change the
+  // chosen action. Saves most of the budget on forced or one-sided moves.
+  bool early_stop = false;
+
+  // Roll unused budget (from early stops or solved trees) into the following
+  // move, so time saved on easy moves is spent on hard ones.
+  bool carryover = false;
+};
+
+// Tuning knobs for the in-tree selection policy.
+struct SelectionPolicy {
+  // The exploitation value assumed for a child that has never been visited.
+  // The default of 0 (the midpoint of a zero-sum game's returns) makes
+  // unseen actions attractive; a value near the game's minimum utility makes
+  // the search deepen known-good lines before trying every sibling once.
+  double first_play_urgency = 0;
+
+  // Progressive widening: when widening_c > 0, selection at a node visited N
+  // times only considers its ceil(widening_c * N^widening_alpha) highest-
+  // prior children (at least one), so wide nodes -- large action spaces and
+  // high-branching chance nodes -- don't have every child tried from the
+  // first visits. Children beyond the frontier never grow subtrees until
+  // the visit count admits them. At chance nodes the sampled outcome is
+  // drawn from the admitted children, renormalized.
+  double widening_c = 0;
+  double widening_alpha = 0.5;
+};
 
 // A SpielBot that uses the MCTS algorithm as its policy.
 class MCTSBot : public Bot {
@@ -140,13 +248,69 @@ class MCTSBot : public Bot {
       int64_t max_memory_mb,  // Max memory use in megabytes.
       bool solve,  // Whether to back up solved states.
       int seed,
-      bool verbose);
+      bool verbose,
+      int num_threads = 1,  // Tree-parallel search when > 1.
+      int batch_size = 1,   // Leaves per EvaluateBatch call when > 1.
+      bool use_transpositions = false,  // Merge transposed positions; the
+                                        // game must provide HashValue().
+      bool reuse_tree = false,  // Keep the chosen child's subtree between
+                                // moves so the next search starts warm.
+      bool recycle_when_full = false,  // On reaching the memory budget,
+                                       // recycle the least-visited parts of
+                                       // the tree instead of stopping.
+      bool root_parallel = false);  // Run num_threads independent trees with
+                                    // different seeds (each doing the full
+                                    // max_simulations, with no shared state
+                                    // or locking) and merge their root child
+                                    // statistics before choosing.
+
+  ~MCTSBot() override;  // Stops any background pondering.
 
   // Run MCTS for one step, choosing the action, and printing some information.
   std::pair<ActionsAndProbs, Action> Step(const State& state) override;
 
-  // Run MCTS on a given state, and return the resulting search tree.
-  std::unique_ptr<SearchNode> MCTSearch(const State& state);
+  // Forgets the subtree retained for reuse, so the next Step starts from a
+  // fresh tree, and drops any carried-over time and background pondering.
+  void Restart(const State& state) override;
+
+  // Searches `state` on a background thread until StopPonder, handing the
+  // tree to the next Step through the tree-reuse machinery (the bot must be
+  // constructed with reuse_tree=true). Ponder the position the bot just
+  // moved to; when the opponent's reply arrives, the next search advances
+  // the pondered tree along it and starts from its statistics. Pondering
+  // ignores max_simulations -- it runs until stopped, solved, or out of
+  // memory -- and is serial regardless of num_threads.
+  void StartPonder(const State& state) override;
+
+  // Joins the ponder thread, retaining whatever it built. Called implicitly
+  // by the next search if the caller hasn't already.
+  void StopPonder() override;
+
+  // Puts the bot under the given time control for subsequent searches.
+  // Resets any budget carried over under the previous control.
+  void SetTimeControl(const TimeControl& time_control) {
+    time_control_ = time_control;
+    carryover_seconds_ = 0;
+    for (auto& worker : root_workers_) worker->SetTimeControl(time_control);
+  }
+
+  // Replaces the selection policy used by subsequent searches.
+  void SetSelectionPolicy(const SelectionPolicy& selection_policy) {
+    selection_policy_ = selection_policy;
+    for (auto& worker : root_workers_) {
+      worker->SetSelectionPolicy(selection_policy);
+    }
+  }
+
+  // Run MCTS on a given state, and return the root of the resulting search
+  // tree. The tree lives in the bot's node pool and is only valid until the
+  // next search.
+  SearchNode* MCTSearch(const State& state);
+
+  // Estimated bytes of the current search tree (the node pool's reserved
+  // storage, which persists across searches). Publishes the figure to the
+  // kMctsTreeBytes gauge (spiel_utils.h).
+  int64_t TreeMemoryBytes() const;
 
  private:
   // Applies the UCT policy to play the game until reaching a leaf node.
@@ -163,8 +327,68 @@ class MCTSBot : public Bot {
   //
   // Returns: The state of the game at the leaf node.
   std::unique_ptr<State> ApplyTreePolicy(
-      SearchNode* root, const State& state,
-      std::vector<SearchNode*>* visit_path);
+      int root_index, const State& state,
+      std::vector<int>* visit_path);
+
+  // Propagates the returns (and, when `solved`, proven outcomes) up the
+  // visit path. With `revert_virtual_loss` the explore counts were already
+  // incremented at selection time with a virtual loss added to the rewards,
+  // which the backup corrects for.
+  void BackupPath(const std::vector<int>& visit_path,
+                  const std::vector<double>& returns, bool* solved,
+                  bool revert_virtual_loss);
+
+  // Runs the simulations of MCTSearch with num_threads_ workers descending
+  // the shared tree. Tree selection, expansion and backup happen under a
+  // single tree mutex; leaf evaluation (the expensive part) runs outside
+  // it, with a virtual loss on the visit path steering concurrent workers
+  // towards different leaves.
+  void ParallelMCTSearch(int root_index, const State& state);
+
+  // Runs the simulations of MCTSearch collecting up to batch_size_ leaves
+  // before handing them to the evaluator in one EvaluateBatch call. A
+  // virtual loss is applied to each collected path so the following
+  // selections in the same batch spread to different leaves; terminal
+  // leaves are backed up immediately since they need no evaluation.
+  // Returns the root's index, which moves if the tree gets recycled.
+  int BatchedMCTSearch(int root_index, const State& state);
+
+  // Runs num_threads_ single-threaded worker bots over the same state, each
+  // building its own tree from its own seed, then rebuilds node_pool_ as a
+  // one-level tree whose root children carry the summed visit counts and
+  // rewards (and any proven outcome) of the matching children across the
+  // worker trees. The workers are created on first use and reused, so their
+  // time-control carryover persists across moves.
+  SearchNode* RootParallelMCTSearch(const State& state);
+
+  // Tries to reuse the subtree retained by the previous Step: if `state`
+  // extends the history the subtree was kept for, walks it forward along
+  // the observed actions, compacts it into a fresh pool and returns the new
+  // root index. Returns -1 (start from scratch) if the state doesn't match
+  // or the walk leaves the explored tree.
+  int AdvanceRetainedTree(const State& state);
+
+  // Frees memory by de-expanding the interior nodes visited less often than
+  // the median: their subtrees are dropped while their aggregated statistics
+  // stay in place, so they become leaves the search can expand again if it
+  // keeps selecting them. Returns the new index of the root.
+  int RecycleTree(int root_index);
+
+  // True once the current search has used up its wall-clock budget.
+  bool OutOfTime() const;
+
+  // True when the most-explored root child leads the runner-up by more
+  // simulations than the remaining budget (simulation cap, and clock when
+  // one is set) can still deliver, so the choice cannot change.
+  bool BestChildDecided(int root_index, int simulations_done) const;
+
+  // How many of `node`'s children selection may consider: all of them, or
+  // the progressively-widened prefix when widening is enabled.
+  int WidenedChildCount(const SearchNode& node) const;
+
+  // The ponder thread's body: the serial simulation loop, run until
+  // ponder_stop_, then parked in reuse_root_/reuse_history_.
+  void PonderSearch(const State& state);
 
   double uct_c_;
   int max_simulations_;
@@ -174,7 +398,32 @@ class MCTSBot : public Bot {
   bool verbose_;
   bool solve_;
   double max_utility_;
-  std::mt19937 rng_;
+  double min_utility_;  // Used as the virtual loss in parallel search.
+  int num_threads_;
+  int batch_size_;
+  bool use_transpositions_;
+  bool reuse_tree_;
+  bool recycle_when_full_;
+  bool root_parallel_;
+  SelectionPolicy selection_policy_;
+  TimeControl time_control_;
+  double carryover_seconds_ = 0;  // Unused budget saved from earlier moves.
+  absl::Time search_start_;       // When the current search began.
+  double search_budget_ = 0;      // Its wall-clock allowance; 0 if no clock.
+  int reuse_root_ = -1;  // Pool index of the retained subtree, -1 if none.
+  // Action history of the state the retained subtree is rooted at.
+  std::vector<Action> reuse_history_;
+  std::thread ponder_thread_;
+  std::atomic<bool> ponder_stop_{false};
+  bool pondering_ = false;
+  std::unique_ptr<State> ponder_state_;  // Keeps the pondered state alive.
+  SplittableRandom rng_;
+  std::mutex tree_mutex_;  // Guards the tree during parallel search.
+  SearchNodePool node_pool_;  // Storage for the current search tree.
+  // The per-tree bots of root-parallel search, created on first use.
+  std::vector<std::unique_ptr<MCTSBot>> root_workers_;
+  // Position hash -> pool index of the node first created for it.
+  std::unordered_map<uint64_t, int> transposition_table_;
   const Evaluator& evaluator_;
 };
 
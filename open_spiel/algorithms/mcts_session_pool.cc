@@ -0,0 +1,128 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mcts_session_pool.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+MCTSSessionPool::MCTSSessionPool(BotFactory bot_factory,
+                                 int64_t max_total_memory_mb)
+    : bot_factory_(std::move(bot_factory)),
+      max_total_memory_(max_total_memory_mb << 20) {
+  SPIEL_CHECK_TRUE(bot_factory_ != nullptr);
+}
+
+MCTSSessionPool::SessionHandle::~SessionHandle() {
+  if (pool_ != nullptr) pool_->Release(session_);
+}
+
+MCTSSessionPool::SessionHandle MCTSSessionPool::GetSession(
+    const std::string& game_id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    auto it = sessions_.find(game_id);
+    if (it == sessions_.end()) {
+      auto session = std::make_unique<Session>();
+      session->bot = bot_factory_();
+      lru_.push_front(game_id);
+      session->lru_position = lru_.begin();
+      it = sessions_.emplace(game_id, std::move(session)).first;
+    }
+    Session* session = it->second.get();
+    if (!session->in_use) {
+      session->in_use = true;
+      lru_.splice(lru_.begin(), lru_, session->lru_position);
+      return SessionHandle(this, session, session->bot.get());
+    }
+    // Another thread holds this session; sessions with waiters are never
+    // erased, so the pointer stays valid across the wait.
+    ++session->waiters;
+    released_cv_.wait(lock);
+    --session->waiters;
+  }
+}
+
+void MCTSSessionPool::Release(Session* session) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    session->in_use = false;
+    const int64_t tree_bytes = session->bot->TreeMemoryBytes();
+    total_tree_bytes_ += tree_bytes - session->tree_bytes;
+    session->tree_bytes = tree_bytes;
+    if (session->close_requested && session->waiters == 0) {
+      EraseSession(session);
+    } else {
+      EvictOverCap();
+    }
+  }
+  released_cv_.notify_all();
+}
+
+void MCTSSessionPool::CloseSession(const std::string& game_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sessions_.find(game_id);
+  if (it == sessions_.end()) return;
+  Session* session = it->second.get();
+  if (session->in_use || session->waiters > 0) {
+    session->close_requested = true;
+  } else {
+    EraseSession(session);
+  }
+}
+
+void MCTSSessionPool::EraseSession(Session* session) {
+  total_tree_bytes_ -= session->tree_bytes;
+  const std::string game_id = *session->lru_position;
+  lru_.erase(session->lru_position);
+  sessions_.erase(game_id);
+}
+
+void MCTSSessionPool::EvictOverCap() {
+  if (max_total_memory_ <= 0) return;
+  // Walk from the least recently used end; busy sessions are skipped
+  // rather than waited on, and will be measured against the cap again when
+  // they are released. The most recently used session is exempt, so one
+  // game whose tree exceeds the cap on its own is not rebuilt every move.
+  auto it = lru_.end();
+  while (total_tree_bytes_ > max_total_memory_ && it != lru_.begin()) {
+    --it;
+    if (it == lru_.begin()) break;
+    Session* session = sessions_.at(*it).get();
+    if (session->in_use || session->waiters > 0) continue;
+    total_tree_bytes_ -= session->tree_bytes;
+    const std::string game_id = *it;
+    it = lru_.erase(it);
+    sessions_.erase(game_id);
+  }
+}
+
+int MCTSSessionPool::NumSessions() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size();
+}
+
+int64_t MCTSSessionPool::TreeMemoryBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_tree_bytes_;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
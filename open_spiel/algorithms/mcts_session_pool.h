@@ -0,0 +1,133 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_SESSION_POOL_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_SESSION_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "open_spiel/algorithms/mcts.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Keeps one persistent MCTSBot per concurrent game, for match servers that
+// answer move requests for many games at once. Constructing a bot and tree
+// per request throws the tree away between moves; a pooled session keeps
+// the bot (build it with reuse_tree=true) so every search after the first
+// starts from the subtree retained by the previous move.
+//
+// Sessions are keyed by a caller-chosen game id. Lookup is thread-safe and
+// hands out an exclusive handle per session, so requests for different
+// games run concurrently while two requests for the same game serialize.
+// The pool tracks the total tree memory across sessions against a cap;
+// when a request pushes it over, the least-recently-used idle sessions are
+// destroyed, and an evicted game's next request simply cold-starts again.
+// The most recently used session is never evicted, so a single game whose
+// tree alone exceeds the cap still keeps its tree between moves.
+class MCTSSessionPool {
+ public:
+  // Creates the bot for a new session. Called with the pool lock held, so
+  // it must not call back into the pool.
+  using BotFactory = std::function<std::unique_ptr<MCTSBot>()>;
+
+  // The memory cap covers the sum of MCTSBot::TreeMemoryBytes over all
+  // pooled sessions; it bounds the retained trees, not the peak while a
+  // search is running. A non-positive cap never evicts.
+  MCTSSessionPool(BotFactory bot_factory, int64_t max_total_memory_mb);
+
+ private:
+  struct Session;
+
+ public:
+  // Exclusive access to one session's bot for the duration of a move
+  // request. Releasing the handle (destruction) makes the session
+  // available to other threads and applies the memory cap.
+  class SessionHandle {
+   public:
+    SessionHandle(SessionHandle&& other)
+        : pool_(other.pool_), session_(other.session_), bot_(other.bot_) {
+      other.pool_ = nullptr;
+    }
+    SessionHandle(const SessionHandle&) = delete;
+    SessionHandle& operator=(const SessionHandle&) = delete;
+    ~SessionHandle();
+
+    MCTSBot* bot() const { return bot_; }
+    MCTSBot* operator->() const { return bot_; }
+
+   private:
+    friend class MCTSSessionPool;
+    SessionHandle(MCTSSessionPool* pool, Session* session, MCTSBot* bot)
+        : pool_(pool), session_(session), bot_(bot) {}
+
+    MCTSSessionPool* pool_;  // nullptr once moved from.
+    Session* session_;
+    MCTSBot* bot_;
+  };
+
+  // Returns a handle on the session for game_id, creating the session on
+  // first use and marking it most recently used. Blocks while another
+  // thread holds a handle on the same session.
+  SessionHandle GetSession(const std::string& game_id);
+
+  // Drops a finished game's session and its tree. If the session is held
+  // or waited on, it is dropped once released instead. Unknown ids are
+  // ignored, so it is safe to close an already-evicted game.
+  void CloseSession(const std::string& game_id);
+
+  int NumSessions() const;
+
+  // Total retained tree memory across pooled sessions, as of each
+  // session's last release.
+  int64_t TreeMemoryBytes() const;
+
+ private:
+  struct Session {
+    std::unique_ptr<MCTSBot> bot;
+    // Position in lru_ (which stores the game id, so the map entry can be
+    // found again from the list).
+    std::list<std::string>::iterator lru_position;
+    int64_t tree_bytes = 0;  // As of the last release.
+    bool in_use = false;
+    int waiters = 0;  // Threads blocked in GetSession on this session.
+    bool close_requested = false;
+  };
+
+  // All three run under mutex_.
+  void Release(Session* session);
+  void EraseSession(Session* session);
+  void EvictOverCap();
+
+  const BotFactory bot_factory_;
+  const int64_t max_total_memory_;  // In bytes; <= 0 disables eviction.
+
+  mutable std::mutex mutex_;
+  std::condition_variable released_cv_;
+  std::unordered_map<std::string, std::unique_ptr<Session>> sessions_;
+  std::list<std::string> lru_;  // Most recently used first.
+  int64_t total_tree_bytes_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_SESSION_POOL_H_
@@ -0,0 +1,165 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mcts_session_pool.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// A session's bot is built once and then served for every request with the
+// same game id; different ids get their own bots.
+void SessionPersistenceTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/42);
+  int factory_calls = 0;
+  MCTSSessionPool pool(
+      [&]() {
+        ++factory_calls;
+        return std::make_unique<MCTSBot>(
+            *game, /*player=*/0, evaluator, /*uct_c=*/2.0,
+            /*max_simulations=*/100, /*max_memory_mb=*/10, /*solve=*/false,
+            /*seed=*/17, /*verbose=*/false, /*num_threads=*/1,
+            /*batch_size=*/1, /*use_transpositions=*/false,
+            /*reuse_tree=*/true);
+      },
+      /*max_total_memory_mb=*/64);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  Action action;
+  {
+    MCTSSessionPool::SessionHandle session = pool.GetSession("game-a");
+    action = session->Step(*state).second;
+  }
+  SPIEL_CHECK_EQ(factory_calls, 1);
+  SPIEL_CHECK_EQ(pool.NumSessions(), 1);
+  SPIEL_CHECK_GT(pool.TreeMemoryBytes(), 0);
+
+  // The follow-up request for the same game reuses the session (and through
+  // tree reuse, the retained subtree of the move just made).
+  state->ApplyAction(action);
+  {
+    MCTSSessionPool::SessionHandle session = pool.GetSession("game-a");
+    session->Step(*state);
+  }
+  SPIEL_CHECK_EQ(factory_calls, 1);
+
+  {
+    MCTSSessionPool::SessionHandle session = pool.GetSession("game-b");
+    session->Step(*game->NewInitialState());
+  }
+  SPIEL_CHECK_EQ(factory_calls, 2);
+  SPIEL_CHECK_EQ(pool.NumSessions(), 2);
+
+  pool.CloseSession("game-a");
+  SPIEL_CHECK_EQ(pool.NumSessions(), 1);
+  pool.CloseSession("no-such-game");  // Ignored.
+  SPIEL_CHECK_EQ(pool.NumSessions(), 1);
+}
+
+// Overflowing the memory cap evicts the least-recently-used idle sessions;
+// the most recent session survives, and an evicted game cold-starts through
+// the factory on its next request.
+void SessionEvictionTest() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/99);
+  int factory_calls = 0;
+  MCTSSessionPool pool(
+      [&]() {
+        ++factory_calls;
+        return std::make_unique<MCTSBot>(
+            *game, /*player=*/0, evaluator, /*uct_c=*/2.0,
+            /*max_simulations=*/3000, /*max_memory_mb=*/10, /*solve=*/false,
+            /*seed=*/7, /*verbose=*/false, /*num_threads=*/1,
+            /*batch_size=*/1, /*use_transpositions=*/false,
+            /*reuse_tree=*/true);
+      },
+      /*max_total_memory_mb=*/1);
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  auto step = [&](const std::string& game_id) {
+    MCTSSessionPool::SessionHandle session = pool.GetSession(game_id);
+    session->Step(*state);
+  };
+
+  step("game-0");
+  const int64_t tree_bytes = pool.TreeMemoryBytes();
+  SPIEL_CHECK_GT(tree_bytes, 0);
+
+  // Open enough further sessions that their retained trees overflow the
+  // 1 MB cap at least twice over.
+  const int num_extra = (int64_t{2} << 20) / tree_bytes + 2;
+  for (int i = 1; i <= num_extra; ++i) {
+    step(absl::StrCat("game-", i));
+  }
+  SPIEL_CHECK_EQ(factory_calls, num_extra + 1);
+  SPIEL_CHECK_LT(pool.NumSessions(), num_extra + 1);
+
+  // The most recently used session is never evicted...
+  step(absl::StrCat("game-", num_extra));
+  SPIEL_CHECK_EQ(factory_calls, num_extra + 1);
+  // ...while the oldest one was, so it cold-starts again.
+  step("game-0");
+  SPIEL_CHECK_EQ(factory_calls, num_extra + 2);
+}
+
+// Requests for different games run from several threads at once; two
+// threads sharing a game id serialize on its session.
+void ConcurrentSessionsTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/11);
+  MCTSSessionPool pool(
+      [&]() {
+        return std::make_unique<MCTSBot>(
+            *game, /*player=*/0, evaluator, /*uct_c=*/2.0,
+            /*max_simulations=*/50, /*max_memory_mb=*/10, /*solve=*/false,
+            /*seed=*/3, /*verbose=*/false, /*num_threads=*/1,
+            /*batch_size=*/1, /*use_transpositions=*/false,
+            /*reuse_tree=*/true);
+      },
+      /*max_total_memory_mb=*/64);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, &game, t]() {
+      const std::string game_id = absl::StrCat("game-", t % 2);
+      for (int i = 0; i < 10; ++i) {
+        MCTSSessionPool::SessionHandle session = pool.GetSession(game_id);
+        session->Step(*game->NewInitialState());
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  SPIEL_CHECK_EQ(pool.NumSessions(), 2);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::SessionPersistenceTest();
+  open_spiel::algorithms::SessionEvictionTest();
+  open_spiel::algorithms::ConcurrentSessionsTest();
+}
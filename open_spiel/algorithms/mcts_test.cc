@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/mcts.h"
 
+#include <chrono>
+#include <thread>
+
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/spiel_bots.h"
 
@@ -42,7 +45,310 @@ void BotTest_RandomVsRandom() {
   SPIEL_CHECK_FLOAT_NEAR(average_results[1], -0.125, 0.01);
 }
 
+void BotTest_ParallelMCTSSelfPlay() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/42);
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/200,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/17 + p,
+        /*verbose=*/false, /*num_threads=*/4));
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_BatchedMCTSSelfPlay() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/77);
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/200,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/23 + p,
+        /*verbose=*/false, /*num_threads=*/1, /*batch_size=*/8));
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_TranspositionMCTSSelfPlay() {
+  // Tic-tac-toe transposes heavily, so this exercises the merge path.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/11);
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/200,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/31 + p,
+        /*verbose=*/false, /*num_threads=*/1, /*batch_size=*/1,
+        /*use_transpositions=*/true));
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_RecyclingMCTSSearch() {
+  // With a 1mb budget and no recycling this search would stop early; with
+  // recycling it must complete every simulation inside the budget.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/61);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0, /*max_simulations=*/5000,
+      /*max_memory_mb=*/1, /*solve=*/false, /*seed=*/67,
+      /*verbose=*/false, /*num_threads=*/1, /*batch_size=*/1,
+      /*use_transpositions=*/false, /*reuse_tree=*/false,
+      /*recycle_when_full=*/true);
+  auto state = game->NewInitialState();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 5000);
+}
+
+void BotTest_TreeReuseMCTSSelfPlay() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/19);
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/200,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/41 + p,
+        /*verbose=*/false, /*num_threads=*/1, /*batch_size=*/1,
+        /*use_transpositions=*/false, /*reuse_tree=*/true));
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  // Several games in a row also exercise dropping a stale retained tree
+  // when the history restarts.
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_PonderingMCTSSearch() {
+  // A pondered position hands its tree to the next search, whose root then
+  // carries more visits than the simulation cap alone allows.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/163);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0, /*max_simulations=*/10,
+      /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/167, /*verbose=*/false,
+      /*num_threads=*/1, /*batch_size=*/1, /*use_transpositions=*/false,
+      /*reuse_tree=*/true);
+  auto state = game->NewInitialState();
+  bot.StartPonder(*state);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  bot.StopPonder();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_GT(root->explore_count, 10);
+}
+
+void BotTest_PonderingMCTSSelfPlay() {
+  // Each bot ponders while its opponent thinks, over several full games.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/173);
+  std::vector<std::unique_ptr<algorithms::MCTSBot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/100,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/179 + p,
+        /*verbose=*/false, /*num_threads=*/1, /*batch_size=*/1,
+        /*use_transpositions=*/false, /*reuse_tree=*/true));
+  }
+  for (int i = 0; i < 3; ++i) {
+    auto state = game->NewInitialState();
+    for (auto& bot : bots) bot->Restart(*state);
+    while (!state->IsTerminal()) {
+      const Player mover = state->CurrentPlayer();
+      bots[1 - mover]->StartPonder(*state);
+      const Action action = bots[mover]->Step(*state).second;
+      bots[1 - mover]->StopPonder();
+      state->ApplyAction(action);
+    }
+  }
+}
+
+void BotTest_RootParallelMCTSSearch() {
+  // Four independent trees of 200 simulations each; the merged root must
+  // carry all 800.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/139);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0, /*max_simulations=*/200,
+      /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/149, /*verbose=*/false,
+      /*num_threads=*/4, /*batch_size=*/1, /*use_transpositions=*/false,
+      /*reuse_tree=*/false, /*recycle_when_full=*/false,
+      /*root_parallel=*/true);
+  auto state = game->NewInitialState();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 800);
+  SPIEL_CHECK_EQ(root->num_children, 9);
+}
+
+void BotTest_RootParallelMCTSSelfPlay() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/151);
+  std::vector<std::unique_ptr<Bot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/100,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/157 + p,
+        /*verbose=*/false, /*num_threads=*/4, /*batch_size=*/1,
+        /*use_transpositions=*/false, /*reuse_tree=*/false,
+        /*recycle_when_full=*/false, /*root_parallel=*/true));
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_FirstPlayUrgencyMCTSSearch() {
+  // With no exploration bonus and an urgency below the minimum utility, the
+  // first child tried keeps winning selection: exactly one root child is
+  // ever visited.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/107);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/0.0, /*max_simulations=*/50,
+      /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/109, /*verbose=*/false);
+  algorithms::SelectionPolicy selection_policy;
+  selection_policy.first_play_urgency = -2;
+  bot.SetSelectionPolicy(selection_policy);
+  auto state = game->NewInitialState();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  // A fresh search roots the tree at pool index 0, so the root's children
+  // live at root + first_child.
+  SPIEL_CHECK_EQ(root->num_children, 9);
+  int visited = 0;
+  for (int i = 0; i < root->num_children; ++i) {
+    if ((root + root->first_child + i)->explore_count > 0) ++visited;
+  }
+  SPIEL_CHECK_EQ(visited, 1);
+}
+
+void BotTest_ProgressiveWideningMCTSSearch() {
+  // With widening_c=0.1 the admitted width at the root stays 1 for its
+  // first hundred visits, so a 90-simulation search explores a single root
+  // child despite the positive exploration bonus.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/113);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0, /*max_simulations=*/90,
+      /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/127, /*verbose=*/false);
+  algorithms::SelectionPolicy selection_policy;
+  selection_policy.widening_c = 0.1;
+  bot.SetSelectionPolicy(selection_policy);
+  auto state = game->NewInitialState();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->num_children, 9);
+  int visited = 0;
+  for (int i = 0; i < root->num_children; ++i) {
+    if ((root + root->first_child + i)->explore_count > 0) ++visited;
+  }
+  SPIEL_CHECK_EQ(visited, 1);
+}
+
+void BotTest_WidenedChanceMCTSSelfPlay() {
+  // Kuhn poker opens with chance deals, so this exercises sampling among
+  // the admitted outcomes of a widened chance node.
+  auto game = LoadGame("kuhn_poker");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/131);
+  algorithms::SelectionPolicy selection_policy;
+  selection_policy.widening_c = 0.5;
+  std::vector<std::unique_ptr<algorithms::MCTSBot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/100,
+        /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/137 + p,
+        /*verbose=*/false));
+    bots.back()->SetSelectionPolicy(selection_policy);
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 5; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
+void BotTest_TimedMCTSSearch() {
+  // With a huge simulation cap, only the clock can end the search.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/83);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0,
+      /*max_simulations=*/100000000, /*max_memory_mb=*/0, /*solve=*/false,
+      /*seed=*/89, /*verbose=*/false);
+  algorithms::TimeControl time_control;
+  time_control.seconds_per_move = 0.1;
+  bot.SetTimeControl(time_control);
+  auto state = game->NewInitialState();
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_GT(root->explore_count, 0);
+  SPIEL_CHECK_LT(root->explore_count, 100000000);
+}
+
+void BotTest_EarlyStopMCTSSearch() {
+  // One empty square left: the single root child can never be overtaken,
+  // so an early-stopping search ends after a handful of simulations.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/97);
+  algorithms::MCTSBot bot(
+      *game, /*player=*/0, evaluator, /*uct_c=*/2.0, /*max_simulations=*/1000,
+      /*max_memory_mb=*/10, /*solve=*/false, /*seed=*/101, /*verbose=*/false);
+  algorithms::TimeControl time_control;
+  time_control.early_stop = true;
+  bot.SetTimeControl(time_control);
+  auto state = game->NewInitialState();
+  for (Action action : {0, 1, 2, 4, 3, 5, 7, 6}) state->ApplyAction(action);
+  algorithms::SearchNode* root = bot.MCTSearch(*state);
+  SPIEL_CHECK_LT(root->explore_count, 10);
+}
+
+void BotTest_TimeControlSelfPlay() {
+  // Clock, early stop and carryover together, over full games.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/53);
+  algorithms::TimeControl time_control;
+  time_control.seconds_per_move = 0.02;
+  time_control.early_stop = true;
+  time_control.carryover = true;
+  std::vector<std::unique_ptr<algorithms::MCTSBot>> bots;
+  for (auto p = Player{0}; p < 2; ++p) {
+    bots.push_back(std::make_unique<algorithms::MCTSBot>(
+        *game, p, evaluator, /*uct_c=*/2.0, /*max_simulations=*/100000,
+        /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/59 + p,
+        /*verbose=*/false));
+    bots.back()->SetTimeControl(time_control);
+  }
+  std::vector<Bot*> bot_ptrs = {bots[0].get(), bots[1].get()};
+  for (int i = 0; i < 2; ++i) {
+    EvaluateBots(game->NewInitialState().get(), bot_ptrs, /*seed=*/i);
+  }
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::BotTest_RandomVsRandom(); }
+int main(int argc, char** argv) {
+  open_spiel::BotTest_RandomVsRandom();
+  open_spiel::BotTest_ParallelMCTSSelfPlay();
+  open_spiel::BotTest_BatchedMCTSSelfPlay();
+  open_spiel::BotTest_TranspositionMCTSSelfPlay();
+  open_spiel::BotTest_TreeReuseMCTSSelfPlay();
+  open_spiel::BotTest_RecyclingMCTSSearch();
+  open_spiel::BotTest_PonderingMCTSSearch();
+  open_spiel::BotTest_PonderingMCTSSelfPlay();
+  open_spiel::BotTest_RootParallelMCTSSearch();
+  open_spiel::BotTest_RootParallelMCTSSelfPlay();
+  open_spiel::BotTest_FirstPlayUrgencyMCTSSearch();
+  open_spiel::BotTest_ProgressiveWideningMCTSSearch();
+  open_spiel::BotTest_WidenedChanceMCTSSelfPlay();
+  open_spiel::BotTest_TimedMCTSSearch();
+  open_spiel::BotTest_EarlyStopMCTSSearch();
+  open_spiel::BotTest_TimeControlSelfPlay();
+}
@@ -15,7 +15,12 @@
 #include "open_spiel/algorithms/minimax.h"
 
 #include <algorithm>  // std::max
+#include <array>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
@@ -25,6 +30,45 @@ namespace open_spiel {
 namespace algorithms {
 namespace {
 
+// Lazily walks the legal actions of a state: for games with staged
+// generation (Game::ProvidesStagedActions) the forcing stage (captures and
+// promotions) is produced first and the quiet stage is only generated if
+// the caller exhausts the forcing moves without a cut-off, so at most
+// nodes refuted by a capture the quiet-move generation work never happens.
+// For other games this is a plain walk over LegalActions().
+class StagedActionIterator {
+ public:
+  explicit StagedActionIterator(const State& state) : state_(state) {
+    if (state.GetGame()->ProvidesStagedActions()) {
+      actions_ = state.LegalActions(ActionStage::kForcing);
+      quiet_stage_pending_ = true;
+    } else {
+      actions_ = state.LegalActions();
+    }
+  }
+
+  // Writes the next action into *action, returning false when there are no
+  // actions left. The state must be at the same position as at
+  // construction whenever this is called (apply/undo pairs between calls
+  // are fine).
+  bool Next(Action* action) {
+    while (next_ >= actions_.size()) {
+      if (!quiet_stage_pending_) return false;
+      quiet_stage_pending_ = false;
+      actions_ = state_.LegalActions(ActionStage::kQuiet);
+      next_ = 0;
+    }
+    *action = actions_[next_++];
+    return true;
+  }
+
+ private:
+  const State& state_;
+  std::vector<Action> actions_;
+  int next_ = 0;
+  bool quiet_stage_pending_ = false;
+};
+
 // An alpha-beta algorithm.
 //
 // Implements a min-max algorithm with alpha-beta pruning.
@@ -47,7 +91,8 @@ namespace {
 //   The optimal value of the sub-game starting in state (given alpha/beta).
 double _alpha_beta(State* state, int depth, double alpha, double beta,
                    std::function<double(const State&)> value_function,
-                   Player maximizing_player, Action* best_action) {
+                   Player maximizing_player, Action* best_action,
+                   bool use_undo) {
   if (state->IsTerminal()) {
     return state->PlayerReturn(maximizing_player);
   }
@@ -66,13 +111,24 @@ double _alpha_beta(State* state, int depth, double alpha, double beta,
   if (player == maximizing_player) {
     double value = -std::numeric_limits<double>::infinity();
 
-    for (auto action : state->LegalActions()) {
-      state->ApplyAction(action);
-      double child_value =
-          _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
-                      /*beta=*/beta, value_function, maximizing_player,
-                      /*best_action=*/nullptr);
-      state->UndoAction(player, action);
+    StagedActionIterator actions(*state);
+    Action action;
+    while (actions.Next(&action)) {
+      double child_value;
+      if (use_undo) {
+        state->ApplyAction(action);
+        child_value =
+            _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
+                        /*beta=*/beta, value_function, maximizing_player,
+                        /*best_action=*/nullptr, use_undo);
+        state->UndoAction(player, action);
+      } else {
+        std::unique_ptr<State> child = state->Child(action);
+        child_value =
+            _alpha_beta(child.get(), /*depth=*/depth - 1, /*alpha=*/alpha,
+                        /*beta=*/beta, value_function, maximizing_player,
+                        /*best_action=*/nullptr, use_undo);
+      }
 
       if (child_value > value) {
         value = child_value;
@@ -91,13 +147,24 @@ double _alpha_beta(State* state, int depth, double alpha, double beta,
   } else {
     double value = std::numeric_limits<double>::infinity();
 
-    for (auto action : state->LegalActions()) {
-      state->ApplyAction(action);
-      double child_value =
-          _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
-                      /*beta=*/beta, value_function, maximizing_player,
-                      /*best_action=*/nullptr);
-      state->UndoAction(player, action);
+    StagedActionIterator actions(*state);
+    Action action;
+    while (actions.Next(&action)) {
+      double child_value;
+      if (use_undo) {
+        state->ApplyAction(action);
+        child_value =
+            _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
+                        /*beta=*/beta, value_function, maximizing_player,
+                        /*best_action=*/nullptr, use_undo);
+        state->UndoAction(player, action);
+      } else {
+        std::unique_ptr<State> child = state->Child(action);
+        child_value =
+            _alpha_beta(child.get(), /*depth=*/depth - 1, /*alpha=*/alpha,
+                        /*beta=*/beta, value_function, maximizing_player,
+                        /*best_action=*/nullptr, use_undo);
+      }
 
       if (child_value < value) {
         value = child_value;
@@ -115,17 +182,18 @@ double _alpha_beta(State* state, int depth, double alpha, double beta,
     return value;
   }
 }
-}  // namespace
 
-std::pair<double, Action> AlphaBetaSearch(
-    const Game& game, const State* state,
-    std::function<double(const State&)> value_function, int depth_limit,
-    Player maximizing_player) {
+// Checks the requirements shared by all the searches in this file. The
+// alpha-beta searches require deterministic games; expectiminimax handles
+// explicit chance nodes as well.
+void CheckGameIsSearchable(const Game& game, bool allow_chance) {
   if (game.NumPlayers() != 2) {
     SpielFatalError("Game must be a 2-player game");
   }
   GameType game_info = game.GetType();
-  if (game_info.chance_mode != GameType::ChanceMode::kDeterministic) {
+  if (game_info.chance_mode != GameType::ChanceMode::kDeterministic &&
+      !(allow_chance &&
+        game_info.chance_mode == GameType::ChanceMode::kExplicitStochastic)) {
     SpielFatalError(absl::StrCat("The game must be a Deterministic one, not ",
                                  game_info.chance_mode));
   }
@@ -142,6 +210,379 @@ std::pair<double, Action> AlphaBetaSearch(
     SpielFatalError(
         absl::StrCat("The game must be 0-sum, not  ", game_info.utility));
   }
+}
+
+constexpr int kNumKillerMoves = 2;
+
+// A transposition table entry. The value is exact only if the search that
+// produced it finished without a cut-off; otherwise it is a bound on the
+// true value, which can still narrow the window or fail high immediately.
+using Bound = TTBound;
+
+struct TTEntry {
+  int depth;
+  double value;
+  Bound bound;
+  Action best_action;
+};
+
+// The ordering state carried across iterative deepening iterations.
+struct SearchTables {
+  bool use_hashing;
+  // Key the table on State::CanonicalHash instead of State::HashValue, so
+  // symmetric positions share one entry. The stored best move may then come
+  // from a different orientation of the position, which is harmless for
+  // move ordering (an unmatched move is simply not promoted) but means an
+  // exact hit cannot be returned where a legal move is required.
+  bool use_canonical = false;
+  std::unordered_map<uint64_t, TTEntry> transpositions;
+  // When set, entries live in the two-tier disk-backed table instead of
+  // the map above, so the working set is bounded by its memory tier.
+  DiskTranspositionTable* disk_table = nullptr;
+  // killer_moves[ply] holds the last moves that caused a cut-off at that
+  // ply; trying them early often repeats the cut-off in sibling positions.
+  std::vector<std::array<Action, kNumKillerMoves>> killer_moves;
+  // Optional cooperative deadline. Once it expires, the search unwinds
+  // with meaningless values and out_of_time tells the driver (and the
+  // transposition store below) to discard them.
+  TimeBudget* budget = nullptr;
+  bool out_of_time = false;
+};
+
+// Alpha-beta as in _alpha_beta above, extended with a transposition table
+// and move ordering: the best move stored for this position (typically from
+// the previous, shallower iteration) is searched first, then the killer
+// moves of this ply, then the rest in move-generation order.
+double OrderedAlphaBeta(
+    State* state, int depth, int ply, double alpha, double beta,
+    const std::function<double(const State&)>& value_function,
+    Player maximizing_player, bool use_undo, SearchTables* tables,
+    Action* best_action_out) {
+  if (tables->budget != nullptr &&
+      (tables->out_of_time || tables->budget->Expired())) {
+    // Unwind immediately; the returned value is discarded by the driver.
+    tables->out_of_time = true;
+    return 0;
+  }
+
+  if (state->IsTerminal()) {
+    return state->PlayerReturn(maximizing_player);
+  }
+
+  if (depth == 0 && !value_function) {
+    SpielFatalError(
+        "We assume we can walk the full depth of the tree. "
+        "Try increasing depth or provide a value_function.");
+  }
+
+  if (depth == 0) {
+    return value_function(*state);
+  }
+
+  const double alpha_orig = alpha;
+  const double beta_orig = beta;
+
+  uint64_t key = 0;
+  Action tt_action = kInvalidAction;
+  // With canonical keying, the entry's move may belong to a symmetric
+  // orientation, so where the caller needs a legal move (the root) the hit
+  // only seeds the move ordering and the search still runs.
+  const bool may_return_entry =
+      best_action_out == nullptr || !tables->use_canonical;
+  if (tables->use_hashing) {
+    key = tables->use_canonical ? state->CanonicalHash() : state->HashValue();
+    bool found = false;
+    TTEntry entry;
+    if (tables->disk_table != nullptr) {
+      DiskTTEntry disk_entry;
+      if (tables->disk_table->Lookup(key, &disk_entry)) {
+        entry = {disk_entry.depth, disk_entry.value, disk_entry.bound,
+                 disk_entry.best_action};
+        found = true;
+      }
+    } else {
+      auto it = tables->transpositions.find(key);
+      if (it != tables->transpositions.end()) {
+        entry = it->second;
+        found = true;
+      }
+    }
+    if (found) {
+      tt_action = entry.best_action;
+      if (entry.depth >= depth && may_return_entry) {
+        if (entry.bound == Bound::kExact) {
+          if (best_action_out != nullptr) *best_action_out = entry.best_action;
+          return entry.value;
+        } else if (entry.bound == Bound::kLower) {
+          alpha = std::max(alpha, entry.value);
+        } else {
+          beta = std::min(beta, entry.value);
+        }
+        if (alpha >= beta) {
+          if (best_action_out != nullptr) *best_action_out = entry.best_action;
+          return entry.value;
+        }
+      }
+    }
+  }
+
+  std::vector<Action> actions = state->LegalActions();
+  int front = 0;  // Actions before this index have already been ordered.
+  auto move_to_front = [&actions, &front](Action action) {
+    for (int i = front; i < actions.size(); ++i) {
+      if (actions[i] == action) {
+        std::rotate(actions.begin() + front, actions.begin() + i,
+                    actions.begin() + i + 1);
+        ++front;
+        break;
+      }
+    }
+  };
+  if (tt_action != kInvalidAction) move_to_front(tt_action);
+  if (ply < tables->killer_moves.size()) {
+    for (Action killer : tables->killer_moves[ply]) {
+      if (killer != kInvalidAction) move_to_front(killer);
+    }
+  }
+
+  Player player = state->CurrentPlayer();
+  const bool maximizing = (player == maximizing_player);
+  double value = maximizing ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+  Action best_action = kInvalidAction;
+
+  for (Action action : actions) {
+    double child_value;
+    if (use_undo) {
+      state->ApplyAction(action);
+      child_value = OrderedAlphaBeta(
+          state, /*depth=*/depth - 1, /*ply=*/ply + 1, alpha, beta,
+          value_function, maximizing_player, use_undo, tables,
+          /*best_action_out=*/nullptr);
+      state->UndoAction(player, action);
+    } else {
+      std::unique_ptr<State> child = state->Child(action);
+      child_value = OrderedAlphaBeta(
+          child.get(), /*depth=*/depth - 1, /*ply=*/ply + 1, alpha, beta,
+          value_function, maximizing_player, use_undo, tables,
+          /*best_action_out=*/nullptr);
+    }
+
+    if (maximizing ? child_value > value : child_value < value) {
+      value = child_value;
+      best_action = action;
+    }
+
+    if (maximizing) {
+      alpha = std::max(alpha, value);
+    } else {
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) {
+      // Remember the cut-off move as a killer for this ply.
+      if (ply < tables->killer_moves.size()) {
+        std::array<Action, kNumKillerMoves>& killers =
+            tables->killer_moves[ply];
+        if (action != killers[0]) {
+          killers[1] = killers[0];
+          killers[0] = action;
+        }
+      }
+      break;
+    }
+  }
+
+  // A node whose move loop was cut short by the budget has a meaningless
+  // value; keep it out of the table.
+  if (tables->use_hashing && !tables->out_of_time) {
+    const Bound bound = value <= alpha_orig
+                            ? Bound::kUpper
+                            : value >= beta_orig ? Bound::kLower
+                                                 : Bound::kExact;
+    if (tables->disk_table != nullptr) {
+      DiskTTEntry disk_entry;
+      disk_entry.key = key;
+      disk_entry.value = value;
+      disk_entry.best_action = best_action;
+      disk_entry.depth = depth;
+      disk_entry.bound = bound;
+      tables->disk_table->Insert(disk_entry);
+    } else {
+      auto insert = tables->transpositions.insert(
+          {key, {depth, value, bound, best_action}});
+      // Deepest-search-wins replacement.
+      if (!insert.second && depth >= insert.first->second.depth) {
+        insert.first->second = {depth, value, bound, best_action};
+      }
+    }
+  }
+
+  if (best_action_out != nullptr) *best_action_out = best_action;
+  return value;
+}
+
+// Expectiminimax: as _alpha_beta, but chance nodes take the expectation
+// over ChanceOutcomes() with Star1 pruning. The utility bounds let the
+// expectation be bracketed while outcomes resolve: once even the extreme
+// values for the unresolved probability mass cannot bring it back inside
+// the (alpha, beta) window, the remaining outcomes are cut off, which
+// matters on games like backgammon with 21 dice outcomes per ply.
+double _expectiminimax(State* state, int depth, double alpha, double beta,
+                       const std::function<double(const State&)>&
+                           value_function,
+                       Player maximizing_player, Action* best_action,
+                       double min_utility, double max_utility) {
+  if (state->IsTerminal()) {
+    return state->PlayerReturn(maximizing_player);
+  }
+
+  if (depth == 0 && !value_function) {
+    SpielFatalError(
+        "We assume we can walk the full depth of the tree. "
+        "Try increasing depth or provide a value_function.");
+  }
+
+  if (depth == 0) {
+    return value_function(*state);
+  }
+
+  if (state->IsChanceNode()) {
+    double expected = 0.0;   // Expectation over the resolved outcomes.
+    double remaining = 1.0;  // Probability mass not yet resolved.
+    for (const auto& [action, prob] : state->ChanceOutcomes()) {
+      remaining -= prob;
+      // The window the child must land in for the total expectation to
+      // still fall inside (alpha, beta), assuming the best and worst for
+      // the unresolved mass.
+      const double child_alpha = std::max(
+          min_utility, (alpha - expected - remaining * max_utility) / prob);
+      const double child_beta = std::min(
+          max_utility, (beta - expected - remaining * min_utility) / prob);
+      std::unique_ptr<State> child = state->Child(action);
+      const double child_value = _expectiminimax(
+          child.get(), /*depth=*/depth - 1, child_alpha, child_beta,
+          value_function, maximizing_player, /*best_action=*/nullptr,
+          min_utility, max_utility);
+      expected += prob * child_value;
+      // Star1 cut-offs; what's returned is a bound, like a cut-off value
+      // in alpha-beta.
+      if (expected + remaining * max_utility <= alpha) {
+        return expected + remaining * max_utility;
+      }
+      if (expected + remaining * min_utility >= beta) {
+        return expected + remaining * min_utility;
+      }
+    }
+    return expected;
+  }
+
+  Player player = state->CurrentPlayer();
+  if (player == maximizing_player) {
+    double value = -std::numeric_limits<double>::infinity();
+
+    for (auto action : state->LegalActions()) {
+      std::unique_ptr<State> child = state->Child(action);
+      double child_value = _expectiminimax(
+          child.get(), /*depth=*/depth - 1, /*alpha=*/alpha, /*beta=*/beta,
+          value_function, maximizing_player, /*best_action=*/nullptr,
+          min_utility, max_utility);
+
+      if (child_value > value) {
+        value = child_value;
+        if (best_action != nullptr) {
+          *best_action = action;
+        }
+      }
+
+      alpha = std::max(alpha, value);
+      if (alpha >= beta) {
+        break;  // beta cut-off
+      }
+    }
+
+    return value;
+  } else {
+    double value = std::numeric_limits<double>::infinity();
+
+    for (auto action : state->LegalActions()) {
+      std::unique_ptr<State> child = state->Child(action);
+      double child_value = _expectiminimax(
+          child.get(), /*depth=*/depth - 1, /*alpha=*/alpha, /*beta=*/beta,
+          value_function, maximizing_player, /*best_action=*/nullptr,
+          min_utility, max_utility);
+
+      if (child_value < value) {
+        value = child_value;
+        if (best_action != nullptr) {
+          *best_action = action;
+        }
+      }
+
+      beta = std::min(beta, value);
+      if (alpha >= beta) {
+        break;  // alpha cut-off
+      }
+    }
+
+    return value;
+  }
+}
+}  // namespace
+
+EvaluationCache::EvaluationCache(int64_t max_bytes)
+    : max_entries_(std::max<int64_t>(1, max_bytes / kBytesPerEntry)) {}
+
+bool EvaluationCache::Lookup(uint64_t key, double* value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  *value = it->second->value;
+  return true;
+}
+
+void EvaluationCache::Insert(uint64_t key, double value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->value = value;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.push_front({key, value});
+  index_[key] = lru_.begin();
+  while (index_.size() > max_entries_) {
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+int64_t EvaluationCache::NumEntries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+std::pair<double, Action> AlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, EvaluationCache* eval_cache) {
+  CheckGameIsSearchable(game, /*allow_chance=*/false);
+
+  if (eval_cache != nullptr && value_function) {
+    if (!game.ProvidesHashValue()) {
+      SpielFatalError("eval_cache requires a game with HashValue().");
+    }
+    // Wrap the value function so leaves hit the cache transparently.
+    std::function<double(const State&)> base = std::move(value_function);
+    value_function = [eval_cache, base](const State& state) {
+      const uint64_t key = state.HashValue();
+      double value;
+      if (eval_cache->Lookup(key, &value)) return value;
+      value = base(state);
+      eval_cache->Insert(key, value);
+      return value;
+    };
+  }
 
   std::unique_ptr<State> search_root;
   if (state == nullptr) {
@@ -154,11 +595,186 @@ std::pair<double, Action> AlphaBetaSearch(
     maximizing_player = search_root->CurrentPlayer();
   }
 
+  // Traverse in place via apply/undo when the game supports it; otherwise
+  // fall back to cloning the state at every child.
+  const bool use_undo = game.ProvidesUndo();
+
   double infinity = std::numeric_limits<double>::infinity();
   Action best_action = kInvalidAction;
   double value = _alpha_beta(
       search_root.get(), /*depth=*/depth_limit, /*alpha=*/-infinity,
-      /*beta=*/infinity, value_function, maximizing_player, &best_action);
+      /*beta=*/infinity, value_function, maximizing_player, &best_action,
+      use_undo);
+
+  return std::pair<double, Action>(value, best_action);
+}
+
+std::pair<double, Action> IterativeDeepeningSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, bool canonical_transpositions,
+    DiskTranspositionTable* disk_table, TimeBudget* budget) {
+  CheckGameIsSearchable(game, /*allow_chance=*/false);
+  if (canonical_transpositions && !game.ProvidesCanonicalForm()) {
+    SpielFatalError(
+        "canonical_transpositions requires a game with "
+        "Game::ProvidesCanonicalForm().");
+  }
+  if (disk_table != nullptr && !canonical_transpositions &&
+      !game.ProvidesHashValue()) {
+    SpielFatalError(
+        "disk_table requires a game with Game::ProvidesHashValue().");
+  }
+
+  std::unique_ptr<State> search_root;
+  if (state == nullptr) {
+    search_root = game.NewInitialState();
+  } else {
+    search_root = state->Clone();
+  }
+
+  if (maximizing_player == kInvalidPlayer) {
+    maximizing_player = search_root->CurrentPlayer();
+  }
+
+  const bool use_undo = game.ProvidesUndo();
+  if (depth_limit < 0) {
+    depth_limit = game.MaxGameLength();
+  }
+
+  SearchTables tables;
+  tables.use_hashing = canonical_transpositions || game.ProvidesHashValue();
+  tables.use_canonical = canonical_transpositions;
+  tables.disk_table = disk_table;
+  tables.killer_moves.assign(depth_limit + 1,
+                             {kInvalidAction, kInvalidAction});
+  tables.budget = budget;
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  double value = 0;
+  Action best_action = kInvalidAction;
+  // Without a value function the shallower iterations cannot evaluate their
+  // depth-limited frontiers, so only the full-depth search runs.
+  const int start_depth = value_function ? 1 : depth_limit;
+  for (int depth = start_depth; depth <= depth_limit; ++depth) {
+    Action iteration_action = kInvalidAction;
+    const double iteration_value = OrderedAlphaBeta(
+        search_root.get(), depth, /*ply=*/0,
+        /*alpha=*/-infinity, /*beta=*/infinity, value_function,
+        maximizing_player, use_undo, &tables, &iteration_action);
+    // An iteration cut short by the budget is discarded; the previous
+    // (completed) iteration's result stands.
+    if (tables.out_of_time) break;
+    value = iteration_value;
+    best_action = iteration_action;
+  }
+
+  // The budget expired before any iteration completed: finish the
+  // shallowest one over budget so there is always a move to return.
+  if (best_action == kInvalidAction) {
+    tables.budget = nullptr;
+    tables.out_of_time = false;
+    value = OrderedAlphaBeta(search_root.get(), start_depth, /*ply=*/0,
+                             /*alpha=*/-infinity, /*beta=*/infinity,
+                             value_function, maximizing_player, use_undo,
+                             &tables, &best_action);
+  }
+
+  return std::pair<double, Action>(value, best_action);
+}
+
+std::pair<double, Action> ParallelAlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, int num_threads) {
+  CheckGameIsSearchable(game, /*allow_chance=*/false);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  std::unique_ptr<State> search_root;
+  if (state == nullptr) {
+    search_root = game.NewInitialState();
+  } else {
+    search_root = state->Clone();
+  }
+
+  if (maximizing_player == kInvalidPlayer) {
+    maximizing_player = search_root->CurrentPlayer();
+  }
+
+  const bool use_undo = game.ProvidesUndo();
+  const double infinity = std::numeric_limits<double>::infinity();
+  const Player root_player = search_root->CurrentPlayer();
+  const bool maximizing = (root_player == maximizing_player);
+  std::vector<Action> actions = search_root->LegalActions();
+  SPIEL_CHECK_GT(actions.size(), 0);
+
+  // Each root move gets its own subtree search on a fresh child state.
+  auto search_child = [&](Action action, double alpha, double beta) {
+    std::unique_ptr<State> child = search_root->Child(action);
+    return _alpha_beta(child.get(), /*depth=*/depth_limit - 1, alpha, beta,
+                       value_function, maximizing_player,
+                       /*best_action=*/nullptr, use_undo);
+  };
+
+  // Young brothers wait: search the first move with a full window on the
+  // calling thread, so the workers start with a bound to prune against.
+  double best_value = search_child(actions[0], -infinity, infinity);
+  Action best_action = actions[0];
+
+  std::mutex best_mutex;  // Guards best_value and best_action.
+  {
+    // The remaining moves are one task each on the shared pool.
+    TaskGroup group(TaskPool::Global());
+    for (int index = 1; index < actions.size(); ++index) {
+      group.Spawn([&, index]() {
+        double alpha, beta;
+        {
+          // The shared bound: a move only improves on the best value found
+          // so far, so everything outside that window can be pruned. A
+          // search failing outside the window returns a bound, which the
+          // improvement test below correctly ignores.
+          std::lock_guard<std::mutex> lock(best_mutex);
+          alpha = maximizing ? best_value : -infinity;
+          beta = maximizing ? infinity : best_value;
+        }
+        const double value = search_child(actions[index], alpha, beta);
+        std::lock_guard<std::mutex> lock(best_mutex);
+        if (maximizing ? value > best_value : value < best_value) {
+          best_value = value;
+          best_action = actions[index];
+        }
+      });
+    }
+    group.Sync();
+  }
+
+  return std::pair<double, Action>(best_value, best_action);
+}
+
+std::pair<double, Action> ExpectiminimaxSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player) {
+  CheckGameIsSearchable(game, /*allow_chance=*/true);
+
+  std::unique_ptr<State> search_root;
+  if (state == nullptr) {
+    search_root = game.NewInitialState();
+  } else {
+    search_root = state->Clone();
+  }
+
+  if (maximizing_player == kInvalidPlayer) {
+    SPIEL_CHECK_FALSE(search_root->IsChanceNode());
+    maximizing_player = search_root->CurrentPlayer();
+  }
+
+  double infinity = std::numeric_limits<double>::infinity();
+  Action best_action = kInvalidAction;
+  double value = _expectiminimax(
+      search_root.get(), /*depth=*/depth_limit, /*alpha=*/-infinity,
+      /*beta=*/infinity, value_function, maximizing_player, &best_action,
+      game.MinUtility(), game.MaxUtility());
 
   return std::pair<double, Action>(value, best_action);
 }
@@ -15,14 +15,51 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MINMAX_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MINMAX_H_
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
+#include "open_spiel/algorithms/disk_transposition_table.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
 namespace algorithms {
 
+// A thread-safe cache of leaf evaluations keyed on `State::HashValue`, with
+// least-recently-used eviction under an approximate byte budget. Analysis
+// pipelines call `AlphaBetaSearch` repeatedly on adjacent positions (move
+// lists, blunder checks); passing the same cache across those calls avoids
+// recomputing the value function at the many leaves the searches share.
+class EvaluationCache {
+ public:
+  explicit EvaluationCache(int64_t max_bytes);
+
+  // Returns true and fills *value if the key is present, marking the entry
+  // as most recently used.
+  bool Lookup(uint64_t key, double* value);
+
+  // Inserts (or refreshes) an entry, evicting the least recently used
+  // entries while over budget.
+  void Insert(uint64_t key, double value);
+
+  int64_t NumEntries() const;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    double value;
+  };
+  // Approximate per-entry footprint: the list node plus the index entry.
+  static constexpr int64_t kBytesPerEntry = sizeof(Entry) + 8 * sizeof(void*);
+
+  mutable std::mutex mutex_;
+  int64_t max_entries_;
+  std::list<Entry> lru_;  // Most recently used at the front.
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+};
+
 // Solves deterministic, 2-players, perfect-information 0-sum game.
 //
 // For small games only! Please use keyword arguments for optional arguments.
@@ -39,12 +76,83 @@ namespace algorithms {
 //   maximizing_player_id: The id of the MAX player. The other player is assumed
 //     to be MIN. Passing in kInvalidPlayer will set this to the search root's
 //     current player.
+//   eval_cache: An optional EvaluationCache consulted before calling
+//     `value_function` at depth-limited leaves, and filled with the computed
+//     values. Requires a game with `HashValue()`. Pass the same cache across
+//     calls on nearby positions to reuse their shared leaf evaluations.
+//
+// For games with staged action generation (`Game::ProvidesStagedActions`),
+// the move loop consumes the stages lazily: forcing moves (captures and
+// promotions) are tried first, and a node's quiet moves are only generated
+// if none of its forcing moves produces a cut-off.
 
 //   Returns:
 //     A pair of the value of the game for the maximizing player when both
 //     players play optimally, along with the action that achieves this value.
 
 std::pair<double, Action> AlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, EvaluationCache* eval_cache = nullptr);
+
+// Iterative-deepening alpha-beta with move ordering. Searches to depth 1,
+// then 2, and so on up to `depth_limit`, carrying a transposition table
+// (keyed on `State::HashValue` when the game provides one) and killer moves
+// across iterations. Each deeper search tries the previous iteration's best
+// move in every visited position first, which is what makes alpha-beta
+// pruning effective on games like chess and breakthrough.
+//
+// Arguments are as for `AlphaBetaSearch`; a negative `depth_limit` searches
+// to `game.MaxGameLength()`. Without a `value_function` the shallower
+// iterations cannot evaluate their depth-limited frontiers, so only the
+// full-depth search runs (still with transposition and killer ordering).
+//
+// With `canonical_transpositions` (requires `Game::ProvidesCanonicalForm`),
+// the transposition table is keyed on `State::CanonicalHash`, so rotated
+// and reflected variants of a position share one entry and their subtree
+// is searched only once per depth. Sharing values between symmetric
+// positions is only sound if `value_function` is itself invariant under
+// the game's symmetries.
+//
+// With a `disk_table`, entries go through the two-tier disk-backed table
+// instead of the in-memory map, so full-game solves whose transposition
+// sets exceed RAM (connect-four and friends) trade memory for disk reads.
+// Requires a game with a hash (or `canonical_transpositions`).
+//
+// With a `budget`, the search is anytime: it polls the budget at every
+// node and, when it expires, abandons the current depth and returns the
+// result of the deepest fully completed iteration (entries written by
+// the abandoned iteration are kept out of the transposition table, so a
+// reused table stays sound). If the budget expires before the first
+// iteration completes, that iteration is finished anyway so a move is
+// always returned. The budget must outlive the call.
+std::pair<double, Action> IterativeDeepeningSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, bool canonical_transpositions = false,
+    DiskTranspositionTable* disk_table = nullptr,
+    TimeBudget* budget = nullptr);
+
+// Alpha-beta with the root moves split across `num_threads` workers. In the
+// young-brothers-wait style, the first root move is searched on the calling
+// thread with a full window to establish a bound; the remaining moves are
+// then searched in parallel, each picking up the bound of the best value
+// found so far. Returns the same value as `AlphaBetaSearch` (though the
+// chosen action may differ between equal-valued moves); the subtree
+// searches themselves are single-threaded, so the speedup comes from the
+// root fan-out. Arguments are as for `AlphaBetaSearch`.
+std::pair<double, Action> ParallelAlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player, int num_threads);
+
+// Expectiminimax for stochastic perfect-information 0-sum games: decision
+// nodes are searched as in `AlphaBetaSearch`, chance nodes take the
+// expectation over `ChanceOutcomes()` with Star1 pruning based on the
+// game's utility bounds. Arguments are as for `AlphaBetaSearch`; when
+// `maximizing_player` is `kInvalidPlayer` the search root must not be a
+// chance node, since the MAX player is taken from it.
+std::pair<double, Action> ExpectiminimaxSearch(
     const Game& game, const State* state,
     std::function<double(const State&)> value_function, int depth_limit,
     Player maximizing_player);
@@ -16,6 +16,7 @@
 
 #include <cmath>
 
+#include "open_spiel/games/chess.h"
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -64,6 +65,146 @@ void AlphaBetaSearchTest_TicTacToe_Loss() {
   SPIEL_CHECK_EQ(-1.0, value_and_action.first);
 }
 
+void IterativeDeepeningSearchTest_TicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::pair<double, Action> value_and_action =
+      IterativeDeepeningSearch(*game, nullptr, {}, -1, kInvalidPlayer);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+}
+
+void IterativeDeepeningSearchTest_TicTacToe_Win() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+
+  // With a (trivial) value function, every depth from 1 up runs, so this
+  // exercises reusing the previous iteration's best moves and the killers.
+  std::pair<double, Action> value_and_action = IterativeDeepeningSearch(
+      *game, state.get(), [](const State&) { return 0.0; }, -1,
+      kInvalidPlayer);
+  SPIEL_CHECK_EQ(1.0, value_and_action.first);
+}
+
+void IterativeDeepeningSearchTest_TicTacToe_CanonicalTT() {
+  // With the transposition table keyed on the canonical form, symmetric
+  // positions share entries; the search must still return the exact values
+  // and a move that is legal in the root's own orientation.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::pair<double, Action> value_and_action = IterativeDeepeningSearch(
+      *game, nullptr, {}, -1, kInvalidPlayer,
+      /*canonical_transpositions=*/true);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+  SPIEL_CHECK_GE(value_and_action.second, 0);
+  SPIEL_CHECK_LT(value_and_action.second, 9);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+  value_and_action = IterativeDeepeningSearch(
+      *game, state.get(), [](const State&) { return 0.0; }, -1,
+      kInvalidPlayer, /*canonical_transpositions=*/true);
+  SPIEL_CHECK_EQ(1.0, value_and_action.first);
+}
+
+void IterativeDeepeningSearchTest_TicTacToe_TimeBudget() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+
+  // A generous budget changes nothing: every depth completes.
+  TimeBudget generous(/*seconds=*/60.0);
+  std::pair<double, Action> value_and_action = IterativeDeepeningSearch(
+      *game, nullptr, [](const State&) { return 0.0; }, -1, kInvalidPlayer,
+      /*canonical_transpositions=*/false, /*disk_table=*/nullptr, &generous);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+
+  // An already-expired budget still returns a result, from finishing the
+  // shallowest iteration over budget.
+  TimeBudget expired(/*seconds=*/0.0);
+  value_and_action = IterativeDeepeningSearch(
+      *game, nullptr, [](const State&) { return 0.0; }, -1, kInvalidPlayer,
+      /*canonical_transpositions=*/false, /*disk_table=*/nullptr, &expired);
+  SPIEL_CHECK_GE(value_and_action.second, 0);
+  SPIEL_CHECK_LT(value_and_action.second, 9);
+}
+
+void ParallelAlphaBetaSearchTest_TicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::pair<double, Action> value_and_action = ParallelAlphaBetaSearch(
+      *game, nullptr, {}, -1, kInvalidPlayer, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+}
+
+void ParallelAlphaBetaSearchTest_TicTacToe_Loss() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  // Construct:
+  // ...
+  // xox
+  // ..o
+  state->ApplyAction(5);
+  state->ApplyAction(4);
+  state->ApplyAction(3);
+  state->ApplyAction(8);
+
+  std::pair<double, Action> value_and_action = ParallelAlphaBetaSearch(
+      *game, state.get(), {}, -1, kInvalidPlayer, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(-1.0, value_and_action.first);
+}
+
+void AlphaBetaSearchTest_TicTacToe_EvaluationCache() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  int num_evaluations = 0;
+  auto value_function = [&num_evaluations](const State&) {
+    ++num_evaluations;
+    return 0.0;
+  };
+
+  EvaluationCache cache(/*max_bytes=*/1 << 20);
+  std::pair<double, Action> first = AlphaBetaSearch(
+      *game, nullptr, value_function, /*depth_limit=*/4, kInvalidPlayer,
+      &cache);
+  const int first_evaluations = num_evaluations;
+  SPIEL_CHECK_GT(first_evaluations, 0);
+  SPIEL_CHECK_GT(cache.NumEntries(), 0);
+
+  // The second identical search must answer every leaf from the cache.
+  num_evaluations = 0;
+  std::pair<double, Action> second = AlphaBetaSearch(
+      *game, nullptr, value_function, /*depth_limit=*/4, kInvalidPlayer,
+      &cache);
+  SPIEL_CHECK_EQ(num_evaluations, 0);
+  SPIEL_CHECK_EQ(first.first, second.first);
+  SPIEL_CHECK_EQ(first.second, second.second);
+}
+
+void AlphaBetaSearchTest_Chess_MateInOne() {
+  // Chess provides staged action generation, so this exercises the lazy
+  // forcing-then-quiet move loop end to end. Back-rank mate in one: only
+  // Ra8# forces the win within the search depth.
+  std::shared_ptr<const Game> game = LoadGame("chess");
+  chess::ChessState state(game, "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1");
+  std::pair<double, Action> value_and_action = AlphaBetaSearch(
+      *game, &state, [](const State&) { return 0.0; },
+      /*depth_limit=*/2, state.CurrentPlayer());
+  SPIEL_CHECK_EQ(value_and_action.first, 1.0);
+  auto mate_move = state.Board().ParseLANMove("a1a8");
+  SPIEL_CHECK_TRUE(mate_move);
+  SPIEL_CHECK_EQ(value_and_action.second, chess::MoveToAction(*mate_move));
+}
+
+void ExpectiminimaxSearchTest_Pig() {
+  // A small pig: first player to 6 with a 3-sided die. Rolling until the
+  // win score is optimal for both, so the first player wins more often
+  // than not, and the value must stay a valid expectation.
+  std::shared_ptr<const Game> game =
+      LoadGame("pig(winscore=6,diceoutcomes=3,horizon=20)");
+  std::pair<double, Action> value_and_action = ExpectiminimaxSearch(
+      *game, nullptr, [](const State&) { return 0.0; }, 10, Player{0});
+  SPIEL_CHECK_GT(value_and_action.first, 0.0);
+  SPIEL_CHECK_LE(value_and_action.first, 1.0);
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -72,4 +213,14 @@ int main(int argc, char **argv) {
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Win();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Loss();
+  open_spiel::algorithms::IterativeDeepeningSearchTest_TicTacToe();
+  open_spiel::algorithms::IterativeDeepeningSearchTest_TicTacToe_Win();
+  open_spiel::algorithms::IterativeDeepeningSearchTest_TicTacToe_CanonicalTT();
+  open_spiel::algorithms::
+      IterativeDeepeningSearchTest_TicTacToe_TimeBudget();
+  open_spiel::algorithms::ParallelAlphaBetaSearchTest_TicTacToe();
+  open_spiel::algorithms::ParallelAlphaBetaSearchTest_TicTacToe_Loss();
+  open_spiel::algorithms::AlphaBetaSearchTest_Chess_MateInOne();
+  open_spiel::algorithms::ExpectiminimaxSearchTest_Pig();
+  open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_EvaluationCache();
 }
@@ -0,0 +1,58 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/observation_encoder.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+BatchedObservationEncoder::BatchedObservationEncoder(const Game& game,
+                                                     int batch_size,
+                                                     TensorType type)
+    : type_(type),
+      batch_size_(batch_size),
+      observation_size_(type == TensorType::kObservation
+                            ? game.ObservationNormalizedVectorSize()
+                            : game.InformationStateNormalizedVectorSize()),
+      group_(TaskPool::Global()) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  for (std::vector<double>& buffer : buffers_) {
+    buffer.assign(static_cast<size_t>(batch_size_) * observation_size_, 0.0);
+  }
+}
+
+void BatchedObservationEncoder::Submit(const State& state, Player player,
+                                       int slot) {
+  SPIEL_CHECK_GE(slot, 0);
+  SPIEL_CHECK_LT(slot, batch_size_);
+  double* row =
+      buffers_[fill_].data() + static_cast<size_t>(slot) * observation_size_;
+  group_.Spawn([this, &state, player, row]() {
+    if (type_ == TensorType::kObservation) {
+      state.ObservationAsNormalizedVector(player, row);
+    } else {
+      state.InformationStateAsNormalizedVector(player, row);
+    }
+  });
+}
+
+const std::vector<double>& BatchedObservationEncoder::SwapBuffers() {
+  group_.Sync();
+  const int ready = fill_;
+  fill_ = 1 - fill_;
+  return buffers_[ready];
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
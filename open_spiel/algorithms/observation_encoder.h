@@ -0,0 +1,79 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_ENCODER_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_ENCODER_H_
+
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A pipeline stage that turns states into rows of a contiguous observation
+// tensor on the shared TaskPool, decoupling simulation threads from
+// encoding cost: Submit only queues a task, and the tensor fill (the
+// expensive part for games like chess or hanabi) runs on the pool workers
+// through the buffer-filling State encoders, straight into the block.
+//
+// The block is double buffered. Producers submit rows of the fill buffer;
+// SwapBuffers waits for its outstanding rows, publishes it, and directs
+// subsequent submissions at the other buffer. A consumer can therefore
+// train on one batch while the workers encode the next, and the returned
+// block stays valid until the following swap.
+//
+// Any number of threads may call Submit concurrently (with distinct slots);
+// SwapBuffers is the batch boundary and must not race with Submit, which in
+// practice just means the producers hand the batch off before the consumer
+// swaps.
+class BatchedObservationEncoder {
+ public:
+  // Which of the game's tensors to encode.
+  enum class TensorType { kObservation, kInformationState };
+
+  // Buffers are [batch_size, observation_size] blocks of doubles, sized
+  // from the game's normalized-vector shape.
+  BatchedObservationEncoder(
+      const Game& game, int batch_size,
+      TensorType type = TensorType::kObservation);
+
+  int batch_size() const { return batch_size_; }
+  int observation_size() const { return observation_size_; }
+
+  // Schedules encoding of `state`, as seen by `player`, into row `slot` of
+  // the fill buffer. Returns immediately. The state must stay live (and
+  // unchanged) until the SwapBuffers call that publishes the slot returns.
+  void Submit(const State& state, Player player, int slot);
+
+  // Waits for every submitted row, publishes the fill buffer and returns
+  // it; later submissions target the other buffer. The reference is valid
+  // until the next SwapBuffers call. Unsubmitted slots keep the values
+  // they were published with last.
+  const std::vector<double>& SwapBuffers();
+
+ private:
+  const TensorType type_;
+  const int batch_size_;
+  const int observation_size_;
+  std::vector<double> buffers_[2];
+  int fill_ = 0;
+  TaskGroup group_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_ENCODER_H_
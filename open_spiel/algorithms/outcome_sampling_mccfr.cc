@@ -0,0 +1,191 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/outcome_sampling_mccfr.h"
+
+#include <numeric>
+#include <random>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+double RandomUniform(std::mt19937* rng) {
+  return std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+}
+
+}  // namespace
+
+OutcomeSamplingMCCFRSolver::OutcomeSamplingMCCFRSolver(const Game& game,
+                                                       double epsilon, int seed,
+                                                       AverageType avg_type)
+    : game_(game.Clone()),
+      epsilon_(epsilon),
+      rng_(new std::mt19937(seed)),
+      avg_type_(avg_type),
+      uniform_policy_(std::shared_ptr<TabularPolicy>(
+          new TabularPolicy(GetUniformPolicy(game)))) {
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "MCCFR requires sequential games. If you're trying to run it "
+        "on a simultaneous (or normal-form) game, please first transform it "
+        "using turn_based_simultaneous_game.");
+  }
+}
+
+void OutcomeSamplingMCCFRSolver::RunIteration() { RunIteration(rng_.get()); }
+
+void OutcomeSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
+  for (auto p = Player{0}; p < game_->NumPlayers(); ++p) {
+    SampleEpisode(*game_->NewInitialState(), p, rng, /*my_reach=*/1.0,
+                  /*opp_reach=*/1.0, /*sample_reach=*/1.0);
+  }
+
+  if (avg_type_ == AverageType::kFull) {
+    std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
+    FullUpdateAverage(*game_->NewInitialState(), reach_probs);
+  }
+}
+
+double OutcomeSamplingMCCFRSolver::SampleEpisode(const State& state,
+                                                 Player update_player,
+                                                 std::mt19937* rng,
+                                                 double my_reach,
+                                                 double opp_reach,
+                                                 double sample_reach) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(update_player);
+  } else if (state.IsChanceNode()) {
+    // Chance is sampled on-policy, so its probability cancels in the tail
+    // ratio and only the reach products pick it up.
+    std::pair<Action, double> outcome =
+        state.SampleChanceOutcome(RandomUniform(rng));
+    double prob = outcome.second;
+    return SampleEpisode(*state.Child(outcome.first), update_player, rng,
+                         my_reach, prob * opp_reach, prob * sample_reach);
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  Player cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationState(cur_player);
+  std::vector<Action> legal_actions = state.LegalActions();
+
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  auto iter_and_result = info_states_.insert(
+      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+
+  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  info_state_copy.ApplyRegretMatching();
+
+  // The updating player explores with epsilon-uniform mixing; everyone else
+  // is sampled on-policy.
+  const double exploration = (cur_player == update_player) ? epsilon_ : 0.0;
+  const int aidx =
+      info_state_copy.SampleActionIndex(exploration, RandomUniform(rng));
+  const double prob = info_state_copy.current_policy[aidx];
+  const double sample_prob =
+      exploration / legal_actions.size() + (1.0 - exploration) * prob;
+
+  const double child_value = SampleEpisode(
+      *state.Child(legal_actions[aidx]), update_player, rng,
+      cur_player == update_player ? my_reach * prob : my_reach,
+      cur_player == update_player ? opp_reach : opp_reach * prob,
+      sample_reach * sample_prob);
+  // Tail-corrected state value: the utility at the end of the episode times
+  // the product, from here down, of current policy over sampling policy.
+  const double value = child_value * prob / sample_prob;
+
+  CFRInfoStateValues& info_state = iter_and_result.first->second;
+
+  if (cur_player == update_player) {
+    // Counterfactual values: zero for the unsampled actions, and the
+    // importance-corrected child value for the sampled one.
+    const double cf_state_value = value * opp_reach / sample_reach;
+    for (int a = 0; a < legal_actions.size(); ++a) {
+      const double cf_action_value =
+          a == aidx ? child_value * opp_reach / (sample_reach * sample_prob)
+                    : 0.0;
+      info_state.cumulative_regrets[a] += (cf_action_value - cf_state_value);
+    }
+  }
+
+  // Simple average does averaging on the opponent node, like the external
+  // sampling solver; dividing by the sample reach corrects for how often
+  // this node is visited under the sampling policies.
+  if (avg_type_ == AverageType::kSimple &&
+      cur_player == ((update_player + 1) % game_->NumPlayers())) {
+    for (int a = 0; a < legal_actions.size(); ++a) {
+      info_state.cumulative_policy[a] +=
+          info_state_copy.current_policy[a] / sample_reach;
+    }
+  }
+
+  return value;
+}
+
+void OutcomeSamplingMCCFRSolver::FullUpdateAverage(
+    const State& state, const std::vector<double>& reach_probs) {
+  if (state.IsTerminal()) {
+    return;
+  } else if (state.IsChanceNode()) {
+    for (Action action : state.LegalActions()) {
+      FullUpdateAverage(*state.Child(action), reach_probs);
+    }
+    return;
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  // If all the probs are zero, no need to keep going.
+  double sum = std::accumulate(reach_probs.begin(), reach_probs.end(), 0.0);
+  if (sum == 0.0) return;
+
+  Player cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationState(cur_player);
+  std::vector<Action> legal_actions = state.LegalActions();
+
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  auto iter_and_result = info_states_.insert(
+      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+
+  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  info_state_copy.ApplyRegretMatching();
+
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    std::vector<double> new_reach_probs = reach_probs;
+    new_reach_probs[cur_player] *= info_state_copy.current_policy[aidx];
+    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
+  }
+
+  // Now update the cumulative policy.
+  CFRInfoStateValues& info_state = iter_and_result.first->second;
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    info_state.cumulative_policy[aidx] +=
+        (reach_probs[cur_player] * info_state_copy.current_policy[aidx]);
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
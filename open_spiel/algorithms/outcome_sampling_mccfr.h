@@ -0,0 +1,97 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"  // For AverageType.
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// An implementation of outcome sampling Monte Carlo Counterfactual Regret
+// Minimization (CFR). See Lanctot 2009 [0] and Chapter 4 of Lanctot 2013 [1]
+// for details.
+// [0]: http://mlanctot.info/files/papers/nips09mccfr.pdf
+// [1]: http://mlanctot.info/files/papers/PhD_Thesis_MarcLanctot.pdf
+//
+// Unlike external sampling, which walks over every action of the updating
+// player, an outcome sampling iteration touches a single trajectory per
+// player and importance-corrects the updates by the sampling probability.
+// The per-iteration cost is therefore one episode, at the price of higher
+// variance, which makes it the right trade-off for games where external
+// sampling cannot finish a pass. The updating player samples from an
+// epsilon-uniform mix of their current policy so that every trajectory has
+// positive probability.
+
+namespace open_spiel {
+namespace algorithms {
+
+class OutcomeSamplingMCCFRSolver {
+ public:
+  static inline constexpr double kInitialTableValues = 0.000001;
+  static inline constexpr double kDefaultEpsilon = 0.6;
+
+  // Creates a solver with a specific exploration parameter, seed, and
+  // average type (shared with the external sampling solver).
+  OutcomeSamplingMCCFRSolver(const Game& game, double epsilon = kDefaultEpsilon,
+                             int seed = 0,
+                             AverageType avg_type = AverageType::kSimple);
+
+  // Performs one iteration of outcome sampling MCCFR, sampling one episode
+  // per player and updating the regrets and average strategy. This method
+  // uses the internal random number generator.
+  void RunIteration();
+
+  // Same as above, but uses the specified random number generator instead.
+  void RunIteration(std::mt19937* rng);
+
+  // Computes the average policy, containing the policy for all players.
+  // The returned policy instance should only be used during the lifetime of
+  // the solver object.
+  std::unique_ptr<Policy> AveragePolicy() const {
+    return std::unique_ptr<Policy>(
+        new CFRAveragePolicy(info_states_, uniform_policy_));
+  }
+
+ private:
+  // Walks a single sampled episode. `my_reach` is the updating player's
+  // reach probability, `opp_reach` the product of all other players' (and
+  // chance's) reach probabilities, and `sample_reach` the probability the
+  // sampling policies assigned to reaching this state. Returns the episode
+  // utility for the updating player scaled by the tail ratio of current
+  // policy to sampling policy below this state, which makes the parent's
+  // importance corrections telescope.
+  double SampleEpisode(const State& state, Player update_player,
+                       std::mt19937* rng, double my_reach, double opp_reach,
+                       double sample_reach);
+  void FullUpdateAverage(const State& state,
+                         const std::vector<double>& reach_probs);
+
+  std::shared_ptr<const Game> game_;
+  double epsilon_;
+  std::unique_ptr<std::mt19937> rng_;
+  AverageType avg_type_;
+  CFRInfoStateValuesTable info_states_;
+  std::shared_ptr<TabularPolicy> uniform_policy_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
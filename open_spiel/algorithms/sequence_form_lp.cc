@@ -0,0 +1,453 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form_lp.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kTolerance = 1e-9;
+
+void CheckGameIsLPSolvable(const Game& game) {
+  GameType game_info = game.GetType();
+
+  if (game.NumPlayers() != 2) {
+    SpielFatalError(absl::StrCat("Game must be a 2-player game: ",
+                                 game.NumPlayers()));
+  }
+  if (game_info.chance_mode == GameType::ChanceMode::kSampledStochastic) {
+    SpielFatalError(absl::StrCat(
+        "The game must have explicit chance outcomes: ",
+        "GameType::ChanceMode::kSampledStochastic not supported."));
+  }
+  if (game_info.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        absl::StrCat("The game must be turn-based, not: ",
+                     game_info.dynamics == GameType::Dynamics::kSimultaneous
+                         ? "simultaneous"
+                         : "unknown"));
+  }
+  if (game_info.utility != GameType::Utility::kZeroSum) {
+    SpielFatalError(absl::StrCat("The game must be a zero-sum one, not: ",
+                                 static_cast<int>(game_info.utility)));
+  }
+}
+
+// --------------------------- Simplex solver ---------------------------
+//
+// A dense two-phase primal simplex for the LP in standard form
+//   max c.z  subject to  A z = b, z >= 0, b >= 0.
+// Entering columns are picked by the Dantzig rule; if the iteration count
+// suggests cycling the solver falls back to Bland's rule, which cannot
+// cycle. Sequence-form programs are heavily degenerate, so pivot counts —
+// and the dense tableau updates — grow quickly with game size; see the
+// header for the practical limits.
+class SimplexSolver {
+ public:
+  SimplexSolver(int num_rows, int num_cols)
+      : num_rows_(num_rows),
+        num_cols_(num_cols),
+        // Columns: the problem variables, one artificial per row (at most;
+        // see SetInitialBasis), and the rhs.
+        width_(num_cols + num_rows + 1),
+        tableau_(num_rows * width_, 0.0),
+        objective_(width_, 0.0),
+        basis_(num_rows, -1) {}
+
+  double& At(int row, int col) { return tableau_[row * width_ + col]; }
+  double& Rhs(int row) { return tableau_[row * width_ + width_ - 1]; }
+  void SetObjective(int col, double coeff) { objective_[col] = coeff; }
+
+  // Declares `col` basic in `row`, skipping the artificial variable for
+  // that row. The caller must have built the row with At(row, col) == 1 and
+  // the column appearing in no other row (e.g. a slack or surplus column).
+  // Sequence-form programs can seed most rows this way, which shrinks
+  // phase 1 to the handful of genuine equality constraints.
+  void SetInitialBasis(int row, int col) { basis_[row] = col; }
+
+  // Returns the optimal objective value and fills `solution` with the
+  // optimal values of the problem variables. Infeasible or unbounded
+  // programs are fatal errors; sequence-form programs are always feasible
+  // and bounded, so either indicates a bug in the caller.
+  double Solve(std::vector<double>* solution) {
+    // Phase 1: give every row without a designated basic column an
+    // artificial variable and maximize minus the artificials' sum, which is
+    // zero exactly at a feasible basis.
+    std::vector<double> phase1(width_, 0.0);
+    int next_artificial = num_cols_;
+    for (int row = 0; row < num_rows_; ++row) {
+      if (basis_[row] >= 0) continue;
+      basis_[row] = next_artificial;
+      At(row, next_artificial++) = 1.0;
+      for (int col = 0; col < width_; ++col) {
+        if (col < num_cols_ || col == width_ - 1) {
+          phase1[col] -= At(row, col);
+        }
+      }
+    }
+    RunPivots(&phase1, /*allow_artificial=*/true);
+    if (phase1[width_ - 1] < -1e-7) {
+      SpielFatalError("Sequence-form LP is infeasible.");
+    }
+    // Degenerate basic artificials (at value zero) must not re-enter nor
+    // drift positive, so pivot them out where possible; an all-zero row is
+    // redundant and can stay, its artificial never changes value again.
+    for (int row = 0; row < num_rows_; ++row) {
+      if (basis_[row] < num_cols_) continue;
+      for (int col = 0; col < num_cols_; ++col) {
+        if (std::abs(At(row, col)) > kTolerance) {
+          Pivot(row, col, &phase1);
+          break;
+        }
+      }
+    }
+
+    // Phase 2: the real objective, with basic columns eliminated so their
+    // reduced costs start at zero.
+    std::vector<double> reduced(width_, 0.0);
+    for (int col = 0; col < num_cols_; ++col) reduced[col] = -objective_[col];
+    for (int row = 0; row < num_rows_; ++row) {
+      const double coeff = basis_[row] < num_cols_ ? objective_[basis_[row]]
+                                                   : 0.0;
+      if (coeff == 0.0) continue;
+      for (int col = 0; col < width_; ++col) {
+        reduced[col] += coeff * At(row, col);
+      }
+    }
+    RunPivots(&reduced, /*allow_artificial=*/false);
+
+    solution->assign(num_cols_, 0.0);
+    for (int row = 0; row < num_rows_; ++row) {
+      if (basis_[row] < num_cols_) (*solution)[basis_[row]] = Rhs(row);
+    }
+    return reduced[width_ - 1];
+  }
+
+ private:
+  // Pivots until no entering column improves `objective_row`.
+  void RunPivots(std::vector<double>* objective_row, bool allow_artificial) {
+    const int max_col = allow_artificial ? num_cols_ + num_rows_ : num_cols_;
+    const int64_t dantzig_limit =
+        10000 + 50 * static_cast<int64_t>(num_rows_ + num_cols_);
+    bool blands_rule = false;
+    for (int64_t iteration = 0;; ++iteration) {
+      if (iteration > dantzig_limit) blands_rule = true;
+      if (iteration > 100 * dantzig_limit) {
+        SpielFatalError("Sequence-form LP simplex failed to terminate.");
+      }
+      // Entering column: most negative reduced cost (Dantzig), or the
+      // first negative one (Bland) once cycling is suspected.
+      int entering = -1;
+      double best = -kTolerance;
+      for (int col = 0; col < max_col; ++col) {
+        if ((*objective_row)[col] < best) {
+          entering = col;
+          best = (*objective_row)[col];
+          if (blands_rule) break;
+        }
+      }
+      if (entering < 0) return;  // Optimal.
+
+      // Leaving row: minimum ratio, ties by smallest basis index (Bland).
+      int leaving = -1;
+      double best_ratio = 0;
+      for (int row = 0; row < num_rows_; ++row) {
+        const double coeff = At(row, entering);
+        if (coeff <= kTolerance) continue;
+        const double ratio = Rhs(row) / coeff;
+        if (leaving < 0 || ratio < best_ratio - kTolerance ||
+            (ratio < best_ratio + kTolerance &&
+             basis_[row] < basis_[leaving])) {
+          leaving = row;
+          best_ratio = ratio;
+        }
+      }
+      if (leaving < 0) {
+        SpielFatalError("Sequence-form LP is unbounded.");
+      }
+      Pivot(leaving, entering, objective_row);
+    }
+  }
+
+  // Row operations visit only the pivot row's nonzero columns: the tableau
+  // starts sparse and fills in slowly, so this is where the solver's time
+  // goes. Updated entries below the dust threshold are snapped to zero to
+  // keep the fill-in (and the accumulated round-off) down.
+  void Pivot(int pivot_row, int pivot_col, std::vector<double>* objective_row) {
+    constexpr double kDust = 1e-12;
+    const double inverse = 1.0 / At(pivot_row, pivot_col);
+    nonzero_cols_.clear();
+    for (int col = 0; col < width_; ++col) {
+      double& value = At(pivot_row, col);
+      if (value == 0.0) continue;
+      value *= inverse;
+      nonzero_cols_.push_back(col);
+    }
+    At(pivot_row, pivot_col) = 1.0;
+    for (int row = 0; row < num_rows_; ++row) {
+      if (row == pivot_row) continue;
+      const double factor = At(row, pivot_col);
+      if (factor == 0.0) continue;
+      for (int col : nonzero_cols_) {
+        double& value = At(row, col);
+        value -= factor * At(pivot_row, col);
+        if (std::abs(value) < kDust) value = 0.0;
+      }
+      At(row, pivot_col) = 0.0;
+    }
+    const double factor = (*objective_row)[pivot_col];
+    if (factor != 0.0) {
+      for (int col : nonzero_cols_) {
+        (*objective_row)[col] -= factor * At(pivot_row, col);
+      }
+      (*objective_row)[pivot_col] = 0.0;
+    }
+    basis_[pivot_row] = pivot_col;
+  }
+
+  const int num_rows_;
+  const int num_cols_;
+  const int width_;
+  std::vector<double> tableau_;
+  std::vector<double> objective_;
+  std::vector<int> basis_;
+  std::vector<int> nonzero_cols_;  // Pivot-row scratch.
+};
+
+// ------------------------- Sequence extraction -------------------------
+
+// One information set of a player: where its sequences branch off from.
+struct InfoSetData {
+  std::string info_state;
+  int parent_sequence;
+  std::vector<Action> legal_actions;
+  std::vector<int> action_sequences;  // Sequence id reached by each action.
+};
+
+// A player's sequences and information sets. Sequence 0 is the empty
+// sequence (the player has not acted yet); every other sequence is owned by
+// exactly one information set, whose realization constraint introduces it.
+struct SequenceFormData {
+  std::map<std::string, int> info_set_index;
+  std::vector<InfoSetData> info_sets;
+  int num_sequences = 1;
+};
+
+// Walks the game tree accumulating both players' sequence structures and
+// the sparse payoff matrix A[(seq0, seq1)] = chance-weighted return to
+// player 0 over the terminals consistent with that sequence pair.
+void BuildSequenceData(const State& state, double chance_reach, int seq0,
+                       int seq1, std::array<SequenceFormData, 2>* data,
+                       std::map<std::pair<int, int>, double>* payoffs) {
+  if (state.IsTerminal()) {
+    (*payoffs)[{seq0, seq1}] += chance_reach * state.PlayerReturn(0);
+    return;
+  }
+  if (state.IsChanceNode()) {
+    for (const auto& outcome : state.ChanceOutcomes()) {
+      BuildSequenceData(*state.Child(outcome.first),
+                        chance_reach * outcome.second, seq0, seq1, data,
+                        payoffs);
+    }
+    return;
+  }
+
+  const Player player = state.CurrentPlayer();
+  SPIEL_CHECK_TRUE(player == Player{0} || player == Player{1});
+  SequenceFormData& player_data = (*data)[player];
+  const int parent_sequence = player == Player{0} ? seq0 : seq1;
+  const std::string info_state = state.InformationState(player);
+
+  auto [iter, inserted] = player_data.info_set_index.emplace(
+      info_state, player_data.info_sets.size());
+  if (inserted) {
+    InfoSetData info_set;
+    info_set.info_state = info_state;
+    info_set.parent_sequence = parent_sequence;
+    info_set.legal_actions = state.LegalActions();
+    for (int aidx = 0; aidx < info_set.legal_actions.size(); ++aidx) {
+      info_set.action_sequences.push_back(player_data.num_sequences++);
+    }
+    player_data.info_sets.push_back(std::move(info_set));
+  } else if (player_data.info_sets[iter->second].parent_sequence !=
+             parent_sequence) {
+    // Two histories in one information set with different own-action pasts.
+    SpielFatalError(absl::StrCat(
+        "Sequence-form LP requires perfect recall; violated at info state: ",
+        info_state));
+  }
+
+  // Copies: the recursion below appends to info_sets and may reallocate.
+  const std::vector<Action> legal_actions =
+      player_data.info_sets[iter->second].legal_actions;
+  const std::vector<int> action_sequences =
+      player_data.info_sets[iter->second].action_sequences;
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    const int sequence = action_sequences[aidx];
+    BuildSequenceData(*state.Child(legal_actions[aidx]), chance_reach,
+                      player == Player{0} ? sequence : seq0,
+                      player == Player{1} ? sequence : seq1, data, payoffs);
+  }
+}
+
+// ---------------------------- LP assembly ----------------------------
+
+// Solves for `maximizer`'s equilibrium realization plan x:
+//   max  q_0   s.t.   E x = e,   Aᵀ x - Fᵀ q >= 0,   x >= 0,
+// where E and F are the players' realization constraints and q is free
+// (one component per opponent constraint). q_0 is the value of the inner
+// minimization, i.e. the game value for the maximizer. Returns that value
+// and fills `realization` with x, indexed by the maximizer's sequences.
+double SolveForPlayer(const SequenceFormData& max_data,
+                      const SequenceFormData& opp_data,
+                      const std::map<std::pair<int, int>, double>& payoffs,
+                      Player maximizer, std::vector<double>* realization) {
+  const int num_max_sequences = max_data.num_sequences;
+  const int num_opp_sequences = opp_data.num_sequences;
+  const int num_max_constraints = 1 + max_data.info_sets.size();
+  const int num_opp_constraints = 1 + opp_data.info_sets.size();
+
+  // Variable layout: x, then q split into positive and negative parts (the
+  // standard form needs nonnegative variables), then one surplus per
+  // opponent sequence turning the payoff inequalities into equalities.
+  const int x0 = 0;
+  const int qp0 = num_max_sequences;
+  const int qn0 = qp0 + num_opp_constraints;
+  const int s0 = qn0 + num_opp_constraints;
+  const int num_cols = s0 + num_opp_sequences;
+  const int num_rows = num_max_constraints + num_opp_sequences;
+
+  SimplexSolver lp(num_rows, num_cols);
+
+  // E x = e: the empty sequence is played with probability one, and each
+  // information set spreads its parent sequence's mass over its actions.
+  lp.At(0, x0) = 1.0;
+  lp.Rhs(0) = 1.0;
+  for (int i = 0; i < max_data.info_sets.size(); ++i) {
+    const InfoSetData& info_set = max_data.info_sets[i];
+    lp.At(1 + i, x0 + info_set.parent_sequence) -= 1.0;
+    for (int sequence : info_set.action_sequences) {
+      lp.At(1 + i, x0 + sequence) += 1.0;
+    }
+  }
+
+  // Aᵀ x - Fᵀ q >= 0, one row per opponent sequence, stored negated as
+  // -Aᵀ x + Fᵀ q + s = 0 so that the surplus column can seed the basis
+  // (b = 0 makes the all-surplus start feasible and keeps phase 1 small).
+  const int payoff_row = num_max_constraints;
+  for (const auto& [sequences, value] : payoffs) {
+    const int max_seq =
+        maximizer == Player{0} ? sequences.first : sequences.second;
+    const int opp_seq =
+        maximizer == Player{0} ? sequences.second : sequences.first;
+    const double max_value = maximizer == Player{0} ? value : -value;
+    lp.At(payoff_row + opp_seq, x0 + max_seq) -= max_value;
+  }
+  // Column j of F holds +1 from the constraint row of the information set
+  // owning sequence j, and -1 from each row whose parent sequence is j.
+  lp.At(payoff_row + 0, qp0) += 1.0;
+  lp.At(payoff_row + 0, qn0) -= 1.0;
+  for (int k = 0; k < opp_data.info_sets.size(); ++k) {
+    const InfoSetData& info_set = opp_data.info_sets[k];
+    lp.At(payoff_row + info_set.parent_sequence, qp0 + 1 + k) -= 1.0;
+    lp.At(payoff_row + info_set.parent_sequence, qn0 + 1 + k) += 1.0;
+    for (int sequence : info_set.action_sequences) {
+      lp.At(payoff_row + sequence, qp0 + 1 + k) += 1.0;
+      lp.At(payoff_row + sequence, qn0 + 1 + k) -= 1.0;
+    }
+  }
+  for (int j = 0; j < num_opp_sequences; ++j) {
+    lp.At(payoff_row + j, s0 + j) = 1.0;
+    lp.SetInitialBasis(payoff_row + j, s0 + j);
+  }
+
+  // Maximize q_0, the root component of the opponent's best-response dual.
+  lp.SetObjective(qp0, 1.0);
+  lp.SetObjective(qn0, -1.0);
+
+  std::vector<double> solution;
+  const double value = lp.Solve(&solution);
+  realization->assign(solution.begin(), solution.begin() + num_max_sequences);
+  return value;
+}
+
+// Converts a realization plan into behavior probabilities at each of the
+// player's information sets. Information sets the plan never reaches get a
+// uniform policy; any completion there preserves the equilibrium.
+void RealizationToBehavior(
+    const SequenceFormData& data, const std::vector<double>& realization,
+    std::unordered_map<std::string, ActionsAndProbs>* policy_table) {
+  for (const InfoSetData& info_set : data.info_sets) {
+    ActionsAndProbs actions_and_probs;
+    const double parent_mass = realization[info_set.parent_sequence];
+    double sum_prob = 0.0;
+    std::vector<double> probs(info_set.legal_actions.size());
+    for (int aidx = 0; aidx < info_set.legal_actions.size(); ++aidx) {
+      probs[aidx] = std::max(0.0, realization[info_set.action_sequences[aidx]]);
+      sum_prob += probs[aidx];
+    }
+    for (int aidx = 0; aidx < info_set.legal_actions.size(); ++aidx) {
+      const double prob = (parent_mass > kTolerance && sum_prob > 0)
+                              ? probs[aidx] / sum_prob
+                              : 1.0 / info_set.legal_actions.size();
+      actions_and_probs.push_back({info_set.legal_actions[aidx], prob});
+    }
+    (*policy_table)[info_set.info_state] = std::move(actions_and_probs);
+  }
+}
+
+}  // namespace
+
+SequenceFormLPSolution SolveSequenceFormLP(const Game& game) {
+  CheckGameIsLPSolvable(game);
+
+  std::array<SequenceFormData, 2> data;
+  std::map<std::pair<int, int>, double> payoffs;
+  std::unique_ptr<State> root = game.NewInitialState();
+  BuildSequenceData(*root, /*chance_reach=*/1.0, /*seq0=*/0, /*seq1=*/0, &data,
+                    &payoffs);
+
+  std::vector<double> realization0;
+  std::vector<double> realization1;
+  const double value0 =
+      SolveForPlayer(data[0], data[1], payoffs, Player{0}, &realization0);
+  const double value1 =
+      SolveForPlayer(data[1], data[0], payoffs, Player{1}, &realization1);
+  // The two one-sided solves bound the same saddle point.
+  SPIEL_CHECK_FLOAT_NEAR(value0, -value1, 1e-6);
+
+  SequenceFormLPSolution solution;
+  solution.game_value = value0;
+  std::unordered_map<std::string, ActionsAndProbs> policy_table;
+  RealizationToBehavior(data[0], realization0, &policy_table);
+  RealizationToBehavior(data[1], realization1, &policy_table);
+  solution.policy = TabularPolicy(policy_table);
+  return solution;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
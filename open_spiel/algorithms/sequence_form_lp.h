@@ -0,0 +1,55 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_LP_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_LP_H_
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// An exact equilibrium of a two-player zero-sum game, computed by linear
+// programming over the sequence form.
+struct SequenceFormLPSolution {
+  // The root value of the game for player 0 (player 1's value is its
+  // negation).
+  double game_value;
+
+  // An equilibrium behavior policy for both players, keyed on information
+  // state strings like every other tabular policy.
+  TabularPolicy policy;
+};
+
+// Solves a two-player zero-sum sequential game exactly via the sequence-form
+// linear program of Koller, Megiddo & von Stengel: one variable per sequence
+// of information-set/action pairs, so the program is linear in the size of
+// the game tree rather than exponential like the normal form. One LP is
+// solved per player with a bundled dense two-phase simplex.
+//
+// Unlike iterative methods (CFR, fictitious play) the result is exact up to
+// floating point, which makes this the reference solver for verifying them
+// on small games. The bundled simplex keeps a dense tableau, so this is
+// practical for kuhn_poker-sized games but degrades quickly beyond a few
+// hundred sequences per player; leduc-scale games need a sparse LP solver.
+// The game must be zero-sum, sequential, with explicit chance outcomes and
+// perfect recall (violations are detected and fatal). Simultaneous-move
+// games can be solved through ConvertToTurnBased.
+SequenceFormLPSolution SolveSequenceFormLP(const Game& game);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_LP_H_
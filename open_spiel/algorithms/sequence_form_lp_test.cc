@@ -0,0 +1,62 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form_lp.h"
+
+#include <memory>
+
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void KuhnPokerExactSolveTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  SequenceFormLPSolution solution = SolveSequenceFormLP(*game);
+  // The known value of Kuhn poker is -1/18 for the first player.
+  SPIEL_CHECK_FLOAT_NEAR(solution.game_value, -1.0 / 18.0, 1e-9);
+  SPIEL_CHECK_LE(Exploitability(*game, solution.policy), 1e-9);
+}
+
+void MatchingPenniesSolveTest() {
+  // A simultaneous-move game is solvable through its turn-based transform.
+  std::shared_ptr<const Game> game = LoadGameAsTurnBased("matrix_mp");
+  SequenceFormLPSolution solution = SolveSequenceFormLP(*game);
+  SPIEL_CHECK_FLOAT_NEAR(solution.game_value, 0.0, 1e-9);
+  // MatrixGame does not implement UtilitySum, so check NashConv instead.
+  SPIEL_CHECK_LE(NashConv(*game, solution.policy), 1e-9);
+}
+
+void RockPaperScissorsSolveTest() {
+  // The equilibrium is fully mixed, so this exercises a solution interior
+  // to the realization polytope rather than a pure one.
+  std::shared_ptr<const Game> game = LoadGameAsTurnBased("matrix_rps");
+  SequenceFormLPSolution solution = SolveSequenceFormLP(*game);
+  SPIEL_CHECK_FLOAT_NEAR(solution.game_value, 0.0, 1e-9);
+  SPIEL_CHECK_LE(NashConv(*game, solution.policy), 1e-9);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::KuhnPokerExactSolveTest();
+  open_spiel::algorithms::MatchingPenniesSolveTest();
+  open_spiel::algorithms::RockPaperScissorsSolveTest();
+}
@@ -0,0 +1,504 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tablebase.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Format marker for tablebase files; bump when the layout changes.
+constexpr char kTablebaseFileMagic[8] = {'O', 'S', 'T', 'A', 'B', 'v', '0',
+                                         '1'};
+
+// Number of two-bit values packed into one 64-bit word.
+constexpr int kValuesPerWord = 32;
+
+// The same position is a win for one player exactly when it is a loss for
+// the other; draws are shared. Zero-sum lets values switch perspective.
+TablebaseValue Negate(TablebaseValue value) {
+  switch (value) {
+    case TablebaseValue::kWin:
+      return TablebaseValue::kLoss;
+    case TablebaseValue::kLoss:
+      return TablebaseValue::kWin;
+    default:
+      return value;
+  }
+}
+
+// Retrograde analysis needs exact position keys and the win/loss/draw value
+// notion, so the requirements are those of the alpha-beta searches plus a
+// position hash.
+void CheckGameIsTablable(const Game& game) {
+  if (!game.ProvidesHashValue()) {
+    SpielFatalError(
+        "Tablebase requires a game with Game::ProvidesHashValue().");
+  }
+  if (game.NumPlayers() != 2) {
+    SpielFatalError("Game must be a 2-player game");
+  }
+  GameType game_info = game.GetType();
+  if (game_info.chance_mode != GameType::ChanceMode::kDeterministic) {
+    SpielFatalError(absl::StrCat("The game must be a Deterministic one, not ",
+                                 game_info.chance_mode));
+  }
+  if (game_info.information != GameType::Information::kPerfectInformation) {
+    SpielFatalError(
+        absl::StrCat("The game must be a perfect information one, not ",
+                     game_info.information));
+  }
+  if (game_info.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        absl::StrCat("The game must be turn-based, not ", game_info.dynamics));
+  }
+  if (game_info.utility != GameType::Utility::kZeroSum) {
+    SpielFatalError(
+        absl::StrCat("The game must be 0-sum, not  ", game_info.utility));
+  }
+}
+
+// Per-position metadata gathered during enumeration. The solve itself runs
+// on separate atomic arrays indexed the same way, so workers can share them.
+// Terminal nodes carry their value from player 0's perspective with
+// `to_move` set to player 0, which makes the perspective switch in the
+// backward pass uniform across terminal and solved positions.
+struct BuildNode {
+  uint64_t key;
+  Player to_move;
+  TablebaseValue terminal_value;  // kUnknown for non-terminal positions.
+  int64_t first_child = 0;
+  int32_t num_children = 0;
+};
+
+TablebaseValue SignToValue(double return_value) {
+  if (return_value > 0) return TablebaseValue::kWin;
+  if (return_value < 0) return TablebaseValue::kLoss;
+  return TablebaseValue::kDraw;
+}
+
+BuildNode MakeBuildNode(const State& state, uint64_t key) {
+  BuildNode node;
+  node.key = key;
+  if (state.IsTerminal()) {
+    node.to_move = Player{0};
+    node.terminal_value = SignToValue(state.Returns()[0]);
+  } else {
+    node.to_move = state.CurrentPlayer();
+    node.terminal_value = TablebaseValue::kUnknown;
+  }
+  return node;
+}
+
+}  // namespace
+
+std::unique_ptr<Tablebase> Tablebase::Build(const Game& game,
+                                            const State* root,
+                                            int num_threads) {
+  CheckGameIsTablable(game);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  std::vector<BuildNode> nodes;
+  std::vector<int32_t> children;
+  std::unordered_map<uint64_t, int32_t> index;
+
+  // Breadth-first enumeration, one level at a time: workers expand the
+  // frontier states in parallel, then a serial merge deduplicates the
+  // children and assigns node indices, as in GetAllStatesParallel.
+  std::vector<std::unique_ptr<State>> frontier_states;
+  std::vector<int32_t> frontier_nodes;
+  std::unique_ptr<State> initial =
+      root == nullptr ? game.NewInitialState() : root->Clone();
+  {
+    const uint64_t key = initial->HashValue();
+    const bool terminal = initial->IsTerminal();
+    index[key] = 0;
+    nodes.push_back(MakeBuildNode(*initial, key));
+    if (!terminal) {
+      frontier_states.push_back(std::move(initial));
+      frontier_nodes.push_back(0);
+    }
+  }
+
+  // A child produced by a worker during one level, before the serial merge
+  // has decided whether the position is new.
+  struct ChildRecord {
+    BuildNode node;
+    std::unique_ptr<State> state;
+  };
+
+  while (!frontier_states.empty()) {
+    std::vector<std::vector<ChildRecord>> expanded(frontier_states.size());
+    std::atomic<int64_t> work_index(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back([&]() {
+        const int64_t frontier_size = frontier_states.size();
+        for (int64_t i = work_index++; i < frontier_size; i = work_index++) {
+          State* state = frontier_states[i].get();
+          for (Action action : state->LegalActions()) {
+            std::unique_ptr<State> child = state->Child(action);
+            ChildRecord record;
+            record.node = MakeBuildNode(*child, child->HashValue());
+            record.state = std::move(child);
+            expanded[i].push_back(std::move(record));
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    std::vector<std::unique_ptr<State>> next_frontier_states;
+    std::vector<int32_t> next_frontier_nodes;
+    for (int64_t i = 0; i < static_cast<int64_t>(expanded.size()); ++i) {
+      const int32_t parent = frontier_nodes[i];
+      nodes[parent].first_child = children.size();
+      nodes[parent].num_children = expanded[i].size();
+      for (ChildRecord& record : expanded[i]) {
+        auto insertion = index.emplace(record.node.key,
+                                       static_cast<int32_t>(nodes.size()));
+        if (insertion.second) {
+          SPIEL_CHECK_LT(static_cast<int64_t>(nodes.size()),
+                         std::numeric_limits<int32_t>::max());
+          const bool terminal =
+              record.node.terminal_value != TablebaseValue::kUnknown;
+          nodes.push_back(record.node);
+          if (!terminal) {
+            next_frontier_states.push_back(std::move(record.state));
+            next_frontier_nodes.push_back(insertion.first->second);
+          }
+        }
+        children.push_back(insertion.first->second);
+      }
+      // Free the expanded parent before moving on; only the unique children
+      // are carried to the next level.
+      frontier_states[i].reset();
+    }
+    frontier_states = std::move(next_frontier_states);
+    frontier_nodes = std::move(next_frontier_nodes);
+  }
+  index.clear();
+
+  // Invert the child links into a CSR predecessor array; the backward pass
+  // walks these edges.
+  const int64_t num_nodes = nodes.size();
+  std::vector<int64_t> pred_offset(num_nodes + 1, 0);
+  for (int32_t child : children) ++pred_offset[child + 1];
+  for (int64_t i = 0; i < num_nodes; ++i) pred_offset[i + 1] += pred_offset[i];
+  std::vector<int32_t> preds(children.size());
+  {
+    std::vector<int64_t> fill(pred_offset.begin(), pred_offset.end() - 1);
+    for (int64_t parent = 0; parent < num_nodes; ++parent) {
+      for (int32_t c = 0; c < nodes[parent].num_children; ++c) {
+        const int32_t child = children[nodes[parent].first_child + c];
+        preds[fill[child]++] = static_cast<int32_t>(parent);
+      }
+    }
+  }
+
+  // Backward propagation in waves. Each wave holds freshly decided
+  // positions; workers push their consequences to the predecessors. A
+  // predecessor becomes a win as soon as one child is a loss for the side
+  // to move there — the compare-exchange makes exactly one worker claim it —
+  // and becomes a draw or loss when its last non-winning child resolves:
+  // the counter reaches zero only if no child was a win for it, since
+  // winning children claim the parent instead of decrementing. Positions no
+  // wave ever decides can only be realized by play that cycles forever, so
+  // they are draws.
+  std::vector<std::atomic<uint8_t>> values(num_nodes);
+  std::vector<std::atomic<int32_t>> undecided(num_nodes);
+  std::vector<std::atomic<uint8_t>> has_drawing_child(num_nodes);
+  std::vector<int32_t> wave;
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    undecided[i].store(nodes[i].num_children, std::memory_order_relaxed);
+    has_drawing_child[i].store(0, std::memory_order_relaxed);
+    values[i].store(static_cast<uint8_t>(nodes[i].terminal_value),
+                    std::memory_order_relaxed);
+    if (nodes[i].terminal_value != TablebaseValue::kUnknown) {
+      wave.push_back(static_cast<int32_t>(i));
+    }
+  }
+
+  while (!wave.empty()) {
+    std::vector<std::vector<int32_t>> next_waves(num_threads);
+    std::atomic<int64_t> work_index(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back([&, t]() {
+        const int64_t wave_size = wave.size();
+        for (int64_t i = work_index++; i < wave_size; i = work_index++) {
+          const int32_t child = wave[i];
+          const TablebaseValue child_value =
+              static_cast<TablebaseValue>(values[child].load());
+          for (int64_t e = pred_offset[child]; e < pred_offset[child + 1];
+               ++e) {
+            const int32_t parent = preds[e];
+            const TablebaseValue for_parent =
+                nodes[parent].to_move == nodes[child].to_move
+                    ? child_value
+                    : Negate(child_value);
+            if (for_parent == TablebaseValue::kWin) {
+              uint8_t expected =
+                  static_cast<uint8_t>(TablebaseValue::kUnknown);
+              if (values[parent].compare_exchange_strong(
+                      expected, static_cast<uint8_t>(TablebaseValue::kWin))) {
+                next_waves[t].push_back(parent);
+              }
+              continue;
+            }
+            if (for_parent == TablebaseValue::kDraw) {
+              has_drawing_child[parent].store(1);
+            }
+            if (undecided[parent].fetch_sub(1) == 1) {
+              uint8_t expected =
+                  static_cast<uint8_t>(TablebaseValue::kUnknown);
+              const uint8_t resolved = static_cast<uint8_t>(
+                  has_drawing_child[parent].load() != 0
+                      ? TablebaseValue::kDraw
+                      : TablebaseValue::kLoss);
+              if (values[parent].compare_exchange_strong(expected, resolved)) {
+                next_waves[t].push_back(parent);
+              }
+            }
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    wave.clear();
+    for (std::vector<int32_t>& next_wave : next_waves) {
+      wave.insert(wave.end(), next_wave.begin(), next_wave.end());
+    }
+  }
+
+  // Emit the non-terminal positions sorted by key, packing the values two
+  // bits each; terminal positions are visible to callers through `Returns`
+  // and would only bloat the table.
+  std::vector<std::pair<uint64_t, uint8_t>> entries;
+  entries.reserve(num_nodes);
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    if (nodes[i].terminal_value != TablebaseValue::kUnknown) continue;
+    uint8_t value = values[i].load(std::memory_order_relaxed);
+    if (value == static_cast<uint8_t>(TablebaseValue::kUnknown)) {
+      value = static_cast<uint8_t>(TablebaseValue::kDraw);
+    }
+    entries.push_back({nodes[i].key, value});
+  }
+  std::sort(entries.begin(), entries.end());
+
+  std::unique_ptr<Tablebase> tablebase(new Tablebase);
+  tablebase->num_positions_ = entries.size();
+  tablebase->owned_keys_.reserve(entries.size());
+  tablebase->owned_values_.assign(
+      (entries.size() + kValuesPerWord - 1) / kValuesPerWord, 0);
+  for (int64_t i = 0; i < static_cast<int64_t>(entries.size()); ++i) {
+    tablebase->owned_keys_.push_back(entries[i].first);
+    tablebase->owned_values_[i / kValuesPerWord] |=
+        static_cast<uint64_t>(entries[i].second)
+        << (2 * (i % kValuesPerWord));
+  }
+  tablebase->keys_ = tablebase->owned_keys_.data();
+  tablebase->values_ = tablebase->owned_values_.data();
+  return tablebase;
+}
+
+std::unique_ptr<Tablebase> Tablebase::LoadFromFile(
+    const std::string& filename) {
+  std::unique_ptr<Tablebase> tablebase(new Tablebase);
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("Cannot open tablebase file: ", filename));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Cannot stat tablebase file: ", filename));
+  }
+  tablebase->mapping_size_ = file_stat.st_size;
+  const uint64_t header_size = sizeof(kTablebaseFileMagic) + sizeof(int64_t);
+  if (tablebase->mapping_size_ < header_size) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Tablebase file too short: ", filename));
+  }
+  tablebase->mapping_ =
+      mmap(nullptr, tablebase->mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (tablebase->mapping_ == MAP_FAILED) {
+    tablebase->mapping_ = nullptr;
+    SpielFatalError(absl::StrCat("Cannot map tablebase file: ", filename));
+  }
+  const char* base = static_cast<const char*>(tablebase->mapping_);
+  if (std::memcmp(base, kTablebaseFileMagic, sizeof(kTablebaseFileMagic)) !=
+      0) {
+    SpielFatalError(absl::StrCat("Not a tablebase file: ", filename));
+  }
+  tablebase->num_positions_ = *reinterpret_cast<const int64_t*>(
+      base + sizeof(kTablebaseFileMagic));
+  tablebase->keys_ = reinterpret_cast<const uint64_t*>(base + header_size);
+  tablebase->values_ = tablebase->keys_ + tablebase->num_positions_;
+  const int64_t num_words =
+      (tablebase->num_positions_ + kValuesPerWord - 1) / kValuesPerWord;
+  const char* end = reinterpret_cast<const char*>(
+      tablebase->values_ + num_words);
+  if (static_cast<uint64_t>(end - base) != tablebase->mapping_size_) {
+    SpielFatalError(absl::StrCat("Truncated tablebase file: ", filename));
+  }
+  return tablebase;
+}
+
+Tablebase::~Tablebase() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+}
+
+void Tablebase::SaveToFile(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open tablebase file: ", filename));
+  }
+  file.write(kTablebaseFileMagic, sizeof(kTablebaseFileMagic));
+  file.write(reinterpret_cast<const char*>(&num_positions_),
+             sizeof(num_positions_));
+  file.write(reinterpret_cast<const char*>(keys_),
+             num_positions_ * sizeof(uint64_t));
+  const int64_t num_words =
+      (num_positions_ + kValuesPerWord - 1) / kValuesPerWord;
+  file.write(reinterpret_cast<const char*>(values_),
+             num_words * sizeof(uint64_t));
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing tablebase file: ", filename));
+  }
+}
+
+TablebaseValue Tablebase::Probe(const State& state) const {
+  return ProbeKey(state.HashValue());
+}
+
+TablebaseValue Tablebase::ProbeKey(uint64_t key) const {
+  int64_t lo = 0;
+  int64_t hi = num_positions_;
+  while (lo < hi) {
+    const int64_t mid = (lo + hi) / 2;
+    if (keys_[mid] == key) {
+      return static_cast<TablebaseValue>(
+          (values_[mid / kValuesPerWord] >> (2 * (mid % kValuesPerWord))) & 3);
+    } else if (keys_[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return TablebaseValue::kUnknown;
+}
+
+std::function<double(const State&)> TablebaseValueFunction(
+    std::shared_ptr<const Tablebase> tablebase, Player maximizing_player) {
+  return [tablebase, maximizing_player](const State& state) {
+    TablebaseValue value = tablebase->Probe(state);
+    if (value == TablebaseValue::kUnknown) return 0.0;
+    if (state.CurrentPlayer() != maximizing_player) value = Negate(value);
+    if (value == TablebaseValue::kWin) return 1.0;
+    if (value == TablebaseValue::kLoss) return -1.0;
+    return 0.0;
+  };
+}
+
+namespace {
+
+class TablebaseBot : public Bot {
+ public:
+  TablebaseBot(const Game& game, Player player_id,
+               std::shared_ptr<const Tablebase> tablebase)
+      : Bot(game, player_id), tablebase_(std::move(tablebase)) {}
+
+  std::pair<ActionsAndProbs, Action> Step(const State& state) override {
+    std::vector<Action> legal_actions = state.LegalActions();
+    const Action chosen = ChooseAction(state, legal_actions);
+    ActionsAndProbs policy;
+    policy.reserve(legal_actions.size());
+    for (Action action : legal_actions) {
+      policy.push_back({action, action == chosen ? 1. : 0.});
+    }
+    return {policy, chosen};
+  }
+
+  Action StepAction(const State& state) override {
+    return ChooseAction(state, state.LegalActions());
+  }
+
+ private:
+  // Ranks a child position for `player`: win 3, draw 2, untabled 1, loss 0,
+  // so an untabled move is preferred to a known loss when the bot is asked
+  // to act outside the solved region.
+  int Rank(const State& child, Player player) const {
+    if (child.IsTerminal()) {
+      const double return_value = child.Returns()[player];
+      if (return_value > 0) return 3;
+      return return_value < 0 ? 0 : 2;
+    }
+    TablebaseValue value = tablebase_->Probe(child);
+    if (value == TablebaseValue::kUnknown) return 1;
+    if (child.CurrentPlayer() != player) value = Negate(value);
+    if (value == TablebaseValue::kWin) return 3;
+    return value == TablebaseValue::kDraw ? 2 : 0;
+  }
+
+  Action ChooseAction(const State& state,
+                      const std::vector<Action>& legal_actions) const {
+    SPIEL_CHECK_FALSE(legal_actions.empty());
+    const Player player = state.CurrentPlayer();
+    Action best_action = legal_actions[0];
+    int best_rank = -1;
+    for (Action action : legal_actions) {
+      const int rank = Rank(*state.Child(action), player);
+      if (rank > best_rank) {
+        best_rank = rank;
+        best_action = action;
+      }
+    }
+    return best_action;
+  }
+
+  std::shared_ptr<const Tablebase> tablebase_;
+};
+
+}  // namespace
+
+std::unique_ptr<Bot> MakeTablebaseBot(
+    const Game& game, Player player_id,
+    std::shared_ptr<const Tablebase> tablebase) {
+  return std::unique_ptr<Bot>(
+      new TablebaseBot(game, player_id, std::move(tablebase)));
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,118 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// The game-theoretic value of a position, from the perspective of the player
+// to move.
+enum class TablebaseValue : uint8_t {
+  kUnknown = 0,  // Position not in the table.
+  kLoss = 1,
+  kDraw = 2,
+  kWin = 3,
+};
+
+// An endgame tablebase built by retrograde analysis: every position reachable
+// from a root is enumerated, terminals are labeled from their returns, and
+// values are propagated backwards along predecessor links until a fixed point.
+// Positions left undecided by the propagation can only be reached by play that
+// cycles forever, so they are draws; this makes the solve exact for games with
+// repetition, such as oware endings.
+//
+// Forward search answers one root per call; the tablebase answers every
+// position in the region with a single binary-search probe, which is what
+// turns repeated exhaustive searches over the same endings into lookups.
+// Positions are keyed on `State::HashValue`, so the game must provide one and
+// it must identify positions exactly within the enumerated region.
+class Tablebase {
+ public:
+  // Enumerates all positions reachable from `root` (the initial state when
+  // nullptr) and solves them. Requires a deterministic, two-player, zero-sum,
+  // perfect-information game with `Game::ProvidesHashValue`. `num_threads`
+  // parallelizes both the enumeration and the backward propagation.
+  //
+  // For small games or endgame regions only: every reachable position is held
+  // in memory while building (the finished table is 66 bits per position).
+  static std::unique_ptr<Tablebase> Build(const Game& game,
+                                          const State* root = nullptr,
+                                          int num_threads = 1);
+
+  // Maps a file written by `SaveToFile` into memory, read-only and shared, so
+  // a table larger than RAM can be probed and concurrent processes share one
+  // copy through the page cache.
+  static std::unique_ptr<Tablebase> LoadFromFile(const std::string& filename);
+
+  ~Tablebase();
+  Tablebase(const Tablebase&) = delete;
+  Tablebase& operator=(const Tablebase&) = delete;
+
+  // Writes the table: a fixed header, the sorted position keys, then the
+  // values packed two bits each.
+  void SaveToFile(const std::string& filename) const;
+
+  // The value of the position for its player to move, or `kUnknown` when the
+  // position is not in the table. Only non-terminal positions are stored;
+  // callers see terminal positions directly from `Returns`.
+  TablebaseValue Probe(const State& state) const;
+  TablebaseValue ProbeKey(uint64_t key) const;
+
+  int64_t NumPositions() const { return num_positions_; }
+
+ private:
+  Tablebase() = default;
+
+  // Either view into the owned vectors below or into the file mapping.
+  const uint64_t* keys_ = nullptr;
+  const uint64_t* values_ = nullptr;  // Packed, two bits per position.
+  int64_t num_positions_ = 0;
+
+  // Backing storage when built in memory.
+  std::vector<uint64_t> owned_keys_;
+  std::vector<uint64_t> owned_values_;
+
+  // Backing mapping when loaded from a file.
+  void* mapping_ = nullptr;
+  uint64_t mapping_size_ = 0;
+};
+
+// A leaf evaluator for `AlphaBetaSearch`: tabled wins, draws and losses map
+// to +1, 0 and -1 for `maximizing_player`; positions outside the table
+// evaluate to 0. With a table covering the endgame, a depth-limited search
+// from any position that reaches the table at its frontier is exact.
+std::function<double(const State&)> TablebaseValueFunction(
+    std::shared_ptr<const Tablebase> tablebase, Player maximizing_player);
+
+// A bot that plays perfectly within the table: it probes each child and picks
+// a winning move when one exists, otherwise a drawing one, preferring
+// untabled moves to tabled losses when outside the solved region.
+std::unique_ptr<Bot> MakeTablebaseBot(
+    const Game& game, Player player_id,
+    std::shared_ptr<const Tablebase> tablebase);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
@@ -0,0 +1,190 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tablebase.h"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void BuildAndProbeTest_TicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<Tablebase> tablebase =
+      Tablebase::Build(*game, nullptr, /*num_threads=*/4);
+  SPIEL_CHECK_GT(tablebase->NumPositions(), 0);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_TRUE(tablebase->Probe(*state) == TablebaseValue::kDraw);
+
+  // .o.
+  // .x.
+  // ... : the player to move (x) wins.
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+  SPIEL_CHECK_TRUE(tablebase->Probe(*state) == TablebaseValue::kWin);
+
+  // ...
+  // xox
+  // ..o : the player to move (x) loses.
+  state = game->NewInitialState();
+  state->ApplyAction(5);
+  state->ApplyAction(4);
+  state->ApplyAction(3);
+  state->ApplyAction(8);
+  SPIEL_CHECK_TRUE(tablebase->Probe(*state) == TablebaseValue::kLoss);
+
+  // A key from some other game is not in the table.
+  SPIEL_CHECK_TRUE(tablebase->ProbeKey(0xdeadbeefdeadbeefULL) ==
+                   TablebaseValue::kUnknown);
+}
+
+// Along random playouts, the tabled value must match a forward search from
+// the same position.
+void AgreementWithAlphaBetaTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<Tablebase> tablebase = Tablebase::Build(*game);
+  std::mt19937 rng(2387);
+  for (int episode = 0; episode < 5; ++episode) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const double search_value =
+          AlphaBetaSearch(*game, state.get(), {}, -1, state->CurrentPlayer())
+              .first;
+      const TablebaseValue tabled = tablebase->Probe(*state);
+      if (search_value > 0) {
+        SPIEL_CHECK_TRUE(tabled == TablebaseValue::kWin);
+      } else if (search_value < 0) {
+        SPIEL_CHECK_TRUE(tabled == TablebaseValue::kLoss);
+      } else {
+        SPIEL_CHECK_TRUE(tabled == TablebaseValue::kDraw);
+      }
+      std::vector<Action> legal_actions = state->LegalActions();
+      state->ApplyAction(legal_actions[rng() % legal_actions.size()]);
+    }
+  }
+}
+
+void SaveLoadRoundTripTest() {
+  const std::string filename = "/tmp/open_spiel_tablebase_test.bin";
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<Tablebase> built = Tablebase::Build(*game);
+  built->SaveToFile(filename);
+  std::unique_ptr<Tablebase> loaded = Tablebase::LoadFromFile(filename);
+  SPIEL_CHECK_EQ(built->NumPositions(), loaded->NumPositions());
+
+  std::mt19937 rng(17);
+  for (int episode = 0; episode < 3; ++episode) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      SPIEL_CHECK_TRUE(built->Probe(*state) == loaded->Probe(*state));
+      std::vector<Action> legal_actions = state->LegalActions();
+      state->ApplyAction(legal_actions[rng() % legal_actions.size()]);
+    }
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+// A depth-limited search whose leaves are answered by the table must give
+// the exact value.
+void ValueFunctionTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::shared_ptr<const Tablebase> tablebase = Tablebase::Build(*game);
+  const double root_value =
+      AlphaBetaSearch(*game, nullptr, TablebaseValueFunction(tablebase, 0),
+                      /*depth_limit=*/2, Player{0})
+          .first;
+  SPIEL_CHECK_EQ(root_value, 0.0);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+  const double win_value =
+      AlphaBetaSearch(*game, state.get(), TablebaseValueFunction(tablebase, 0),
+                      /*depth_limit=*/1, Player{0})
+          .first;
+  SPIEL_CHECK_EQ(win_value, 1.0);
+}
+
+void TablebaseBotTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::shared_ptr<const Tablebase> tablebase = Tablebase::Build(*game);
+
+  // Self-play from the initial position is a draw.
+  std::vector<std::unique_ptr<Bot>> bots;
+  bots.push_back(MakeTablebaseBot(*game, Player{0}, tablebase));
+  bots.push_back(MakeTablebaseBot(*game, Player{1}, tablebase));
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    state->ApplyAction(bots[state->CurrentPlayer()]->StepAction(*state));
+  }
+  SPIEL_CHECK_EQ(state->Returns()[0], 0.0);
+
+  // Against a random opponent the bot must never lose.
+  for (int seed = 0; seed < 20; ++seed) {
+    std::unique_ptr<Bot> opponent = MakeUniformRandomBot(*game, Player{1},
+                                                         seed);
+    state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      Bot* to_act =
+          state->CurrentPlayer() == 0 ? bots[0].get() : opponent.get();
+      state->ApplyAction(to_act->StepAction(*state));
+    }
+    SPIEL_CHECK_GE(state->Returns()[0], 0.0);
+  }
+}
+
+// Breakthrough provides a hash but no draws: pieces only ever advance, so
+// play cannot cycle and every position must come out decided.
+void BreakthroughTablebaseTest() {
+  std::shared_ptr<const Game> game =
+      LoadGame("breakthrough(rows=4,columns=3)");
+  std::shared_ptr<const Tablebase> tablebase =
+      Tablebase::Build(*game, nullptr, /*num_threads=*/4);
+  SPIEL_CHECK_GT(tablebase->NumPositions(), 1000);
+
+  const TablebaseValue root_value =
+      tablebase->Probe(*game->NewInitialState());
+  SPIEL_CHECK_TRUE(root_value == TablebaseValue::kWin ||
+                   root_value == TablebaseValue::kLoss);
+
+  // A shallow table-backed search must agree with the tabled root value.
+  const double backed_value =
+      AlphaBetaSearch(*game, nullptr, TablebaseValueFunction(tablebase, 0),
+                      /*depth_limit=*/2, Player{0})
+          .first;
+  SPIEL_CHECK_EQ(backed_value,
+                 root_value == TablebaseValue::kWin ? 1.0 : -1.0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::BuildAndProbeTest_TicTacToe();
+  open_spiel::algorithms::AgreementWithAlphaBetaTest();
+  open_spiel::algorithms::SaveLoadRoundTripTest();
+  open_spiel::algorithms::ValueFunctionTest();
+  open_spiel::algorithms::TablebaseBotTest();
+  open_spiel::algorithms::BreakthroughTablebaseTest();
+}
@@ -17,6 +17,7 @@
 #include <cmath>
 #include <limits>
 #include <unordered_set>
+#include <vector>
 
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/expected_returns.h"
@@ -27,7 +28,31 @@
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
 
+// Computes each player's best-response value as its own task on the
+// shared pool. The per-player computations are independent, and building
+// the per-player HistoryTree dominates the cost, so fanning out across
+// players cuts the latency to that of the slowest player. The trees
+// themselves are stamped out of the cached per-game SharedGameTree, so
+// the game engine is only walked on the first call for a given game.
+std::vector<double> BestResponseValues(const Game& game,
+                                       const Policy& policy) {
+  std::shared_ptr<const SharedGameTree> shared_tree = GetSharedGameTree(game);
+  std::vector<double> values(game.NumPlayers());
+  TaskGroup group(TaskPool::Global());
+  for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
+    group.Spawn([&game, &policy, &values, shared_tree, p]() {
+      TabularBestResponse best_response(game, p, &policy, *shared_tree);
+      std::unique_ptr<State> root = game.NewInitialState();
+      values[p] = best_response.Value(root->ToString());
+    });
+  }
+  group.Sync();
+  return values;
+}
+
+}  // namespace
 
 double Exploitability(const Game& game, const Policy& policy) {
   GameType game_type = game.GetType();
@@ -39,11 +64,10 @@ double Exploitability(const Game& game, const Policy& policy) {
     SpielFatalError("The game must have zero- or constant-sum utility.");
   }
 
-  std::unique_ptr<State> root = game.NewInitialState();
+  std::vector<double> best_response_values = BestResponseValues(game, policy);
   double nash_conv = 0;
   for (auto i = Player{0}; i < game.NumPlayers(); ++i) {
-    TabularBestResponse best_response(game, i, &policy);
-    nash_conv += best_response.Value(root->ToString());
+    nash_conv += best_response_values[i];
   }
   return (nash_conv - game.UtilitySum()) / game.NumPlayers();
 }
@@ -62,11 +86,7 @@ double NashConv(const Game& game, const Policy& policy) {
   }
 
   std::unique_ptr<State> root = game.NewInitialState();
-  std::vector<double> best_response_values(game.NumPlayers());
-  for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
-    TabularBestResponse best_response(game, p, &policy);
-    best_response_values[p] = best_response.Value(root->ToString());
-  }
+  std::vector<double> best_response_values = BestResponseValues(game, policy);
   std::vector<double> on_policy_values = ExpectedReturns(*root, policy, -1);
   SPIEL_CHECK_EQ(best_response_values.size(), on_policy_values.size());
   double nash_conv = 0;
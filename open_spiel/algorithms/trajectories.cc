@@ -14,10 +14,19 @@
 
 #include "open_spiel/algorithms/trajectories.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
 #include <chrono>  // NOLINT
 #include <cstdint>
+#include <cstring>
+#include <mutex>  // NOLINT
 #include <random>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +48,213 @@ std::string StateKey(const Game& game, const State& state,
   }
   return state.ToString();
 }
+
+// Raw destination of one flat batch: either a FlatBatchedTrajectory's
+// vectors or a shared-memory segment. Layouts as in FlatBatchedTrajectory.
+struct FlatFields {
+  int batch_size;
+  int max_length;
+  int observation_size;
+  int num_distinct_actions;
+  int num_players;
+  double* observations;
+  int* state_indices;
+  int* legal_actions;
+  Action* actions;
+  double* player_policies;
+  int* player_ids;
+  double* rewards;
+  int* valid_lengths;
+};
+
+FlatFields FieldsOf(FlatBatchedTrajectory* batch) {
+  return {batch->batch_size,
+          batch->max_length,
+          batch->observation_size,
+          batch->num_distinct_actions,
+          batch->num_players,
+          batch->observations.data(),
+          batch->state_indices.data(),
+          batch->legal_actions.data(),
+          batch->actions.data(),
+          batch->player_policies.data(),
+          batch->player_ids.data(),
+          batch->rewards.data(),
+          batch->valid_lengths.data()};
+}
+
+FlatFields FieldsOf(SharedMemoryTrajectoryBuffer* buffer) {
+  return {buffer->BatchSize(),
+          buffer->MaxLength(),
+          buffer->ObservationSize(),
+          buffer->NumDistinctActions(),
+          buffer->NumPlayers(),
+          buffer->Observations(),
+          buffer->StateIndices(),
+          buffer->LegalActions(),
+          buffer->Actions(),
+          buffer->PlayerPolicies(),
+          buffer->PlayerIds(),
+          buffer->Rewards(),
+          buffer->ValidLengths()};
+}
+
+// Plays one episode and writes it into row `episode` of the flat batch.
+// Only touches that row (and its entries of rewards/valid_lengths), so
+// concurrent calls for distinct episodes need no synchronisation.
+void RecordEpisodeInto(const Game& game,
+                       const std::vector<TabularPolicy>& policies,
+                       const State& initial_state,
+                       const std::unordered_map<std::string, int>&
+                           state_to_index,
+                       std::mt19937* rng, int episode,
+                       const FlatFields& batch) {
+  const int max_length = batch.max_length;
+  const int num_actions = batch.num_distinct_actions;
+  const bool find_index = batch.observation_size == 0;
+  std::unique_ptr<open_spiel::State> state = initial_state.Clone();
+  int t = 0;
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(open_spiel::SampleChanceOutcome(
+          state->ChanceOutcomes(),
+          std::uniform_real_distribution<double>(0.0, 1.0)(*rng)));
+      continue;
+    } else if (state->IsSimultaneousNode()) {
+      open_spiel::SpielFatalError(
+          "We do not support games with simultaneous actions.");
+    }
+    SPIEL_CHECK_LT(t, max_length);
+    const size_t row = static_cast<size_t>(episode) * max_length + t;
+
+    int* mask = batch.legal_actions + row * num_actions;
+    std::fill(mask, mask + num_actions, 0);
+    for (Action action : state->LegalActions()) mask[action] = 1;
+
+    if (find_index) {
+      auto it = state_to_index.find(StateKey(game, *state));
+      SPIEL_CHECK_TRUE(it != state_to_index.end());
+      batch.state_indices[row] = it->second;
+    } else {
+      state->InformationStateAsNormalizedVector(
+          state->CurrentPlayer(),
+          batch.observations + row * batch.observation_size);
+    }
+
+    ActionsAndProbs policy = policies.at(state->CurrentPlayer())
+                                 .GetStatePolicy(state->InformationState());
+    SPIEL_CHECK_LE(policy.size(), state->LegalActions().size());
+    double* policy_row = batch.player_policies + row * num_actions;
+    std::fill(policy_row, policy_row + num_actions, 0.);
+    for (const std::pair<Action, double>& pair : policy) {
+      policy_row[pair.first] = pair.second;
+    }
+    batch.player_ids[row] = state->CurrentPlayer();
+    Action action = SampleChanceOutcome(
+        policy, std::uniform_real_distribution<double>(0.0, 1.0)(*rng));
+    batch.actions[row] = action;
+    ++t;
+    state->ApplyAction(action);
+  }
+  SPIEL_CHECK_GT(t, 0);
+  batch.valid_lengths[episode] = t;
+  std::vector<double> returns = state->Returns();
+  std::copy(returns.begin(), returns.end(),
+            batch.rewards + static_cast<size_t>(episode) * batch.num_players);
+}
+
+// Serial/parallel episode driver shared by the vector-backed and
+// shared-memory recorders. Seeding behaves as in RecordBatchedTrajectory.
+void RecordFlatEpisodes(const Game& game,
+                        const std::vector<TabularPolicy>& policies,
+                        const State& initial_state,
+                        const std::unordered_map<std::string, int>&
+                            state_to_index,
+                        std::mt19937* rng_ptr, int num_threads,
+                        const FlatFields& fields) {
+  const int batch_size = fields.batch_size;
+  if (num_threads == 1) {
+    for (int i = 0; i < batch_size; ++i) {
+      RecordEpisodeInto(game, policies, initial_state, state_to_index, rng_ptr,
+                        i, fields);
+    }
+    return;
+  }
+  // Episodes are seeded from the caller's generator up front so the batch
+  // content is independent of the number of workers.
+  std::vector<uint32_t> seeds(batch_size);
+  for (int i = 0; i < batch_size; ++i) seeds[i] = (*rng_ptr)();
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([t, num_threads, batch_size, &seeds, &game, &policies,
+                          &initial_state, &state_to_index, &fields]() {
+      for (int i = t; i < batch_size; i += num_threads) {
+        std::mt19937 rng(seeds[i]);
+        RecordEpisodeInto(game, policies, initial_state, state_to_index, &rng,
+                          i, fields);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
+// On-disk (well, in-memory) layout of a shared trajectory segment: the
+// header, then the 8-byte-wide tensors, then the int tensors.
+struct SharedBufferHeader {
+  int64_t magic;
+  int32_t batch_size;
+  int32_t max_length;
+  int32_t observation_size;
+  int32_t num_distinct_actions;
+  int32_t num_players;
+  int32_t padding;  // Keeps the first tensor 8-byte aligned.
+};
+
+constexpr int64_t kSharedBufferMagic = 0x6f735f7368747231;  // "os_shtr1"
+
+struct SharedBufferLayout {
+  int64_t observations;
+  int64_t player_policies;
+  int64_t rewards;
+  int64_t actions;
+  int64_t state_indices;
+  int64_t legal_actions;
+  int64_t player_ids;
+  int64_t valid_lengths;
+  int64_t total_bytes;
+};
+
+SharedBufferLayout ComputeLayout(const SharedBufferHeader& header) {
+  const int64_t rows =
+      static_cast<int64_t>(header.batch_size) * header.max_length;
+  SharedBufferLayout layout;
+  int64_t offset = sizeof(SharedBufferHeader);
+  layout.observations = offset;
+  offset += rows * header.observation_size * sizeof(double);
+  layout.player_policies = offset;
+  offset += rows * header.num_distinct_actions * sizeof(double);
+  layout.rewards = offset;
+  offset += static_cast<int64_t>(header.batch_size) * header.num_players *
+            sizeof(double);
+  layout.actions = offset;
+  offset += rows * sizeof(Action);
+  layout.state_indices = offset;
+  if (header.observation_size == 0) offset += rows * sizeof(int);
+  layout.legal_actions = offset;
+  offset += rows * header.num_distinct_actions * sizeof(int);
+  layout.player_ids = offset;
+  offset += rows * sizeof(int);
+  layout.valid_lengths = offset;
+  offset += header.batch_size * sizeof(int);
+  layout.total_bytes = offset;
+  return layout;
+}
+
+std::string NormalizeShmName(const std::string& name) {
+  if (!name.empty() && name[0] == '/') return name;
+  return "/" + name;
+}
 }  // namespace
 
 // Initializes a BatchedTrajectory of size [batch_size, T].
@@ -110,22 +326,303 @@ void BatchedTrajectory::ResizeFields(int length) {
   }
 }
 
+FlatBatchedTrajectory::FlatBatchedTrajectory(const Game& game, int batch_size,
+                                             int max_length,
+                                             bool include_full_observations)
+    : batch_size(batch_size),
+      max_length(max_length),
+      observation_size(include_full_observations
+                           ? game.InformationStateNormalizedVectorSize()
+                           : 0),
+      num_distinct_actions(game.NumDistinctActions()),
+      num_players(game.NumPlayers()) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_GT(max_length, 0);
+  const size_t rows = static_cast<size_t>(batch_size) * max_length;
+  if (include_full_observations) {
+    observations.assign(rows * observation_size, 0.);
+  } else {
+    state_indices.assign(rows, 0);
+  }
+  // The fill values of the padded region match what
+  // BatchedTrajectory::ResizeFields pads with.
+  legal_actions.assign(rows * num_distinct_actions, 1);
+  actions.assign(rows, 0);
+  player_policies.assign(rows * num_distinct_actions, 1.);
+  player_ids.assign(rows, 0);
+  rewards.assign(static_cast<size_t>(batch_size) * num_players, 0.);
+  valid_lengths.assign(batch_size, 0);
+}
+
+FlatBatchedTrajectory RecordFlatBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, std::mt19937* rng_ptr, int max_length,
+    int num_threads) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  if (max_length < 0) max_length = game.MaxGameLength();
+  FlatBatchedTrajectory batch(game, batch_size, max_length,
+                              include_full_observations);
+  RecordFlatEpisodes(game, policies, initial_state, state_to_index, rng_ptr,
+                     num_threads, FieldsOf(&batch));
+  return batch;
+}
+
+SharedMemoryTrajectoryBuffer::SharedMemoryTrajectoryBuffer(
+    const std::string& name, const Game& game, int batch_size, int max_length,
+    bool include_full_observations)
+    : name_(NormalizeShmName(name)) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_GT(max_length, 0);
+  SharedBufferHeader header;
+  header.magic = kSharedBufferMagic;
+  header.batch_size = batch_size;
+  header.max_length = max_length;
+  header.observation_size =
+      include_full_observations ? game.InformationStateNormalizedVectorSize()
+                                : 0;
+  header.num_distinct_actions = game.NumDistinctActions();
+  header.num_players = game.NumPlayers();
+  header.padding = 0;
+  const SharedBufferLayout layout = ComputeLayout(header);
+
+  // Remove any previous incarnation so the segment is recreated at the
+  // right size (and zero-filled) rather than reused.
+  shm_unlink(name_.c_str());
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("shm_open(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  if (ftruncate(fd, layout.total_bytes) != 0) {
+    close(fd);
+    shm_unlink(name_.c_str());
+    SpielFatalError(absl::StrCat("ftruncate(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  mapping_ = mmap(nullptr, layout.total_bytes, PROT_READ | PROT_WRITE,
+                  MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    shm_unlink(name_.c_str());
+    SpielFatalError(absl::StrCat("mmap(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  mapping_size_ = layout.total_bytes;
+  *static_cast<SharedBufferHeader*>(mapping_) = header;
+  // ftruncate zero-fills; give the padded regions the same fill values
+  // FlatBatchedTrajectory uses.
+  const int64_t rows = static_cast<int64_t>(batch_size) * max_length;
+  std::fill(LegalActions(), LegalActions() + rows * header.num_distinct_actions,
+            1);
+  std::fill(PlayerPolicies(),
+            PlayerPolicies() + rows * header.num_distinct_actions, 1.);
+}
+
+SharedMemoryTrajectoryBuffer::SharedMemoryTrajectoryBuffer(
+    const std::string& name)
+    : name_(NormalizeShmName(name)) {
+  int fd = shm_open(name_.c_str(), O_RDWR, 0644);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("shm_open(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) != 0) {
+    close(fd);
+    SpielFatalError(absl::StrCat("fstat(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  if (statbuf.st_size < static_cast<off_t>(sizeof(SharedBufferHeader))) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Shared memory segment ", name_,
+                                 " is too small to hold a trajectory buffer."));
+  }
+  mapping_ = mmap(nullptr, statbuf.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    SpielFatalError(absl::StrCat("mmap(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+  mapping_size_ = statbuf.st_size;
+  const SharedBufferHeader& header =
+      *static_cast<const SharedBufferHeader*>(mapping_);
+  if (header.magic != kSharedBufferMagic) {
+    SpielFatalError(absl::StrCat(
+        "Shared memory segment ", name_,
+        " was not created by SharedMemoryTrajectoryBuffer."));
+  }
+  SPIEL_CHECK_GE(mapping_size_, ComputeLayout(header).total_bytes);
+}
+
+SharedMemoryTrajectoryBuffer::~SharedMemoryTrajectoryBuffer() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+}
+
+void SharedMemoryTrajectoryBuffer::Unlink() {
+  if (shm_unlink(name_.c_str()) != 0 && errno != ENOENT) {
+    SpielFatalError(absl::StrCat("shm_unlink(", name_,
+                                 ") failed: ", std::strerror(errno)));
+  }
+}
+
+namespace {
+const SharedBufferHeader& HeaderOf(const void* mapping) {
+  return *static_cast<const SharedBufferHeader*>(mapping);
+}
+
+template <typename T>
+T* FieldAt(void* mapping, int64_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(mapping) + offset);
+}
+}  // namespace
+
+int SharedMemoryTrajectoryBuffer::BatchSize() const {
+  return HeaderOf(mapping_).batch_size;
+}
+
+int SharedMemoryTrajectoryBuffer::MaxLength() const {
+  return HeaderOf(mapping_).max_length;
+}
+
+int SharedMemoryTrajectoryBuffer::ObservationSize() const {
+  return HeaderOf(mapping_).observation_size;
+}
+
+int SharedMemoryTrajectoryBuffer::NumDistinctActions() const {
+  return HeaderOf(mapping_).num_distinct_actions;
+}
+
+int SharedMemoryTrajectoryBuffer::NumPlayers() const {
+  return HeaderOf(mapping_).num_players;
+}
+
+int64_t SharedMemoryTrajectoryBuffer::FieldOffset(
+    const std::string& field) const {
+  const SharedBufferLayout layout = ComputeLayout(HeaderOf(mapping_));
+  if (field == "observations") return layout.observations;
+  if (field == "player_policies") return layout.player_policies;
+  if (field == "rewards") return layout.rewards;
+  if (field == "actions") return layout.actions;
+  if (field == "state_indices") return layout.state_indices;
+  if (field == "legal_actions") return layout.legal_actions;
+  if (field == "player_ids") return layout.player_ids;
+  if (field == "valid_lengths") return layout.valid_lengths;
+  SpielFatalError(absl::StrCat("Unknown trajectory field: ", field));
+}
+
+double* SharedMemoryTrajectoryBuffer::Observations() {
+  return FieldAt<double>(mapping_,
+                         ComputeLayout(HeaderOf(mapping_)).observations);
+}
+
+int* SharedMemoryTrajectoryBuffer::StateIndices() {
+  return FieldAt<int>(mapping_,
+                      ComputeLayout(HeaderOf(mapping_)).state_indices);
+}
+
+int* SharedMemoryTrajectoryBuffer::LegalActions() {
+  return FieldAt<int>(mapping_,
+                      ComputeLayout(HeaderOf(mapping_)).legal_actions);
+}
+
+Action* SharedMemoryTrajectoryBuffer::Actions() {
+  return FieldAt<Action>(mapping_, ComputeLayout(HeaderOf(mapping_)).actions);
+}
+
+double* SharedMemoryTrajectoryBuffer::PlayerPolicies() {
+  return FieldAt<double>(mapping_,
+                         ComputeLayout(HeaderOf(mapping_)).player_policies);
+}
+
+int* SharedMemoryTrajectoryBuffer::PlayerIds() {
+  return FieldAt<int>(mapping_, ComputeLayout(HeaderOf(mapping_)).player_ids);
+}
+
+double* SharedMemoryTrajectoryBuffer::Rewards() {
+  return FieldAt<double>(mapping_, ComputeLayout(HeaderOf(mapping_)).rewards);
+}
+
+int* SharedMemoryTrajectoryBuffer::ValidLengths() {
+  return FieldAt<int>(mapping_,
+                      ComputeLayout(HeaderOf(mapping_)).valid_lengths);
+}
+
+void RecordFlatBatchedTrajectoryIntoSharedMemory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index,
+    bool include_full_observations, int seed,
+    SharedMemoryTrajectoryBuffer* buffer, int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  if (include_full_observations) {
+    SPIEL_CHECK_EQ(buffer->ObservationSize(),
+                   game.InformationStateNormalizedVectorSize());
+  } else {
+    SPIEL_CHECK_EQ(buffer->ObservationSize(), 0);
+  }
+  SPIEL_CHECK_EQ(buffer->NumDistinctActions(), game.NumDistinctActions());
+  SPIEL_CHECK_EQ(buffer->NumPlayers(), game.NumPlayers());
+  std::mt19937 rng(seed);
+  std::unique_ptr<State> initial_state = game.NewInitialState();
+  RecordFlatEpisodes(game, policies, *initial_state, state_to_index, &rng,
+                     num_threads, FieldsOf(buffer));
+}
+
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length) {
+    int max_unroll_length, int num_threads) {
   SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
   if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
   BatchedTrajectory batched_trajectory(batch_size);
-  // TODO(author1): Replace this with a multi-threaded version.
-  for (int i = 0; i < batch_size; ++i) {
-    BatchedTrajectory trajectory =
-        RecordTrajectory(game, policies, initial_state, state_to_index,
-                         include_full_observations, rng_ptr);
-    SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
-    batched_trajectory.MoveTrajectory(i, &trajectory);
+  if (num_threads == 1) {
+    for (int i = 0; i < batch_size; ++i) {
+      BatchedTrajectory trajectory =
+          RecordTrajectory(game, policies, initial_state, state_to_index,
+                           include_full_observations, rng_ptr);
+      SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+      batched_trajectory.MoveTrajectory(i, &trajectory);
+    }
+  } else {
+    // Every episode gets its own generator seeded from the caller's, so the
+    // batch content does not depend on the number of workers or on how the
+    // scheduler interleaves them.
+    std::vector<uint32_t> seeds(batch_size);
+    for (int i = 0; i < batch_size; ++i) seeds[i] = (*rng_ptr)();
+
+    // Each episode owns a pre-assigned slot in the batch, so workers need no
+    // queue; the mutex only serialises the (cheap) moves into the batch and
+    // the shared max_trajectory_length update.
+    std::mutex batch_mutex;
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([t, num_threads, batch_size, &seeds, &game,
+                            &policies, &initial_state, &state_to_index,
+                            include_full_observations, &batch_mutex,
+                            &batched_trajectory]() {
+        for (int i = t; i < batch_size; i += num_threads) {
+          std::mt19937 rng(seeds[i]);
+          BatchedTrajectory trajectory =
+              RecordTrajectory(game, policies, initial_state, state_to_index,
+                               include_full_observations, &rng);
+          SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+          std::lock_guard<std::mutex> lock(batch_mutex);
+          batched_trajectory.MoveTrajectory(i, &trajectory);
+        }
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
   }
   batched_trajectory.ResizeFields(max_unroll_length);
   return batched_trajectory;
@@ -202,22 +699,23 @@ BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length) {
+    int max_unroll_length, int num_threads) {
   if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
   std::unique_ptr<State> state = game.NewInitialState();
   return RecordBatchedTrajectory(game, policies, *state, state_to_index,
                                  batch_size, include_full_observations, rng_ptr,
-                                 max_unroll_length);
+                                 max_unroll_length, num_threads);
 }
 
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
-    bool include_full_observations, int seed, int max_unroll_length) {
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads) {
   std::mt19937 rng(seed);
   return RecordBatchedTrajectory(game, policies, state_to_index, batch_size,
                                  include_full_observations, &rng,
-                                 max_unroll_length);
+                                 max_unroll_length, num_threads);
 }
 
 BatchedTrajectory RecordTrajectory(
@@ -72,6 +72,130 @@ struct BatchedTrajectory {
   uint64_t max_trajectory_length = 0;
 };
 
+// Fixed-size, contiguous layout of a batch of trajectories. Every field is a
+// single allocation sized once from the time horizon and the game's tensor
+// shapes, so a learner can consume the buffers zero-copy. Row b of a [B, T]
+// or [B, T, N] field starts at b * max_length (times N), and valid_lengths[b]
+// gives the number of real steps of episode b; everything past that is
+// padding (with the same fill values BatchedTrajectory::ResizeFields uses).
+// The final valid step of an episode is its terminal transition, so there is
+// no separate next_is_terminal field.
+struct FlatBatchedTrajectory {
+  // Sizes the tensors for `batch_size` episodes of up to `max_length` steps
+  // (pass game.MaxGameLength() if no tighter unroll bound is known).
+  FlatBatchedTrajectory(const Game& game, int batch_size, int max_length,
+                        bool include_full_observations);
+
+  int batch_size;
+  int max_length;
+  // Feature size of the observations field; 0 when state indices are
+  // recorded instead.
+  int observation_size;
+  int num_distinct_actions;
+  int num_players;
+
+  // [B, T, observation_size]; empty unless full observations were requested.
+  std::vector<double> observations;
+  // [B, T]; empty when full observations were requested.
+  std::vector<int> state_indices;
+  // [B, T, num_distinct_actions]
+  std::vector<int> legal_actions;
+  // [B, T]
+  std::vector<Action> actions;
+  // [B, T, num_distinct_actions]
+  std::vector<double> player_policies;
+  // [B, T]
+  std::vector<int> player_ids;
+  // [B, num_players]
+  std::vector<double> rewards;
+  // [B]
+  std::vector<int> valid_lengths;
+};
+
+// A FlatBatchedTrajectory whose tensors live in a named POSIX shared
+// memory segment instead of process-private vectors, so consumer
+// processes (typically NumPy via /dev/shm) map the recorded data
+// zero-copy instead of receiving a pickled copy through a queue. The
+// segment starts with a header holding the dimensions, followed by the
+// fields in a fixed order at the byte offsets reported by FieldOffset;
+// the layouts and padding values match FlatBatchedTrajectory exactly.
+//
+// The creating constructor sizes and zero-fills the segment; the
+// attaching constructor maps an existing one and reads the dimensions
+// from its header. The name is removed only by Unlink (the memory itself
+// lives until the last process unmaps it), so a producer can exit after
+// recording and consumers can still attach.
+class SharedMemoryTrajectoryBuffer {
+ public:
+  // Creates the named segment (replacing any previous incarnation).
+  // Names follow shm_open conventions; a leading '/' is added if absent.
+  SharedMemoryTrajectoryBuffer(const std::string& name, const Game& game,
+                               int batch_size, int max_length,
+                               bool include_full_observations);
+
+  // Attaches to a segment created by another SharedMemoryTrajectoryBuffer.
+  explicit SharedMemoryTrajectoryBuffer(const std::string& name);
+
+  // Unmaps; never removes the name.
+  ~SharedMemoryTrajectoryBuffer();
+
+  SharedMemoryTrajectoryBuffer(const SharedMemoryTrajectoryBuffer&) = delete;
+  SharedMemoryTrajectoryBuffer& operator=(const SharedMemoryTrajectoryBuffer&) =
+      delete;
+
+  // Removes the name from the system; existing mappings stay valid.
+  void Unlink();
+
+  const std::string& Name() const { return name_; }
+  int BatchSize() const;
+  int MaxLength() const;
+  int ObservationSize() const;
+  int NumDistinctActions() const;
+  int NumPlayers() const;
+
+  // Byte offset of the field's tensor from the start of the segment.
+  // Valid names: "observations", "player_policies", "rewards", "actions",
+  // "state_indices", "legal_actions", "player_ids", "valid_lengths".
+  int64_t FieldOffset(const std::string& field) const;
+
+  // Typed views into the mapping; layouts as in FlatBatchedTrajectory.
+  double* Observations();
+  int* StateIndices();
+  int* LegalActions();
+  Action* Actions();
+  double* PlayerPolicies();
+  int* PlayerIds();
+  double* Rewards();
+  int* ValidLengths();
+
+ private:
+  std::string name_;
+  void* mapping_ = nullptr;
+  int64_t mapping_size_ = 0;
+};
+
+// Records batch_size episodes directly into the shared segment, exactly
+// as RecordFlatBatchedTrajectory fills its vectors (same seeding, same
+// row layout, same worker scheme). The buffer's dimensions choose the
+// batch size and unroll length.
+void RecordFlatBatchedTrajectoryIntoSharedMemory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index,
+    bool include_full_observations, int seed,
+    SharedMemoryTrajectoryBuffer* buffer, int num_threads = 1);
+
+// Flat counterpart of RecordBatchedTrajectory below: plays batch_size
+// episodes and writes each directly into its row of the preallocated
+// tensors, with no per-step allocations and no padding pass afterwards.
+// Threading and seeding behave as in RecordBatchedTrajectory; rows are
+// disjoint, so the workers need no synchronisation at all.
+FlatBatchedTrajectory RecordFlatBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, std::mt19937* rng_ptr,
+    int max_length = -1, int num_threads = 1);
+
 // If include_full_observations is true, then we record the result of
 // open_spiel::State::InformationStateAsNormalizedVector(); otherwise, we store
 // the index (taken from state_to_index).
@@ -81,12 +205,18 @@ BatchedTrajectory RecordTrajectory(
     const std::unordered_map<std::string, int>& state_to_index,
     bool include_full_observations, std::mt19937* rng_ptr);
 
+// Plays batch_size episodes and collects them into one padded batch. With
+// num_threads > 1 the episodes are shared out over a pool of workers, each
+// playing on its own State with its own generator. One seed per episode is
+// drawn from `rng_ptr` up front, so the batch content is reproducible and
+// does not depend on the number of workers (though with num_threads == 1 the
+// caller's generator is used directly, matching the previous behaviour).
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length = -1);
+    int max_unroll_length = -1, int num_threads = 1);
 
 BatchedTrajectory RecordTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
@@ -97,12 +227,13 @@ BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length = -1);
+    int max_unroll_length = -1, int num_threads = 1);
 
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
-    bool include_full_observations, int seed, int max_unroll_length = -1);
+    bool include_full_observations, int seed, int max_unroll_length = -1,
+    int num_threads = 1);
 
 // Stateful version of RecordTrajectory. There are several optimisations that
 // this allows. Currently, the only optimisation is preventing making multiple
@@ -119,12 +250,13 @@ class TrajectoryRecorder {
         rng_(std::mt19937(seed)) {}
 
   BatchedTrajectory RecordBatch(const std::vector<TabularPolicy>& policies,
-                                int batch_size, int max_unroll_length) {
+                                int batch_size, int max_unroll_length,
+                                int num_threads = 1) {
     bool include_full_observations = !state_to_index_.empty();
     std::unique_ptr<State> root = game_->NewInitialState();
     return RecordBatchedTrajectory(*game_, policies, *root, state_to_index_,
                                    batch_size, include_full_observations, &rng_,
-                                   max_unroll_length);
+                                   max_unroll_length, num_threads);
   }
 
  private:
@@ -14,6 +14,7 @@
 
 #include "open_spiel/algorithms/trajectories.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "open_spiel/policy.h"
@@ -210,6 +211,126 @@ void RecordBatchedTrajectoryPlayerIdsIsCorrect(const std::string& game_name) {
   }
 }
 
+void RecordBatchedTrajectoryThreadedIsReproducible(
+    const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  // Episodes are seeded up front from the caller's generator, so batches
+  // recorded from the same generator state must be identical whatever the
+  // number of worker threads.
+  std::mt19937 rng_two(/*seed=*/3047884);
+  std::mt19937 rng_four(/*seed=*/3047884);
+  BatchedTrajectory two_workers = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*rng_ptr=*/&rng_two,
+      /*max_unroll_length=*/-1, /*num_threads=*/2);
+  BatchedTrajectory four_workers = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*rng_ptr=*/&rng_four,
+      /*max_unroll_length=*/-1, /*num_threads=*/4);
+  SPIEL_CHECK_TRUE(two_workers.actions == four_workers.actions);
+  SPIEL_CHECK_TRUE(two_workers.state_indices == four_workers.state_indices);
+  SPIEL_CHECK_TRUE(two_workers.player_ids == four_workers.player_ids);
+  SPIEL_CHECK_TRUE(two_workers.rewards == four_workers.rewards);
+  SPIEL_CHECK_EQ(two_workers.max_trajectory_length,
+                 four_workers.max_trajectory_length);
+}
+
+void FlatBatchedTrajectoryMatchesNested(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  // Both recorders consume the generator identically, so from the same seed
+  // the flat tensors must hold exactly the nested batch's episodes.
+  std::mt19937 rng_nested(/*seed=*/76812326);
+  std::mt19937 rng_flat(/*seed=*/76812326);
+  BatchedTrajectory nested = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*rng_ptr=*/&rng_nested);
+  FlatBatchedTrajectory flat = RecordFlatBatchedTrajectory(
+      *game, policies, *game->NewInitialState(), states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*rng_ptr=*/&rng_flat);
+  SPIEL_CHECK_EQ(flat.batch_size, kBatchSize);
+  SPIEL_CHECK_EQ(flat.max_length, game->MaxGameLength());
+  for (int b = 0; b < kBatchSize; ++b) {
+    const int length = flat.valid_lengths[b];
+    SPIEL_CHECK_EQ(length, std::count(nested.valid[b].begin(),
+                                      nested.valid[b].end(), 1));
+    for (int t = 0; t < length; ++t) {
+      const int row = b * flat.max_length + t;
+      SPIEL_CHECK_EQ(flat.actions[row], nested.actions[b][t]);
+      SPIEL_CHECK_EQ(flat.state_indices[row], nested.state_indices[b][t]);
+      SPIEL_CHECK_EQ(flat.player_ids[row], nested.player_ids[b][t]);
+      for (int a = 0; a < flat.num_distinct_actions; ++a) {
+        SPIEL_CHECK_EQ(flat.legal_actions[row * flat.num_distinct_actions + a],
+                       nested.legal_actions[b][t][a]);
+      }
+    }
+    for (int p = 0; p < flat.num_players; ++p) {
+      SPIEL_CHECK_EQ(flat.rewards[b * flat.num_players + p],
+                     nested.rewards[b][p]);
+    }
+  }
+}
+
+void SharedMemoryBufferMatchesFlat(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  const std::string segment_name =
+      "open_spiel_trajectories_test_" + game_name;
+  constexpr int kSeed = 86523981;
+  SharedMemoryTrajectoryBuffer buffer(segment_name, *game, kBatchSize,
+                                      game->MaxGameLength(),
+                                      /*include_full_observations=*/false);
+  RecordFlatBatchedTrajectoryIntoSharedMemory(
+      *game, policies, states_to_indices,
+      /*include_full_observations=*/false, kSeed, &buffer);
+  // The same seed through the vector-backed recorder must give exactly the
+  // same tensors.
+  std::mt19937 rng(kSeed);
+  FlatBatchedTrajectory flat = RecordFlatBatchedTrajectory(
+      *game, policies, *game->NewInitialState(), states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, &rng);
+
+  // Read everything back through a second mapping, as a consumer process
+  // would.
+  SharedMemoryTrajectoryBuffer reader(segment_name);
+  SPIEL_CHECK_EQ(reader.BatchSize(), flat.batch_size);
+  SPIEL_CHECK_EQ(reader.MaxLength(), flat.max_length);
+  SPIEL_CHECK_EQ(reader.ObservationSize(), 0);
+  SPIEL_CHECK_EQ(reader.NumDistinctActions(), flat.num_distinct_actions);
+  SPIEL_CHECK_EQ(reader.NumPlayers(), flat.num_players);
+  const size_t rows = static_cast<size_t>(flat.batch_size) * flat.max_length;
+  SPIEL_CHECK_TRUE(std::equal(flat.actions.begin(), flat.actions.end(),
+                              reader.Actions()));
+  SPIEL_CHECK_TRUE(std::equal(flat.state_indices.begin(),
+                              flat.state_indices.end(),
+                              reader.StateIndices()));
+  SPIEL_CHECK_TRUE(std::equal(flat.legal_actions.begin(),
+                              flat.legal_actions.end(),
+                              reader.LegalActions()));
+  SPIEL_CHECK_TRUE(std::equal(flat.player_policies.begin(),
+                              flat.player_policies.end(),
+                              reader.PlayerPolicies()));
+  SPIEL_CHECK_TRUE(std::equal(flat.player_ids.begin(), flat.player_ids.end(),
+                              reader.PlayerIds()));
+  SPIEL_CHECK_TRUE(
+      std::equal(flat.rewards.begin(), flat.rewards.end(), reader.Rewards()));
+  SPIEL_CHECK_TRUE(std::equal(flat.valid_lengths.begin(),
+                              flat.valid_lengths.end(),
+                              reader.ValidLengths()));
+  // The field offsets must describe the same data the accessors return.
+  SPIEL_CHECK_EQ(reader.FieldOffset("valid_lengths") -
+                     reader.FieldOffset("player_ids"),
+                 static_cast<int64_t>(rows * sizeof(int)));
+  buffer.Unlink();
+}
+
 void BatchedTrajectoryResizesCorrectly(const std::string& game_name) {
   std::shared_ptr<const Game> game = LoadGame(game_name);
   const std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
@@ -275,6 +396,9 @@ int main() {
     alg::RecordBatchedTrajectoryLegalActionsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryPlayerIdsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryNextIsTerminalIsCorrect(game_name);
+    alg::RecordBatchedTrajectoryThreadedIsReproducible(game_name);
+    alg::FlatBatchedTrajectoryMatchesNested(game_name);
+    alg::SharedMemoryBufferMatchesFlat(game_name);
     alg::BatchedTrajectoryResizesCorrectly(game_name);
   }
 }
@@ -0,0 +1,373 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Format marker for trajectory files; bump when the layout changes.
+constexpr char kTrajectoryFileMagic[8] = {'O', 'S', 'T', 'R', 'J', 'v', '0',
+                                          '2'};
+
+// Number of int64 fields in a chunk header: the five dimensions, the
+// observation encoding, and the stored byte size of the observations (or
+// state_indices) array, which is no longer implied by the dimensions once
+// encodings vary.
+constexpr int kChunkHeaderFields = 7;
+
+// Values of the observation encoding header field.
+constexpr int64_t kRawObservations = 0;
+constexpr int64_t kDeltaObservations = 1;
+
+// Every array in a chunk is padded to an 8-byte boundary, so that all
+// arrays (in particular the double ones) stay aligned in the mapping.
+uint64_t Padded(uint64_t bytes) { return (bytes + 7) & ~uint64_t{7}; }
+
+// Byte size of a chunk with the given header, including the header itself.
+// `observation_bytes` is the stored size of the observations array (or of
+// state_indices when observation_size == 0), as recorded in the header.
+uint64_t ChunkSize(int64_t batch_size, int64_t max_length,
+                   int64_t num_distinct_actions, int64_t num_players,
+                   int64_t observation_bytes) {
+  const uint64_t rows = batch_size * max_length;
+  uint64_t size = kChunkHeaderFields * sizeof(int64_t);
+  size += Padded(observation_bytes);  // observations or state_indices
+  size += Padded(rows * num_distinct_actions * sizeof(int32_t));  // legal
+  size += Padded(rows * sizeof(Action));                          // actions
+  size += Padded(rows * num_distinct_actions * sizeof(double));   // policies
+  size += Padded(rows * sizeof(int32_t));                         // player_ids
+  size += Padded(batch_size * num_players * sizeof(double));      // rewards
+  size += Padded(batch_size * sizeof(int32_t));  // valid_lengths
+  return size;
+}
+
+// Delta form of the observations tensor: per episode, the first row in
+// full, then for every later row an int64 count of changed cells followed
+// by (int64 cell, double value) pairs against the previous row. Everything
+// is an 8-byte unit, so the stream keeps the chunk arrays aligned, and the
+// padding rows past an episode's valid length cost one count each.
+std::vector<char> DeltaEncodeObservations(const FlatBatchedTrajectory& batch) {
+  std::vector<char> encoded;
+  auto append = [&encoded](const void* data, uint64_t bytes) {
+    const char* begin = static_cast<const char*>(data);
+    encoded.insert(encoded.end(), begin, begin + bytes);
+  };
+  const int64_t row_bytes = batch.observation_size * sizeof(double);
+  for (int64_t b = 0; b < batch.batch_size; ++b) {
+    const double* row =
+        batch.observations.data() +
+        b * batch.max_length * batch.observation_size;
+    append(row, row_bytes);  // Keyframe.
+    for (int64_t t = 1; t < batch.max_length; ++t) {
+      const double* prev = row;
+      row += batch.observation_size;
+      int64_t num_changes = 0;
+      for (int64_t cell = 0; cell < batch.observation_size; ++cell) {
+        if (row[cell] != prev[cell]) ++num_changes;
+      }
+      append(&num_changes, sizeof(num_changes));
+      for (int64_t cell = 0; cell < batch.observation_size; ++cell) {
+        if (row[cell] != prev[cell]) {
+          append(&cell, sizeof(cell));
+          append(&row[cell], sizeof(double));
+        }
+      }
+    }
+  }
+  return encoded;
+}
+
+// Rebuilds the flat [B, T, observation_size] tensor from the delta stream.
+void DeltaDecodeObservations(const char* data, int64_t batch_size,
+                             int64_t max_length, int64_t observation_size,
+                             std::vector<double>* observations) {
+  observations->resize(batch_size * max_length * observation_size);
+  const int64_t row_bytes = observation_size * sizeof(double);
+  const char* cursor = data;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    double* row = observations->data() + b * max_length * observation_size;
+    std::memcpy(row, cursor, row_bytes);
+    cursor += row_bytes;
+    for (int64_t t = 1; t < max_length; ++t) {
+      std::memcpy(row + observation_size, row, row_bytes);
+      row += observation_size;
+      int64_t num_changes;
+      std::memcpy(&num_changes, cursor, sizeof(num_changes));
+      cursor += sizeof(num_changes);
+      for (int64_t change = 0; change < num_changes; ++change) {
+        int64_t cell;
+        std::memcpy(&cell, cursor, sizeof(cell));
+        cursor += sizeof(cell);
+        std::memcpy(&row[cell], cursor, sizeof(double));
+        cursor += sizeof(double);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TrajectoryFileWriter::TrajectoryFileWriter(const std::string& filename,
+                                           bool delta_encode_observations)
+    : file_(filename, std::ios::binary | std::ios::trunc),
+      filename_(filename),
+      delta_encode_observations_(delta_encode_observations) {
+  if (!file_) {
+    SpielFatalError(absl::StrCat("Cannot open trajectory file: ", filename));
+  }
+  file_.write(kTrajectoryFileMagic, sizeof(kTrajectoryFileMagic));
+  writer_thread_ = std::thread(&TrajectoryFileWriter::WriteLoop, this);
+}
+
+TrajectoryFileWriter::~TrajectoryFileWriter() {
+  queue_.Close();  // The writer drains what is queued, then exits.
+  writer_thread_.join();
+  file_.flush();
+}
+
+void TrajectoryFileWriter::Append(FlatBatchedTrajectory batch) {
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  if (!queue_.Push(
+          std::make_unique<FlatBatchedTrajectory>(std::move(batch)))) {
+    // Closed (destruction already began); nothing will write the chunk.
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void TrajectoryFileWriter::Flush() {
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  flush_cv_.wait(lock, [this]() {
+    return pending_.load(std::memory_order_acquire) == 0;
+  });
+  file_.flush();
+  if (!file_) {
+    SpielFatalError(absl::StrCat("Error writing trajectories to: ", filename_));
+  }
+}
+
+void TrajectoryFileWriter::WriteLoop() {
+  std::unique_ptr<FlatBatchedTrajectory> batch;
+  while (queue_.Pop(&batch)) {
+    WriteChunk(*batch);
+    batch.reset();
+    {
+      std::lock_guard<std::mutex> lock(flush_mutex_);
+      pending_.fetch_sub(1, std::memory_order_release);
+    }
+    flush_cv_.notify_all();
+  }
+}
+
+void TrajectoryFileWriter::WriteChunk(const FlatBatchedTrajectory& batch) {
+  std::vector<char> encoded;
+  int64_t observation_encoding = kRawObservations;
+  int64_t observation_bytes;
+  if (batch.observation_size > 0) {
+    if (delta_encode_observations_) {
+      encoded = DeltaEncodeObservations(batch);
+      observation_encoding = kDeltaObservations;
+      observation_bytes = encoded.size();
+    } else {
+      observation_bytes = batch.observations.size() * sizeof(double);
+    }
+  } else {
+    observation_bytes = batch.state_indices.size() * sizeof(int32_t);
+  }
+  const int64_t header[kChunkHeaderFields] = {
+      batch.batch_size,           batch.max_length,
+      batch.observation_size,     batch.num_distinct_actions,
+      batch.num_players,          observation_encoding,
+      observation_bytes};
+  file_.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  auto write_padded = [this](const void* data, uint64_t bytes) {
+    static const char zeros[8] = {0};
+    file_.write(reinterpret_cast<const char*>(data), bytes);
+    if (bytes % 8 != 0) file_.write(zeros, 8 - bytes % 8);
+  };
+  if (batch.observation_size > 0) {
+    if (observation_encoding == kDeltaObservations) {
+      write_padded(encoded.data(), encoded.size());
+    } else {
+      write_padded(batch.observations.data(),
+                   batch.observations.size() * sizeof(double));
+    }
+  } else {
+    write_padded(batch.state_indices.data(),
+                 batch.state_indices.size() * sizeof(int32_t));
+  }
+  write_padded(batch.legal_actions.data(),
+               batch.legal_actions.size() * sizeof(int32_t));
+  write_padded(batch.actions.data(), batch.actions.size() * sizeof(Action));
+  write_padded(batch.player_policies.data(),
+               batch.player_policies.size() * sizeof(double));
+  write_padded(batch.player_ids.data(),
+               batch.player_ids.size() * sizeof(int32_t));
+  write_padded(batch.rewards.data(), batch.rewards.size() * sizeof(double));
+  write_padded(batch.valid_lengths.data(),
+               batch.valid_lengths.size() * sizeof(int32_t));
+  if (!file_) {
+    SpielFatalError(absl::StrCat("Error writing trajectories to: ", filename_));
+  }
+}
+
+TrajectoryFileReader::TrajectoryFileReader(const std::string& filename)
+    : filename_(filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("Cannot open trajectory file: ", filename));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    SpielFatalError(absl::StrCat("Cannot stat trajectory file: ", filename));
+  }
+  size_ = file_stat.st_size;
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Cannot map trajectory file: ", filename));
+  }
+  data_ = static_cast<const char*>(mapping);
+
+  if (size_ < sizeof(kTrajectoryFileMagic) ||
+      std::memcmp(data_, kTrajectoryFileMagic,
+                  sizeof(kTrajectoryFileMagic)) != 0) {
+    SpielFatalError(absl::StrCat("Not a trajectory file: ", filename));
+  }
+
+  // Index the chunk offsets once; chunk sizes follow from their headers.
+  uint64_t offset = sizeof(kTrajectoryFileMagic);
+  while (offset < size_) {
+    if (offset + kChunkHeaderFields * sizeof(int64_t) > size_) {
+      SpielFatalError(absl::StrCat("Truncated trajectory file: ", filename));
+    }
+    const int64_t* header = reinterpret_cast<const int64_t*>(data_ + offset);
+    const uint64_t chunk_size =
+        ChunkSize(header[0], header[1], header[3], header[4], header[6]);
+    if (offset + chunk_size > size_) {
+      SpielFatalError(absl::StrCat("Truncated trajectory file: ", filename));
+    }
+    chunk_offsets_.push_back(offset);
+    offset += chunk_size;
+  }
+}
+
+TrajectoryFileReader::~TrajectoryFileReader() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+TrajectoryChunkView TrajectoryFileReader::GetChunk(int index) const {
+  SPIEL_CHECK_GE(index, 0);
+  SPIEL_CHECK_LT(index, chunk_offsets_.size());
+  const char* chunk = data_ + chunk_offsets_[index];
+  const int64_t* header = reinterpret_cast<const int64_t*>(chunk);
+  TrajectoryChunkView view;
+  view.batch_size = header[0];
+  view.max_length = header[1];
+  view.observation_size = header[2];
+  view.num_distinct_actions = header[3];
+  view.num_players = header[4];
+  const int64_t observation_encoding = header[5];
+  const int64_t observation_bytes = header[6];
+
+  const uint64_t rows = view.batch_size * view.max_length;
+  const char* cursor = chunk + kChunkHeaderFields * sizeof(int64_t);
+  auto take = [&cursor](uint64_t bytes) {
+    const char* array = cursor;
+    cursor += Padded(bytes);
+    return array;
+  };
+  if (view.observation_size > 0) {
+    if (observation_encoding == kDeltaObservations) {
+      DeltaDecodeObservations(take(observation_bytes), view.batch_size,
+                              view.max_length, view.observation_size,
+                              &view.decoded_observations);
+      view.observations = view.decoded_observations.data();
+    } else {
+      view.observations = reinterpret_cast<const double*>(
+          take(rows * view.observation_size * sizeof(double)));
+    }
+    view.state_indices = nullptr;
+  } else {
+    view.observations = nullptr;
+    view.state_indices =
+        reinterpret_cast<const int32_t*>(take(rows * sizeof(int32_t)));
+  }
+  view.legal_actions = reinterpret_cast<const int32_t*>(
+      take(rows * view.num_distinct_actions * sizeof(int32_t)));
+  view.actions =
+      reinterpret_cast<const Action*>(take(rows * sizeof(Action)));
+  view.player_policies = reinterpret_cast<const double*>(
+      take(rows * view.num_distinct_actions * sizeof(double)));
+  view.player_ids =
+      reinterpret_cast<const int32_t*>(take(rows * sizeof(int32_t)));
+  view.rewards = reinterpret_cast<const double*>(
+      take(view.batch_size * view.num_players * sizeof(double)));
+  view.valid_lengths = reinterpret_cast<const int32_t*>(
+      take(view.batch_size * sizeof(int32_t)));
+  return view;
+}
+
+BatchedTrajectory ToBatchedTrajectory(const TrajectoryChunkView& chunk) {
+  BatchedTrajectory trajectory(chunk.batch_size);
+  for (int b = 0; b < chunk.batch_size; ++b) {
+    const int length = chunk.valid_lengths[b];
+    trajectory.max_trajectory_length =
+        std::max<uint64_t>(trajectory.max_trajectory_length, length);
+    trajectory.rewards[b].assign(
+        chunk.rewards + b * chunk.num_players,
+        chunk.rewards + (b + 1) * chunk.num_players);
+    for (int t = 0; t < length; ++t) {
+      const uint64_t row = static_cast<uint64_t>(b) * chunk.max_length + t;
+      if (chunk.observation_size > 0) {
+        trajectory.observations[b].emplace_back(
+            chunk.observations + row * chunk.observation_size,
+            chunk.observations + (row + 1) * chunk.observation_size);
+      } else {
+        trajectory.state_indices[b].push_back(chunk.state_indices[row]);
+      }
+      trajectory.legal_actions[b].emplace_back(
+          chunk.legal_actions + row * chunk.num_distinct_actions,
+          chunk.legal_actions + (row + 1) * chunk.num_distinct_actions);
+      trajectory.actions[b].push_back(chunk.actions[row]);
+      trajectory.player_policies[b].emplace_back(
+          chunk.player_policies + row * chunk.num_distinct_actions,
+          chunk.player_policies + (row + 1) * chunk.num_distinct_actions);
+      trajectory.player_ids[b].push_back(chunk.player_ids[row]);
+      trajectory.valid[b].push_back(1);
+      trajectory.next_is_terminal[b].push_back(t == length - 1);
+    }
+  }
+  // Pad to the chunk's unroll length, as RecordBatchedTrajectory does.
+  trajectory.ResizeFields(chunk.max_length);
+  return trajectory;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
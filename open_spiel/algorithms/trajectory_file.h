@@ -0,0 +1,152 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/spiel_utils.h"
+
+// A chunked binary on-disk format for recorded trajectories, so dataset
+// generation is no longer bounded by RAM and recorded data can be replayed.
+// A file is a fixed header followed by appended chunks, where each chunk is
+// one FlatBatchedTrajectory written field by field; since that layout is
+// already flat and every array is padded to an 8-byte boundary, a reader can
+// map the file and serve batches as pointers straight into the mapping.
+// Observations may optionally be delta encoded (each episode's first row in
+// full, later rows as sparse cell updates), which shrinks grid-game files by
+// an order of magnitude; the reader reconstructs the flat tensor, so only
+// that field loses the zero-copy path.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Appends batches to a trajectory file. Append only queues the batch; a
+// background thread serialises and writes the queued chunks, so recording
+// threads are not blocked on disk. The handoff is a bounded lock-free
+// queue (MpmcQueue, so several recording threads may append): when the
+// writer falls kQueueCapacity chunks behind, Append blocks, bounding the
+// memory held in flight instead of letting it grow with the backlog. The
+// file is complete once the writer is flushed (or destroyed); chunks
+// appear in the order they were appended.
+class TrajectoryFileWriter {
+ public:
+  // With delta_encode_observations, appended chunks store each episode's
+  // observations as a full first row plus per-step changed cells. Worth it
+  // whenever consecutive observations differ in a few cells (the grid
+  // games); a poor fit for games whose tensors change wholesale, where the
+  // update lists approach the raw rows in size. The other fields and the
+  // reader interface are unaffected.
+  explicit TrajectoryFileWriter(const std::string& filename,
+                                bool delta_encode_observations = false);
+
+  // Joins the flushing thread, so the file is complete on destruction.
+  ~TrajectoryFileWriter();
+
+  TrajectoryFileWriter(const TrajectoryFileWriter&) = delete;
+  TrajectoryFileWriter& operator=(const TrajectoryFileWriter&) = delete;
+
+  // Queues a batch for writing. The batch is moved from.
+  void Append(FlatBatchedTrajectory batch);
+
+  // Blocks until every queued chunk has been written to the file.
+  void Flush();
+
+ private:
+  // How many chunks may be in flight before Append applies backpressure.
+  static constexpr int kQueueCapacity = 16;
+
+  void WriteLoop();
+  void WriteChunk(const FlatBatchedTrajectory& batch);
+
+  std::ofstream file_;
+  std::string filename_;
+  bool delta_encode_observations_;
+
+  MpmcQueue<std::unique_ptr<FlatBatchedTrajectory>> queue_{kQueueCapacity};
+  // Chunks appended but not yet on disk; Flush waits for it to hit zero.
+  std::atomic<int64_t> pending_{0};
+  std::mutex flush_mutex_;
+  std::condition_variable flush_cv_;
+  std::thread writer_thread_;
+};
+
+// One chunk of a mapped trajectory file. The pointers alias the mapping
+// owned by the TrajectoryFileReader and stay valid for its lifetime; the
+// array shapes are as documented on FlatBatchedTrajectory. For chunks with
+// delta-encoded observations, `observations` instead points at
+// `decoded_observations`, which the view owns; take views by value from
+// GetChunk (a move keeps the pointer valid) rather than copying them.
+struct TrajectoryChunkView {
+  int64_t batch_size;
+  int64_t max_length;
+  int64_t observation_size;
+  int64_t num_distinct_actions;
+  int64_t num_players;
+
+  const double* observations;  // Null when observation_size == 0.
+  // Backing storage for `observations` when the chunk was delta encoded;
+  // empty for raw chunks.
+  std::vector<double> decoded_observations;
+  const int32_t* state_indices;
+  const int32_t* legal_actions;
+  const Action* actions;
+  const double* player_policies;
+  const int32_t* player_ids;
+  const double* rewards;
+  const int32_t* valid_lengths;
+};
+
+// Copies a chunk into the nested in-memory form, for consumers of the
+// existing BatchedTrajectory interface. The flat view itself is the
+// zero-copy path.
+BatchedTrajectory ToBatchedTrajectory(const TrajectoryChunkView& chunk);
+
+// Memory-maps a trajectory file and serves chunks in O(1) without reading
+// or copying them up front; the chunk offsets are indexed once on open.
+class TrajectoryFileReader {
+ public:
+  explicit TrajectoryFileReader(const std::string& filename);
+  ~TrajectoryFileReader();
+
+  TrajectoryFileReader(const TrajectoryFileReader&) = delete;
+  TrajectoryFileReader& operator=(const TrajectoryFileReader&) = delete;
+
+  int NumChunks() const { return chunk_offsets_.size(); }
+
+  // Returns a view of the given chunk, pointing into the mapping. Suitable
+  // for serving random batches: no deserialisation happens.
+  TrajectoryChunkView GetChunk(int index) const;
+
+ private:
+  std::string filename_;
+  const char* data_ = nullptr;
+  uint64_t size_ = 0;
+  std::vector<uint64_t> chunk_offsets_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
@@ -0,0 +1,227 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_file.h"
+
+#include <fstream>
+#include <unordered_map>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kBatchSize = 8;
+constexpr int kNumChunks = 3;
+
+std::unordered_map<std::string, int> GetStatesToIndices(const Game& game) {
+  std::unordered_map<std::string, int> state_index;
+  std::vector<std::unique_ptr<State>> to_visit;
+  to_visit.push_back(game.NewInitialState());
+  int index = 0;
+  while (!to_visit.empty()) {
+    std::unique_ptr<State> state = std::move(to_visit.back());
+    to_visit.pop_back();
+    if (!state->IsChanceNode() && !state->IsTerminal()) {
+      state_index[state->InformationState()] = index;
+    }
+    ++index;
+    for (Action action : state->LegalActions()) {
+      to_visit.push_back(state->Child(action));
+    }
+  }
+  return state_index;
+}
+
+std::vector<FlatBatchedTrajectory> RecordBatches(
+    const std::string& game_name, bool include_full_observations) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::mt19937 rng(283764);
+  std::vector<FlatBatchedTrajectory> batches;
+  for (int i = 0; i < kNumChunks; ++i) {
+    batches.push_back(RecordFlatBatchedTrajectory(
+        *game, policies, *game->NewInitialState(), states_to_indices,
+        kBatchSize, include_full_observations, &rng));
+  }
+  return batches;
+}
+
+void CheckChunkMatchesBatch(const TrajectoryChunkView& chunk,
+                            const FlatBatchedTrajectory& batch) {
+  SPIEL_CHECK_EQ(chunk.batch_size, batch.batch_size);
+  SPIEL_CHECK_EQ(chunk.max_length, batch.max_length);
+  SPIEL_CHECK_EQ(chunk.observation_size, batch.observation_size);
+  SPIEL_CHECK_EQ(chunk.num_distinct_actions, batch.num_distinct_actions);
+  SPIEL_CHECK_EQ(chunk.num_players, batch.num_players);
+  if (batch.observation_size > 0) {
+    SPIEL_CHECK_TRUE(chunk.state_indices == nullptr);
+    for (int i = 0; i < batch.observations.size(); ++i) {
+      SPIEL_CHECK_EQ(chunk.observations[i], batch.observations[i]);
+    }
+  } else {
+    SPIEL_CHECK_TRUE(chunk.observations == nullptr);
+    for (int i = 0; i < batch.state_indices.size(); ++i) {
+      SPIEL_CHECK_EQ(chunk.state_indices[i], batch.state_indices[i]);
+    }
+  }
+  for (int i = 0; i < batch.legal_actions.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.legal_actions[i], batch.legal_actions[i]);
+  }
+  for (int i = 0; i < batch.actions.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.actions[i], batch.actions[i]);
+  }
+  for (int i = 0; i < batch.player_policies.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.player_policies[i], batch.player_policies[i]);
+  }
+  for (int i = 0; i < batch.player_ids.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.player_ids[i], batch.player_ids[i]);
+  }
+  for (int i = 0; i < batch.rewards.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.rewards[i], batch.rewards[i]);
+  }
+  for (int i = 0; i < batch.valid_lengths.size(); ++i) {
+    SPIEL_CHECK_EQ(chunk.valid_lengths[i], batch.valid_lengths[i]);
+  }
+}
+
+void WriteThenReadRoundTrips(const std::string& game_name,
+                             bool include_full_observations,
+                             bool delta_encode_observations = false) {
+  const std::string filename = absl::StrCat(
+      "/tmp/open_spiel_trajectory_file_test_", game_name,
+      include_full_observations ? "_obs" : "_idx",
+      delta_encode_observations ? "_delta" : "", ".bin");
+  std::vector<FlatBatchedTrajectory> batches =
+      RecordBatches(game_name, include_full_observations);
+  {
+    TrajectoryFileWriter writer(filename, delta_encode_observations);
+    for (const FlatBatchedTrajectory& batch : batches) {
+      writer.Append(batch);
+    }
+    writer.Flush();
+    // The destructor also completes the file; Flush just makes it eager.
+  }
+  TrajectoryFileReader reader(filename);
+  SPIEL_CHECK_EQ(reader.NumChunks(), batches.size());
+  for (int i = 0; i < reader.NumChunks(); ++i) {
+    CheckChunkMatchesBatch(reader.GetChunk(i), batches[i]);
+  }
+}
+
+uint64_t FileSize(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  SPIEL_CHECK_TRUE(file.good());
+  return file.tellg();
+}
+
+void DeltaEncodingShrinksFiles() {
+  // Consecutive leduc_poker information-state rows share most cells (the
+  // card planes are fixed within a round, the betting bits accumulate), so
+  // the delta stream is a fraction of the raw rows; the encoded file must
+  // round-trip exactly and come out smaller.
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::mt19937 rng(283764);
+  std::vector<FlatBatchedTrajectory> batches;
+  for (int i = 0; i < kNumChunks; ++i) {
+    batches.push_back(RecordFlatBatchedTrajectory(
+        *game, policies, *game->NewInitialState(), {}, kBatchSize,
+        /*include_full_observations=*/true, &rng));
+  }
+  const std::string raw_filename =
+      "/tmp/open_spiel_trajectory_file_test_leduc_poker_raw.bin";
+  const std::string delta_filename =
+      "/tmp/open_spiel_trajectory_file_test_leduc_poker_delta.bin";
+  {
+    TrajectoryFileWriter raw_writer(raw_filename);
+    TrajectoryFileWriter delta_writer(delta_filename,
+                                      /*delta_encode_observations=*/true);
+    for (const FlatBatchedTrajectory& batch : batches) {
+      raw_writer.Append(batch);
+      delta_writer.Append(batch);
+    }
+  }
+  TrajectoryFileReader reader(delta_filename);
+  SPIEL_CHECK_EQ(reader.NumChunks(), batches.size());
+  for (int i = 0; i < reader.NumChunks(); ++i) {
+    CheckChunkMatchesBatch(reader.GetChunk(i), batches[i]);
+  }
+  SPIEL_CHECK_LT(FileSize(delta_filename), FileSize(raw_filename));
+}
+
+void ToBatchedTrajectoryMatchesChunk(const std::string& game_name) {
+  const std::string filename = absl::StrCat(
+      "/tmp/open_spiel_trajectory_file_test_", game_name, "_nested.bin");
+  std::vector<FlatBatchedTrajectory> batches =
+      RecordBatches(game_name, /*include_full_observations=*/false);
+  {
+    TrajectoryFileWriter writer(filename);
+    for (const FlatBatchedTrajectory& batch : batches) {
+      writer.Append(batch);
+    }
+  }
+  TrajectoryFileReader reader(filename);
+  for (int i = 0; i < reader.NumChunks(); ++i) {
+    const TrajectoryChunkView chunk = reader.GetChunk(i);
+    BatchedTrajectory trajectory = ToBatchedTrajectory(chunk);
+    SPIEL_CHECK_EQ(trajectory.batch_size, chunk.batch_size);
+    SPIEL_CHECK_EQ(trajectory.max_trajectory_length, chunk.max_length);
+    for (int b = 0; b < chunk.batch_size; ++b) {
+      const int length = chunk.valid_lengths[b];
+      SPIEL_CHECK_EQ(trajectory.state_indices[b].size(), chunk.max_length);
+      for (int t = 0; t < length; ++t) {
+        const int row = b * chunk.max_length + t;
+        SPIEL_CHECK_EQ(trajectory.state_indices[b][t],
+                       chunk.state_indices[row]);
+        SPIEL_CHECK_EQ(trajectory.actions[b][t], chunk.actions[row]);
+        SPIEL_CHECK_EQ(trajectory.player_ids[b][t], chunk.player_ids[row]);
+        SPIEL_CHECK_EQ(trajectory.valid[b][t], 1);
+        SPIEL_CHECK_EQ(trajectory.next_is_terminal[b][t], t == length - 1);
+      }
+      for (int t = length; t < chunk.max_length; ++t) {
+        SPIEL_CHECK_EQ(trajectory.valid[b][t], 0);
+      }
+      for (int p = 0; p < chunk.num_players; ++p) {
+        SPIEL_CHECK_EQ(trajectory.rewards[b][p],
+                       chunk.rewards[b * chunk.num_players + p]);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace alg = open_spiel::algorithms;
+
+int main() {
+  for (const std::string& game_name : {"kuhn_poker", "leduc_poker"}) {
+    alg::WriteThenReadRoundTrips(game_name,
+                                 /*include_full_observations=*/false);
+    alg::WriteThenReadRoundTrips(game_name,
+                                 /*include_full_observations=*/true);
+    alg::WriteThenReadRoundTrips(game_name,
+                                 /*include_full_observations=*/true,
+                                 /*delta_encode_observations=*/true);
+    alg::ToBatchedTrajectoryMatchesChunk(game_name);
+  }
+  alg::DeltaEncodingShrinksFiles();
+}
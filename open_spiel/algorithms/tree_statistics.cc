@@ -0,0 +1,219 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tree_statistics.h"
+
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// One walker's share of the profile. The information-state sets are kept
+// per level so duplicates across levels (possible when a game repeats an
+// information state at different depths) are not conflated.
+struct PartialProfile {
+  TreeStatistics stats;
+  std::vector<std::unordered_set<std::string>> infosets_by_level;
+};
+
+void EnsureLevel(PartialProfile* partial, int depth) {
+  if (partial->stats.states_per_level.size() <= static_cast<size_t>(depth)) {
+    partial->stats.states_per_level.resize(depth + 1, 0);
+    partial->stats.chance_nodes_per_level.resize(depth + 1, 0);
+    partial->infosets_by_level.resize(depth + 1);
+  }
+}
+
+// Records one node. Branching is recorded for every non-terminal node
+// counted, including those cut off by a depth limit.
+void CountNode(const State& state, int depth, bool track_infosets,
+               PartialProfile* partial) {
+  TreeStatistics& stats = partial->stats;
+  EnsureLevel(partial, depth);
+  ++stats.num_states;
+  ++stats.states_per_level[depth];
+  if (state.IsTerminal()) {
+    ++stats.num_terminal_states;
+    return;
+  }
+  const size_t branching = state.LegalActions().size();
+  if (stats.branching_histogram.size() <= branching) {
+    stats.branching_histogram.resize(branching + 1, 0);
+  }
+  ++stats.branching_histogram[branching];
+  if (state.IsChanceNode()) {
+    ++stats.num_chance_nodes;
+    ++stats.chance_nodes_per_level[depth];
+  } else {
+    ++stats.num_decision_nodes;
+    if (track_infosets && state.CurrentPlayer() >= 0) {
+      partial->infosets_by_level[depth].insert(state.InformationState());
+    }
+  }
+}
+
+void WalkSubtree(const State& state, int depth, int depth_limit,
+                 bool track_infosets, PartialProfile* partial) {
+  CountNode(state, depth, track_infosets, partial);
+  if (state.IsTerminal() || depth == depth_limit) return;
+  for (Action action : state.LegalActions()) {
+    WalkSubtree(*state.Child(action), depth + 1, depth_limit, track_infosets,
+                partial);
+  }
+}
+
+void MergeInto(PartialProfile&& from, PartialProfile* into) {
+  TreeStatistics& stats = into->stats;
+  const TreeStatistics& other = from.stats;
+  stats.num_states += other.num_states;
+  stats.num_decision_nodes += other.num_decision_nodes;
+  stats.num_chance_nodes += other.num_chance_nodes;
+  stats.num_terminal_states += other.num_terminal_states;
+  auto merge_counts = [](const std::vector<int64_t>& src,
+                         std::vector<int64_t>* dest) {
+    if (dest->size() < src.size()) dest->resize(src.size(), 0);
+    for (size_t i = 0; i < src.size(); ++i) (*dest)[i] += src[i];
+  };
+  merge_counts(other.branching_histogram, &stats.branching_histogram);
+  merge_counts(other.states_per_level, &stats.states_per_level);
+  merge_counts(other.chance_nodes_per_level, &stats.chance_nodes_per_level);
+  if (into->infosets_by_level.size() < from.infosets_by_level.size()) {
+    into->infosets_by_level.resize(from.infosets_by_level.size());
+  }
+  for (size_t depth = 0; depth < from.infosets_by_level.size(); ++depth) {
+    for (const std::string& infoset : from.infosets_by_level[depth]) {
+      into->infosets_by_level[depth].insert(infoset);
+    }
+  }
+}
+
+TreeStatistics Finalize(PartialProfile&& partial, bool track_infosets) {
+  TreeStatistics stats = std::move(partial.stats);
+  if (track_infosets) {
+    stats.information_states_per_level.resize(partial.infosets_by_level.size(),
+                                              0);
+    for (size_t depth = 0; depth < partial.infosets_by_level.size(); ++depth) {
+      stats.information_states_per_level[depth] =
+          partial.infosets_by_level[depth].size();
+    }
+  }
+  return stats;
+}
+
+void AppendCounts(const std::string& label, const std::vector<int64_t>& counts,
+                  std::string* result) {
+  absl::StrAppend(result, label, ":");
+  for (int64_t count : counts) absl::StrAppend(result, " ", count);
+  absl::StrAppend(result, "\n");
+}
+
+}  // namespace
+
+double TreeStatistics::AverageBranchingFactor() const {
+  int64_t nodes = 0;
+  int64_t edges = 0;
+  for (size_t b = 0; b < branching_histogram.size(); ++b) {
+    nodes += branching_histogram[b];
+    edges += b * branching_histogram[b];
+  }
+  return nodes == 0 ? 0. : static_cast<double>(edges) / nodes;
+}
+
+std::string TreeStatistics::ToString() const {
+  std::string result = absl::StrCat(
+      "States: ", num_states, " (", num_decision_nodes, " decision, ",
+      num_chance_nodes, " chance, ", num_terminal_states, " terminal)\n",
+      "Max depth: ", MaxDepth(), "\n",
+      "Average branching factor: ", AverageBranchingFactor(), "\n");
+  if (num_episodes > 0) {
+    absl::StrAppend(&result, "Sampled from ", num_episodes, " episodes\n");
+  }
+  absl::StrAppend(&result, "Branching histogram:");
+  for (size_t b = 0; b < branching_histogram.size(); ++b) {
+    if (branching_histogram[b] > 0) {
+      absl::StrAppend(&result, " ", b, ":", branching_histogram[b]);
+    }
+  }
+  absl::StrAppend(&result, "\n");
+  AppendCounts("States per level", states_per_level, &result);
+  AppendCounts("Chance nodes per level", chance_nodes_per_level, &result);
+  if (!information_states_per_level.empty()) {
+    AppendCounts("Information states per level", information_states_per_level,
+                 &result);
+  }
+  return result;
+}
+
+TreeStatistics ProfileGameTree(const Game& game, int depth_limit) {
+  const bool track_infosets = game.GetType().provides_information_state;
+  TaskPool* pool = TaskPool::Global();
+  std::vector<PartialProfile> partials(pool->NumSlots());
+  std::unique_ptr<State> root = game.NewInitialState();
+  PartialProfile merged;
+  CountNode(*root, /*depth=*/0, track_infosets, &merged);
+  if (!root->IsTerminal() && depth_limit != 0) {
+    // One task per top-level subtree; tasks sharing a worker run one
+    // after another, so the per-slot partials need no locking.
+    TaskGroup group(pool);
+    for (Action action : root->LegalActions()) {
+      std::shared_ptr<State> child = root->Child(action);
+      group.Spawn([child, depth_limit, track_infosets, pool, &partials]() {
+        WalkSubtree(*child, /*depth=*/1, depth_limit, track_infosets,
+                    &partials[pool->CurrentSlot()]);
+      });
+    }
+    group.Sync();
+  }
+  for (PartialProfile& partial : partials) {
+    MergeInto(std::move(partial), &merged);
+  }
+  return Finalize(std::move(merged), track_infosets);
+}
+
+TreeStatistics SampleGameTree(const Game& game, int num_episodes, int seed) {
+  const bool track_infosets = game.GetType().provides_information_state;
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  PartialProfile partial;
+  for (int episode = 0; episode < num_episodes; ++episode) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    int depth = 0;
+    CountNode(*state, depth, track_infosets, &partial);
+    while (!state->IsTerminal()) {
+      Action action;
+      if (state->IsChanceNode()) {
+        action = SampleChanceOutcome(state->ChanceOutcomes(), uniform(rng));
+      } else {
+        const std::vector<Action> legal = state->LegalActions();
+        action = legal[std::uniform_int_distribution<int>(
+            0, legal.size() - 1)(rng)];
+      }
+      state->ApplyAction(action);
+      CountNode(*state, ++depth, track_infosets, &partial);
+    }
+  }
+  TreeStatistics stats = Finalize(std::move(partial), track_infosets);
+  stats.num_episodes = num_episodes;
+  return stats;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,87 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_STATISTICS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_STATISTICS_H_
+
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+// Shape statistics of a game tree - the branching factor distribution,
+// states and information states per level, chance density - gathered in a
+// single walk. Solver settings (tabular vs sampled, how to partition the
+// tree across workers, transposition table sizing) depend on exactly these
+// numbers, and deriving them by materializing GetAllStates and
+// post-processing pays for a full state map that is thrown away.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct TreeStatistics {
+  // Node counts over the walked tree. Like the tree itself, these count
+  // one node per path from the root, so a state reached by several move
+  // orders contributes once per path.
+  int64_t num_states = 0;
+  int64_t num_decision_nodes = 0;
+  int64_t num_chance_nodes = 0;
+  int64_t num_terminal_states = 0;
+
+  // branching_histogram[b] is the number of non-terminal nodes with b
+  // legal actions (chance nodes: b outcomes).
+  std::vector<int64_t> branching_histogram;
+
+  // Per-level counts, indexed by depth (the root is level 0; every action,
+  // including a chance outcome, adds a level).
+  std::vector<int64_t> states_per_level;
+  std::vector<int64_t> chance_nodes_per_level;
+
+  // Distinct information states among the decision nodes of each level.
+  // Filled only when the game provides information states; in sampling
+  // mode the counts cover the sampled nodes, a lower bound on the truth.
+  std::vector<int64_t> information_states_per_level;
+
+  // Number of playouts the statistics were estimated from; 0 for an exact
+  // walk.
+  int64_t num_episodes = 0;
+
+  // The deepest level walked; -1 if nothing was.
+  int MaxDepth() const { return static_cast<int>(states_per_level.size()) - 1; }
+
+  // Mean legal actions over all non-terminal nodes.
+  double AverageBranchingFactor() const;
+
+  // A human-readable multi-line summary.
+  std::string ToString() const;
+};
+
+// Exact profile of the game tree down to depth_limit (negative for no
+// limit). Walks every path once, splitting top-level subtrees across the
+// shared TaskPool. Small games only: the walk touches the full tree, but
+// unlike GetAllStates it retains nothing beyond the histograms and one set
+// of information-state strings per level.
+TreeStatistics ProfileGameTree(const Game& game, int depth_limit = -1);
+
+// Sampling profile for games too large to enumerate: aggregates the same
+// statistics over the nodes visited by num_episodes uniform-random
+// playouts. Level counts then measure visit mass rather than tree size,
+// and rare deep lines are under-represented, but branching and chance
+// density come out close at a tiny fraction of the cost.
+TreeStatistics SampleGameTree(const Game& game, int num_episodes, int seed);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_STATISTICS_H_
@@ -0,0 +1,106 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tree_statistics.h"
+
+#include <numeric>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void KuhnExactProfile() {
+  // Kuhn poker's tree is small enough to check against hand counts: two
+  // chance levels dealing 3 x 2 cards, then a betting tree of 4 decision
+  // nodes and 5 terminals per deal.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TreeStatistics stats = ProfileGameTree(*game);
+  SPIEL_CHECK_EQ(stats.num_states, 58);
+  SPIEL_CHECK_EQ(stats.num_chance_nodes, 4);
+  SPIEL_CHECK_EQ(stats.num_decision_nodes, 24);
+  SPIEL_CHECK_EQ(stats.num_terminal_states, 30);
+  SPIEL_CHECK_EQ(stats.num_episodes, 0);
+  SPIEL_CHECK_EQ(stats.MaxDepth(), 5);
+
+  std::vector<int64_t> expected_states_per_level = {1, 3, 6, 12, 24, 12};
+  SPIEL_CHECK_TRUE(stats.states_per_level == expected_states_per_level);
+  std::vector<int64_t> expected_chance_per_level = {1, 3, 0, 0, 0, 0};
+  SPIEL_CHECK_TRUE(stats.chance_nodes_per_level == expected_chance_per_level);
+
+  // Every node but the root (3 cards) has two legal actions or outcomes.
+  SPIEL_CHECK_EQ(stats.branching_histogram[2], 27);
+  SPIEL_CHECK_EQ(stats.branching_histogram[3], 1);
+  SPIEL_CHECK_FLOAT_EQ(stats.AverageBranchingFactor(), 57.0 / 28);
+
+  // 3 first-move infosets (own card), 6 for the reply (card x action),
+  // 3 after pass-bet: kuhn_poker's 12 information sets by level.
+  std::vector<int64_t> expected_infosets_per_level = {0, 0, 3, 6, 3, 0};
+  SPIEL_CHECK_TRUE(stats.information_states_per_level ==
+                   expected_infosets_per_level);
+  SPIEL_CHECK_FALSE(stats.ToString().empty());
+}
+
+void DepthLimitedProfile() {
+  // The first three plies of tic_tac_toe; branching is recorded for the
+  // cut-off level too.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  TreeStatistics stats = ProfileGameTree(*game, /*depth_limit=*/2);
+  SPIEL_CHECK_EQ(stats.num_states, 1 + 9 + 72);
+  SPIEL_CHECK_EQ(stats.num_terminal_states, 0);
+  SPIEL_CHECK_EQ(stats.num_chance_nodes, 0);
+  std::vector<int64_t> expected_states_per_level = {1, 9, 72};
+  SPIEL_CHECK_TRUE(stats.states_per_level == expected_states_per_level);
+  SPIEL_CHECK_EQ(stats.branching_histogram[9], 1);
+  SPIEL_CHECK_EQ(stats.branching_histogram[8], 9);
+  SPIEL_CHECK_EQ(stats.branching_histogram[7], 72);
+}
+
+void SampledProfileIsConsistent() {
+  constexpr int kNumEpisodes = 100;
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TreeStatistics stats = SampleGameTree(*game, kNumEpisodes, /*seed=*/7263);
+  SPIEL_CHECK_EQ(stats.num_episodes, kNumEpisodes);
+  SPIEL_CHECK_EQ(stats.num_states,
+                 std::accumulate(stats.states_per_level.begin(),
+                                 stats.states_per_level.end(), int64_t{0}));
+  SPIEL_CHECK_EQ(stats.num_states, stats.num_decision_nodes +
+                                       stats.num_chance_nodes +
+                                       stats.num_terminal_states);
+  // Every playout passes both chance levels and ends in one terminal.
+  SPIEL_CHECK_EQ(stats.states_per_level[0], kNumEpisodes);
+  SPIEL_CHECK_EQ(stats.num_chance_nodes, 2 * kNumEpisodes);
+  SPIEL_CHECK_EQ(stats.num_terminal_states, kNumEpisodes);
+  SPIEL_CHECK_LE(stats.MaxDepth(), 5);
+  // Sampled infoset counts never exceed the exact ones.
+  TreeStatistics exact = ProfileGameTree(*game);
+  for (size_t d = 0; d < stats.information_states_per_level.size(); ++d) {
+    SPIEL_CHECK_LE(stats.information_states_per_level[d],
+                   exact.information_states_per_level[d]);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace alg = open_spiel::algorithms;
+
+int main() {
+  alg::KuhnExactProfile();
+  alg::DepthLimitedProfile();
+  alg::SampledProfileIsConsistent();
+}
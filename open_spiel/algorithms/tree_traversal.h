@@ -0,0 +1,74 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
+
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+// Explicit-stack frame storage for iterative tree traversals. The recursive
+// tree walkers in this directory (CFR, expected returns, the history-tree
+// builder) allocate one call frame per node on the path from the root, which
+// both bounds the supported game depth by the thread stack size and pays
+// allocator churn for the vectors inside each frame. A FrameStack replaces
+// the call stack with an explicit stack of frames: frames are popped by
+// decrementing the depth without destroying them, so a frame slot — and the
+// heap buffers owned by its vectors — is reused by the next push at that
+// depth. After the traversal warms up, descending the tree allocates nothing.
+
+namespace open_spiel {
+namespace algorithms {
+
+// A stack of traversal frames with preallocated, reusable slots. Frame must
+// be default-constructible; the caller re-initializes a frame's fields after
+// each Push, typically by clear()-ing its vectors (which keeps their
+// capacity).
+//
+// Push may grow the underlying storage and invalidate references to frames,
+// so traversal loops hold frame *indices* across pushes and re-resolve them
+// through operator[].
+template <typename Frame>
+class FrameStack {
+ public:
+  // Pushes a frame and returns its index. The frame's fields hold whatever
+  // the previous occupant of the slot left there.
+  int Push() {
+    if (depth_ == frames_.size()) frames_.emplace_back();
+    return depth_++;
+  }
+
+  // Pops the top frame. The frame object is kept alive so that its buffers
+  // are reused by the next Push at this depth.
+  void Pop() {
+    SPIEL_CHECK_GT(depth_, 0);
+    --depth_;
+  }
+
+  bool Empty() const { return depth_ == 0; }
+  int Depth() const { return depth_; }
+
+  Frame& Top() { return frames_[depth_ - 1]; }
+  Frame& operator[](int index) { return frames_[index]; }
+
+ private:
+  std::vector<Frame> frames_;
+  int depth_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
@@ -0,0 +1,99 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tree_traversal.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+struct TestFrame {
+  std::vector<double> values;
+  int next_child = 0;
+};
+
+void TestDepthBookkeeping() {
+  FrameStack<TestFrame> stack;
+  SPIEL_CHECK_TRUE(stack.Empty());
+  SPIEL_CHECK_EQ(stack.Depth(), 0);
+
+  const int first = stack.Push();
+  SPIEL_CHECK_EQ(first, 0);
+  stack.Top().next_child = 7;
+  const int second = stack.Push();
+  SPIEL_CHECK_EQ(second, 1);
+  SPIEL_CHECK_EQ(stack.Depth(), 2);
+  stack.Top().next_child = 11;
+
+  // Frames are addressable by index while deeper frames are open.
+  SPIEL_CHECK_EQ(stack[first].next_child, 7);
+  SPIEL_CHECK_EQ(stack[second].next_child, 11);
+
+  stack.Pop();
+  SPIEL_CHECK_EQ(stack.Depth(), 1);
+  SPIEL_CHECK_EQ(stack.Top().next_child, 7);
+  stack.Pop();
+  SPIEL_CHECK_TRUE(stack.Empty());
+}
+
+void TestSlotReuse() {
+  FrameStack<TestFrame> stack;
+  stack.Push();
+  stack.Top().values.assign(1000, 1.0);
+  const double* buffer = stack.Top().values.data();
+  stack.Pop();
+
+  // The next push at this depth reuses the frame, so after a clear() the
+  // vector still owns its old buffer and refilling it allocates nothing.
+  TestFrame& frame = stack[stack.Push()];
+  frame.values.clear();
+  SPIEL_CHECK_GE(frame.values.capacity(), 1000);
+  frame.values.assign(1000, 2.0);
+  SPIEL_CHECK_TRUE(frame.values.data() == buffer);
+  stack.Pop();
+}
+
+void TestDeepChain() {
+  // Walk down and back up a chain far deeper than any thread stack could
+  // support with one call frame (plus frame-local vector) per node.
+  constexpr int kDepth = 1000000;
+  FrameStack<TestFrame> stack;
+  for (int i = 0; i < kDepth; ++i) {
+    TestFrame& frame = stack[stack.Push()];
+    frame.values.assign(8, static_cast<double>(i));
+    frame.next_child = 0;
+  }
+  SPIEL_CHECK_EQ(stack.Depth(), kDepth);
+  int64_t sum = 0;
+  while (!stack.Empty()) {
+    sum += static_cast<int64_t>(stack.Top().values[0]);
+    stack.Pop();
+  }
+  SPIEL_CHECK_EQ(sum, static_cast<int64_t>(kDepth) * (kDepth - 1) / 2);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TestDepthBookkeeping();
+  open_spiel::algorithms::TestSlotReuse();
+  open_spiel::algorithms::TestDeepChain();
+}
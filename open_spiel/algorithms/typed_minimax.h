@@ -0,0 +1,123 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_MINIMAX_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_MINIMAX_H_
+
+#include <limits>
+#include <utility>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Opt-in compile-time fast path for alpha-beta over a concrete state type
+// (e.g. tic_tac_toe::TicTacToeState), in the typed_rollout.h mold: states
+// are stack value copies, so the compiler knows every object's dynamic
+// type, devirtualizes ApplyAction, LegalActions, IsTerminal and friends,
+// and inlines them into the search loop. The values returned match
+// AlphaBetaSearch move for move; exhaustive-verification jobs that solve
+// the same fixed game millions of times instantiate this instead of
+// paying the generic solver's dispatch per node.
+//
+// Only full walks are supported (no value function and no transposition
+// table - for those, use the generic solvers); the game must be
+// deterministic, perfect-information and zero-sum, like AlphaBetaSearch.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Alpha-beta over the subtree under `state`, as _alpha_beta in minimax.cc
+// but with static dispatch. Exceeding `depth_remaining` before reaching
+// the terminals is a fatal error, since there is no value function to
+// evaluate the frontier with.
+template <typename StateT>
+double TypedAlphaBeta(const StateT& state, int depth_remaining, double alpha,
+                      double beta, Player maximizing_player) {
+  if (state.IsTerminal()) {
+    const State& base = state;
+    return base.PlayerReturn(maximizing_player);
+  }
+  if (depth_remaining == 0) {
+    SpielFatalError(
+        "TypedAlphaBeta must walk the full depth of the tree. "
+        "Try increasing depth_limit.");
+  }
+
+  const State& base = state;
+  const bool maximizing = base.CurrentPlayer() == maximizing_player;
+  double value = maximizing ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+  for (Action action : state.LegalActions()) {
+    StateT child(state);
+    child.ApplyAction(action);
+    const double child_value = TypedAlphaBeta(
+        child, depth_remaining - 1, alpha, beta, maximizing_player);
+    if (maximizing) {
+      value = std::max(value, child_value);
+      alpha = std::max(alpha, value);
+    } else {
+      value = std::min(value, child_value);
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) break;
+  }
+  return value;
+}
+
+// Solves the game from `root`, returning the value for the maximizing
+// player under optimal play and an action achieving it. Passing
+// kInvalidPlayer takes the maximizing player from the root. A negative
+// `depth_limit` searches to the game's maximum length.
+template <typename StateT>
+std::pair<double, Action> TypedAlphaBetaSearch(const StateT& root,
+                                               int depth_limit,
+                                               Player maximizing_player) {
+  const State& base = root;
+  SPIEL_CHECK_FALSE(base.IsChanceNode());
+  SPIEL_CHECK_FALSE(base.IsTerminal());
+  if (maximizing_player == kInvalidPlayer) {
+    maximizing_player = base.CurrentPlayer();
+  }
+  if (depth_limit < 0) {
+    depth_limit = base.GetGame()->MaxGameLength();
+  }
+
+  const bool maximizing = base.CurrentPlayer() == maximizing_player;
+  double alpha = -std::numeric_limits<double>::infinity();
+  double beta = std::numeric_limits<double>::infinity();
+  double value = maximizing ? alpha : beta;
+  Action best_action = kInvalidAction;
+  for (Action action : root.LegalActions()) {
+    StateT child(root);
+    child.ApplyAction(action);
+    const double child_value = TypedAlphaBeta(
+        child, depth_limit - 1, alpha, beta, maximizing_player);
+    if (maximizing ? child_value > value : child_value < value) {
+      value = child_value;
+      best_action = action;
+    }
+    if (maximizing) {
+      alpha = std::max(alpha, value);
+    } else {
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) break;
+  }
+  return std::pair<double, Action>(value, best_action);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_MINIMAX_H_
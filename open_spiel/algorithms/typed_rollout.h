@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_ROLLOUT_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_ROLLOUT_H_
+
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Opt-in compile-time fast path for rollouts and traversals over a concrete
+// state type (e.g. tic_tac_toe::TicTacToeState). Everything here works on
+// value copies of StateT, so the compiler knows each object's dynamic type
+// exactly and can devirtualize and inline ApplyAction, LegalActions,
+// CurrentPlayer and friends, which virtual dispatch through State* blocks.
+// The semantics match the equivalent State-based loops draw for draw: code
+// that is generic over games keeps using State*, and binaries specialized to
+// a known game instantiate these instead.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Plays one uniformly random playout to the end of the game and returns the
+// terminal returns. `state` is taken by value: pass the position to roll out
+// from and the engine mutates its own copy in place.
+template <typename StateT>
+std::vector<double> RandomRollout(StateT state, SplittableRandom* rng) {
+  while (!state.IsTerminal()) {
+    if (state.IsChanceNode()) {
+      state.ApplyAction(state.SampleChanceOutcome(rng->NextDouble()).first);
+    } else if (state.IsSimultaneousNode()) {
+      // Concrete states usually only override LegalActions(); go through the
+      // base for the per-player overload so it is not hidden. The dynamic
+      // type is still known, so this stays devirtualizable.
+      const State& base = state;
+      std::vector<Action> joint_action(base.NumPlayers());
+      for (Player player = 0; player < base.NumPlayers(); ++player) {
+        std::vector<Action> actions = base.LegalActions(player);
+        joint_action[player] = actions[rng->NextInt(actions.size())];
+      }
+      state.ApplyActions(joint_action);
+    } else {
+      state.ApplyAction(state.SampleLegalAction(rng->NextDouble()));
+    }
+  }
+  return state.Returns();
+}
+
+// Mean returns over `num_rollouts` random playouts from `state`.
+template <typename StateT>
+std::vector<double> AverageRolloutReturns(const StateT& state, int num_rollouts,
+                                          SplittableRandom* rng) {
+  SPIEL_CHECK_GT(num_rollouts, 0);
+  std::vector<double> sums(state.NumPlayers(), 0);
+  for (int i = 0; i < num_rollouts; ++i) {
+    std::vector<double> returns = RandomRollout(state, rng);
+    for (Player player = 0; player < sums.size(); ++player) {
+      sums[player] += returns[player];
+    }
+  }
+  for (double& sum : sums) sum /= num_rollouts;
+  return sums;
+}
+
+// Depth-first traversal of the subtree under `state` with static dispatch.
+// `visit` is invoked on every state, terminals included. Children are stack
+// value copies, so the traversal does not touch the heap for states. At
+// simultaneous nodes the flat joint actions are expanded, matching what
+// State::LegalActions does for SimMoveState.
+template <typename StateT, typename Visitor>
+void TraverseSubtree(const StateT& state, Visitor&& visit) {
+  visit(state);
+  if (state.IsTerminal()) return;
+  for (Action action : state.LegalActions()) {
+    StateT child(state);
+    child.ApplyAction(action);
+    TraverseSubtree(child, visit);
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TYPED_ROLLOUT_H_
@@ -0,0 +1,115 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/typed_rollout.h"
+
+#include <functional>
+#include <memory>
+
+#include "open_spiel/games/blotto.h"
+#include "open_spiel/games/catch.h"
+#include "open_spiel/games/tic_tac_toe.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Reference playout through the virtual State interface, drawing from the
+// rng in the same order as RandomRollout. With equal seeds the two must
+// produce identical returns.
+std::vector<double> VirtualRollout(const State& root, SplittableRandom* rng) {
+  std::unique_ptr<State> state = root.Clone();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(rng->NextDouble()).first);
+    } else if (state->IsSimultaneousNode()) {
+      std::vector<Action> joint_action(state->NumPlayers());
+      for (Player player = 0; player < state->NumPlayers(); ++player) {
+        std::vector<Action> actions = state->LegalActions(player);
+        joint_action[player] = actions[rng->NextInt(actions.size())];
+      }
+      state->ApplyActions(joint_action);
+    } else {
+      state->ApplyAction(state->SampleLegalAction(rng->NextDouble()));
+    }
+  }
+  return state->Returns();
+}
+
+template <typename StateT>
+void CheckRolloutsMatchVirtual(const std::string& game_name, int num_episodes,
+                               int seed) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::unique_ptr<State> root = game->NewInitialState();
+  const StateT& typed_root = static_cast<const StateT&>(*root);
+  SplittableRandom typed_rng(seed);
+  SplittableRandom virtual_rng(seed);
+  for (int episode = 0; episode < num_episodes; ++episode) {
+    std::vector<double> typed_returns = RandomRollout(typed_root, &typed_rng);
+    std::vector<double> virtual_returns = VirtualRollout(*root, &virtual_rng);
+    SPIEL_CHECK_TRUE(typed_returns == virtual_returns);
+  }
+}
+
+void RolloutsMatchVirtualPath() {
+  // Turn-based, chance, and simultaneous games respectively.
+  CheckRolloutsMatchVirtual<tic_tac_toe::TicTacToeState>("tic_tac_toe", 100,
+                                                         2837);
+  CheckRolloutsMatchVirtual<catch_::CatchState>("catch", 100, 2837);
+  CheckRolloutsMatchVirtual<blotto::BlottoState>("blotto", 100, 2837);
+}
+
+void AverageReturnsAreZeroSum() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> root = game->NewInitialState();
+  SplittableRandom rng(61234);
+  std::vector<double> avg = AverageRolloutReturns(
+      static_cast<const tic_tac_toe::TicTacToeState&>(*root), 1000, &rng);
+  SPIEL_CHECK_EQ(avg.size(), 2);
+  SPIEL_CHECK_FLOAT_NEAR(avg[0] + avg[1], 0., 1e-12);
+}
+
+// The typed traversal must see exactly as many states as one through the
+// virtual interface.
+void TraversalCountsMatch() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> root = game->NewInitialState();
+
+  int64_t virtual_count = 0;
+  std::function<void(const State&)> walk = [&](const State& state) {
+    ++virtual_count;
+    if (state.IsTerminal()) return;
+    for (Action action : state.LegalActions()) {
+      walk(*state.Child(action));
+    }
+  };
+  walk(*root);
+
+  int64_t typed_count = 0;
+  TraverseSubtree(static_cast<const tic_tac_toe::TicTacToeState&>(*root),
+                  [&](const tic_tac_toe::TicTacToeState&) { ++typed_count; });
+  SPIEL_CHECK_EQ(typed_count, virtual_count);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::RolloutsMatchVirtualPath();
+  open_spiel::algorithms::AverageReturnsAreZeroSum();
+  open_spiel::algorithms::TraversalCountsMatch();
+}
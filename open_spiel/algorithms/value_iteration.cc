@@ -15,6 +15,10 @@
 #include "open_spiel/algorithms/value_iteration.h"
 
 #include <algorithm>
+#include <limits>
+#include <queue>
+#include <thread>  // NOLINT
+#include <unordered_map>
 
 #include "open_spiel/spiel_utils.h"
 
@@ -25,45 +29,248 @@ namespace {
 using std::map;
 using std::vector;
 using state_pointer = std::unique_ptr<State>;
-using state_action = std::pair<std::string, Action>;
-using state_prob = std::pair<std::string, double>;
-
-// Adds transitions and transition probability from a given state
-void AddTransition(map<state_action, vector<state_prob>>* transitions,
-                   std::string key, const state_pointer& state) {
-  for (auto action : state->LegalActions()) {
-    auto next_state = state->Clone();
-    next_state->ApplyAction(action);
-    vector<state_prob> possibilities;
-    if (next_state->IsChanceNode()) {
-      // For a chance node, record the transition probabilities
-      for (const auto& actionprob : next_state->ChanceOutcomes()) {
-        auto realized_next_state = next_state->Clone();
-        realized_next_state->ApplyAction(actionprob.first);
-        possibilities.emplace_back(realized_next_state->ToString(),
-                                   actionprob.second);
-      }
-    } else {
-      // A non-chance node is equivalent to transition with probability 1
-      possibilities.emplace_back(next_state->ToString(), 1.0);
-    }
-    (*transitions)[std::make_pair(key, action)] = possibilities;
-  }
+
+// The game indexed for sweeping: states are numbered in key order and every
+// string lookup is resolved once, so the sweeps themselves touch only
+// vectors. Next states beyond the depth limit are mapped to one extra
+// sentinel entry whose value stays zero, matching what the map-based
+// implementation did for keys it had never swept.
+//
+// The transition graph is stored as flat arrays so that a sweep is one
+// contiguous pass: the actions of state i are the index range
+// [action_begin[i], action_begin[i + 1]) — empty for terminal states — and
+// the outcomes of action a are [outcome_begin[a], outcome_begin[a + 1]) in
+// next_states/probabilities.
+struct IndexedStates {
+  vector<const std::string*> keys;
+  vector<Player> players;  // kTerminalPlayerId for terminal states.
+  // values has one extra trailing entry: the zero-valued sentinel.
+  vector<double> values;
+  vector<int> action_begin;
+  vector<int> outcome_begin;
+  vector<int> next_states;
+  vector<double> probabilities;
+
+  int NumStates() const { return players.size(); }
+  bool IsTerminal(int i) const { return players[i] == kTerminalPlayerId; }
+};
+
+// Resolves a successor state to its index (or the sentinel).
+int IndexOrSentinel(const std::unordered_map<std::string, int>& index_of,
+                    const std::string& key, int sentinel) {
+  auto it = index_of.find(key);
+  return it == index_of.end() ? sentinel : it->second;
 }
 
-// Initialize transition map and value map
-void InitializeMaps(const map<std::string, state_pointer>& states,
-                    map<std::string, double>* values,
-                    map<state_action, vector<state_prob>>* transitions) {
+IndexedStates BuildIndex(const map<std::string, state_pointer>& states) {
+  IndexedStates index;
+  const int num_states = states.size();
+  std::unordered_map<std::string, int> index_of;
+  index_of.reserve(num_states);
+  index.keys.reserve(num_states);
   for (const auto& kv : states) {
-    auto key = kv.first;
-    if (kv.second->IsTerminal()) {
+    index_of[kv.first] = index.keys.size();
+    index.keys.push_back(&kv.first);
+  }
+
+  index.players.resize(num_states);
+  index.values.assign(num_states + 1, 0);  // Trailing entry: the sentinel.
+  index.action_begin.reserve(num_states + 1);
+  int i = 0;
+  for (const auto& kv : states) {
+    const state_pointer& state = kv.second;
+    index.action_begin.push_back(index.outcome_begin.size());
+    if (state->IsTerminal()) {
+      index.players[i] = kTerminalPlayerId;
       // For both 1-player and 2-player zero sum games, suffices to look at
-      // player 0's utility
-      (*values)[key] = kv.second->PlayerReturn(Player{0});
+      // player 0's utility.
+      index.values[i] = state->PlayerReturn(Player{0});
     } else {
-      (*values)[key] = 0;
-      AddTransition(transitions, key, kv.second);
+      index.players[i] = state->CurrentPlayer();
+      for (auto action : state->LegalActions()) {
+        auto next_state = state->Clone();
+        next_state->ApplyAction(action);
+        index.outcome_begin.push_back(index.next_states.size());
+        if (next_state->IsChanceNode()) {
+          // For a chance node, record the transition probabilities.
+          for (const auto& actionprob : next_state->ChanceOutcomes()) {
+            auto realized_next_state = next_state->Clone();
+            realized_next_state->ApplyAction(actionprob.first);
+            index.next_states.push_back(IndexOrSentinel(
+                index_of, realized_next_state->ToString(), num_states));
+            index.probabilities.push_back(actionprob.second);
+          }
+        } else {
+          // A non-chance node is equivalent to transition with probability 1.
+          index.next_states.push_back(
+              IndexOrSentinel(index_of, next_state->ToString(), num_states));
+          index.probabilities.push_back(1.0);
+        }
+      }
+    }
+    ++i;
+  }
+  // Trailing sentinels so every range has an end.
+  index.action_begin.push_back(index.outcome_begin.size());
+  index.outcome_begin.push_back(index.next_states.size());
+  return index;
+}
+
+// One Bellman backup of state i against the given value vector.
+double Backup(const IndexedStates& index, const vector<double>& values, int i,
+              double min_utility) {
+  // Initialize value to be the minimum utility if current player is the
+  // maximizing player (i.e. player 0), and to maximum utility if current
+  // player is the minimizing player (i.e. player 1).
+  const Player player = index.players[i];
+  double value = player == Player{1} ? -min_utility : min_utility;
+  for (int a = index.action_begin[i]; a < index.action_begin[i + 1]; ++a) {
+    double q_value = 0;
+    for (int o = index.outcome_begin[a]; o < index.outcome_begin[a + 1]; ++o) {
+      q_value += index.probabilities[o] * values[index.next_states[o]];
+    }
+    // Player 0 is maximizing the value (which is w.r.t. player 0),
+    // player 1 is minimizing the value.
+    value = player == Player{0} ? std::max(value, q_value)
+                                : std::min(value, q_value);
+  }
+  return value;
+}
+
+// Serial Gauss-Seidel sweeps: each backup sees the values already updated
+// earlier in the same sweep.
+void GaussSeidelSweeps(IndexedStates* index, double threshold,
+                       double min_utility) {
+  double error;
+  do {
+    error = 0;
+    for (int i = 0; i < index->NumStates(); ++i) {
+      if (index->IsTerminal(i)) continue;
+      const double value = Backup(*index, index->values, i, min_utility);
+      error = std::max(std::abs(index->values[i] - value), error);
+      index->values[i] = value;
+    }
+  } while (error > threshold);
+}
+
+// Parallel Jacobi sweeps: every backup of a sweep reads the previous sweep's
+// values, so the state index can be partitioned over workers freely.
+void JacobiSweeps(IndexedStates* index, double threshold, int num_threads,
+                  double min_utility) {
+  const int num_states = index->NumStates();
+  vector<double> next_values = index->values;
+  vector<double> errors(num_threads);
+  double error;
+  do {
+    {
+      vector<std::thread> threads;
+      threads.reserve(num_threads);
+      for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([t, num_threads, num_states, min_utility, index,
+                              &next_values, &errors]() {
+          double thread_error = 0;
+          for (int i = t; i < num_states; i += num_threads) {
+            if (index->IsTerminal(i)) continue;
+            const double value = Backup(*index, index->values, i, min_utility);
+            thread_error =
+                std::max(std::abs(index->values[i] - value), thread_error);
+            next_values[i] = value;
+          }
+          errors[t] = thread_error;
+        });
+      }
+      for (std::thread& thread : threads) thread.join();
+    }
+    error = *std::max_element(errors.begin(), errors.end());
+    std::swap(index->values, next_values);
+  } while (error > threshold);
+}
+
+// Prioritized sweeping: each worker owns the states i with
+// i % num_threads == t and keeps a max-heap of them ordered by how large a
+// value change could still reach them (their Bellman-residual bound). A
+// round backs up, in parallel, every state whose priority exceeds the
+// threshold — against the previous round's values, so the outcome does not
+// depend on the number of workers — and then bumps the priorities of the
+// predecessors of every state whose value moved. States in converged
+// regions keep a priority below the threshold and are never revisited.
+void PrioritizedSweeps(IndexedStates* index, double threshold, int num_threads,
+                       double min_utility) {
+  const int num_states = index->NumStates();
+
+  // Unique predecessor lists, for propagating residuals backwards.
+  vector<vector<int>> predecessors(num_states);
+  for (int i = 0; i < num_states; ++i) {
+    for (int o = index->outcome_begin[index->action_begin[i]];
+         o < index->outcome_begin[index->action_begin[i + 1]]; ++o) {
+      if (index->next_states[o] < num_states) {
+        predecessors[index->next_states[o]].push_back(i);
+      }
+    }
+  }
+  for (vector<int>& preds : predecessors) {
+    std::sort(preds.begin(), preds.end());
+    preds.erase(std::unique(preds.begin(), preds.end()), preds.end());
+  }
+
+  // priority[i] is the best residual bound known for state i; heap entries
+  // are lazy and only valid while they match it.
+  vector<double> priority(num_states, 0);
+  vector<std::priority_queue<std::pair<double, int>>> heaps(num_threads);
+  for (int i = 0; i < num_states; ++i) {
+    if (index->IsTerminal(i)) continue;
+    priority[i] = std::numeric_limits<double>::infinity();
+    heaps[i % num_threads].emplace(priority[i], i);
+  }
+
+  vector<vector<std::pair<int, double>>> updates(num_threads);
+  while (true) {
+    // Drain phase: pop everything above the threshold and compute the new
+    // values. Only reads index->values, so the workers are independent.
+    {
+      vector<std::thread> threads;
+      threads.reserve(num_threads);
+      for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([t, threshold, min_utility, index, &priority,
+                              &heaps, &updates]() {
+          while (!heaps[t].empty() && heaps[t].top().first > threshold) {
+            const std::pair<double, int> entry = heaps[t].top();
+            heaps[t].pop();
+            if (entry.first != priority[entry.second]) continue;  // Stale.
+            updates[t].emplace_back(
+                entry.second,
+                Backup(*index, index->values, entry.second, min_utility));
+          }
+        });
+      }
+      for (std::thread& thread : threads) thread.join();
+    }
+
+    // Apply phase: reset the processed states' priorities first, so a state
+    // updated in this round can be re-prioritized by another update below,
+    // then write the values and propagate each change to its predecessors.
+    bool any_update = false;
+    for (int t = 0; t < num_threads; ++t) {
+      for (const auto& update : updates[t]) {
+        priority[update.first] = 0;
+        any_update = true;
+      }
+    }
+    if (!any_update) break;
+    for (int t = 0; t < num_threads; ++t) {
+      for (const auto& update : updates[t]) {
+        const int i = update.first;
+        const double delta = std::abs(index->values[i] - update.second);
+        index->values[i] = update.second;
+        if (delta == 0) continue;
+        for (int pred : predecessors[i]) {
+          if (delta > priority[pred]) {
+            priority[pred] = delta;
+            heaps[pred % num_threads].emplace(delta, pred);
+          }
+        }
+      }
+      updates[t].clear();
     }
   }
 }
@@ -71,10 +278,8 @@ void InitializeMaps(const map<std::string, state_pointer>& states,
 }  // namespace
 
 std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
-                                             double threshold) {
-  using state_action = std::pair<std::string, Action>;
-  using state_prob = std::pair<std::string, double>;
-
+                                             double threshold, int num_threads,
+                                             bool prioritized) {
   // Currently only supports 1-player or 2-player zero sum games
   SPIEL_CHECK_TRUE(game.NumPlayers() == 1 || game.NumPlayers() == 2);
   if (game.NumPlayers() == 2) {
@@ -86,50 +291,25 @@ std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
   SPIEL_CHECK_EQ(game.GetType().dynamics, GameType::Dynamics::kSequential);
   SPIEL_CHECK_EQ(game.GetType().information,
                  GameType::Information::kPerfectInformation);
+  SPIEL_CHECK_GE(num_threads, 1);
 
   auto states = GetAllStates(game, depth_limit, /*include_terminals=*/true,
                              /*include_chance_states=*/false);
-  std::map<std::string, double> values;
-  std::map<state_action, std::vector<state_prob>> transitions;
-
-  InitializeMaps(states, &values, &transitions);
-
-  double error;
-  double min_utility = game.MinUtility();
-  do {
-    error = 0;
-    for (const auto& kv : states) {
-      auto key = kv.first;
-
-      if (kv.second->IsTerminal()) continue;
-
-      auto player = kv.second->CurrentPlayer();
-
-      // Initialize value to be the minimum utility if current player
-      // is the maximizing player (i.e. player 0), and to maximum utility
-      // if current player is the minimizing player (i.e. player 1).
-      double value = min_utility;
-      if (player == Player{1}) value = -value;
-      for (auto action : kv.second->LegalActions()) {
-        auto possibilities = transitions[std::make_pair(key, action)];
-        double q_value = 0;
-        for (const auto& outcome : possibilities) {
-          q_value += outcome.second * values[outcome.first];
-        }
-        // Player 0 is maximizing the value (which is w.r.t. player 0)
-        // Player 1 is minimizing the value
-        if (player == Player{0})
-          value = std::max(value, q_value);
-        else
-          value = std::min(value, q_value);
-      }
+  IndexedStates index = BuildIndex(states);
 
-      double* stored_value = &values[key];
-      error = std::max(std::abs(*stored_value - value), error);
-      *stored_value = value;
-    }
-  } while (error > threshold);
+  const double min_utility = game.MinUtility();
+  if (prioritized) {
+    PrioritizedSweeps(&index, threshold, num_threads, min_utility);
+  } else if (num_threads == 1) {
+    GaussSeidelSweeps(&index, threshold, min_utility);
+  } else {
+    JacobiSweeps(&index, threshold, num_threads, min_utility);
+  }
 
+  std::map<std::string, double> values;
+  for (int i = 0; i < index.NumStates(); ++i) {
+    values[*index.keys[i]] = index.values[i];
+  }
   return values;
 }
 
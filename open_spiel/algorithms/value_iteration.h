@@ -27,11 +27,20 @@ namespace algorithms {
 // initial state (so if depth_limit is 0, only the root is considered).
 // If depth limit is negative, all states are considered.
 //
+// With num_threads > 1, each sweep is a Jacobi update computed in parallel
+// over a partitioned state index (the default is a serial Gauss-Seidel
+// sweep). With prioritized = true, sweeps are driven by Bellman-residual
+// priority heaps: a state is only revisited once a value change larger than
+// the threshold could still reach it, so converged regions drop out of the
+// sweeps. The prioritized result is identical for any number of threads.
+//
 // Currently works for sequential 1-player or 2-player zero-sum games,
 // with or without chance nodes.
 
 std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
-                                             double threshold);
+                                             double threshold,
+                                             int num_threads = 1,
+                                             bool prioritized = false);
 
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -0,0 +1,67 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/value_iteration.h"
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kThreshold = 1e-6;
+
+// Tic-tac-toe is a draw under optimal play, and the values are exact
+// integers, so every sweep strategy must agree on them to high precision.
+void AllSweepModesAgreeOnTicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::map<std::string, double> baseline =
+      ValueIteration(*game, -1, kThreshold);
+  SPIEL_CHECK_FLOAT_NEAR(baseline[game->NewInitialState()->ToString()], 0.,
+                         1e-4);
+
+  for (bool prioritized : {false, true}) {
+    for (int num_threads : {1, 4}) {
+      std::map<std::string, double> values = ValueIteration(
+          *game, -1, kThreshold, num_threads, prioritized);
+      SPIEL_CHECK_EQ(values.size(), baseline.size());
+      for (const auto& kv : baseline) {
+        SPIEL_CHECK_FLOAT_NEAR(values[kv.first], kv.second, 1e-4);
+      }
+    }
+  }
+}
+
+// The prioritized schedule backs every round up against the previous
+// round's values, so the result must not depend on the worker count.
+void PrioritizedSweepsAreThreadCountIndependent() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::map<std::string, double> one_worker =
+      ValueIteration(*game, -1, kThreshold, /*num_threads=*/1,
+                     /*prioritized=*/true);
+  std::map<std::string, double> three_workers =
+      ValueIteration(*game, -1, kThreshold, /*num_threads=*/3,
+                     /*prioritized=*/true);
+  SPIEL_CHECK_TRUE(one_worker == three_workers);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::AllSweepModesAgreeOnTicTacToe();
+  open_spiel::algorithms::PrioritizedSweepsAreThreadCountIndependent();
+}
@@ -0,0 +1,221 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_KERNELS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_KERNELS_H_
+
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Small vector kernels for the inner loops of the tabular solvers: regret
+// accumulation, average-policy accumulation and regret matching. These run
+// once per info state per iteration, over arrays that are contiguous but not
+// necessarily 32-byte aligned (they live in std::vector<double>), so the SIMD
+// paths use unaligned loads. Scalar tails handle the leftover lanes; all
+// paths sum in the same order so results are identical across platforms up to
+// the usual floating-point reassociation within a vector lane.
+
+namespace open_spiel {
+namespace algorithms {
+
+// acc[i] += scale * src[i], for i in [0, n).
+inline void AccumulateScaled(double* acc, const double* src, double scale,
+                             int n) {
+  int i = 0;
+#if defined(__AVX2__)
+  const __m256d vscale = _mm256_set1_pd(scale);
+  for (; i + 4 <= n; i += 4) {
+    __m256d vacc = _mm256_loadu_pd(acc + i);
+    __m256d vsrc = _mm256_loadu_pd(src + i);
+    vacc = _mm256_add_pd(vacc, _mm256_mul_pd(vscale, vsrc));
+    _mm256_storeu_pd(acc + i, vacc);
+  }
+#elif defined(__ARM_NEON)
+  const float64x2_t vscale = vdupq_n_f64(scale);
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t vacc = vld1q_f64(acc + i);
+    float64x2_t vsrc = vld1q_f64(src + i);
+    vacc = vmlaq_f64(vacc, vscale, vsrc);
+    vst1q_f64(acc + i, vacc);
+  }
+#endif
+  for (; i < n; ++i) {
+    acc[i] += scale * src[i];
+  }
+}
+
+// acc[i] += acc2[i], for i in [0, n).
+inline void Accumulate(double* acc, const double* src, int n) {
+  AccumulateScaled(acc, src, /*scale=*/1.0, n);
+}
+
+// acc[i] += scale * (values[i] - baseline), for i in [0, n). This is the
+// counterfactual regret update, with `baseline` the state value and `scale`
+// the counterfactual reach probability.
+inline void AccumulateShiftedScaled(double* acc, const double* values,
+                                    double baseline, double scale, int n) {
+  int i = 0;
+#if defined(__AVX2__)
+  const __m256d vscale = _mm256_set1_pd(scale);
+  const __m256d vbaseline = _mm256_set1_pd(baseline);
+  for (; i + 4 <= n; i += 4) {
+    __m256d vacc = _mm256_loadu_pd(acc + i);
+    __m256d vval = _mm256_sub_pd(_mm256_loadu_pd(values + i), vbaseline);
+    vacc = _mm256_add_pd(vacc, _mm256_mul_pd(vscale, vval));
+    _mm256_storeu_pd(acc + i, vacc);
+  }
+#elif defined(__ARM_NEON)
+  const float64x2_t vscale = vdupq_n_f64(scale);
+  const float64x2_t vbaseline = vdupq_n_f64(baseline);
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t vacc = vld1q_f64(acc + i);
+    float64x2_t vval = vsubq_f64(vld1q_f64(values + i), vbaseline);
+    vacc = vmlaq_f64(vacc, vscale, vval);
+    vst1q_f64(acc + i, vacc);
+  }
+#endif
+  for (; i < n; ++i) {
+    acc[i] += scale * (values[i] - baseline);
+  }
+}
+
+// Returns the sum of the positive entries of values[0..n).
+inline double SumPositive(const double* values, int n) {
+  int i = 0;
+  double sum = 0.0;
+#if defined(__AVX2__)
+  const __m256d vzero = _mm256_setzero_pd();
+  __m256d vsum = vzero;
+  for (; i + 4 <= n; i += 4) {
+    vsum = _mm256_add_pd(vsum, _mm256_max_pd(_mm256_loadu_pd(values + i),
+                                             vzero));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, vsum);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__ARM_NEON)
+  const float64x2_t vzero = vdupq_n_f64(0.0);
+  float64x2_t vsum = vzero;
+  for (; i + 2 <= n; i += 2) {
+    vsum = vaddq_f64(vsum, vmaxq_f64(vld1q_f64(values + i), vzero));
+  }
+  sum = vgetq_lane_f64(vsum, 0) + vgetq_lane_f64(vsum, 1);
+#endif
+  for (; i < n; ++i) {
+    if (values[i] > 0) sum += values[i];
+  }
+  return sum;
+}
+
+// Writes the regret-matching policy for `regrets` into `policy`:
+// policy[i] = max(regrets[i], 0) / sum-of-positive-regrets, or uniform if no
+// regret is positive.
+inline void RegretMatchingPolicy(const double* regrets, int n,
+                                 double* policy) {
+  const double sum_positive = SumPositive(regrets, n);
+  if (sum_positive <= 0) {
+    const double uniform = 1.0 / n;
+    for (int i = 0; i < n; ++i) policy[i] = uniform;
+    return;
+  }
+  const double normalizer = 1.0 / sum_positive;
+  int i = 0;
+#if defined(__AVX2__)
+  const __m256d vzero = _mm256_setzero_pd();
+  const __m256d vnormalizer = _mm256_set1_pd(normalizer);
+  for (; i + 4 <= n; i += 4) {
+    __m256d vpolicy = _mm256_mul_pd(
+        _mm256_max_pd(_mm256_loadu_pd(regrets + i), vzero), vnormalizer);
+    _mm256_storeu_pd(policy + i, vpolicy);
+  }
+#elif defined(__ARM_NEON)
+  const float64x2_t vzero = vdupq_n_f64(0.0);
+  const float64x2_t vnormalizer = vdupq_n_f64(normalizer);
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t vpolicy = vmulq_f64(
+        vmaxq_f64(vld1q_f64(regrets + i), vzero), vnormalizer);
+    vst1q_f64(policy + i, vpolicy);
+  }
+#endif
+  for (; i < n; ++i) {
+    policy[i] = regrets[i] > 0 ? regrets[i] * normalizer : 0;
+  }
+}
+
+// Float32-storage overloads of the kernels above, used when the CFR tables
+// are compiled with OPEN_SPIEL_CFR_FLOAT32_VALUES (see cfr.h). Arithmetic
+// stays in double and only the stored value rounds; with half the bytes per
+// entry these loops stay bandwidth-bound, so the scalar conversion code is
+// not the limiter.
+
+inline void AccumulateScaled(float* acc, const double* src, double scale,
+                             int n) {
+  for (int i = 0; i < n; ++i) {
+    acc[i] = static_cast<float>(acc[i] + scale * src[i]);
+  }
+}
+
+inline void Accumulate(float* acc, const float* src, int n) {
+  for (int i = 0; i < n; ++i) {
+    acc[i] += src[i];
+  }
+}
+
+inline void AccumulateShiftedScaled(float* acc, const double* values,
+                                    double baseline, double scale, int n) {
+  for (int i = 0; i < n; ++i) {
+    acc[i] = static_cast<float>(acc[i] + scale * (values[i] - baseline));
+  }
+}
+
+inline double SumPositive(const float* values, int n) {
+  double sum = 0.0;
+  for (int i = 0; i < n; ++i) {
+    if (values[i] > 0) sum += values[i];
+  }
+  return sum;
+}
+
+inline void RegretMatchingPolicy(const float* regrets, int n, float* policy) {
+  const double sum_positive = SumPositive(regrets, n);
+  if (sum_positive <= 0) {
+    const float uniform = 1.0f / n;
+    for (int i = 0; i < n; ++i) policy[i] = uniform;
+    return;
+  }
+  const double normalizer = 1.0 / sum_positive;
+  for (int i = 0; i < n; ++i) {
+    policy[i] =
+        regrets[i] > 0 ? static_cast<float>(regrets[i] * normalizer) : 0.0f;
+  }
+}
+
+// In-place normalization: values[i] /= sum(values). The caller must ensure
+// the sum is positive.
+inline void Normalize(double* values, int n) {
+  double sum = 0.0;
+  for (int i = 0; i < n; ++i) sum += values[i];
+  const double normalizer = 1.0 / sum;
+  for (int i = 0; i < n; ++i) values[i] *= normalizer;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_KERNELS_H_
@@ -0,0 +1,125 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/vector_kernels.h"
+
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Sizes chosen to exercise both the SIMD body and the scalar tail.
+const std::vector<int> kTestSizes = {1, 2, 3, 4, 5, 7, 8, 13, 16, 19};
+
+std::vector<double> TestValues(int n, double offset) {
+  std::vector<double> values(n);
+  for (int i = 0; i < n; ++i) {
+    // Mix of positive and negative values.
+    values[i] = (i % 3 == 0 ? -1.0 : 1.0) * (i + 1) * 0.25 + offset;
+  }
+  return values;
+}
+
+void TestAccumulateScaled() {
+  for (int n : kTestSizes) {
+    std::vector<double> acc = TestValues(n, 0.5);
+    std::vector<double> expected = acc;
+    std::vector<double> src = TestValues(n, -0.25);
+    const double scale = 1.75;
+
+    AccumulateScaled(acc.data(), src.data(), scale, n);
+    for (int i = 0; i < n; ++i) {
+      expected[i] += scale * src[i];
+      SPIEL_CHECK_FLOAT_EQ(acc[i], expected[i]);
+    }
+  }
+}
+
+void TestAccumulateShiftedScaled() {
+  for (int n : kTestSizes) {
+    std::vector<double> acc = TestValues(n, 1.0);
+    std::vector<double> expected = acc;
+    std::vector<double> values = TestValues(n, 0.125);
+    const double baseline = 0.375;
+    const double scale = -2.5;
+
+    AccumulateShiftedScaled(acc.data(), values.data(), baseline, scale, n);
+    for (int i = 0; i < n; ++i) {
+      expected[i] += scale * (values[i] - baseline);
+      SPIEL_CHECK_FLOAT_EQ(acc[i], expected[i]);
+    }
+  }
+}
+
+void TestSumPositive() {
+  for (int n : kTestSizes) {
+    std::vector<double> values = TestValues(n, 0.0);
+    double expected = 0.0;
+    for (int i = 0; i < n; ++i) {
+      if (values[i] > 0) expected += values[i];
+    }
+    SPIEL_CHECK_FLOAT_EQ(SumPositive(values.data(), n), expected);
+  }
+}
+
+void TestRegretMatchingPolicy() {
+  for (int n : kTestSizes) {
+    std::vector<double> regrets = TestValues(n, 0.0);
+    std::vector<double> policy(n, -1.0);
+    RegretMatchingPolicy(regrets.data(), n, policy.data());
+
+    double sum_positive = 0.0;
+    for (int i = 0; i < n; ++i) {
+      if (regrets[i] > 0) sum_positive += regrets[i];
+    }
+    double policy_sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      if (sum_positive > 0) {
+        SPIEL_CHECK_FLOAT_EQ(
+            policy[i], regrets[i] > 0 ? regrets[i] / sum_positive : 0.0);
+      } else {
+        SPIEL_CHECK_FLOAT_EQ(policy[i], 1.0 / n);
+      }
+      policy_sum += policy[i];
+    }
+    SPIEL_CHECK_FLOAT_EQ(policy_sum, 1.0);
+  }
+}
+
+void TestNormalize() {
+  for (int n : kTestSizes) {
+    std::vector<double> values(n);
+    for (int i = 0; i < n; ++i) values[i] = i + 1;
+    const double sum = n * (n + 1) / 2.0;
+    Normalize(values.data(), n);
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_FLOAT_EQ(values[i], (i + 1) / sum);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TestAccumulateScaled();
+  open_spiel::algorithms::TestAccumulateShiftedScaled();
+  open_spiel::algorithms::TestSumPositive();
+  open_spiel::algorithms::TestRegretMatchingPolicy();
+  open_spiel::algorithms::TestNormalize();
+}
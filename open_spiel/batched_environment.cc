@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/batched_environment.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+BatchedEnvironment::BatchedEnvironment(std::shared_ptr<const Game> game,
+                                       int batch_size, int seed)
+    : game_(std::move(game)), rng_(seed) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_TRUE(game_->GetType().dynamics ==
+                   GameType::Dynamics::kSequential);
+  states_.reserve(batch_size);
+  for (int i = 0; i < batch_size; ++i) {
+    states_.push_back(game_->NewInitialState());
+    ResolveChance(i);
+  }
+}
+
+void BatchedEnvironment::ResolveChance(int i) {
+  while (states_[i]->IsChanceNode()) {
+    ActionsAndProbs outcomes = states_[i]->ChanceOutcomes();
+    double z = std::uniform_real_distribution<double>(0., 1.)(rng_);
+    states_[i]->ApplyAction(SampleChanceOutcome(outcomes, z));
+  }
+}
+
+void BatchedEnvironment::StepAll(const Action* actions) {
+  for (int i = 0; i < states_.size(); ++i) {
+    if (states_[i]->IsTerminal()) continue;
+    states_[i]->ApplyAction(actions[i]);
+    ResolveChance(i);
+  }
+}
+
+void BatchedEnvironment::StepAll(const std::vector<Action>& actions) {
+  SPIEL_CHECK_EQ(actions.size(), states_.size());
+  StepAll(actions.data());
+}
+
+int BatchedEnvironment::ResetTerminals() {
+  int num_reset = 0;
+  for (int i = 0; i < states_.size(); ++i) {
+    if (states_[i]->IsTerminal()) {
+      states_[i] = game_->NewInitialState();
+      ResolveChance(i);
+      ++num_reset;
+    }
+  }
+  return num_reset;
+}
+
+void BatchedEnvironment::ResetAll() {
+  for (int i = 0; i < states_.size(); ++i) {
+    states_[i] = game_->NewInitialState();
+    ResolveChance(i);
+  }
+}
+
+void BatchedEnvironment::AddStepFilter(StepFilter filter) {
+  filters_.push_back(std::move(filter));
+}
+
+void BatchedEnvironment::FillRewards(double* buffer, int stride) const {
+  SPIEL_CHECK_GE(stride, game_->NumPlayers());
+  for (int i = 0; i < states_.size(); ++i) {
+    std::vector<double> rewards = states_[i]->Rewards();
+    for (const StepFilter& filter : filters_) {
+      if (filter.shape_rewards) filter.shape_rewards(*states_[i], &rewards);
+    }
+    SPIEL_CHECK_EQ(rewards.size(), game_->NumPlayers());
+    std::copy(rewards.begin(), rewards.end(),
+              buffer + static_cast<int64_t>(i) * stride);
+  }
+}
+
+void BatchedEnvironment::PostprocessRow(int i, double* buffer, int stride,
+                                        int size) const {
+  double* row = buffer + static_cast<int64_t>(i) * stride;
+  for (const StepFilter& filter : filters_) {
+    if (filter.postprocess_observation) {
+      filter.postprocess_observation(*states_[i], row, size);
+    }
+  }
+}
+
+void BatchedEnvironment::FillObservations(double* buffer, int stride) const {
+  const int size = game_->ObservationNormalizedVectorSize();
+  SPIEL_CHECK_GE(stride, size);
+  for (int i = 0; i < states_.size(); ++i) {
+    if (states_[i]->IsTerminal()) continue;
+    states_[i]->ObservationAsNormalizedVector(
+        states_[i]->CurrentPlayer(), buffer + static_cast<int64_t>(i) * stride);
+    PostprocessRow(i, buffer, stride, size);
+  }
+}
+
+void BatchedEnvironment::FillInformationStates(double* buffer,
+                                               int stride) const {
+  const int size = game_->InformationStateNormalizedVectorSize();
+  SPIEL_CHECK_GE(stride, size);
+  for (int i = 0; i < states_.size(); ++i) {
+    if (states_[i]->IsTerminal()) continue;
+    states_[i]->InformationStateAsNormalizedVector(
+        states_[i]->CurrentPlayer(), buffer + static_cast<int64_t>(i) * stride);
+    PostprocessRow(i, buffer, stride, size);
+  }
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,112 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_BATCHED_ENVIRONMENT_H_
+#define THIRD_PARTY_OPEN_SPIEL_BATCHED_ENVIRONMENT_H_
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+
+// A per-step hook applied inside the batch stepping loop, so reward shaping
+// and observation post-processing run in C++ over the batch instead of
+// wrapping every transition at a language boundary. Either member may be
+// left empty; filters added with AddStepFilter compose in the order added.
+struct StepFilter {
+  // Rewrites one episode's per-step rewards in place (one entry per
+  // player), given the state the step arrived at. Applied by FillRewards.
+  std::function<void(const State&, std::vector<double>*)> shape_rewards;
+
+  // Rewrites one episode's freshly written observation row in place.
+  // Applied by FillObservations and FillInformationStates after the row is
+  // filled; `size` is the row's tensor size.
+  std::function<void(const State&, double* row, int size)>
+      postprocess_observation;
+};
+
+// Drives a fixed-size batch of episodes of one game from a single loop, for
+// RL pipelines that step many environments per network inference. Chance
+// nodes are resolved internally by sampling, so every exposed state is either
+// a decision node or terminal. The stepping loop itself does not allocate;
+// the only allocations are those the game makes inside ApplyAction and the
+// fresh states created when terminal episodes are reset.
+//
+// Only turn-based (sequential) games are supported.
+class BatchedEnvironment {
+ public:
+  BatchedEnvironment(std::shared_ptr<const Game> game, int batch_size,
+                     int seed = 0);
+
+  // Not copyable; the batch owns its episode states.
+  BatchedEnvironment(const BatchedEnvironment&) = delete;
+  BatchedEnvironment& operator=(const BatchedEnvironment&) = delete;
+
+  int BatchSize() const { return states_.size(); }
+  const Game& GetGame() const { return *game_; }
+  const State& GetState(int i) const { return *states_[i]; }
+  bool IsTerminal(int i) const { return states_[i]->IsTerminal(); }
+
+  // Applies actions[i] to episode i. `actions` must hold BatchSize()
+  // entries; entries for terminal episodes are ignored (reset them with
+  // ResetTerminals before or after stepping, as the pipeline prefers).
+  void StepAll(const Action* actions);
+  void StepAll(const std::vector<Action>& actions);
+
+  // Replaces every terminal episode with a fresh initial state; returns the
+  // number of episodes reset.
+  int ResetTerminals();
+
+  // Restarts every episode from the initial state.
+  void ResetAll();
+
+  // Appends a filter to the pipeline; it applies to every subsequent
+  // FillRewards / FillObservations / FillInformationStates call.
+  void AddStepFilter(StepFilter filter);
+
+  // Writes each episode's per-step rewards (one entry per player, shaped by
+  // the filter pipeline) into row i * stride of `buffer`; `stride` must be
+  // at least Game::NumPlayers(). Terminal episodes get their terminal
+  // rewards, so call this before ResetTerminals.
+  void FillRewards(double* buffer, int stride) const;
+
+  // Writes each episode's observation tensor (from its current player's
+  // view) into row i * stride of `buffer`; `stride` must be at least
+  // Game::ObservationNormalizedVectorSize(). Terminal episodes leave their
+  // row untouched. FillInformationStates is the analogue for the
+  // information state tensor.
+  void FillObservations(double* buffer, int stride) const;
+  void FillInformationStates(double* buffer, int stride) const;
+
+ private:
+  // Samples chance outcomes until episode i reaches a decision or terminal
+  // node.
+  void ResolveChance(int i);
+
+  // Applies the observation half of every filter to row i of `buffer`.
+  void PostprocessRow(int i, double* buffer, int stride, int size) const;
+
+  std::shared_ptr<const Game> game_;
+  std::vector<std::unique_ptr<State>> states_;
+  std::vector<StepFilter> filters_;
+  std::mt19937 rng_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_BATCHED_ENVIRONMENT_H_
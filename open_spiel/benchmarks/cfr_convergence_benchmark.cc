@@ -0,0 +1,153 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/resource.h>
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/cfr_br.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/algorithms/outcome_sampling_mccfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Exploitability-vs-wall-clock convergence driver. Emits one CSV row per
+// report point on stdout: iteration, cumulative solver seconds (evaluation
+// time excluded), exploitability, and peak RSS. Diff curves across solver
+// changes instead of hand-timing cfr_example runs.
+
+ABSL_FLAG(std::string, game, "kuhn_poker", "The game to solve.");
+ABSL_FLAG(std::string, solver, "cfr",
+          "One of: cfr, cfrplus, cfrbr, mccfr_outcome, mccfr_external.");
+ABSL_FLAG(int, iterations, 1000, "Total solver iterations.");
+ABSL_FLAG(int, report_every, 100, "Iterations between exploitability reports.");
+ABSL_FLAG(int, seed, 739264, "Seed for the sampling solvers.");
+
+namespace open_spiel {
+namespace {
+
+// Peak resident set size in megabytes. ru_maxrss is kilobytes on Linux and
+// bytes on MacOS.
+double PeakMemoryMB() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+  return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+// Adapts the solvers' slightly different interfaces (EvaluateAndUpdatePolicy
+// vs RunIteration) behind one step/policy pair.
+class SolverAdapter {
+ public:
+  virtual ~SolverAdapter() = default;
+  virtual void Step() = 0;
+  virtual std::unique_ptr<Policy> AveragePolicy() const = 0;
+};
+
+template <typename Solver>
+class CFRStyleAdapter : public SolverAdapter {
+ public:
+  explicit CFRStyleAdapter(const Game& game) : solver_(game) {}
+  void Step() override { solver_.EvaluateAndUpdatePolicy(); }
+  std::unique_ptr<Policy> AveragePolicy() const override {
+    return solver_.AveragePolicy();
+  }
+
+ private:
+  Solver solver_;
+};
+
+template <typename Solver>
+class MCCFRStyleAdapter : public SolverAdapter {
+ public:
+  // The solver's own seed is unused: iteration draws come from rng_, which
+  // is what RunIteration consumes.
+  MCCFRStyleAdapter(const Game& game, int seed) : solver_(game), rng_(seed) {}
+  void Step() override { solver_.RunIteration(&rng_); }
+  std::unique_ptr<Policy> AveragePolicy() const override {
+    return solver_.AveragePolicy();
+  }
+
+ private:
+  Solver solver_;
+  std::mt19937 rng_;
+};
+
+std::unique_ptr<SolverAdapter> MakeSolver(const std::string& name,
+                                          const Game& game, int seed) {
+  if (name == "cfr") {
+    return std::unique_ptr<SolverAdapter>(
+        new CFRStyleAdapter<algorithms::CFRSolver>(game));
+  } else if (name == "cfrplus") {
+    return std::unique_ptr<SolverAdapter>(
+        new CFRStyleAdapter<algorithms::CFRPlusSolver>(game));
+  } else if (name == "cfrbr") {
+    return std::unique_ptr<SolverAdapter>(
+        new CFRStyleAdapter<algorithms::CFRBRSolver>(game));
+  } else if (name == "mccfr_outcome") {
+    return std::unique_ptr<SolverAdapter>(
+        new MCCFRStyleAdapter<algorithms::OutcomeSamplingMCCFRSolver>(game,
+                                                                      seed));
+  } else if (name == "mccfr_external") {
+    return std::unique_ptr<SolverAdapter>(
+        new MCCFRStyleAdapter<algorithms::ExternalSamplingMCCFRSolver>(game,
+                                                                       seed));
+  }
+  SpielFatalError(absl::StrCat("Unknown solver: ", name));
+}
+
+void RunConvergenceBenchmark() {
+  std::shared_ptr<const Game> game = LoadGame(absl::GetFlag(FLAGS_game));
+  std::unique_ptr<SolverAdapter> solver =
+      MakeSolver(absl::GetFlag(FLAGS_solver), *game, absl::GetFlag(FLAGS_seed));
+  const int iterations = absl::GetFlag(FLAGS_iterations);
+  const int report_every = absl::GetFlag(FLAGS_report_every);
+
+  std::cout << "iteration,solver_seconds,exploitability,peak_rss_mb"
+            << std::endl;
+  absl::Duration solver_time;
+  for (int i = 1; i <= iterations; ++i) {
+    const absl::Time start = absl::Now();
+    solver->Step();
+    solver_time += absl::Now() - start;
+    if (i % report_every == 0 || i == iterations) {
+      const double exploitability =
+          algorithms::Exploitability(*game, *solver->AveragePolicy());
+      std::cout << absl::StrFormat("%d,%.4f,%.6g,%.1f\n", i,
+                                   absl::ToDoubleSeconds(solver_time),
+                                   exploitability, PeakMemoryMB());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  open_spiel::RunConvergenceBenchmark();
+}
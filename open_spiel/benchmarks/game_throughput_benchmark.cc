@@ -0,0 +1,170 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// The performance twin of RandomSimTest: timed random playouts over every
+// registered game, reported as one machine-readable CSV row per game on
+// stdout (progress goes to stderr). Intended for release gating — keep a
+// report from the previous release and diff states/sec per game.
+
+ABSL_FLAG(int, time_per_game_ms, 100,
+          "Minimum measured wall time per game and metric, in milliseconds.");
+ABSL_FLAG(std::string, games, "",
+          "Comma-separated subset of games to run; empty means every "
+          "registered game.");
+
+namespace open_spiel {
+namespace {
+
+volatile int64_t sink = 0;
+
+// Returns true if the game cannot be loaded with default parameters only.
+bool HasMandatoryParameters(const GameType& type) {
+  for (const auto& key_and_param : type.parameter_specification) {
+    if (key_and_param.second.is_mandatory()) return true;
+  }
+  return false;
+}
+
+// Plays one random episode, returning the number of states visited
+// (decision, chance and terminal alike, matching what a learning loop walks
+// through per episode).
+int64_t RandomPlayout(const Game& game, SplittableRandom* rng) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  int64_t num_states = 1;
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(rng->NextDouble()).first);
+    } else if (state->IsSimultaneousNode()) {
+      std::vector<Action> joint_action(game.NumPlayers());
+      for (Player player = 0; player < game.NumPlayers(); ++player) {
+        std::vector<Action> actions = state->LegalActions(player);
+        joint_action[player] = actions[rng->NextInt(actions.size())];
+      }
+      state->ApplyActions(joint_action);
+    } else {
+      state->ApplyAction(state->SampleLegalAction(rng->NextDouble()));
+    }
+    ++num_states;
+  }
+  return num_states;
+}
+
+void BenchmarkGame(const GameType& type) {
+  std::cerr << "Timing " << type.short_name << "..." << std::endl;
+  std::shared_ptr<const Game> game = LoadGame(type.short_name);
+  const absl::Duration min_time =
+      absl::Milliseconds(absl::GetFlag(FLAGS_time_per_game_ms));
+  SplittableRandom rng(1234);
+
+  // States per second over full random episodes.
+  RandomPlayout(*game, &rng);  // Warm-up.
+  int64_t num_states = 0;
+  absl::Duration elapsed;
+  while (elapsed < min_time) {
+    const absl::Time start = absl::Now();
+    num_states += RandomPlayout(*game, &rng);
+    elapsed += absl::Now() - start;
+  }
+  const double states_per_sec = num_states / absl::ToDoubleSeconds(elapsed);
+
+  // Clones per second and serialized bytes per state, over a fixed sample of
+  // mid-game positions from one more playout.
+  std::vector<std::unique_ptr<State>> states;
+  std::unique_ptr<State> state = game->NewInitialState();
+  states.push_back(state->Clone());
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(rng.NextDouble()).first);
+    } else if (state->IsSimultaneousNode()) {
+      std::vector<Action> joint_action(game->NumPlayers());
+      for (Player player = 0; player < game->NumPlayers(); ++player) {
+        std::vector<Action> actions = state->LegalActions(player);
+        joint_action[player] = actions[rng.NextInt(actions.size())];
+      }
+      state->ApplyActions(joint_action);
+    } else {
+      state->ApplyAction(state->SampleLegalAction(rng.NextDouble()));
+    }
+    states.push_back(state->Clone());
+  }
+  int64_t num_clones = 0;
+  int64_t next = 0;
+  elapsed = absl::ZeroDuration();
+  while (elapsed < min_time) {
+    const absl::Time start = absl::Now();
+    for (int i = 0; i < 1000; ++i) {
+      sink += states[next]->Clone()->CurrentPlayer();
+      next = (next + 1) % states.size();
+    }
+    elapsed += absl::Now() - start;
+    num_clones += 1000;
+  }
+  const double clones_per_sec = num_clones / absl::ToDoubleSeconds(elapsed);
+
+  // String-serialized size is the closest portable proxy we have for state
+  // footprint; it tracks history length and board size across games.
+  int64_t total_bytes = 0;
+  for (const std::unique_ptr<State>& sampled : states) {
+    total_bytes += sampled->ToString().size();
+  }
+  const double bytes_per_state =
+      static_cast<double>(total_bytes) / states.size();
+
+  std::cout << absl::StrFormat("%s,%.0f,%.0f,%.1f\n", type.short_name,
+                               states_per_sec, clones_per_sec,
+                               bytes_per_state);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string games_flag = absl::GetFlag(FLAGS_games);
+  std::vector<std::string> selected;
+  if (!games_flag.empty()) selected = absl::StrSplit(games_flag, ',');
+
+  std::cout << "game,states_per_sec,clones_per_sec,bytes_per_state"
+            << std::endl;
+  for (const open_spiel::GameType& type :
+       open_spiel::RegisteredGameTypes()) {
+    if (!selected.empty() &&
+        std::find(selected.begin(), selected.end(), type.short_name) ==
+            selected.end()) {
+      continue;
+    }
+    if (open_spiel::HasMandatoryParameters(type)) {
+      std::cerr << "Skipping " << type.short_name
+                << ": has mandatory parameters." << std::endl;
+      continue;
+    }
+    open_spiel::BenchmarkGame(type);
+  }
+}
@@ -0,0 +1,213 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/typed_rollout.h"
+#include "open_spiel/games/tic_tac_toe.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Microbenchmarks for the core hot paths. Run times are best-effort wall
+// clock measurements; for optimization work, run several times on an idle
+// machine and compare the medians.
+
+ABSL_FLAG(int, min_time_ms, 200,
+          "Minimum measured wall time per benchmark, in milliseconds.");
+ABSL_FLAG(std::string, games, "tic_tac_toe,kuhn_poker,leduc_poker,liars_dice",
+          "Comma-separated list of games to run the per-game benchmarks on.");
+ABSL_FLAG(int, mcts_simulations, 100,
+          "Simulations per MCTS search in the MCTS benchmark.");
+
+namespace open_spiel {
+namespace {
+
+// A volatile sink keeps the compiler from discarding benchmark bodies whose
+// results are otherwise unused.
+volatile int64_t sink = 0;
+
+// Times `fn` for at least --min_time_ms (after one untimed warm-up call) and
+// prints a report line. Batch sizes grow geometrically so the timing overhead
+// is negligible for nanosecond-scale bodies.
+template <typename Fn>
+void RunBenchmark(const std::string& name, Fn&& fn) {
+  const absl::Duration min_time =
+      absl::Milliseconds(absl::GetFlag(FLAGS_min_time_ms));
+  fn();  // Warm-up: don't bill one-time costs (lazy caches, allocator growth).
+  int64_t iterations = 0;
+  int64_t batch = 1;
+  absl::Duration elapsed;
+  while (elapsed < min_time) {
+    const absl::Time start = absl::Now();
+    for (int64_t i = 0; i < batch; ++i) fn();
+    elapsed += absl::Now() - start;
+    iterations += batch;
+    batch *= 2;
+  }
+  const double ns_per_op = absl::ToDoubleNanoseconds(elapsed) / iterations;
+  std::cout << absl::StrFormat("%-52s %12d iters %12.1f ns/op %14.0f op/s\n",
+                               name, iterations, ns_per_op, 1e9 / ns_per_op);
+}
+
+// Collects up to `limit` decision states along random playouts, so the
+// per-state benchmarks average over a representative mix of positions
+// rather than hammering the (often cheapest) initial state.
+std::vector<std::unique_ptr<State>> SampleDecisionStates(const Game& game,
+                                                         int limit, int seed) {
+  std::mt19937 rng(seed);
+  std::vector<std::unique_ptr<State>> states;
+  while (states.size() < limit) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal() && states.size() < limit) {
+      if (!state->IsChanceNode()) states.push_back(state->Clone());
+      std::vector<Action> actions = state->LegalActions();
+      std::uniform_int_distribution<int> dist(0, actions.size() - 1);
+      state->ApplyAction(actions[dist(rng)]);
+    }
+  }
+  return states;
+}
+
+void PerGameBenchmarks(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<std::unique_ptr<State>> states =
+      SampleDecisionStates(*game, /*limit=*/64, /*seed=*/1234);
+  int next = 0;
+  auto cycle = [&]() -> const State& {
+    const State& state = *states[next];
+    next = (next + 1) % states.size();
+    return state;
+  };
+
+  RunBenchmark(absl::StrCat("State::Clone/", game_name), [&]() {
+    sink += cycle().Clone()->CurrentPlayer();
+  });
+  RunBenchmark(absl::StrCat("State::LegalActions/", game_name), [&]() {
+    sink += cycle().LegalActions().size();
+  });
+  if (game->GetType().provides_information_state) {
+    RunBenchmark(absl::StrCat("State::InformationState/", game_name), [&]() {
+      sink += cycle().InformationState().size();
+    });
+  }
+}
+
+void RegretMatchingBenchmark(int num_actions) {
+  std::vector<Action> legal_actions(num_actions);
+  for (int aidx = 0; aidx < num_actions; ++aidx) legal_actions[aidx] = aidx;
+  algorithms::CFRInfoStateValues values(legal_actions);
+  // Mixed-sign regrets so both branches of the positive-part sum are hit.
+  for (int aidx = 0; aidx < num_actions; ++aidx) {
+    values.cumulative_regrets[aidx] = (aidx % 2 == 0) ? aidx + 1.0 : -1.0;
+  }
+  RunBenchmark(
+      absl::StrCat("CFRInfoStateValues::ApplyRegretMatching/", num_actions),
+      [&]() {
+        values.ApplyRegretMatching();
+        sink += values.current_policy[0] > 0;
+      });
+}
+
+void TabularPolicyBenchmark(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::vector<std::unique_ptr<State>> states =
+      SampleDecisionStates(*game, /*limit=*/64, /*seed=*/1234);
+  std::vector<std::string> info_states;
+  info_states.reserve(states.size());
+  for (const std::unique_ptr<State>& state : states) {
+    info_states.push_back(state->InformationState());
+  }
+  int next = 0;
+  RunBenchmark(absl::StrCat("TabularPolicy::GetStatePolicy/", game_name),
+               [&]() {
+                 sink += policy.GetStatePolicy(info_states[next]).size();
+                 next = (next + 1) % info_states.size();
+               });
+}
+
+// Virtual-dispatch rollouts vs the statically dispatched engine in
+// typed_rollout.h, to track what devirtualization buys on a known game.
+void RolloutDispatchBenchmark() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> root = game->NewInitialState();
+  SplittableRandom rng(42);
+
+  // Same branch structure as RandomRollout, through State*.
+  RunBenchmark("RandomRollout/virtual/tic_tac_toe", [&]() {
+    std::unique_ptr<State> state = root->Clone();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(state->SampleChanceOutcome(rng.NextDouble()).first);
+      } else if (state->IsSimultaneousNode()) {
+        SpielFatalError("Unexpected simultaneous node.");
+      } else {
+        state->ApplyAction(state->SampleLegalAction(rng.NextDouble()));
+      }
+    }
+    sink += state->Returns()[0];
+  });
+  const auto& typed_root =
+      static_cast<const tic_tac_toe::TicTacToeState&>(*root);
+  RunBenchmark("RandomRollout/typed/tic_tac_toe", [&]() {
+    sink += algorithms::RandomRollout(typed_root, &rng)[0];
+  });
+}
+
+void MCTSBenchmark(const std::string& game_name) {
+  const int max_simulations = absl::GetFlag(FLAGS_mcts_simulations);
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/42);
+  algorithms::MCTSBot bot(*game, /*player=*/0, evaluator, /*uct_c=*/2,
+                          max_simulations, /*max_memory_mb=*/1000,
+                          /*solve=*/false, /*seed=*/42, /*verbose=*/false);
+  std::unique_ptr<State> state = game->NewInitialState();
+  // One op is a full search, so op/s * simulations = simulations per second.
+  RunBenchmark(absl::StrCat("MCTSBot::Step/", game_name, "/",
+                            max_simulations, "sims"),
+               [&]() { sink += bot.Step(*state).second; });
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  std::vector<std::string> game_names =
+      absl::StrSplit(absl::GetFlag(FLAGS_games), ',');
+  for (const std::string& game_name : game_names) {
+    open_spiel::PerGameBenchmarks(game_name);
+  }
+  for (int num_actions : {2, 8, 32}) {
+    open_spiel::RegretMatchingBenchmark(num_actions);
+  }
+  open_spiel::TabularPolicyBenchmark("kuhn_poker");
+  open_spiel::TabularPolicyBenchmark("leduc_poker");
+  open_spiel::RolloutDispatchBenchmark();
+  open_spiel::MCTSBenchmark("tic_tac_toe");
+}
@@ -0,0 +1,275 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Runs the standard workloads — random rollouts, CFR iterations, MCTS
+// searches and exploitability evaluations — for a fixed wall-clock budget
+// each, on a configurable set of games, and emits one JSON report on
+// stdout (progress goes to stderr). One binary to run per machine type and
+// per release; diff the reports to catch regressions. The benchmarks/
+// directory holds the narrower drill-down tools; this is the overview.
+//
+// Workloads that a game cannot support are skipped and reported as null:
+// CFR and exploitability need a turn-based game with information states
+// and explicit chance, MCTS additionally at most two players. The event
+// counters in each section are all zero unless the binary was built with
+// -DOPEN_SPIEL_ENABLE_STATS.
+
+ABSL_FLAG(std::string, games, "kuhn_poker,leduc_poker,tic_tac_toe",
+          "Comma-separated list of games to report on.");
+ABSL_FLAG(int, time_per_benchmark_ms, 200,
+          "Wall-clock budget per game and workload, in milliseconds. Each "
+          "workload always runs at least one operation, so a CFR iteration "
+          "on a large game may overshoot.");
+ABSL_FLAG(int, mcts_simulations, 100, "Simulations per MCTS search.");
+ABSL_FLAG(int, seed, 1234, "Seed for the sampled workloads.");
+
+namespace open_spiel {
+namespace {
+
+volatile int64_t sink = 0;
+
+struct BudgetResult {
+  int64_t ops = 0;
+  double seconds = 0;
+};
+
+// Runs `fn` repeatedly until the budget is spent; always at least once.
+template <typename Fn>
+BudgetResult RunForBudget(Fn&& fn) {
+  const absl::Duration budget =
+      absl::Milliseconds(absl::GetFlag(FLAGS_time_per_benchmark_ms));
+  BudgetResult result;
+  absl::Duration elapsed;
+  do {
+    const absl::Time start = absl::Now();
+    fn();
+    elapsed += absl::Now() - start;
+    ++result.ops;
+  } while (elapsed < budget);
+  result.seconds = absl::ToDoubleSeconds(elapsed);
+  return result;
+}
+
+// The change in each event counter across `before` and a fresh snapshot,
+// as a JSON object keyed by counter name.
+std::string CountersJson(const std::vector<int64_t>& before) {
+  const std::vector<int64_t> after = stats::SnapshotCounters();
+  std::string json = "{";
+  for (int i = 0; i < stats::kNumCounters; ++i) {
+    absl::StrAppendFormat(
+        &json, "%s\"%s\": %d", i == 0 ? "" : ", ",
+        stats::CounterName(static_cast<stats::Counter>(i)),
+        after[i] - before[i]);
+  }
+  return json + "}";
+}
+
+// One workload's JSON object: ops, ops/sec, the counter deltas, and any
+// workload-specific fields passed in `extra` (each prefixed with ", ").
+std::string SectionJson(const BudgetResult& result,
+                        const std::vector<int64_t>& counters_before,
+                        const std::string& extra = "") {
+  return absl::StrFormat(
+      "{\"ops\": %d, \"ops_per_sec\": %.2f%s, \"counters\": %s}", result.ops,
+      result.ops / result.seconds, extra, CountersJson(counters_before));
+}
+
+int64_t RandomPlayout(const Game& game, SplittableRandom* rng) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  int64_t num_states = 1;
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(rng->NextDouble()).first);
+    } else if (state->IsSimultaneousNode()) {
+      std::vector<Action> joint_action(game.NumPlayers());
+      for (Player player = 0; player < game.NumPlayers(); ++player) {
+        std::vector<Action> actions = state->LegalActions(player);
+        joint_action[player] = actions[rng->NextInt(actions.size())];
+      }
+      state->ApplyActions(joint_action);
+    } else {
+      state->ApplyAction(state->SampleLegalAction(rng->NextDouble()));
+    }
+    ++num_states;
+  }
+  return num_states;
+}
+
+std::string RolloutSection(const Game& game) {
+  SplittableRandom rng(absl::GetFlag(FLAGS_seed));
+  RandomPlayout(game, &rng);  // Warm-up.
+  stats::ResetCounters();
+  const std::vector<int64_t> before = stats::SnapshotCounters();
+  int64_t num_states = 0;
+  const BudgetResult result =
+      RunForBudget([&]() { num_states += RandomPlayout(game, &rng); });
+  return SectionJson(
+      result, before,
+      absl::StrFormat(", \"states_per_sec\": %.0f",
+                      num_states / result.seconds));
+}
+
+bool SupportsTabularSolvers(const GameType& type) {
+  return type.dynamics == GameType::Dynamics::kSequential &&
+         type.chance_mode != GameType::ChanceMode::kSampledStochastic &&
+         type.provides_information_state;
+}
+
+// Runs budgeted CFR iterations; on success also hands the solver back so
+// the exploitability section can evaluate its average policy — the policy
+// someone would actually measure during training. (The average policy
+// reads the solver's table, so the solver has to outlive it.)
+std::string CfrSection(const Game& game,
+                       std::unique_ptr<algorithms::CFRSolver>* solver_out) {
+  if (!SupportsTabularSolvers(game.GetType())) return "null";
+  auto solver = std::make_unique<algorithms::CFRSolver>(game);
+  solver->EvaluateAndUpdatePolicy();  // Warm-up builds most of the table.
+  stats::ResetCounters();
+  const std::vector<int64_t> before = stats::SnapshotCounters();
+  const BudgetResult result =
+      RunForBudget([&]() { solver->EvaluateAndUpdatePolicy(); });
+  const std::string json =
+      SectionJson(result, before,
+                  absl::StrFormat(", \"table_bytes\": %d",
+                                  solver->TableMemoryBytes()));
+  *solver_out = std::move(solver);
+  return json;
+}
+
+std::string MctsSection(const Game& game) {
+  const GameType& type = game.GetType();
+  if (type.dynamics != GameType::Dynamics::kSequential ||
+      game.NumPlayers() > 2) {
+    return "null";
+  }
+  const int simulations = absl::GetFlag(FLAGS_mcts_simulations);
+  const int seed = absl::GetFlag(FLAGS_seed);
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, seed);
+  algorithms::MCTSBot bot(game, /*player=*/0, evaluator, /*uct_c=*/2,
+                          simulations, /*max_memory_mb=*/1000,
+                          /*solve=*/false, seed, /*verbose=*/false);
+  // Search from the first decision node; the bot does not step on chance.
+  std::unique_ptr<State> state = game.NewInitialState();
+  SplittableRandom rng(seed);
+  while (state->IsChanceNode()) {
+    state->ApplyAction(state->SampleChanceOutcome(rng.NextDouble()).first);
+  }
+  sink += bot.Step(*state).second;  // Warm-up.
+  stats::ResetCounters();
+  const std::vector<int64_t> before = stats::SnapshotCounters();
+  const BudgetResult result =
+      RunForBudget([&]() { sink += bot.Step(*state).second; });
+  return SectionJson(
+      result, before,
+      absl::StrFormat(", \"simulations_per_sec\": %.0f, \"tree_bytes\": %d",
+                      result.ops * simulations / result.seconds,
+                      bot.TreeMemoryBytes()));
+}
+
+// Evaluates the CFR section's average policy when that section ran, so
+// nash_conv here doubles as a convergence sanity check for the report.
+std::string ExploitabilitySection(const Game& game,
+                                  const algorithms::CFRSolver* solver) {
+  const GameType& type = game.GetType();
+  if (solver == nullptr || game.NumPlayers() != 2 ||
+      type.utility != GameType::Utility::kZeroSum) {
+    return "null";
+  }
+  const std::unique_ptr<Policy> policy = solver->AveragePolicy();
+  double nash_conv = 0;
+  const auto evaluate = [&]() {
+    nash_conv = algorithms::Exploitability(game, *policy);
+  };
+  evaluate();  // Warm-up.
+  stats::ResetCounters();
+  const std::vector<int64_t> before = stats::SnapshotCounters();
+  const BudgetResult result = RunForBudget(evaluate);
+  return SectionJson(result, before,
+                     absl::StrFormat(", \"nash_conv\": %.6g", nash_conv));
+}
+
+std::string GameReport(const std::string& game_name) {
+  std::cerr << "Benchmarking " << game_name << "..." << std::endl;
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::string json = absl::StrFormat("    {\n      \"name\": \"%s\",\n",
+                                     game_name);
+  absl::StrAppend(&json, "      \"rollout\": ", RolloutSection(*game), ",\n");
+  std::unique_ptr<algorithms::CFRSolver> cfr_solver;
+  absl::StrAppend(&json, "      \"cfr\": ", CfrSection(*game, &cfr_solver),
+                  ",\n");
+  absl::StrAppend(&json, "      \"mcts\": ", MctsSection(*game), ",\n");
+  absl::StrAppend(&json, "      \"exploitability\": ",
+                  ExploitabilitySection(*game, cfr_solver.get()), "\n    }");
+  return json;
+}
+
+void EmitReport() {
+  std::vector<std::string> game_names =
+      absl::StrSplit(absl::GetFlag(FLAGS_games), ',');
+  std::string json = "{\n";
+  absl::StrAppendFormat(&json, "  \"timestamp_unix_s\": %d,\n",
+                        absl::ToUnixSeconds(absl::Now()));
+  absl::StrAppendFormat(&json, "  \"time_per_benchmark_ms\": %d,\n",
+                        absl::GetFlag(FLAGS_time_per_benchmark_ms));
+#ifdef OPEN_SPIEL_ENABLE_STATS
+  absl::StrAppend(&json, "  \"counters_enabled\": true,\n");
+#else
+  absl::StrAppend(&json, "  \"counters_enabled\": false,\n");
+#endif
+  absl::StrAppend(&json, "  \"games\": [\n");
+  for (int i = 0; i < game_names.size(); ++i) {
+    absl::StrAppend(&json, GameReport(game_names[i]),
+                    i + 1 < game_names.size() ? ",\n" : "\n");
+  }
+  absl::StrAppend(&json, "  ],\n");
+  // The gauges are process-wide, published by whichever workloads ran last;
+  // cfr_table_bytes and mcts_tree_bytes reflect the final game in the list.
+  const std::vector<int64_t> gauges = stats::SnapshotGauges();
+  absl::StrAppend(&json, "  \"gauges\": {");
+  for (int i = 0; i < stats::kNumGauges; ++i) {
+    absl::StrAppendFormat(&json, "%s\"%s\": %d", i == 0 ? "" : ", ",
+                          stats::GaugeName(static_cast<stats::Gauge>(i)),
+                          gauges[i]);
+  }
+  absl::StrAppend(&json, "}\n}\n");
+  std::cout << json;
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  open_spiel::EmitReport();
+}
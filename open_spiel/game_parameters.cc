@@ -15,8 +15,31 @@
 #include "open_spiel/game_parameters.h"
 
 #include <iostream>
+#include <mutex>
 
 namespace open_spiel {
+namespace {
+
+GameParameters ParseGameParameters(const std::string& game_string);
+
+// Batch jobs load thousands of game variants from a handful of distinct
+// strings, and wrapped games (e.g. turn_based_simultaneous_game) parse their
+// nested sub-game strings through the same entry point, so the parse is
+// memoized on the raw string. Bounded so adversarial or generated inputs
+// can't grow it without limit; misses past the bound just parse.
+constexpr int kMaxParseCacheEntries = 10000;
+
+std::mutex* ParseCacheMutex() {
+  static std::mutex* mutex = new std::mutex;
+  return mutex;
+}
+
+std::map<std::string, GameParameters>* ParseCache() {
+  static auto* cache = new std::map<std::string, GameParameters>;
+  return cache;
+}
+
+}  // namespace
 
 std::string GameParameter::ToReprString() const {
   switch (type_) {
@@ -94,6 +117,24 @@ GameParameter GameParameterFromString(const std::string& str) {
 }
 
 GameParameters GameParametersFromString(const std::string& game_string) {
+  {
+    std::lock_guard<std::mutex> lock(*ParseCacheMutex());
+    auto iter = ParseCache()->find(game_string);
+    if (iter != ParseCache()->end()) return iter->second;
+  }
+  GameParameters params = ParseGameParameters(game_string);
+  {
+    std::lock_guard<std::mutex> lock(*ParseCacheMutex());
+    if (ParseCache()->size() < kMaxParseCacheEntries) {
+      ParseCache()->emplace(game_string, params);
+    }
+  }
+  return params;
+}
+
+namespace {
+
+GameParameters ParseGameParameters(const std::string& game_string) {
   GameParameters params;
   int first_paren = game_string.find('(');
   if (first_paren == std::string::npos) {
@@ -124,4 +165,6 @@ GameParameters GameParametersFromString(const std::string& game_string) {
   return params;
 }
 
+}  // namespace
+
 }  // namespace open_spiel
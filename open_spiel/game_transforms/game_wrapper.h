@@ -96,6 +96,93 @@ class WrappedState : public State {
   std::unique_ptr<State> state_;
 };
 
+// Compile-time variant of WrappedState for transforms over a game known at
+// build time. The wrapped state is held by value rather than behind a
+// unique_ptr, so its dynamic type is known exactly where these inline
+// forwards are compiled: the delegated calls devirtualize instead of paying
+// a second level of virtual dispatch, and copying needs no heap allocation
+// for the inner state. Forwarding goes through a State reference (not the
+// concrete type) so games that override only some overloads of a name do
+// not hide the rest. Transforms offer this alongside their dynamic form by
+// deriving with the concrete state type (see misere.h).
+template <typename BaseState>
+class TypedWrappedState : public State {
+ public:
+  TypedWrappedState(std::shared_ptr<const Game> game, BaseState state)
+      : State(game), state_(std::move(state)) {}
+  TypedWrappedState(const TypedWrappedState& other) = default;
+
+  Player CurrentPlayer() const override { return Base().CurrentPlayer(); }
+
+  virtual std::vector<Action> LegalActions(Player player) const {
+    return Base().LegalActions(player);
+  }
+
+  std::vector<Action> LegalActions() const override {
+    return Base().LegalActions();
+  }
+
+  std::string ActionToString(Player player, Action action_id) const override {
+    return Base().ActionToString(player, action_id);
+  }
+
+  std::string ToString() const override { return Base().ToString(); }
+
+  bool IsTerminal() const override { return Base().IsTerminal(); }
+
+  std::vector<double> Rewards() const override { return Base().Rewards(); }
+
+  std::vector<double> Returns() const override { return Base().Returns(); }
+
+  std::string InformationState(Player player) const override {
+    return Base().InformationState(player);
+  }
+
+  void InformationStateAsNormalizedVector(
+      Player player, std::vector<double>* values) const override {
+    Base().InformationStateAsNormalizedVector(player, values);
+  }
+
+  virtual std::string Observation(Player player) const {
+    return Base().Observation(player);
+  }
+
+  virtual void ObservationAsNormalizedVector(
+      Player player, std::vector<double>* values) const {
+    Base().ObservationAsNormalizedVector(player, values);
+  }
+
+  virtual std::unique_ptr<State> Clone() const = 0;
+
+  virtual void UndoAction(Player player, Action action) {
+    Base().UndoAction(player, action);
+    history_.pop_back();
+  }
+
+  ActionsAndProbs ChanceOutcomes() const override {
+    return Base().ChanceOutcomes();
+  }
+
+  std::vector<Action> LegalChanceOutcomes() const override {
+    return Base().LegalChanceOutcomes();
+  }
+
+ protected:
+  void DoApplyAction(Action action_id) override {
+    Base().ApplyAction(action_id);
+  }
+
+  void DoApplyActions(const std::vector<Action>& actions) override {
+    Base().ApplyActions(actions);
+  }
+
+  State& Base() { return state_; }
+  const State& Base() const { return state_; }
+
+  // Held by value: the concrete type is known where the forwards inline.
+  BaseState state_;
+};
+
 class WrappedGame : public Game {
  public:
   WrappedGame(std::shared_ptr<const Game> game, GameType game_type,
@@ -18,25 +18,28 @@ namespace open_spiel {
 namespace {
 
 // These parameters are the most-general case. The actual game may be simpler.
-const GameType kGameType{
-    /*short_name=*/"misere",
-    /*long_name=*/"Misere Version of a Regular Game",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kSampledStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kRewards,
-    /*max_num_players=*/100,
-    /*min_num_players=*/1,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    {{"game",
-      GameParameter(GameParameter::Type::kGame, /*is_mandatory=*/true)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"misere",
+      /*long_name=*/"Misere Version of a Regular Game",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kSampledStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kRewards,
+      /*max_num_players=*/100,
+      /*min_num_players=*/1,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      {{"game",
+        GameParameter(GameParameter::Type::kGame, /*is_mandatory=*/true)}}};
+  return kGameType;
+}
 
 GameType MisereGameType(GameType game_type) {
-  game_type.short_name = kGameType.short_name;
+  game_type.short_name = GetGameType().short_name;
   game_type.long_name = absl::StrCat("Misere ", game_type.long_name);
   return game_type;
 }
@@ -47,7 +50,7 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new MisereGame(game, game_type, params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("misere", GetGameType, Factory);
 
 }  // namespace
 
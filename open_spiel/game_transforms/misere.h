@@ -71,6 +71,52 @@ class MisereGame : public WrappedGame {
   double UtilitySum() const override { return -game_->UtilitySum(); }
 };
 
+// Compile-time form of the transform for games known at build time, e.g.
+// TypedMisereGame<tic_tac_toe::TicTacToeState>. Behaves exactly like the
+// dynamic version but composes over TypedWrappedState, so delegated calls
+// skip the second virtual hop. The dynamic classes above remain the form the
+// game registry uses.
+template <typename BaseState>
+class TypedMisereState : public TypedWrappedState<BaseState> {
+ public:
+  TypedMisereState(std::shared_ptr<const Game> game, BaseState state)
+      : TypedWrappedState<BaseState>(game, std::move(state)) {}
+  TypedMisereState(const TypedMisereState& other) = default;
+
+  std::vector<double> Rewards() const override {
+    return Negative(this->Base().Rewards());
+  }
+
+  std::vector<double> Returns() const override {
+    return Negative(this->Base().Returns());
+  }
+
+  std::unique_ptr<State> Clone() const override {
+    return std::unique_ptr<State>(new TypedMisereState(*this));
+  }
+};
+
+template <typename BaseState>
+class TypedMisereGame : public MisereGame {
+ public:
+  TypedMisereGame(std::shared_ptr<const Game> game, GameType game_type,
+                  GameParameters game_parameters)
+      : MisereGame(game, game_type, game_parameters) {}
+  TypedMisereGame(const TypedMisereGame& other) = default;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    // The underlying game creates states on the heap; the value copy here is
+    // once per episode and buys direct dispatch for the rest of it.
+    std::unique_ptr<State> state = game_->NewInitialState();
+    return std::unique_ptr<State>(new TypedMisereState<BaseState>(
+        shared_from_this(), static_cast<const BaseState&>(*state)));
+  }
+
+  std::shared_ptr<const Game> Clone() const override {
+    return std::shared_ptr<const Game>(new TypedMisereGame(*this));
+  }
+};
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_MISERE_H_
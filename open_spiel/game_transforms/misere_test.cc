@@ -14,6 +14,10 @@
 
 #include "open_spiel/game_transforms/misere.h"
 
+#include <memory>
+#include <random>
+
+#include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -29,8 +33,44 @@ void BasicMisereTests() {
   testing::RandomSimTest(*LoadGame("misere(game=leduc_poker())"), 100);
 }
 
+// The typed (compile-time) form of the transform must be observationally
+// identical to the dynamic one loaded through the registry.
+void TypedMisereMatchesDynamicTest() {
+  std::shared_ptr<const Game> dynamic_game =
+      LoadGame("misere(game=tic_tac_toe())");
+  auto typed_game =
+      std::make_shared<TypedMisereGame<tic_tac_toe::TicTacToeState>>(
+          LoadGame("tic_tac_toe"), dynamic_game->GetType(),
+          dynamic_game->GetParameters());
+
+  std::mt19937 rng(2875);
+  for (int episode = 0; episode < 20; ++episode) {
+    std::unique_ptr<State> dynamic_state = dynamic_game->NewInitialState();
+    std::unique_ptr<State> typed_state = typed_game->NewInitialState();
+    while (!dynamic_state->IsTerminal()) {
+      SPIEL_CHECK_FALSE(typed_state->IsTerminal());
+      SPIEL_CHECK_EQ(dynamic_state->ToString(), typed_state->ToString());
+      std::vector<Action> actions = dynamic_state->LegalActions();
+      SPIEL_CHECK_TRUE(actions == typed_state->LegalActions());
+      std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+      Action action = actions[dis(rng)];
+      dynamic_state->ApplyAction(action);
+      typed_state->ApplyAction(action);
+    }
+    SPIEL_CHECK_TRUE(typed_state->IsTerminal());
+    std::vector<double> dynamic_returns = dynamic_state->Returns();
+    std::vector<double> typed_returns = typed_state->Returns();
+    for (auto p = Player{0}; p < dynamic_game->NumPlayers(); ++p) {
+      SPIEL_CHECK_EQ(dynamic_returns[p], typed_returns[p]);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace misere
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::misere::BasicMisereTests(); }
+int main(int argc, char** argv) {
+  open_spiel::misere::BasicMisereTests();
+  open_spiel::misere::TypedMisereMatchesDynamicTest();
+}
@@ -17,8 +17,10 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/spiel.h"
 
 // This wrapper turns any n-player simultaneous move game into an equivalent
@@ -33,35 +35,224 @@
 
 namespace open_spiel {
 
-class TurnBasedSimultaneousState : public State {
+namespace turn_based_internal {
+
+// How the wrapper holds the underlying simultaneous state. The dynamic
+// variant owns it behind a unique_ptr; the typed variant holds the concrete
+// type by value, so the dynamic type is known where the wrapper's inline
+// methods compile and the delegated calls devirtualize.
+inline State& Deref(std::unique_ptr<State>& holder) { return *holder; }
+inline const State& Deref(const std::unique_ptr<State>& holder) {
+  return *holder;
+}
+template <typename T>
+State& Deref(T& holder) {
+  return holder;
+}
+template <typename T>
+const State& Deref(const T& holder) {
+  return holder;
+}
+
+inline std::unique_ptr<State> CloneHolder(
+    const std::unique_ptr<State>& holder) {
+  return holder->Clone();
+}
+template <typename T>
+T CloneHolder(const T& holder) {
+  return holder;
+}
+
+}  // namespace turn_based_internal
+
+// The rolling-turn logic, shared between the dynamic wrapper (StateHolder =
+// std::unique_ptr<State>) and the typed one (StateHolder = the concrete
+// simultaneous state type). Use the aliases below rather than this class
+// directly.
+template <typename StateHolder>
+class TurnBasedSimultaneousStateImpl : public State {
  public:
-  TurnBasedSimultaneousState(std::shared_ptr<const Game> game,
-                             std::unique_ptr<State> state);
-  TurnBasedSimultaneousState(const TurnBasedSimultaneousState& other);
-
-  Player CurrentPlayer() const override;
-  std::string ActionToString(Player player, Action action_id) const override;
-  std::string ToString() const override;
-  bool IsTerminal() const override;
-  std::vector<double> Returns() const override;
-  std::string InformationState(Player player) const override;
+  TurnBasedSimultaneousStateImpl(std::shared_ptr<const Game> game,
+                                 StateHolder state)
+      : State(game), state_(std::move(state)), rollout_mode_(false) {
+    DetermineWhoseTurn();
+    action_vector_.resize(game->NumPlayers());
+  }
+
+  TurnBasedSimultaneousStateImpl(const TurnBasedSimultaneousStateImpl& other)
+      : State(other),
+        state_(turn_based_internal::CloneHolder(other.state_)),
+        action_vector_(other.action_vector_),
+        current_player_(other.current_player_),
+        rollout_mode_(other.rollout_mode_),
+        turn_legal_actions_(other.turn_legal_actions_),
+        turn_legal_actions_valid_(other.turn_legal_actions_valid_) {}
+
+  Player CurrentPlayer() const override { return current_player_; }
+
+  std::string ActionToString(Player player, Action action_id) const override {
+    return Sim().ActionToString(player, action_id);
+  }
+
+  std::string ToString() const override {
+    std::string partial_action = "";
+    if (rollout_mode_) {
+      partial_action = "Partial joint action: ";
+      for (auto p = Player{0}; p < current_player_; ++p) {
+        absl::StrAppend(&partial_action, action_vector_[p]);
+        partial_action.push_back(' ');
+      }
+      partial_action.push_back('\n');
+    }
+    return partial_action + Sim().ToString();
+  }
+
+  bool IsTerminal() const override { return Sim().IsTerminal(); }
+
+  std::vector<double> Returns() const override { return Sim().Returns(); }
+
+  std::string InformationState(Player player) const override {
+    SPIEL_CHECK_GE(player, 0);
+    SPIEL_CHECK_LT(player, num_players_);
+
+    std::string extra_info = "";
+    extra_info = "Current player: ";
+    absl::StrAppend(&extra_info, current_player_);
+    extra_info.push_back('\n');
+    if (rollout_mode_) {
+      // Include the player's action if they have take one already.
+      if (player < current_player_) {
+        absl::StrAppend(&extra_info, "Observer's action this turn: ");
+        absl::StrAppend(&extra_info, action_vector_[player]);
+        extra_info.push_back('\n');
+      }
+    }
+    return extra_info + Sim().InformationState(player);
+  }
+
   void InformationStateAsNormalizedVector(
-      Player player, std::vector<double>* values) const override;
-  std::unique_ptr<State> Clone() const override;
-  std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+      Player player, std::vector<double>* values) const override {
+    SPIEL_CHECK_GE(player, 0);
+    SPIEL_CHECK_LT(player, num_players_);
+
+    values->clear();
+
+    // First, get the 2 * num_players bits to encode whose turn it is and who
+    // the observer is.
+    for (auto p = Player{0}; p < num_players_; ++p) {
+      values->push_back(p == current_player_ ? 1 : 0);
+    }
+    for (auto p = Player{0}; p < num_players_; ++p) {
+      values->push_back(p == player ? 1 : 0);
+    }
+
+    // Then get the underlying info set at
+    std::vector<double> infoset;
+    Sim().InformationStateAsNormalizedVector(player, &infoset);
+
+    int offset = values->size();
+    values->resize(values->size() + infoset.size());
+
+    // Now copy it over.
+    for (int i = 0; i < infoset.size(); i++) {
+      (*values)[offset + i] = infoset[i];
+    }
+  }
+
+  std::unique_ptr<State> Clone() const override {
+    return std::unique_ptr<State>(new TurnBasedSimultaneousStateImpl(*this));
+  }
+
+  std::vector<std::pair<Action, double>> ChanceOutcomes() const override {
+    return Sim().ChanceOutcomes();
+  }
 
   // Access to the wrapped state, used for debugging and in the tests.
-  const State* SimultaneousGameState() const { return state_.get(); }
-  std::vector<Action> LegalActions() const override;
+  const State* SimultaneousGameState() const { return &Sim(); }
+
+  std::vector<Action> LegalActions() const override {
+    if (rollout_mode_) {
+      // While a joint turn rolls out, the underlying state does not change;
+      // serve every pseudo-player's query from the per-turn cache.
+      return TurnLegalActions()[current_player_];
+    }
+    return Sim().LegalActions(CurrentPlayer());
+  }
 
  protected:
-  void DoApplyAction(Action action_id) override;
+  void DoApplyAction(Action action_id) override {
+    if (Sim().IsChanceNode()) {
+      SPIEL_CHECK_FALSE(rollout_mode_);
+      Sim().ApplyAction(action_id);
+      DetermineWhoseTurn();
+    } else {
+      if (rollout_mode_) {
+        // If we are currently rolling out a simultaneous move node, then
+        // simply buffer the action in the action vector.
+        action_vector_[current_player_] = action_id;
+        RolloutModeIncrementCurrentPlayer();
+        // Check if we then need to apply it.
+        if (current_player_ == num_players_) {
+          Sim().ApplyActions(action_vector_);
+          DetermineWhoseTurn();
+        }
+      } else {
+        SPIEL_CHECK_NE(Sim().CurrentPlayer(), kSimultaneousPlayerId);
+        Sim().ApplyAction(action_id);
+        DetermineWhoseTurn();
+      }
+    }
+  }
 
  private:
-  void DetermineWhoseTurn();
-  void RolloutModeIncrementCurrentPlayer();
+  void DetermineWhoseTurn() {
+    // Reached only when the underlying state advanced (or at construction),
+    // so any cached per-turn legal actions are stale.
+    turn_legal_actions_valid_ = false;
+    if (Sim().CurrentPlayer() == kSimultaneousPlayerId) {
+      // When the underlying game's node is at a simultaneous move node, they
+      // get rolled out as turn-based, starting with player 0.
+      current_player_ = Player{0};
+      rollout_mode_ = true;
+    } else {
+      // Otherwise, just execute it normally.
+      current_player_ = Sim().CurrentPlayer();
+      rollout_mode_ = false;
+    }
+  }
+
+  void RolloutModeIncrementCurrentPlayer() {
+    current_player_++;
 
-  std::unique_ptr<State> state_;
+    // Make sure to skip over the players that do not have legal actions.
+    while (current_player_ < num_players_ &&
+           TurnLegalActions()[current_player_].empty()) {
+      // Unnecessary to set an action here, but leads to a nicer ToString.
+      action_vector_[current_player_] = 0;
+      current_player_++;
+    }
+  }
+
+  State& Sim() { return turn_based_internal::Deref(state_); }
+  const State& Sim() const { return turn_based_internal::Deref(state_); }
+
+  // Legal actions of every player at the current joint turn, computed from
+  // the underlying state at most once per turn (it is queried once per
+  // pseudo-player while the turn rolls out, plus once per player skipped for
+  // having no actions). Same lazy mutable-cache pattern as
+  // State::CachedLegalActions.
+  const std::vector<std::vector<Action>>& TurnLegalActions() const {
+    if (!turn_legal_actions_valid_) {
+      turn_legal_actions_.resize(num_players_);
+      for (auto p = Player{0}; p < num_players_; ++p) {
+        turn_legal_actions_[p] = Sim().LegalActions(p);
+      }
+      turn_legal_actions_valid_ = true;
+    }
+    return turn_legal_actions_;
+  }
+
+  StateHolder state_;
 
   // A vector of actions that is used primarily to store the intermediate
   // actions taken by the players when extending the simultaneous move nodes
@@ -73,8 +264,23 @@ class TurnBasedSimultaneousState : public State {
 
   // Are we currently rolling out a simultaneous move node?
   bool rollout_mode_;
+
+  // Per-joint-turn legal actions cache; see TurnLegalActions().
+  mutable std::vector<std::vector<Action>> turn_legal_actions_;
+  mutable bool turn_legal_actions_valid_ = false;
 };
 
+// The dynamic wrapper, used by the game registry: works over any
+// simultaneous game loaded at runtime.
+using TurnBasedSimultaneousState =
+    TurnBasedSimultaneousStateImpl<std::unique_ptr<State>>;
+
+// Compile-time form over a known simultaneous state type, e.g.
+// TypedTurnBasedSimultaneousState<goofspiel::GoofspielState>: the delegated
+// calls dispatch directly instead of through the State vtable.
+template <typename BaseState>
+using TypedTurnBasedSimultaneousState = TurnBasedSimultaneousStateImpl<BaseState>;
+
 class TurnBasedSimultaneousGame : public Game {
  public:
   explicit TurnBasedSimultaneousGame(std::shared_ptr<const Game> game);
@@ -104,10 +310,32 @@ class TurnBasedSimultaneousGame : public Game {
     return std::shared_ptr<const Game>(new TurnBasedSimultaneousGame(*this));
   }
 
- private:
+ protected:
   std::shared_ptr<const Game> game_;
 };
 
+// Companion game for the typed state above; the wrapped simultaneous game
+// must create states of type BaseState.
+template <typename BaseState>
+class TypedTurnBasedSimultaneousGame : public TurnBasedSimultaneousGame {
+ public:
+  using TurnBasedSimultaneousGame::TurnBasedSimultaneousGame;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    // The underlying game creates states on the heap; the value copy here is
+    // once per episode and buys direct dispatch for the rest of it.
+    std::unique_ptr<State> state = game_->NewInitialState();
+    return std::unique_ptr<State>(
+        new TypedTurnBasedSimultaneousState<BaseState>(
+            shared_from_this(), static_cast<const BaseState&>(*state)));
+  }
+
+  std::shared_ptr<const Game> Clone() const override {
+    return std::shared_ptr<const Game>(
+        new TypedTurnBasedSimultaneousGame(*this));
+  }
+};
+
 // Equivalent loader functions that return back the transformed game.
 // Important: takes ownership of the game that is passed in.
 std::shared_ptr<const Game> ConvertToTurnBased(const Game& game);
@@ -14,10 +14,12 @@
 
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 
+#include <memory>
 #include <random>
 #include <string>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
+#include "open_spiel/games/blotto.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -121,9 +123,48 @@ void BasicTurnBasedSimultaneousTests() {
   }
 }
 
+// The typed (compile-time) wrapper shares its rolling-turn logic with the
+// dynamic one; check the two are observationally identical on a known game.
+void TypedTurnBasedMatchesDynamicTest() {
+  std::shared_ptr<const Game> dynamic_game =
+      ConvertToTurnBased(*LoadGame("blotto"));
+  auto typed_game =
+      std::make_shared<TypedTurnBasedSimultaneousGame<blotto::BlottoState>>(
+          LoadGame("blotto"));
+
+  std::mt19937 rng(618);
+  for (int episode = 0; episode < 20; ++episode) {
+    std::unique_ptr<State> dynamic_state = dynamic_game->NewInitialState();
+    std::unique_ptr<State> typed_state = typed_game->NewInitialState();
+    while (!dynamic_state->IsTerminal()) {
+      SPIEL_CHECK_FALSE(typed_state->IsTerminal());
+      SPIEL_CHECK_EQ(dynamic_state->ToString(), typed_state->ToString());
+      SPIEL_CHECK_EQ(dynamic_state->CurrentPlayer(),
+                     typed_state->CurrentPlayer());
+      for (auto p = Player{0}; p < dynamic_game->NumPlayers(); ++p) {
+        SPIEL_CHECK_EQ(dynamic_state->InformationState(p),
+                       typed_state->InformationState(p));
+      }
+      std::vector<Action> actions = dynamic_state->LegalActions();
+      SPIEL_CHECK_TRUE(actions == typed_state->LegalActions());
+      absl::uniform_int_distribution<> dis(0, actions.size() - 1);
+      Action action = actions[dis(rng)];
+      dynamic_state->ApplyAction(action);
+      typed_state->ApplyAction(action);
+    }
+    SPIEL_CHECK_TRUE(typed_state->IsTerminal());
+    std::vector<double> dynamic_returns = dynamic_state->Returns();
+    std::vector<double> typed_returns = typed_state->Returns();
+    for (auto p = Player{0}; p < dynamic_game->NumPlayers(); ++p) {
+      SPIEL_CHECK_EQ(dynamic_returns[p], typed_returns[p]);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::BasicTurnBasedSimultaneousTests();
+  open_spiel::TypedTurnBasedMatchesDynamicTest();
 }
@@ -15,8 +15,8 @@
 #include "open_spiel/games/backgammon.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -65,29 +65,32 @@ const std::vector<std::vector<int>> kChanceOutcomeValues = {
     {5, 6}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}, {6, 6}};
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"backgammon",
-    /*long_name=*/"Backgammon",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*min_num_players=*/2,
-    /*max_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"scoring_type",
-      GameParameter(static_cast<std::string>(kDefaultScoringType))}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"backgammon",
+      /*long_name=*/"Backgammon",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*min_num_players=*/2,
+      /*max_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"scoring_type",
+        GameParameter(static_cast<std::string>(kDefaultScoringType))}}};
+  return kGameType;
+}
 
 static std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new BackgammonGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("backgammon", GetGameType, Factory);
 }  // namespace
 
 ScoringType ParseScoringType(const std::string& st_str) {
@@ -460,6 +463,7 @@ void BackgammonState::DoApplyAction(Action move) {
 }
 
 void BackgammonState::UndoAction(int player, Action action) {
+  InvalidateLegalActionsCache();
   {
     const TurnHistoryInfo& thi = turn_history_info_.back();
     SPIEL_CHECK_EQ(thi.player, player);
@@ -520,6 +524,61 @@ Action BackgammonState::EncodedBarMove() const { return 24; }
 
 Action BackgammonState::EncodedPassMove() const { return 25; }
 
+namespace {
+
+// The action encoding is two digits in base 26 (a board point, 24 for the
+// bar, 25 for pass) plus a high-roll-first flag (see kNumDistinctActions in
+// the header). The digits of an action never depend on the state, so both
+// directions of the conversion are precomputed once and served from lookup
+// tables; only the die values are filled in from the current roll.
+
+// Positional part of a decoded action.
+struct DecodedSpielMove {
+  int pos0;  // A board point, kBarPos or kPassPos.
+  int pos1;
+  bool high_roll_first;
+};
+
+int DigitToPosition(int digit) {
+  if (digit == 24) return kBarPos;   // EncodedBarMove().
+  if (digit == 25) return kPassPos;  // EncodedPassMove().
+  return digit;
+}
+
+const std::array<DecodedSpielMove, kNumDistinctActions>& DecodeTable() {
+  static const auto* table = []() {
+    auto* t = new std::array<DecodedSpielMove, kNumDistinctActions>();
+    for (int action = 0; action < kNumDistinctActions; ++action) {
+      int encoded = action;
+      bool high_roll_first = encoded < 676;
+      if (!high_roll_first) encoded -= 676;
+      (*t)[action] = {DigitToPosition(encoded % 26),
+                      DigitToPosition(encoded / 26), high_roll_first};
+    }
+    return t;
+  }();
+  return *table;
+}
+
+// EncodeTable()[high_roll_first ? 0 : 1][dig1][dig0] is the action encoding
+// those digits.
+const std::array<std::array<std::array<Action, 26>, 26>, 2>& EncodeTable() {
+  static const auto* table = []() {
+    auto* t = new std::array<std::array<std::array<Action, 26>, 26>, 2>();
+    for (int flag = 0; flag < 2; ++flag) {
+      for (int dig1 = 0; dig1 < 26; ++dig1) {
+        for (int dig0 = 0; dig0 < 26; ++dig0) {
+          (*t)[flag][dig1][dig0] = dig1 * 26 + dig0 + flag * 676;
+        }
+      }
+    }
+    return t;
+  }();
+  return *table;
+}
+
+}  // namespace
+
 Action BackgammonState::CheckerMovesToSpielMove(
     const std::vector<CheckerMove>& moves) const {
   SPIEL_CHECK_LE(moves.size(), 2);
@@ -550,10 +609,7 @@ Action BackgammonState::CheckerMovesToSpielMove(
     }
   }
 
-  Action move = dig1 * 26 + dig0;
-  if (!high_roll_first) {
-    move += 676;  // 26**2
-  }
+  Action move = EncodeTable()[high_roll_first ? 0 : 1][dig1][dig0];
   SPIEL_CHECK_GE(move, 0);
   SPIEL_CHECK_LT(move, kNumDistinctActions);
   return move;
@@ -564,36 +620,22 @@ std::vector<CheckerMove> BackgammonState::SpielMoveToCheckerMoves(
   SPIEL_CHECK_GE(spiel_move, 0);
   SPIEL_CHECK_LT(spiel_move, kNumDistinctActions);
 
-  bool high_roll_first = spiel_move < 676;
-  if (!high_roll_first) {
-    spiel_move -= 676;
-  }
-
-  std::vector<Action> digits = {spiel_move % 26, spiel_move / 26};
-  std::vector<CheckerMove> cmoves;
+  const DecodedSpielMove& decoded = DecodeTable()[spiel_move];
   int high_roll = DiceValue(0) >= DiceValue(1) ? DiceValue(0) : DiceValue(1);
   int low_roll = DiceValue(0) < DiceValue(1) ? DiceValue(0) : DiceValue(1);
+  SPIEL_CHECK_GE(low_roll, 1);
+  SPIEL_CHECK_LE(high_roll, 6);
+  int num0 = decoded.high_roll_first ? high_roll : low_roll;
+  int num1 = decoded.high_roll_first ? low_roll : high_roll;
 
-  for (int i = 0; i < 2; ++i) {
-    SPIEL_CHECK_GE(digits[i], 0);
-    SPIEL_CHECK_LE(digits[i], 25);
-
-    int num = -1;
-    if (i == 0) {
-      num = high_roll_first ? high_roll : low_roll;
-    } else {
-      num = high_roll_first ? low_roll : high_roll;
-    }
-    SPIEL_CHECK_GE(num, 1);
-    SPIEL_CHECK_LE(num, 6);
-
-    if (digits[i] == EncodedPassMove()) {
-      cmoves.push_back(CheckerMove(kPassPos, -1, false));
-    } else {
-      cmoves.push_back(CheckerMove(
-          digits[i] == EncodedBarMove() ? kBarPos : digits[i], num, false));
-    }
-  }
+  std::vector<CheckerMove> cmoves;
+  cmoves.reserve(2);
+  cmoves.push_back(decoded.pos0 == kPassPos ? CheckerMove(kPassPos, -1, false)
+                                            : CheckerMove(decoded.pos0, num0,
+                                                          false));
+  cmoves.push_back(decoded.pos1 == kPassPos ? CheckerMove(kPassPos, -1, false)
+                                            : CheckerMove(decoded.pos1, num1,
+                                                          false));
   return cmoves;
 }
 
@@ -858,28 +900,36 @@ int BackgammonState::IsBackgammoned(int player) const {
   return false;
 }
 
-std::set<CheckerMove> BackgammonState::LegalCheckerMoves(int player) const {
-  std::set<CheckerMove> moves;
+void BackgammonState::LegalCheckerMoves(
+    int player, std::vector<CheckerMove>* moves) const {
+  moves->clear();
+
+  // With doubles the two dice are interchangeable, so generating from the
+  // first usable die is enough to produce each move exactly once.
+  const int num_dice =
+      (dice_.size() == 2 && dice_[0] == dice_[1]) ? 1 : dice_.size();
 
   if (bar_[player] > 0) {
     // If there are any checkers are the bar, must move them out first.
-    for (int outcome : dice_) {
+    for (int i = 0; i < num_dice; ++i) {
+      int outcome = dice_[i];
       if (UsableDiceOutcome(outcome)) {
         int pos = PositionFromBar(player, outcome);
         if (NumOppCheckers(player, pos) <= 1) {
           bool hit = NumOppCheckers(player, pos) == 1;
-          moves.insert(CheckerMove(kBarPos, outcome, hit));
+          moves->push_back(CheckerMove(kBarPos, outcome, hit));
         }
       }
     }
-    return moves;
+    return;
   }
 
   // Regular board moves.
   bool all_in_home = AllInHome(player);
   for (int i = 0; i < kNumPoints; ++i) {
     if (board_[player][i] > 0) {
-      for (int outcome : dice_) {
+      for (int d = 0; d < num_dice; ++d) {
+        int outcome = dice_[d];
         if (UsableDiceOutcome(outcome)) {
           int pos = PositionFrom(player, i, outcome);
           if (pos == kScorePos && all_in_home) {
@@ -890,24 +940,23 @@ std::set<CheckerMove> BackgammonState::LegalCheckerMoves(int player) const {
             // just stepping off the board.
             if ((player == kXPlayerId && i + outcome == 24) ||
                 (player == kOPlayerId && i - outcome == -1)) {
-              moves.insert(CheckerMove(i, outcome, false));
+              moves->push_back(CheckerMove(i, outcome, false));
             } else {
               // Otherwise, a die can only be used to move a checker off if
               // there are no checkers further than it in the player's home.
               if (i == FurthestCheckerInHome(player)) {
-                moves.insert(CheckerMove(i, outcome, false));
+                moves->push_back(CheckerMove(i, outcome, false));
               }
             }
           } else if (pos != kScorePos && NumOppCheckers(player, pos) <= 1) {
             // Regular move.
             bool hit = NumOppCheckers(player, pos) == 1;
-            moves.insert(CheckerMove(i, outcome, hit));
+            moves->push_back(CheckerMove(i, outcome, hit));
           }
         }
       }
     }
   }
-  return moves;
 }
 
 bool BackgammonState::ApplyCheckerMove(int player, const CheckerMove& move) {
@@ -1004,35 +1053,37 @@ void BackgammonState::UndoCheckerMove(int player, const CheckerMove& move) {
 
 // Returns the maximum move size (2, 1, or 0)
 int BackgammonState::RecLegalMoves(
-    std::vector<CheckerMove> moveseq,
-    std::set<std::vector<CheckerMove>>* movelist) {
-  if (moveseq.size() == 2) {
-    movelist->insert(moveseq);
-    return moveseq.size();
+    std::vector<CheckerMove>* moveseq,
+    std::vector<std::vector<CheckerMove>>* movelist) {
+  if (moveseq->size() == 2) {
+    movelist->push_back(*moveseq);
+    return moveseq->size();
   }
 
-  std::set<CheckerMove> moves_here = LegalCheckerMoves(cur_player_);
+  std::vector<CheckerMove> moves_here;
+  LegalCheckerMoves(cur_player_, &moves_here);
 
   if (moves_here.empty()) {
-    movelist->insert(moveseq);
-    return moveseq.size();
+    movelist->push_back(*moveseq);
+    return moveseq->size();
   }
 
   int max_moves = -1;
   for (const auto& move : moves_here) {
-    moveseq.push_back(move);
+    moveseq->push_back(move);
     ApplyCheckerMove(cur_player_, move);
     int child_max = RecLegalMoves(moveseq, movelist);
     UndoCheckerMove(cur_player_, move);
     max_moves = std::max(child_max, max_moves);
-    moveseq.pop_back();
+    moveseq->pop_back();
   }
 
   return max_moves;
 }
 
 std::vector<Action> BackgammonState::ProcessLegalMoves(
-    int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const {
+    int max_moves,
+    const std::vector<std::vector<CheckerMove>>& movelist) const {
   if (max_moves == 0) {
     SPIEL_CHECK_EQ(movelist.size(), 1);
     SPIEL_CHECK_TRUE(movelist.begin()->empty());
@@ -1083,14 +1134,20 @@ std::vector<Action> BackgammonState::LegalActions() const {
   SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
   SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
 
-  std::unique_ptr<State> cstate = this->Clone();
-  BackgammonState* state = dynamic_cast<BackgammonState*>(cstate.get());
-  std::set<std::vector<CheckerMove>> movelist;
-  int max_moves = state->RecLegalMoves({}, &movelist);
+  // The recursion applies and undoes candidate checker moves directly on this
+  // state; every path is fully unwound, so the state is unchanged on return.
+  // This avoids cloning the whole state per call.
+  auto* mutable_this = const_cast<BackgammonState*>(this);
+  std::vector<CheckerMove> moveseq;
+  moveseq.reserve(2);
+  std::vector<std::vector<CheckerMove>> movelist;
+  int max_moves = mutable_this->RecLegalMoves(&moveseq, &movelist);
   SPIEL_CHECK_GE(max_moves, 0);
   SPIEL_CHECK_LE(max_moves, 2);
   std::vector<Action> legal_actions = ProcessLegalMoves(max_moves, movelist);
   std::sort(legal_actions.begin(), legal_actions.end());
+  legal_actions.erase(std::unique(legal_actions.begin(), legal_actions.end()),
+                      legal_actions.end());
   return legal_actions;
 }
 
@@ -1099,6 +1156,22 @@ std::vector<std::pair<Action, double>> BackgammonState::ChanceOutcomes() const {
   return kChanceOutcomes;
 }
 
+std::pair<Action, double> BackgammonState::SampleChanceOutcome(double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // Outcomes 0-14 are the non-doubles (probability 1/18 each, 15/18 total);
+  // outcomes 15-20 are the doubles (probability 1/36 each).
+  constexpr double kNonDoublesMass = 15.0 / 18;
+  if (z < kNonDoublesMass) {
+    int outcome = static_cast<int>(z * 18);
+    if (outcome > 14) outcome = 14;  // Guard against rounding at the boundary.
+    return {outcome, 1.0 / 18};
+  } else {
+    int outcome = 15 + static_cast<int>((z - kNonDoublesMass) * 36);
+    if (outcome > 20) outcome = 20;
+    return {outcome, 1.0 / 36};
+  }
+}
+
 std::string BackgammonState::ToString() const {
   std::vector<std::string> board_array = {
       "+------|------+", "|......|......|", "|......|......|",
@@ -1226,7 +1299,7 @@ void BackgammonState::SetState(int cur_player, bool double_turn,
 }
 
 BackgammonGame::BackgammonGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       scoring_type_(
           ParseScoringType(ParameterValue<std::string>("scoring_type"))) {}
 
@@ -17,7 +17,6 @@
 
 #include <array>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -119,6 +118,10 @@ class BackgammonState : public State {
   std::vector<Action> LegalActions() const override;
   std::string ActionToString(Player player, Action move_id) const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  // The roll distribution is fixed (15 non-doubles at 1/18, 6 doubles at
+  // 1/36), so an outcome can be sampled by arithmetic on z without
+  // materializing the 21-entry ChanceOutcomes() vector.
+  std::pair<Action, double> SampleChanceOutcome(double z) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
@@ -213,11 +216,17 @@ class BackgammonState : public State {
 
   bool ApplyCheckerMove(int player, const CheckerMove& move);
   void UndoCheckerMove(int player, const CheckerMove& move);
-  std::set<CheckerMove> LegalCheckerMoves(int player) const;
-  int RecLegalMoves(std::vector<CheckerMove> moveseq,
-                    std::set<std::vector<CheckerMove>>* movelist);
+  // Fills *moves with the single checker moves playable with the current
+  // dice (each move once - with doubles the two dice are interchangeable).
+  void LegalCheckerMoves(int player, std::vector<CheckerMove>* moves) const;
+  // Enumerates the checker-move sequences for this turn by applying and
+  // undoing candidate moves in place; *moveseq is scratch space for the
+  // current path. Returns the maximum sequence length (2, 1, or 0).
+  int RecLegalMoves(std::vector<CheckerMove>* moveseq,
+                    std::vector<std::vector<CheckerMove>>* movelist);
   std::vector<Action> ProcessLegalMoves(
-      int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const;
+      int max_moves,
+      const std::vector<std::vector<CheckerMove>>& movelist) const;
 
   ScoringType scoring_type_;  // Which rules apply when scoring the game.
 
@@ -249,6 +258,7 @@ class BackgammonGame : public Game {
 
   // There is arbitrarily chosen number to ensure the game is finite.
   int MaxGameLength() const override { return 1000; }
+  bool ProvidesUndo() const override { return true; }
 
   int NumPlayers() const override { return 2; }
   double MinUtility() const override { return -MaxUtility(); }
@@ -62,6 +62,22 @@ void BasicBackgammonTestsDoNotStartWithDoubles() {
   }
 }
 
+// The closed-form dice sampler must agree with a cumulative walk over
+// ChanceOutcomes(). The sweep stays away from exact outcome boundaries,
+// where the two implementations may legitimately differ by one ulp.
+void SampleChanceOutcomeTest() {
+  std::shared_ptr<const Game> game = LoadGame("backgammon");
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_TRUE(state->IsChanceNode());
+  ActionsAndProbs outcomes = state->ChanceOutcomes();
+  for (int i = 0; i < 1000; ++i) {
+    double z = (i + 0.5) / 1000.0;
+    std::pair<Action, double> sampled = state->SampleChanceOutcome(z);
+    SPIEL_CHECK_EQ(sampled.first, SampleChanceOutcome(outcomes, z));
+    SPIEL_CHECK_FLOAT_EQ(sampled.second, outcomes[sampled.first].second);
+  }
+}
+
 // Must bear-off furthest checker first.
 // Should have exactly one legal move here (since double moves are
 // two separate turns): 1-5, 0-5
@@ -527,6 +543,7 @@ void HumanReadableNotation() {
 
 int main(int argc, char** argv) {
   open_spiel::testing::LoadGameTest("backgammon");
+  open_spiel::backgammon::SampleChanceOutcomeTest();
   open_spiel::backgammon::BasicBackgammonTestsDoNotStartWithDoubles();
   open_spiel::backgammon::BearOffFurthestFirstTest();
   open_spiel::backgammon::NormalBearOffSituation();
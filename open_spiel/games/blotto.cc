@@ -28,30 +28,33 @@ constexpr const int kDefaultNumPlayers = 2;
 
 namespace {
 
-const GameType kGameType{
-    /*short_name=*/"blotto",
-    /*long_name=*/"Blotto",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"coins", GameParameter(kDefaultNumCoins)},
-     {"fields", GameParameter(kDefaultNumFields)},
-     {"players", GameParameter(kDefaultNumPlayers)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"blotto",
+      /*long_name=*/"Blotto",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"coins", GameParameter(kDefaultNumCoins)},
+       {"fields", GameParameter(kDefaultNumFields)},
+       {"players", GameParameter(kDefaultNumPlayers)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new BlottoGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("blotto", GetGameType, Factory);
 }  // namespace
 
 BlottoState::BlottoState(std::shared_ptr<const Game> game, int coins,
@@ -178,7 +181,7 @@ void BlottoGame::CreateActionMapRec(int* count, int coins_left,
 }
 
 BlottoGame::BlottoGame(const GameParameters& params)
-    : NormalFormGame(kGameType, params),
+    : NormalFormGame(GetGameType(), params),
       num_distinct_actions_(0),  // Set properly after CreateActionMap.
       coins_(ParameterValue<int>("coins")),
       fields_(ParameterValue<int>("fields")),
@@ -38,29 +38,32 @@ constexpr std::array<int, kNumDirections> kDirColOffsets = {
     {-1, 0, 1, -1, 0, 1}};
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"breakthrough",
-    /*long_name=*/"Breakthrough",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"rows", GameParameter(kDefaultRows)},
-     {"columns", GameParameter(kDefaultColumns)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"breakthrough",
+      /*long_name=*/"Breakthrough",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"rows", GameParameter(kDefaultRows)},
+       {"columns", GameParameter(kDefaultColumns)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new BreakthroughGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("breakthrough", GetGameType, Factory);
 
 int StateToPlayer(CellState state) {
   switch (state) {
@@ -341,6 +344,7 @@ void BreakthroughState::InformationStateAsNormalizedVector(
 }
 
 void BreakthroughState::UndoAction(Player player, Action action) {
+  InvalidateLegalActionsCache();
   std::vector<int> values(4, -1);
   UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
   int r1 = values[0];
@@ -379,7 +383,7 @@ std::unique_ptr<State> BreakthroughState::Clone() const {
 }
 
 BreakthroughGame::BreakthroughGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       rows_(ParameterValue<int>("rows")),
       cols_(ParameterValue<int>("columns")) {}
 
@@ -73,6 +73,19 @@ class BreakthroughState : public State {
   std::vector<Action> LegalActions() const override;
   std::string Serialize() const override;
 
+  // Position key: FNV-1a over the board cells and the side to move (which,
+  // unlike in tic-tac-toe, does not follow from the board contents).
+  uint64_t HashValue() const override {
+    uint64_t hash = 14695981039346656037ULL;
+    for (CellState cell : board_) {
+      hash ^= static_cast<uint64_t>(cell);
+      hash *= 1099511628211ULL;
+    }
+    hash ^= static_cast<uint64_t>(cur_player_);
+    hash *= 1099511628211ULL;
+    return hash;
+  }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -107,6 +120,7 @@ class BreakthroughGame : public Game {
   std::vector<int> InformationStateNormalizedVectorShape() const override {
     return {kCellStates, rows_, cols_};
   }
+  bool ProvidesHashValue() const override { return true; }
 
   // Each piece must move forward from its current position, so the second last
   // row on the opponent's side is a distance of rows_ - 2 for the front row,
@@ -116,6 +130,7 @@ class BreakthroughGame : public Game {
   int MaxGameLength() const override {
     return (2 * (2 * rows_ - 3) * cols_) + 1;
   }
+  bool ProvidesUndo() const override { return true; }
   std::unique_ptr<State> DeserializeState(
       const std::string& str) const override;
 
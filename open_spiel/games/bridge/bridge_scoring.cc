@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/bridge/bridge_scoring.h"
 
+#include "open_spiel/spiel_utils.h"
+
 namespace open_spiel {
 namespace bridge {
 namespace {
@@ -74,9 +76,9 @@ int ScoreBonuses(int level, int contract_score, bool is_vulnerable) {
     return 50;
   }
 }
-}  // namespace
 
-int Score(Contract contract, int declarer_tricks, bool is_vulnerable) {
+// Computes the score arithmetically. Only used to fill the lookup table.
+int ComputeScore(Contract contract, int declarer_tricks, bool is_vulnerable) {
   int contracted_tricks = 6 + contract.level;
   int contract_result = declarer_tricks - contracted_tricks;
   if (contract_result < 0) {
@@ -92,5 +94,48 @@ int Score(Contract contract, int declarer_tricks, bool is_vulnerable) {
   }
 }
 
+// Every score, indexed by [level - 1][trumps][log2(double status)]
+// [is_vulnerable][declarer tricks]. The whole domain is only 2940 entries.
+using ScoreTable =
+    std::array<std::array<std::array<std::array<std::array<int, 14>, 2>, 3>,
+                          5>,
+               7>;
+
+const ScoreTable& GetScoreTable() {
+  static const auto* table = []() {
+    auto* t = new ScoreTable();
+    for (int level = 1; level <= 7; ++level) {
+      for (int trumps = kClubs; trumps <= kNone; ++trumps) {
+        for (int doubles = 0; doubles < 3; ++doubles) {
+          for (int vul = 0; vul < 2; ++vul) {
+            for (int tricks = 0; tricks < 14; ++tricks) {
+              (*t)[level - 1][trumps][doubles][vul][tricks] = ComputeScore(
+                  {level, Suit(trumps), DoubleStatus(1 << doubles)}, tricks,
+                  vul == 1);
+            }
+          }
+        }
+      }
+    }
+    return t;
+  }();
+  return *table;
+}
+}  // namespace
+
+const std::array<int, 14>& ScoreAllTricks(Contract contract,
+                                          bool is_vulnerable) {
+  SPIEL_CHECK_GE(contract.level, 1);
+  SPIEL_CHECK_LE(contract.level, 7);
+  return GetScoreTable()[contract.level - 1][contract.trumps]
+                        [contract.double_status / 2][is_vulnerable];
+}
+
+int Score(Contract contract, int declarer_tricks, bool is_vulnerable) {
+  SPIEL_CHECK_GE(declarer_tricks, 0);
+  SPIEL_CHECK_LE(declarer_tricks, 13);
+  return ScoreAllTricks(contract, is_vulnerable)[declarer_tricks];
+}
+
 }  // namespace bridge
 }  // namespace open_spiel
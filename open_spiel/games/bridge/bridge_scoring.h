@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_BRIDGE_SCORING_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_BRIDGE_SCORING_H_
 
+#include <array>
+
 // Scoring for (duplicate) contract bridge.
 // See Law 77 of the Laws of Bridge, 2017:
 // http://www.worldbridge.org/wp-content/uploads/2017/03/2017LawsofDuplicateBridge-paginated.pdf
@@ -34,6 +36,12 @@ struct Contract {
 
 int Score(Contract contract, int declarer_tricks, bool is_vulnerable);
 
+// The scores for a contract at every possible number of declarer tricks
+// (0 through 13), from a table precomputed on first use. Lets a caller score
+// one contract against many double-dummy results without rescoring.
+const std::array<int, 14>& ScoreAllTricks(Contract contract,
+                                          bool is_vulnerable);
+
 }  // namespace bridge
 }  // namespace open_spiel
 
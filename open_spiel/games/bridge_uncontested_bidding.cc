@@ -35,48 +35,59 @@ namespace {
 
 constexpr int kNumRedeals = 10;  // how many possible layouts to analyse
 
-const GameType kGameType{
-    /*short_name=*/"bridge_uncontested_bidding",
-    /*long_name=*/"Bridge: Uncontested Bidding",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kSampledStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/kNumPlayers,
-    /*min_num_players=*/kNumPlayers,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {
-        {"subgame", GameParameter(static_cast<std::string>(""))},
-        {"rng_seed", GameParameter(0)},
-        {"relative_scoring", GameParameter(false)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"bridge_uncontested_bidding",
+      /*long_name=*/"Bridge: Uncontested Bidding",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kSampledStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/kNumPlayers,
+      /*min_num_players=*/kNumPlayers,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {
+          {"subgame", GameParameter(static_cast<std::string>(""))},
+          {"rng_seed", GameParameter(0)},
+          {"relative_scoring", GameParameter(false)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new UncontestedBiddingGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("bridge_uncontested_bidding", GetGameType, Factory);
 
 constexpr Action kPass = 0;
 constexpr Action k2NT = 10;
 
+// One suit in a hand mask: every fourth card, starting from the suit.
+constexpr uint64_t kSuitZeroMask = 0x1111111111111ULL;
+
 bool Is2NTDeal(const Deal& deal) {
-  int lengths[kNumSuits] = {0, 0, 0, 0};
+  // The deal filter runs on every shuffle of a rejection-sampling loop,
+  // so the features come from popcounts on the hand mask rather than a
+  // per-card walk.
+  const uint64_t hand = deal.HandMask(0, kNumCardsPerHand);
+  // Balanced means 4333, 4432 or 5332
+  int length_product = 1;
+  for (int suit = 0; suit < kNumSuits; ++suit) {
+    length_product *= __builtin_popcountll(hand & (kSuitZeroMask << suit));
+  }
+  if (length_product < 90) return false;
   int hcp = 0;
-  for (int i = 0; i < kNumCardsPerHand; ++i) {
-    int suit = deal.Suit(i);
-    int rank = deal.Rank(i);
-    lengths[suit]++;
-    if (rank > 8) hcp += (rank - 8);
+  for (int rank = 9; rank <= 12; ++rank) {  // J, Q, K, A: 1..4 points.
+    hcp += (rank - 8) *
+           __builtin_popcountll(hand & (uint64_t{0xF} << (rank * kNumSuits)));
   }
-  // Balanced means 4333, 4432 or 5332
-  bool is_balanced = (lengths[0] * lengths[1] * lengths[2] * lengths[3] >= 90);
-  return is_balanced && (20 <= hcp) && (hcp <= 21);
+  return (20 <= hcp) && (hcp <= 21);
 }
 bool NoFilter(const Deal& deal) { return true; }
 
@@ -183,9 +194,10 @@ void UncontestedBiddingState::InformationStateAsNormalizedVector(
   std::fill(values->begin(), values->end(), 0.);
   auto ptr = values->begin();
 
-  for (int i = kNumCardsPerHand * player; i < kNumCardsPerHand * (1 + player);
-       ++i) {
-    ptr[deal_.Card(i)] = 1.;
+  // The hand section is fixed per deal, so it comes from the cached mask:
+  // one store per set bit.
+  for (uint64_t mask = hand_masks_[player]; mask != 0; mask &= mask - 1) {
+    ptr[__builtin_ctzll(mask)] = 1.;
   }
   ptr += kNumCards;
 
@@ -251,6 +263,17 @@ void UncontestedBiddingState::ScoreDeal() {
   reference_scores_.resize(reference_contracts_.size());
   std::fill(reference_scores_.begin(), reference_scores_.end(), 0);
 
+  // Look up the score-per-trick-count row for each contract once, rather
+  // than rescoring per redeal.
+  const std::array<int, 14>* contract_scores =
+      passed_out ? nullptr : &ScoreAllTricks(contract, /*is_vulnerable=*/false);
+  std::vector<const std::array<int, 14>*> reference_score_rows;
+  reference_score_rows.reserve(reference_contracts_.size());
+  for (const Contract& reference_contract : reference_contracts_) {
+    reference_score_rows.push_back(
+        &ScoreAllTricks(reference_contract, /*is_vulnerable=*/false));
+  }
+
   // For each redeal
   for (int ideal = 0; ideal < kNumRedeals; ++ideal) {
     if (ideal > 0) deal_.Shuffle(&rng_, kNumCardsPerHand * 2, kNumCards);
@@ -282,8 +305,7 @@ void UncontestedBiddingState::ScoreDeal() {
     if (!passed_out) {
       const int declarer_tricks =
           results.resTable[contract.trumps][2 * contract.declarer];
-      const int declarer_score =
-          Score(contract, declarer_tricks, /*is_vulnerable=*/false);
+      const int declarer_score = (*contract_scores)[declarer_tricks];
       score_ += static_cast<double>(declarer_score) / kNumRedeals;
     }
 
@@ -292,8 +314,7 @@ void UncontestedBiddingState::ScoreDeal() {
       const int declarer_tricks =
           results.resTable[reference_contracts_[i].trumps]
                           [2 * reference_contracts_[i].declarer];
-      const int declarer_score = Score(reference_contracts_[i], declarer_tricks,
-                                       /*is_vulnerable=*/false);
+      const int declarer_score = (*reference_score_rows[i])[declarer_tricks];
       reference_scores_[i] += static_cast<double>(declarer_score) / kNumRedeals;
     }
   }
@@ -308,6 +329,14 @@ void UncontestedBiddingState::DoApplyAction(Action action_id) {
       deal_.Shuffle(&rng_);
     } while (!deal_filter_(deal_));
     dealt_ = true;
+    CacheHandMasks();
+  }
+}
+
+void UncontestedBiddingState::CacheHandMasks() {
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    hand_masks_[player] = deal_.HandMask(kNumCardsPerHand * player,
+                                         kNumCardsPerHand * (1 + player));
   }
 }
 
@@ -317,7 +346,7 @@ std::vector<std::pair<Action, double>> UncontestedBiddingState::ChanceOutcomes()
 }
 
 UncontestedBiddingGame::UncontestedBiddingGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       forced_actions_{},
       deal_filter_{NoFilter},
       rng_seed_(ParameterValue<int>("rng_seed")) {
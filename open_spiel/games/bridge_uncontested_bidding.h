@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_UNCONTESTED_BIDDING_H_
 
 #include <array>
+#include <cstdint>
 
 // Uncontested bridge bidding. A two-player purely cooperative game.
 //
@@ -129,6 +130,15 @@ class Deal {
   int Card(int i) const { return cards_[i]; }
   int Suit(int i) const { return cards_[i] % kNumSuits; }
   int Rank(int i) const { return cards_[i] / kNumSuits; }
+  // Bitmask over card indices of the cards in positions [begin, end).
+  // Cards are numbered rank * kNumSuits + suit, so a suit is every fourth
+  // bit and a rank is a nibble; suit lengths and high-card points are
+  // popcounts against fixed masks, with no per-card loop.
+  uint64_t HandMask(int begin, int end) const {
+    uint64_t mask = 0;
+    for (int i = begin; i < end; ++i) mask |= uint64_t{1} << cards_[i];
+    return mask;
+  }
   std::string HandString(int begin, int end) const;
 
  private:
@@ -157,6 +167,7 @@ class UncontestedBiddingState : public State {
         rng_(rng_seed),
         deal_(deal),
         dealt_(true) {
+    CacheHandMasks();
     if (IsTerminal()) ScoreDeal();
   }
   UncontestedBiddingState(const UncontestedBiddingState&) = default;
@@ -178,6 +189,7 @@ class UncontestedBiddingState : public State {
  protected:
   void DoApplyAction(Action action_id) override;
   void ScoreDeal();
+  void CacheHandMasks();
 
  private:
   // If non-empty, the score for player 1 will be relative to the best-scoring
@@ -192,6 +204,11 @@ class UncontestedBiddingState : public State {
   std::function<bool(const Deal&)> deal_filter_;
   mutable std::mt19937 rng_;
   mutable Deal deal_;
+  // Each player's hand as a card bitmask, fixed once the deal is made
+  // (the redeal shuffles only touch the opponents' cards); the
+  // information state encoding reads this cache instead of re-deriving
+  // the hand per call.
+  std::array<uint64_t, kNumPlayers> hand_masks_{};
   bool dealt_;
   double score_;                          // score for the achieved contract
   std::vector<double> reference_scores_;  // scores for the reference_contracts
@@ -25,29 +25,32 @@ namespace catch_ {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"catch",
-    /*long_name=*/"Catch",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/1,
-    /*min_num_players=*/1,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"rows", GameParameter(kDefaultRows)},
-     {"columns", GameParameter(kDefaultColumns)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"catch",
+      /*long_name=*/"Catch",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/1,
+      /*min_num_players=*/1,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"rows", GameParameter(kDefaultRows)},
+       {"columns", GameParameter(kDefaultColumns)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new CatchGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("catch", GetGameType, Factory);
 
 std::string StateToString(CellState state) {
   switch (state) {
@@ -98,6 +101,12 @@ ActionsAndProbs CatchState::ChanceOutcomes() const {
   return action_and_probs;
 }
 
+int64_t CatchState::EstimatedMemory() const {
+  // The board is implicit in three ints, so there is no storage beyond the
+  // object and the base-class bookkeeping.
+  return State::EstimatedMemory() + sizeof(CatchState) - sizeof(State);
+}
+
 CellState CatchState::BoardAt(int row, int column) const {
   if (row == num_rows_ - 1 && column == paddle_col_)
     return CellState::kPaddle;
@@ -185,15 +194,24 @@ void CatchState::InformationStateAsNormalizedVector(
 }
 
 void CatchState::UndoAction(Player player, Action move) {
+  InvalidateLegalActionsCache();
+  history_.pop_back();
   if (player == kChancePlayerId) {
     initialized_ = false;
+    ball_row_ = -1;
+    ball_col_ = -1;
+    paddle_col_ = -1;
     return;
   }
-  int direction = move - 1;
-  paddle_col_ =
-      std::min(std::max(paddle_col_ - direction, 0), num_columns_ - 1);
   --ball_row_;
-  history_.pop_back();
+  // The paddle clamps at the walls, so the previous column cannot always be
+  // recovered from the move alone; replay the remaining moves instead.
+  paddle_col_ = num_columns_ / 2;
+  for (int i = 1; i < history_.size(); ++i) {
+    int direction = history_[i] - 1;
+    paddle_col_ =
+        std::min(std::max(paddle_col_ + direction, 0), num_columns_ - 1);
+  }
 }
 
 std::unique_ptr<State> CatchState::Clone() const {
@@ -215,7 +233,7 @@ void CatchState::DoApplyAction(Action move) {
 }
 
 CatchGame::CatchGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_rows_(ParameterValue<int>("rows")),
       num_columns_(ParameterValue<int>("columns")) {}
 
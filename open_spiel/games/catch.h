@@ -79,6 +79,7 @@ class CatchState : public State {
   void UndoAction(Player player, Action move) override;
   std::vector<Action> LegalActions() const override;
   ActionsAndProbs ChanceOutcomes() const override;
+  int64_t EstimatedMemory() const override;
   CellState BoardAt(int row, int column) const;
 
  protected:
@@ -116,6 +117,7 @@ class CatchGame : public Game {
   double MaxUtility() const override { return 1; }
   double MinUtility() const override { return -1; }
   int MaxGameLength() const override { return num_rows_; }
+  bool ProvidesUndo() const override { return true; }
   int NumRows() const { return num_rows_; }
   int NumColumns() const { return num_columns_; }
 
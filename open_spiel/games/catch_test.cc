@@ -29,6 +29,7 @@ void BasicCatchTests() {
   testing::LoadGameTest("catch");
   testing::ChanceOutcomesTest(*LoadGame("catch"));
   testing::RandomSimTest(*LoadGame("catch"), 100);
+  testing::ReturnsCostTest(*LoadGame("catch"), /*min_episode_length=*/5);
 }
 
 void GetAllStatesTest() {
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
+#include <cstring>
 #include <optional>
 
 #include "open_spiel/games/chess/chess_board.h"
@@ -27,64 +29,55 @@ constexpr int kNumReversibleMovesToDraw = 100;
 constexpr int kNumRepetitionsToDraw = 3;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"chess",
-    /*long_name=*/"Chess",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"chess",
+      /*long_name=*/"Chess",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new ChessGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("chess", GetGameType, Factory);
 
-// Adds a plane to the information state vector corresponding to the presence
-// and absence of the given piece type and colour at each square.
-void AddPieceTypePlane(Color color, PieceType piece_type,
-                       const StandardChessBoard& board,
-                       std::vector<double>* values) {
-  for (int8_t y = 0; y < BoardSize(); ++y) {
-    for (int8_t x = 0; x < BoardSize(); ++x) {
-      Piece piece_on_board = board.at(Square{x, y});
-      values->push_back(piece_on_board.color == color &&
-                                piece_on_board.type == piece_type
-                            ? 1.0
-                            : 0.0);
-    }
-  }
-}
+// The plane writers below advance `buffer` past the plane they fill, so the
+// information state vector is laid down in one pass with no intermediate
+// storage.
 
-// Adds a uniform scalar plane scaled with min and max.
+// Writes a plane corresponding to the presence and absence of the given piece
+// type and colour at each square.
+// Writes a uniform scalar plane scaled with min and max.
 template <typename T>
-void AddScalarPlane(T val, T min, T max, std::vector<double>* values) {
+void AddScalarPlane(T val, T min, T max, double*& buffer) {
   double normalized_val = static_cast<double>(val - min) / (max - min);
-  values->insert(values->end(), BoardSize() * BoardSize(), normalized_val);
+  buffer = std::fill_n(buffer, BoardSize() * BoardSize(), normalized_val);
 }
 
-// Adds a binary scalar plane.
-void AddBinaryPlane(bool val, std::vector<double>* values) {
-  AddScalarPlane<int>(val ? 1 : 0, 0, 1, values);
+// Writes a binary scalar plane.
+void AddBinaryPlane(bool val, double*& buffer) {
+  AddScalarPlane<int>(val ? 1 : 0, 0, 1, buffer);
 }
 }  // namespace
 
 ChessState::ChessState(std::shared_ptr<const Game> game)
     : State(game),
       start_board_(MakeDefaultBoard()),
-      current_board_(start_board_) {
-  repetitions_[current_board_.HashValue()] = 1;
-}
+      current_board_(start_board_) {}
 
 ChessState::ChessState(std::shared_ptr<const Game> game, const std::string& fen)
     : State(game) {
@@ -92,14 +85,16 @@ ChessState::ChessState(std::shared_ptr<const Game> game, const std::string& fen)
   SPIEL_CHECK_TRUE(maybe_board);
   start_board_ = *maybe_board;
   current_board_ = start_board_;
-  repetitions_[current_board_.HashValue()] = 1;
 }
 
 void ChessState::DoApplyAction(Action action) {
-  Move move = ActionToMove(action);
-  moves_history_.push_back(move);
-  Board().ApplyMove(move);
-  ++repetitions_[current_board_.HashValue()];
+  auto node = std::make_shared<HistoryNode>();
+  node->parent = std::move(history_chain_);
+  node->move = ActionToMove(action);
+  Board().ApplyMove(node->move, &node->undo);
+  node->hash = current_board_.HashValue();
+  // The node is published (and from then on immutable) only once complete.
+  history_chain_ = std::move(node);
 }
 
 std::vector<Action> ChessState::LegalActions() const {
@@ -113,6 +108,20 @@ std::vector<Action> ChessState::LegalActions() const {
   return actions;
 }
 
+std::vector<Action> ChessState::LegalActions(ActionStage stage) const {
+  std::vector<Action> actions;
+  if (IsTerminal()) return actions;
+  Board().GenerateLegalMoves(
+      [&actions](const Move& move) -> bool {
+        actions.push_back(MoveToAction(move));
+        return true;
+      },
+      stage == ActionStage::kForcing ? MoveStage::kForcing
+                                     : MoveStage::kQuiet);
+  std::sort(actions.begin(), actions.end());
+  return actions;
+}
+
 std::string ChessState::ActionToString(Player player, Action action) const {
   Move move = ActionToMove(action);
   return move.ToSAN(Board());
@@ -135,27 +144,44 @@ std::string ChessState::InformationState(Player player) const {
 
 void ChessState::InformationStateAsNormalizedVector(
     Player player, std::vector<double>* values) const {
-  SPIEL_CHECK_NE(player, kChancePlayerId);
-
   std::size_t vector_size = 1;
   for (int dim : InformationStateNormalizedVectorShape()) {
     vector_size *= dim;
   }
+  values->resize(vector_size);
+  InformationStateAsNormalizedVector(player, values->data());
+}
 
-  values->resize(0);
-  values->reserve(vector_size);
+void ChessState::InformationStateAsNormalizedVector(Player player,
+                                                    double* buffer) const {
+  SPIEL_CHECK_NE(player, kChancePlayerId);
 
-  // Piece cconfiguration.
-  for (const auto& piece_type : kPieceTypes) {
-    AddPieceTypePlane(Color::kWhite, piece_type, Board(), values);
-    AddPieceTypePlane(Color::kBlack, piece_type, Board(), values);
+  double* values = buffer;
+
+  // Piece configuration, in a single pass over the board: zero the twelve
+  // piece planes and the empty plane, then set the one entry each square
+  // contributes. The plane order matches the per-plane encoding this
+  // replaces - a white and a black plane per type in kPieceTypes order,
+  // followed by the empty plane - and kPieceTypes is ordered by enum value,
+  // so the plane index follows directly from the piece.
+  constexpr int kNumPieceTypes = kPieceTypes.size();
+  constexpr int kPiecePlanes = 2 * kNumPieceTypes + 1;
+  const int plane_size = BoardSize() * BoardSize();
+  std::fill(values, values + kPiecePlanes * plane_size, 0.);
+  int square = 0;
+  for (int8_t y = 0; y < BoardSize(); ++y) {
+    for (int8_t x = 0; x < BoardSize(); ++x, ++square) {
+      Piece piece = Board().at(Square{x, y});
+      int plane = piece.type == PieceType::kEmpty
+                      ? 2 * kNumPieceTypes
+                      : 2 * (static_cast<int>(piece.type) - 1) +
+                            (piece.color == Color::kWhite ? 0 : 1);
+      values[plane * plane_size + square] = 1.;
+    }
   }
+  values += kPiecePlanes * plane_size;
 
-  AddPieceTypePlane(Color::kEmpty, PieceType::kEmpty, Board(), values);
-
-  const auto entry = repetitions_.find(Board().HashValue());
-  SPIEL_CHECK_FALSE(entry == repetitions_.end());
-  int repetitions = entry->second;
+  int repetitions = RepetitionCount();
 
   // Num repetitions for the current board.
   AddScalarPlane(repetitions, 1, 3, values);
@@ -185,21 +211,77 @@ std::unique_ptr<State> ChessState::Clone() const {
 }
 
 void ChessState::UndoAction(Player player, Action action) {
-  // TODO: Make this fast by storing undo info in another stack.
-  SPIEL_CHECK_GE(moves_history_.size(), 1);
-  --repetitions_[current_board_.HashValue()];
-  moves_history_.pop_back();
+  InvalidateLegalActionsCache();
+  SPIEL_DCHECK_TRUE(history_chain_ != nullptr);
+  // Snapshot-restored history has no unmake records below the floor.
+  SPIEL_DCHECK_GT(static_cast<int>(history_.size()), snapshot_floor_);
+  current_board_.UndoMove(history_chain_->undo);
+  history_chain_ = history_chain_->parent;
   history_.pop_back();
-  current_board_ = start_board_;
-  for (const Move& move : moves_history_) {
-    current_board_.ApplyMove(move);
+}
+
+int64_t ChessState::EstimatedMemory() const {
+  int64_t bytes =
+      State::EstimatedMemory() + sizeof(ChessState) - sizeof(State);
+  for (const HistoryNode* node = history_chain_.get(); node != nullptr;
+       node = node->parent.get()) {
+    // One chain node plus its shared_ptr control block.
+    bytes += sizeof(HistoryNode) + 2 * sizeof(void*);
+  }
+  return bytes;
+}
+
+std::string ChessState::SerializeBinary() const {
+  std::string str;
+  AppendVarint(history_.size(), &str);
+  for (Action action : history_) {
+    AppendVarint(static_cast<uint64_t>(action), &str);
+  }
+  const std::string fen = Board().ToFEN();
+  AppendVarint(fen.size(), &str);
+  str.append(fen);
+  const std::string start_fen = start_board_.ToFEN();
+  AppendVarint(start_fen.size(), &str);
+  str.append(start_fen);
+  // Only positions since the last irreversible move can ever repeat, so
+  // the chain beyond that window need not be saved; the bound also holds
+  // for every future position, whose window starts no earlier than this
+  // one's (see RepetitionCount).
+  std::vector<uint64_t> hashes;
+  int remaining = Board().IrreversibleMoveCounter() + 1;
+  for (const HistoryNode* node = history_chain_.get();
+       node != nullptr && remaining > 0; node = node->parent.get()) {
+    hashes.push_back(node->hash);
+    --remaining;
   }
+  AppendVarint(hashes.size(), &str);
+  for (uint64_t hash : hashes) {
+    str.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+  }
+  return str;
+}
+
+int ChessState::RepetitionCount() const {
+  const uint64_t hash = Board().HashValue();
+  // Positions from before the last irreversible move cannot equal the
+  // current one, so only this many positions (including the current one)
+  // need to be examined.
+  int remaining = Board().IrreversibleMoveCounter() + 1;
+  int count = 0;
+  const HistoryNode* node = history_chain_.get();
+  while (node != nullptr && remaining > 0) {
+    if (node->hash == hash) ++count;
+    node = node->parent.get();
+    --remaining;
+  }
+  if (node == nullptr && remaining > 0 && start_board_.HashValue() == hash) {
+    ++count;
+  }
+  return count;
 }
 
 bool ChessState::IsRepetitionDraw() const {
-  const auto entry = repetitions_.find(Board().HashValue());
-  SPIEL_CHECK_FALSE(entry == repetitions_.end());
-  return entry->second >= kNumRepetitionsToDraw;
+  return RepetitionCount() >= kNumRepetitionsToDraw;
 }
 
 std::optional<std::vector<double>> ChessState::MaybeFinalReturns() const {
@@ -240,7 +322,50 @@ std::optional<std::vector<double>> ChessState::MaybeFinalReturns() const {
   return std::nullopt;
 }
 
-ChessGame::ChessGame(const GameParameters& params) : Game(kGameType, params) {}
+ChessGame::ChessGame(const GameParameters& params) : Game(GetGameType(), params) {}
+
+std::unique_ptr<State> ChessGame::DeserializeStateBinary(
+    const std::string& str) const {
+  size_t offset = 0;
+  const uint64_t num_actions = DecodeVarint(str, &offset);
+  std::vector<Action> history;
+  history.reserve(num_actions);
+  for (uint64_t i = 0; i < num_actions; ++i) {
+    history.push_back(static_cast<Action>(DecodeVarint(str, &offset)));
+  }
+  const uint64_t fen_size = DecodeVarint(str, &offset);
+  SPIEL_CHECK_LE(offset + fen_size, str.size());
+  const std::string fen = str.substr(offset, fen_size);
+  offset += fen_size;
+  const uint64_t start_fen_size = DecodeVarint(str, &offset);
+  SPIEL_CHECK_LE(offset + start_fen_size, str.size());
+  const std::string start_fen = str.substr(offset, start_fen_size);
+  offset += start_fen_size;
+
+  std::unique_ptr<ChessState> state(
+      new ChessState(shared_from_this(), start_fen));
+  auto maybe_board = StandardChessBoard::BoardFromFEN(fen);
+  SPIEL_CHECK_TRUE(maybe_board);
+  state->current_board_ = *maybe_board;
+  state->history_ = std::move(history);
+  state->snapshot_floor_ = static_cast<int>(state->history_.size());
+
+  // The saved hashes are newest first; rebuild the chain oldest first so
+  // the head ends up at the current position. Moves and unmake records are
+  // not part of a snapshot, which is why UndoAction stops at the floor.
+  const uint64_t num_hashes = DecodeVarint(str, &offset);
+  SPIEL_CHECK_LE(offset + num_hashes * sizeof(uint64_t), str.size());
+  for (uint64_t i = num_hashes; i-- > 0;) {
+    uint64_t hash;
+    std::memcpy(&hash, str.data() + offset + i * sizeof(uint64_t),
+                sizeof(hash));
+    auto node = std::make_shared<ChessState::HistoryNode>();
+    node->parent = std::move(state->history_chain_);
+    node->hash = hash;
+    state->history_chain_ = std::move(node);
+  }
+  return state;
+}
 
 }  // namespace chess
 }  // namespace open_spiel
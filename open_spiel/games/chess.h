@@ -111,58 +111,53 @@ inline Square IndexToSquare(uint8_t index) {
                 static_cast<int8_t>(index / BoardSize())};
 }
 
-inline Action MoveToAction(const Move& move) {
-  Action action = 0;
-
-  SetField(0, 6, SquareToIndex(move.from), &action);
-  SetField(6, 6, SquareToIndex(move.to), &action);
-
-  uint8_t promo_encoded = 0;
-  switch (move.promotion_type) {
-    case PieceType::kQueen:
-      promo_encoded = static_cast<uint8_t>(PromotionTypeEncoding::kQueen);
-      break;
-    case PieceType::kRook:
-      promo_encoded = static_cast<uint8_t>(PromotionTypeEncoding::kRook);
-      break;
-    case PieceType::kBishop:
-      promo_encoded = static_cast<uint8_t>(PromotionTypeEncoding::kBishop);
-      break;
-    case PieceType::kKnight:
-      promo_encoded = static_cast<uint8_t>(PromotionTypeEncoding::kKnight);
-      break;
-    default:
-      promo_encoded = 0;
+// Lookup tables for the action encoding, built at compile time so that
+// MoveToAction and ActionToMove are indexed loads instead of branch
+// chains; they run once per generated move in LegalActions and once per
+// ApplyAction/ActionToString.
+inline constexpr std::array<Square, BoardSize() * BoardSize()>
+MakeIndexToSquareTable() {
+  std::array<Square, BoardSize() * BoardSize()> table{};
+  for (int index = 0; index < BoardSize() * BoardSize(); ++index) {
+    table[index] = Square{static_cast<int8_t>(index % BoardSize()),
+                          static_cast<int8_t>(index / BoardSize())};
   }
+  return table;
+}
+inline constexpr auto kIndexToSquareTable = MakeIndexToSquareTable();
+
+// PieceType -> 3-bit promotion field; indexed by the PieceType value.
+// Non-promotion piece types (and kEmpty) map to kNotPromotion.
+inline constexpr std::array<uint8_t, 7> kPromotionEncodingTable = {
+    {static_cast<uint8_t>(PromotionTypeEncoding::kNotPromotion),  // kEmpty
+     static_cast<uint8_t>(PromotionTypeEncoding::kNotPromotion),  // kKing
+     static_cast<uint8_t>(PromotionTypeEncoding::kQueen),
+     static_cast<uint8_t>(PromotionTypeEncoding::kRook),
+     static_cast<uint8_t>(PromotionTypeEncoding::kBishop),
+     static_cast<uint8_t>(PromotionTypeEncoding::kKnight),
+     static_cast<uint8_t>(PromotionTypeEncoding::kNotPromotion)}};  // kPawn
+
+// 3-bit promotion field -> PieceType. The three unused encodings decode
+// to kKing, which no move can promote to, and are rejected below.
+inline constexpr std::array<PieceType, 8> kPromotionDecodingTable = {
+    {PieceType::kEmpty, PieceType::kQueen, PieceType::kRook, PieceType::kBishop,
+     PieceType::kKnight, PieceType::kKing, PieceType::kKing, PieceType::kKing}};
 
-  SetField(12, 3, promo_encoded, &action);
-
-  return action;
+inline Action MoveToAction(const Move& move) {
+  return static_cast<Action>(SquareToIndex(move.from)) |
+         (static_cast<Action>(SquareToIndex(move.to)) << 6) |
+         (static_cast<Action>(
+              kPromotionEncodingTable[static_cast<int>(move.promotion_type)])
+          << 12);
 }
 
 inline Move ActionToMove(const Action& action) {
-  PieceType promo_type;
-  switch (static_cast<PromotionTypeEncoding>(GetField(action, 12, 3))) {
-    case PromotionTypeEncoding::kQueen:
-      promo_type = PieceType::kQueen;
-      break;
-    case PromotionTypeEncoding::kRook:
-      promo_type = PieceType::kRook;
-      break;
-    case PromotionTypeEncoding::kBishop:
-      promo_type = PieceType::kBishop;
-      break;
-    case PromotionTypeEncoding::kKnight:
-      promo_type = PieceType::kKnight;
-      break;
-    case PromotionTypeEncoding::kNotPromotion:
-      promo_type = PieceType::kEmpty;
-      break;
-    default:
-      SpielFatalError("Unknown promotion type encoding");
+  const PieceType promo_type = kPromotionDecodingTable[GetField(action, 12, 3)];
+  if (promo_type == PieceType::kKing) {
+    SpielFatalError("Unknown promotion type encoding");
   }
-  return Move(IndexToSquare(GetField(action, 0, 6)),
-              IndexToSquare(GetField(action, 6, 6)), promo_type);
+  return Move(kIndexToSquareTable[GetField(action, 0, 6)],
+              kIndexToSquareTable[GetField(action, 6, 6)], promo_type);
 }
 
 // State of an in-play game.
@@ -182,6 +177,9 @@ class ChessState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(Board().ToPlay());
   }
   std::vector<Action> LegalActions() const override;
+  // Staged generation (ChessGame::ProvidesStagedActions): the forcing stage
+  // holds the captures and promotions, the quiet stage the rest.
+  std::vector<Action> LegalActions(ActionStage stage) const override;
   std::string ActionToString(Player player, Action action) const override;
   std::string ToString() const override;
 
@@ -194,13 +192,31 @@ class ChessState : public State {
   std::string InformationState(Player player) const override;
   void InformationStateAsNormalizedVector(
       Player player, std::vector<double>* values) const override;
+  void InformationStateAsNormalizedVector(Player player,
+                                          double* buffer) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action action) override;
 
+  // Direct snapshot of the position: the action history (recorded, not
+  // replayed on restore), both boards as FEN, and the window of position
+  // hashes the repetition rule can still reach. Restoring through
+  // ChessGame::DeserializeStateBinary rebuilds the state without applying
+  // a single move, where the base-class format replays the whole game.
+  std::string SerializeBinary() const override;
+
   // Current board.
   StandardChessBoard& Board() { return current_board_; }
   const StandardChessBoard& Board() const { return current_board_; }
 
+  // The board's incrementally-maintained Zobrist hash (covers side to move,
+  // castling rights and en passant).
+  uint64_t HashValue() const override { return Board().HashValue(); }
+
+  // Counts the history chain, which dominates the footprint of states deep
+  // into a game. Chain nodes shared with clones are counted in full for
+  // every state that can reach them.
+  int64_t EstimatedMemory() const override;
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -211,27 +227,43 @@ class ChessState : public State {
 
   std::optional<std::vector<double>> MaybeFinalReturns() const;
 
-  // We have to store every move made to check for repetitions and to implement
-  // undo. We store the current board position as an optimization.
-  std::vector<Move> moves_history_;
+  // One node per applied move in a shared, immutable history chain. Each
+  // DoApplyAction prepends a node and UndoAction pops back to the parent;
+  // nodes are never mutated after being published, so clones share the
+  // chain and Clone() copies one shared pointer instead of the whole
+  // history. This matters in search, where every expansion clones a state
+  // whose history grows with the move number.
+  struct HistoryNode {
+    std::shared_ptr<const HistoryNode> parent;
+    Move move;
+    // Unmake record for UndoAction.
+    StandardChessBoard::MoveUndo undo;
+    // Board hash after the move, for repetition counting.
+    uint64_t hash = 0;
+  };
+
+  // Returns how many times the current position has occurred, including
+  // the current occurrence. The walk visits at most
+  // IrreversibleMoveCounter() + 1 positions: captures and pawn moves reset
+  // the counter, and no position from before one can ever repeat.
+  int RepetitionCount() const;
+
   // We store the start board for history to support games not starting
   // from the start position.
   StandardChessBoard start_board_;
   // We store the current board position as an optimization.
   StandardChessBoard current_board_;
 
-  // RepetitionTable records how many times the given hash exists in the history
-  // stack (including the current board).
-  // We are already indexing by board hash, so there is no need to hash that
-  // hash again, so we use a custom passthrough hasher.
-  class PassthroughHash {
-   public:
-    std::size_t operator()(uint64_t x) const {
-      return static_cast<std::size_t>(x);
-    }
-  };
-  using RepetitionTable = std::unordered_map<uint64_t, int, PassthroughHash>;
-  RepetitionTable repetitions_;
+  // Head of the history chain; null at the start position.
+  std::shared_ptr<const HistoryNode> history_chain_;
+
+  // Number of history entries restored from a snapshot. Snapshots carry
+  // position hashes but no unmake records, so UndoAction cannot step below
+  // this floor; zero for states built by play.
+  int snapshot_floor_ = 0;
+
+  // Rebuilds states from snapshots, which touches all of the above.
+  friend class ChessGame;
 };
 
 // Game object.
@@ -258,6 +290,14 @@ class ChessGame : public Game {
     return chess::InformationStateNormalizedVectorShape();
   }
   int MaxGameLength() const override { return chess::MaxGameLength(); }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
+  bool ProvidesStagedActions() const override { return true; }
+
+  // Inverse of ChessState::SerializeBinary: rebuilds the state directly
+  // from the stored boards and hash window, with no move replay.
+  std::unique_ptr<State> DeserializeStateBinary(
+      const std::string& str) const override;
 };
 
 }  // namespace chess
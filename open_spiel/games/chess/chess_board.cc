@@ -14,8 +14,12 @@
 
 #include "open_spiel/games/chess/chess_board.h"
 
+#include <algorithm>
+#include <bitset>
 #include <cctype>
+#include <cstdint>
 #include <iostream>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +28,162 @@
 
 namespace open_spiel {
 namespace chess {
+namespace {
+
+// Magic-bitboard sliding-piece attack generation for the standard 8x8 board.
+// A Bitboard has bit (y * 8 + x) set for the square at (x, y), matching
+// SquareToIndex_. For each square, the occupancy of the squares that can block
+// a rook (or bishop) is hashed to a table index by a multiply-and-shift with a
+// per-square "magic" constant, yielding the full attack set in one lookup
+// instead of four ray walks. The magics are found once, on first use, by
+// random search - sparse random numbers are tried until one hashes every
+// reachable blocker configuration without a destructive collision - so the
+// tables are correct by construction.
+using Bitboard = uint64_t;
+
+constexpr int kRookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+constexpr int kBishopDirections[4][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+
+// Attack set of a sliding piece on square index sq, by walking the given rays
+// through the given occupancy. Only used while building the tables; the hot
+// path is a table lookup.
+Bitboard SlidingAttacks(int sq, Bitboard occupancy,
+                        const int directions[4][2]) {
+  Bitboard attacks = 0;
+  for (int d = 0; d < 4; ++d) {
+    int x = sq % 8 + directions[d][0];
+    int y = sq / 8 + directions[d][1];
+    while (x >= 0 && x < 8 && y >= 0 && y < 8) {
+      Bitboard bit = Bitboard{1} << (y * 8 + x);
+      attacks |= bit;
+      if ((occupancy & bit) != 0) break;
+      x += directions[d][0];
+      y += directions[d][1];
+    }
+  }
+  return attacks;
+}
+
+// The squares whose occupancy can change the attack set from sq - the rays
+// from sq excluding the last square of each ray (a piece on the board edge
+// has nothing behind it to block).
+Bitboard RelevantBlockersMask(int sq, const int directions[4][2]) {
+  Bitboard mask = 0;
+  for (int d = 0; d < 4; ++d) {
+    int x = sq % 8 + directions[d][0];
+    int y = sq / 8 + directions[d][1];
+    while (x + directions[d][0] >= 0 && x + directions[d][0] < 8 &&
+           y + directions[d][1] >= 0 && y + directions[d][1] < 8) {
+      mask |= Bitboard{1} << (y * 8 + x);
+      x += directions[d][0];
+      y += directions[d][1];
+    }
+  }
+  return mask;
+}
+
+struct MagicEntry {
+  Bitboard mask;    // Relevant blocker squares for this square.
+  Bitboard magic;   // Multiplier hashing masked occupancy to an index.
+  int shift;        // 64 minus the number of bits in mask.
+  uint32_t offset;  // Start of this square's block in the attack table.
+};
+
+struct MagicTables {
+  MagicEntry rook[64];
+  MagicEntry bishop[64];
+  std::vector<Bitboard> attacks;
+
+  // (lsb * kLowestBitMultiplier) >> 58 is distinct for every single-bit lsb
+  // (de Bruijn sequence), which lowest_bit_index maps back to the bit's
+  // index. Verified exhaustively when the tables are built.
+  static constexpr Bitboard kLowestBitMultiplier = 0x03f79d71b4cb0a89ULL;
+  int lowest_bit_index[64];
+};
+
+void InitMagics(const int directions[4][2], std::mt19937_64* rng,
+                MagicEntry* entries, std::vector<Bitboard>* attack_table) {
+  for (int sq = 0; sq < 64; ++sq) {
+    MagicEntry& entry = entries[sq];
+    entry.mask = RelevantBlockersMask(sq, directions);
+    int bits = std::bitset<64>(entry.mask).count();
+    entry.shift = 64 - bits;
+    entry.offset = attack_table->size();
+
+    // Enumerate every subset of the mask (Carry-Rippler trick) together with
+    // its reference attack set.
+    std::vector<Bitboard> occupancies;
+    std::vector<Bitboard> reference;
+    Bitboard subset = 0;
+    do {
+      occupancies.push_back(subset);
+      reference.push_back(SlidingAttacks(sq, subset, directions));
+      subset = (subset - entry.mask) & entry.mask;
+    } while (subset != 0);
+
+    // Try sparse random multipliers until one maps every subset either to an
+    // unused index or to an index holding the same attack set (a harmless
+    // collision).
+    std::vector<Bitboard> table(size_t{1} << bits);
+    std::vector<bool> used(table.size());
+    while (true) {
+      entry.magic = (*rng)() & (*rng)() & (*rng)();
+      std::fill(used.begin(), used.end(), false);
+      bool ok = true;
+      for (size_t i = 0; i < occupancies.size() && ok; ++i) {
+        size_t index = (occupancies[i] * entry.magic) >> entry.shift;
+        if (!used[index]) {
+          used[index] = true;
+          table[index] = reference[i];
+        } else if (table[index] != reference[i]) {
+          ok = false;
+        }
+      }
+      if (ok) break;
+    }
+    attack_table->insert(attack_table->end(), table.begin(), table.end());
+  }
+}
+
+const MagicTables& GetMagicTables() {
+  static const MagicTables* const tables = []() {
+    auto* t = new MagicTables();
+    // Fixed seed so every process builds identical tables.
+    std::mt19937_64 rng(/*seed=*/2765481);
+    // 102400 rook entries plus 5248 bishop entries.
+    t->attacks.reserve(107648);
+    InitMagics(kRookDirections, &rng, t->rook, &t->attacks);
+    InitMagics(kBishopDirections, &rng, t->bishop, &t->attacks);
+    std::fill(std::begin(t->lowest_bit_index), std::end(t->lowest_bit_index),
+              -1);
+    for (int i = 0; i < 64; ++i) {
+      int key =
+          ((Bitboard{1} << i) * MagicTables::kLowestBitMultiplier) >> 58;
+      if (t->lowest_bit_index[key] != -1) {
+        SpielFatalError("Lowest-bit multiplier is not a de Bruijn sequence.");
+      }
+      t->lowest_bit_index[key] = i;
+    }
+    return t;
+  }();
+  return *tables;
+}
+
+Bitboard RookAttacks(const MagicTables& tables, int sq, Bitboard occupancy) {
+  const MagicEntry& entry = tables.rook[sq];
+  return tables
+      .attacks[entry.offset + ((occupancy & entry.mask) * entry.magic >>
+                               entry.shift)];
+}
+
+Bitboard BishopAttacks(const MagicTables& tables, int sq, Bitboard occupancy) {
+  const MagicEntry& entry = tables.bishop[sq];
+  return tables
+      .attacks[entry.offset + ((occupancy & entry.mask) * entry.magic >>
+                               entry.shift)];
+}
+
+}  // namespace
 
 bool IsMoveCharacter(char c) {
   return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
@@ -315,7 +475,8 @@ ChessBoard<kBoardSize>::ChessBoard()
       irreversible_move_counter_(0),
       move_number_(1),
       castling_rights_{{true, true}, {true, true}},
-      zobrist_hash_(0) {
+      zobrist_hash_(0),
+      occupancy_{0, 0} {
   board_.fill(kEmptyPiece);
 }
 
@@ -448,37 +609,51 @@ Square ChessBoard<kBoardSize>::find(const Piece &piece) const {
 }
 
 template <uint32_t kBoardSize>
-void ChessBoard<kBoardSize>::GenerateLegalMoves(
-    const MoveYieldFn &yield) const {
+void ChessBoard<kBoardSize>::GenerateLegalMoves(const MoveYieldFn &yield,
+                                                MoveStage stage) const {
   auto king_square = find(Piece{to_play_, PieceType::kKing});
 
-  GeneratePseudoLegalMoves([this, &king_square, &yield](const Move &move) {
-    // See if the move is legal by applying, checking whether the king is
-    // under attack, and undoing the move.
-    // TODO: Optimize this.
-    auto board_copy = *this;
-    board_copy.ApplyMove(move);
+  GeneratePseudoLegalMoves(
+      [this, &king_square, &yield](const Move &move) {
+        // See if the move is legal by applying, checking whether the king is
+        // under attack, and undoing the move.
+        // TODO: Optimize this.
+        auto board_copy = *this;
+        board_copy.ApplyMove(move);
 
-    auto ks = at(move.from).type == PieceType::kKing ? move.to : king_square;
+        auto ks =
+            at(move.from).type == PieceType::kKing ? move.to : king_square;
 
-    if (board_copy.UnderAttack(ks, to_play_)) {
-      return true;
-    } else {
-      return yield(move);
-    }
-  });
+        if (board_copy.UnderAttack(ks, to_play_)) {
+          return true;
+        } else {
+          return yield(move);
+        }
+      },
+      stage);
 }
 
 template <uint32_t kBoardSize>
-void ChessBoard<kBoardSize>::GeneratePseudoLegalMoves(
-    const MoveYieldFn &yield) const {
+void ChessBoard<kBoardSize>::GeneratePseudoLegalMoves(const MoveYieldFn &yield,
+                                                      MoveStage stage) const {
   bool generating = true;
+  const bool want_forcing = stage != MoveStage::kQuiet;
+  const bool want_quiet = stage != MoveStage::kForcing;
 
 #define YIELD(move)     \
   if (!yield(move)) {   \
     generating = false; \
   }
 
+  // Stage filter for non-pawn destinations: such a move is forcing iff it
+  // lands on an enemy piece.
+  auto filtered = [this, &yield, want_forcing, want_quiet,
+                   &generating](const Move &move) {
+    if (IsEnemy(move.to, to_play_) ? want_forcing : want_quiet) {
+      YIELD(move);
+    }
+  };
+
   for (int8_t y = 0; y < kBoardSize && generating; ++y) {
     for (int8_t x = 0; x < kBoardSize && generating; ++x) {
       Square sq{x, y};
@@ -487,62 +662,72 @@ void ChessBoard<kBoardSize>::GeneratePseudoLegalMoves(
         switch (piece.type) {
           case PieceType::kKing:
             GenerateKingDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to));
-                });
-            GenerateCastlingDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to, PieceType::kEmpty, true));
-                });
+                sq, to_play_,
+                [&filtered, &sq](const Square &to) { filtered(Move(sq, to)); });
+            // Castling never captures, so it is always quiet.
+            if (want_quiet) {
+              GenerateCastlingDestinations_(
+                  sq, to_play_, [&yield, &sq, &generating](const Square &to) {
+                    YIELD(Move(sq, to, PieceType::kEmpty, true));
+                  });
+            }
             break;
           case PieceType::kQueen:
             GenerateQueenDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to));
-                });
+                sq, to_play_,
+                [&filtered, &sq](const Square &to) { filtered(Move(sq, to)); });
             break;
           case PieceType::kRook:
             GenerateRookDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to));
-                });
+                sq, to_play_,
+                [&filtered, &sq](const Square &to) { filtered(Move(sq, to)); });
             break;
           case PieceType::kBishop:
             GenerateBishopDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to));
-                });
+                sq, to_play_,
+                [&filtered, &sq](const Square &to) { filtered(Move(sq, to)); });
             break;
           case PieceType::kKnight:
             GenerateKnightDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  YIELD(Move(sq, to));
-                });
+                sq, to_play_,
+                [&filtered, &sq](const Square &to) { filtered(Move(sq, to)); });
             break;
           case PieceType::kPawn:
-            GeneratePawnDestinations_(
-                sq, to_play_, [&yield, &sq, &generating](const Square &to) {
-                  if (IsPawnPromotionRank(to)) {
-                    YIELD(Move(sq, to, PieceType::kQueen));
-                    YIELD(Move(sq, to, PieceType::kRook));
-                    YIELD(Move(sq, to, PieceType::kBishop));
-                    YIELD(Move(sq, to, PieceType::kKnight));
-                  } else {
-                    YIELD(Move(sq, to));
-                  }
-                });
-            GeneratePawnCaptureDestinations_(
-                sq, to_play_, true, /* include enpassant */
-                [&yield, &sq, &generating](const Square &to) {
-                  if (IsPawnPromotionRank(to)) {
-                    YIELD(Move(sq, to, PieceType::kQueen));
-                    YIELD(Move(sq, to, PieceType::kRook));
-                    YIELD(Move(sq, to, PieceType::kBishop));
-                    YIELD(Move(sq, to, PieceType::kKnight));
-                  } else {
-                    YIELD(Move(sq, to));
-                  }
-                });
+            // Pawn pushes are quiet except for promotions; a pawn can only
+            // push to the promotion rank from the rank just below it, so the
+            // forcing stage skips push generation for every other pawn.
+            if (want_quiet || IsPawnPrePromotionRank(sq, to_play_)) {
+              GeneratePawnDestinations_(
+                  sq, to_play_,
+                  [&yield, &sq, &generating, want_forcing,
+                   want_quiet](const Square &to) {
+                    if (IsPawnPromotionRank(to)) {
+                      if (want_forcing) {
+                        YIELD(Move(sq, to, PieceType::kQueen));
+                        YIELD(Move(sq, to, PieceType::kRook));
+                        YIELD(Move(sq, to, PieceType::kBishop));
+                        YIELD(Move(sq, to, PieceType::kKnight));
+                      }
+                    } else if (want_quiet) {
+                      YIELD(Move(sq, to));
+                    }
+                  });
+            }
+            // Pawn captures (including en passant) are always forcing.
+            if (want_forcing) {
+              GeneratePawnCaptureDestinations_(
+                  sq, to_play_, true, /* include enpassant */
+                  [&yield, &sq, &generating](const Square &to) {
+                    if (IsPawnPromotionRank(to)) {
+                      YIELD(Move(sq, to, PieceType::kQueen));
+                      YIELD(Move(sq, to, PieceType::kRook));
+                      YIELD(Move(sq, to, PieceType::kBishop));
+                      YIELD(Move(sq, to, PieceType::kKnight));
+                    } else {
+                      YIELD(Move(sq, to));
+                    }
+                  });
+            }
             break;
           default:
             std::cerr << "Unknown piece type: " << static_cast<int>(piece.type)
@@ -907,7 +1092,7 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
   // Special cases that require adjustment -
   // 1. Castling
   if (move.is_castling) {
-    SPIEL_CHECK_EQ(moving_piece.type, PieceType::kKing);
+    SPIEL_DCHECK_EQ(moving_piece.type, PieceType::kKing);
     // We can tell which side we are castling to using "to" square.
     if (to_play_ == Color::kWhite) {
       if (move.to == Square{2, 0}) {
@@ -959,7 +1144,7 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
     } else {
       ++captured_pawn_square.y;
     }
-    SPIEL_CHECK_EQ(at(captured_pawn_square),
+    SPIEL_DCHECK_EQ(at(captured_pawn_square),
                    (Piece{OppColor(to_play_), PieceType::kPawn}));
     set_square(captured_pawn_square, kEmptyPiece);
   }
@@ -985,6 +1170,74 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
   SetToPlay(OppColor(to_play_));
 }
 
+template <uint32_t kBoardSize>
+void ChessBoard<kBoardSize>::ApplyMove(const Move &move, MoveUndo *undo) {
+  undo->move = move;
+  undo->moved_piece = at(move.from);
+  undo->captured_piece = at(move.to);
+  undo->ep_square = ep_square_;
+  for (Color color : {Color::kBlack, Color::kWhite}) {
+    undo->left_castle[ToInt(color)] =
+        CastlingRight(color, CastlingDirection::kLeft);
+    undo->right_castle[ToInt(color)] =
+        CastlingRight(color, CastlingDirection::kRight);
+  }
+  undo->irreversible_move_counter = irreversible_move_counter_;
+  undo->move_number = move_number_;
+  ApplyMove(move);
+}
+
+template <uint32_t kBoardSize>
+void ChessBoard<kBoardSize>::UndoMove(const MoveUndo &undo) {
+  // Give the move back to the side that made it, and restore the counters,
+  // en passant square and castling rights through the setters so that the
+  // Zobrist hash stays in sync.
+  SetToPlay(OppColor(to_play_));
+  SetMovenumber(undo.move_number);
+  SetIrreversibleMoveCounter(undo.irreversible_move_counter);
+  SetEpSquare(undo.ep_square);
+  for (Color color : {Color::kBlack, Color::kWhite}) {
+    SetCastlingRight(color, CastlingDirection::kLeft,
+                     undo.left_castle[ToInt(color)]);
+    SetCastlingRight(color, CastlingDirection::kRight,
+                     undo.right_castle[ToInt(color)]);
+  }
+
+  const Move &move = undo.move;
+  // Restore whatever was captured on the destination square, then put the
+  // moving piece back (which also reverses promotions). In that order because
+  // in Chess960 the king can castle in-place, making from == to.
+  if (move.to != move.from) {
+    set_square(move.to, undo.captured_piece);
+  }
+  set_square(move.from, undo.moved_piece);
+
+  if (move.is_castling) {
+    // The rook was moved next to the king; put it back in the corner.
+    if (move.to.x == 2) {
+      set_square(Square{static_cast<int8_t>(3), move.from.y}, kEmptyPiece);
+      set_square(Square{static_cast<int8_t>(0), move.from.y},
+                 Piece{to_play_, PieceType::kRook});
+    } else {
+      set_square(Square{static_cast<int8_t>(5), move.from.y}, kEmptyPiece);
+      set_square(Square{static_cast<int8_t>(7), move.from.y},
+                 Piece{to_play_, PieceType::kRook});
+    }
+  } else if (undo.moved_piece.type == PieceType::kPawn &&
+             move.from.x != move.to.x &&
+             undo.captured_piece.type == PieceType::kEmpty) {
+    // En passant - put the captured pawn back behind the destination square.
+    Square captured_pawn_square = move.to;
+    if (to_play_ == Color::kWhite) {
+      --captured_pawn_square.y;
+    } else {
+      ++captured_pawn_square.y;
+    }
+    set_square(captured_pawn_square,
+               Piece{OppColor(to_play_), PieceType::kPawn});
+  }
+}
+
 template <uint32_t kBoardSize>
 bool ChessBoard<kBoardSize>::TestApplyMove(const Move &move) {
   Color color = to_play_;
@@ -1264,20 +1517,54 @@ template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateRookDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  GenerateRayDestinations_(sq, color, {1, 0}, yield);
-  GenerateRayDestinations_(sq, color, {-1, 0}, yield);
-  GenerateRayDestinations_(sq, color, {0, 1}, yield);
-  GenerateRayDestinations_(sq, color, {0, -1}, yield);
+  if constexpr (kBoardSize == 8) {
+    const MagicTables &tables = GetMagicTables();
+    Bitboard attacks =
+        RookAttacks(tables, SquareToIndex_(sq),
+                    occupancy_[0] | occupancy_[1]) &
+        ~occupancy_[ToInt(color)];
+    while (attacks != 0) {
+      Bitboard lsb = attacks & (~attacks + 1);
+      attacks ^= lsb;
+      int index = tables.lowest_bit_index[(lsb *
+                                           MagicTables::kLowestBitMultiplier) >>
+                                          58];
+      yield(Square{static_cast<int8_t>(index % 8),
+                   static_cast<int8_t>(index / 8)});
+    }
+  } else {
+    GenerateRayDestinations_(sq, color, {1, 0}, yield);
+    GenerateRayDestinations_(sq, color, {-1, 0}, yield);
+    GenerateRayDestinations_(sq, color, {0, 1}, yield);
+    GenerateRayDestinations_(sq, color, {0, -1}, yield);
+  }
 }
 
 template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateBishopDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  GenerateRayDestinations_(sq, color, {1, 1}, yield);
-  GenerateRayDestinations_(sq, color, {-1, 1}, yield);
-  GenerateRayDestinations_(sq, color, {1, -1}, yield);
-  GenerateRayDestinations_(sq, color, {-1, -1}, yield);
+  if constexpr (kBoardSize == 8) {
+    const MagicTables &tables = GetMagicTables();
+    Bitboard attacks =
+        BishopAttacks(tables, SquareToIndex_(sq),
+                      occupancy_[0] | occupancy_[1]) &
+        ~occupancy_[ToInt(color)];
+    while (attacks != 0) {
+      Bitboard lsb = attacks & (~attacks + 1);
+      attacks ^= lsb;
+      int index = tables.lowest_bit_index[(lsb *
+                                           MagicTables::kLowestBitMultiplier) >>
+                                          58];
+      yield(Square{static_cast<int8_t>(index % 8),
+                   static_cast<int8_t>(index / 8)});
+    }
+  } else {
+    GenerateRayDestinations_(sq, color, {1, 1}, yield);
+    GenerateRayDestinations_(sq, color, {-1, 1}, yield);
+    GenerateRayDestinations_(sq, color, {1, -1}, yield);
+    GenerateRayDestinations_(sq, color, {-1, -1}, yield);
+  }
 }
 
 template <uint32_t kBoardSize>
@@ -1445,6 +1732,17 @@ void ChessBoard<kBoardSize>::set_square(Square sq, Piece piece) {
   zobrist_hash_ ^= kZobristValues[position][static_cast<int>(piece.color)]
                                  [static_cast<int>(piece.type)];
 
+  // Keep the occupancy bitboards in sync when squares fit in 64 bits.
+  if constexpr (kBoardSize * kBoardSize <= 64) {
+    uint64_t bit = uint64_t{1} << position;
+    if (current_piece.color != Color::kEmpty) {
+      occupancy_[ToInt(current_piece.color)] &= ~bit;
+    }
+    if (piece.color != Color::kEmpty) {
+      occupancy_[ToInt(piece.color)] |= bit;
+    }
+  }
+
   board_[position] = piece;
 }
 
@@ -56,6 +56,16 @@ enum class CastlingDirection { kLeft, kRight };
 
 int ToInt(CastlingDirection dir);
 
+// Which subset of moves to generate. Staged generation lets a searcher ask
+// for the forcing moves (captures and promotions) first and only pay for
+// generating and legality-testing the quiet moves if it gets that far,
+// which at typical cut rates it usually does not.
+enum class MoveStage {
+  kAll,      // Every move.
+  kForcing,  // Captures (including en passant) and promotions.
+  kQuiet,    // The complement of kForcing.
+};
+
 enum class PieceType : int8_t {
   kEmpty = 0,
   kKing = 1,
@@ -259,8 +269,21 @@ class ChessBoard {
   // For performance reasons, we do not guarantee that no more moves will be
   // generated if yield returns false. It is only for optimization.
   using MoveYieldFn = std::function<bool(const Move&)>;
-  void GenerateLegalMoves(const MoveYieldFn& yield) const;
-  void GeneratePseudoLegalMoves(const MoveYieldFn& yield) const;
+  void GenerateLegalMoves(const MoveYieldFn& yield) const {
+    GenerateLegalMoves(yield, MoveStage::kAll);
+  }
+  void GeneratePseudoLegalMoves(const MoveYieldFn& yield) const {
+    GeneratePseudoLegalMoves(yield, MoveStage::kAll);
+  }
+
+  // Staged variants: generate only the moves in the given stage. Every move
+  // is in exactly one of kForcing and kQuiet, so the two stages together
+  // yield the same moves as kAll (kAll preserves the historical order;
+  // within a single stage moves keep their relative order). The kForcing
+  // stage skips quiet-move generation and its legality tests entirely.
+  void GenerateLegalMoves(const MoveYieldFn& yield, MoveStage stage) const;
+  void GeneratePseudoLegalMoves(const MoveYieldFn& yield,
+                                MoveStage stage) const;
 
   bool HasLegalMoves() const {
     bool found = false;
@@ -301,6 +324,28 @@ class ChessBoard {
 
   void ApplyMove(const Move& move);
 
+  // Everything ApplyMove changes besides the squares implied by the move
+  // itself, captured so the move can be reversed with UndoMove.
+  struct MoveUndo {
+    Move move;
+    Piece moved_piece;     // As it was before any promotion.
+    Piece captured_piece;  // Contents of move.to before the move.
+    Square ep_square;
+    bool left_castle[2];   // Indexed by ToInt(color).
+    bool right_castle[2];
+    int32_t irreversible_move_counter;
+    int32_t move_number;
+  };
+
+  // Like ApplyMove, but fills *undo first so the move can be reversed with
+  // UndoMove. This supports make/unmake traversals on a single board instead
+  // of copying the whole board per node.
+  void ApplyMove(const Move& move, MoveUndo* undo);
+
+  // Reverses the most recent not-yet-undone ApplyMove, given the record it
+  // filled in. Undo records must be applied in reverse order of the moves.
+  void UndoMove(const MoveUndo& undo);
+
   // Applies a pseudo-legal move and returns whether it's legal. This avoids
   // applying and copying the whole board once for legality testing, and once
   // for actually applying the move.
@@ -336,6 +381,12 @@ class ChessBoard {
             (our_color == Color::kBlack && sq.y == (kBoardSize - 2)));
   }
 
+  /* Whether a pawn of our_color on sq is a single push away from promoting. */
+  static bool IsPawnPrePromotionRank(const Square& sq, Color our_color) {
+    return ((our_color == Color::kWhite && sq.y == (kBoardSize - 2)) ||
+            (our_color == Color::kBlack && sq.y == 1));
+  }
+
   static bool IsPawnPromotionRank(const Square& sq) {
     // No need to test for color here because a pawn can't be on the "wrong"
     // promotion rank.
@@ -442,6 +493,12 @@ class ChessBoard {
   } castling_rights_[2];
 
   uint64_t zobrist_hash_;
+
+  // Per-colour occupancy bitboards (bit SquareToIndex_(sq) is set iff a piece
+  // of that colour is on sq). Maintained incrementally by set_square for
+  // boards whose squares fit in 64 bits; they drive the magic-bitboard
+  // sliding move generation for the standard 8x8 board.
+  uint64_t occupancy_[2];
 };
 
 template <uint32_t kBoardSize>
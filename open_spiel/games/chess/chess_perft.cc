@@ -0,0 +1,130 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Perft driver for the chess move generator.
+//
+// Perft(d) counts the leaf nodes of the legal move tree to depth d. The
+// counts for a set of standard positions are published, so running this
+// after any change to move generation in chess_board.cc gives both a
+// correctness check (a count mismatch means the change is wrong) and a
+// benchmark (the reported nodes/second is the before/after number).
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/games/chess/chess_board.h"
+#include "open_spiel/spiel_utils.h"
+
+ABSL_FLAG(int, max_depth, 5, "Deepest perft level to run per position.");
+ABSL_FLAG(std::string, fen, "",
+          "If set, run on this position only, without checking counts.");
+
+namespace open_spiel {
+namespace chess {
+namespace {
+
+struct PerftPosition {
+  std::string name;
+  std::string fen;
+  // expected_counts[d] is the expected value of Perft(d + 1).
+  std::vector<uint64_t> expected_counts;
+};
+
+// Standard positions with published perft counts; see
+// https://www.chessprogramming.org/Perft_Results.
+std::vector<PerftPosition> StandardPositions() {
+  return {
+      {"initial position",
+       "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+       {20, 400, 8902, 197281, 4865609}},
+      {"kiwipete",
+       "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+       {48, 2039, 97862, 4085603}},
+      {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+       {14, 191, 2812, 43238, 674624}},
+      {"position 4",
+       "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+       {6, 264, 9467, 422333}},
+      {"position 5",
+       "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+       {44, 1486, 62379, 2103487}},
+  };
+}
+
+uint64_t Perft(const StandardChessBoard& board, int depth) {
+  std::vector<Move> moves;
+  board.GenerateLegalMoves([&moves](const Move& move) {
+    moves.push_back(move);
+    return true;
+  });
+  if (depth <= 1) return moves.size();
+  uint64_t nodes = 0;
+  for (const Move& move : moves) {
+    StandardChessBoard child = board;
+    child.ApplyMove(move);
+    nodes += Perft(child, depth - 1);
+  }
+  return nodes;
+}
+
+void RunPosition(const PerftPosition& position, int max_depth) {
+  auto board = StandardChessBoard::BoardFromFEN(position.fen);
+  if (!board) {
+    SpielFatalError("Invalid FEN: " + position.fen);
+  }
+  std::cout << position.name << " (" << position.fen << ")" << std::endl;
+  for (int depth = 1; depth <= max_depth; ++depth) {
+    if (!position.expected_counts.empty() &&
+        depth > static_cast<int>(position.expected_counts.size())) {
+      break;
+    }
+    absl::Time start = absl::Now();
+    uint64_t nodes = Perft(*board, depth);
+    double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+    std::cout << "  perft(" << depth << ") = " << nodes;
+    if (seconds > 0) {
+      std::cout << " ("
+                << static_cast<uint64_t>(static_cast<double>(nodes) / seconds)
+                << " nodes/sec)";
+    }
+    std::cout << std::endl;
+    if (!position.expected_counts.empty()) {
+      SPIEL_CHECK_EQ(nodes, position.expected_counts[depth - 1]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace chess
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  int max_depth = absl::GetFlag(FLAGS_max_depth);
+  std::string fen = absl::GetFlag(FLAGS_fen);
+  if (!fen.empty()) {
+    open_spiel::chess::RunPosition({"custom position", fen, {}}, max_depth);
+    return 0;
+  }
+  for (const auto& position : open_spiel::chess::StandardPositions()) {
+    open_spiel::chess::RunPosition(position, max_depth);
+  }
+  return 0;
+}
@@ -14,7 +14,9 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel.h"
@@ -67,6 +69,54 @@ void MoveGenerationTests() {
   SPIEL_CHECK_EQ(CountNumLegalMoves(start_pos), 20);
 }
 
+// Checks that the forcing and quiet stages partition the legal actions, and
+// that the forcing stage is exactly the captures and promotions.
+void CheckStagedPartition(const ChessState& state) {
+  std::vector<Action> all = state.LegalActions();
+  std::vector<Action> forcing = state.LegalActions(ActionStage::kForcing);
+  std::vector<Action> quiet = state.LegalActions(ActionStage::kQuiet);
+
+  std::vector<Action> merged = forcing;
+  merged.insert(merged.end(), quiet.begin(), quiet.end());
+  std::sort(merged.begin(), merged.end());
+  SPIEL_CHECK_TRUE(merged == all);
+
+  const StandardChessBoard& board = state.Board();
+  auto is_forcing = [&board](Action action) {
+    Move move = ActionToMove(action);
+    // Captures include en passant, where the destination square is empty
+    // but the pawn still changes file.
+    bool capture = board.IsEnemy(move.to, board.ToPlay()) ||
+                   (board.at(move.from).type == PieceType::kPawn &&
+                    move.from.x != move.to.x);
+    return capture || move.promotion_type != PieceType::kEmpty;
+  };
+  for (Action action : forcing) SPIEL_CHECK_TRUE(is_forcing(action));
+  for (Action action : quiet) SPIEL_CHECK_FALSE(is_forcing(action));
+}
+
+void StagedMoveGenerationTests() {
+  std::shared_ptr<const Game> game = LoadGame("chess");
+
+  // Start position: every move is quiet.
+  ChessState start(game);
+  SPIEL_CHECK_TRUE(start.LegalActions(ActionStage::kForcing).empty());
+  CheckStagedPartition(start);
+
+  // A middlegame position with several captures available.
+  CheckStagedPartition(ChessState(
+      game, "r1bqkbnr/ppp2ppp/2np4/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq -"));
+
+  // En passant: the capture lands on an empty square.
+  CheckStagedPartition(ChessState(
+      game, "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"));
+
+  // Promotion pushes are forcing even though nothing is captured.
+  ChessState promotion(game, "8/P6k/8/8/8/8/7K/8 w - - 0 1");
+  SPIEL_CHECK_EQ(promotion.LegalActions(ActionStage::kForcing).size(), 4);
+  CheckStagedPartition(promotion);
+}
+
 void TerminalReturnTests() {
   std::shared_ptr<const Game> game = LoadGame("chess");
   ChessState checkmate_state(
@@ -111,6 +161,72 @@ void UndoTests() {
             "rnbqkbnr/pppp1p1p/6P1/4p3/8/8/PPPPP1PP/RNBQKBNR b KQkq - 0 2");
 }
 
+void ZobristHashTests() {
+  // The hash is maintained incrementally (set_square, SetToPlay, SetEpSquare
+  // and SetCastlingRight each XOR their contribution), so after every kind of
+  // move it must match the hash of the same position built freshly from FEN.
+  std::shared_ptr<const Game> game = LoadGame("chess");
+  ChessState state(game);
+  uint64_t initial_hash = state.Board().HashValue();
+
+  // Double pawn moves (en passant squares), captures, castling, and losing
+  // castling rights by moving a rook.
+  for (const char* san :
+       {"e4", "e5", "Nf3", "Nc6", "Bb5", "a6", "Bxc6", "dxc6", "O-O", "Rb8"}) {
+    ApplySANMove(san, &state);
+    auto roundtrip = StandardChessBoard::BoardFromFEN(state.Board().ToFEN());
+    SPIEL_CHECK_TRUE(roundtrip);
+    SPIEL_CHECK_EQ(state.Board().HashValue(), roundtrip->HashValue());
+  }
+
+  // Undoing back to the start must restore the initial hash exactly.
+  while (!state.History().empty()) {
+    std::vector<Action> history = state.History();
+    state.UndoAction(ColorToPlayer(OppColor(state.Board().ToPlay())),
+                     history.back());
+  }
+  SPIEL_CHECK_EQ(state.Board().HashValue(), initial_hash);
+}
+
+void SnapshotSerializationTests() {
+  // A snapshot-restored state must be indistinguishable from the original
+  // going forward: same position, same legal actions, and the same
+  // repetition accounting for positions still inside the repetition
+  // window.
+  std::shared_ptr<const Game> game = LoadGame("chess");
+  ChessState state(game);
+  // Shuffle the knights back and forth to stack up repetitions, then make
+  // some real moves.
+  for (const char* san : {"Nf3", "Nf6", "Ng1", "Ng8", "Nf3", "Nf6", "e4",
+                          "e5", "Nc3", "Nc6"}) {
+    ApplySANMove(san, &state);
+  }
+
+  const std::string snapshot = state.SerializeBinary();
+  std::unique_ptr<State> restored = game->DeserializeStateBinary(snapshot);
+  SPIEL_CHECK_EQ(restored->ToString(), state.ToString());
+  SPIEL_CHECK_EQ(restored->History(), state.History());
+  SPIEL_CHECK_EQ(restored->CurrentPlayer(), state.CurrentPlayer());
+  SPIEL_CHECK_TRUE(restored->LegalActions() == state.LegalActions());
+
+  // Walk both states into a threefold repetition; the restored one must
+  // declare the draw on the same move, which requires the hash window from
+  // the snapshot.
+  ChessState* restored_chess = dynamic_cast<ChessState*>(restored.get());
+  SPIEL_CHECK_TRUE(restored_chess != nullptr);
+  for (const char* san : {"Ng1", "Ng8", "Nf3", "Nf6", "Ng1", "Ng8", "Nf3",
+                          "Nf6"}) {
+    SPIEL_CHECK_EQ(restored->IsTerminal(), state.IsTerminal());
+    ApplySANMove(san, &state);
+    ApplySANMove(san, restored_chess);
+    SPIEL_CHECK_EQ(restored_chess->Board().HashValue(),
+                   state.Board().HashValue());
+  }
+  SPIEL_CHECK_TRUE(state.IsTerminal());
+  SPIEL_CHECK_TRUE(restored->IsTerminal());
+  SPIEL_CHECK_TRUE(restored->Returns() == state.Returns());
+}
+
 double ValueAt(const std::vector<double>& v, const std::vector<int>& shape,
                int plane, int x, int y) {
   return v[plane * shape[1] * shape[2] + y * shape[2] + x];
@@ -221,7 +337,10 @@ void InformationStateVectorTests() {
 int main(int argc, char** argv) {
   open_spiel::chess::BasicChessTests();
   open_spiel::chess::MoveGenerationTests();
+  open_spiel::chess::StagedMoveGenerationTests();
   open_spiel::chess::UndoTests();
+  open_spiel::chess::ZobristHashTests();
+  open_spiel::chess::SnapshotSerializationTests();
   open_spiel::chess::TerminalReturnTests();
   open_spiel::chess::InformationStateVectorTests();
 }
@@ -32,42 +32,45 @@ constexpr int kDefaultEpisodeLength = 20;
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"coin_game",
-    /*long_name=*/"The Coin Game",
-    GameType::Dynamics::kSequential,
-    // Getting a NewInitialState randomly initializes player and coin positions
-    // and player preferences, but from that point on no chance nodes are
-    // involved.
-    GameType::ChanceMode::kExplicitStochastic,
-    // Imperfect information game because players only know their own preferred
-    // coin.
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/1,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {
-        {"players", GameParameter(kDefaultPlayers)},
-        {"rows", GameParameter(kDefaultRows)},
-        {"columns", GameParameter(kDefaultColumns)},
-        {"episode_length", GameParameter(kDefaultEpisodeLength)},
-        // Number of extra coin colors to use apart from the
-        // players' preferred color.
-        {"num_extra_coin_colors", GameParameter(kDefaultExtraCoinColors)},
-        {"num_coins_per_color", GameParameter(kDefaultCoinsPerColor)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"coin_game",
+      /*long_name=*/"The Coin Game",
+      GameType::Dynamics::kSequential,
+      // Getting a NewInitialState randomly initializes player and coin positions
+      // and player preferences, but from that point on no chance nodes are
+      // involved.
+      GameType::ChanceMode::kExplicitStochastic,
+      // Imperfect information game because players only know their own preferred
+      // coin.
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/1,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {
+          {"players", GameParameter(kDefaultPlayers)},
+          {"rows", GameParameter(kDefaultRows)},
+          {"columns", GameParameter(kDefaultColumns)},
+          {"episode_length", GameParameter(kDefaultEpisodeLength)},
+          // Number of extra coin colors to use apart from the
+          // players' preferred color.
+          {"num_extra_coin_colors", GameParameter(kDefaultExtraCoinColors)},
+          {"num_coins_per_color", GameParameter(kDefaultCoinsPerColor)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new CoinGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("coin_game", GetGameType, Factory);
 
 std::string GamePhaseToString(GamePhase phase) {
   switch (phase) {
@@ -444,7 +447,7 @@ double CoinGame::MaxUtility() const { return std::pow(TotalCoins(), 2); }
 double CoinGame::MinUtility() const { return -MaxUtility(); }
 
 CoinGame::CoinGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_players_(ParameterValue<int>("players")),
       num_rows_(ParameterValue<int>("rows")),
       num_columns_(ParameterValue<int>("columns")),
@@ -23,28 +23,31 @@ namespace connect_four {
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"connect_four",
-    /*long_name=*/"Connect Four",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"connect_four",
+      /*long_name=*/"Connect Four",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new ConnectFourGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("connect_four", GetGameType, Factory);
 
 CellState PlayerToState(Player player) {
   switch (player) {
@@ -70,14 +73,40 @@ std::string StateToString(CellState state) {
       return "This will never return.";
   }
 }
-}  // namespace
 
-CellState& ConnectFourState::CellAt(int row, int col) {
-  return board_[row * kCols + col];
+// Each column occupies kRows + 1 consecutive bits of a bitboard; the top bit
+// of every column stays empty so that shifted copies of a bitboard never
+// spill into a neighbouring column.
+constexpr int kBitsPerCol = kRows + 1;
+
+constexpr uint64_t ColumnMask(int col) {
+  return ((uint64_t{1} << kRows) - 1) << (col * kBitsPerCol);
+}
+
+constexpr uint64_t FullBoardMask() {
+  uint64_t mask = 0;
+  for (int col = 0; col < kCols; ++col) mask |= ColumnMask(col);
+  return mask;
 }
 
+constexpr uint64_t CellMask(int row, int col) {
+  return uint64_t{1} << (col * kBitsPerCol + row);
+}
+}  // namespace
+
 CellState ConnectFourState::CellAt(int row, int col) const {
-  return board_[row * kCols + col];
+  uint64_t mask = CellMask(row, col);
+  if (bitboard_[0] & mask) return CellState::kCross;
+  if (bitboard_[1] & mask) return CellState::kNought;
+  return CellState::kEmpty;
+}
+
+void ConnectFourState::SetCellAt(int row, int col, CellState state) {
+  uint64_t mask = CellMask(row, col);
+  bitboard_[0] &= ~mask;
+  bitboard_[1] &= ~mask;
+  if (state == CellState::kCross) bitboard_[0] |= mask;
+  if (state == CellState::kNought) bitboard_[1] |= mask;
 }
 
 int ConnectFourState::CurrentPlayer() const {
@@ -89,10 +118,12 @@ int ConnectFourState::CurrentPlayer() const {
 }
 
 void ConnectFourState::DoApplyAction(Action move) {
-  SPIEL_CHECK_EQ(CellAt(kRows - 1, move), CellState::kEmpty);
-  int row = 0;
-  while (CellAt(row, move) != CellState::kEmpty) ++row;
-  CellAt(row, move) = PlayerToState(CurrentPlayer());
+  SPIEL_DCHECK_EQ(CellAt(kRows - 1, move), CellState::kEmpty);
+  // Columns fill from the bottom, so adding the column's bottom bit to the
+  // combined board carries up to the first empty cell of that column.
+  uint64_t both = bitboard_[0] | bitboard_[1];
+  bitboard_[current_player_] |=
+      (both + CellMask(0, move)) & ColumnMask(move);
 
   if (HasLine(current_player_)) {
     outcome_ = static_cast<Outcome>(current_player_);
@@ -113,53 +144,39 @@ std::vector<Action> ConnectFourState::LegalActions() const {
   return moves;
 }
 
+std::vector<int> ConnectFourState::LegalActionsMask() const {
+  // Actions are columns, so the top row of the board is the mask.
+  std::vector<int> mask(kCols, 0);
+  if (IsTerminal()) return mask;
+  for (int col = 0; col < kCols; ++col) {
+    if (CellAt(kRows - 1, col) == CellState::kEmpty) mask[col] = 1;
+  }
+  return mask;
+}
+
 std::string ConnectFourState::ActionToString(Player player,
                                              Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), action_id);
 }
 
-bool ConnectFourState::HasLineFrom(Player player, int row, int col) const {
-  return HasLineFromInDirection(player, row, col, 0, 1) ||
-         HasLineFromInDirection(player, row, col, -1, -1) ||
-         HasLineFromInDirection(player, row, col, -1, 0) ||
-         HasLineFromInDirection(player, row, col, -1, 1);
-}
-
-bool ConnectFourState::HasLineFromInDirection(Player player, int row, int col,
-                                              int drow, int dcol) const {
-  if (row + 3 * drow >= kRows || col + 3 * dcol >= kCols ||
-      row + 3 * drow < 0 || col + 3 * dcol < 0)
-    return false;
-  CellState c = PlayerToState(player);
-  for (int i = 0; i < 4; ++i) {
-    if (CellAt(row, col) != c) return false;
-    row += drow;
-    col += dcol;
-  }
-  return true;
-}
-
 bool ConnectFourState::HasLine(Player player) const {
-  CellState c = PlayerToState(player);
-  for (int col = 0; col < kCols; ++col) {
-    for (int row = 0; row < kRows; ++row) {
-      if (CellAt(row, col) == c && HasLineFrom(player, row, col)) return true;
-    }
+  // A line of four exists iff the bitboard still has a set bit after being
+  // intersected with itself shifted by one, two and three steps along one of
+  // the four directions: vertical, horizontal and the two diagonals.
+  uint64_t bb = bitboard_[player];
+  for (int shift : {1, kBitsPerCol - 1, kBitsPerCol, kBitsPerCol + 1}) {
+    uint64_t pairs = bb & (bb >> shift);
+    if (pairs & (pairs >> (2 * shift))) return true;
   }
   return false;
 }
 
 bool ConnectFourState::IsFull() const {
-  for (int col = 0; col < kCols; ++col) {
-    if (CellAt(kRows - 1, col) == CellState::kEmpty) return false;
-  }
-  return true;
+  return (bitboard_[0] | bitboard_[1]) == FullBoardMask();
 }
 
 ConnectFourState::ConnectFourState(std::shared_ptr<const Game> game)
-    : State(game) {
-  std::fill(begin(board_), end(board_), CellState::kEmpty);
-}
+    : State(game) {}
 
 std::string ConnectFourState::ToString() const {
   std::string str;
@@ -171,6 +188,22 @@ std::string ConnectFourState::ToString() const {
   }
   return str;
 }
+std::string ConnectFourState::CanonicalString() const {
+  // The board's only symmetry is the left-right mirror; render both
+  // orientations and keep the smaller one.
+  std::string str;
+  std::string mirrored;
+  for (int row = kRows - 1; row >= 0; --row) {
+    for (int col = 0; col < kCols; ++col) {
+      str.append(StateToString(CellAt(row, col)));
+      mirrored.append(StateToString(CellAt(row, kCols - 1 - col)));
+    }
+    str.append("\n");
+    mirrored.append("\n");
+  }
+  return std::min(str, mirrored);
+}
+
 bool ConnectFourState::IsTerminal() const {
   return outcome_ != Outcome::kUnknown;
 }
@@ -195,7 +228,8 @@ void ConnectFourState::InformationStateAsNormalizedVector(
   values->resize(kNumCells * kCellStates);
   std::fill(values->begin(), values->end(), 0.);
   for (int cell = 0; cell < kNumCells; ++cell) {
-    (*values)[kNumCells * static_cast<int>(board_[cell]) + cell] = 1.0;
+    CellState state = CellAt(cell / kCols, cell % kCols);
+    (*values)[kNumCells * static_cast<int>(state) + cell] = 1.0;
   }
 }
 
@@ -206,7 +240,7 @@ std::unique_ptr<State> ConnectFourState::Clone() const {
 std::string ConnectFourState::Serialize() const { return ToString(); }
 
 ConnectFourGame::ConnectFourGame(const GameParameters& params)
-    : Game(kGameType, params) {}
+    : Game(GetGameType(), params) {}
 
 std::unique_ptr<State> ConnectFourGame::DeserializeState(
     const std::string& str) const {
@@ -223,15 +257,15 @@ ConnectFourState::ConnectFourState(std::shared_ptr<const Game> game,
   for (const char ch : str) {
     switch (ch) {
       case '.':
-        CellAt(r, c) = CellState::kEmpty;
+        SetCellAt(r, c, CellState::kEmpty);
         break;
       case 'x':
         ++xs;
-        CellAt(r, c) = CellState::kCross;
+        SetCellAt(r, c, CellState::kCross);
         break;
       case 'o':
         ++os;
-        CellAt(r, c) = CellState::kNought;
+        SetCellAt(r, c, CellState::kNought);
         break;
     }
     if (ch == '.' || ch == 'x' || ch == 'o') {
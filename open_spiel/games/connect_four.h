@@ -16,12 +16,14 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_H_
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "open_spiel/spiel.h"
+#include "open_spiel/tensor_shape.h"
 
 // Simple game of Connect Four
 // https://en.wikipedia.org/wiki/Connect_Four
@@ -42,6 +44,9 @@ inline constexpr int kNumCells = kRows * kCols;
 inline constexpr int kCellStates =
     1 + kNumPlayers;  // player 0, player 1, empty
 
+// Compile-time information state tensor shape (see open_spiel/tensor_shape.h).
+using InformationStateShape = TensorShape<kCellStates, kRows, kCols>;
+
 // Outcome of the game.
 enum class Outcome {
   kPlayer1 = 0,
@@ -67,6 +72,7 @@ class ConnectFourState : public State {
 
   Player CurrentPlayer() const override;
   std::vector<Action> LegalActions() const override;
+  std::vector<int> LegalActionsMask() const override;
   std::string ActionToString(Player player, Action action_id) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
@@ -77,20 +83,34 @@ class ConnectFourState : public State {
   std::unique_ptr<State> Clone() const override;
   std::string Serialize() const override;
 
+  // Symmetry-reduced key: the board and its left-right mirror share it.
+  std::string CanonicalString() const override;
+
+  // Cheap transposition key mixing the two bitboards (the side to move
+  // follows from the piece counts).
+  uint64_t HashValue() const override {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t bits : bitboard_) {
+      hash ^= bits;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
  protected:
   void DoApplyAction(Action move) override;
 
  private:
-  CellState& CellAt(int row, int col);
   CellState CellAt(int row, int col) const;
+  void SetCellAt(int row, int col, CellState state);
   bool HasLine(Player player) const;  // Does this player have a line?
-  bool HasLineFrom(Player player, int row, int col) const;
-  bool HasLineFromInDirection(Player player, int row, int col, int drow,
-                              int dcol) const;
   bool IsFull() const;         // Is the board full?
   Player current_player_ = 0;  // Player zero goes first
   Outcome outcome_ = Outcome::kUnknown;
-  std::array<CellState, kNumCells> board_;
+  // One bitboard per player, with bit (col * (kRows + 1) + row) set iff that
+  // player has a piece on (row, col). The extra sentinel bit per column keeps
+  // the shift-based line detection from wrapping between columns.
+  std::array<uint64_t, kNumPlayers> bitboard_ = {{0, 0}};
 };
 
 // Game object.
@@ -109,9 +129,11 @@ class ConnectFourGame : public Game {
     return std::shared_ptr<const Game>(new ConnectFourGame(*this));
   }
   std::vector<int> InformationStateNormalizedVectorShape() const override {
-    return {kCellStates, kRows, kCols};
+    return InformationStateShape::AsVector();
   }
   int MaxGameLength() const override { return kNumCells; }
+  bool ProvidesCanonicalForm() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
   std::unique_ptr<State> DeserializeState(
       const std::string& str) const override;
 };
@@ -130,6 +152,12 @@ inline std::ostream& operator<<(std::ostream& stream, const CellState& state) {
 }
 
 }  // namespace connect_four
+
+template <>
+struct InformationStateTensorTraits<connect_four::ConnectFourGame> {
+  using Shape = connect_four::InformationStateShape;
+};
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_H_
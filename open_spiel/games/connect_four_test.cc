@@ -83,6 +83,26 @@ void Benchmark() {
   testing::RandomSimBenchmark("connect_four", 10000);
 }
 
+// Dropping into mirrored columns must land on the same canonical form;
+// breaking the mirror symmetry must change it.
+void CanonicalFormTest() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  SPIEL_CHECK_TRUE(game->ProvidesCanonicalForm());
+
+  const std::vector<Action> columns = {3, 2, 5, 0, 1};
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::unique_ptr<State> mirrored = game->NewInitialState();
+  for (Action column : columns) {
+    state->ApplyAction(column);
+    mirrored->ApplyAction(kCols - 1 - column);
+    SPIEL_CHECK_EQ(state->CanonicalString(), mirrored->CanonicalString());
+    SPIEL_CHECK_EQ(state->CanonicalHash(), mirrored->CanonicalHash());
+  }
+  state->ApplyAction(6);
+  mirrored->ApplyAction(6);
+  SPIEL_CHECK_NE(state->CanonicalString(), mirrored->CanonicalString());
+}
+
 }  // namespace
 }  // namespace connect_four
 }  // namespace open_spiel
@@ -93,4 +113,5 @@ int main(int argc, char **argv) {
   open_spiel::connect_four::BasicSerializationTest();
   open_spiel::connect_four::DeserializeDraw();
   open_spiel::connect_four::Benchmark();
+  open_spiel::connect_four::CanonicalFormTest();
 }
@@ -61,28 +61,31 @@ constexpr std::array<int, 4> row_offsets = {{-1, 0, 1, 0}};
 constexpr std::array<int, 4> col_offsets = {{0, 1, 0, -1}};
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"coop_box_pushing",
-    /*long_name=*/"Cooperative Box Pushing",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kRewards,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"horizon", GameParameter(kDefaultHorizon)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"coop_box_pushing",
+      /*long_name=*/"Cooperative Box Pushing",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kRewards,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"horizon", GameParameter(kDefaultHorizon)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new CoopBoxPushingGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("coop_box_pushing", GetGameType, Factory);
 
 ActionType ToAction(Action action) {
   switch (action) {
@@ -470,7 +473,7 @@ std::unique_ptr<State> CoopBoxPushingState::Clone() const {
 }
 
 CoopBoxPushingGame::CoopBoxPushingGame(const GameParameters& params)
-    : SimMoveGame(kGameType, params),
+    : SimMoveGame(GetGameType(), params),
       horizon_(ParameterValue<int>("horizon")) {}
 
 std::vector<int> CoopBoxPushingGame::InformationStateNormalizedVectorShape()
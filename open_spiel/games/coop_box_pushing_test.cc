@@ -27,6 +27,7 @@ void BasicCoopBoxPushingTests() {
   testing::LoadGameTest("coop_box_pushing");
   testing::ChanceOutcomesTest(*LoadGame("coop_box_pushing"));
   testing::RandomSimTest(*LoadGame("coop_box_pushing"), 100);
+  testing::ReturnsCostTest(*LoadGame("coop_box_pushing"));
 }
 
 }  // namespace
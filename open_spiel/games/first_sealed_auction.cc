@@ -23,35 +23,38 @@ namespace first_sealed_auction {
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"first_sealed_auction",
-    /*long_name=*/"First-Price Sealed-Bid Auction",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"players", GameParameter(kDefaultPlayers)},
-        {"max_value", GameParameter(kDefaultMaxValue)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"first_sealed_auction",
+      /*long_name=*/"First-Price Sealed-Bid Auction",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"players", GameParameter(kDefaultPlayers)},
+          {"max_value", GameParameter(kDefaultMaxValue)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new FPSBAGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("first_sealed_auction", GetGameType, Factory);
 }  // namespace
 
 FPSBAGame::FPSBAGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_players_(ParameterValue<int>("players" )),
       max_value_(ParameterValue<int>("max_value")) {}
 
@@ -25,33 +25,36 @@ namespace go {
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"go",
-    /*long_name=*/"Go",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"komi", GameParameter(7.5)},
-        {"board_size", GameParameter(19)},
-        {"handicap", GameParameter(0)},
-    },
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"go",
+      /*long_name=*/"Go",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"komi", GameParameter(7.5)},
+          {"board_size", GameParameter(19)},
+          {"handicap", GameParameter(0)},
+      },
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new GoGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("go", GetGameType, Factory);
 
 std::vector<GoPoint> HandicapStones(int num_handicap) {
   if (num_handicap < 2 || num_handicap > 9) return {};
@@ -95,24 +98,30 @@ std::string GoState::Observation(int player) const { return ToString(); }
 
 void GoState::ObservationAsNormalizedVector(int player,
                                             std::vector<double>* values) const {
+  int num_cells = board_.board_size() * board_.board_size();
+  values->resize(num_cells * (CellStates() + 1));
+  ObservationAsNormalizedVector(player, values->data());
+}
+
+void GoState::ObservationAsNormalizedVector(int player, double* buffer) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   int num_cells = board_.board_size() * board_.board_size();
-  values->resize(num_cells * (CellStates() + 1));
-  std::fill(values->begin(), values->end(), 0.);
+  int size = num_cells * (CellStates() + 1);
+  std::fill(buffer, buffer + size, 0.);
 
   // Add planes: black, white, empty.
   int cell = 0;
   for (GoPoint p : BoardPoints(board_.board_size())) {
     int color_val = static_cast<int>(board_.PointColor(p));
-    (*values)[num_cells * color_val + cell] = 1.0;
+    buffer[num_cells * color_val + cell] = 1.0;
     ++cell;
   }
   SPIEL_CHECK_EQ(cell, num_cells);
 
   // Add a fourth binary plane for komi (whether white is to play).
-  std::fill(values->begin() + (CellStates() * num_cells), values->end(),
+  std::fill(buffer + (CellStates() * num_cells), buffer + size,
             (to_play_ == GoColor::kWhite ? 1.0 : 0.0));
 }
 
@@ -181,6 +190,7 @@ std::unique_ptr<State> GoState::Clone() const {
 }
 
 void GoState::UndoAction(Player player, Action action) {
+  InvalidateLegalActionsCache();
   // We don't have direct undo functionality, but copying the board and
   // replaying all actions is still pretty fast (> 1 million undos/second).
   history_.pop_back();
@@ -218,7 +228,7 @@ void GoState::ResetBoard() {
 }
 
 GoGame::GoGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       komi_(ParameterValue<double>("komi")),
       board_size_(ParameterValue<int>("board_size")),
       handicap_(ParameterValue<int>("handicap")) {}
@@ -81,6 +81,7 @@ class GoState : public State {
   // (whether white is to play).
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
+  void ObservationAsNormalizedVector(int player, double* buffer) const override;
 
   std::vector<double> Returns() const override;
 
@@ -89,6 +90,13 @@ class GoState : public State {
 
   const GoBoard& board() const { return board_; }
 
+  // The board's Zobrist hash, mixed with the color to play (the stones alone
+  // do not determine whose turn it is after a pass).
+  uint64_t HashValue() const override {
+    return board_.HashValue() ^
+           (to_play_ == GoColor::kBlack ? 0x9e3779b97f4a7c15ULL : 0);
+  }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -145,6 +153,8 @@ class GoGame : public Game {
   }
 
   int MaxGameLength() const override { return go::MaxGameLength(board_size_); }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
 
  private:
   const float komi_;
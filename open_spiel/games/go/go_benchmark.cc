@@ -0,0 +1,80 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Random playout benchmark for go.
+//
+// Plays uniform-random games through GoState from the empty board and
+// reports moves/second and playouts/second per board size. This measures
+// the full per-move cost the algorithms see - GoState::LegalActions plus
+// GoBoard::PlayMove and the superko bookkeeping - so changes to the chain,
+// liberty or hashing code in go_board.cc land with a tracked number.
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+ABSL_FLAG(int, num_playouts, 20, "Number of playouts per board size.");
+ABSL_FLAG(int, seed, 82736, "Seed for the random number generator.");
+
+namespace open_spiel {
+namespace go {
+namespace {
+
+void RunBoardSize(int board_size, int num_playouts, std::mt19937* rng) {
+  std::shared_ptr<const Game> game =
+      LoadGame("go", {{"board_size", GameParameter(board_size)}});
+
+  int64_t num_moves = 0;
+  absl::Time start = absl::Now();
+  for (int playout = 0; playout < num_playouts; ++playout) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> actions = state->LegalActions();
+      int choice =
+          std::uniform_int_distribution<int>(0, actions.size() - 1)(*rng);
+      state->ApplyAction(actions[choice]);
+      ++num_moves;
+    }
+  }
+  double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+
+  std::cout << board_size << "x" << board_size << ": " << num_playouts
+            << " playouts, " << num_moves << " moves in " << seconds
+            << " seconds (" << static_cast<int64_t>(num_moves / seconds)
+            << " moves/sec, " << num_playouts / seconds << " playouts/sec)"
+            << std::endl;
+}
+
+}  // namespace
+}  // namespace go
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  int num_playouts = absl::GetFlag(FLAGS_num_playouts);
+  std::mt19937 rng(absl::GetFlag(FLAGS_seed));
+  for (int board_size : {9, 19}) {
+    open_spiel::go::RunBoardSize(board_size, num_playouts, &rng);
+  }
+  return 0;
+}
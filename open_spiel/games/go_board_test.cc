@@ -0,0 +1,172 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/go/go_board.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace go {
+namespace {
+
+// Exercises the incremental chain bookkeeping: chain heads, pseudo-liberty
+// counts, merging, atari detection and capture.
+void ChainAndLibertyTest() {
+  GoBoard board(9);
+
+  // A lone corner stone has two liberties.
+  GoPoint corner = GoPointFrom2DPoint({0, 0});
+  SPIEL_CHECK_TRUE(board.PlayMove(corner, GoColor::kBlack));
+  SPIEL_CHECK_EQ(board.PseudoLiberty(corner), 2);
+  SPIEL_CHECK_EQ(board.RealLiberty(corner), 2);
+
+  // Extending along the edge merges into one chain with three liberties.
+  GoPoint edge = GoPointFrom2DPoint({0, 1});
+  SPIEL_CHECK_TRUE(board.PlayMove(edge, GoColor::kBlack));
+  SPIEL_CHECK_EQ(board.ChainHead(corner), board.ChainHead(edge));
+  SPIEL_CHECK_EQ(board.RealLiberty(corner), 3);
+  SPIEL_CHECK_FALSE(board.InAtari(corner));
+
+  // Surrounding the chain takes it down to atari, then captures it.
+  SPIEL_CHECK_TRUE(
+      board.PlayMove(GoPointFrom2DPoint({1, 0}), GoColor::kWhite));
+  SPIEL_CHECK_TRUE(
+      board.PlayMove(GoPointFrom2DPoint({1, 1}), GoColor::kWhite));
+  SPIEL_CHECK_TRUE(board.InAtari(corner));
+  SPIEL_CHECK_EQ(board.PseudoLiberty(corner), 1);
+  SPIEL_CHECK_EQ(board.RealLiberty(corner), 1);
+
+  GoPoint capture_point = GoPointFrom2DPoint({0, 2});
+  SPIEL_CHECK_TRUE(board.IsLegalMove(capture_point, GoColor::kWhite));
+  SPIEL_CHECK_TRUE(board.PlayMove(capture_point, GoColor::kWhite));
+  SPIEL_CHECK_TRUE(board.IsEmpty(corner));
+  SPIEL_CHECK_TRUE(board.IsEmpty(edge));
+
+  // The capturing stone gained the vacated points as liberties.
+  SPIEL_CHECK_EQ(board.RealLiberty(capture_point), 3);
+}
+
+void KoTest() {
+  GoBoard board(9);
+
+  // Classic ko shape around (3, 3) and (3, 4).
+  for (const auto& rc :
+       std::vector<std::pair<int, int>>{{2, 3}, {3, 2}, {4, 3}}) {
+    SPIEL_CHECK_TRUE(board.PlayMove(GoPointFrom2DPoint(rc), GoColor::kBlack));
+  }
+  for (const auto& rc :
+       std::vector<std::pair<int, int>>{{2, 4}, {4, 4}, {3, 5}}) {
+    SPIEL_CHECK_TRUE(board.PlayMove(GoPointFrom2DPoint(rc), GoColor::kWhite));
+  }
+  GoPoint black_stone = GoPointFrom2DPoint({3, 4});
+  GoPoint white_stone = GoPointFrom2DPoint({3, 3});
+  SPIEL_CHECK_TRUE(board.PlayMove(black_stone, GoColor::kBlack));
+
+  // White takes the ko; black may not immediately retake.
+  SPIEL_CHECK_TRUE(board.PlayMove(white_stone, GoColor::kWhite));
+  SPIEL_CHECK_TRUE(board.IsEmpty(black_stone));
+  SPIEL_CHECK_EQ(board.LastKoPoint(), black_stone);
+  SPIEL_CHECK_FALSE(board.IsLegalMove(black_stone, GoColor::kBlack));
+
+  // After a move elsewhere the ko is lifted.
+  SPIEL_CHECK_TRUE(
+      board.PlayMove(GoPointFrom2DPoint({8, 8}), GoColor::kBlack));
+  SPIEL_CHECK_TRUE(board.IsLegalMove(black_stone, GoColor::kBlack));
+}
+
+// The superko check in go.cc is a probe into a set of prior board hashes, so
+// the hash must depend only on the stones on the board: the same position
+// reached through different histories has to hash identically, and captures
+// have to XOR the removed stones back out.
+void ZobristHashTest() {
+  GoPoint p1 = GoPointFrom2DPoint({4, 4});
+  GoPoint p2 = GoPointFrom2DPoint({5, 5});
+
+  // Transpositions hash the same.
+  GoBoard a(9);
+  SPIEL_CHECK_TRUE(a.PlayMove(p1, GoColor::kBlack));
+  SPIEL_CHECK_TRUE(a.PlayMove(p2, GoColor::kWhite));
+  GoBoard b(9);
+  SPIEL_CHECK_TRUE(b.PlayMove(p2, GoColor::kWhite));
+  SPIEL_CHECK_TRUE(b.PlayMove(p1, GoColor::kBlack));
+  SPIEL_CHECK_EQ(a.HashValue(), b.HashValue());
+  SPIEL_CHECK_NE(a.HashValue(), GoBoard(9).HashValue());
+
+  // Capturing a chain leaves the hash equal to that of a board holding only
+  // the surviving stones.
+  GoBoard c(9);
+  SPIEL_CHECK_TRUE(c.PlayMove(GoPointFrom2DPoint({0, 0}), GoColor::kBlack));
+  GoBoard d(9);
+  for (const auto& rc :
+       std::vector<std::pair<int, int>>{{1, 0}, {0, 1}}) {
+    GoPoint p = GoPointFrom2DPoint(rc);
+    SPIEL_CHECK_TRUE(c.PlayMove(p, GoColor::kWhite));
+    SPIEL_CHECK_TRUE(d.PlayMove(p, GoColor::kWhite));
+  }
+  SPIEL_CHECK_TRUE(c.IsEmpty(GoPointFrom2DPoint({0, 0})));
+  SPIEL_CHECK_EQ(c.HashValue(), d.HashValue());
+
+  // Clear resets the hash along with the board.
+  c.Clear();
+  SPIEL_CHECK_EQ(c.HashValue(), GoBoard(9).HashValue());
+}
+
+// Random playout benchmark; the moves/second figure is the number to compare
+// when changing the chain or liberty bookkeeping in go_board.cc.
+void PlayoutBenchmark() {
+  constexpr int kNumGames = 10;
+  constexpr int kMaxMovesPerGame = 500;
+
+  std::mt19937 rng(82736);
+  GoBoard board(19);
+  int num_moves = 0;
+  absl::Time start = absl::Now();
+  for (int game = 0; game < kNumGames; ++game) {
+    board.Clear();
+    GoColor to_play = GoColor::kBlack;
+    for (int i = 0; i < kMaxMovesPerGame; ++i) {
+      std::vector<GoPoint> legal_moves;
+      for (GoPoint p : BoardPoints(19)) {
+        if (board.IsLegalMove(p, to_play)) legal_moves.push_back(p);
+      }
+      if (legal_moves.empty()) break;
+      int choice = std::uniform_int_distribution<int>(
+          0, legal_moves.size() - 1)(rng);
+      SPIEL_CHECK_TRUE(board.PlayMove(legal_moves[choice], to_play));
+      to_play = OppColor(to_play);
+      ++num_moves;
+    }
+  }
+  double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+  std::cerr << "Played " << num_moves << " moves in " << seconds << " seconds ("
+            << static_cast<int>(num_moves / seconds) << " moves/sec, including "
+            << "full-board legal move generation per move)" << std::endl;
+}
+
+}  // namespace
+}  // namespace go
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::go::ChainAndLibertyTest();
+  open_spiel::go::KoTest();
+  open_spiel::go::ZobristHashTest();
+  open_spiel::go::PlayoutBenchmark();
+}
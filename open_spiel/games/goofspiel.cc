@@ -25,32 +25,35 @@ namespace open_spiel {
 namespace goofspiel {
 namespace {
 
-const GameType kGameType{
-    /*short_name=*/"goofspiel",
-    /*long_name=*/"Goofspiel",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"imp_info", GameParameter(kDefaultImpInfo)},
-     {"num_cards", GameParameter(kDefaultNumCards)},
-     {"players", GameParameter(kDefaultNumPlayers)},
-     {"points_order",
-      GameParameter(static_cast<std::string>(kDefaultPointsOrder))}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"goofspiel",
+      /*long_name=*/"Goofspiel",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"imp_info", GameParameter(kDefaultImpInfo)},
+       {"num_cards", GameParameter(kDefaultNumCards)},
+       {"players", GameParameter(kDefaultNumPlayers)},
+       {"points_order",
+        GameParameter(static_cast<std::string>(kDefaultPointsOrder))}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new GoofspielGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("goofspiel", GetGameType, Factory);
 
 PointsOrder ParsePointsOrder(const std::string& po_str) {
   if (po_str == "random") {
@@ -86,9 +89,13 @@ GoofspielState::GoofspielState(std::shared_ptr<const Game> game, int num_cards,
 
   // Player hands.
   player_hands_.clear();
+  remaining_cards_.clear();
+  std::vector<Action> all_cards(num_cards_);
+  for (int c = 0; c < num_cards_; ++c) all_cards[c] = c;
   for (auto p = Player{0}; p < num_players_; ++p) {
     std::vector<bool> hand(num_cards_, true);
     player_hands_.push_back(hand);
+    remaining_cards_.push_back(all_cards);
   }
 
   // Set the points card index.
@@ -165,6 +172,8 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
   // Remove the cards from the player's hands.
   for (auto p = Player{0}; p < num_players_; ++p) {
     player_hands_[p][actions[p]] = false;
+    std::vector<Action>& hand = remaining_cards_[p];
+    hand.erase(std::lower_bound(hand.begin(), hand.end(), actions[p]));
   }
 
   // Next player's turn.
@@ -230,13 +239,7 @@ std::vector<Action> GoofspielState::LegalActions(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  std::vector<Action> movelist;
-  for (int bid = 0; bid < player_hands_[player].size(); ++bid) {
-    if (player_hands_[player][bid]) {
-      movelist.push_back(bid);
-    }
-  }
-  return movelist;
+  return remaining_cards_[player];
 }
 
 std::string GoofspielState::ActionToString(Player player,
@@ -377,55 +380,52 @@ void GoofspielState::InformationStateAsNormalizedVector(
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
+  // Size the vector once and write only the hot bits; see
+  // InformationStateNormalizedVectorShape for the layout.
+  // Cards numbered 1 .. K
+  const int max_points_slots = (num_cards_ * (num_cards_ + 1)) / 2 + 1;
+  int size = num_players_ + num_players_ * max_points_slots;
+  size += impinfo_ ? num_cards_ + num_cards_ * num_players_ +
+                         num_cards_ * num_cards_
+                   : num_players_ * num_cards_;
+  values->assign(size, 0.);
 
   // 1-hot vector for the observing player.
-  for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == player ? 1 : 0);
-  }
+  (*values)[player] = 1;
+  int offset = num_players_;
 
   // Point totals: one-hot vector encoding points, per player.
   for (auto p = Player{0}; p < num_players_; ++p) {
-    // Cards numbered 1 .. K
-    int max_points_slots = (num_cards_ * (num_cards_ + 1)) / 2 + 1;
-    for (int i = 0; i < max_points_slots; ++i) {
-      values->push_back(i == points_[p] ? 1 : 0);
-    }
+    (*values)[offset + points_[p]] = 1;
+    offset += max_points_slots;
   }
 
   if (impinfo_) {
     // Bit vector of observing player's hand.
-    for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+    for (const Action card : remaining_cards_[player]) {
+      (*values)[offset + card] = 1;
     }
+    offset += num_cards_;
 
-    // Sequence of who won each trick.
+    // Sequence of who won each trick, padded with zeros for future tricks.
     for (int i = 0; i < win_sequence_.size(); ++i) {
-      for (auto p = Player{0}; p < num_players_; ++p) {
-        values->push_back(win_sequence_[i] == p ? 1 : 0);
+      if (win_sequence_[i] != kInvalidPlayer) {
+        (*values)[offset + i * num_players_ + win_sequence_[i]] = 1;
       }
     }
-
-    // Padding for future tricks
-    const int future_tricks = num_cards_ - win_sequence_.size();
-    for (int i = 0; i < future_tricks * num_players_; ++i) values->push_back(0);
+    offset += num_cards_ * num_players_;
 
     // The observing player's action sequence.
-    for (int i = 0; i < num_cards_; ++i) {
-      for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(i < actions_history_.size() &&
-                                  actions_history_[i][player] == c
-                              ? 1
-                              : 0);
-      }
+    for (int i = 0; i < actions_history_.size(); ++i) {
+      (*values)[offset + i * num_cards_ + actions_history_[i][player]] = 1;
     }
-
   } else {
     // Bit vectors encoding all players' hands.
     for (auto p = Player{0}; p < num_players_; ++p) {
-      for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+      for (const Action card : remaining_cards_[p]) {
+        (*values)[offset + card] = 1;
       }
+      offset += num_cards_;
     }
   }
 }
@@ -435,7 +435,7 @@ std::unique_ptr<State> GoofspielState::Clone() const {
 }
 
 GoofspielGame::GoofspielGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_cards_(ParameterValue<int>("num_cards")),
       num_players_(ParameterValue<int>("players")),
       points_order_(
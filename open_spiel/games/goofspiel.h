@@ -95,6 +95,9 @@ class GoofspielState : public SimMoveState {
   std::vector<int> points_;
   std::vector<int> point_deck_;                  // Current point deck.
   std::vector<std::vector<bool>> player_hands_;  // true if card is in hand.
+  // Sorted remaining cards per player, kept in sync with player_hands_ so
+  // that LegalActions is a copy rather than a scan over all cards.
+  std::vector<std::vector<Action>> remaining_cards_;
   std::vector<int> win_sequence_;
   std::vector<std::vector<Action>> actions_history_;
 };
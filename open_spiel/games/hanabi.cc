@@ -23,38 +23,41 @@ namespace hanabi {
 
 namespace {
 
-const GameType kGameType{
-    /*short_name=*/"hanabi",
-    /*long_name=*/"Hanabi",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kRewards,
-    /*max_num_players=*/5,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"players", GameParameter(GameParameter::Type::kInt)},
-        {"colors", GameParameter(GameParameter::Type::kInt)},
-        {"ranks", GameParameter(GameParameter::Type::kInt)},
-        {"hand_size", GameParameter(GameParameter::Type::kInt)},
-        {"max_information_tokens", GameParameter(GameParameter::Type::kInt)},
-        {"max_life_tokens", GameParameter(GameParameter::Type::kInt)},
-        {"seed", GameParameter(GameParameter::Type::kInt)},
-        {"random_start_player", GameParameter(GameParameter::Type::kBool)},
-        {"observation_type", GameParameter(GameParameter::Type::kString)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"hanabi",
+      /*long_name=*/"Hanabi",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kRewards,
+      /*max_num_players=*/5,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"players", GameParameter(GameParameter::Type::kInt)},
+          {"colors", GameParameter(GameParameter::Type::kInt)},
+          {"ranks", GameParameter(GameParameter::Type::kInt)},
+          {"hand_size", GameParameter(GameParameter::Type::kInt)},
+          {"max_information_tokens", GameParameter(GameParameter::Type::kInt)},
+          {"max_life_tokens", GameParameter(GameParameter::Type::kInt)},
+          {"seed", GameParameter(GameParameter::Type::kInt)},
+          {"random_start_player", GameParameter(GameParameter::Type::kBool)},
+          {"observation_type", GameParameter(GameParameter::Type::kString)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new OpenSpielHanabiGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("hanabi", GetGameType, Factory);
 
 }  // namespace
 
@@ -108,7 +111,7 @@ std::unordered_map<std::string, std::string> OpenSpielHanabiGame::MapParams()
 }
 
 OpenSpielHanabiGame::OpenSpielHanabiGame(const GameParameters& params)
-    : Game(kGameType, params), game_(MapParams()), encoder_(&game_) {}
+    : Game(GetGameType(), params), game_(MapParams()), encoder_(&game_) {}
 
 int OpenSpielHanabiGame::NumDistinctActions() const { return game_.MaxMoves(); }
 
@@ -191,6 +194,7 @@ void OpenSpielHanabiState::DoApplyAction(Action action) {
   if (state_.MoveIsLegal(move)) {
     if (!IsChanceNode()) prev_state_score_ = state_.Score();
     state_.ApplyMove(move);
+    for (auto& encoded : encoded_observations_) encoded.clear();
   } else {
     SpielFatalError(absl::StrCat("Invalid move ", move.ToString()));
   }
@@ -200,14 +204,38 @@ std::string OpenSpielHanabiState::Observation(Player player) const {
   return hanabi_learning_env::HanabiObservation(state_, player).ToString();
 }
 
+const std::vector<int>& OpenSpielHanabiState::EncodedObservation(
+    Player player) const {
+  std::vector<int>& encoded = encoded_observations_[player];
+  if (encoded.empty()) {
+    encoded = game_->Encoder().Encode(
+        hanabi_learning_env::HanabiObservation(state_, player));
+  }
+  return encoded;
+}
+
 void OpenSpielHanabiState::ObservationAsNormalizedVector(
     Player player, std::vector<double>* values) const {
-  auto obs = game_->Encoder().Encode(
-      hanabi_learning_env::HanabiObservation(state_, player));
+  const std::vector<int>& obs = EncodedObservation(player);
   values->resize(obs.size());
   for (int i = 0; i < obs.size(); ++i) values->at(i) = obs[i];
 }
 
+void OpenSpielHanabiState::ObservationAsNormalizedVector(Player player,
+                                                         double* buffer) const {
+  const std::vector<int>& obs = EncodedObservation(player);
+  for (int i = 0; i < obs.size(); ++i) buffer[i] = obs[i];
+}
+
+void OpenSpielHanabiState::AllObservationsAsNormalizedVector(
+    double* buffer) const {
+  for (auto p = Player{0}; p < NumPlayers(); ++p) {
+    const std::vector<int>& obs = EncodedObservation(p);
+    for (int i = 0; i < obs.size(); ++i) buffer[i] = obs[i];
+    buffer += obs.size();
+  }
+}
+
 std::unique_ptr<State> OpenSpielHanabiState::Clone() const {
   return std::unique_ptr<State>(new OpenSpielHanabiState(*this));
 }
@@ -233,7 +261,8 @@ OpenSpielHanabiState::OpenSpielHanabiState(std::shared_ptr<const Game> game)
     : State(game),
       state_(&(static_cast<const OpenSpielHanabiGame&>(*game).HanabiGame())),
       game_(static_cast<const OpenSpielHanabiGame*>(game.get())),
-      prev_state_score_(0.) {}
+      prev_state_score_(0.),
+      encoded_observations_(game->NumPlayers()) {}
 
 }  // namespace hanabi
 }  // namespace open_spiel
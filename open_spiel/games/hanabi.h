@@ -86,6 +86,14 @@ class OpenSpielHanabiState : public State {
   std::string Observation(Player player) const override;
   void ObservationAsNormalizedVector(Player player,
                                      std::vector<double>* values) const;
+  void ObservationAsNormalizedVector(Player player,
+                                     double* buffer) const override;
+
+  // Encodes the observations of all players into `buffer`, which must hold
+  // NumPlayers() * game->ObservationNormalizedVectorSize() doubles, ordered
+  // by player. Cheaper than separate per-player calls when a self-play job
+  // needs every seat's encoding of the same state.
+  void AllObservationsAsNormalizedVector(double* buffer) const;
 
   std::unique_ptr<State> Clone() const override;
   ActionsAndProbs ChanceOutcomes() const override;
@@ -96,9 +104,19 @@ class OpenSpielHanabiState : public State {
   void DoApplyAction(Action action) override;
 
  private:
+  // Returns the encoded observation for the player, encoding it on first use.
+  const std::vector<int>& EncodedObservation(Player player) const;
+
   hanabi_learning_env::HanabiState state_;
   const OpenSpielHanabiGame* game_;
   double prev_state_score_;
+
+  // Observation encoding dominates the cost of Hanabi self-play, and the same
+  // encoding is frequently requested several times per state (e.g. once per
+  // player position fed to the network). Encodings are cached per player and
+  // invalidated when a move is applied; an empty entry means not yet encoded
+  // (valid encodings always have the full observation length).
+  mutable std::vector<std::vector<int>> encoded_observations_;
 };
 
 }  // namespace hanabi
@@ -24,30 +24,68 @@ namespace hex {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"hex",
-    /*long_name=*/"Hex",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"board_size", GameParameter(kDefaultBoardSize)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"hex",
+      /*long_name=*/"Hex",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"board_size", GameParameter(kDefaultBoardSize)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new HexGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("hex", GetGameType, Factory);
+
+// Cells adjacent to cell, clipped to the board.
+std::vector<int> GenAdjacentCells(int cell, int board_size) {
+  std::vector<int> neighbours = {
+      cell - board_size, cell - board_size + 1, cell - 1,
+      cell + 1,          cell + board_size - 1, cell + board_size};
+  for (int i = kMaxNeighbours - 1; i >= 0; i--) {
+    // Check for invalid neighbours and remove
+    // Iterating in reverse to avoid changing the index of a candidate neighbour
+    if (neighbours[i] < 0 || (neighbours[i] >= board_size * board_size) ||
+        (neighbours[i] % board_size == 0 &&
+         cell % board_size == board_size - 1) ||
+        (neighbours[i] % board_size == board_size - 1 &&
+         cell % board_size == 0)) {
+      neighbours.erase(neighbours.begin() + i);
+    }
+  }
+  return neighbours;
+}
+
+// Precomputed list of neighbours per board_size: [board_size][cell]
+std::vector<std::vector<std::vector<int>>> neighbor_list;
+
+const std::vector<std::vector<int>>& GetNeighbors(int board_size) {
+  if (board_size >= neighbor_list.size()) {
+    neighbor_list.resize(board_size + 1);
+  }
+  if (neighbor_list[board_size].empty()) {
+    neighbor_list[board_size].resize(board_size * board_size);
+    for (int cell = 0; cell < board_size * board_size; ++cell) {
+      neighbor_list[board_size][cell] = GenAdjacentCells(cell, board_size);
+    }
+  }
+  return neighbor_list[board_size];
+}
 
 }  // namespace
 
@@ -145,6 +183,45 @@ std::string StateToString(CellState state) {
   }
 }
 
+namespace {
+
+// The cell contents after rotating the board by 180 degrees: the edges swap
+// within each player (north with south, west with east), so the
+// edge-connectivity flags swap with them; plain stones and wins map to
+// themselves.
+CellState RotateCellState(CellState state) {
+  switch (state) {
+    case CellState::kBlackNorth:
+      return CellState::kBlackSouth;
+    case CellState::kBlackSouth:
+      return CellState::kBlackNorth;
+    case CellState::kWhiteWest:
+      return CellState::kWhiteEast;
+    case CellState::kWhiteEast:
+      return CellState::kWhiteWest;
+    default:
+      return state;
+  }
+}
+
+}  // namespace
+
+std::string HexState::CanonicalString() const {
+  // The board's only symmetry that preserves the players' edges is the
+  // 180-degree rotation; render both orientations and keep the smaller one.
+  const int num_cells = board_.size();
+  std::string str;
+  std::string rotated;
+  str.reserve(num_cells);
+  rotated.reserve(num_cells);
+  for (int cell = 0; cell < num_cells; ++cell) {
+    str.append(StateToString(board_[cell]));
+    rotated.append(
+        StateToString(RotateCellState(board_[num_cells - 1 - cell])));
+  }
+  return std::min(str, rotated);
+}
+
 void HexState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
   CellState move_cell_state = PlayerAndActionToState(CurrentPlayer(), move);
@@ -202,26 +279,10 @@ std::string HexState::ActionToString(Player player, Action action_id) const {
                       action_id / board_size_, ")");
 }
 
-std::vector<int> HexState::AdjacentCells(int cell) const {
-  std::vector<int> neighbours = {
-      cell - board_size_, cell - board_size_ + 1, cell - 1,
-      cell + 1,           cell + board_size_ - 1, cell + board_size_};
-  for (int i = kMaxNeighbours - 1; i >= 0; i--) {
-    // Check for invalid neighbours and remove
-    // Iterating in reverse to avoid changing the index of a candidate neighbour
-    if (neighbours[i] < 0 || (neighbours[i] >= board_size_ * board_size_) ||
-        (neighbours[i] % board_size_ == 0 &&
-         cell % board_size_ == board_size_ - 1) ||
-        (neighbours[i] % board_size_ == board_size_ - 1 &&
-         cell % board_size_ == 0)) {
-      neighbours.erase(neighbours.begin() + i);
-    }
-  }
-  return neighbours;
-}
-
 HexState::HexState(std::shared_ptr<const Game> game, int board_size)
-    : State(game), board_size_(board_size) {
+    : State(game),
+      neighbors_(GetNeighbors(board_size)),
+      board_size_(board_size) {
   board_.resize(board_size * board_size, CellState::kEmpty);
 }
 
@@ -279,6 +340,6 @@ std::unique_ptr<State> HexState::Clone() const {
 }
 
 HexGame::HexGame(const GameParameters& params)
-    : Game(kGameType, params), board_size_(ParameterValue<int>("board_size")) {}
+    : Game(GetGameType(), params), board_size_(ParameterValue<int>("board_size")) {}
 }  // namespace hex
 }  // namespace open_spiel
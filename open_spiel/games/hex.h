@@ -82,15 +82,34 @@ class HexState : public State {
   std::vector<Action> LegalActions() const override;
   CellState BoardAt(int cell) const { return board_[cell]; }
 
+  // Symmetry-reduced key: the board and its 180-degree rotation share it.
+  std::string CanonicalString() const override;
+
+  // Cheap transposition key: FNV-1a over the cells, shifted to be
+  // non-negative (the connectivity flags are a function of the stone
+  // placement, and the side to move follows from the stone count).
+  uint64_t HashValue() const override {
+    uint64_t hash = 14695981039346656037ULL;
+    for (CellState cell : board_) {
+      hash ^= static_cast<uint64_t>(static_cast<int64_t>(cell) + 4);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
  protected:
   std::vector<CellState> board_;
   void DoApplyAction(Action move) override;
 
  private:
   CellState PlayerAndActionToState(Player player, Action move) const;
-  Player current_player_ = 0;                      // Player zero goes first
-  double result_black_perspective_ = 0;            // 1 if Black (player 0) wins
-  std::vector<int> AdjacentCells(int cell) const;  // Cells adjacent to cell
+  // Cells adjacent to cell, from the list precomputed per board size.
+  const std::vector<int>& AdjacentCells(int cell) const {
+    return neighbors_[cell];
+  }
+  Player current_player_ = 0;            // Player zero goes first
+  double result_black_perspective_ = 0;  // 1 if Black (player 0) wins
+  const std::vector<std::vector<int>>& neighbors_;
   const int board_size_;
 };
 
@@ -114,6 +133,8 @@ class HexGame : public Game {
     return {kCellStates, board_size_, board_size_};
   }
   int MaxGameLength() const { return board_size_ * board_size_; }
+  bool ProvidesCanonicalForm() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
 
  private:
   const int board_size_;
@@ -28,8 +28,34 @@ void BasicHexTests() {
   testing::RandomSimTest(*LoadGame("hex"), 5);
 }
 
+// Playing a game and its 180-degree rotation must land on the same
+// canonical form, including the edge-connectivity flags the cells carry;
+// breaking the symmetry must change it.
+void CanonicalFormTest() {
+  std::shared_ptr<const Game> game = LoadGame("hex(board_size=5)");
+  SPIEL_CHECK_TRUE(game->ProvidesCanonicalForm());
+  const int num_cells = 5 * 5;
+
+  // Includes edge cells so that connectivity flags appear on both boards.
+  const std::vector<Action> moves = {12, 2, 7, 3, 11};
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::unique_ptr<State> rotated = game->NewInitialState();
+  for (Action move : moves) {
+    state->ApplyAction(move);
+    rotated->ApplyAction(num_cells - 1 - move);
+    SPIEL_CHECK_EQ(state->CanonicalString(), rotated->CanonicalString());
+    SPIEL_CHECK_EQ(state->CanonicalHash(), rotated->CanonicalHash());
+  }
+  state->ApplyAction(8);
+  rotated->ApplyAction(8);
+  SPIEL_CHECK_NE(state->CanonicalString(), rotated->CanonicalString());
+}
+
 }  // namespace
 }  // namespace hex
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::hex::BasicHexTests(); }
+int main(int argc, char** argv) {
+  open_spiel::hex::BasicHexTests();
+  open_spiel::hex::CanonicalFormTest();
+}
@@ -31,28 +31,31 @@ constexpr int kDefaultPlayers = 2;
 constexpr double kAnte = 1;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"kuhn_poker",
-    /*long_name=*/"Kuhn Poker",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"players", GameParameter(kDefaultPlayers)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"kuhn_poker",
+      /*long_name=*/"Kuhn Poker",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"players", GameParameter(kDefaultPlayers)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new KuhnGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("kuhn_poker", GetGameType, Factory);
 }  // namespace
 
 KuhnState::KuhnState(std::shared_ptr<const Game> game)
@@ -180,6 +183,19 @@ std::string KuhnState::InformationState(Player player) const {
   return str;
 }
 
+uint64_t KuhnState::InformationStateKey(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // Betting sequence behind a sentinel bit, then the player's card.
+  uint64_t key = 1;
+  for (int i = num_players_; i < history_.size(); ++i) {
+    key = (key << 1) | static_cast<uint64_t>(history_[i]);
+  }
+  uint64_t card = history_.size() > player ? history_[player] + 1 : 0;
+  return key * (num_players_ + 2) + card;
+}
+
 // Observation is card then contributions to the pot, e.g. 111
 std::string KuhnState::Observation(Player player) const {
   SPIEL_CHECK_GE(player, 0);
@@ -248,6 +264,7 @@ std::unique_ptr<State> KuhnState::Clone() const {
 }
 
 void KuhnState::UndoAction(Player player, Action move) {
+  InvalidateLegalActionsCache();
   if (history_.size() <= num_players_) {
     // Undoing a deal move.
     card_dealt_[move] = kInvalidPlayer;
@@ -285,9 +302,9 @@ bool KuhnState::DidBet(Player player) const {
 }
 
 KuhnGame::KuhnGame(const GameParameters& params)
-    : Game(kGameType, params), num_players_(ParameterValue<int>("players")) {
-  SPIEL_CHECK_GE(num_players_, kGameType.min_num_players);
-  SPIEL_CHECK_LE(num_players_, kGameType.max_num_players);
+    : Game(GetGameType(), params), num_players_(ParameterValue<int>("players")) {
+  SPIEL_CHECK_GE(num_players_, GetGameType().min_num_players);
+  SPIEL_CHECK_LE(num_players_, GetGameType().max_num_players);
 }
 
 std::unique_ptr<State> KuhnGame::NewInitialState() const {
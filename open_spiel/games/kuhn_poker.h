@@ -56,6 +56,7 @@ class KuhnState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(Player player) const override;
+  uint64_t InformationStateKey(Player player) const override;
   std::string Observation(Player player) const override;
   void InformationStateAsNormalizedVector(
       Player player, std::vector<double>* values) const override;
@@ -104,6 +105,8 @@ class KuhnGame : public Game {
   std::vector<int> InformationStateNormalizedVectorShape() const override;
   std::vector<int> ObservationNormalizedVectorShape() const override;
   int MaxGameLength() const override { return num_players_ * 2 - 1; }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesInformationStateKey() const override { return true; }
 
  private:
   // Number of players.
@@ -30,29 +30,32 @@ constexpr int kDefaultHorizon = 1000;
 constexpr bool kDefaultZeroSum = false;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"laser_tag",
-    /*long_name=*/"Laser Tag",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kRewards,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"horizon", GameParameter(kDefaultHorizon)},
-     {"zero_sum", GameParameter(kDefaultZeroSum)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"laser_tag",
+      /*long_name=*/"Laser Tag",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kRewards,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"horizon", GameParameter(kDefaultHorizon)},
+       {"zero_sum", GameParameter(kDefaultZeroSum)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new LaserTagGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("laser_tag", GetGameType, Factory);
 
 // Constants.
 constexpr int kRows = 7;
@@ -517,7 +520,7 @@ std::vector<int> LaserTagGame::ObservationNormalizedVectorShape() const {
 }
 
 LaserTagGame::LaserTagGame(const GameParameters& params)
-    : SimMoveGame(kGameType, params),
+    : SimMoveGame(GetGameType(), params),
       horizon_(ParameterValue<int>("horizon")),
       zero_sum_(ParameterValue<bool>("zero_sum")) {}
 
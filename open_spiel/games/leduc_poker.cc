@@ -30,28 +30,31 @@ namespace {
 
 constexpr double kAnte = 1;
 
-const GameType kGameType{
-    /*short_name=*/"leduc_poker",
-    /*long_name=*/"Leduc Poker",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"players", GameParameter(kDefaultPlayers)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"leduc_poker",
+      /*long_name=*/"Leduc Poker",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"players", GameParameter(kDefaultPlayers)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new LeducGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("leduc_poker", GetGameType, Factory);
 
 }  // namespace
 LeducState::LeducState(std::shared_ptr<const Game> game)
@@ -80,7 +83,8 @@ LeducState::LeducState(std::shared_ptr<const Game> game)
       folded_(game->NumPlayers(), false),
       // Sequence of actions for each round. Needed to report information state.
       round1_sequence_(),
-      round2_sequence_() {
+      round2_sequence_(),
+      betting_encoding_(2 * game->MaxGameLength(), 0.0) {
   // Cards by value (0-6 for standard 2-player game, kInvalidCard if no longer
   // in the deck.)
   deck_.resize(deck_size_);
@@ -100,9 +104,9 @@ int LeducState::CurrentPlayer() const {
 // On a player node, it should be ActionType::{kFold, kCall, kRaise}
 void LeducState::DoApplyAction(Action move) {
   if (IsChanceNode()) {
-    SPIEL_CHECK_GE(move, 0);
-    SPIEL_CHECK_LT(move, deck_.size());
-    SPIEL_CHECK_NE(deck_[move], kInvalidCard);
+    SPIEL_DCHECK_GE(move, 0);
+    SPIEL_DCHECK_LT(move, deck_.size());
+    SPIEL_DCHECK_NE(deck_[move], kInvalidCard);
 
     if (private_cards_dealt_ < num_players_) {
       // Round 1. `move` refers to the card value to deal to the current
@@ -119,14 +123,14 @@ void LeducState::DoApplyAction(Action move) {
     } else {
       // Round 2: A single public card.
       public_card_ = deck_[move];
-      deck_[move] = kInvalidPlayer;
+      deck_[move] = kInvalidCard;
       deck_size_--;
 
       // We have finished the public card, let's bet!
       cur_player_ = NextPlayer();
     }
   } else if (move == ActionType::kFold) {
-    SPIEL_CHECK_NE(cur_player_, kChancePlayerId);
+    SPIEL_DCHECK_NE(cur_player_, kChancePlayerId);
     SequenceAppendMove(ActionType::kFold);
 
     // Player is now out.
@@ -141,13 +145,13 @@ void LeducState::DoApplyAction(Action move) {
       cur_player_ = NextPlayer();
     }
   } else if (move == ActionType::kCall) {
-    SPIEL_CHECK_NE(cur_player_, kChancePlayerId);
+    SPIEL_DCHECK_NE(cur_player_, kChancePlayerId);
 
     // Current player puts in an amount of money equal to the current level
     // (stakes) minus what they have contributed to level their contribution
     // off. Note: this action also acts as a 'check' where the stakes are equal
     // to each player's ante.
-    SPIEL_CHECK_GE(stakes_, ante_[cur_player_]);
+    SPIEL_DCHECK_GE(stakes_, ante_[cur_player_]);
     int amount = stakes_ - ante_[cur_player_];
     Ante(cur_player_, amount);
     num_calls_++;
@@ -161,14 +165,14 @@ void LeducState::DoApplyAction(Action move) {
       cur_player_ = NextPlayer();
     }
   } else if (move == ActionType::kRaise) {
-    SPIEL_CHECK_NE(cur_player_, kChancePlayerId);
+    SPIEL_DCHECK_NE(cur_player_, kChancePlayerId);
 
     // This player matches the current stakes and then brings the stakes up.
-    SPIEL_CHECK_LT(num_raises_, kMaxRaises);
+    SPIEL_DCHECK_LT(num_raises_, kMaxRaises);
     int call_amount = stakes_ - ante_[cur_player_];
 
     // First, match the current stakes if necessary
-    SPIEL_CHECK_GE(call_amount, 0);
+    SPIEL_DCHECK_GE(call_amount, 0);
     if (call_amount > 0) {
       Ante(cur_player_, call_amount);
     }
@@ -288,6 +292,26 @@ std::string LeducState::InformationState(Player player) const {
       public_card_, absl::StrJoin(round2_sequence_, " "));
 }
 
+uint64_t LeducState::InformationStateKey(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // Both betting sequences behind a sentinel digit, with a zero digit as the
+  // round separator (actions are encoded as 1..3), then the public and the
+  // player's private card, encoded as 1-based with 0 for not-yet-dealt.
+  uint64_t key = 1;
+  for (int action : round1_sequence_) key = key * 4 + action + 1;
+  key *= 4;
+  for (int action : round2_sequence_) key = key * 4 + action + 1;
+  const uint64_t card_base = deck_.size() + 1;
+  key = key * card_base +
+        (public_card_ == kInvalidCard ? 0 : public_card_ + 1);
+  key = key * card_base +
+        (private_cards_[player] == kInvalidCard ? 0
+                                                : private_cards_[player] + 1);
+  return key;
+}
+
 // Observation is card then contribution of each players to the pot.
 std::string LeducState::Observation(Player player) const {
   SPIEL_CHECK_GE(player, 0);
@@ -344,30 +368,11 @@ void LeducState::InformationStateAsNormalizedVector(
   }
   offset += deck_.size();
 
-  for (int r = 1; r <= 2; r++) {
-    const std::vector<int>& round_sequence =
-        (r == 1 ? round1_sequence_ : round2_sequence_);
-
-    for (int i = 0; i < round_sequence.size(); ++i) {
-      SPIEL_CHECK_LT(offset + i + 1, values->size());
-      if (round_sequence[i] == ActionType::kCall) {
-        // Encode call as 10.
-        (*values)[offset + (2 * i)] = 1;
-        (*values)[offset + (2 * i) + 1] = 0;
-      } else if (round_sequence[i] == ActionType::kRaise) {
-        // Encode raise as 01.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 1;
-      } else {
-        // Encode fold as 00.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 0;
-      }
-    }
-
-    // Move offset up to the next round: 2 bits per move.
-    offset += game_->MaxGameLength();
-  }
+  // Both betting sections (call 10, raise 01, fold 00) are maintained
+  // incrementally as the actions apply, so the encode is one copy.
+  SPIEL_CHECK_EQ(offset + betting_encoding_.size(), values->size());
+  std::copy(betting_encoding_.begin(), betting_encoding_.end(),
+            values->begin() + offset);
 }
 
 void LeducState::ObservationAsNormalizedVector(
@@ -412,6 +417,7 @@ std::unique_ptr<State> LeducState::Clone() const {
 std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
   std::vector<std::pair<Action, double>> outcomes;
+  outcomes.reserve(deck_size_);
 
   const double p = 1.0 / deck_size_;
   for (int card = 0; card < deck_.size(); card++) {
@@ -421,6 +427,20 @@ std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
   return outcomes;
 }
 
+std::pair<Action, double> LeducState::SampleChanceOutcome(double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // Every remaining card is equally likely, so pick the index-th one directly.
+  int index = static_cast<int>(z * deck_size_);
+  // Guard against z values within a rounding error of 1.
+  if (index >= deck_size_) index = deck_size_ - 1;
+  for (int card = 0; card < deck_.size(); card++) {
+    if (deck_[card] != kInvalidCard && index-- == 0) {
+      return {card, 1.0 / deck_size_};
+    }
+  }
+  SpielFatalError("No cards remaining in the deck.");
+}
+
 int LeducState::NextPlayer() const {
   // If we are on a chance node, it is the first player to play
   int current_real_player;
@@ -531,11 +551,23 @@ void LeducState::NewRound() {
 }
 
 void LeducState::SequenceAppendMove(int move) {
+  int offset;
   if (round_ == 1) {
     round1_sequence_.push_back(move);
+    offset = 2 * (static_cast<int>(round1_sequence_.size()) - 1);
   } else {
     SPIEL_CHECK_EQ(round_, 2);
     round2_sequence_.push_back(move);
+    offset = game_->MaxGameLength() +
+             2 * (static_cast<int>(round2_sequence_.size()) - 1);
+  }
+  // Keep the cached tensor section in step: call is 10, raise is 01, and
+  // fold keeps the zeroes it was initialized with.
+  SPIEL_CHECK_LT(offset + 1, static_cast<int>(betting_encoding_.size()));
+  if (move == ActionType::kCall) {
+    betting_encoding_[offset] = 1;
+  } else if (move == ActionType::kRaise) {
+    betting_encoding_[offset + 1] = 1;
   }
 }
 
@@ -560,11 +592,11 @@ std::vector<int> LeducState::padded_betting_sequence() const {
 }
 
 LeducGame::LeducGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_players_(ParameterValue<int>("players")),
       total_cards_((num_players_ + 1) * kNumSuits) {
-  SPIEL_CHECK_GE(num_players_, kGameType.min_num_players);
-  SPIEL_CHECK_LE(num_players_, kGameType.max_num_players);
+  SPIEL_CHECK_GE(num_players_, GetGameType().min_num_players);
+  SPIEL_CHECK_LE(num_players_, GetGameType().max_num_players);
 }
 
 std::unique_ptr<State> LeducGame::NewInitialState() const {
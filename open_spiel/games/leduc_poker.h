@@ -69,6 +69,7 @@ class LeducState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(Player player) const override;
+  uint64_t InformationStateKey(Player player) const override;
   std::string Observation(Player player) const override;
   void InformationStateAsNormalizedVector(
       Player player, std::vector<double>* values) const override;
@@ -77,6 +78,9 @@ class LeducState : public State {
   std::unique_ptr<State> Clone() const override;
   // The probability of taking each possible action in a particular info state.
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  // The chance distribution is always uniform over the remaining deck, so a
+  // card can be sampled directly without materializing ChanceOutcomes().
+  std::pair<Action, double> SampleChanceOutcome(double z) const override;
 
   // Additional methods
   int round() const { return round_; }
@@ -148,6 +152,10 @@ class LeducState : public State {
   // Sequence of actions for each round. Needed to report information state.
   std::vector<int> round1_sequence_;
   std::vector<int> round2_sequence_;
+  // The two-bits-per-move betting section of the info state tensor (both
+  // round slices, in tensor layout), maintained by SequenceAppendMove so
+  // that each encode copies it instead of replaying the sequences.
+  std::vector<double> betting_encoding_;
 };
 
 class LeducGame : public Game {
@@ -172,6 +180,7 @@ class LeducGame : public Game {
     // = 2 raises + (num_players_-1)*2 calls + (num_players_-2) calls
     return 2 * (2 + (num_players_ - 1) * 2 + (num_players_ - 2));
   }
+  bool ProvidesInformationStateKey() const override { return true; }
 
  private:
   int num_players_;  // Number of players.
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <numeric>
 #include <utility>
 #include "open_spiel/game_parameters.h"
 
@@ -31,30 +32,33 @@ constexpr int kInvalidOutcome = -1;
 constexpr int kInvalidBid = -1;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"liars_dice",
-    /*long_name=*/"Liars Dice",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/kDefaultPlayers,
-    /*min_num_players=*/kDefaultPlayers,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"players", GameParameter(kDefaultPlayers)},
-     {"numdice", GameParameter(kDefaultNumDice)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"liars_dice",
+      /*long_name=*/"Liars Dice",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/kDefaultPlayers,
+      /*min_num_players=*/kDefaultPlayers,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"players", GameParameter(kDefaultPlayers)},
+       {"numdice", GameParameter(kDefaultNumDice)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new LiarsDiceGame(params));
 }
 }  // namespace
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("liars_dice", GetGameType, Factory);
 
 LiarsDiceState::LiarsDiceState(std::shared_ptr<const Game> game,
                                int total_num_dice, int max_dice_per_player,
@@ -73,8 +77,7 @@ LiarsDiceState::LiarsDiceState(std::shared_ptr<const Game> game,
       dice_outcomes_(),
       num_dice_(num_dice),
       num_dice_rolled_(game->NumPlayers(), 0),
-      bidseq_(),
-      bidseq_str_() {
+      bid_mask_(0) {
   for (int const& num_dices : num_dice_) {
     std::vector<int> initial_outcomes(num_dices, kInvalidOutcome);
     dice_outcomes_.push_back(initial_outcomes);
@@ -155,20 +158,20 @@ void LiarsDiceState::DoApplyAction(Action action) {
       }
     }
   } else {
-    // Check for legal actions.
-    if (!bidseq_.empty() && action <= bidseq_.back()) {
+    // Check for legal actions. The last bid is the current one (a Liar
+    // call ends the game, so it is never the bid being topped).
+    if (total_moves_ > 0 && action <= current_bid_) {
       SpielFatalError(absl::StrCat("Illegal action. ", action,
                                    " should be strictly higher than ",
-                                   bidseq_.back()));
+                                   current_bid_));
     }
+    bid_mask_ |= uint64_t{1} << action;
     if (action == total_num_dice_ * kDiceSides) {
       // This was the calling bid, game is over.
-      bidseq_.push_back(action);
       calling_player_ = cur_player_;
       ResolveWinner();
     } else {
       // Up the bid and move to the next player.
-      bidseq_.push_back(action);
       current_bid_ = action;
       bidding_player_ = cur_player_;
       cur_player_ = NextPlayerRoundRobin(cur_player_, num_players_);
@@ -180,42 +183,24 @@ void LiarsDiceState::DoApplyAction(Action action) {
 
 std::vector<Action> LiarsDiceState::LegalActions() const {
   if (IsTerminal()) return {};
+  const auto& game = static_cast<const LiarsDiceGame&>(*game_);
   // A chance node is a single die roll.
   if (IsChanceNode()) {
-    std::vector<Action> outcomes(kDiceSides);
-    for (int i = 0; i < kDiceSides; i++) {
-      outcomes[i] = 1 + i;
-    }
-    return outcomes;
-  }
-
-  std::vector<Action> actions;
-
-  // Any move higher than the current bid is allowed. (Bids start at 0)
-  for (int b = current_bid_ + 1; b < total_num_dice_ * kDiceSides; b++) {
-    actions.push_back(b);
-  }
-
-  // Calling Liar is only available if at least one move has been made.
-  if (total_moves_ > 0) {
-    actions.push_back(total_num_dice_ * kDiceSides);
+    return game.ChanceActions();
   }
 
-  return actions;
+  // Any move higher than the current bid is allowed (bids start at 0), and
+  // calling Liar — the last table entry — only once a move has been made.
+  // That is a suffix of the game's ascending bid table: one bulk copy.
+  const std::vector<Action>& bids = game.BidActions();
+  return std::vector<Action>(bids.begin() + current_bid_ + 1,
+                             total_moves_ > 0 ? bids.end() : bids.end() - 1);
 }
 
 std::vector<std::pair<Action, double>> LiarsDiceState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-
-  std::vector<std::pair<Action, double>> outcomes;
-
-  // A chance node is a single die roll.
-  outcomes.reserve(kDiceSides);
-  for (int i = 0; i < kDiceSides; i++) {
-    outcomes.emplace_back(1 + i, 1.0 / kDiceSides);
-  }
-
-  return outcomes;
+  // A chance node is a single die roll, the same at every chance node.
+  return static_cast<const LiarsDiceGame&>(*game_).ChanceOutcomeTable();
 }
 
 std::string LiarsDiceState::InformationState(Player player) const {
@@ -223,17 +208,33 @@ std::string LiarsDiceState::InformationState(Player player) const {
   SPIEL_CHECK_LT(player, num_players_);
 
   std::string result = absl::StrJoin(dice_outcomes_[player], "");
-  for (int b = 0; b < bidseq_.size(); b++) {
-    if (bidseq_[b] == total_num_dice_ * kDiceSides) {
+  for (int b = 0; b <= total_num_dice_ * kDiceSides; b++) {
+    if (!(bid_mask_ >> b & 1)) continue;
+    if (b == total_num_dice_ * kDiceSides) {
       absl::StrAppend(&result, " Liar");
     } else {
-      auto bid = LiarsDiceGame::GetQuantityFace(bidseq_[b], total_num_dice_);
+      auto bid = LiarsDiceGame::GetQuantityFace(b, total_num_dice_);
       absl::StrAppend(&result, " ", bid.first, "-", bid.second);
     }
   }
   return result;
 }
 
+uint64_t LiarsDiceState::InformationStateKey(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // The bid set is already the bit set the key wants (see bid_mask_). The
+  // player's own dice are appended in base kDiceSides + 1.
+  const int num_bid_actions = total_num_dice_ * kDiceSides + 1;
+  SPIEL_CHECK_LE(num_bid_actions + 3 * num_dice_[player], 64);
+  uint64_t key = bid_mask_;
+  for (int die : dice_outcomes_[player]) {
+    key = key * (kDiceSides + 1) + die;
+  }
+  return key;
+}
+
 std::string LiarsDiceState::ToString() const {
   std::string result = "";
 
@@ -249,11 +250,12 @@ std::string LiarsDiceState::ToString() const {
                         cur_roller_);
   }
 
-  for (int b = 0; b < bidseq_.size(); b++) {
-    if (bidseq_[b] == total_num_dice_ * kDiceSides) {
+  for (int b = 0; b <= total_num_dice_ * kDiceSides; b++) {
+    if (!(bid_mask_ >> b & 1)) continue;
+    if (b == total_num_dice_ * kDiceSides) {
       absl::StrAppend(&result, " Liar");
     } else {
-      auto bid = LiarsDiceGame::GetQuantityFace(bidseq_[b], total_num_dice_);
+      auto bid = LiarsDiceGame::GetQuantityFace(b, total_num_dice_);
       absl::StrAppend(&result, " ", bid.first, "-", bid.second);
     }
   }
@@ -307,10 +309,10 @@ void LiarsDiceState::InformationStateAsNormalizedVector(
   // players, all the remaining entries are 0 for those dice.
   offset = num_players_ + max_dice_per_player_ * kDiceSides;
 
-  for (int b = 0; b < bidseq_.size(); b++) {
-    SPIEL_CHECK_GE(bidseq_[b], 0);
-    SPIEL_CHECK_LE(bidseq_[b], total_num_dice_ * kDiceSides);
-    (*values)[offset + bidseq_[b]] = 1;
+  for (int b = 0; b <= total_num_dice_ * kDiceSides; b++) {
+    if (bid_mask_ >> b & 1) {
+      (*values)[offset + b] = 1;
+    }
   }
 }
 
@@ -319,10 +321,10 @@ std::unique_ptr<State> LiarsDiceState::Clone() const {
 }
 
 LiarsDiceGame::LiarsDiceGame(const GameParameters& params)
-    : Game(kGameType, params) {
+    : Game(GetGameType(), params) {
   num_players_ = ParameterValue<int>("players");
-  SPIEL_CHECK_GE(num_players_, kGameType.min_num_players);
-  SPIEL_CHECK_LE(num_players_, kGameType.max_num_players);
+  SPIEL_CHECK_GE(num_players_, GetGameType().min_num_players);
+  SPIEL_CHECK_LE(num_players_, GetGameType().max_num_players);
 
   int def_num_dice = ParameterValue<int>("numdice");
 
@@ -350,6 +352,21 @@ LiarsDiceGame::LiarsDiceGame(const GameParameters& params)
       max_dice_per_player_ = nd;
     }
   }
+
+  // The bid history is kept as a 64-bit set (see LiarsDiceState), so every
+  // bid action — including the Liar call — must have a bit.
+  SPIEL_CHECK_LE(NumDistinctActions(), 64);
+
+  // Constant action tables: the ascending bids with Liar last, and the
+  // single die roll at every chance node.
+  bid_actions_.resize(NumDistinctActions());
+  std::iota(bid_actions_.begin(), bid_actions_.end(), 0);
+  chance_actions_.resize(kDiceSides);
+  std::iota(chance_actions_.begin(), chance_actions_.end(), 1);
+  chance_outcomes_.reserve(kDiceSides);
+  for (int i = 0; i < kDiceSides; i++) {
+    chance_outcomes_.emplace_back(1 + i, 1.0 / kDiceSides);
+  }
 }
 
 int LiarsDiceGame::NumDistinctActions() const {
@@ -51,6 +51,7 @@ class LiarsDiceState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(Player player) const override;
+  uint64_t InformationStateKey(Player player) const override;
   void InformationStateAsNormalizedVector(
       Player player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
@@ -80,9 +81,11 @@ class LiarsDiceState : public State {
   std::vector<int> num_dice_;         // How many dice each player has.
   std::vector<int> num_dice_rolled_;  // Number of dice currently rolled.
 
-  // Used to encode the information state.
-  std::vector<int> bidseq_;
-  std::string bidseq_str_;
+  // The set of bids made so far, one bit per action id. Bids strictly
+  // increase, so the set (with the Liar call as the highest id) uniquely
+  // determines the bidding sequence; walking the bits in ascending order
+  // replays it. Also the bid part of InformationStateKey, verbatim.
+  uint64_t bid_mask_;
 };
 
 class LiarsDiceGame : public Game {
@@ -92,6 +95,7 @@ class LiarsDiceGame : public Game {
   std::unique_ptr<State> NewInitialState() const override;
   int MaxChanceOutcomes() const override;
   int NumPlayers() const override { return num_players_; }
+  bool ProvidesInformationStateKey() const override { return true; }
   double MinUtility() const override { return -1; }
   double MaxUtility() const override { return 1; }
   double UtilitySum() const override { return 0; }
@@ -112,6 +116,18 @@ class LiarsDiceGame : public Game {
   // The bids starts at 1 and go to total_dice*6+1.
   static std::pair<int, int> GetQuantityFace(int bid, int total_dice);
 
+  // Every bid action in ascending order, with the Liar call last. Legal
+  // actions at a bidding node are a suffix of this table, so states serve
+  // them as one bulk copy instead of a per-element loop.
+  const std::vector<Action>& BidActions() const { return bid_actions_; }
+
+  // The single die roll at a chance node: actions and outcome
+  // distribution, identical at every chance node.
+  const std::vector<Action>& ChanceActions() const { return chance_actions_; }
+  const std::vector<std::pair<Action, double>>& ChanceOutcomeTable() const {
+    return chance_outcomes_;
+  }
+
  private:
   // Number of players.
   int num_players_;
@@ -121,6 +137,11 @@ class LiarsDiceGame : public Game {
 
   std::vector<int> num_dice_;  // How many dice each player has.
   int max_dice_per_player_;    // Maximum value in num_dice_ vector.
+
+  // Constant action tables, built once at construction (see above).
+  std::vector<Action> bid_actions_;
+  std::vector<Action> chance_actions_;
+  std::vector<std::pair<Action, double>> chance_outcomes_;
 };
 
 }  // namespace liars_dice
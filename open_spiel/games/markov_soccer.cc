@@ -28,28 +28,31 @@ namespace {
 constexpr int kDefaultHorizon = 1000;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"markov_soccer",
-    /*long_name=*/"Markov Soccer",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"horizon", GameParameter(kDefaultHorizon)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"markov_soccer",
+      /*long_name=*/"Markov Soccer",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"horizon", GameParameter(kDefaultHorizon)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new MarkovSoccerGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("markov_soccer", GetGameType, Factory);
 
 // Constants.
 constexpr int kRows = 4;
@@ -363,7 +366,7 @@ std::vector<int> MarkovSoccerGame::InformationStateNormalizedVectorShape()
 }
 
 MarkovSoccerGame::MarkovSoccerGame(const GameParameters& params)
-    : SimMoveGame(kGameType, params),
+    : SimMoveGame(GetGameType(), params),
       horizon_(ParameterValue<int>("horizon")) {}
 
 }  // namespace markov_soccer
@@ -27,27 +27,30 @@ constexpr const Action kHeadsActionId = 0;
 constexpr const Action kTailsActionId = 1;
 
 namespace {
-const GameType kGameType{
-    /*short_name=*/"matching_pennies_3p",
-    /*long_name=*/"Three-Player Matching Pennies",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/3,
-    /*min_num_players=*/3,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matching_pennies_3p",
+      /*long_name=*/"Three-Player Matching Pennies",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/3,
+      /*min_num_players=*/3,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/{}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new MatchingPennies3pGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matching_pennies_3p", GetGameType, Factory);
 }  // namespace
 
 MatchingPennies3pState::MatchingPennies3pState(std::shared_ptr<const Game> game)
@@ -97,7 +100,7 @@ void MatchingPennies3pState::DoApplyActions(
 }
 
 MatchingPennies3pGame::MatchingPennies3pGame(const GameParameters& params)
-    : NormalFormGame(kGameType, params) {}
+    : NormalFormGame(GetGameType(), params) {}
 
 }  // namespace matching_pennies_3p
 }  // namespace open_spiel
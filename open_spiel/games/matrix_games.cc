@@ -23,58 +23,64 @@ using matrix_game::MatrixGame;
 // Matching Pennies.
 namespace matching_pennies {
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"matrix_mp",
-    /*long_name=*/"Matching Pennies",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_mp",
+      /*long_name=*/"Matching Pennies",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Heads", "Tails"}, {"Heads", "Tails"},
+      new MatrixGame(GetGameType(), params, {"Heads", "Tails"}, {"Heads", "Tails"},
                      {1, -1, -1, 1}, {-1, 1, 1, -1}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_mp", GetGameType, Factory);
 }  // namespace matching_pennies
 
 // Rock, Paper, Scissors.
 namespace rock_paper_scissors {
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"matrix_rps",
-    /*long_name=*/"Rock, Paper, Scissors",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_rps",
+      /*long_name=*/"Rock, Paper, Scissors",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new MatrixGame(
-      kGameType, params, {"Rock", "Paper", "Scissors"},
+      GetGameType(), params, {"Rock", "Paper", "Scissors"},
       {"Rock", "Paper", "Scissors"}, {0, -1, 1, 1, 0, -1, -1, 1, 0},
       {0, 1, -1, -1, 0, 1, 1, -1, 0}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_rps", GetGameType, Factory);
 }  // namespace rock_paper_scissors
 
 // A general-sum variant of Rock, Paper, Scissors. Often used as a
@@ -83,134 +89,149 @@ REGISTER_SPIEL_GAME(kGameType, Factory);
 // Game-Theoretic, and Logical Foundations, 2009) for detailed examples.
 namespace shapleys_game {
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"matrix_shapleys_game",
-    /*long_name=*/"Shapley's Game",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_shapleys_game",
+      /*long_name=*/"Shapley's Game",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Rock", "Paper", "Scissors"},
+      new MatrixGame(GetGameType(), params, {"Rock", "Paper", "Scissors"},
                      {"Rock", "Paper", "Scissors"}, {0, 0, 1, 1, 0, 0, 0, 1, 0},
                      {0, 1, 0, 0, 0, 1, 1, 0, 0}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_shapleys_game", GetGameType, Factory);
 }  // namespace shapleys_game
 
 // Prisoner's Dilemma.
 namespace prisoners_dilemma {
-const GameType kGameType{
-    /*short_name=*/"matrix_pd",
-    /*long_name=*/"Prisoner's Dilemma",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_pd",
+      /*long_name=*/"Prisoner's Dilemma",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Cooperate", "Defect"},
+      new MatrixGame(GetGameType(), params, {"Cooperate", "Defect"},
                      {"Cooperate", "Defect"}, {5, 0, 10, 1}, {5, 10, 0, 1}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_pd", GetGameType, Factory);
 }  // namespace prisoners_dilemma
 
 // Stag Hunt.
 namespace stag_hunt {
-const GameType kGameType{
-    /*short_name=*/"matrix_sh",
-    /*long_name=*/"Stag Hunt",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_sh",
+      /*long_name=*/"Stag Hunt",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Stag", "Hare"}, {"Stag", "Hare"},
+      new MatrixGame(GetGameType(), params, {"Stag", "Hare"}, {"Stag", "Hare"},
                      {2, 0, 1, 1}, {2, 1, 0, 1}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_sh", GetGameType, Factory);
 }  // namespace stag_hunt
 
 // Coordination.
 namespace coordination {
-const GameType kGameType{
-    /*short_name=*/"matrix_coordination",
-    /*long_name=*/"Coordination",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_coordination",
+      /*long_name=*/"Coordination",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Left", "Right"}, {"Left", "Right"},
+      new MatrixGame(GetGameType(), params, {"Left", "Right"}, {"Left", "Right"},
                      {1, 0, 0, 1}, {1, 0, 0, 1}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_coordination", GetGameType, Factory);
 }  // namespace coordination
 
 // Chicken-Dare game.
 // As described in https://web.stanford.edu/~saberi/lecture6.pdf
 namespace chicken_dare {
-const GameType kGameType{
-    /*short_name=*/"matrix_cd",
-    /*long_name=*/"Chicken-Dare",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kOneShot,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"matrix_cd",
+      /*long_name=*/"Chicken-Dare",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(
-      new MatrixGame(kGameType, params, {"Dare", "Chicken"},
+      new MatrixGame(GetGameType(), params, {"Dare", "Chicken"},
                      {"Dare", "Chicken"}, {0, 4, 1, 3}, {0, 1, 4, 3}));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("matrix_cd", GetGameType, Factory);
 }  // namespace chicken_dare
 
 }  // namespace open_spiel
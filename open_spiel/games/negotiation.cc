@@ -35,33 +35,36 @@ namespace negotiation {
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"negotiation",
-    /*long_name=*/"Negotiation",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kSampledStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kGeneralSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"enable_proposals", GameParameter(kDefaultEnableProposals)},
-     {"enable_utterances", GameParameter(kDefaultEnableUtterances)},
-     {"num_items", GameParameter(kDefaultNumItems)},
-     {"num_symbols", GameParameter(kDefaultNumSymbols)},
-     {"rng_seed", GameParameter(kDefaultSeed)},
-     {"utterance_dim", GameParameter(kDefaultUtteranceDim)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"negotiation",
+      /*long_name=*/"Negotiation",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kSampledStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kGeneralSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"enable_proposals", GameParameter(kDefaultEnableProposals)},
+       {"enable_utterances", GameParameter(kDefaultEnableUtterances)},
+       {"num_items", GameParameter(kDefaultNumItems)},
+       {"num_symbols", GameParameter(kDefaultNumSymbols)},
+       {"rng_seed", GameParameter(kDefaultSeed)},
+       {"utterance_dim", GameParameter(kDefaultUtteranceDim)}}};
+  return kGameType;
+}
 
 static std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new NegotiationGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("negotiation", GetGameType, Factory);
 
 std::string TurnTypeToString(TurnType turn_type) {
   if (turn_type == TurnType::kProposal) {
@@ -72,6 +75,31 @@ std::string TurnTypeToString(TurnType turn_type) {
     SpielFatalError("Unrecognized turn type");
   }
 }
+
+// Fixed-base integer coding used for both proposals and utterances; only
+// the game's table construction runs these, so per-move encoding and
+// decoding never does digit arithmetic.
+std::vector<int> DecodeInteger(int encoded_value, int dimensions,
+                               int num_digit_values) {
+  std::vector<int> decoded(dimensions, 0);
+  int i = dimensions - 1;
+  while (encoded_value > 0) {
+    SPIEL_CHECK_GE(i, 0);
+    SPIEL_CHECK_LT(i, dimensions);
+    decoded[i] = encoded_value % num_digit_values;
+    encoded_value /= num_digit_values;
+    i--;
+  }
+  return decoded;
+}
+
+int EncodeInteger(const std::vector<int>& container, int num_digit_values) {
+  int encoded_value = 0;
+  for (int digit : container) {
+    encoded_value = encoded_value * num_digit_values + digit;
+  }
+  return encoded_value;
+}
 }  // namespace
 
 std::string NegotiationState::ActionToString(Player player,
@@ -84,12 +112,12 @@ std::string NegotiationState::ActionToString(Player player,
       if (move_id == parent_game_.NumDistinctProposals() - 1) {
         absl::StrAppend(&action_string, "Proposal: Agreement reached!");
       } else {
-        std::vector<int> proposal = DecodeProposal(move_id);
+        const std::vector<int>& proposal = DecodeProposal(move_id);
         std::string prop_str = absl::StrJoin(proposal, ", ");
         absl::StrAppend(&action_string, "Proposal: [", prop_str, "]");
       }
     } else {
-      std::vector<int> utterance = DecodeUtterance(move_id);
+      const std::vector<int>& utterance = DecodeUtterance(move_id);
       std::string utt_str = absl::StrJoin(utterance, ", ");
       absl::StrAppend(&action_string, ", Utterance: [", utt_str, "]");
     }
@@ -325,8 +353,7 @@ void NegotiationState::DoApplyAction(Action move_id) {
         // Agreement!
         agreement_reached_ = true;
       } else {
-        std::vector<int> proposal = DecodeProposal(move_id);
-        proposals_.push_back(proposal);
+        proposals_.push_back(DecodeProposal(move_id));
       }
 
       if (enable_utterances_) {
@@ -338,78 +365,21 @@ void NegotiationState::DoApplyAction(Action move_id) {
       }
     } else {
       SPIEL_CHECK_TRUE(enable_utterances_);
-      std::vector<int> utterance = DecodeUtterance(move_id);
-      utterances_.push_back(utterance);
+      utterances_.push_back(DecodeUtterance(move_id));
       turn_type_ = TurnType::kProposal;
       cur_player_ = 1 - cur_player_;
     }
   }
 }
 
-bool NegotiationState::NextProposal(std::vector<int>* proposal) const {
-  // Starting from the right, move left trying to increase the value. When
-  // successful, increment the value and set all the right digits back to 0.
-  for (int i = num_items_ - 1; i >= 0; --i) {
-    if ((*proposal)[i] + 1 <= item_pool_[i]) {
-      // Success!
-      (*proposal)[i]++;
-      for (int j = i + 1; j < num_items_; ++j) {
-        (*proposal)[j] = 0;
-      }
-      return true;
-    }
-  }
-
-  return false;
-}
-
-std::vector<int> NegotiationState::DecodeInteger(int encoded_value,
-                                                 int dimensions,
-                                                 int num_digit_values) const {
-  std::vector<int> decoded(dimensions, 0);
-  int i = dimensions - 1;
-  while (encoded_value > 0) {
-    SPIEL_CHECK_GE(i, 0);
-    SPIEL_CHECK_LT(i, dimensions);
-    decoded[i] = encoded_value % num_digit_values;
-    encoded_value /= num_digit_values;
-    i--;
-  }
-  return decoded;
-}
-
-int NegotiationState::EncodeInteger(const std::vector<int>& container,
-                                    int num_digit_values) const {
-  int encoded_value = 0;
-  for (int digit : container) {
-    encoded_value = encoded_value * num_digit_values + digit;
-  }
-  return encoded_value;
-}
-
-Action NegotiationState::EncodeProposal(
-    const std::vector<int>& proposal) const {
-  SPIEL_CHECK_EQ(proposal.size(), num_items_);
-  return EncodeInteger(proposal, kMaxQuantity + 1);
+const std::vector<int>& NegotiationState::DecodeProposal(
+    int encoded_proposal) const {
+  return parent_game_.DecodedProposal(encoded_proposal);
 }
 
-Action NegotiationState::EncodeUtterance(
-    const std::vector<int>& utterance) const {
-  SPIEL_CHECK_EQ(utterance.size(), utterance_dim_);
-  // Utterance ids are offset from zero (starting at NumDistinctProposals()).
-  return parent_game_.NumDistinctProposals() +
-         EncodeInteger(utterance, num_symbols_);
-}
-
-std::vector<int> NegotiationState::DecodeProposal(int encoded_proposal) const {
-  return DecodeInteger(encoded_proposal, num_items_, kMaxQuantity + 1);
-}
-
-std::vector<int> NegotiationState::DecodeUtterance(
+const std::vector<int>& NegotiationState::DecodeUtterance(
     int encoded_utterance) const {
-  // Utterance ids are offset from zero (starting at NumDistinctProposals()).
-  return DecodeInteger(encoded_utterance - parent_game_.NumDistinctProposals(),
-                       utterance_dim_, num_symbols_);
+  return parent_game_.DecodedUtterance(encoded_utterance);
 }
 
 std::vector<Action> NegotiationState::LegalActions() const {
@@ -418,15 +388,13 @@ std::vector<Action> NegotiationState::LegalActions() const {
   } else if (IsTerminal()) {
     return {};
   } else if (turn_type_ == TurnType::kProposal) {
+    // Proposals are always enabled; the game holds the enumeration for
+    // this item pool, so this is a copy rather than a walk of the splits.
+    const std::vector<Action>& proposals =
+        parent_game_.LegalProposals(item_pool_);
     std::vector<Action> legal_actions;
-
-    // Proposals are always enabled, so first contruct them.
-    std::vector<int> proposal(num_items_, 0);
-    legal_actions.push_back(EncodeProposal(proposal));
-
-    while (NextProposal(&proposal)) {
-      legal_actions.push_back(EncodeProposal(proposal));
-    }
+    legal_actions.reserve(proposals.size() + 1);
+    legal_actions.assign(proposals.begin(), proposals.end());
 
     if (!proposals_.empty()) {
       // Add the agreement action only if there's been at least one proposal.
@@ -490,7 +458,7 @@ std::unique_ptr<State> NegotiationState::Clone() const {
 }
 
 NegotiationGame::NegotiationGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       enable_proposals_(
           ParameterValue<bool>("enable_proposals", kDefaultEnableProposals)),
       enable_utterances_(
@@ -503,9 +471,11 @@ NegotiationGame::NegotiationGame(const GameParameters& params)
       legal_utterances_({}),
       rng_(new std::mt19937(seed_ >= 0 ? seed_ : std::mt19937::default_seed)) {
   ConstructLegalUtterances();
+  ConstructDecodingTables();
 }
 
-// Need to provide a custom copy constructor to clone the RNG.
+// Need to provide a custom copy constructor to clone the RNG. The decoding
+// tables are copied; the per-pool lists are rebuilt on demand.
 NegotiationGame::NegotiationGame(const NegotiationGame& other)
     : Game(other),
       enable_proposals_(other.enable_proposals_),
@@ -515,7 +485,9 @@ NegotiationGame::NegotiationGame(const NegotiationGame& other)
       utterance_dim_(other.utterance_dim_),
       seed_(other.seed_),
       legal_utterances_(other.legal_utterances_),
-      rng_(new std::mt19937(*other.rng_)) {}
+      rng_(new std::mt19937(*other.rng_)),
+      proposal_decodings_(other.proposal_decodings_),
+      utterance_decodings_(other.utterance_decodings_) {}
 
 void NegotiationGame::ConstructLegalUtterances() {
   if (enable_utterances_) {
@@ -526,6 +498,68 @@ void NegotiationGame::ConstructLegalUtterances() {
   }
 }
 
+void NegotiationGame::ConstructDecodingTables() {
+  // One decoded vector per proposal id (the trailing agreement action has
+  // no decoding). The table is the same size as one full LegalActions
+  // enumeration, so this does not change the game's memory order.
+  const int num_proposals = NumDistinctProposals() - 1;
+  proposal_decodings_.reserve(num_proposals);
+  for (int id = 0; id < num_proposals; ++id) {
+    proposal_decodings_.push_back(
+        DecodeInteger(id, num_items_, kMaxQuantity + 1));
+  }
+  if (enable_utterances_) {
+    utterance_decodings_.reserve(NumDistinctUtterances());
+    for (int id = 0; id < NumDistinctUtterances(); ++id) {
+      utterance_decodings_.push_back(
+          DecodeInteger(id, utterance_dim_, num_symbols_));
+    }
+  }
+}
+
+const std::vector<int>& NegotiationGame::DecodedProposal(Action action) const {
+  SPIEL_CHECK_GE(action, 0);
+  SPIEL_CHECK_LT(action, static_cast<Action>(proposal_decodings_.size()));
+  return proposal_decodings_[action];
+}
+
+const std::vector<int>& NegotiationGame::DecodedUtterance(Action action) const {
+  // Utterance ids are offset from zero (starting at NumDistinctProposals()).
+  const Action index = action - NumDistinctProposals();
+  SPIEL_CHECK_GE(index, 0);
+  SPIEL_CHECK_LT(index, static_cast<Action>(utterance_decodings_.size()));
+  return utterance_decodings_[index];
+}
+
+const std::vector<Action>& NegotiationGame::LegalProposals(
+    const std::vector<int>& item_pool) const {
+  const int pool_code = EncodeInteger(item_pool, kMaxQuantity + 1);
+  std::lock_guard<std::mutex> lock(pools_mutex_);
+  auto it = legal_proposals_.find(pool_code);
+  if (it != legal_proposals_.end()) {
+    return it->second;
+  }
+  // First sight of this pool: walk the splits once, as LegalActions used
+  // to per call. Starting from the right, move left trying to increase a
+  // quantity; when successful, set all the quantities to the right back
+  // to 0.
+  std::vector<Action>& actions = legal_proposals_[pool_code];
+  std::vector<int> proposal(num_items_, 0);
+  while (true) {
+    actions.push_back(EncodeInteger(proposal, kMaxQuantity + 1));
+    int i = num_items_ - 1;
+    for (; i >= 0; --i) {
+      if (proposal[i] + 1 <= item_pool[i]) {
+        proposal[i]++;
+        std::fill(proposal.begin() + i + 1, proposal.end(), 0);
+        break;
+      }
+    }
+    if (i < 0) break;
+  }
+  return actions;
+}
+
 int NegotiationGame::MaxGameLength() const {
   if (enable_utterances_) {
     return 2 * kMaxSteps;  // Every step is two turns: proposal, then utterance.
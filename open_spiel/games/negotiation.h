@@ -16,8 +16,10 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_NEGOTIATION_H_
 
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -110,23 +112,14 @@ class NegotiationState : public State {
   // Initialize state variables to start an episode.
   void InitializeEpisode();
 
-  // Get the next valid proposal; returns false when there are no more.
-  bool NextProposal(std::vector<int>* proposal) const;
-
-  // Action encoding and decoding helpers. Actions are encoded as follows:
-  // the first values { 0, 1, ... , NumDistinctProposals() - 1 } are reserved
-  // for proposals, encoded in the usual way (fixed base). The next
-  // NumDistinctUtterances() values are reserved for utterances, so these begin
-  // at an offset of NumDistinctProposals().
-  Action EncodeProposal(const std::vector<int>& proposal) const;
-  Action EncodeUtterance(const std::vector<int>& utterance) const;
-  std::vector<int> DecodeProposal(int encoded_proposal) const;
-  std::vector<int> DecodeUtterance(int encoded_utterance) const;
-
-  std::vector<int> DecodeInteger(int encoded_value, int dimensions,
-                                 int num_digit_values) const;
-  int EncodeInteger(const std::vector<int>& container,
-                    int num_digit_values) const;
+  // Action decoding. Actions are encoded as follows: the first values
+  // { 0, 1, ... , NumDistinctProposals() - 1 } are reserved for proposals,
+  // encoded in the usual way (fixed base). The next NumDistinctUtterances()
+  // values are reserved for utterances, so these begin at an offset of
+  // NumDistinctProposals(). Both decodes are lookups into tables the parent
+  // game builds once (see below).
+  const std::vector<int>& DecodeProposal(int encoded_proposal) const;
+  const std::vector<int>& DecodeUtterance(int encoded_utterance) const;
 
   const NegotiationGame& parent_game_;
   bool enable_proposals_;
@@ -195,8 +188,24 @@ class NegotiationGame : public Game {
     return legal_utterances_;
   }
 
+  // Decoded form of every proposal and utterance action, built once at
+  // construction so that per-move decoding is an indexed load instead of a
+  // digit-extraction loop. The references stay valid for the lifetime of
+  // the game.
+  const std::vector<int>& DecodedProposal(Action action) const;
+  const std::vector<int>& DecodedUtterance(Action action) const;
+
+  // The legal proposal actions for the given item pool (every split whose
+  // quantities fit within the pool, excluding the trailing agreement
+  // action). Pools are sampled per episode, so the per-pool lists are
+  // built on first sight and cached for the lifetime of the game;
+  // thereafter every state with the same pool shares one list.
+  const std::vector<Action>& LegalProposals(
+      const std::vector<int>& item_pool) const;
+
  private:
   void ConstructLegalUtterances();
+  void ConstructDecodingTables();
 
   bool enable_proposals_;
   bool enable_utterances_;
@@ -206,6 +215,17 @@ class NegotiationGame : public Game {
   int seed_;
   std::vector<Action> legal_utterances_;
   std::unique_ptr<std::mt19937> rng_;
+
+  // Decoding tables, indexed by proposal id and by utterance id minus the
+  // proposal offset.
+  std::vector<std::vector<int>> proposal_decodings_;
+  std::vector<std::vector<int>> utterance_decodings_;
+
+  // Per-pool legal proposal lists, keyed by the fixed-base encoding of the
+  // pool quantities. Filled lazily under the mutex; games are shared
+  // between threads, so the cache must be, too.
+  mutable std::mutex pools_mutex_;
+  mutable std::unordered_map<int, std::vector<Action>> legal_proposals_;
 };
 
 }  // namespace negotiation
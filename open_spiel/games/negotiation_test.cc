@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/negotiation.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -49,10 +50,45 @@ void BasicNegotiationTests() {
       100);
 }
 
+// The precomputed tables must agree with the arithmetic encoding they
+// replaced: every cached legal proposal decodes to a split that fits its
+// pool, re-encodes to itself, and the lists are enumeration-complete.
+void ActionTableTests() {
+  std::shared_ptr<const Game> game = LoadGame("negotiation");
+  const auto& negotiation_game = static_cast<const NegotiationGame&>(*game);
+  const int base = kMaxQuantity + 1;
+  for (const std::vector<int>& pool :
+       {std::vector<int>{0, 0, 0}, std::vector<int>{5, 5, 5},
+        std::vector<int>{2, 0, 4}}) {
+    const std::vector<Action>& proposals = negotiation_game.LegalProposals(pool);
+    int expected_size = 1;
+    for (int quantity : pool) expected_size *= quantity + 1;
+    SPIEL_CHECK_EQ(proposals.size(), expected_size);
+    for (Action action : proposals) {
+      const std::vector<int>& split = negotiation_game.DecodedProposal(action);
+      Action reencoded = 0;
+      for (int item = 0; item < split.size(); ++item) {
+        SPIEL_CHECK_LE(split[item], pool[item]);
+        reencoded = reencoded * base + split[item];
+      }
+      SPIEL_CHECK_EQ(reencoded, action);
+    }
+    // A second query returns the same cached list.
+    SPIEL_CHECK_TRUE(&proposals == &negotiation_game.LegalProposals(pool));
+  }
+  // Utterance ids start at the proposal offset and decode in order.
+  const std::vector<Action>& utterances = negotiation_game.LegalUtterances();
+  SPIEL_CHECK_EQ(utterances.front(), negotiation_game.NumDistinctProposals());
+  const std::vector<int>& first =
+      negotiation_game.DecodedUtterance(utterances.front());
+  for (int symbol : first) SPIEL_CHECK_EQ(symbol, 0);
+}
+
 }  // namespace
 }  // namespace negotiation
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::negotiation::BasicNegotiationTests();
+  open_spiel::negotiation::ActionTableTests();
 }
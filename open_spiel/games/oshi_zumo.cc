@@ -37,32 +37,35 @@ constexpr int kDefaultSize = 3;
 constexpr bool kDefaultAlesia = false;
 constexpr int kDefaultMinBid = 0;
 
-const GameType kGameType{
-    /*short_name=*/"oshi_zumo",
-    /*long_name=*/"Oshi Zumo",
-    GameType::Dynamics::kSimultaneous,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {{"alesia", GameParameter(kDefaultAlesia)},
-     {"coins", GameParameter(kDefaultCoins)},
-     {"size", GameParameter(kDefaultSize)},
-     {"horizon", GameParameter(kDefaultHorizon)},
-     {"min_bid", GameParameter(kDefaultMinBid)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"oshi_zumo",
+      /*long_name=*/"Oshi Zumo",
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {{"alesia", GameParameter(kDefaultAlesia)},
+       {"coins", GameParameter(kDefaultCoins)},
+       {"size", GameParameter(kDefaultSize)},
+       {"horizon", GameParameter(kDefaultHorizon)},
+       {"min_bid", GameParameter(kDefaultMinBid)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new OshiZumoGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("oshi_zumo", GetGameType, Factory);
 }  // namespace
 
 OshiZumoState::OshiZumoState(std::shared_ptr<const Game> game)
@@ -227,7 +230,7 @@ std::unique_ptr<State> OshiZumoState::Clone() const {
 }
 
 OshiZumoGame::OshiZumoGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       horizon_(ParameterValue<int>("horizon")),
       starting_coins_(ParameterValue<int>("coins")),
       size_(ParameterValue<int>("size")),
@@ -23,29 +23,32 @@ namespace oware {
 namespace {
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"oware",
-    /*long_name=*/"Oware",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"num_houses_per_player", GameParameter(kDefaultHousesPerPlayer)},
-     {"num_seeds_per_house", GameParameter(kDdefaultSeedsPerHouse)}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"oware",
+      /*long_name=*/"Oware",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"num_houses_per_player", GameParameter(kDefaultHousesPerPlayer)},
+       {"num_seeds_per_house", GameParameter(kDdefaultSeedsPerHouse)}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new OwareGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("oware", GetGameType, Factory);
 
 }  // namespace
 
@@ -56,7 +59,7 @@ OwareState::OwareState(std::shared_ptr<const Game> game,
       total_seeds_(kNumPlayers * num_seeds_per_house * num_houses_per_player),
       board_(/*num_houses_per_player=*/num_houses_per_player,
              /*num_seeds_per_house=*/num_seeds_per_house) {
-  boards_since_last_capture_.insert(board_);
+  boards_since_last_capture_.insert(board_.HashValue());
 }
 
 OwareState::OwareState(std::shared_ptr<const Game> game,
@@ -67,7 +70,7 @@ OwareState::OwareState(std::shared_ptr<const Game> game,
       board_(board) {
   SPIEL_CHECK_EQ(0, board.seeds.size() % kNumPlayers);
   SPIEL_CHECK_TRUE(IsTerminal() || !LegalActions().empty());
-  boards_since_last_capture_.insert(board_);
+  boards_since_last_capture_.insert(board_.HashValue());
 }
 
 std::vector<Action> OwareState::LegalActions() const {
@@ -175,16 +178,28 @@ int OwareState::DistributeSeeds(int house) {
   int to_distribute = board_.seeds[house];
   SPIEL_CHECK_NE(to_distribute, 0);
   board_.seeds[house] = 0;
-  int index = house;
-  while (to_distribute > 0) {
-    index = (index + 1) % NumHouses();
-    // Seeds are never sown into the house they were drawn from.
-    if (index != house) {
-      board_.seeds[index]++;
-      to_distribute--;
+  const int num_houses = NumHouses();
+  // Seeds are never sown into the house they were drawn from, so each full
+  // lap around the board drops one seed into every other house.
+  const int laps = to_distribute / (num_houses - 1);
+  if (laps > 0) {
+    for (int index = 0; index < num_houses; index++) {
+      if (index != house) {
+        board_.seeds[index] += laps;
+      }
     }
   }
-  return index;
+  const int remainder = to_distribute % (num_houses - 1);
+  if (remainder == 0) {
+    // The last seed of the final lap lands just before the starting house.
+    return (house + num_houses - 1) % num_houses;
+  }
+  // The remaining seeds land in the houses directly following the starting
+  // one, which they are too few to reach again.
+  for (int index = house + 1; index <= house + remainder; index++) {
+    board_.seeds[index % num_houses]++;
+  }
+  return (house + remainder) % num_houses;
 }
 
 bool OwareState::InOpponentRow(int house) const {
@@ -254,7 +269,7 @@ void OwareState::DoApplyAction(Action action) {
   }
   board_.current_player = 1 - board_.current_player;
 
-  if (!boards_since_last_capture_.insert(board_).second) {
+  if (!boards_since_last_capture_.insert(board_.HashValue()).second) {
     // We have game repetition, the game is ended.
     CollectAndTerminate();
   }
@@ -289,7 +304,7 @@ void OwareState::ObservationAsNormalizedVector(
 }
 
 OwareGame::OwareGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       num_houses_per_player_(ParameterValue<int>("num_houses_per_player"
                                                  )),
       num_seeds_per_house_(
@@ -71,6 +71,8 @@ class OwareState : public State {
   std::vector<double> Returns() const override;
   std::unique_ptr<State> Clone() const override;
   const OwareBoard& Board() const { return board_; }
+
+  uint64_t HashValue() const override { return board_.HashValue(); }
   std::string Observation(Player player) const override;
 
   // The game board is provided as a vector, encoding the players' seeds
@@ -139,21 +141,25 @@ class OwareState : public State {
 
   int NumHouses() const { return kNumPlayers * num_houses_per_player_; }
 
-  class OwareBoardHash {
+  // We are already indexing by board hash, so there is no need to hash that
+  // hash again, so we use a custom passthrough hasher.
+  class PassthroughHash {
    public:
-    std::size_t operator()(const OwareBoard& board) const {
-      return board.HashValue();
+    std::size_t operator()(uint64_t x) const {
+      return static_cast<std::size_t>(x);
     }
   };
 
   const int num_houses_per_player_;
   const int total_seeds_;
 
-  // We keep the set of visited board states to detect repetition, at which
-  // point the game ends and both players collect the seeds on their own row.
-  // Because captured seeds never enter the game again, this set is reset
-  // on any capture.
-  std::unordered_set<OwareBoard, OwareBoardHash> boards_since_last_capture_;
+  // We keep the hashes of the visited board states to detect repetition, at
+  // which point the game ends and both players collect the seeds on their own
+  // row. Because captured seeds never enter the game again, this set is reset
+  // on any capture. As in the chess repetition table, the 64-bit hashes stand
+  // in for the boards themselves, which keeps the set small and avoids
+  // copying the board on every move.
+  std::unordered_set<uint64_t, PassthroughHash> boards_since_last_capture_;
   OwareBoard board_;
 };
 
@@ -175,6 +181,7 @@ class OwareGame : public Game {
   }
 
   int MaxGameLength() const override { return kMaxGameLength; }
+  bool ProvidesHashValue() const override { return true; }
   std::vector<int> ObservationNormalizedVectorShape() const override;
 
  private:
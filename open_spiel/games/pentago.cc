@@ -24,30 +24,33 @@ namespace pentago {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"pentago",
-    /*long_name=*/"Pentago",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"ansi_color_output", GameParameter(false)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"pentago",
+      /*long_name=*/"Pentago",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"ansi_color_output", GameParameter(false)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new PentagoGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("pentago", GetGameType, Factory);
 
 struct Move {
   int x, y, xy;  // xy = x + y * kBoardSize
@@ -211,6 +214,32 @@ std::string PentagoState::ToString() const {
   return out.str();
 }
 
+std::string PentagoState::CanonicalString() const {
+  // All 8 symmetries of the square apply: a position is just the marble
+  // placement (quadrant rotations are part of the moves, not the state), so
+  // rotating or reflecting the whole board yields an equivalent game.
+  // Render the board under each transform of (x, y) and keep the smallest.
+  constexpr int kLast = kBoardSize - 1;
+  std::string canonical;
+  for (int sym = 0; sym < 8; ++sym) {
+    std::string transformed;
+    transformed.reserve(kBoardPositions);
+    for (int y = 0; y < kBoardSize; y++) {
+      for (int x = 0; x < kBoardSize; x++) {
+        int sx = x, sy = y;
+        if (sym & 1) sx = kLast - sx;              // Mirror horizontally.
+        if (sym & 2) sy = kLast - sy;              // Mirror vertically.
+        if (sym & 4) std::swap(sx, sy);            // Transpose.
+        Player p = get(sx, sy);
+        transformed.push_back(p == kPlayerNone ? '.'
+                                               : p == kPlayer1 ? 'O' : '@');
+      }
+    }
+    if (sym == 0 || transformed < canonical) canonical = transformed;
+  }
+  return canonical;
+}
+
 PentagoPlayer PentagoState::get(int i) const {
   return (board_[0] & xy_bit_mask[i]
               ? kPlayer1
@@ -263,13 +292,16 @@ void PentagoState::DoApplyAction(Action action) {
   }
   moves_made_++;
 
-  // Check the win conditions.
+  // Check the win conditions. A line of five needs five stones of one color
+  // on the board, which first happens on the ninth move.
   bool p1_won = false;
   bool p2_won = false;
-  for (int i = 0; i < kPossibleWinConditions; i++) {
-    uint64_t wm = win_mask[i];
-    if ((board_[0] & wm) == wm) p1_won = true;
-    if ((board_[1] & wm) == wm) p2_won = true;
+  if (moves_made_ >= 9) {
+    for (int i = 0; i < kPossibleWinConditions; i++) {
+      uint64_t wm = win_mask[i];
+      if ((board_[0] & wm) == wm) p1_won = true;
+      if ((board_[1] & wm) == wm) p2_won = true;
+    }
   }
 
   // Note that you can rotate such that you cause your opponent to win.
@@ -291,7 +323,7 @@ std::unique_ptr<State> PentagoState::Clone() const {
 }
 
 PentagoGame::PentagoGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       ansi_color_output_(ParameterValue<bool>("ansi_color_output")) {}
 
 }  // namespace pentago
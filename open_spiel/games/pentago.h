@@ -70,6 +70,22 @@ class PentagoState : public State {
   std::unique_ptr<State> Clone() const override;
   std::vector<Action> LegalActions() const override;
 
+  // Symmetry-reduced key over the 8 symmetries of the square: only the
+  // marble placement matters for the position, so the whole group of the
+  // board applies.
+  std::string CanonicalString() const override;
+
+  // Cheap transposition key mixing the two marble bitboards (the side to
+  // move follows from the marble counts).
+  uint64_t HashValue() const override {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t bits : board_) {
+      hash ^= bits;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -109,6 +125,8 @@ class PentagoGame : public Game {
     // Increase this by one if swap is ever implemented.
     return kBoardPositions;
   }
+  bool ProvidesCanonicalForm() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
 
  private:
   const bool ansi_color_output_ = false;
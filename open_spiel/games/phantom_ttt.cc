@@ -36,28 +36,31 @@ using tic_tac_toe::PlayerToState;
 using tic_tac_toe::StateToString;
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"phantom_ttt",
-    /*long_name=*/"Phantom Tic Tac Toe",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {{"obstype", GameParameter(static_cast<std::string>(kDefaultObsType))}}};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"phantom_ttt",
+      /*long_name=*/"Phantom Tic Tac Toe",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {{"obstype", GameParameter(static_cast<std::string>(kDefaultObsType))}}};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new PhantomTTTGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("phantom_ttt", GetGameType, Factory);
 
 }  // namespace
 
@@ -191,6 +194,7 @@ std::unique_ptr<State> PhantomTTTState::Clone() const {
 }
 
 void PhantomTTTState::UndoAction(Player player, Action move) {
+  InvalidateLegalActionsCache();
   Action last_move = action_sequence_.back().second;
   SPIEL_CHECK_EQ(last_move, move);
 
@@ -213,7 +217,7 @@ void PhantomTTTState::UndoAction(Player player, Action move) {
 }
 
 PhantomTTTGame::PhantomTTTGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       game_(std::static_pointer_cast<const tic_tac_toe::TicTacToeGame>(
           LoadGame("tic_tac_toe"))) {
   std::string obs_type =
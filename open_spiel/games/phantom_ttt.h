@@ -122,6 +122,7 @@ class PhantomTTTGame : public Game {
   // This will depend on the obstype parameter.
   std::vector<int> InformationStateNormalizedVectorShape() const override;
   int MaxGameLength() const { return kLongestSequence; }
+  bool ProvidesUndo() const override { return true; }
 
  private:
   std::shared_ptr<const tic_tac_toe::TicTacToeGame> game_;
@@ -39,33 +39,36 @@ constexpr int kDefaultPlayers = 2;
 constexpr int kDefaultWinScore = 100;
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"pig",
-    /*long_name=*/"Pig",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {
-        {"players", GameParameter(kDefaultPlayers)},
-        {"horizon", GameParameter(kDefaultHorizon)},
-        {"winscore", GameParameter(kDefaultWinScore)},
-        {"diceoutcomes", GameParameter(kDefaultDiceOutcomes)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"pig",
+      /*long_name=*/"Pig",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {
+          {"players", GameParameter(kDefaultPlayers)},
+          {"horizon", GameParameter(kDefaultHorizon)},
+          {"winscore", GameParameter(kDefaultWinScore)},
+          {"diceoutcomes", GameParameter(kDefaultDiceOutcomes)},
+      }};
+  return kGameType;
+}
 
 static std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new PigGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("pig", GetGameType, Factory);
 }  // namespace
 
 std::string PigState::ActionToString(Player player, Action move_id) const {
@@ -255,7 +258,7 @@ std::unique_ptr<State> PigState::Clone() const {
 }
 
 PigGame::PigGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       dice_outcomes_(ParameterValue<int>("diceoutcomes")),
       horizon_(ParameterValue<int>("horizon")),
       num_players_(ParameterValue<int>("players")),
@@ -28,34 +28,37 @@ namespace quoridor {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"quoridor",
-    /*long_name=*/"Quoridor",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"board_size", GameParameter(kDefaultBoardSize)},
-        // A default will be computed from the board_size
-        {"wall_count",
-         GameParameter(GameParameter::Type::kInt, /*is_mandatory=*/false)},
-        {"ansi_color_output", GameParameter(false)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"quoridor",
+      /*long_name=*/"Quoridor",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"board_size", GameParameter(kDefaultBoardSize)},
+          // A default will be computed from the board_size
+          {"wall_count",
+           GameParameter(GameParameter::Type::kInt, /*is_mandatory=*/false)},
+          {"ansi_color_output", GameParameter(false)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new QuoridorGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("quoridor", GetGameType, Factory);
 
 }  // namespace
 
@@ -489,7 +492,7 @@ std::unique_ptr<State> QuoridorState::Clone() const {
 }
 
 QuoridorGame::QuoridorGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       board_size_(ParameterValue<int>("board_size")),
       wall_count_(
           ParameterValue<int>("wall_count", board_size_ * board_size_ / 8)),
@@ -26,28 +26,31 @@ namespace tic_tac_toe {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"tic_tac_toe",
-    /*long_name=*/"Tic Tac Toe",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"tic_tac_toe",
+      /*long_name=*/"Tic Tac Toe",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new TicTacToeGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("tic_tac_toe", GetGameType, Factory);
 
 }  // namespace
 
@@ -76,8 +79,55 @@ std::string StateToString(CellState state) {
   }
 }
 
+namespace {
+
+// The 8 symmetries of the 3x3 board (rotations, reflections and their
+// compositions). kSymmetries[s][i] is the cell whose contents land on cell
+// i after applying symmetry s; entry 0 is the identity.
+constexpr int kNumSymmetries = 8;
+constexpr int kSymmetries[kNumSymmetries][kNumCells] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8},  // Identity.
+    {6, 3, 0, 7, 4, 1, 8, 5, 2},  // Rotation by 90 degrees.
+    {8, 7, 6, 5, 4, 3, 2, 1, 0},  // Rotation by 180 degrees.
+    {2, 5, 8, 1, 4, 7, 0, 3, 6},  // Rotation by 270 degrees.
+    {2, 1, 0, 5, 4, 3, 8, 7, 6},  // Reflection of the columns.
+    {6, 7, 8, 3, 4, 5, 0, 1, 2},  // Reflection of the rows.
+    {0, 3, 6, 1, 4, 7, 2, 5, 8},  // Reflection in the main diagonal.
+    {8, 5, 2, 7, 4, 1, 6, 3, 0},  // Reflection in the anti-diagonal.
+};
+
+}  // namespace
+
+std::string TicTacToeState::CanonicalString() const {
+  std::string canonical;
+  for (int sym = 0; sym < kNumSymmetries; ++sym) {
+    std::string transformed;
+    transformed.reserve(kNumCells);
+    for (int cell = 0; cell < kNumCells; ++cell) {
+      transformed.append(StateToString(board_[kSymmetries[sym][cell]]));
+    }
+    if (sym == 0 || transformed < canonical) canonical = transformed;
+  }
+  return canonical;
+}
+
+uint64_t TicTacToeState::CanonicalHash() const {
+  // The minimal base-3 board encoding over the symmetry group; the
+  // symmetry achieving it is the same one CanonicalString picks, since
+  // both compare the transformed cells in the same order.
+  uint64_t canonical_key = 0;
+  for (int sym = 0; sym < kNumSymmetries; ++sym) {
+    uint64_t key = 0;
+    for (int cell = 0; cell < kNumCells; ++cell) {
+      key = key * 3 + static_cast<uint64_t>(board_[kSymmetries[sym][cell]]);
+    }
+    if (sym == 0 || key < canonical_key) canonical_key = key;
+  }
+  return canonical_key;
+}
+
 void TicTacToeState::DoApplyAction(Action move) {
-  SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
+  SPIEL_DCHECK_EQ(board_[move], CellState::kEmpty);
   board_[move] = PlayerToState(CurrentPlayer());
   current_player_ = 1 - current_player_;
 }
@@ -94,10 +144,43 @@ std::vector<Action> TicTacToeState::LegalActions() const {
   return moves;
 }
 
+std::vector<int> TicTacToeState::LegalActionsMask() const {
+  // Actions are cells, so the mask comes straight off the board.
+  std::vector<int> mask(kNumCells, 0);
+  if (IsTerminal()) return mask;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (board_[cell] == CellState::kEmpty) mask[cell] = 1;
+  }
+  return mask;
+}
+
+Action TicTacToeState::SampleLegalAction(double z) const {
+  // Count the empty cells and index into them, with no action list built.
+  int num_moves = 0;
+  for (CellState cell : board_) {
+    if (cell == CellState::kEmpty) ++num_moves;
+  }
+  SPIEL_DCHECK_GT(num_moves, 0);
+  int index = static_cast<int>(z * num_moves);
+  if (index >= num_moves) index = num_moves - 1;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (board_[cell] == CellState::kEmpty && index-- == 0) return cell;
+  }
+  SpielFatalError("No empty cells to sample.");
+}
+
 std::string TicTacToeState::ActionToString(Player player,
                                            Action action_id) const {
-  return absl::StrCat(StateToString(PlayerToState(player)), "(",
-                      action_id % kNumCols, ",", action_id / kNumCols, ")");
+  std::string out;
+  ActionToString(player, action_id, &out);
+  return out;
+}
+
+void TicTacToeState::ActionToString(Player player, Action action_id,
+                                    std::string* out) const {
+  out->clear();
+  absl::StrAppend(out, StateToString(PlayerToState(player)), "(",
+                  action_id % kNumCols, ",", action_id / kNumCols, ")");
 }
 
 bool TicTacToeState::HasLine(Player player) const {
@@ -173,6 +256,7 @@ void TicTacToeState::ObservationAsNormalizedVector(
 }
 
 void TicTacToeState::UndoAction(Player player, Action move) {
+  InvalidateLegalActionsCache();
   board_[move] = CellState::kEmpty;
   current_player_ = player;
   history_.pop_back();
@@ -183,7 +267,7 @@ std::unique_ptr<State> TicTacToeState::Clone() const {
 }
 
 TicTacToeGame::TicTacToeGame(const GameParameters& params)
-    : Game(kGameType, params) {}
+    : Game(GetGameType(), params) {}
 
 }  // namespace tic_tac_toe
 }  // namespace open_spiel
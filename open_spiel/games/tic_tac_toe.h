@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "open_spiel/spiel.h"
+#include "open_spiel/tensor_shape.h"
 
 // Simple game of Noughts and Crosses:
 // https://en.wikipedia.org/wiki/Tic-tac-toe
@@ -41,6 +42,9 @@ inline constexpr int kCellStates = 1 + kNumPlayers;  // empty, 'x', and 'o'.
 // https://math.stackexchange.com/questions/485752/tictactoe-state-space-choose-calculation/485852
 inline constexpr int kNumberStates = 5478;
 
+// Compile-time observation tensor shape (see open_spiel/tensor_shape.h).
+using ObservationShape = TensorShape<kCellStates, kNumRows, kNumCols>;
+
 // State of a cell.
 enum class CellState {
   kEmpty,
@@ -60,6 +64,8 @@ class TicTacToeState : public State {
     return IsTerminal() ? kTerminalPlayerId : current_player_;
   }
   std::string ActionToString(Player player, Action action_id) const override;
+  void ActionToString(Player player, Action action_id,
+                      std::string* out) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
@@ -70,11 +76,27 @@ class TicTacToeState : public State {
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action move) override;
   std::vector<Action> LegalActions() const override;
+  std::vector<int> LegalActionsMask() const override;
+  Action SampleLegalAction(double z) const override;
   CellState BoardAt(int cell) const { return board_[cell]; }
   CellState BoardAt(int row, int column) const {
     return board_[row * kNumCols + column];
   }
 
+  // Cheap transposition key: the board encoded in base 3 (the side to move
+  // follows from the number of filled cells).
+  uint64_t HashValue() const override {
+    uint64_t key = 0;
+    for (CellState cell : board_) {
+      key = key * 3 + static_cast<uint64_t>(cell);
+    }
+    return key;
+  }
+
+  // Symmetry-reduced keys over the 8 symmetries of the square.
+  std::string CanonicalString() const override;
+  uint64_t CanonicalHash() const override;
+
  protected:
   std::array<CellState, kNumCells> board_;
   void DoApplyAction(Action move) override;
@@ -101,9 +123,12 @@ class TicTacToeGame : public Game {
     return std::shared_ptr<const Game>(new TicTacToeGame(*this));
   }
   std::vector<int> ObservationNormalizedVectorShape() const override {
-    return {kCellStates, kNumRows, kNumCols};
+    return ObservationShape::AsVector();
   }
   int MaxGameLength() const { return kNumCells; }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesHashValue() const override { return true; }
+  bool ProvidesCanonicalForm() const override { return true; }
 };
 
 CellState PlayerToState(Player player);
@@ -114,6 +139,12 @@ inline std::ostream& operator<<(std::ostream& stream, const CellState& state) {
 }
 
 }  // namespace tic_tac_toe
+
+template <>
+struct ObservationTensorTraits<tic_tac_toe::TicTacToeGame> {
+  using Shape = tic_tac_toe::ObservationShape;
+};
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_TIC_TAC_TOE_H_
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <random>
+
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -27,10 +29,58 @@ void BasicTicTacToeTests() {
   testing::RandomSimTest(*LoadGame("tic_tac_toe"), 100);
 }
 
+// The board-scanning SampleLegalAction must agree with indexing into the
+// materialized action list, for any z.
+void SampleLegalActionMatchesLegalActions() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::mt19937 rng(87361);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int sim = 0; sim < 20; ++sim) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> legal_actions = state->LegalActions();
+      for (int draw = 0; draw < 5; ++draw) {
+        const double z = uniform(rng);
+        const int index = std::min(static_cast<int>(z * legal_actions.size()),
+                                   static_cast<int>(legal_actions.size()) - 1);
+        SPIEL_CHECK_EQ(state->SampleLegalAction(z), legal_actions[index]);
+      }
+      state->ApplyAction(state->SampleLegalAction(uniform(rng)));
+    }
+  }
+}
+
+// Playing a game and its mirror image must land on the same canonical
+// form; adding a move that breaks the symmetry must change it.
+void CanonicalFormTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_TRUE(game->ProvidesCanonicalForm());
+
+  // The column reflection (r, c) -> (r, 2 - c) as a cell map.
+  constexpr int kMirror[] = {2, 1, 0, 5, 4, 3, 8, 7, 6};
+  const std::vector<Action> moves = {4, 0, 8, 1};
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::unique_ptr<State> mirrored = game->NewInitialState();
+  for (Action move : moves) {
+    state->ApplyAction(move);
+    mirrored->ApplyAction(kMirror[move]);
+    SPIEL_CHECK_EQ(state->CanonicalString(), mirrored->CanonicalString());
+    SPIEL_CHECK_EQ(state->CanonicalHash(), mirrored->CanonicalHash());
+    // The canonical key is the minimum over a group that includes the
+    // identity, so it can never exceed the plain board key.
+    SPIEL_CHECK_LE(state->CanonicalHash(), state->HashValue());
+  }
+  state->ApplyAction(2);
+  mirrored->ApplyAction(3);
+  SPIEL_CHECK_NE(state->CanonicalHash(), mirrored->CanonicalHash());
+}
+
 }  // namespace
 }  // namespace tic_tac_toe
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::tic_tac_toe::BasicTicTacToeTests();
+  open_spiel::tic_tac_toe::SampleLegalActionMatchesLegalActions();
+  open_spiel::tic_tac_toe::CanonicalFormTest();
 }
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/tiny_bridge.h"
 
+#include <unordered_map>
+
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/algorithms/minimax.h"
 #include "open_spiel/spiel.h"
@@ -93,71 +95,80 @@ std::pair<int, int> ChanceOutcomeToCards(int outcome) {
 }
 
 // Facts about the game
-const GameType kGameType2p{
-    /*short_name=*/"tiny_bridge_2p",
-    /*long_name=*/"Tiny Bridge (Uncontested)",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
-};
-
-const GameType kGameType4p{
-    /*short_name=*/"tiny_bridge_4p",
-    /*long_name=*/"Tiny Bridge (Contested)",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/4,
-    /*min_num_players=*/4,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
-};
+const GameType& GetGameType2p() {
+  static const GameType kGameType2p{
+      /*short_name=*/"tiny_bridge_2p",
+      /*long_name=*/"Tiny Bridge (Uncontested)",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType2p;
+}
+
+const GameType& GetGameType4p() {
+  static const GameType kGameType4p{
+      /*short_name=*/"tiny_bridge_4p",
+      /*long_name=*/"Tiny Bridge (Contested)",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/4,
+      /*min_num_players=*/4,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return kGameType4p;
+}
 
 // Game for the play of the cards. We don't register this - it is for internal
 // use only, computing the payoff of a tiny bridge auction.
-const GameType kGameTypePlay{
-    /*short_name=*/"tiny_bridge_play",
-    /*long_name=*/"Tiny Bridge (Play Phase)",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/false,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/false,
-    /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/
-    {
-        {"trumps",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-        {"leader",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-        {"hand_W",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-        {"hand_N",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-        {"hand_E",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-        {"hand_S",
-         GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
-    }};
+const GameType& GetGameTypePlay() {
+  static const GameType kGameTypePlay{
+      /*short_name=*/"tiny_bridge_play",
+      /*long_name=*/"Tiny Bridge (Play Phase)",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/false,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/false,
+      /*provides_observation_as_normalized_vector=*/false,
+      /*parameter_specification=*/
+      {
+          {"trumps",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+          {"leader",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+          {"hand_W",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+          {"hand_N",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+          {"hand_E",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+          {"hand_S",
+           GameParameter(GameParameter::Type::kString, /*is_mandatory=*/true)},
+      }};
+  return kGameTypePlay;
+}
 
 std::shared_ptr<const Game> Factory2p(const GameParameters& params) {
   return std::shared_ptr<const Game>(new TinyBridgeGame2p(params));
@@ -167,8 +178,8 @@ std::shared_ptr<const Game> Factory4p(const GameParameters& params) {
   return std::shared_ptr<const Game>(new TinyBridgeGame4p(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType2p, Factory2p);
-REGISTER_SPIEL_GAME(kGameType4p, Factory4p);
+REGISTER_SPIEL_GAME("tiny_bridge_2p", GetGameType2p, Factory2p);
+REGISTER_SPIEL_GAME("tiny_bridge_4p", GetGameType4p, Factory4p);
 
 // Score a played-out hand.
 // Score is 1 for the second trick, 2 for slam (bidding and making two).
@@ -183,24 +194,46 @@ int Score(int contract, int tricks, bool doubled, bool redoubled) {
   return score * double_factor;
 }
 
+// Number of tricks the declaring side takes with best play of the deal, from
+// a minimax search of the play phase. Solving the play is far more expensive
+// than the auction around it and CFR-style algorithms revisit the same few
+// thousand (deal, contract) combinations millions of times, so results are
+// cached under a key packing the holder of each card with the trump suit,
+// leader and declarer.
+int SolveTricks(const std::array<int, kNumCards>& holder, int trumps,
+                int leader, int declarer) {
+  uint32_t key = 0;
+  for (int card = 0; card < kNumCards; ++card) key = key * 4 + holder[card];
+  key = ((key * 3 + trumps) * 4 + leader) * 2 + declarer;
+  static auto* cache = new std::unordered_map<uint32_t, int>();
+  auto it = cache->find(key);
+  if (it != cache->end()) return it->second;
+  static std::shared_ptr<Game> game(new TinyBridgePlayGame({}));
+  TinyBridgePlayState play{game, trumps, leader, holder};
+  const int tricks =
+      algorithms::AlphaBetaSearch(*game, &play, nullptr, -1, declarer).first;
+  cache->emplace(key, tricks);
+  return tricks;
+}
+
 }  // namespace
 
 TinyBridgeGame2p::TinyBridgeGame2p(const GameParameters& params)
-    : Game(kGameType2p, params) {}
+    : Game(GetGameType2p(), params) {}
 
 std::unique_ptr<State> TinyBridgeGame2p::NewInitialState() const {
   return std::unique_ptr<State>(new TinyBridgeAuctionState(shared_from_this()));
 }
 
 TinyBridgeGame4p::TinyBridgeGame4p(const GameParameters& params)
-    : Game(kGameType4p, params) {}
+    : Game(GetGameType4p(), params) {}
 
 std::unique_ptr<State> TinyBridgeGame4p::NewInitialState() const {
   return std::unique_ptr<State>(new TinyBridgeAuctionState(shared_from_this()));
 }
 
 TinyBridgePlayGame::TinyBridgePlayGame(const GameParameters& params)
-    : Game(kGameTypePlay, params) {}
+    : Game(GetGameTypePlay(), params) {}
 
 std::unique_ptr<State> TinyBridgePlayGame::NewInitialState() const {
   int trumps = CharToTrumps(ParameterValue<std::string>("trumps")[0]);
@@ -256,14 +289,11 @@ TinyBridgeAuctionState::AuctionState TinyBridgeAuctionState::AnalyzeAuction()
 
 int TinyBridgeAuctionState::Score_p0(std::array<int, kNumCards> holder) const {
   auto state = AnalyzeAuction();
-  std::shared_ptr<Game> game(new TinyBridgePlayGame({}));
   int trumps = (state.last_bid - 1) % 3;
   int leader = num_players_ == 2 ? (state.last_bidder * 2 + 1)
                                  : (state.last_bidder + 1) % 4;
   int decl = num_players_ == 2 ? 0 : state.last_bidder % 2;
-  TinyBridgePlayState play{game, trumps, leader, holder};
-  const int tricks =
-      algorithms::AlphaBetaSearch(*game, &play, nullptr, -1, decl).first;
+  const int tricks = SolveTricks(holder, trumps, leader, decl);
   const int declarer_score =
       Score(state.last_bid, tricks, state.doubler != kInvalidPlayer,
             state.redoubler != kInvalidPlayer);
@@ -434,6 +464,23 @@ std::vector<double> TinyBridgeAuctionState::Returns() const {
   }
 }
 
+uint64_t TinyBridgeAuctionState::InformationStateKey(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // The auction sequence behind a sentinel digit, then the player's hand.
+  // Auction actions fit in one base-(kNumActions + 1) digit each; the key
+  // would overflow after 17 auction actions, which cannot be reached in the
+  // 2p game and is checked for in the 4p game.
+  SPIEL_CHECK_LE(static_cast<int>(actions_.size()) - num_players_, 17);
+  uint64_t key = 1;
+  for (int i = num_players_; i < actions_.size(); ++i) {
+    key = key * (kNumActions + 1) + actions_[i] + 1;
+  }
+  uint64_t hand = IsDealt(player) ? actions_[player] + 1 : 0;
+  return key * (kNumCards * (kNumCards - 1) / 2 + 1) + hand;
+}
+
 std::string TinyBridgeAuctionState::InformationState(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
@@ -519,7 +566,9 @@ std::unique_ptr<State> TinyBridgeAuctionState::Clone() const {
 }
 
 void TinyBridgeAuctionState::UndoAction(Player player, Action action) {
+  InvalidateLegalActionsCache();
   actions_.pop_back();
+  history_.pop_back();
   is_terminal_ = false;
 }
 
@@ -595,6 +644,7 @@ std::unique_ptr<State> TinyBridgePlayState::Clone() const {
 }
 
 void TinyBridgePlayState::UndoAction(Player player, Action action) {
+  InvalidateLegalActionsCache();
   actions_.pop_back();
   history_.pop_back();
 }
@@ -85,6 +85,8 @@ class TinyBridgeGame2p : public Game {
   double MinUtility() const override { return -3; }
   double MaxUtility() const override { return 3; }
   int MaxGameLength() const override { return 8; }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesInformationStateKey() const override { return true; }
   int MaxChanceOutcomes() const override { return 28; }
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new TinyBridgeGame2p(*this));
@@ -108,6 +110,8 @@ class TinyBridgeGame4p : public Game {
   double UtilitySum() const override { return 0; }
   double MaxUtility() const override { return 12; }
   int MaxGameLength() const override { return 57; }
+  bool ProvidesUndo() const override { return true; }
+  bool ProvidesInformationStateKey() const override { return true; }
   int MaxChanceOutcomes() const override { return 28; }
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new TinyBridgeGame4p(*this));
@@ -124,6 +128,7 @@ class TinyBridgePlayGame : public Game {
   double MinUtility() const override { return 0; }
   double MaxUtility() const override { return kNumTricks; }
   int MaxGameLength() const override { return 8; }
+  bool ProvidesUndo() const override { return true; }
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new TinyBridgePlayGame(*this));
   }
@@ -142,6 +147,7 @@ class TinyBridgeAuctionState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(Player player) const override;
+  uint64_t InformationStateKey(Player player) const override;
   void InformationStateAsNormalizedVector(
       Player player, std::vector<double>* values) const override;
   std::string Observation(Player player) const override;
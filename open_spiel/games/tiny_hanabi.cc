@@ -51,33 +51,36 @@ std::vector<int> ParsePayoffString(const std::string& str) {
 }
 
 // Facts about the game
-const GameType kGameType{
-    /*short_name=*/"tiny_hanabi",
-    /*long_name=*/"Tiny Hanabi",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kExplicitStochastic,
-    GameType::Information::kImperfectInformation,
-    GameType::Utility::kIdentical,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/10,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/true,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"num_players", GameParameter(2)},
-        {"num_chance", GameParameter(2)},
-        {"num_actions", GameParameter(3)},
-        {"payoff", GameParameter(std::string(kDefaultPayoffString))},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"tiny_hanabi",
+      /*long_name=*/"Tiny Hanabi",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kExplicitStochastic,
+      GameType::Information::kImperfectInformation,
+      GameType::Utility::kIdentical,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/10,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"num_players", GameParameter(2)},
+          {"num_chance", GameParameter(2)},
+          {"num_actions", GameParameter(3)},
+          {"payoff", GameParameter(std::string(kDefaultPayoffString))},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new TinyHanabiGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("tiny_hanabi", GetGameType, Factory);
 
 }  // namespace
 
@@ -87,7 +90,7 @@ std::unique_ptr<State> TinyHanabiGame::NewInitialState() const {
 }
 
 TinyHanabiGame::TinyHanabiGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       payoff_(ParameterValue<int>("num_players"),
               ParameterValue<int>("num_chance"),
               ParameterValue<int>("num_actions"),
@@ -25,31 +25,34 @@ namespace y_game {
 namespace {
 
 // Facts about the game.
-const GameType kGameType{
-    /*short_name=*/"y",
-    /*long_name=*/"Y Connection Game",
-    GameType::Dynamics::kSequential,
-    GameType::ChanceMode::kDeterministic,
-    GameType::Information::kPerfectInformation,
-    GameType::Utility::kZeroSum,
-    GameType::RewardModel::kTerminal,
-    /*max_num_players=*/2,
-    /*min_num_players=*/2,
-    /*provides_information_state=*/true,
-    /*provides_information_state_as_normalized_vector=*/false,
-    /*provides_observation=*/true,
-    /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/
-    {
-        {"board_size", GameParameter(kDefaultBoardSize)},
-        {"ansi_color_output", GameParameter(false)},
-    }};
+const GameType& GetGameType() {
+  static const GameType kGameType{
+      /*short_name=*/"y",
+      /*long_name=*/"Y Connection Game",
+      GameType::Dynamics::kSequential,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kPerfectInformation,
+      GameType::Utility::kZeroSum,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/false,
+      /*provides_observation=*/true,
+      /*provides_observation_as_normalized_vector=*/true,
+      /*parameter_specification=*/
+      {
+          {"board_size", GameParameter(kDefaultBoardSize)},
+          {"ansi_color_output", GameParameter(false)},
+      }};
+  return kGameType;
+}
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   return std::shared_ptr<const Game>(new YGame(params));
 }
 
-REGISTER_SPIEL_GAME(kGameType, Factory);
+REGISTER_SPIEL_GAME("y", GetGameType, Factory);
 
 // The board is represented as a flattened 2d array of the form:
 //   1 2 3
@@ -310,7 +313,7 @@ std::unique_ptr<State> YState::Clone() const {
 }
 
 YGame::YGame(const GameParameters& params)
-    : Game(kGameType, params),
+    : Game(GetGameType(), params),
       board_size_(ParameterValue<int>("board_size")),
       ansi_color_output_(ParameterValue<bool>("ansi_color_output")) {}
 
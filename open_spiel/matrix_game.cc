@@ -92,6 +92,73 @@ std::unique_ptr<State> MatrixGame::NewInitialState() const {
   return std::unique_ptr<State>(new MatrixState(shared_from_this()));
 }
 
+double MatrixGame::ExpectedUtility(
+    Player player, const std::vector<double>& row_strategy,
+    const std::vector<double>& col_strategy) const {
+  const int num_rows = NumRows();
+  const int num_cols = NumCols();
+  SPIEL_CHECK_EQ(row_strategy.size(), num_rows);
+  SPIEL_CHECK_EQ(col_strategy.size(), num_cols);
+  const double* utils =
+      (player == kRowPlayer ? row_utilities_ : col_utilities_).data();
+  const double* col_probs = col_strategy.data();
+  double total = 0;
+  // One contiguous dot product per row; both loops vectorize.
+  for (int r = 0; r < num_rows; ++r) {
+    const double* row = utils + r * num_cols;
+    double row_value = 0;
+    for (int c = 0; c < num_cols; ++c) {
+      row_value += row[c] * col_probs[c];
+    }
+    total += row_strategy[r] * row_value;
+  }
+  return total;
+}
+
+void MatrixGame::BestResponseUtilities(
+    Player player, const std::vector<double>& opponent_strategy,
+    std::vector<double>* utilities) const {
+  const int num_rows = NumRows();
+  const int num_cols = NumCols();
+  if (player == kRowPlayer) {
+    SPIEL_CHECK_EQ(opponent_strategy.size(), num_cols);
+    utilities->resize(num_rows);
+    const double* col_probs = opponent_strategy.data();
+    for (int r = 0; r < num_rows; ++r) {
+      const double* row = row_utilities_.data() + r * num_cols;
+      double row_value = 0;
+      for (int c = 0; c < num_cols; ++c) {
+        row_value += row[c] * col_probs[c];
+      }
+      (*utilities)[r] = row_value;
+    }
+  } else {
+    SPIEL_CHECK_TRUE(player == kColPlayer);
+    SPIEL_CHECK_EQ(opponent_strategy.size(), num_rows);
+    // Accumulate the column sums row by row (an axpy per row) so the payoff
+    // matrix is still walked contiguously rather than down strided columns.
+    utilities->assign(num_cols, 0);
+    double* out = utilities->data();
+    for (int r = 0; r < num_rows; ++r) {
+      const double row_prob = opponent_strategy[r];
+      if (row_prob == 0) continue;
+      const double* row = col_utilities_.data() + r * num_cols;
+      for (int c = 0; c < num_cols; ++c) {
+        out[c] += row_prob * row[c];
+      }
+    }
+  }
+}
+
+Action MatrixGame::BestResponse(
+    Player player, const std::vector<double>& opponent_strategy) const {
+  std::vector<double> utilities;
+  BestResponseUtilities(player, opponent_strategy, &utilities);
+  return std::distance(
+      utilities.begin(),
+      std::max_element(utilities.begin(), utilities.end()));
+}
+
 std::vector<double> FlattenMatrix(
     const std::vector<std::vector<double>>& matrix_rows) {
   std::vector<double> utilities;
@@ -99,6 +99,26 @@ class MatrixGame : public NormalFormGame {
     return (player == Player{0} ? row_utilities_[Index(row, col)]
                                 : col_utilities_[Index(row, col)]);
   }
+  // Expected utility for `player` under mixed strategies for both players:
+  // p^T A q over the player's payoff matrix. The kernel walks the row-major
+  // payoffs contiguously so compilers can vectorize it; use this rather than
+  // summing PlayerUtility calls in fictitious-play-style loops.
+  double ExpectedUtility(Player player, const std::vector<double>& row_strategy,
+                         const std::vector<double>& col_strategy) const;
+
+  // Fills `utilities` with the utility of each of `player`'s pure strategies
+  // against the opponent's mixed strategy (size NumRows() for the row player,
+  // NumCols() for the column player) — the batch kernel behind best response
+  // and regret updates in normal-form algorithms.
+  void BestResponseUtilities(Player player,
+                             const std::vector<double>& opponent_strategy,
+                             std::vector<double>* utilities) const;
+
+  // Returns a pure best response to the opponent's mixed strategy: the
+  // argmax of BestResponseUtilities, lowest index winning ties.
+  Action BestResponse(Player player,
+                      const std::vector<double>& opponent_strategy) const;
+
   const std::string& RowActionName(int row) const {
     return row_action_names_[row];
   }
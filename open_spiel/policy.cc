@@ -14,6 +14,16 @@
 
 #include "open_spiel/policy.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <memory>
 
@@ -34,6 +44,820 @@ double GetProb(const ActionsAndProbs& action_and_probs, Action action) {
 TabularPolicy::TabularPolicy(const Game& game)
     : TabularPolicy(GetRandomPolicy(game)) {}
 
+int64_t TabularPolicy::EstimatedMemory() const {
+  int64_t bytes = sizeof(TabularPolicy) +
+                  policy_table_.bucket_count() * sizeof(void*);
+  for (const auto& entry : policy_table_) {
+    bytes += sizeof(entry) + entry.first.capacity() +
+             entry.second.capacity() * sizeof(ActionsAndProbs::value_type);
+  }
+  stats::SetGauge(stats::kPolicyTableBytes, bytes);
+  return bytes;
+}
+
+FlatTabularPolicy::FlatTabularPolicy(const TabularPolicy& policy) {
+  Freeze(policy.PolicyTable());
+}
+
+FlatTabularPolicy::FlatTabularPolicy(
+    const std::unordered_map<std::string, ActionsAndProbs>& table) {
+  Freeze(table);
+}
+
+void FlatTabularPolicy::Freeze(
+    const std::unordered_map<std::string, ActionsAndProbs>& table) {
+  std::vector<const std::string*> sorted_keys;
+  sorted_keys.reserve(table.size());
+  int64_t total_key_bytes = 0;
+  int total_pairs = 0;
+  for (const auto& entry : table) {
+    sorted_keys.push_back(&entry.first);
+    total_key_bytes += entry.first.size();
+    total_pairs += entry.second.size();
+  }
+  std::sort(sorted_keys.begin(), sorted_keys.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  keys_.reserve(total_key_bytes);
+  key_offset_.reserve(sorted_keys.size() + 1);
+  pair_offset_.reserve(sorted_keys.size() + 1);
+  pairs_.reserve(total_pairs);
+  key_offset_.push_back(0);
+  pair_offset_.push_back(0);
+  for (const std::string* key : sorted_keys) {
+    const ActionsAndProbs& actions_and_probs = table.at(*key);
+    keys_.append(*key);
+    pairs_.insert(pairs_.end(), actions_and_probs.begin(),
+                  actions_and_probs.end());
+    key_offset_.push_back(keys_.size());
+    pair_offset_.push_back(pairs_.size());
+  }
+}
+
+int FlatTabularPolicy::FindEntry(const std::string& info_state) const {
+  int lo = 0;
+  int hi = NumEntries();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    const int cmp =
+        keys_.compare(key_offset_[mid], key_offset_[mid + 1] - key_offset_[mid],
+                      info_state);
+    if (cmp == 0) {
+      return mid;
+    } else if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
+ActionsAndProbs FlatTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  const int entry = FindEntry(info_state);
+  if (entry < 0) return {};
+  return ActionsAndProbs(pairs_.begin() + pair_offset_[entry],
+                         pairs_.begin() + pair_offset_[entry + 1]);
+}
+
+void FlatTabularPolicy::GetStatePolicyInto(const std::string& info_state,
+                                           ActionsAndProbs* out) const {
+  out->clear();
+  const int entry = FindEntry(info_state);
+  if (entry >= 0) {
+    out->assign(pairs_.begin() + pair_offset_[entry],
+                pairs_.begin() + pair_offset_[entry + 1]);
+  }
+}
+
+double FlatTabularPolicy::GetActionProbability(const std::string& info_state,
+                                               Action action) const {
+  const int entry = FindEntry(info_state);
+  if (entry < 0) return -1.;
+  for (int i = pair_offset_[entry]; i < pair_offset_[entry + 1]; ++i) {
+    if (pairs_[i].first == action) return pairs_[i].second;
+  }
+  return -1.;
+}
+
+namespace {
+
+// Format marker for policy files; bump when the layout changes.
+constexpr char kPolicyFileMagic[8] = {'O', 'S', 'P', 'O', 'L', 'v', '0', '1'};
+
+}  // namespace
+
+void SavePolicyToFile(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    const std::string& filename) {
+  std::vector<const std::string*> sorted_keys;
+  sorted_keys.reserve(table.size());
+  int64_t num_key_bytes = 0;
+  int64_t num_pairs = 0;
+  for (const auto& entry : table) {
+    sorted_keys.push_back(&entry.first);
+    num_key_bytes += entry.first.size();
+    num_pairs += entry.second.size();
+  }
+  std::sort(sorted_keys.begin(), sorted_keys.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename));
+  }
+  auto write_int64 = [&file](int64_t value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  file.write(kPolicyFileMagic, sizeof(kPolicyFileMagic));
+  write_int64(static_cast<int64_t>(sorted_keys.size()));
+  write_int64(num_pairs);
+  write_int64(num_key_bytes);
+  int64_t key_offset = 0;
+  write_int64(key_offset);
+  for (const std::string* key : sorted_keys) {
+    key_offset += key->size();
+    write_int64(key_offset);
+  }
+  int64_t pair_offset = 0;
+  write_int64(pair_offset);
+  for (const std::string* key : sorted_keys) {
+    pair_offset += table.at(*key).size();
+    write_int64(pair_offset);
+  }
+  for (const std::string* key : sorted_keys) {
+    for (const auto& action_and_prob : table.at(*key)) {
+      write_int64(action_and_prob.first);
+      file.write(reinterpret_cast<const char*>(&action_and_prob.second),
+                 sizeof(double));
+    }
+  }
+  for (const std::string* key : sorted_keys) {
+    file.write(key->data(), key->size());
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing policy file: ", filename));
+  }
+}
+
+void SavePolicyToFile(const TabularPolicy& policy,
+                      const std::string& filename) {
+  SavePolicyToFile(policy.PolicyTable(), filename);
+}
+
+MmapTabularPolicy::MmapTabularPolicy(const std::string& filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Cannot stat policy file: ", filename));
+  }
+  mapping_size_ = file_stat.st_size;
+  const uint64_t header_size = sizeof(kPolicyFileMagic) + 3 * sizeof(int64_t);
+  if (mapping_size_ < header_size) {
+    close(fd);
+    SpielFatalError(absl::StrCat("Policy file too short: ", filename));
+  }
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Cannot map policy file: ", filename));
+  }
+  const char* base = static_cast<const char*>(mapping_);
+  if (std::memcmp(base, kPolicyFileMagic, sizeof(kPolicyFileMagic)) != 0) {
+    SpielFatalError(absl::StrCat("Not a policy file: ", filename));
+  }
+  const int64_t* header =
+      reinterpret_cast<const int64_t*>(base + sizeof(kPolicyFileMagic));
+  num_entries_ = header[0];
+  const int64_t num_pairs = header[1];
+  const int64_t num_key_bytes = header[2];
+  key_offset_ = reinterpret_cast<const int64_t*>(base + header_size);
+  pair_offset_ = key_offset_ + num_entries_ + 1;
+  pairs_ = reinterpret_cast<const Pair*>(pair_offset_ + num_entries_ + 1);
+  keys_ = reinterpret_cast<const char*>(pairs_ + num_pairs);
+  if (static_cast<uint64_t>((keys_ + num_key_bytes) - base) != mapping_size_) {
+    SpielFatalError(absl::StrCat("Truncated policy file: ", filename));
+  }
+}
+
+MmapTabularPolicy::~MmapTabularPolicy() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+}
+
+int64_t MmapTabularPolicy::FindEntry(const std::string& info_state) const {
+  int64_t lo = 0;
+  int64_t hi = num_entries_;
+  while (lo < hi) {
+    const int64_t mid = (lo + hi) / 2;
+    const absl::string_view key(keys_ + key_offset_[mid],
+                                key_offset_[mid + 1] - key_offset_[mid]);
+    const int cmp = key.compare(info_state);
+    if (cmp == 0) {
+      return mid;
+    } else if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
+ActionsAndProbs MmapTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  ActionsAndProbs result;
+  GetStatePolicyInto(info_state, &result);
+  return result;
+}
+
+void MmapTabularPolicy::GetStatePolicyInto(const std::string& info_state,
+                                           ActionsAndProbs* out) const {
+  out->clear();
+  const int64_t entry = FindEntry(info_state);
+  if (entry < 0) return;
+  out->reserve(pair_offset_[entry + 1] - pair_offset_[entry]);
+  for (int64_t i = pair_offset_[entry]; i < pair_offset_[entry + 1]; ++i) {
+    out->push_back({pairs_[i].action, pairs_[i].prob});
+  }
+}
+
+double MmapTabularPolicy::GetActionProbability(const std::string& info_state,
+                                               Action action) const {
+  const int64_t entry = FindEntry(info_state);
+  if (entry < 0) return -1.;
+  for (int64_t i = pair_offset_[entry]; i < pair_offset_[entry + 1]; ++i) {
+    if (pairs_[i].action == action) return pairs_[i].prob;
+  }
+  return -1.;
+}
+
+namespace {
+
+// Format marker for policy export files; bump when the layout changes.
+constexpr char kPolicyExportMagic[8] = {'O', 'S', 'P', 'X', 'P', 'v', '0', '1'};
+
+// Flag bits stored in the header.
+constexpr int64_t kExportFlagFloat32 = 1;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Maps signed values to unsigned so that small deltas of either sign
+// encode as short varints.
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Reads a varint from [pos, end), advancing pos; fatal on truncation.
+const char* ReadVarint(const char* pos, const char* end, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos == end) SpielFatalError("Truncated policy export file.");
+    const uint8_t byte = static_cast<uint8_t>(*pos++);
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return pos;
+  }
+  SpielFatalError("Malformed varint in policy export file.");
+}
+
+// Encodes entries [begin, end) of the sorted key list into `out`. Keys are
+// front-coded within the chunk (the first key has an empty shared prefix,
+// so chunks decode independently), actions are zigzag deltas from their
+// predecessor in list order, and probabilities follow as raw floats.
+void EncodeExportChunk(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    const std::vector<const std::string*>& sorted_keys, int64_t begin,
+    int64_t end, bool float32_probs, std::string* out) {
+  const std::string* prev_key = nullptr;
+  for (int64_t i = begin; i < end; ++i) {
+    const std::string& key = *sorted_keys[i];
+    int64_t shared = 0;
+    if (prev_key != nullptr) {
+      const int64_t limit =
+          std::min<int64_t>(prev_key->size(), key.size());
+      while (shared < limit && (*prev_key)[shared] == key[shared]) ++shared;
+    }
+    AppendVarint(shared, out);
+    AppendVarint(key.size() - shared, out);
+    out->append(key, shared, key.size() - shared);
+    prev_key = &key;
+
+    const ActionsAndProbs& actions_and_probs = table.at(key);
+    AppendVarint(actions_and_probs.size(), out);
+    Action prev_action = 0;
+    for (const auto& action_and_prob : actions_and_probs) {
+      AppendVarint(ZigZagEncode(action_and_prob.first - prev_action), out);
+      prev_action = action_and_prob.first;
+    }
+    for (const auto& action_and_prob : actions_and_probs) {
+      if (float32_probs) {
+        const float prob = static_cast<float>(action_and_prob.second);
+        out->append(reinterpret_cast<const char*>(&prob), sizeof(prob));
+      } else {
+        out->append(reinterpret_cast<const char*>(&action_and_prob.second),
+                    sizeof(double));
+      }
+    }
+  }
+}
+
+// Decodes one chunk written by EncodeExportChunk.
+void DecodeExportChunk(
+    const char* pos, const char* end, int64_t num_entries, bool float32_probs,
+    std::vector<std::pair<std::string, ActionsAndProbs>>* out) {
+  out->reserve(num_entries);
+  std::string key;
+  for (int64_t i = 0; i < num_entries; ++i) {
+    uint64_t shared, suffix_length;
+    pos = ReadVarint(pos, end, &shared);
+    pos = ReadVarint(pos, end, &suffix_length);
+    if (shared > key.size() ||
+        static_cast<uint64_t>(end - pos) < suffix_length) {
+      SpielFatalError("Truncated policy export file.");
+    }
+    key.resize(shared);
+    key.append(pos, suffix_length);
+    pos += suffix_length;
+
+    uint64_t num_pairs;
+    pos = ReadVarint(pos, end, &num_pairs);
+    ActionsAndProbs actions_and_probs;
+    actions_and_probs.reserve(num_pairs);
+    Action prev_action = 0;
+    for (uint64_t j = 0; j < num_pairs; ++j) {
+      uint64_t delta;
+      pos = ReadVarint(pos, end, &delta);
+      prev_action += ZigZagDecode(delta);
+      actions_and_probs.push_back({prev_action, 0});
+    }
+    const int64_t prob_bytes =
+        num_pairs * (float32_probs ? sizeof(float) : sizeof(double));
+    if (end - pos < prob_bytes) {
+      SpielFatalError("Truncated policy export file.");
+    }
+    for (uint64_t j = 0; j < num_pairs; ++j) {
+      if (float32_probs) {
+        float prob;
+        std::memcpy(&prob, pos, sizeof(prob));
+        pos += sizeof(prob);
+        actions_and_probs[j].second = prob;
+      } else {
+        std::memcpy(&actions_and_probs[j].second, pos, sizeof(double));
+        pos += sizeof(double);
+      }
+    }
+    out->push_back({key, std::move(actions_and_probs)});
+  }
+}
+
+}  // namespace
+
+void ExportPolicyToFile(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    const std::string& filename, const PolicyExportOptions& options) {
+  std::vector<const std::string*> sorted_keys;
+  sorted_keys.reserve(table.size());
+  for (const auto& entry : table) sorted_keys.push_back(&entry.first);
+  std::sort(sorted_keys.begin(), sorted_keys.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  const int64_t num_entries = sorted_keys.size();
+  const int64_t chunk_size = std::max(1, options.chunk_size);
+  const int64_t num_chunks = (num_entries + chunk_size - 1) / chunk_size;
+  std::vector<std::string> chunks(num_chunks);
+  {
+    TaskGroup group(TaskPool::Global());
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      group.Spawn([&, c]() {
+        EncodeExportChunk(table, sorted_keys, c * chunk_size,
+                          std::min(num_entries, (c + 1) * chunk_size),
+                          options.float32_probs, &chunks[c]);
+      });
+    }
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename));
+  }
+  auto write_int64 = [&file](int64_t value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  file.write(kPolicyExportMagic, sizeof(kPolicyExportMagic));
+  write_int64(options.float32_probs ? kExportFlagFloat32 : 0);
+  write_int64(num_entries);
+  write_int64(num_chunks);
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    write_int64(std::min(num_entries, (c + 1) * chunk_size) - c * chunk_size);
+    write_int64(static_cast<int64_t>(chunks[c].size()));
+  }
+  for (const std::string& chunk : chunks) {
+    file.write(chunk.data(), chunk.size());
+  }
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing policy file: ", filename));
+  }
+}
+
+void ExportPolicyToFile(const TabularPolicy& policy,
+                        const std::string& filename,
+                        const PolicyExportOptions& options) {
+  ExportPolicyToFile(policy.PolicyTable(), filename, options);
+}
+
+TabularPolicy ImportPolicyFromFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename));
+  }
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  const int64_t header_size = sizeof(kPolicyExportMagic) + 3 * sizeof(int64_t);
+  if (static_cast<int64_t>(data.size()) < header_size) {
+    SpielFatalError(absl::StrCat("Policy file too short: ", filename));
+  }
+  if (std::memcmp(data.data(), kPolicyExportMagic,
+                  sizeof(kPolicyExportMagic)) != 0) {
+    SpielFatalError(absl::StrCat("Not a policy export file: ", filename));
+  }
+  const int64_t* header = reinterpret_cast<const int64_t*>(
+      data.data() + sizeof(kPolicyExportMagic));
+  const int64_t flags = header[0];
+  const int64_t num_entries = header[1];
+  const int64_t num_chunks = header[2];
+  if ((flags & ~kExportFlagFloat32) != 0) {
+    SpielFatalError(absl::StrCat("Unsupported policy export file: ", filename));
+  }
+  const bool float32_probs = (flags & kExportFlagFloat32) != 0;
+  if (static_cast<int64_t>(data.size()) <
+      header_size + 2 * num_chunks * static_cast<int64_t>(sizeof(int64_t))) {
+    SpielFatalError(absl::StrCat("Truncated policy file: ", filename));
+  }
+  const int64_t* directory =
+      reinterpret_cast<const int64_t*>(data.data() + header_size);
+
+  std::vector<std::vector<std::pair<std::string, ActionsAndProbs>>> decoded(
+      num_chunks);
+  {
+    int64_t offset = header_size + 2 * num_chunks * sizeof(int64_t);
+    TaskGroup group(TaskPool::Global());
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      const int64_t chunk_entries = directory[2 * c];
+      const int64_t chunk_bytes = directory[2 * c + 1];
+      if (offset + chunk_bytes > static_cast<int64_t>(data.size())) {
+        SpielFatalError(absl::StrCat("Truncated policy file: ", filename));
+      }
+      const char* chunk_begin = data.data() + offset;
+      group.Spawn([&, c, chunk_begin, chunk_bytes, chunk_entries]() {
+        DecodeExportChunk(chunk_begin, chunk_begin + chunk_bytes,
+                          chunk_entries, float32_probs, &decoded[c]);
+      });
+      offset += chunk_bytes;
+    }
+  }
+
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  table.reserve(num_entries);
+  for (auto& chunk : decoded) {
+    for (auto& entry : chunk) {
+      table.emplace(std::move(entry.first), std::move(entry.second));
+    }
+  }
+  return TabularPolicy(table);
+}
+
+namespace {
+
+// Format marker for checkpoint streams; bump when the layout changes.
+constexpr char kPolicyCheckpointMagic[8] = {'O', 'S', 'P', 'C', 'S',
+                                            'v', '0', '1'};
+
+// Record types in a checkpoint stream.
+constexpr int64_t kCheckpointKeyframe = 0;
+constexpr int64_t kCheckpointDelta = 1;
+
+// A parsed record: five int64 fields, the chunk directory, and the
+// payload (chunk data followed by the removed-key list). Records and
+// their directories are 8-aligned in the file: every payload is padded
+// to a multiple of 8 bytes, so the headers can be read in place.
+struct CheckpointRecord {
+  int64_t type;
+  int64_t num_entries;
+  int64_t num_chunks;
+  int64_t num_removed;
+  int64_t removed_bytes;
+  const int64_t* directory;
+  const char* payload;
+};
+
+int64_t PadTo8(int64_t bytes) { return (bytes + 7) & ~int64_t{7}; }
+
+// Walks the stream in `data`, filling `records`; returns the header flags.
+int64_t ParseCheckpointStream(const std::string& data,
+                              const std::string& filename,
+                              std::vector<CheckpointRecord>* records) {
+  const int64_t header_size =
+      sizeof(kPolicyCheckpointMagic) + sizeof(int64_t);
+  if (static_cast<int64_t>(data.size()) < header_size) {
+    SpielFatalError(absl::StrCat("Policy checkpoint file too short: ",
+                                 filename));
+  }
+  if (std::memcmp(data.data(), kPolicyCheckpointMagic,
+                  sizeof(kPolicyCheckpointMagic)) != 0) {
+    SpielFatalError(absl::StrCat("Not a policy checkpoint file: ", filename));
+  }
+  int64_t flags;
+  std::memcpy(&flags, data.data() + sizeof(kPolicyCheckpointMagic),
+              sizeof(flags));
+  if ((flags & ~kExportFlagFloat32) != 0) {
+    SpielFatalError(absl::StrCat("Unsupported policy checkpoint file: ",
+                                 filename));
+  }
+  int64_t offset = header_size;
+  while (offset < static_cast<int64_t>(data.size())) {
+    if (offset + 5 * static_cast<int64_t>(sizeof(int64_t)) >
+        static_cast<int64_t>(data.size())) {
+      SpielFatalError(absl::StrCat("Truncated policy checkpoint file: ",
+                                   filename));
+    }
+    CheckpointRecord record;
+    const int64_t* header =
+        reinterpret_cast<const int64_t*>(data.data() + offset);
+    record.type = header[0];
+    record.num_entries = header[1];
+    record.num_chunks = header[2];
+    record.num_removed = header[3];
+    record.removed_bytes = header[4];
+    if (record.type != kCheckpointKeyframe &&
+        record.type != kCheckpointDelta) {
+      SpielFatalError(absl::StrCat("Unknown record in checkpoint file: ",
+                                   filename));
+    }
+    record.directory = header + 5;
+    int64_t payload_bytes = record.removed_bytes;
+    for (int64_t c = 0; c < record.num_chunks; ++c) {
+      payload_bytes += record.directory[2 * c + 1];
+    }
+    record.payload =
+        reinterpret_cast<const char*>(record.directory + 2 * record.num_chunks);
+    offset = (record.payload - data.data()) + PadTo8(payload_bytes);
+    if (offset > static_cast<int64_t>(data.size())) {
+      SpielFatalError(absl::StrCat("Truncated policy checkpoint file: ",
+                                   filename));
+    }
+    records->push_back(record);
+  }
+  return flags;
+}
+
+// Decodes a record's entry chunks concurrently and applies them to the
+// table (inserting or overwriting), then erases the removed keys.
+void ApplyCheckpointRecord(
+    const CheckpointRecord& record, bool float32_probs,
+    const std::string& filename,
+    std::unordered_map<std::string, ActionsAndProbs>* table) {
+  std::vector<std::vector<std::pair<std::string, ActionsAndProbs>>> decoded(
+      record.num_chunks);
+  {
+    const char* chunk_begin = record.payload;
+    TaskGroup group(TaskPool::Global());
+    for (int64_t c = 0; c < record.num_chunks; ++c) {
+      const int64_t chunk_entries = record.directory[2 * c];
+      const int64_t chunk_bytes = record.directory[2 * c + 1];
+      group.Spawn([&, c, chunk_begin, chunk_bytes, chunk_entries]() {
+        DecodeExportChunk(chunk_begin, chunk_begin + chunk_bytes,
+                          chunk_entries, float32_probs, &decoded[c]);
+      });
+      chunk_begin += chunk_bytes;
+    }
+  }
+  for (auto& chunk : decoded) {
+    for (auto& entry : chunk) {
+      (*table)[std::move(entry.first)] = std::move(entry.second);
+    }
+  }
+
+  // The removed keys follow the chunks, front-coded like the chunk keys.
+  const char* pos = record.payload;
+  for (int64_t c = 0; c < record.num_chunks; ++c) {
+    pos += record.directory[2 * c + 1];
+  }
+  const char* end = pos + record.removed_bytes;
+  std::string key;
+  for (int64_t i = 0; i < record.num_removed; ++i) {
+    uint64_t shared, suffix_length;
+    pos = ReadVarint(pos, end, &shared);
+    pos = ReadVarint(pos, end, &suffix_length);
+    if (shared > key.size() ||
+        static_cast<uint64_t>(end - pos) < suffix_length) {
+      SpielFatalError(absl::StrCat("Truncated policy checkpoint file: ",
+                                   filename));
+    }
+    key.resize(shared);
+    key.append(pos, suffix_length);
+    pos += suffix_length;
+    table->erase(key);
+  }
+}
+
+// Front-codes a sorted key list, the same way the chunk keys are coded.
+void EncodeKeyList(const std::vector<const std::string*>& sorted_keys,
+                   std::string* out) {
+  const std::string* prev_key = nullptr;
+  for (const std::string* key : sorted_keys) {
+    int64_t shared = 0;
+    if (prev_key != nullptr) {
+      const int64_t limit = std::min<int64_t>(prev_key->size(), key->size());
+      while (shared < limit && (*prev_key)[shared] == (*key)[shared]) {
+        ++shared;
+      }
+    }
+    AppendVarint(shared, out);
+    AppendVarint(key->size() - shared, out);
+    out->append(*key, shared, key->size() - shared);
+    prev_key = key;
+  }
+}
+
+// Reads a whole file into a string, failing loudly.
+std::string ReadFileToString(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename));
+  }
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+PolicyCheckpointWriter::PolicyCheckpointWriter(
+    const std::string& filename, const PolicyCheckpointOptions& options)
+    : filename_(filename), options_(options) {
+  SPIEL_CHECK_GE(options_.keyframe_interval, 1);
+  std::ifstream existing(filename_, std::ios::binary);
+  if (existing && existing.peek() != std::ifstream::traits_type::eof()) {
+    existing.close();
+    const std::string data = ReadFileToString(filename_);
+    std::vector<CheckpointRecord> records;
+    const int64_t flags = ParseCheckpointStream(data, filename_, &records);
+    options_.export_options.float32_probs =
+        (flags & kExportFlagFloat32) != 0;
+    num_checkpoints_ = records.size();
+    if (num_checkpoints_ > 0) {
+      previous_table_ =
+          ReadPolicyCheckpoint(filename_, num_checkpoints_ - 1).PolicyTable();
+    }
+    return;
+  }
+  std::ofstream file(filename_, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename_));
+  }
+  file.write(kPolicyCheckpointMagic, sizeof(kPolicyCheckpointMagic));
+  const int64_t flags =
+      options_.export_options.float32_probs ? kExportFlagFloat32 : 0;
+  file.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing policy file: ", filename_));
+  }
+}
+
+void PolicyCheckpointWriter::Append(
+    const std::unordered_map<std::string, ActionsAndProbs>& table) {
+  const bool keyframe =
+      num_checkpoints_ % options_.keyframe_interval == 0;
+
+  // A keyframe stores every entry; a delta stores the entries that differ
+  // from the previous checkpoint and the keys that disappeared from it.
+  std::vector<const std::string*> changed_keys;
+  std::vector<const std::string*> removed_keys;
+  for (const auto& entry : table) {
+    if (keyframe) {
+      changed_keys.push_back(&entry.first);
+      continue;
+    }
+    auto it = previous_table_.find(entry.first);
+    if (it == previous_table_.end() || it->second != entry.second) {
+      changed_keys.push_back(&entry.first);
+    }
+  }
+  if (!keyframe) {
+    for (const auto& entry : previous_table_) {
+      if (table.find(entry.first) == table.end()) {
+        removed_keys.push_back(&entry.first);
+      }
+    }
+  }
+  auto by_value = [](const std::string* a, const std::string* b) {
+    return *a < *b;
+  };
+  std::sort(changed_keys.begin(), changed_keys.end(), by_value);
+  std::sort(removed_keys.begin(), removed_keys.end(), by_value);
+
+  const int64_t num_entries = changed_keys.size();
+  const int64_t chunk_size = std::max(1, options_.export_options.chunk_size);
+  const int64_t num_chunks = (num_entries + chunk_size - 1) / chunk_size;
+  std::vector<std::string> chunks(num_chunks);
+  {
+    TaskGroup group(TaskPool::Global());
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      group.Spawn([&, c]() {
+        EncodeExportChunk(table, changed_keys, c * chunk_size,
+                          std::min(num_entries, (c + 1) * chunk_size),
+                          options_.export_options.float32_probs, &chunks[c]);
+      });
+    }
+  }
+
+  std::string removed;
+  EncodeKeyList(removed_keys, &removed);
+
+  std::ofstream file(filename_, std::ios::binary | std::ios::app);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Cannot open policy file: ", filename_));
+  }
+  auto write_int64 = [&file](int64_t value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  write_int64(keyframe ? kCheckpointKeyframe : kCheckpointDelta);
+  write_int64(num_entries);
+  write_int64(num_chunks);
+  write_int64(static_cast<int64_t>(removed_keys.size()));
+  write_int64(static_cast<int64_t>(removed.size()));
+  int64_t payload_bytes = removed.size();
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    write_int64(std::min(num_entries, (c + 1) * chunk_size) - c * chunk_size);
+    write_int64(static_cast<int64_t>(chunks[c].size()));
+    payload_bytes += chunks[c].size();
+  }
+  for (const std::string& chunk : chunks) {
+    file.write(chunk.data(), chunk.size());
+  }
+  file.write(removed.data(), removed.size());
+  // Pad so the next record header stays 8-aligned.
+  const char zeros[8] = {0};
+  file.write(zeros, PadTo8(payload_bytes) - payload_bytes);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing policy file: ", filename_));
+  }
+
+  previous_table_ = table;
+  ++num_checkpoints_;
+}
+
+void PolicyCheckpointWriter::Append(const TabularPolicy& policy) {
+  Append(policy.PolicyTable());
+}
+
+int64_t NumPolicyCheckpoints(const std::string& filename) {
+  const std::string data = ReadFileToString(filename);
+  std::vector<CheckpointRecord> records;
+  ParseCheckpointStream(data, filename, &records);
+  return records.size();
+}
+
+TabularPolicy ReadPolicyCheckpoint(const std::string& filename,
+                                   int64_t checkpoint) {
+  const std::string data = ReadFileToString(filename);
+  std::vector<CheckpointRecord> records;
+  const int64_t flags = ParseCheckpointStream(data, filename, &records);
+  const bool float32_probs = (flags & kExportFlagFloat32) != 0;
+  SPIEL_CHECK_GE(checkpoint, 0);
+  SPIEL_CHECK_LT(checkpoint, static_cast<int64_t>(records.size()));
+
+  int64_t keyframe = checkpoint;
+  while (keyframe > 0 && records[keyframe].type != kCheckpointKeyframe) {
+    --keyframe;
+  }
+  if (records[keyframe].type != kCheckpointKeyframe) {
+    SpielFatalError(absl::StrCat("No keyframe in checkpoint file: ",
+                                 filename));
+  }
+
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  table.reserve(records[keyframe].num_entries);
+  for (int64_t r = keyframe; r <= checkpoint; ++r) {
+    ApplyCheckpointRecord(records[r], float32_probs, filename, &table);
+  }
+  return TabularPolicy(table);
+}
+
 TabularPolicy GetEmptyTabularPolicy(const Game& game,
                                     bool initialize_to_uniform) {
   std::unordered_map<std::string, ActionsAndProbs> policy;
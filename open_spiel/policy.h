@@ -24,12 +24,33 @@
 
 namespace open_spiel {
 
+// Returns the probability for the specified action, or -1 if not found.
+double GetProb(const ActionsAndProbs& action_and_probs, Action action);
+
 // A general policy object. A policy is a mapping from states to list of
 // (action, prob) pairs for all the legal actions at the state.
 class Policy {
  public:
   virtual ~Policy() = default;
 
+  // Allocation-free variant for hot loops: writes the state policy into
+  // the caller-provided buffer (cleared first), so a buffer reused across
+  // calls stops paying a heap allocation per lookup. The base
+  // implementation falls back to the allocating form; tabular policies
+  // override it to copy straight out of their storage.
+  virtual void GetStatePolicyInto(const std::string& info_state,
+                                  ActionsAndProbs* out) const {
+    *out = GetStatePolicy(info_state);
+  }
+
+  // Returns the probability of the action at the info state, or -1 if the
+  // info state or action is not found, without materializing the whole
+  // (action, prob) list.
+  virtual double GetActionProbability(const std::string& info_state,
+                                      Action action) const {
+    return GetProb(GetStatePolicy(info_state), action);
+  }
+
   // A convenience method for callers that want to use arrays.
   virtual std::pair<std::vector<Action>, std::vector<double>>
   GetStatePolicyAsParallelVectors(const State& state) const {
@@ -124,16 +145,288 @@ class TabularPolicy : public Policy {
     }
   }
 
+  void GetStatePolicyInto(const std::string& info_state,
+                          ActionsAndProbs* out) const override {
+    out->clear();
+    auto iter = policy_table_.find(info_state);
+    if (iter != policy_table_.end()) {
+      out->assign(iter->second.begin(), iter->second.end());
+    }
+  }
+
+  double GetActionProbability(const std::string& info_state,
+                              Action action) const override {
+    auto iter = policy_table_.find(info_state);
+    if (iter == policy_table_.end()) return -1.;
+    return GetProb(iter->second, action);
+  }
+
   std::unordered_map<std::string, ActionsAndProbs>& PolicyTable() {
     return policy_table_;
   }
 
+  const std::unordered_map<std::string, ActionsAndProbs>& PolicyTable() const {
+    return policy_table_;
+  }
+
+  // Estimated bytes of the policy table (keys, probability vectors, and map
+  // overhead), for capacity planning. Publishes the figure to the
+  // kPolicyTableBytes gauge (spiel_utils.h).
+  int64_t EstimatedMemory() const;
+
  private:
   std::unordered_map<std::string, ActionsAndProbs> policy_table_;
 };
 
-// Returns the probability for the specified action, or -1 if not found.
-double GetProb(const ActionsAndProbs& action_and_probs, Action action);
+// A policy serving a small set of per-infostate overrides on top of a base
+// policy. Oracle loops over mostly-identical candidate policies (e.g.
+// enumerating deterministic deviations in double-oracle methods) mutate
+// one or two overrides per candidate instead of copying a complete table,
+// and the override keys double as the changed-infostate set for
+// TabularBestResponse's incremental SetPolicy. The base policy must
+// outlive the overlay and not change while overrides are layered on it.
+class OverlayPolicy : public Policy {
+ public:
+  explicit OverlayPolicy(const Policy* base) : base_(base) {}
+
+  // Replaces (or installs) the override for one information state.
+  void SetOverride(const std::string& info_state, ActionsAndProbs policy) {
+    overrides_[info_state] = std::move(policy);
+  }
+
+  // Deterministic override: probability one on `action`, zero on the rest
+  // of `legal_actions`.
+  void SetOverride(const std::string& info_state, Action action,
+                   const std::vector<Action>& legal_actions) {
+    ActionsAndProbs& probs = overrides_[info_state];
+    probs.clear();
+    for (Action legal_action : legal_actions) {
+      probs.push_back({legal_action, legal_action == action ? 1.0 : 0.0});
+    }
+  }
+
+  // Removes an override, falling back to the base policy for that state.
+  // Returns whether one was present.
+  bool RemoveOverride(const std::string& info_state) {
+    return overrides_.erase(info_state) > 0;
+  }
+
+  void ClearOverrides() { overrides_.clear(); }
+
+  const std::unordered_map<std::string, ActionsAndProbs>& Overrides() const {
+    return overrides_;
+  }
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override {
+    auto iter = overrides_.find(info_state);
+    return iter != overrides_.end() ? iter->second
+                                    : base_->GetStatePolicy(info_state);
+  }
+
+  void GetStatePolicyInto(const std::string& info_state,
+                          ActionsAndProbs* out) const override {
+    auto iter = overrides_.find(info_state);
+    if (iter != overrides_.end()) {
+      out->assign(iter->second.begin(), iter->second.end());
+    } else {
+      base_->GetStatePolicyInto(info_state, out);
+    }
+  }
+
+  double GetActionProbability(const std::string& info_state,
+                              Action action) const override {
+    auto iter = overrides_.find(info_state);
+    if (iter != overrides_.end()) return GetProb(iter->second, action);
+    return base_->GetActionProbability(info_state, action);
+  }
+
+ private:
+  const Policy* base_;
+  std::unordered_map<std::string, ActionsAndProbs> overrides_;
+};
+
+// An immutable, high-density backend for serving a finished tabular
+// policy. The information state strings are interned into one buffer and
+// kept sorted, and every (action, prob) pair lives in a single contiguous
+// array, so a table costs its raw data plus three offsets per entry
+// instead of an unordered_map node, a string and a vector allocation
+// each. GetStatePolicy is a binary search whose probes compare against
+// the key buffer rather than chasing hashed nodes. Build and edit with
+// TabularPolicy, then freeze into this for best response, evaluation and
+// serving; for solved liars_dice-sized tables this is the difference
+// between ~8GB of fragmented nodes and the flat data itself.
+class FlatTabularPolicy : public Policy {
+ public:
+  FlatTabularPolicy() = default;
+  explicit FlatTabularPolicy(const TabularPolicy& policy);
+  explicit FlatTabularPolicy(
+      const std::unordered_map<std::string, ActionsAndProbs>& table);
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicyInto(const std::string& info_state,
+                          ActionsAndProbs* out) const override;
+  double GetActionProbability(const std::string& info_state,
+                              Action action) const override;
+
+  int NumEntries() const {
+    return key_offset_.empty() ? 0 : static_cast<int>(key_offset_.size()) - 1;
+  }
+
+ private:
+  void Freeze(const std::unordered_map<std::string, ActionsAndProbs>& table);
+
+  // Returns the entry index for the info state, or -1 if absent.
+  int FindEntry(const std::string& info_state) const;
+
+  // All keys back-to-back, in sorted order; entry i's key is the range
+  // [key_offset_[i], key_offset_[i + 1]) and its pairs are the range
+  // [pair_offset_[i], pair_offset_[i + 1]).
+  std::string keys_;
+  std::vector<int64_t> key_offset_;
+  std::vector<int> pair_offset_;
+  ActionsAndProbs pairs_;
+};
+
+// Writes a tabular policy to a file in the FlatTabularPolicy layout:
+// sorted interned keys, offset arrays and one contiguous (action, prob)
+// array, preceded by a magic marker and the section sizes. The format is
+// what MmapTabularPolicy serves from.
+void SavePolicyToFile(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    const std::string& filename);
+void SavePolicyToFile(const TabularPolicy& policy,
+                      const std::string& filename);
+
+// A read-only Policy over a file written by SavePolicyToFile. The file is
+// memory-mapped rather than loaded: construction costs one mmap
+// regardless of the table size, GetStatePolicy binary-searches the key
+// buffer directly in the mapping, and the pages are demand-paged and
+// shared by the OS across every process serving the same file. This is
+// the serving path for solved policies too large (or too slow) to
+// rebuild as an in-memory table per process.
+class MmapTabularPolicy : public Policy {
+ public:
+  explicit MmapTabularPolicy(const std::string& filename);
+  ~MmapTabularPolicy() override;
+
+  // The mapping is owned; no copies.
+  MmapTabularPolicy(const MmapTabularPolicy&) = delete;
+  MmapTabularPolicy& operator=(const MmapTabularPolicy&) = delete;
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicyInto(const std::string& info_state,
+                          ActionsAndProbs* out) const override;
+  double GetActionProbability(const std::string& info_state,
+                              Action action) const override;
+
+  int64_t NumEntries() const { return num_entries_; }
+
+ private:
+  // An (action, prob) pair as stored in the file; 16 bytes, 8-aligned.
+  struct Pair {
+    int64_t action;
+    double prob;
+  };
+
+  // Returns the entry index for the info state, or -1 if absent.
+  int64_t FindEntry(const std::string& info_state) const;
+
+  void* mapping_ = nullptr;
+  uint64_t mapping_size_ = 0;
+
+  // Pointers into the mapping.
+  int64_t num_entries_ = 0;
+  const int64_t* key_offset_ = nullptr;
+  const int64_t* pair_offset_ = nullptr;
+  const Pair* pairs_ = nullptr;
+  const char* keys_ = nullptr;
+};
+
+// Options for ExportPolicyToFile.
+struct PolicyExportOptions {
+  // Store probabilities as float32 instead of float64. Halves the
+  // probability bytes; import reproduces them to ~1e-7 relative error,
+  // below the convergence noise of any solver that produced them. Leave
+  // false for exact round-trips.
+  bool float32_probs = false;
+
+  // Number of entries per chunk. Chunks are encoded and decoded
+  // concurrently on the global task pool; the default keeps every worker
+  // busy on tables worth parallelizing without fragmenting small ones.
+  int chunk_size = 1024;
+};
+
+// A compact, versioned transport container for moving policies between
+// machines, distinct from the mmap serving format written by
+// SavePolicyToFile: keys are sorted and front-coded against their
+// predecessor, action lists are delta-encoded varints, and probabilities
+// are float64 or optionally float32. The payload is split into
+// independently decodable chunks, which the writer encodes and the reader
+// decodes concurrently, so both directions are I/O-bound. Readers reject
+// files with an unknown version or flags.
+void ExportPolicyToFile(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    const std::string& filename, const PolicyExportOptions& options = {});
+void ExportPolicyToFile(const TabularPolicy& policy,
+                        const std::string& filename,
+                        const PolicyExportOptions& options = {});
+
+// Reads a file written by ExportPolicyToFile back into a TabularPolicy.
+TabularPolicy ImportPolicyFromFile(const std::string& filename);
+
+// Options for PolicyCheckpointWriter.
+struct PolicyCheckpointOptions {
+  // Encoding of the entry payloads; see PolicyExportOptions. The
+  // probability width is fixed by the stream header, so it is taken from
+  // there instead when appending to an existing stream.
+  PolicyExportOptions export_options;
+
+  // Every keyframe_interval-th checkpoint (the first one always) is stored
+  // as a full snapshot; the checkpoints in between store only the entries
+  // that differ from their predecessor plus the keys that disappeared.
+  // A larger interval shrinks the stream, a smaller one caps how many
+  // deltas ReadPolicyCheckpoint has to apply on top of a keyframe.
+  int keyframe_interval = 16;
+};
+
+// Appends a sequence of policy snapshots to a single stream file. Between
+// checkpoints of an iterative solver only a fraction of the info states
+// move, so the delta records are a fraction of a snapshot's size; the
+// periodic keyframes bound the replay cost of materializing a checkpoint.
+// Entries use the ExportPolicyToFile chunk encoding, with the chunks of a
+// record encoded concurrently on the global task pool.
+class PolicyCheckpointWriter {
+ public:
+  // Creates the stream, or reopens an existing one to append to it: the
+  // tail checkpoint is materialized and becomes the delta base, so a
+  // resumed experiment keeps its history.
+  explicit PolicyCheckpointWriter(const std::string& filename,
+                                  const PolicyCheckpointOptions& options = {});
+
+  // Appends `table` as the next checkpoint.
+  void Append(const std::unordered_map<std::string, ActionsAndProbs>& table);
+  void Append(const TabularPolicy& policy);
+
+  int64_t NumCheckpoints() const { return num_checkpoints_; }
+
+ private:
+  std::string filename_;
+  PolicyCheckpointOptions options_;
+  int64_t num_checkpoints_ = 0;
+
+  // The previous checkpoint's table, diffed against to form the next
+  // delta record.
+  std::unordered_map<std::string, ActionsAndProbs> previous_table_;
+};
+
+// Number of checkpoints in a stream written by PolicyCheckpointWriter.
+int64_t NumPolicyCheckpoints(const std::string& filename);
+
+// Materializes checkpoint `checkpoint` (0-based) of a stream written by
+// PolicyCheckpointWriter, by decoding the nearest keyframe at or before it
+// and applying the delta records in between.
+TabularPolicy ReadPolicyCheckpoint(const std::string& filename,
+                                   int64_t checkpoint);
 
 // Helper functions that generate policies for testing.
 TabularPolicy GetEmptyTabularPolicy(const Game& game,
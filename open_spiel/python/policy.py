@@ -427,3 +427,25 @@ def python_policy_to_pyspiel_policy(python_tabular_policy):
 def policy_from_pyspiel_policy(pyspiel_policy):
   """Returns a `policy.Policy` object from a `pyspiel.Policy` object."""
   return PolicyFromCallable(None, pyspiel_policy.get_state_policy_as_map)
+
+
+def pyspiel_policy_from_batched_callable(game, batched_callable):
+  """Builds a pyspiel.TabularPolicy with a single batched query.
+
+  Unlike passing a Python policy to C++ directly, which crosses the
+  language boundary once per information state, the callable is invoked
+  exactly once with two parallel lists - every information state string in
+  the game and its legal actions - and must return a list of
+  {action: probability} dicts of the same length. Use this to hand learned
+  policies to pyspiel.TabularBestResponse or exploitability without
+  per-state chatter.
+
+  Args:
+    game: The pyspiel.Game the policy is for.
+    batched_callable: A callable f(info_states, legal_actions) returning
+      one {action: probability} dict per information state.
+
+  Returns:
+    A pyspiel.TabularPolicy holding the callable's output.
+  """
+  return pyspiel.tabular_policy_from_batched_callable(game, batched_callable)
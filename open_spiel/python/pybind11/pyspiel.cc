@@ -12,13 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/algorithms/cfr_br.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/algorithms/get_legal_actions_map.h"
 #include "open_spiel/algorithms/matrix_game_utils.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/algorithms/trajectories.h"
@@ -85,6 +88,17 @@ class PyBot : public Bot {
     );
   }
 
+  // Choose and execute an action without reporting a policy.
+  Action StepAction(const State& state) override {
+    PYBIND11_OVERLOAD_NAME(
+        Action,  // Return type (must be a simple token for macro parser)
+        Bot,     // Parent class
+        "step_action",  // Name of function in Python
+        StepAction,     // Name of function in C++
+        state           // Arguments
+    );
+  }
+
   // Restart at the specified state.
   void Restart(const State& state) override {
     PYBIND11_OVERLOAD_NAME(
@@ -97,6 +111,68 @@ class PyBot : public Bot {
   }
 };
 
+// Writes a state tensor into a caller-provided numpy array through the
+// buffer protocol, so no per-element Python objects are created. The array
+// must be 1-D, contiguous, writable, of float32 or float64, and hold exactly
+// `size` elements. float64 buffers are filled in place; float32 buffers go
+// through a per-thread double scratch and a narrowing copy.
+void FillTensorBuffer(const py::buffer& buffer, int size,
+                      const std::function<void(double*)>& fill) {
+  py::buffer_info info = buffer.request(/*writable=*/true);
+  if (info.ndim != 1 || info.size != size) {
+    SpielFatalError(absl::StrCat("Expected a 1-D buffer of ", size,
+                                 " elements."));
+  }
+  if (info.strides[0] != info.itemsize) {
+    SpielFatalError("Expected a contiguous buffer.");
+  }
+  if (info.format == py::format_descriptor<double>::format()) {
+    fill(static_cast<double*>(info.ptr));
+  } else if (info.format == py::format_descriptor<float>::format()) {
+    thread_local std::vector<double> scratch;
+    scratch.resize(size);
+    fill(scratch.data());
+    float* out = static_cast<float*>(info.ptr);
+    for (int i = 0; i < size; ++i) out[i] = static_cast<float>(scratch[i]);
+  } else {
+    SpielFatalError("Expected a float32 or float64 buffer.");
+  }
+}
+
+// Batched variant of the above: row i of the 2-D array receives the tensor
+// of states[i] from its current player's view.
+void FillTensorBufferBatch(
+    const std::vector<const State*>& states, const py::buffer& buffer,
+    int size, const std::function<void(const State&, double*)>& fill) {
+  py::buffer_info info = buffer.request(/*writable=*/true);
+  if (info.ndim != 2 || info.shape[0] != static_cast<py::ssize_t>(states.size()) ||
+      info.shape[1] != size) {
+    SpielFatalError(absl::StrCat("Expected a 2-D buffer of shape (",
+                                 states.size(), ", ", size, ")."));
+  }
+  if (info.strides[1] != info.itemsize) {
+    SpielFatalError("Expected rows to be contiguous.");
+  }
+  const py::ssize_t row_stride = info.strides[0];
+  if (info.format == py::format_descriptor<double>::format()) {
+    char* ptr = static_cast<char*>(info.ptr);
+    for (int i = 0; i < states.size(); ++i) {
+      fill(*states[i], reinterpret_cast<double*>(ptr + i * row_stride));
+    }
+  } else if (info.format == py::format_descriptor<float>::format()) {
+    thread_local std::vector<double> scratch;
+    scratch.resize(size);
+    char* ptr = static_cast<char*>(info.ptr);
+    for (int i = 0; i < states.size(); ++i) {
+      fill(*states[i], scratch.data());
+      float* out = reinterpret_cast<float*>(ptr + i * row_stride);
+      for (int j = 0; j < size; ++j) out[j] = static_cast<float>(scratch[j]);
+    }
+  } else {
+    SpielFatalError("Expected a float32 or float64 buffer.");
+  }
+}
+
 // Definintion of our Python module.
 PYBIND11_MODULE(pyspiel, m) {
   m.doc() = "Open Spiel";
@@ -229,6 +305,25 @@ PYBIND11_MODULE(pyspiel, m) {
       .def("observation_as_normalized_vector",
            (std::vector<double>(State::*)() const) &
                State::ObservationAsNormalizedVector)
+      // Buffer-protocol forms: fill a caller-provided numpy array (float32 or
+      // float64) in place instead of building a Python list.
+      .def("information_state_as_normalized_vector",
+           [](const State& state, int player, py::buffer buffer) {
+             FillTensorBuffer(
+                 buffer,
+                 state.GetGame()->InformationStateNormalizedVectorSize(),
+                 [&state, player](double* out) {
+                   state.InformationStateAsNormalizedVector(player, out);
+                 });
+           })
+      .def("observation_as_normalized_vector",
+           [](const State& state, int player, py::buffer buffer) {
+             FillTensorBuffer(
+                 buffer, state.GetGame()->ObservationNormalizedVectorSize(),
+                 [&state, player](double* out) {
+                   state.ObservationAsNormalizedVector(player, out);
+                 });
+           })
       .def("clone", &State::Clone)
       .def("child", &State::Child)
       .def("undo_action", &State::UndoAction)
@@ -327,6 +422,7 @@ PYBIND11_MODULE(pyspiel, m) {
   bot.def(py::init<const Game&, int>())
       .def("player_id", &Bot::PlayerId)
       .def("step", &Bot::Step)
+      .def("step_action", &Bot::StepAction)
       .def("apply_action", &Bot::ApplyAction)
       .def("restart", &Bot::Restart);
 
@@ -335,11 +431,16 @@ PYBIND11_MODULE(pyspiel, m) {
                     const std::unordered_map<std::string,
                                              open_spiel::ActionsAndProbs>&>())
       .def(py::init<const open_spiel::Game&, int, const open_spiel::Policy*>())
-      .def("value", &TabularBestResponse::Value)
+      // The computations below can run for a long time on large games, so
+      // release the GIL while they do (they are pure C++).
+      .def("value", &TabularBestResponse::Value,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_best_response_policy",
-           &TabularBestResponse::GetBestResponsePolicy)
+           &TabularBestResponse::GetBestResponsePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_best_response_actions",
-           &TabularBestResponse::GetBestResponseActions)
+           &TabularBestResponse::GetBestResponseActions,
+           py::call_guard<py::gil_scoped_release>())
       .def("set_policy",
            (void (open_spiel::algorithms::TabularBestResponse::*)(
                const std::unordered_map<std::string,
@@ -366,19 +467,61 @@ PYBIND11_MODULE(pyspiel, m) {
       .def(py::init<const std::unordered_map<std::string, ActionsAndProbs>&>())
       .def("get_state_policy", &open_spiel::TabularPolicy::GetStatePolicy);
 
+  // Builds a TabularPolicy by querying a Python callable once for the
+  // whole game instead of once per information state. The callable
+  // receives two parallel lists - every information state string in the
+  // game and its legal actions - and must return a list of
+  // {action: probability} dicts of the same length. This turns the
+  // per-state boundary crossings (GIL acquire, dict building) that
+  // dominate best response against a learned Python policy into a single
+  // round trip; the result is an ordinary Policy usable by
+  // TabularBestResponse, exploitability, etc.
+  m.def("tabular_policy_from_batched_callable",
+        [](const Game& game, py::function callable) {
+          std::shared_ptr<const open_spiel::algorithms::LegalActionsIndex>
+              index = open_spiel::algorithms::GetLegalActionsIndex(game);
+          const int num_info_states = index->NumInfoStates();
+          py::list info_states;
+          py::list legal_actions;
+          for (int id = 0; id < num_info_states; ++id) {
+            info_states.append(index->InfoState(id));
+            legal_actions.append(index->LegalActions(id));
+          }
+          auto batched =
+              callable(info_states, legal_actions)
+                  .cast<std::vector<std::unordered_map<Action, double>>>();
+          if (static_cast<int>(batched.size()) != num_info_states) {
+            SpielFatalError(absl::StrCat(
+                "tabular_policy_from_batched_callable: callable returned ",
+                batched.size(), " entries for ", num_info_states,
+                " information states."));
+          }
+          std::unordered_map<std::string, ActionsAndProbs> table;
+          table.reserve(num_info_states);
+          for (int id = 0; id < num_info_states; ++id) {
+            ActionsAndProbs actions_and_probs(batched[id].begin(),
+                                              batched[id].end());
+            std::sort(actions_and_probs.begin(), actions_and_probs.end());
+            table[index->InfoState(id)] = std::move(actions_and_probs);
+          }
+          return open_spiel::TabularPolicy(table);
+        });
+
   m.def("UniformRandomPolicy", &open_spiel::GetUniformPolicy);
 
   py::class_<open_spiel::algorithms::CFRSolver>(m, "CFRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy", &open_spiel::algorithms::CFRSolver::AveragePolicy);
 
   py::class_<open_spiel::algorithms::CFRPlusSolver>(m, "CFRPlusSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
@@ -386,7 +529,8 @@ PYBIND11_MODULE(pyspiel, m) {
   py::class_<open_spiel::algorithms::CFRBRSolver>(m, "CFRBRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
@@ -396,7 +540,9 @@ PYBIND11_MODULE(pyspiel, m) {
       .def(py::init<const Game&, const std::unordered_map<std::string, int>&,
                     int>())
       .def("record_batch",
-           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch);
+           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch,
+           py::arg("policies"), py::arg("batch_size"),
+           py::arg("max_unroll_length"), py::arg("num_threads") = 1);
 
   m.def("create_matrix_game",
         (std::shared_ptr<const MatrixGame>(*)(
@@ -451,13 +597,43 @@ PYBIND11_MODULE(pyspiel, m) {
   m.def("registered_games", GameRegisterer::RegisteredGames,
         "Returns the details of all available games.");
 
+  // The GIL is released for the duration of the game; bots implemented in
+  // Python reacquire it for each callback.
   m.def("evaluate_bots", open_spiel::EvaluateBots,
+        py::call_guard<py::gil_scoped_release>(),
         "Plays a single game with the given bots and returns the final "
         "utilities.");
 
   m.def("make_uniform_random_bot", open_spiel::MakeUniformRandomBot,
         "A uniform random bot, for test purposes.");
 
+  m.def("information_state_as_normalized_vector_batch",
+        [](const std::vector<const State*>& states, py::buffer buffer) {
+          if (states.empty()) return;
+          FillTensorBufferBatch(
+              states, buffer,
+              states[0]->GetGame()->InformationStateNormalizedVectorSize(),
+              [](const State& state, double* out) {
+                state.InformationStateAsNormalizedVector(state.CurrentPlayer(),
+                                                         out);
+              });
+        },
+        "Fills rows of a 2-D numpy array with the information state tensors "
+        "of a list of states, from each state's current player's view.");
+
+  m.def("observation_as_normalized_vector_batch",
+        [](const std::vector<const State*>& states, py::buffer buffer) {
+          if (states.empty()) return;
+          FillTensorBufferBatch(
+              states, buffer,
+              states[0]->GetGame()->ObservationNormalizedVectorSize(),
+              [](const State& state, double* out) {
+                state.ObservationAsNormalizedVector(state.CurrentPlayer(), out);
+              });
+        },
+        "Fills rows of a 2-D numpy array with the observation tensors of a "
+        "list of states, from each state's current player's view.");
+
   m.def("serialize_game_and_state", open_spiel::SerializeGameAndState,
         "A general implementation of game and state serialization.");
 
@@ -467,6 +643,7 @@ PYBIND11_MODULE(pyspiel, m) {
 
   m.def("exploitability",
         (double (*)(const Game&, const Policy&))Exploitability,
+        py::call_guard<py::gil_scoped_release>(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -478,6 +655,7 @@ PYBIND11_MODULE(pyspiel, m) {
         (double (*)(const Game&,
                     const std::unordered_map<std::string, ActionsAndProbs>&))
             Exploitability,
+        py::call_guard<py::gil_scoped_release>(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -486,6 +664,7 @@ PYBIND11_MODULE(pyspiel, m) {
         "to it.");
 
   m.def("nash_conv", (double (*)(const Game&, const Policy&))NashConv,
+        py::call_guard<py::gil_scoped_release>(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -497,6 +676,7 @@ PYBIND11_MODULE(pyspiel, m) {
         (double (*)(
             const Game&,
             const std::unordered_map<std::string, ActionsAndProbs>&))NashConv,
+        py::call_guard<py::gil_scoped_release>(),
         "Calculates a measure of how far the given policy is from a Nash "
         "equilibrium by returning the sum of the improvements in the value "
         "that each player could obtain by unilaterally changing their strategy "
@@ -538,10 +718,86 @@ PYBIND11_MODULE(pyspiel, m) {
   m.def("record_batched_trajectories",
         (open_spiel::algorithms::BatchedTrajectory(*)(
             const Game&, const std::vector<open_spiel::TabularPolicy>&,
-            const std::unordered_map<std::string, int>&, int, bool, int,
+            const std::unordered_map<std::string, int>&, int, bool, int, int,
             int))open_spiel::algorithms::RecordBatchedTrajectory,
+        py::call_guard<py::gil_scoped_release>(), py::arg("game"),
+        py::arg("policies"), py::arg("state_to_index"), py::arg("batch_size"),
+        py::arg("include_full_observations"), py::arg("seed"),
+        py::arg("max_unroll_length") = -1, py::arg("num_threads") = 1,
         "Records a batch of trajectories.");
 
+  py::class_<open_spiel::algorithms::FlatBatchedTrajectory>(
+      m, "FlatBatchedTrajectory")
+      .def_readonly("observations",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::
+                        observations)
+      .def_readonly(
+          "state_indices",
+          &open_spiel::algorithms::FlatBatchedTrajectory::state_indices)
+      .def_readonly(
+          "legal_actions",
+          &open_spiel::algorithms::FlatBatchedTrajectory::legal_actions)
+      .def_readonly("actions",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::actions)
+      .def_readonly(
+          "player_policies",
+          &open_spiel::algorithms::FlatBatchedTrajectory::player_policies)
+      .def_readonly(
+          "player_ids",
+          &open_spiel::algorithms::FlatBatchedTrajectory::player_ids)
+      .def_readonly("rewards",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::rewards)
+      .def_readonly(
+          "valid_lengths",
+          &open_spiel::algorithms::FlatBatchedTrajectory::valid_lengths)
+      .def_readonly("batch_size",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::batch_size)
+      .def_readonly("max_length",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::max_length)
+      .def_readonly(
+          "observation_size",
+          &open_spiel::algorithms::FlatBatchedTrajectory::observation_size)
+      .def_readonly("num_distinct_actions",
+                    &open_spiel::algorithms::FlatBatchedTrajectory::
+                        num_distinct_actions)
+      .def_readonly(
+          "num_players",
+          &open_spiel::algorithms::FlatBatchedTrajectory::num_players);
+
+  py::class_<open_spiel::algorithms::SharedMemoryTrajectoryBuffer>(
+      m, "SharedMemoryTrajectoryBuffer")
+      .def(py::init<const std::string&, const Game&, int, int, bool>(),
+           py::arg("name"), py::arg("game"), py::arg("batch_size"),
+           py::arg("max_length"), py::arg("include_full_observations"))
+      .def(py::init<const std::string&>(), py::arg("name"))
+      .def("unlink",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::Unlink)
+      .def("name",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::Name)
+      .def("batch_size",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::BatchSize)
+      .def("max_length",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::MaxLength)
+      .def("observation_size",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::
+               ObservationSize)
+      .def("num_distinct_actions",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::
+               NumDistinctActions)
+      .def("num_players",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::NumPlayers)
+      .def("field_offset",
+           &open_spiel::algorithms::SharedMemoryTrajectoryBuffer::FieldOffset,
+           py::arg("field"));
+
+  m.def("record_flat_batched_trajectory_into_shared_memory",
+        open_spiel::algorithms::RecordFlatBatchedTrajectoryIntoSharedMemory,
+        py::call_guard<py::gil_scoped_release>(), py::arg("game"),
+        py::arg("policies"), py::arg("state_to_index"),
+        py::arg("include_full_observations"), py::arg("seed"),
+        py::arg("buffer"), py::arg("num_threads") = 1,
+        "Records a batch of trajectories into a shared memory segment.");
+
   // Set an error handler that will raise exceptions. These exceptions are for
   // the Python interface only. When used from C++, OpenSpiel will never raise
   // exceptions - the process will be terminated instead.
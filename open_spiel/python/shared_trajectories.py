@@ -0,0 +1,104 @@
+# Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Zero-copy NumPy views of shared-memory trajectory buffers.
+
+A producer process creates a `pyspiel.SharedMemoryTrajectoryBuffer` and fills
+it with `pyspiel.record_flat_batched_trajectory_into_shared_memory`. Consumer
+processes then call `map_shared_trajectories(name)` here to get NumPy arrays
+backed directly by the shared segment (via `np.memmap` on the file POSIX
+shared memory exposes under /dev/shm), so no trajectory data is pickled or
+copied between processes. The layouts are those of
+`pyspiel.FlatBatchedTrajectory`; rows past `valid_lengths[b]` of episode b
+are padding.
+"""
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import collections
+
+import numpy as np
+
+import pyspiel
+
+# Where Linux exposes POSIX shared memory objects as files.
+_SHM_DIR = "/dev/shm"
+
+SharedTrajectories = collections.namedtuple(
+    "SharedTrajectories",
+    [
+        "batch_size", "max_length", "observation_size", "num_distinct_actions",
+        "num_players", "observations", "state_indices", "legal_actions",
+        "actions", "player_policies", "player_ids", "rewards", "valid_lengths"
+    ])
+
+
+def _field(path, offset, dtype, shape):
+  return np.memmap(path, dtype=dtype, mode="r+", offset=offset, shape=shape)
+
+
+def map_shared_trajectories(name):
+  """Maps a shared trajectory segment into NumPy arrays, zero-copy.
+
+  Args:
+    name: The segment name the producer passed to
+      `pyspiel.SharedMemoryTrajectoryBuffer` (with or without the leading
+      '/').
+
+  Returns:
+    A `SharedTrajectories` with the dimensions of the batch and one array per
+    field, each a writable view of the shared memory. `observations` is None
+    when the producer recorded state indices, and `state_indices` is None
+    when it recorded full observations.
+  """
+  # Attaching validates the header and gives us the dimensions and offsets.
+  buf = pyspiel.SharedMemoryTrajectoryBuffer(name)
+  path = _SHM_DIR + buf.name()
+  batch_size = buf.batch_size()
+  max_length = buf.max_length()
+  observation_size = buf.observation_size()
+  num_distinct_actions = buf.num_distinct_actions()
+  num_players = buf.num_players()
+
+  observations = None
+  state_indices = None
+  if observation_size > 0:
+    observations = _field(path, buf.field_offset("observations"), np.float64,
+                          (batch_size, max_length, observation_size))
+  else:
+    state_indices = _field(path, buf.field_offset("state_indices"), np.int32,
+                           (batch_size, max_length))
+  return SharedTrajectories(
+      batch_size=batch_size,
+      max_length=max_length,
+      observation_size=observation_size,
+      num_distinct_actions=num_distinct_actions,
+      num_players=num_players,
+      observations=observations,
+      state_indices=state_indices,
+      legal_actions=_field(path, buf.field_offset("legal_actions"), np.int32,
+                           (batch_size, max_length, num_distinct_actions)),
+      actions=_field(path, buf.field_offset("actions"), np.int64,
+                     (batch_size, max_length)),
+      player_policies=_field(path, buf.field_offset("player_policies"),
+                             np.float64,
+                             (batch_size, max_length, num_distinct_actions)),
+      player_ids=_field(path, buf.field_offset("player_ids"), np.int32,
+                        (batch_size, max_length)),
+      rewards=_field(path, buf.field_offset("rewards"), np.float64,
+                     (batch_size, num_players)),
+      valid_lengths=_field(path, buf.field_offset("valid_lengths"), np.int32,
+                           (batch_size,)))
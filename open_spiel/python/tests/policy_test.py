@@ -261,6 +261,27 @@ class TabularPolicyTest(parameterized.TestCase):
           realized_policy.action_probabilities(state),
           tabular_policy.action_probabilities(state))
 
+  def test_pyspiel_policy_from_batched_callable(self):
+    game = pyspiel.load_game("kuhn_poker")
+
+    num_calls = [0]
+
+    def batched_uniform(info_states, legal_actions):
+      num_calls[0] += 1
+      self.assertLen(legal_actions, len(info_states))
+      return [{action: 1. / len(actions)
+               for action in actions}
+              for actions in legal_actions]
+
+    pyspiel_policy = policy.pyspiel_policy_from_batched_callable(
+        game, batched_uniform)
+    # The whole game crosses the boundary in a single call.
+    self.assertEqual(num_calls[0], 1)
+    # Every Kuhn betting node has two actions: pass and bet.
+    for info_state in ["0", "1pb", "2b"]:
+      self.assertEqual(
+          pyspiel_policy.get_state_policy(info_state), [(0, 0.5), (1, 0.5)])
+
 
 class TabularRockPaperScissorsPolicyTest(absltest.TestCase):
 
@@ -19,6 +19,7 @@ from __future__ import division
 from __future__ import print_function
 
 from absl.testing import absltest
+import numpy as np
 import six
 
 from open_spiel.python import policy
@@ -137,6 +138,23 @@ class PyspielTest(absltest.TestCase):
     self.assertFalse(state.is_terminal())
     self.assertEqual(state.legal_actions(), [0, 1, 2, 3, 4, 5, 6, 7, 8])
 
+  def test_normalized_vector_into_numpy_buffer(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    state = game.new_initial_state()
+    state.apply_action(4)
+    expected = state.observation_as_normalized_vector(0)
+    for dtype in (np.float64, np.float32):
+      buf = np.zeros(game.observation_normalized_vector_size(), dtype=dtype)
+      state.observation_as_normalized_vector(0, buf)
+      np.testing.assert_allclose(buf, expected)
+    # Batched form: one row per state.
+    states = [game.new_initial_state(), state]
+    batch = np.zeros((2, game.observation_normalized_vector_size()))
+    pyspiel.observation_as_normalized_vector_batch(states, batch)
+    for row, s in zip(batch, states):
+      np.testing.assert_allclose(
+          row, s.observation_as_normalized_vector(s.current_player()))
+
   def test_game_parameter(self):
     param = pyspiel.GameParameter(True)
     self.assertEqual(repr(param), "GameParameter(bool_value=True)")
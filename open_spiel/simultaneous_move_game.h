@@ -58,6 +58,7 @@ class SimMoveState : public State {
       ApplyFlatJointAction(action);
     } else {
       DoApplyAction(action);
+      TruncateStaleHistoryCaches();
       history_.push_back(action);
     }
   }
@@ -19,7 +19,9 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
@@ -57,8 +59,89 @@ void ValidateParams(const GameParameters& params,
   }
 }
 
+// Tags written into the header that precedes every State allocation, so that
+// State::operator delete can tell arena-backed allocations from heap ones.
+constexpr uint64_t kArenaAllocTag = 0xA4E7A123A4E7A123ULL;
+constexpr uint64_t kHeapAllocTag = 0x4EA9123B4EA9123BULL;
+
+// The header is one max-aligned unit so the state itself stays max-aligned.
+constexpr std::size_t kAllocHeaderSize = alignof(std::max_align_t);
+
+// The arena (if any) that State allocations on this thread are drawn from.
+thread_local StateArena* active_state_arena = nullptr;
+
 }  // namespace
 
+StateArena::StateArena(std::size_t block_size) : block_size_(block_size) {}
+
+void* StateArena::Alloc(std::size_t bytes) {
+  // Round the request up so that subsequent allocations stay max-aligned.
+  const std::size_t aligned =
+      (bytes + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  while (current_block_ < blocks_.size() &&
+         blocks_[current_block_].used + aligned >
+             blocks_[current_block_].size) {
+    ++current_block_;
+  }
+  if (current_block_ == blocks_.size()) {
+    const std::size_t size = std::max(block_size_, aligned);
+    blocks_.push_back(Block{std::unique_ptr<char[]>(new char[size]), size, 0});
+  }
+  Block& block = blocks_[current_block_];
+  char* ptr = block.data.get() + block.used;
+  block.used += aligned;
+  return ptr;
+}
+
+void StateArena::Reset() {
+  for (Block& block : blocks_) {
+    block.used = 0;
+  }
+  current_block_ = 0;
+}
+
+std::size_t StateArena::BytesReserved() const {
+  std::size_t total = 0;
+  for (const Block& block : blocks_) {
+    total += block.size;
+  }
+  return total;
+}
+
+ScopedStateArena::ScopedStateArena(StateArena* arena)
+    : previous_(active_state_arena) {
+  active_state_arena = arena;
+}
+
+ScopedStateArena::~ScopedStateArena() { active_state_arena = previous_; }
+
+void* State::operator new(std::size_t bytes) {
+  char* base;
+  uint64_t tag;
+  if (active_state_arena != nullptr) {
+    base = static_cast<char*>(
+        active_state_arena->Alloc(bytes + kAllocHeaderSize));
+    tag = kArenaAllocTag;
+  } else {
+    base = static_cast<char*>(::operator new(bytes + kAllocHeaderSize));
+    tag = kHeapAllocTag;
+  }
+  *reinterpret_cast<uint64_t*>(base) = tag;
+  return base + kAllocHeaderSize;
+}
+
+void State::operator delete(void* ptr) {
+  if (ptr == nullptr) return;
+  char* base = static_cast<char*>(ptr) - kAllocHeaderSize;
+  const uint64_t tag = *reinterpret_cast<uint64_t*>(base);
+  if (tag == kHeapAllocTag) {
+    ::operator delete(base);
+  } else if (tag != kArenaAllocTag) {
+    SpielFatalError("State::operator delete called on an unknown pointer.");
+  }
+  // Arena allocations are reclaimed in bulk by StateArena::Reset().
+}
+
 std::ostream& operator<<(std::ostream& os, const StateType& type) {
   switch (type) {
     case StateType::kChance: {
@@ -87,6 +170,16 @@ StateType State::GetType() const {
   }
 }
 
+int64_t State::EstimatedMemory() const {
+  // Base-class bookkeeping only; overrides add sizeof(Derived) -
+  // sizeof(State) plus their own heap members.
+  return sizeof(State) + history_.MemoryUsed() +
+         legal_actions_cache_.capacity() * sizeof(Action) +
+         history_str_.capacity() +
+         history_str_offsets_.capacity() * sizeof(size_t) +
+         history_prefix_hashes_.capacity() * sizeof(uint64_t);
+}
+
 bool GameType::ContainsRequiredParameters() const {
   for (const auto& key_val : parameter_specification) {
     if (key_val.second.is_mandatory()) {
@@ -96,8 +189,9 @@ bool GameType::ContainsRequiredParameters() const {
   return false;
 }
 
-GameRegisterer::GameRegisterer(const GameType& game_type, CreateFunc creator) {
-  RegisterGame(game_type, creator);
+GameRegisterer::GameRegisterer(const std::string& short_name,
+                               TypeFunc game_type, CreateFunc creator) {
+  RegisterGame(short_name, game_type, creator);
 }
 
 std::shared_ptr<const Game> GameRegisterer::CreateByName(
@@ -109,8 +203,9 @@ std::shared_ptr<const Game> GameRegisterer::CreateByName(
                                  absl::StrJoin(RegisteredNames(), "\n")));
 
   } else {
-    ValidateParams(params, iter->second.first.parameter_specification);
-    return (iter->second.second)(params);
+    // First use of the game: this builds its GameType if nothing else has.
+    ValidateParams(params, iter->second.game_type().parameter_specification);
+    return (iter->second.creator)(params);
   }
 }
 
@@ -125,7 +220,7 @@ std::vector<std::string> GameRegisterer::RegisteredNames() {
 std::vector<GameType> GameRegisterer::RegisteredGames() {
   std::vector<GameType> games;
   for (const auto& key_val : factories()) {
-    games.push_back(key_val.second.first);
+    games.push_back(key_val.second.game_type());
   }
   return games;
 }
@@ -134,9 +229,10 @@ bool GameRegisterer::IsValidName(const std::string& short_name) {
   return factories().find(short_name) != factories().end();
 }
 
-void GameRegisterer::RegisterGame(const GameType& game_info,
+void GameRegisterer::RegisterGame(const std::string& short_name,
+                                  TypeFunc game_type,
                                   GameRegisterer::CreateFunc creator) {
-  factories()[game_info.short_name] = std::make_pair(game_info, creator);
+  factories()[short_name] = {game_type, creator};
 }
 
 bool IsGameRegistered(const std::string& short_name) {
@@ -157,12 +253,9 @@ std::shared_ptr<const Game> LoadGame(const std::string& game_string) {
 
 std::shared_ptr<const Game> LoadGame(const std::string& short_name,
                                      const GameParameters& params) {
-  std::shared_ptr<const Game> result =
-      GameRegisterer::CreateByName(short_name, params);
-  if (result == nullptr) {
-    SpielFatalError(absl::StrCat("Unable to create game: ", short_name));
-  }
-  return result;
+  GameParameters params_with_name = params;
+  params_with_name["name"] = GameParameter(short_name);
+  return LoadGame(std::move(params_with_name));
 }
 
 std::shared_ptr<const Game> LoadGame(GameParameters params) {
@@ -172,13 +265,44 @@ std::shared_ptr<const Game> LoadGame(GameParameters params) {
                                  GameParametersToString(params)));
   }
   std::string name = it->second.string_value();
+
+  // Process-wide intern table. Game instances are immutable once constructed
+  // and handed out as shared_ptr<const Game>, so repeated loads of the same
+  // parameterization can share one instance instead of re-running game
+  // setup. Leaked so that instances handed out late in the process lifetime
+  // stay valid regardless of static destruction order.
+  static std::mutex cache_mutex;
+  static auto* cache =
+      new std::unordered_map<std::string, std::shared_ptr<const Game>>();
+
+  const std::string game_string = GameParametersToString(params);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto cache_it = cache->find(game_string);
+    if (cache_it != cache->end()) return cache_it->second;
+  }
+
   params.erase(it);
   std::shared_ptr<const Game> result =
       GameRegisterer::CreateByName(name, params);
   if (result == nullptr) {
     SpielFatalError(absl::StrCat("Unable to create game: ", name));
   }
-  return result;
+
+  // Games with sampled chance nodes may carry internal sampling state, so
+  // distinct loads keep distinct instances.
+  if (result->GetType().chance_mode ==
+      GameType::ChanceMode::kSampledStochastic) {
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  // Keep the first instance if another thread finished construction first,
+  // and file the canonical spelling too in case the factory normalized the
+  // parameters.
+  auto inserted = cache->emplace(game_string, result);
+  cache->emplace(inserted.first->second->ToString(), inserted.first->second);
+  return inserted.first->second;
 }
 
 State::State(std::shared_ptr<const Game> game)
@@ -186,12 +310,86 @@ State::State(std::shared_ptr<const Game> game)
       num_players_(game->NumPlayers()),
       game_(game) {}
 
+namespace {
+
+// SplitMix64-style mixing step for the rolling history hash. The seed is
+// arbitrary but nonzero so the empty history does not hash to 0.
+constexpr uint64_t kHistoryHashSeed = 0x6a09e667f3bcc908ULL;
+
+uint64_t MixHistoryHash(uint64_t hash, Action action) {
+  uint64_t z = hash ^ (static_cast<uint64_t>(action) + 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+void State::TruncateStaleHistoryCaches() {
+  if (history_str_offsets_.size() > history_.size() + 1) {
+    history_str_offsets_.resize(history_.size() + 1);
+    history_prefix_hashes_.resize(history_.size() + 1);
+    history_str_.resize(history_str_offsets_.back());
+  }
+}
+
+void State::SyncHistoryCaches() const {
+  if (history_str_offsets_.empty()) {
+    history_str_offsets_.push_back(0);
+    history_prefix_hashes_.push_back(kHistoryHashSeed);
+  }
+  size_t cached = history_str_offsets_.size() - 1;
+  if (cached > history_.size()) {
+    // The history shrank (UndoAction): truncate to the surviving prefix.
+    cached = history_.size();
+    history_str_offsets_.resize(cached + 1);
+    history_prefix_hashes_.resize(cached + 1);
+    history_str_.resize(history_str_offsets_[cached]);
+  }
+  for (; cached < history_.size(); ++cached) {
+    if (cached > 0) history_str_.push_back(' ');
+    absl::StrAppend(&history_str_, history_[cached]);
+    history_str_offsets_.push_back(history_str_.size());
+    history_prefix_hashes_.push_back(
+        MixHistoryHash(history_prefix_hashes_.back(), history_[cached]));
+  }
+}
+
+void Game::BuildFlatParameters() {
+  flat_parameters_.clear();
+  flat_parameters_.reserve(game_parameters_.size() +
+                           game_type_.parameter_specification.size());
+  for (const auto& [key, value] : game_parameters_) {
+    flat_parameters_.push_back({&key, &value, /*user_supplied=*/true});
+  }
+  for (const auto& [key, value] : game_type_.parameter_specification) {
+    if (game_parameters_.find(key) == game_parameters_.end()) {
+      flat_parameters_.push_back({&key, &value, /*user_supplied=*/false});
+    }
+  }
+  std::sort(flat_parameters_.begin(), flat_parameters_.end(),
+            [](const FlatParameter& a, const FlatParameter& b) {
+              return *a.key < *b.key;
+            });
+}
+
+const Game::FlatParameter* Game::FindFlatParameter(
+    const std::string& key) const {
+  auto iter = std::lower_bound(
+      flat_parameters_.begin(), flat_parameters_.end(), key,
+      [](const FlatParameter& param, const std::string& k) {
+        return *param.key < k;
+      });
+  if (iter == flat_parameters_.end() || *iter->key != key) return nullptr;
+  return &*iter;
+}
+
 template <>
 GameParameters Game::ParameterValue<GameParameters>(
     const std::string& key, std::optional<GameParameters> default_value) const {
-  auto iter = game_parameters_.find(key);
-  if (iter != game_parameters_.end()) {
-    return iter->second.game_value();
+  const FlatParameter* param = FindFlatParameter(key);
+  if (param != nullptr && param->user_supplied) {
+    return param->value->game_value();
   }
 
   if (default_value == std::nullopt) {
@@ -209,97 +407,81 @@ GameParameters Game::ParameterValue<GameParameters>(
 template <>
 int Game::ParameterValue<int>(const std::string& key,
                               std::optional<int> default_value) const {
-  auto iter = game_parameters_.find(key);
-  if (iter == game_parameters_.end()) {
-    GameParameter default_game_parameter;
-    if (default_value != std::nullopt) {
-      default_game_parameter = GameParameter(default_value.value());
-    } else {
-      auto default_iter = game_type_.parameter_specification.find(key);
-      if (default_iter == game_type_.parameter_specification.end()) {
-        SpielFatalError(absl::StrCat("No default parameter for ", key,
-                                     " and it was not provided as an argument. "
-                                     "It is likely it should be mandatory."));
-      }
-      default_game_parameter = default_iter->second;
-    }
-    defaulted_parameters_[key] = default_game_parameter;
-    return default_game_parameter.int_value();
-  } else {
-    return iter->second.int_value();
+  const FlatParameter* param = FindFlatParameter(key);
+  if (param != nullptr && param->user_supplied) {
+    return param->value->int_value();
+  }
+  if (default_value != std::nullopt) {
+    defaulted_parameters_[key] = GameParameter(default_value.value());
+    return default_value.value();
+  }
+  if (param == nullptr) {
+    SpielFatalError(absl::StrCat("No default parameter for ", key,
+                                 " and it was not provided as an argument. "
+                                 "It is likely it should be mandatory."));
   }
+  defaulted_parameters_[key] = *param->value;
+  return param->value->int_value();
 }
 
 template <>
 double Game::ParameterValue<double>(const std::string& key,
                                     std::optional<double> default_value) const {
-  auto iter = game_parameters_.find(key);
-  if (iter == game_parameters_.end()) {
-    GameParameter default_game_parameter;
-    if (default_value != std::nullopt) {
-      default_game_parameter = GameParameter(default_value.value());
-    } else {
-      auto default_iter = game_type_.parameter_specification.find(key);
-      if (default_iter == game_type_.parameter_specification.end()) {
-        SpielFatalError(absl::StrCat("No default parameter for ", key,
-                                     " and it was not provided as an argument. "
-                                     "It is likely it should be mandatory."));
-      }
-      default_game_parameter = default_iter->second;
-    }
-    defaulted_parameters_[key] = default_game_parameter;
-    return default_game_parameter.double_value();
-  } else {
-    return iter->second.double_value();
+  const FlatParameter* param = FindFlatParameter(key);
+  if (param != nullptr && param->user_supplied) {
+    return param->value->double_value();
   }
+  if (default_value != std::nullopt) {
+    defaulted_parameters_[key] = GameParameter(default_value.value());
+    return default_value.value();
+  }
+  if (param == nullptr) {
+    SpielFatalError(absl::StrCat("No default parameter for ", key,
+                                 " and it was not provided as an argument. "
+                                 "It is likely it should be mandatory."));
+  }
+  defaulted_parameters_[key] = *param->value;
+  return param->value->double_value();
 }
 
 template <>
 std::string Game::ParameterValue<std::string>(
     const std::string& key, std::optional<std::string> default_value) const {
-  auto iter = game_parameters_.find(key);
-  if (iter == game_parameters_.end()) {
-    GameParameter default_game_parameter;
-    if (default_value != std::nullopt) {
-      default_game_parameter = GameParameter(default_value.value());
-    } else {
-      auto default_iter = game_type_.parameter_specification.find(key);
-      if (default_iter == game_type_.parameter_specification.end()) {
-        SpielFatalError(absl::StrCat("No default parameter for ", key,
-                                     " and it was not provided as an argument. "
-                                     "It is likely it should be mandatory."));
-      }
-      default_game_parameter = default_iter->second;
-    }
-    defaulted_parameters_[key] = default_game_parameter;
-    return default_game_parameter.string_value();
-  } else {
-    return iter->second.string_value();
+  const FlatParameter* param = FindFlatParameter(key);
+  if (param != nullptr && param->user_supplied) {
+    return param->value->string_value();
+  }
+  if (default_value != std::nullopt) {
+    defaulted_parameters_[key] = GameParameter(default_value.value());
+    return default_value.value();
+  }
+  if (param == nullptr) {
+    SpielFatalError(absl::StrCat("No default parameter for ", key,
+                                 " and it was not provided as an argument. "
+                                 "It is likely it should be mandatory."));
   }
+  defaulted_parameters_[key] = *param->value;
+  return param->value->string_value();
 }
 
 template <>
 bool Game::ParameterValue<bool>(const std::string& key,
                                 std::optional<bool> default_value) const {
-  auto iter = game_parameters_.find(key);
-  if (iter == game_parameters_.end()) {
-    GameParameter default_game_parameter;
-    if (default_value != std::nullopt) {
-      default_game_parameter = GameParameter(default_value.value());
-    } else {
-      auto default_iter = game_type_.parameter_specification.find(key);
-      if (default_iter == game_type_.parameter_specification.end()) {
-        SpielFatalError(absl::StrCat("No default parameter for ", key,
-                                     " and it was not provided as an argument. "
-                                     "It is likely it should be mandatory."));
-      }
-      default_game_parameter = default_iter->second;
-    }
-    defaulted_parameters_[key] = default_game_parameter;
-    return default_game_parameter.bool_value();
-  } else {
-    return iter->second.bool_value();
+  const FlatParameter* param = FindFlatParameter(key);
+  if (param != nullptr && param->user_supplied) {
+    return param->value->bool_value();
+  }
+  if (default_value != std::nullopt) {
+    defaulted_parameters_[key] = GameParameter(default_value.value());
+    return default_value.value();
   }
+  if (param == nullptr) {
+    SpielFatalError(absl::StrCat("No default parameter for ", key,
+                                 " and it was not provided as an argument. "
+                                 "It is likely it should be mandatory."));
+  }
+  defaulted_parameters_[key] = *param->value;
+  return param->value->bool_value();
 }
 
 Action SampleChanceOutcome(const ActionsAndProbs& outcomes, double z) {
@@ -334,6 +516,25 @@ Action SampleChanceOutcome(const ActionsAndProbs& outcomes, double z) {
       absl::StrCat("Internal error: failed to sample an outcome; z=", z));
 }
 
+std::pair<Action, double> State::SampleChanceOutcome(double z) const {
+  ActionsAndProbs outcomes = ChanceOutcomes();
+  double sum = 0;
+  for (const std::pair<Action, double>& outcome : outcomes) {
+    if (sum <= z && z < sum + outcome.second) return outcome;
+    sum += outcome.second;
+  }
+  SpielFatalError(
+      absl::StrCat("Internal error: failed to sample an outcome; z=", z));
+}
+
+Action State::SampleLegalAction(double z) const {
+  std::vector<Action> actions = LegalActions();
+  SPIEL_CHECK_FALSE(actions.empty());
+  int index = static_cast<int>(z * actions.size());
+  if (index >= actions.size()) index = actions.size() - 1;
+  return actions[index];
+}
+
 std::string State::Serialize() const {
   // This simple serialization doesn't work for games with sampled chance
   // nodes, since the history doesn't give us enough information to reconstruct
@@ -344,6 +545,21 @@ std::string State::Serialize() const {
   return absl::StrCat(absl::StrJoin(History(), "\n"), "\n");
 }
 
+std::string State::SerializeBinary() const {
+  // As with Serialize(), the history is not enough to reconstruct states of
+  // games with sampled chance nodes; such games must override this.
+  SPIEL_CHECK_NE(game_->GetType().chance_mode,
+                 GameType::ChanceMode::kSampledStochastic);
+  std::string str;
+  std::vector<Action> history = History();
+  AppendVarint(history.size(), &str);
+  for (Action action : history) {
+    SPIEL_CHECK_GE(action, 0);
+    AppendVarint(static_cast<uint64_t>(action), &str);
+  }
+  return str;
+}
+
 std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
   // This simple deserialization doesn't work for games with sampled chance
   // nodes, since the history doesn't give us enough information to reconstruct
@@ -376,6 +592,36 @@ std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
   return state;
 }
 
+std::unique_ptr<State> Game::DeserializeStateBinary(
+    const std::string& str) const {
+  // See DeserializeState: sampled chance nodes cannot be replayed.
+  SPIEL_CHECK_NE(game_type_.chance_mode,
+                 GameType::ChanceMode::kSampledStochastic);
+
+  size_t offset = 0;
+  uint64_t num_actions = DecodeVarint(str, &offset);
+  std::vector<Action> history;
+  history.reserve(num_actions);
+  for (uint64_t i = 0; i < num_actions; ++i) {
+    history.push_back(static_cast<Action>(DecodeVarint(str, &offset)));
+  }
+  SPIEL_CHECK_EQ(offset, str.size());
+
+  std::unique_ptr<State> state = NewInitialState();
+  for (int i = 0; i < history.size(); ++i) {
+    if (state->IsSimultaneousNode()) {
+      SPIEL_CHECK_LE(i + state->NumPlayers(), history.size());
+      std::vector<Action> actions(history.begin() + i,
+                                  history.begin() + i + state->NumPlayers());
+      state->ApplyActions(actions);
+      i += state->NumPlayers() - 1;
+    } else {
+      state->ApplyAction(history[i]);
+    }
+  }
+  return state;
+}
+
 std::string SerializeGameAndState(const Game& game, const State& state) {
   std::string str = "";
 
@@ -398,6 +644,53 @@ std::string SerializeGameAndState(const Game& game, const State& state) {
   return str;
 }
 
+void BatchInformationStateAsNormalizedVector(
+    const std::vector<const State*>& states, int stride, double* buffer) {
+  if (states.empty()) return;
+  SPIEL_CHECK_GE(
+      stride,
+      states[0]->GetGame()->InformationStateNormalizedVectorSize());
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->InformationStateAsNormalizedVector(
+        states[i]->CurrentPlayer(), buffer + static_cast<int64_t>(i) * stride);
+  }
+}
+
+void BatchObservationAsNormalizedVector(const std::vector<const State*>& states,
+                                        int stride, double* buffer) {
+  if (states.empty()) return;
+  SPIEL_CHECK_GE(stride,
+                 states[0]->GetGame()->ObservationNormalizedVectorSize());
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->ObservationAsNormalizedVector(
+        states[i]->CurrentPlayer(), buffer + static_cast<int64_t>(i) * stride);
+  }
+}
+
+std::string SerializeStatesBinary(const std::vector<const State*>& states) {
+  std::string str;
+  for (const State* state : states) {
+    std::string record = state->SerializeBinary();
+    AppendVarint(record.size(), &str);
+    str.append(record);
+  }
+  return str;
+}
+
+std::vector<std::unique_ptr<State>> DeserializeStatesBinary(
+    const Game& game, const std::string& str) {
+  std::vector<std::unique_ptr<State>> states;
+  size_t offset = 0;
+  while (offset < str.size()) {
+    uint64_t record_size = DecodeVarint(str, &offset);
+    SPIEL_CHECK_LE(offset + record_size, str.size());
+    states.push_back(
+        game.DeserializeStateBinary(str.substr(offset, record_size)));
+    offset += record_size;
+  }
+  return states;
+}
+
 std::pair<std::shared_ptr<const Game>, std::unique_ptr<State>>
 DeserializeGameAndState(const std::string& serialized_state) {
   std::vector<std::string> lines = absl::StrSplit(serialized_state, '\n');
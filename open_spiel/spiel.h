@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -138,6 +140,16 @@ enum class StateType {
 };
 std::ostream& operator<<(std::ostream& os, const StateType& type);
 
+// Stages of legal-action generation, for games that can produce their
+// actions in phases (see Game::ProvidesStagedActions). The stages are
+// ordered from most to least forcing, so a cut-off-driven search that
+// consumes them in order can often stop before the later (and typically
+// much larger) stages are ever generated.
+enum class ActionStage {
+  kForcing,  // Captures, promotions, and similarly tactical moves.
+  kQuiet,    // Everything else.
+};
+
 std::ostream& operator<<(std::ostream& stream, GameType::Dynamics value);
 std::ostream& operator<<(std::ostream& stream, GameType::ChanceMode value);
 std::ostream& operator<<(std::ostream& stream, GameType::Information value);
@@ -149,6 +161,192 @@ using ActionsAndProbs = std::vector<std::pair<Action, double>>;
 // Forward declaration needed for the backpointer within State.
 class Game;
 
+// A bump allocator for transient State clones. Tree-walking algorithms (e.g.
+// CFR, best response) clone states at every node; allocating those clones
+// from an arena replaces per-node malloc/free with pointer bumps plus one
+// bulk Reset() between iterations.
+//
+// The arena is activated on the current thread via ScopedStateArena (below).
+// While active, State::operator new draws from the arena and State::operator
+// delete becomes a no-op (destructors still run); the memory is reclaimed all
+// at once by Reset(). Consequently, every state allocated while the arena is
+// active must be destroyed before Reset() is called.
+class StateArena {
+ public:
+  explicit StateArena(std::size_t block_size = kDefaultBlockSize);
+
+  // Not copyable or movable; blocks are referenced by live allocations.
+  StateArena(const StateArena&) = delete;
+  StateArena& operator=(const StateArena&) = delete;
+
+  // Returns a pointer to `bytes` bytes of storage, aligned for any type.
+  // The pointer remains valid until the next call to Reset().
+  void* Alloc(std::size_t bytes);
+
+  // Bulk-frees every allocation made so far. Block capacity is retained so
+  // that subsequent iterations allocate without touching the heap.
+  void Reset();
+
+  // Total bytes of block capacity currently reserved by the arena.
+  std::size_t BytesReserved() const;
+
+  static constexpr std::size_t kDefaultBlockSize = 1 << 20;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+    std::size_t used;
+  };
+
+  std::size_t block_size_;
+  std::vector<Block> blocks_;
+  int current_block_ = 0;
+};
+
+// Makes `arena` the active state arena on the current thread for the lifetime
+// of this object, restoring the previously active arena (if any) on
+// destruction. Pass nullptr to suspend an enclosing arena, e.g. around code
+// that creates states which outlive the arena's next Reset().
+class ScopedStateArena {
+ public:
+  explicit ScopedStateArena(StateArena* arena);
+  ~ScopedStateArena();
+
+  ScopedStateArena(const ScopedStateArena&) = delete;
+  ScopedStateArena& operator=(const ScopedStateArena&) = delete;
+
+ private:
+  StateArena* previous_;
+};
+
+// Compact storage for a state's action history. Action ids are int64, but
+// no registered game's ids need anywhere near that range, and with millions
+// of live states (enumeration, tree search) the history is a large share of
+// a State's footprint. Elements are stored at the narrowest of 2, 4 or 8
+// bytes that has fitted every action pushed so far, widening (re-encoding
+// in place, at most twice over a history's lifetime) the first time a
+// larger id arrives; kInvalidAction is mapped to the narrow widths'
+// all-ones sentinel. The interface mirrors the std::vector<Action> it
+// replaces, decoding on access; it converts back to one implicitly where a
+// real vector is needed.
+class ActionHistory {
+ public:
+  // Decoding iterator, sufficient for range-for and std::equal.
+  class const_iterator {
+   public:
+    const_iterator(const ActionHistory* history, size_t index)
+        : history_(history), index_(index) {}
+    Action operator*() const { return (*history_)[index_]; }
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const ActionHistory* history_;
+    size_t index_;
+  };
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  void clear() {
+    data_.clear();
+    size_ = 0;
+  }
+  void reserve(size_t entries) { data_.reserve(entries * width_); }
+
+  Action operator[](size_t i) const {
+    return Load(data_.data() + i * width_, width_);
+  }
+  Action back() const { return (*this)[size_ - 1]; }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  void push_back(Action action) {
+    while (!Fits(action, width_)) Widen(width_ == 2 ? 4 : 8);
+    data_.resize(data_.size() + width_);
+    Store(data_.data() + size_ * width_, width_, action);
+    ++size_;
+  }
+  void pop_back() {
+    data_.resize(data_.size() - width_);
+    --size_;
+  }
+
+  std::vector<Action> ToVector() const {
+    std::vector<Action> actions;
+    actions.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) actions.push_back((*this)[i]);
+    return actions;
+  }
+  operator std::vector<Action>() const { return ToVector(); }  // NOLINT
+  ActionHistory& operator=(const std::vector<Action>& actions) {
+    clear();
+    reserve(actions.size());
+    for (Action action : actions) push_back(action);
+    return *this;
+  }
+
+  // Heap bytes held for the encoded actions, for memory accounting.
+  size_t MemoryUsed() const { return data_.capacity(); }
+
+ private:
+  static uint64_t Sentinel(int width) {
+    return width == 2 ? 0xFFFF : 0xFFFFFFFFull;
+  }
+  static bool Fits(Action action, int width) {
+    if (width == 8 || action == kInvalidAction) return true;
+    return action >= 0 && static_cast<uint64_t>(action) < Sentinel(width);
+  }
+  static void Store(char* dest, int width, Action action) {
+    if (width == 8) {
+      std::memcpy(dest, &action, sizeof(action));
+    } else if (width == 4) {
+      const uint32_t encoded =
+          action == kInvalidAction ? 0xFFFFFFFFu : static_cast<uint32_t>(action);
+      std::memcpy(dest, &encoded, sizeof(encoded));
+    } else {
+      const uint16_t encoded =
+          action == kInvalidAction ? 0xFFFF : static_cast<uint16_t>(action);
+      std::memcpy(dest, &encoded, sizeof(encoded));
+    }
+  }
+  static Action Load(const char* src, int width) {
+    if (width == 8) {
+      Action action;
+      std::memcpy(&action, src, sizeof(action));
+      return action;
+    } else if (width == 4) {
+      uint32_t encoded;
+      std::memcpy(&encoded, src, sizeof(encoded));
+      return encoded == 0xFFFFFFFFu ? kInvalidAction : Action{encoded};
+    } else {
+      uint16_t encoded;
+      std::memcpy(&encoded, src, sizeof(encoded));
+      return encoded == 0xFFFF ? kInvalidAction : Action{encoded};
+    }
+  }
+  void Widen(int new_width) {
+    std::vector<char> widened(size_ * new_width);
+    for (size_t i = 0; i < size_; ++i) {
+      Store(widened.data() + i * new_width, new_width, (*this)[i]);
+    }
+    data_ = std::move(widened);
+    width_ = new_width;
+  }
+
+  int width_ = 2;
+  size_t size_ = 0;
+  std::vector<char> data_;
+};
+
 // An abstract class that represents a state of the game.
 class State {
  public:
@@ -163,7 +361,21 @@ class State {
   // be used as value types and should always be created via a shared pointer.
   // See the documentation of the Game object for further details.
   State(std::shared_ptr<const Game> game);
-  State(const State&) = default;
+  // Copying is member-wise; spelled out (rather than defaulted) only so the
+  // kStateClones counter can be hooked here, the choke point every game's
+  // Clone() goes through.
+  State(const State& other)
+      : num_distinct_actions_(other.num_distinct_actions_),
+        num_players_(other.num_players_),
+        history_(other.history_),
+        game_(other.game_),
+        legal_actions_cache_(other.legal_actions_cache_),
+        legal_actions_cache_valid_(other.legal_actions_cache_valid_),
+        history_str_(other.history_str_),
+        history_str_offsets_(other.history_str_offsets_),
+        history_prefix_hashes_(other.history_prefix_hashes_) {
+    SPIEL_STATS_INCREMENT(kStateClones);
+  }
 
   // Returns current player. Player numbers start from 0.
   // Negative numbers are for chance (-1) or simultaneous (-2).
@@ -185,7 +397,9 @@ class State {
     // history_ needs to be modified *after* DoApplyAction which could
     // be using it.
     DoApplyAction(action_id);
+    TruncateStaleHistoryCaches();
     history_.push_back(action_id);
+    InvalidateLegalActionsCache();
   }
 
   // `LegalActions(Player player)` is valid for all nodes in all games,
@@ -218,6 +432,39 @@ class State {
   // is added.
   virtual std::vector<Action> LegalActions() const = 0;
 
+  // Legal actions belonging to the given stage, in ascending order, for
+  // games with staged generation (Game::ProvidesStagedActions). Every legal
+  // action belongs to exactly one stage, so the stages together partition
+  // LegalActions(). Generating a stage only pays for the moves in that
+  // stage, which lets a search with cut-offs skip quiet-move generation at
+  // nodes refuted by a capture.
+  virtual std::vector<Action> LegalActions(ActionStage stage) const {
+    SpielFatalError("LegalActions(stage) is not implemented.");
+  }
+
+  // Like LegalActions(), but caches the result on this state: the first call
+  // runs move generation and later calls serve the cached list until an
+  // action is applied or undone. Useful for algorithms that query the same
+  // node's actions several times (e.g. once to size value vectors and again
+  // when sampling), where each call would otherwise re-run full move
+  // generation.
+  const std::vector<Action>& CachedLegalActions() const {
+    if (!legal_actions_cache_valid_) {
+      SPIEL_STATS_INCREMENT(kLegalActionsComputes);
+      legal_actions_cache_ = LegalActions();
+      legal_actions_cache_valid_ = true;
+    }
+    return legal_actions_cache_;
+  }
+
+  // Returns a uniformly sampled legal action for the current player, where z
+  // is a uniformly random value in [0, 1). The default indexes into
+  // LegalActions(); games whose moves can be counted and found in place
+  // (e.g. empty cells on a board) may override it to sample without
+  // materializing the action list, which keeps random rollouts
+  // allocation-free.
+  virtual Action SampleLegalAction(double z) const;
+
   // Returns a vector of length `game.NumDistinctActions()` containing 1 for
   // legal actions and 0 for illegal actions.
   std::vector<int> LegalActionsMask(Player player) const {
@@ -230,8 +477,12 @@ class State {
     return mask;
   }
 
-  // Convenience function for turn-based games.
-  std::vector<int> LegalActionsMask() const {
+  // Convenience function for turn-based games. Virtual so that games whose
+  // board representation yields the mask directly (e.g. one cell per action)
+  // can fill it without materializing the action list first. As with
+  // LegalActions(), overriding this hides the player-argument overload in the
+  // derived class unless a using directive is added.
+  virtual std::vector<int> LegalActionsMask() const {
     return LegalActionsMask(CurrentPlayer());
   }
 
@@ -242,6 +493,18 @@ class State {
   // This method will format chance outcomes if player == kChancePlayer
   virtual std::string ActionToString(Player player, Action action_id) const = 0;
 
+  // Buffer-reuse form of the above: clears `out` and writes the action
+  // string into it, so a buffer reused across calls in a logging or
+  // serialization loop keeps its capacity instead of paying an allocation
+  // per action. The default defers to the allocating form; games whose
+  // action strings are assembled from cheap pieces can override it to
+  // append in place.
+  virtual void ActionToString(Player player, Action action_id,
+                              std::string* out) const {
+    out->clear();
+    out->append(ActionToString(player, action_id));
+  }
+
   // Returns a string representation of the state. This has no particular
   // semantics and is targeting debugging code.
   virtual std::string ToString() const = 0;
@@ -308,8 +571,24 @@ class State {
   // including chance) and the `State` objects.
   virtual std::vector<Action> History() const { return history_; }
 
-  virtual std::string HistoryString() const {
-    return absl::StrJoin(history_, " ");
+  // Maintained incrementally: the cached string (and per-prefix data) is
+  // reconciled with history_ on access, appending after ApplyAction and
+  // truncating after UndoAction, so each call costs the delta since the
+  // last one rather than a full re-join. The reference stays valid until
+  // the history next changes.
+  virtual const std::string& HistoryString() const {
+    SyncHistoryCaches();
+    return history_str_;
+  }
+
+  // A rolling 64-bit hash of the action history (sensitive to order and
+  // length). Unlike HashValue it is defined for every game, but it keys
+  // histories, not positions: transpositions hash differently. Maintained
+  // incrementally alongside HistoryString; use it where the history string
+  // would be hashed as a map key, keeping the string for collision checks.
+  uint64_t HistoryHash() const {
+    SyncHistoryCaches();
+    return history_prefix_hashes_.back();
   }
 
   // For imperfect information games. Returns an identifier for the current
@@ -347,6 +626,51 @@ class State {
     return InformationState(CurrentPlayer());
   }
 
+  // A compact integer key identifying the information state for the specified
+  // player, usable in place of the InformationState() string as a hash-table
+  // key (see Game::ProvidesInformationStateKey). Two states must receive the
+  // same key if and only if their InformationState strings are equal. Games
+  // whose information states can be encoded in 64 bits should override this
+  // to spare tabular algorithms the per-lookup string construction.
+  virtual uint64_t InformationStateKey(Player player) const {
+    SpielFatalError("InformationStateKey is not implemented.");
+  }
+
+  virtual uint64_t InformationStateKey() const {
+    return InformationStateKey(CurrentPlayer());
+  }
+
+  // Returns a 64-bit hash identifying this state, for use as a
+  // transposition-table key (see Game::ProvidesHashValue). States reaching
+  // the same position through different move orders should hash equal.
+  // Games that already maintain an incremental (e.g. Zobrist) hash can
+  // serve this at no per-call cost.
+  virtual uint64_t HashValue() const {
+    SpielFatalError("HashValue is not implemented.");
+  }
+
+  // A string identifying this state's symmetry class (see
+  // Game::ProvidesCanonicalForm): the minimal rendering of the position over
+  // the game's symmetry group, so states that are rotations or reflections
+  // of each other return the same string. Not required to match ToString.
+  virtual std::string CanonicalString() const {
+    SpielFatalError("CanonicalString is not implemented.");
+  }
+
+  // A 64-bit hash of the canonical form, for keying transposition tables
+  // and visited sets that should treat symmetric positions as one. The
+  // default hashes CanonicalString; games can override it to skip the
+  // string when the canonical form is cheap to encode directly.
+  virtual uint64_t CanonicalHash() const {
+    // FNV-1a over the canonical string.
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : CanonicalString()) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
   // Vector form, useful for neural-net function approximation approaches.
   // The size of the vector must match Game::InformationStateShape()
   // with values in lexicographic order. E.g. for 2x4x3, order would be:
@@ -373,6 +697,19 @@ class State {
     return normalized_info_state;
   }
 
+  // Writes the normalized information state vector into `buffer`, which must
+  // point at Game::InformationStateNormalizedVectorSize() doubles, in the
+  // same lexicographic layout as the vector form above. The default copies
+  // through the vector-based virtual; games with large tensors override it to
+  // fill the caller's memory in a single pass, so batch encoders can write
+  // straight into rows of a preallocated tensor with no per-state allocation.
+  virtual void InformationStateAsNormalizedVector(Player player,
+                                                  double* buffer) const {
+    std::vector<double> values;
+    InformationStateAsNormalizedVector(player, &values);
+    std::copy(values.begin(), values.end(), buffer);
+  }
+
   // We have functions for observations which are parallel to those for
   // information states. An observation should have the following properties:
   //  - It has at most the same information content as the information state
@@ -411,6 +748,16 @@ class State {
     return normalized_observation;
   }
 
+  // Buffer-filling form of the above; see
+  // InformationStateAsNormalizedVector(Player, double*). `buffer` must point
+  // at Game::ObservationNormalizedVectorSize() doubles.
+  virtual void ObservationAsNormalizedVector(Player player,
+                                             double* buffer) const {
+    std::vector<double> values;
+    ObservationAsNormalizedVector(player, &values);
+    std::copy(values.begin(), values.end(), buffer);
+  }
+
   // Return a copy of this state.
   virtual std::unique_ptr<State> Clone() const = 0;
 
@@ -424,11 +771,23 @@ class State {
   // Undoes the last action, which must be supplied. This is a fast method to
   // undo an action. It is only necessary for algorithms that need a fast undo
   // (e.g. minimax search).
-  // One must call history_.pop_back() in the implementations.
+  // One must call history_.pop_back() in the implementations, and also
+  // InvalidateLegalActionsCache() so that CachedLegalActions() stays correct.
   virtual void UndoAction(Player player, Action action) {
     SpielFatalError("UndoAction function is not overridden; not undoing.");
   }
 
+  // In-place depth-first traversal primitive for games whose states implement
+  // UndoAction (see Game::ProvidesUndo). Applies `action`, invokes `visit` on
+  // the resulting state, then undoes the action, leaving this state as it
+  // was. This avoids the full state copy that Child() performs.
+  void VisitChild(Action action, const std::function<void(State*)>& visit) {
+    Player player = CurrentPlayer();
+    ApplyAction(action);
+    visit(this);
+    UndoAction(player, action);
+  }
+
   // Change the state of the game by applying the specified actions, one per
   // player, for simultaneous action games. This function encodes the logic of
   // the game rules. Element i of the vector is the action for player i.
@@ -440,8 +799,10 @@ class State {
     // history_ needs to be modified *after* DoApplyActions which could
     // be using it.
     DoApplyActions(actions);
+    TruncateStaleHistoryCaches();
     history_.reserve(history_.size() + actions.size());
-    history_.insert(history_.end(), actions.begin(), actions.end());
+    for (Action action : actions) history_.push_back(action);
+    InvalidateLegalActionsCache();
   }
 
   // The size of the action space. See `Game` for a full description.
@@ -469,6 +830,14 @@ class State {
     SpielFatalError("ChanceOutcomes unimplemented!");
   }
 
+  // Samples an outcome at a chance node, where z is a uniformly random value
+  // in [0, 1). Returns the sampled outcome and its probability. The default
+  // implementation materializes ChanceOutcomes(); games with simple chance
+  // distributions may override it with a direct sampling path that avoids
+  // building the outcome vector, which helps sampling-based algorithms such
+  // as MCCFR.
+  virtual std::pair<Action, double> SampleChanceOutcome(double z) const;
+
   // Lists the valid chance outcomes at the current state.
   // Derived classes may substitute this with a more efficient implementation.
   virtual std::vector<Action> LegalChanceOutcomes() const {
@@ -485,6 +854,22 @@ class State {
   // StateType definition for definitions of the different types.
   StateType GetType() const;
 
+  // Estimated footprint of this state in bytes, covering the object and its
+  // heap storage. The default counts the base-class bookkeeping (history and
+  // its caches); subclasses whose states carry significant extra storage
+  // should override, adding their own object size and dynamic members on
+  // top of the base estimate. Intended for capacity planning, so a rough
+  // figure is fine; see also the memory gauges in spiel_utils.h.
+  virtual int64_t EstimatedMemory() const;
+
+  // States are allocated from the active StateArena when one is installed on
+  // the current thread (see ScopedStateArena); deletion of arena-allocated
+  // states runs the destructor but leaves the memory to be reclaimed in bulk
+  // by StateArena::Reset(). Without an active arena these forward to the
+  // global operator new/delete.
+  static void* operator new(std::size_t bytes);
+  static void operator delete(void* ptr);
+
   // Serializes a state into a string.
   //
   // The default implementation writes out a sequence of actions, one per line,
@@ -496,6 +881,16 @@ class State {
   // If overridden, this must be the inverse of Game::DeserializeState.
   virtual std::string Serialize() const;
 
+  // Compact binary form of Serialize(): the action history, varint-coded
+  // (see AppendVarint in spiel_utils.h), preceded by a varint count. This is
+  // both much smaller than the decimal text form and much faster to parse.
+  //
+  // Games for which replaying the history is expensive may override this
+  // (together with Game::DeserializeStateBinary) to dump a direct snapshot
+  // of the state instead. As with Serialize(), the default does not work for
+  // games whose chance mode is kSampledStochastic.
+  virtual std::string SerializeBinary() const;
+
  protected:
   // See ApplyAction.
   virtual void DoApplyAction(Action action_id) {
@@ -506,13 +901,49 @@ class State {
     SpielFatalError("DoApplyActions is not implemented.");
   }
 
+  // Drops the list cached by CachedLegalActions(). Called by the
+  // ApplyAction(s) wrappers; UndoAction implementations must call it
+  // themselves.
+  void InvalidateLegalActionsCache() const {
+    legal_actions_cache_valid_ = false;
+  }
+
+  // Truncates the history string/hash caches to the live prefix. Called by
+  // the ApplyAction(s) wrappers before the new action is pushed: after
+  // UndoAction the caches may still cover the undone suffix, and once a
+  // sibling action is applied at the same depth, the lazy sync (which
+  // reconciles by length alone) could no longer tell the stale tail apart.
+  void TruncateStaleHistoryCaches();
+
   // Fields common to every game state.
   int num_distinct_actions_;
   int num_players_;
-  std::vector<Action> history_;  // The list of actions leading to the state.
+  ActionHistory history_;  // The list of actions leading to the state.
 
   // A pointer to the game that created this state.
   std::shared_ptr<const Game> game_;
+
+ private:
+  // Brings the history string and prefix-hash caches in sync with
+  // history_, appending or truncating as needed. Reconciling against the
+  // length alone is sound because any cached tail the history diverged
+  // from was already dropped at mutation time: ApplyAction(s) call
+  // TruncateStaleHistoryCaches before pushing, and UndoAction only ever
+  // shrinks history_ from the back.
+  void SyncHistoryCaches() const;
+
+  // See CachedLegalActions(). Mutable so that the first (const) query can
+  // fill the cache.
+  mutable std::vector<Action> legal_actions_cache_;
+  mutable bool legal_actions_cache_valid_ = false;
+
+  // See HistoryString() and HistoryHash(). history_str_offsets_[i] is the
+  // length of the string covering the first i actions, and
+  // history_prefix_hashes_[i] the hash of that prefix, so truncation is a
+  // resize. Lazily (re)built, hence mutable.
+  mutable std::string history_str_;
+  mutable std::vector<size_t> history_str_offsets_;
+  mutable std::vector<uint64_t> history_prefix_hashes_;
 };
 
 // A class that refers to a particular game instantiation, for example
@@ -627,6 +1058,11 @@ class Game : public std::enable_shared_from_this<Game> {
   // Game::SerializeState (i.e. it should also be overridden).
   virtual std::unique_ptr<State> DeserializeState(const std::string& str) const;
 
+  // Builds a state from the binary form written by State::SerializeBinary,
+  // and must be kept its inverse (i.e. overridden together with it).
+  virtual std::unique_ptr<State> DeserializeStateBinary(
+      const std::string& str) const;
+
   // Maximum length of any one game (in terms of number of decision nodes
   // visited in the game tree). For a simultaneous action game, this is the
   // maximum number of joint decisions. In a turn-based game, this is the
@@ -634,12 +1070,40 @@ class Game : public std::enable_shared_from_this<Game> {
   // of chance nodes are not included in this length.
   virtual int MaxGameLength() const = 0;
 
+  // Whether the states of this game implement State::UndoAction. When true,
+  // tree-walking algorithms can traverse depth-first in place via
+  // apply/undo (see State::VisitChild) rather than cloning the state at
+  // every child. Games that override UndoAction should also override this.
+  virtual bool ProvidesUndo() const { return false; }
+
+  // Whether the states of this game implement State::InformationStateKey.
+  virtual bool ProvidesInformationStateKey() const { return false; }
+
+  // Whether the states of this game implement State::HashValue.
+  virtual bool ProvidesHashValue() const { return false; }
+
+  // Whether the states of this game implement State::CanonicalString (and
+  // thus State::CanonicalHash): symmetry-reduced keys under which rotated
+  // and reflected variants of a position compare equal. Board games with
+  // large symmetry groups provide these so that enumeration and
+  // transposition tables can collapse up to |group| symmetric positions
+  // into one.
+  virtual bool ProvidesCanonicalForm() const { return false; }
+
+  // Whether the states of this game implement State::LegalActions(stage):
+  // generation of forcing moves (captures and promotions) separately from,
+  // and without paying for, quiet-move generation. Searches with cut-offs
+  // use this to defer the quiet stage until it is actually reached.
+  virtual bool ProvidesStagedActions() const { return false; }
+
   // A string representation of the game, which can be passed to LoadGame.
   std::string ToString() const;
 
  protected:
   Game(GameType game_type, GameParameters game_parameters)
-      : game_type_(game_type), game_parameters_(game_parameters) {}
+      : game_type_(game_type), game_parameters_(game_parameters) {
+    BuildFlatParameters();
+  }
 
   // Access to game parameters. Returns the value provided by the user. If not:
   // - Defaults to the value stored as the default in
@@ -658,35 +1122,73 @@ class Game : public std::enable_shared_from_this<Game> {
   // Track the parameters for which a default value has been used. This
   // enables us to report the actual value used for every parameter.
   mutable GameParameters defaulted_parameters_;
+
+ private:
+  // One resolved parameter: the key and value are interned as pointers into
+  // game_parameters_ or the type's parameter_specification, whose node
+  // addresses are stable for the life of the game.
+  struct FlatParameter {
+    const std::string* key;
+    const GameParameter* value;
+    bool user_supplied;  // From game_parameters_, not a spec default.
+  };
+
+  // Merges game_parameters_ and the parameter specification into
+  // flat_parameters_, sorted by key, with user values shadowing spec
+  // defaults. Game constructors call ParameterValue repeatedly; resolving a
+  // key is then one binary search over the flat table instead of lookups in
+  // two maps of strings.
+  void BuildFlatParameters();
+
+  // The entry for `key`, or nullptr if neither supplied nor specified.
+  const FlatParameter* FindFlatParameter(const std::string& key) const;
+
+  std::vector<FlatParameter> flat_parameters_;
 };
 
 #define CONCAT_(x, y) x##y
 #define CONCAT(x, y) CONCAT_(x, y)
-#define REGISTER_SPIEL_GAME(info, factory) \
-  GameRegisterer CONCAT(game, __COUNTER__)(info, factory);
+#define REGISTER_SPIEL_GAME(short_name, type_accessor, factory) \
+  GameRegisterer CONCAT(game, __COUNTER__)(short_name, type_accessor, factory);
 
 class GameRegisterer {
  public:
   using CreateFunc =
       std::function<std::shared_ptr<const Game>(const GameParameters& params)>;
 
-  GameRegisterer(const GameType& game_type, CreateFunc creator);
+  // Returns the game's full GameType, typically a function-local static in
+  // the game's translation unit. Registration stores only the short name and
+  // this accessor, so the GameType (with its parameter-specification maps)
+  // is built on first use rather than at process start. This keeps static
+  // initialization cheap for binaries (and Python imports) that link every
+  // game but load only a few.
+  using TypeFunc = const GameType& (*)();
+
+  GameRegisterer(const std::string& short_name, TypeFunc game_type,
+                 CreateFunc creator);
 
   static std::shared_ptr<const Game> CreateByName(const std::string& short_name,
                                                   const GameParameters& params);
 
   static std::vector<std::string> RegisteredNames();
+  // Materializes every registered game's GameType.
   static std::vector<GameType> RegisteredGames();
   static bool IsValidName(const std::string& short_name);
-  static void RegisterGame(const GameType& game_type, CreateFunc creator);
+  static void RegisterGame(const std::string& short_name, TypeFunc game_type,
+                           CreateFunc creator);
 
  private:
+  struct Registration {
+    TypeFunc game_type;
+    CreateFunc creator;
+  };
+
   // Returns a "global" map of registrations (i.e. an object that lives from
   // initialization to the end of the program). Note that we do not just use
   // a static data member, as we want the map to be initialized before first
   // use.
-  static std::map<std::string, std::pair<GameType, CreateFunc>>& factories() {
-    static std::map<std::string, std::pair<GameType, CreateFunc>> impl;
+  static std::map<std::string, Registration>& factories() {
+    static std::map<std::string, Registration> impl;
     return impl;
   }
 };
@@ -700,17 +1202,22 @@ std::vector<std::string> RegisteredGames();
 // Returns a list of registered game types.
 std::vector<GameType> RegisteredGameTypes();
 
-// Returns a new game object from the specified string, which is the short
-// name plus optional parameters, e.g. "go(komi=4.5,board_size=19)"
+// Returns a game object from the specified string, which is the short
+// name plus optional parameters, e.g. "go(komi=4.5,board_size=19)".
+//
+// Game instances are immutable once constructed, so repeated loads of the
+// same parameterization return one shared instance from a process-wide
+// cache rather than re-running game setup. The exception is games with
+// sampled chance nodes, which may carry internal sampling state and
+// therefore get a fresh instance per load.
 std::shared_ptr<const Game> LoadGame(const std::string& game_string);
 
-// Returns a new game object with the specified parameters.
+// As above, with the game name and its parameters given separately.
 std::shared_ptr<const Game> LoadGame(const std::string& short_name,
                                      const GameParameters& params);
 
-// Returns a new game object with the specified parameters; reads the name
-// of the game from the 'name' parameter (which is not passed to the game
-// implementation).
+// As above; reads the name of the game from the 'name' parameter (which is
+// not passed to the game implementation).
 std::shared_ptr<const Game> LoadGame(GameParameters params);
 
 // Used to sample a policy. Can also sample from chance outcomes.
@@ -742,6 +1249,25 @@ Action SampleChanceOutcome(const ActionsAndProbs& outcomes, double z);
 //   <serialized state; may take up several lines>
 std::string SerializeGameAndState(const Game& game, const State& state);
 
+// Batch encoders for neural-net pipelines. Each state's tensor (from its
+// current player's view) is written at row i * stride of `buffer`, so the
+// rows of a preallocated, possibly padded, tensor can be filled in place.
+// `stride` must be at least the corresponding tensor size.
+void BatchInformationStateAsNormalizedVector(
+    const std::vector<const State*>& states, int stride, double* buffer);
+
+void BatchObservationAsNormalizedVector(const std::vector<const State*>& states,
+                                        int stride, double* buffer);
+
+// Bulk binary serialization: the concatenation of each state's
+// SerializeBinary() string, varint-length-prefixed so that records can be
+// scanned without parsing them. All states must belong to `game`.
+std::string SerializeStatesBinary(const std::vector<const State*>& states);
+
+// Inverse of SerializeStatesBinary.
+std::vector<std::unique_ptr<State>> DeserializeStatesBinary(
+    const Game& game, const std::string& str);
+
 // A general deserialization which reconstructs both the game and the state,
 // which have been saved using the default simple implementation in
 // SerializeGameAndState. The game must be registered so that it is loadable via
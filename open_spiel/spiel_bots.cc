@@ -16,7 +16,6 @@
 
 #include <algorithm>
 
-#include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
@@ -33,13 +32,17 @@ class UniformRandomBot : public Bot {
     const int num_legal_actions = legal_actions.size();
     const double p = 1.0 / num_legal_actions;
     for (auto action : legal_actions) policy.emplace_back(action, p);
-    int selection =
-        absl::uniform_int_distribution<int>(0, num_legal_actions - 1)(rng_);
-    return std::make_pair(policy, legal_actions[selection]);
+    return std::make_pair(policy, legal_actions[rng_.NextInt(num_legal_actions)]);
+  }
+
+  // Allocation-free stepping: defer to the state's sampling fast path
+  // rather than materializing the action list.
+  Action StepAction(const State& state) override {
+    return state.SampleLegalAction(rng_.NextDouble());
   }
 
  private:
-  std::mt19937 rng_;
+  SplittableRandom rng_;
 };
 
 }  // namespace
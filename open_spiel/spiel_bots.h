@@ -36,6 +36,21 @@ class Bot {
   // distribution over actions and also its selected action.
   virtual std::pair<ActionsAndProbs, Action> Step(const State& state) = 0;
 
+  // Choose and execute an action without reporting a policy. Rollout and
+  // evaluation loops that discard the policy should prefer this entry point,
+  // which bots can implement without building the policy list; the default
+  // defers to Step.
+  virtual Action StepAction(const State& state) { return Step(state).second; }
+
+  // Asynchronous thinking on the opponent's time. StartPonder may kick off
+  // background work on `state` -- typically the position the bot just moved
+  // to -- and StopPonder halts it again; both must be called from the
+  // thread that calls Step, and a pondering bot must be stopped before it
+  // steps. The default implementations do nothing, keeping the interface
+  // purely synchronous for bots that don't think in the background.
+  virtual void StartPonder(const State& state) {}
+  virtual void StopPonder() {}
+
   // Which player this bot acts as.
   Player PlayerId() const { return player_id_; }
 
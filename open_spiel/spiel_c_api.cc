@@ -0,0 +1,291 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/spiel_c_api.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/batched_environment.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+// The handle types own the C++ objects; the struct tags are the ones
+// forward-declared in spiel_c_api.h.
+struct OpenSpielGame {
+  std::shared_ptr<const open_spiel::Game> game;
+};
+
+struct OpenSpielState {
+  std::unique_ptr<open_spiel::State> state;
+};
+
+struct OpenSpielBot {
+  std::unique_ptr<open_spiel::Bot> bot;
+};
+
+struct OpenSpielBatchedEnvironment {
+  open_spiel::BatchedEnvironment env;
+};
+
+namespace {
+
+// Copies `value` into the caller's buffer (truncating if needed, always
+// NUL-terminating what was written) and reports the full size in bytes
+// including the terminator, per the header's buffer convention.
+int FillString(const std::string& value, char* buffer, int buffer_size) {
+  if (buffer_size > 0) {
+    int copied = std::min<int>(value.size(), buffer_size - 1);
+    std::memcpy(buffer, value.data(), copied);
+    buffer[copied] = '\0';
+  }
+  return static_cast<int>(value.size()) + 1;
+}
+
+}  // namespace
+
+extern "C" {
+
+OpenSpielGame* open_spiel_load_game(const char* game_string) {
+  open_spiel::GameParameters params =
+      open_spiel::GameParametersFromString(game_string);
+  auto it = params.find("name");
+  if (it == params.end() ||
+      !open_spiel::IsGameRegistered(it->second.string_value())) {
+    return nullptr;
+  }
+  return new OpenSpielGame{open_spiel::LoadGame(std::move(params))};
+}
+
+void open_spiel_game_delete(OpenSpielGame* game) { delete game; }
+
+int open_spiel_game_num_players(const OpenSpielGame* game) {
+  return game->game->NumPlayers();
+}
+
+int open_spiel_game_num_distinct_actions(const OpenSpielGame* game) {
+  return game->game->NumDistinctActions();
+}
+
+int open_spiel_game_max_game_length(const OpenSpielGame* game) {
+  return game->game->MaxGameLength();
+}
+
+int open_spiel_game_max_chance_outcomes(const OpenSpielGame* game) {
+  return game->game->MaxChanceOutcomes();
+}
+
+double open_spiel_game_min_utility(const OpenSpielGame* game) {
+  return game->game->MinUtility();
+}
+
+double open_spiel_game_max_utility(const OpenSpielGame* game) {
+  return game->game->MaxUtility();
+}
+
+int open_spiel_game_observation_size(const OpenSpielGame* game) {
+  if (!game->game->GetType().provides_observation_as_normalized_vector) {
+    return 0;
+  }
+  return game->game->ObservationNormalizedVectorSize();
+}
+
+int open_spiel_game_information_state_size(const OpenSpielGame* game) {
+  if (!game->game->GetType()
+           .provides_information_state_as_normalized_vector) {
+    return 0;
+  }
+  return game->game->InformationStateNormalizedVectorSize();
+}
+
+int open_spiel_game_to_string(const OpenSpielGame* game, char* buffer,
+                              int buffer_size) {
+  return FillString(game->game->ToString(), buffer, buffer_size);
+}
+
+OpenSpielState* open_spiel_game_new_initial_state(const OpenSpielGame* game) {
+  return new OpenSpielState{game->game->NewInitialState()};
+}
+
+OpenSpielState* open_spiel_state_clone(const OpenSpielState* state) {
+  return new OpenSpielState{state->state->Clone()};
+}
+
+void open_spiel_state_delete(OpenSpielState* state) { delete state; }
+
+int open_spiel_state_current_player(const OpenSpielState* state) {
+  return state->state->CurrentPlayer();
+}
+
+int open_spiel_state_is_terminal(const OpenSpielState* state) {
+  return state->state->IsTerminal() ? 1 : 0;
+}
+
+int open_spiel_state_is_chance_node(const OpenSpielState* state) {
+  return state->state->IsChanceNode() ? 1 : 0;
+}
+
+int open_spiel_state_is_simultaneous_node(const OpenSpielState* state) {
+  return state->state->IsSimultaneousNode() ? 1 : 0;
+}
+
+void open_spiel_state_apply_action(OpenSpielState* state, int64_t action) {
+  state->state->ApplyAction(action);
+}
+
+void open_spiel_state_apply_actions(OpenSpielState* state,
+                                    const int64_t* actions, int num_actions) {
+  state->state->ApplyActions(
+      std::vector<open_spiel::Action>(actions, actions + num_actions));
+}
+
+int open_spiel_state_legal_actions(const OpenSpielState* state,
+                                   int64_t* actions, int buffer_size) {
+  std::vector<open_spiel::Action> legal = state->state->LegalActions();
+  int copied = std::min<int>(legal.size(), buffer_size);
+  std::copy(legal.begin(), legal.begin() + copied, actions);
+  return static_cast<int>(legal.size());
+}
+
+int open_spiel_state_legal_actions_mask(const OpenSpielState* state,
+                                        int* mask, int buffer_size) {
+  std::vector<int> legal_mask = state->state->LegalActionsMask();
+  int copied = std::min<int>(legal_mask.size(), buffer_size);
+  std::copy(legal_mask.begin(), legal_mask.begin() + copied, mask);
+  return static_cast<int>(legal_mask.size());
+}
+
+int open_spiel_state_chance_outcomes(const OpenSpielState* state,
+                                     int64_t* actions, double* probs,
+                                     int buffer_size) {
+  open_spiel::ActionsAndProbs outcomes = state->state->ChanceOutcomes();
+  int copied = std::min<int>(outcomes.size(), buffer_size);
+  for (int i = 0; i < copied; ++i) {
+    actions[i] = outcomes[i].first;
+    probs[i] = outcomes[i].second;
+  }
+  return static_cast<int>(outcomes.size());
+}
+
+void open_spiel_state_returns(const OpenSpielState* state, double* returns) {
+  std::vector<double> values = state->state->Returns();
+  std::copy(values.begin(), values.end(), returns);
+}
+
+double open_spiel_state_player_return(const OpenSpielState* state,
+                                      int player) {
+  return state->state->PlayerReturn(player);
+}
+
+void open_spiel_state_observation(const OpenSpielState* state, int player,
+                                  double* buffer) {
+  state->state->ObservationAsNormalizedVector(player, buffer);
+}
+
+void open_spiel_state_information_state(const OpenSpielState* state,
+                                        int player, double* buffer) {
+  state->state->InformationStateAsNormalizedVector(player, buffer);
+}
+
+int open_spiel_state_to_string(const OpenSpielState* state, char* buffer,
+                               int buffer_size) {
+  return FillString(state->state->ToString(), buffer, buffer_size);
+}
+
+OpenSpielBot* open_spiel_make_uniform_random_bot(const OpenSpielGame* game,
+                                                 int player, int seed) {
+  return new OpenSpielBot{
+      open_spiel::MakeUniformRandomBot(*game->game, player, seed)};
+}
+
+void open_spiel_bot_delete(OpenSpielBot* bot) { delete bot; }
+
+int64_t open_spiel_bot_step(OpenSpielBot* bot, const OpenSpielState* state) {
+  return bot->bot->StepAction(*state->state);
+}
+
+OpenSpielBatchedEnvironment* open_spiel_batched_environment_new(
+    const OpenSpielGame* game, int batch_size, int seed) {
+  return new OpenSpielBatchedEnvironment{
+      open_spiel::BatchedEnvironment(game->game, batch_size, seed)};
+}
+
+void open_spiel_batched_environment_delete(OpenSpielBatchedEnvironment* env) {
+  delete env;
+}
+
+int open_spiel_batched_environment_batch_size(
+    const OpenSpielBatchedEnvironment* env) {
+  return env->env.BatchSize();
+}
+
+void open_spiel_batched_environment_step_all(OpenSpielBatchedEnvironment* env,
+                                             const int64_t* actions) {
+  env->env.StepAll(actions);
+}
+
+int open_spiel_batched_environment_reset_terminals(
+    OpenSpielBatchedEnvironment* env) {
+  return env->env.ResetTerminals();
+}
+
+void open_spiel_batched_environment_reset_all(
+    OpenSpielBatchedEnvironment* env) {
+  env->env.ResetAll();
+}
+
+int open_spiel_batched_environment_is_terminal(
+    const OpenSpielBatchedEnvironment* env, int i) {
+  return env->env.IsTerminal(i) ? 1 : 0;
+}
+
+void open_spiel_batched_environment_current_players(
+    const OpenSpielBatchedEnvironment* env, int* players) {
+  for (int i = 0; i < env->env.BatchSize(); ++i) {
+    players[i] = env->env.GetState(i).CurrentPlayer();
+  }
+}
+
+void open_spiel_batched_environment_fill_rewards(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride) {
+  env->env.FillRewards(buffer, stride);
+}
+
+void open_spiel_batched_environment_fill_observations(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride) {
+  env->env.FillObservations(buffer, stride);
+}
+
+void open_spiel_batched_environment_fill_information_states(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride) {
+  env->env.FillInformationStates(buffer, stride);
+}
+
+void open_spiel_batched_environment_fill_legal_actions_masks(
+    const OpenSpielBatchedEnvironment* env, int* buffer) {
+  const int num_actions = env->env.GetGame().NumDistinctActions();
+  for (int i = 0; i < env->env.BatchSize(); ++i) {
+    int* row = buffer + static_cast<size_t>(i) * num_actions;
+    std::fill(row, row + num_actions, 0);
+    const open_spiel::State& state = env->env.GetState(i);
+    if (state.IsTerminal()) continue;
+    for (open_spiel::Action action : state.LegalActions()) row[action] = 1;
+  }
+}
+
+}  // extern "C"
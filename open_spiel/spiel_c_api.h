@@ -0,0 +1,176 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_C_API_H_
+#define THIRD_PARTY_OPEN_SPIEL_SPIEL_C_API_H_
+
+// A C ABI surface over the core of the library, for embedding the simulator
+// in runtimes that cannot link C++ directly (Rust, Go, ...). The shapes
+// follow spiel.h: opaque handles own the underlying C++ objects, tensors are
+// written into caller-provided flat buffers, and the batched calls mirror
+// BatchedEnvironment so a driving loop crosses the FFI boundary once per
+// batch rather than once per environment.
+//
+// Conventions:
+//  - Every *_new / *_load / *_clone call returns a handle the caller must
+//    release with the matching *_delete; handles are never shared.
+//  - A game handle must outlive the states, bots and environments created
+//    from it.
+//  - Functions that fill a caller buffer take its capacity and return the
+//    number of entries (or bytes, for strings) required; if that exceeds the
+//    capacity, nothing past the capacity was written. String fills always
+//    NUL-terminate what they write.
+//  - Boolean results are 0 or 1. Errors that the C++ API reports by
+//    SpielFatalError terminate the process there too; the only recoverable
+//    error is open_spiel_load_game returning NULL for an unknown game name.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OpenSpielGame OpenSpielGame;
+typedef struct OpenSpielState OpenSpielState;
+typedef struct OpenSpielBot OpenSpielBot;
+typedef struct OpenSpielBatchedEnvironment OpenSpielBatchedEnvironment;
+
+// The chance player id, as in spiel.h (kChancePlayerId).
+#define OPEN_SPIEL_CHANCE_PLAYER_ID (-1)
+
+// ---------------------------------------------------------------------------
+// Game.
+
+// Loads a game from its string description, e.g. "kuhn_poker(players=3)".
+// Returns NULL if no game with that short name is registered.
+OpenSpielGame* open_spiel_load_game(const char* game_string);
+void open_spiel_game_delete(OpenSpielGame* game);
+
+int open_spiel_game_num_players(const OpenSpielGame* game);
+int open_spiel_game_num_distinct_actions(const OpenSpielGame* game);
+int open_spiel_game_max_game_length(const OpenSpielGame* game);
+int open_spiel_game_max_chance_outcomes(const OpenSpielGame* game);
+double open_spiel_game_min_utility(const OpenSpielGame* game);
+double open_spiel_game_max_utility(const OpenSpielGame* game);
+
+// Flat sizes of the observation and information-state tensors; 0 when the
+// game does not provide the tensor.
+int open_spiel_game_observation_size(const OpenSpielGame* game);
+int open_spiel_game_information_state_size(const OpenSpielGame* game);
+
+// The canonical game string (short name plus parameters).
+int open_spiel_game_to_string(const OpenSpielGame* game, char* buffer,
+                              int buffer_size);
+
+// ---------------------------------------------------------------------------
+// State.
+
+OpenSpielState* open_spiel_game_new_initial_state(const OpenSpielGame* game);
+OpenSpielState* open_spiel_state_clone(const OpenSpielState* state);
+void open_spiel_state_delete(OpenSpielState* state);
+
+int open_spiel_state_current_player(const OpenSpielState* state);
+int open_spiel_state_is_terminal(const OpenSpielState* state);
+int open_spiel_state_is_chance_node(const OpenSpielState* state);
+int open_spiel_state_is_simultaneous_node(const OpenSpielState* state);
+
+void open_spiel_state_apply_action(OpenSpielState* state, int64_t action);
+// For simultaneous nodes: one action per player.
+void open_spiel_state_apply_actions(OpenSpielState* state,
+                                    const int64_t* actions, int num_actions);
+
+// Fills `actions` with the legal actions of the current player; returns the
+// number of legal actions.
+int open_spiel_state_legal_actions(const OpenSpielState* state,
+                                   int64_t* actions, int buffer_size);
+// Writes the 0/1 legal-action mask; `buffer_size` should be at least
+// open_spiel_game_num_distinct_actions. Returns the mask length.
+int open_spiel_state_legal_actions_mask(const OpenSpielState* state,
+                                        int* mask, int buffer_size);
+// At chance nodes: parallel outcome/probability arrays; returns the number
+// of outcomes.
+int open_spiel_state_chance_outcomes(const OpenSpielState* state,
+                                     int64_t* actions, double* probs,
+                                     int buffer_size);
+
+// Writes one return per player; `returns` must hold
+// open_spiel_game_num_players entries.
+void open_spiel_state_returns(const OpenSpielState* state, double* returns);
+double open_spiel_state_player_return(const OpenSpielState* state, int player);
+
+// Fills the flat observation (or information-state) tensor from `player`'s
+// view; the buffer must hold open_spiel_game_observation_size (resp.
+// open_spiel_game_information_state_size) entries.
+void open_spiel_state_observation(const OpenSpielState* state, int player,
+                                  double* buffer);
+void open_spiel_state_information_state(const OpenSpielState* state,
+                                        int player, double* buffer);
+
+int open_spiel_state_to_string(const OpenSpielState* state, char* buffer,
+                               int buffer_size);
+
+// ---------------------------------------------------------------------------
+// Bots.
+
+// The uniform random bot from spiel_bots.h.
+OpenSpielBot* open_spiel_make_uniform_random_bot(const OpenSpielGame* game,
+                                                 int player, int seed);
+void open_spiel_bot_delete(OpenSpielBot* bot);
+// Chooses the bot's action in `state` (which must have the bot's player to
+// move).
+int64_t open_spiel_bot_step(OpenSpielBot* bot, const OpenSpielState* state);
+
+// ---------------------------------------------------------------------------
+// Batched environment (see batched_environment.h). Episode i of the batch
+// owns row i of every filled buffer; chance nodes are resolved internally,
+// so exposed states are decision nodes or terminal.
+
+OpenSpielBatchedEnvironment* open_spiel_batched_environment_new(
+    const OpenSpielGame* game, int batch_size, int seed);
+void open_spiel_batched_environment_delete(OpenSpielBatchedEnvironment* env);
+
+int open_spiel_batched_environment_batch_size(
+    const OpenSpielBatchedEnvironment* env);
+// Applies actions[i] to episode i; entries for terminal episodes are
+// ignored. `actions` must hold batch_size entries.
+void open_spiel_batched_environment_step_all(OpenSpielBatchedEnvironment* env,
+                                             const int64_t* actions);
+// Replaces terminal episodes with fresh initial states; returns how many
+// were reset.
+int open_spiel_batched_environment_reset_terminals(
+    OpenSpielBatchedEnvironment* env);
+void open_spiel_batched_environment_reset_all(
+    OpenSpielBatchedEnvironment* env);
+
+// Per-episode queries/fills; buffers are indexed by episode, with the given
+// row stride where applicable.
+int open_spiel_batched_environment_is_terminal(
+    const OpenSpielBatchedEnvironment* env, int i);
+void open_spiel_batched_environment_current_players(
+    const OpenSpielBatchedEnvironment* env, int* players);
+void open_spiel_batched_environment_fill_rewards(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride);
+void open_spiel_batched_environment_fill_observations(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride);
+void open_spiel_batched_environment_fill_information_states(
+    const OpenSpielBatchedEnvironment* env, double* buffer, int stride);
+// Writes episode i's legal-action mask into row i * num_distinct_actions.
+void open_spiel_batched_environment_fill_legal_actions_masks(
+    const OpenSpielBatchedEnvironment* env, int* buffer);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_SPIEL_C_API_H_
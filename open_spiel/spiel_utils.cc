@@ -14,6 +14,12 @@
 
 #include "open_spiel/spiel_utils.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <atomic>
 #include <iostream>
 #include <string>
 
@@ -67,6 +73,27 @@ void UnrankActionMixedBase(Action action, const std::vector<int>& bases,
   SPIEL_CHECK_EQ(action, 0);
 }
 
+void AppendVarint(uint64_t value, std::string* str) {
+  while (value >= 0x80) {
+    str->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  str->push_back(static_cast<char>(value));
+}
+
+uint64_t DecodeVarint(const std::string& str, size_t* offset) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*offset >= str.size()) {
+      SpielFatalError("DecodeVarint: truncated input.");
+    }
+    uint8_t byte = static_cast<uint8_t>(str[(*offset)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+  SpielFatalError("DecodeVarint: malformed input.");
+}
+
 void SpielDefaultErrorHandler(const std::string& error_msg) {
   std::cerr << "Spiel Fatal Error: " << error_msg << std::endl << std::endl;
   std::exit(1);
@@ -74,8 +101,10 @@ void SpielDefaultErrorHandler(const std::string& error_msg) {
 
 ErrorHandler error_handler = SpielDefaultErrorHandler;
 
-void SetErrorHandler(ErrorHandler new_error_handler) {
+ErrorHandler SetErrorHandler(ErrorHandler new_error_handler) {
+  ErrorHandler previous = error_handler;
   error_handler = new_error_handler;
+  return previous;
 }
 
 void SpielFatalError(const std::string& error_msg) {
@@ -85,4 +114,264 @@ void SpielFatalError(const std::string& error_msg) {
   std::exit(1);
 }
 
+namespace stats {
+
+const char* CounterName(Counter counter) {
+  static const char* const kNames[kNumCounters] = {
+      "state_clones",          "legal_actions_computes", "info_state_builds",
+      "regret_matching_calls", "mcts_expansions",        "cache_hits",
+      "cache_misses"};
+  return kNames[counter];
+}
+
+#ifdef OPEN_SPIEL_ENABLE_STATS
+
+namespace {
+std::atomic<int64_t> counters[kNumCounters];
+}  // namespace
+
+void IncrementCounter(Counter counter) {
+  counters[counter].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<int64_t> SnapshotCounters() {
+  std::vector<int64_t> values(kNumCounters);
+  for (int i = 0; i < kNumCounters; ++i) {
+    values[i] = counters[i].load(std::memory_order_relaxed);
+  }
+  return values;
+}
+
+void ResetCounters() {
+  for (int i = 0; i < kNumCounters; ++i) {
+    counters[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+#endif  // OPEN_SPIEL_ENABLE_STATS
+
+const char* GaugeName(Gauge gauge) {
+  static const char* const kNames[kNumGauges] = {
+      "cfr_table_bytes", "mcts_tree_bytes", "policy_table_bytes",
+      "nash_conv_estimate_micros"};
+  return kNames[gauge];
+}
+
+namespace {
+std::atomic<int64_t> gauges[kNumGauges];
+}  // namespace
+
+void SetGauge(Gauge gauge, int64_t value) {
+  gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+std::vector<int64_t> SnapshotGauges() {
+  std::vector<int64_t> values(kNumGauges);
+  for (int i = 0; i < kNumGauges; ++i) {
+    values[i] = gauges[i].load(std::memory_order_relaxed);
+  }
+  return values;
+}
+
+}  // namespace stats
+
+int64_t StringInternPool::Intern(absl::string_view str) {
+  auto it = index_.find(str);
+  if (it != index_.end()) return it->second;
+  const int64_t id = static_cast<int64_t>(strings_.size());
+  strings_.emplace_back(str);
+  index_.emplace(strings_.back(), id);
+  return id;
+}
+
+int64_t StringInternPool::Find(absl::string_view str) const {
+  auto it = index_.find(str);
+  return it == index_.end() ? -1 : it->second;
+}
+
+namespace {
+
+// Which worker of which pool the current thread is; set once per worker
+// thread, used for deque locality and accumulator slots.
+thread_local const TaskPool* tls_task_pool = nullptr;
+thread_local int tls_worker_index = -1;
+
+}  // namespace
+
+struct TaskPool::Worker {
+  std::mutex mutex;
+  std::deque<std::function<void()>> tasks;
+};
+
+TaskPool::TaskPool(int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = std::max(1, static_cast<int>(
+        std::thread::hardware_concurrency()));
+  }
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&TaskPool::WorkerLoop, this, i);
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    shutdown_ = true;
+  }
+  work_cv_.notify_all();
+  for (std::thread& thread : threads_) thread.join();
+}
+
+TaskPool* TaskPool::Global() {
+  // Intentionally leaked: tearing the workers down during static
+  // destruction can deadlock with other exiting state, and the idle
+  // threads cost nothing once main returns.
+  static TaskPool* pool = new TaskPool();
+  return pool;
+}
+
+void TaskPool::PinWorkers() {
+#ifdef __linux__
+  const int num_cpus =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int i = 0; i < NumWorkers(); ++i) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(i % num_cpus, &cpuset);
+    pthread_setaffinity_np(threads_[i].native_handle(), sizeof(cpuset),
+                           &cpuset);
+  }
+#endif
+}
+
+int TaskPool::CurrentSlot() const {
+  return (tls_task_pool == this && tls_worker_index >= 0) ? tls_worker_index
+                                                          : NumWorkers();
+}
+
+void TaskPool::SetDeterministic(bool deterministic) {
+  deterministic_.store(deterministic, std::memory_order_relaxed);
+}
+
+void TaskPool::Push(std::function<void()> task) {
+  const bool deterministic = IsDeterministic();
+  int index;
+  if (!deterministic && tls_task_pool == this && tls_worker_index >= 0) {
+    index = tls_worker_index;
+  } else {
+    // Round-robin by spawn order; in deterministic mode this is the fixed
+    // partitioning, so worker-local enqueueing is bypassed.
+    index = static_cast<int>(next_worker_.fetch_add(1) %
+                             static_cast<int64_t>(workers_.size()));
+  }
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    ++queued_count_;
+  }
+  // Without stealing, only the owner can run the task, so every sleeping
+  // worker must get a chance to check its own deque.
+  if (deterministic) {
+    work_cv_.notify_all();
+  } else {
+    work_cv_.notify_one();
+  }
+}
+
+std::function<void()> TaskPool::PopTask(int start_index) {
+  const bool deterministic = IsDeterministic();
+  const int num_workers = NumWorkers();
+  // In deterministic mode a worker only ever touches its own deque, in
+  // spawn order; otherwise idle workers steal from the others.
+  const int max_offset = deterministic ? 1 : num_workers;
+  for (int offset = 0; offset < max_offset; ++offset) {
+    Worker& worker = *workers_[(start_index + offset) % num_workers];
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (worker.tasks.empty()) continue;
+      if (offset == 0 && !deterministic) {
+        // Own deque: newest first, for cache locality.
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+      } else {
+        // Steal the oldest (likely largest) task; in deterministic mode,
+        // run the own deque oldest-first so it follows spawn order.
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      --queued_count_;
+    }
+    return task;
+  }
+  return nullptr;
+}
+
+bool TaskPool::RunOneTask() {
+  const bool on_worker = tls_task_pool == this && tls_worker_index >= 0;
+  // Threads outside the pool must not take work in deterministic mode:
+  // that would move tasks off their fixed workers. Their Sync spins
+  // instead, yielding until the workers are done.
+  if (IsDeterministic() && !on_worker) return false;
+  const int start_index =
+      on_worker ? tls_worker_index
+                : static_cast<int>(next_worker_.fetch_add(1) %
+                                   static_cast<int64_t>(workers_.size()));
+  std::function<void()> task = PopTask(start_index);
+  if (task == nullptr) return false;
+  task();
+  return true;
+}
+
+void TaskPool::WorkerLoop(int worker_index) {
+  tls_task_pool = this;
+  tls_worker_index = worker_index;
+  while (true) {
+    std::function<void()> task = PopTask(worker_index);
+    if (task != nullptr) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    if (shutdown_) return;
+    work_cv_.wait(lock, [this, worker_index] {
+      if (shutdown_ || queued_count_ == 0) return shutdown_;
+      if (!IsDeterministic()) return true;
+      // No stealing: only wake for work in this worker's own deque.
+      // (Push locks the deque and idle mutexes in sequence, never
+      // nested, so taking the deque mutex here cannot deadlock.)
+      std::lock_guard<std::mutex> guard(workers_[worker_index]->mutex);
+      return !workers_[worker_index]->tasks.empty();
+    });
+    if (shutdown_) return;
+  }
+}
+
+void TaskGroup::Spawn(std::function<void()> task) {
+  pending_.fetch_add(1);
+  pool_->Push([this, task = std::move(task)]() {
+    task();
+    // Last action touching the group: Sync may return (and the group be
+    // destroyed) as soon as this reaches zero.
+    pending_.fetch_sub(1);
+  });
+}
+
+void TaskGroup::Sync() {
+  while (pending_.load() > 0) {
+    if (!pool_->RunOneTask()) std::this_thread::yield();
+  }
+}
+
 }  // namespace open_spiel
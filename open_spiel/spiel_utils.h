@@ -16,12 +16,22 @@
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_UTILS_H_
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <initializer_list>
 #include <limits>
 #include <locale>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -88,6 +98,84 @@ using Action = int64_t;
 // numbers as the threshold.
 inline constexpr float FloatingPointDefaultThresholdRatio() { return 1e-5; }
 
+// A vector with inline storage for up to N elements, spilling to the heap
+// only beyond that. Action lists in most games hold a handful of entries,
+// so keeping them inline removes a heap allocation (and a pointer chase)
+// per list; the tiny-vector allocations otherwise show up in every
+// profile of the tree-walking algorithms. Only the operations the action
+// list call sites need are provided, and std::vector converts in and out,
+// so call sites can adopt it incrementally.
+template <typename T, int N>
+class SmallVector {
+ public:
+  SmallVector() {}
+  SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+  SmallVector(SmallVector&&) = default;
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) assign(other.begin(), other.end());
+    return *this;
+  }
+  SmallVector& operator=(SmallVector&&) = default;
+  SmallVector(std::initializer_list<T> values) {
+    assign(values.begin(), values.end());
+  }
+  // Implicit by design, so std::vector-returning APIs feed it directly.
+  SmallVector(const std::vector<T>& values) {
+    assign(values.begin(), values.end());
+  }
+
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const T* data() const { return size_ <= N ? inline_ : heap_.data(); }
+  T* data() { return size_ <= N ? inline_ : heap_.data(); }
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + size_; }
+  T* begin() { return data(); }
+  T* end() { return data() + size_; }
+  const T& operator[](int i) const { return data()[i]; }
+  T& operator[](int i) { return data()[i]; }
+  const T& back() const { return data()[size_ - 1]; }
+
+  void clear() {
+    heap_.clear();
+    size_ = 0;
+  }
+
+  void push_back(const T& value) {
+    if (size_ < N) {
+      inline_[size_] = value;
+    } else {
+      // Spilling moves the inline elements to the heap once; they are
+      // copied back only by a clear-and-refill.
+      if (size_ == N) heap_.assign(inline_, inline_ + N);
+      heap_.push_back(value);
+    }
+    ++size_;
+  }
+
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    clear();
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+  // Bytes held on the heap once the inline capacity has been exceeded;
+  // zero while the elements fit inline. For memory accounting.
+  int64_t HeapBytes() const { return heap_.capacity() * sizeof(T); }
+
+  bool operator==(const SmallVector& other) const {
+    return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+  }
+  bool operator!=(const SmallVector& other) const { return !(*this == other); }
+
+ private:
+  T inline_[N];
+  std::vector<T> heap_;  // Used only once size() exceeds N.
+  int size_ = 0;
+};
+
 // Helpers used to convert actions represented as integers in mixed bases.
 // E.g. RankActionMixedBase({2, 3, 6}, {1, 1, 1}) = 1*18 + 1*6 + 1 = 25,
 // and UnrankActioMixedBase(25, {2, 3, 6}, &digits) sets digits to {1, 1, 1}.
@@ -99,6 +187,926 @@ Action RankActionMixedBase(const std::vector<int>& bases,
 void UnrankActionMixedBase(Action action, const std::vector<int>& bases,
                            std::vector<int>* digits);
 
+// Base-128 varint coding of unsigned integers, used by the binary state
+// serialization: little-endian groups of 7 bits, with the high bit set on
+// every byte except the last. Small values (the common case for actions)
+// take a single byte.
+void AppendVarint(uint64_t value, std::string* str);
+
+// Decodes the varint starting at `*offset` in `str`, advancing `*offset`
+// past it. Calls SpielFatalError on truncated input.
+uint64_t DecodeVarint(const std::string& str, size_t* offset);
+
+// A small, fast random generator (xoshiro256++) with cheap stream splitting,
+// for sampling-heavy inner loops where std::mt19937's state size and
+// per-draw cost are measurable. Satisfies UniformRandomBitGenerator, so it
+// also works with std:: distributions and std::shuffle.
+class SplittableRandom {
+ public:
+  using result_type = uint64_t;
+
+  explicit SplittableRandom(uint64_t seed) {
+    // Expand the seed into well-mixed state words with SplitMix64.
+    for (uint64_t& word : state_) {
+      seed += 0x9e3779b97f4a7c15ULL;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  // Derives an independent stream, e.g. one per parallel worker. The child
+  // is re-seeded through the SplitMix64 mixer from a draw of this
+  // generator, so parent and children produce unrelated sequences.
+  SplittableRandom Split() { return SplittableRandom(NextUInt64()); }
+
+  uint64_t NextUInt64() {
+    const uint64_t result = RotateLeft(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  // Uniform double in [0, 1), from the top 53 bits.
+  double NextDouble() { return (NextUInt64() >> 11) * 0x1.0p-53; }
+
+  // Uniform int in [0, n), by one draw and a fixed-point multiply — no
+  // modulo and no rejection loop. The bias this leaves is below n / 2^64.
+  int NextInt(int n) {
+    return static_cast<int>(
+        (static_cast<unsigned __int128>(NextUInt64()) * n) >> 64);
+  }
+
+  // UniformRandomBitGenerator interface.
+  uint64_t operator()() { return NextUInt64(); }
+  static constexpr uint64_t min() { return 0; }
+  static constexpr uint64_t max() { return ~uint64_t{0}; }
+
+ private:
+  static uint64_t RotateLeft(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t state_[4];
+};
+
+// Lightweight hot-path counters, compiled out by default. Build with
+// -DOPEN_SPIEL_ENABLE_STATS to enable them; instrumented code then pays one
+// relaxed atomic increment per event and nothing otherwise. Counters are
+// process-wide: call Reset() before and Snapshot() after the region of
+// interest (e.g. one CFR iteration) to attribute where time goes without
+// attaching a profiler.
+namespace stats {
+
+enum Counter {
+  kStateClones = 0,       // State copy constructions (Clone and Child).
+  kLegalActionsComputes,  // LegalActions computations via the state cache.
+  kInfoStateBuilds,       // Information state strings built by the solvers.
+  kRegretMatchingCalls,   // CFRInfoStateValues::ApplyRegretMatching calls.
+  kMctsExpansions,        // MCTS nodes expanded.
+  kCacheHits,             // BoundedCache lookups that hit.
+  kCacheMisses,           // BoundedCache lookups that missed.
+  kNumCounters,
+};
+
+// Name for a counter, e.g. for report printing. Indexable by the enum.
+const char* CounterName(Counter counter);
+
+#ifdef OPEN_SPIEL_ENABLE_STATS
+
+void IncrementCounter(Counter counter);
+
+// Current values of all counters, indexed by Counter.
+std::vector<int64_t> SnapshotCounters();
+
+// Zeroes all counters.
+void ResetCounters();
+
+#define SPIEL_STATS_INCREMENT(counter) \
+  ::open_spiel::stats::IncrementCounter(::open_spiel::stats::counter)
+
+#else  // OPEN_SPIEL_ENABLE_STATS
+
+inline std::vector<int64_t> SnapshotCounters() {
+  return std::vector<int64_t>(kNumCounters, 0);
+}
+inline void ResetCounters() {}
+
+#define SPIEL_STATS_INCREMENT(counter)
+
+#endif  // OPEN_SPIEL_ENABLE_STATS
+
+// Gauges, for capacity planning, the memory-bounded modes and training
+// dashboards. Unlike the event counters above these sit on no hot path:
+// producers (the byte-accounting methods, the exploitability estimator)
+// publish into them when called, so they are always compiled in. Values
+// are bytes unless a gauge says otherwise; a gauge nothing has published
+// to reads zero.
+enum Gauge {
+  kCfrTableBytes = 0,  // CFRSolverBase::TableMemoryBytes.
+  kMctsTreeBytes,      // MCTSBot::TreeMemoryBytes.
+  kPolicyTableBytes,   // TabularPolicy::EstimatedMemory.
+  // ExploitabilityEstimator's latest NashConv estimate, in millionths.
+  kNashConvEstimateMicros,
+  kNumGauges,
+};
+
+// Name for a gauge, e.g. for report printing. Indexable by the enum.
+const char* GaugeName(Gauge gauge);
+
+// Publishes the latest measurement of a gauge.
+void SetGauge(Gauge gauge, int64_t value);
+
+// Current values of all gauges, indexed by Gauge.
+std::vector<int64_t> SnapshotGauges();
+
+}  // namespace stats
+
+// A fixed-capacity key/value cache for the advisory caches the algorithms
+// keep (evaluation caches, observation caches, transposition tiers):
+// dropping an entry only costs a recomputation, never correctness, so the
+// memory footprint can be capped up front. Storage is a flat power-of-two
+// slot array probed linearly over a short window, and eviction is CLOCK
+// (second-chance): every hit sets the slot's reference bit, and an insert
+// into a full window claims the first slot whose bit is already clear,
+// clearing bits as it scans. That approximates LRU with one byte per slot
+// instead of list links, and keeps each operation inside one cache-resident
+// window of slots.
+//
+// With num_stripes >= 1 the slots are divided into that many independently
+// locked stripes (each key maps to a fixed stripe), so concurrent workers
+// contend only when they touch the same stripe. With the default of 0 there
+// is no locking; use that from a single thread or under external
+// synchronization. Hits and misses feed the stats counters above in
+// instrumented builds and are tallied locally either way, so callers can
+// size the capacity from an observed hit rate.
+template <typename K, typename V, typename HashT = std::hash<K>>
+class BoundedCache {
+ public:
+  // A cache holding about `capacity` entries (rounded so that each stripe
+  // is a power of two of at least one probe window).
+  explicit BoundedCache(int64_t capacity, int num_stripes = 0)
+      : locked_(num_stripes >= 1) {
+    const int stripes = std::max(num_stripes, 1);
+    int64_t per_stripe = 1;
+    while (per_stripe < (capacity + stripes - 1) / stripes) per_stripe *= 2;
+    per_stripe = std::max<int64_t>(per_stripe, kProbeRun);
+    for (int i = 0; i < stripes; ++i) {
+      stripes_.push_back(std::make_unique<Stripe>());
+      stripes_.back()->slots.resize(per_stripe);
+      stripes_.back()->mask = static_cast<uint64_t>(per_stripe) - 1;
+    }
+  }
+
+  BoundedCache(const BoundedCache&) = delete;
+  BoundedCache& operator=(const BoundedCache&) = delete;
+
+  // Fills *value and returns true if the key is present, marking the entry
+  // recently used.
+  bool Lookup(const K& key, V* value) {
+    const uint64_t hash = MixedHash(key);
+    Stripe& stripe = StripeFor(hash);
+    StripeLock lock(locked_ ? &stripe.mutex : nullptr);
+    const uint64_t home = hash & stripe.mask;
+    for (int i = 0; i < kProbeRun; ++i) {
+      Slot& slot = stripe.slots[(home + i) & stripe.mask];
+      if (slot.full && slot.hash == hash && slot.key == key) {
+        slot.referenced = true;
+        *value = slot.value;
+        SPIEL_STATS_INCREMENT(kCacheHits);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    SPIEL_STATS_INCREMENT(kCacheMisses);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Inserts (or refreshes) an entry, evicting within the key's probe window
+  // if every slot there is taken.
+  void Insert(const K& key, const V& value) {
+    const uint64_t hash = MixedHash(key);
+    Stripe& stripe = StripeFor(hash);
+    StripeLock lock(locked_ ? &stripe.mutex : nullptr);
+    const uint64_t home = hash & stripe.mask;
+    for (int i = 0; i < kProbeRun; ++i) {
+      Slot& slot = stripe.slots[(home + i) & stripe.mask];
+      if (!slot.full || (slot.hash == hash && slot.key == key)) {
+        if (slot.full) {
+          slot.value = value;
+        } else {
+          Fill(&slot, hash, key, value);
+        }
+        slot.referenced = true;
+        return;
+      }
+    }
+    // Window full: two CLOCK sweeps. The first takes any slot whose bit is
+    // already clear and clears the bits it passes; after it, the second
+    // always finds a victim.
+    for (int i = 0; i < 2 * kProbeRun; ++i) {
+      Slot& slot = stripe.slots[(home + i) & stripe.mask];
+      if (!slot.referenced) {
+        Fill(&slot, hash, key, value);
+        slot.referenced = true;
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      slot.referenced = false;
+    }
+  }
+
+  int64_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+  int64_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+  int64_t Evictions() const {
+    return evictions_.load(std::memory_order_relaxed);
+  }
+  int64_t Capacity() const {
+    return static_cast<int64_t>(stripes_.size() *
+                                (stripes_[0]->mask + 1));
+  }
+
+ private:
+  static constexpr int kProbeRun = 8;  // Probe window, as in the disk TT.
+
+  struct Slot {
+    uint64_t hash = 0;
+    K key{};
+    V value{};
+    bool full = false;
+    bool referenced = false;
+  };
+
+  struct Stripe {
+    std::mutex mutex;
+    std::vector<Slot> slots;
+    uint64_t mask = 0;
+  };
+
+  // Locks the stripe only in striped mode; one branch instead of a mutex
+  // acquisition on the single-threaded path.
+  class StripeLock {
+   public:
+    explicit StripeLock(std::mutex* mutex) : mutex_(mutex) {
+      if (mutex_ != nullptr) mutex_->lock();
+    }
+    ~StripeLock() {
+      if (mutex_ != nullptr) mutex_->unlock();
+    }
+
+   private:
+    std::mutex* mutex_;
+  };
+
+  // User hashes (e.g. std::hash of an integer) may be near-identity;
+  // finishing with the SplitMix64 mixer spreads them over the slots and
+  // the stripe selector bits.
+  static uint64_t MixedHash(const K& key) {
+    uint64_t z = static_cast<uint64_t>(HashT()(key));
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // Stripe from the top bits, slot from the low bits, so the two choices
+  // stay independent.
+  Stripe& StripeFor(uint64_t hash) {
+    return *stripes_[(hash >> 48) % stripes_.size()];
+  }
+
+  static void Fill(Slot* slot, uint64_t hash, const K& key, const V& value) {
+    slot->hash = hash;
+    slot->key = key;
+    slot->value = value;
+    slot->full = true;
+  }
+
+  const bool locked_;
+  std::vector<std::unique_ptr<Stripe>> stripes_;
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+  std::atomic<int64_t> evictions_{0};
+};
+
+// Interns strings into dense int64 ids, with stable absl::string_view access
+// to the originals. Each distinct string is stored exactly once; ids are
+// assigned sequentially from 0. Lookups hash the characters in place, so
+// callers holding a string_view (or another object's string) pay no
+// allocation or copy per query, and id-keyed tables replace repeated
+// hashing of long keys with hashing an integer. Views returned by View()
+// and ids remain valid for the lifetime of the pool.
+class StringInternPool {
+ public:
+  StringInternPool() = default;
+
+  // The index holds views into the storage, so copies must not share it.
+  StringInternPool(const StringInternPool&) = delete;
+  StringInternPool& operator=(const StringInternPool&) = delete;
+  StringInternPool(StringInternPool&&) = default;
+  StringInternPool& operator=(StringInternPool&&) = default;
+
+  // Returns the id for the string, interning it if not yet present.
+  int64_t Intern(absl::string_view str);
+
+  // Returns the id for the string, or -1 if it was never interned.
+  int64_t Find(absl::string_view str) const;
+
+  // The interned string with the given id (which must be valid).
+  absl::string_view View(int64_t id) const { return strings_[id]; }
+
+  // As View, but the stored std::string itself, for callers that need a
+  // reference-stable string (e.g. as a map key) rather than a view.
+  const std::string& Str(int64_t id) const { return strings_[id]; }
+
+  int64_t size() const { return static_cast<int64_t>(strings_.size()); }
+
+ private:
+  struct Hash {
+    // FNV-1a; same register as the other self-contained utilities here.
+    size_t operator()(absl::string_view str) const {
+      uint64_t hash = 14695981039346656037ULL;
+      for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+      }
+      return static_cast<size_t>(hash);
+    }
+  };
+
+  // A deque so growth never moves the stored strings out from under the
+  // views held in the index (or by callers).
+  std::deque<std::string> strings_;
+  std::unordered_map<absl::string_view, int64_t, Hash> index_;
+};
+
+// Bounded lock-free single-producer single-consumer ring, for pipeline
+// stages with exactly one thread on each end (recorder to disk writer,
+// actor to encoder). TryPush and TryPop cost one slot write and one
+// release publication; each side keeps a cached copy of the other side's
+// position and refreshes it only when the ring looks full (or empty), so
+// an uncontended transfer touches no shared cache line beyond the slot
+// and one counter. The batch calls move several items per publication,
+// amortizing the synchronization when rates are high. The blocking calls
+// spin briefly and then wait on a condition variable, so an idle
+// consumer costs nothing; Close() wakes everyone, after which Push fails
+// and Pop drains the remaining items before failing. The capacity is
+// rounded up to a power of two.
+template <typename T>
+class SpscQueue {
+ public:
+  explicit SpscQueue(int capacity) {
+    int rounded = 1;
+    while (rounded < capacity) rounded *= 2;
+    buffer_.resize(rounded);
+    mask_ = rounded - 1;
+  }
+
+  int Capacity() const { return static_cast<int>(buffer_.size()); }
+
+  // Producer side. TryPush moves from `item` only on success; it fails
+  // without queueing once the queue is closed.
+  bool TryPush(T&& item) {
+    if (closed_.load(std::memory_order_relaxed)) return false;
+    if (!TryPushNoWake(std::move(item))) return false;
+    Wake(&pop_waiters_, &can_pop_);
+    return true;
+  }
+
+  // Moves as many items as fit from the front of `*items`, erasing them;
+  // returns how many went in. One publication for the whole batch.
+  int TryPushBatch(std::vector<T>* items) {
+    if (closed_.load(std::memory_order_relaxed)) return 0;
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    cached_head_ = head_.load(std::memory_order_acquire);
+    const int n = std::min<int64_t>(
+        items->size(), buffer_.size() - (tail - cached_head_));
+    for (int i = 0; i < n; ++i) {
+      buffer_[(tail + i) & mask_] = std::move((*items)[i]);
+    }
+    if (n == 0) return 0;
+    tail_.store(tail + n, std::memory_order_release);
+    items->erase(items->begin(), items->begin() + n);
+    Wake(&pop_waiters_, &can_pop_);
+    return n;
+  }
+
+  // Blocks until the item is queued; returns false (keeping the item
+  // unqueued) once the queue is closed.
+  bool Push(T item) {
+    for (int spin = 0; spin < kSpinsBeforeWait; ++spin) {
+      if (closed_.load(std::memory_order_relaxed)) return false;
+      if (TryPush(std::move(item))) return true;
+    }
+    return WaitToPush(&item);
+  }
+
+  // Consumer side. Returns whether an item was popped.
+  bool TryPop(T* out) {
+    if (!TryPopNoWake(out)) return false;
+    Wake(&push_waiters_, &can_push_);
+    return true;
+  }
+
+  // Appends up to `max_items` items to `*out`; returns how many. One
+  // publication for the whole batch.
+  int TryPopBatch(std::vector<T>* out, int max_items) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    const int n =
+        std::min<int64_t>(max_items, cached_tail_ - head);
+    for (int i = 0; i < n; ++i) {
+      out->push_back(std::move(buffer_[(head + i) & mask_]));
+    }
+    if (n == 0) return 0;
+    head_.store(head + n, std::memory_order_release);
+    Wake(&push_waiters_, &can_push_);
+    return n;
+  }
+
+  // Blocks until an item arrives; returns false once the queue is closed
+  // and drained.
+  bool Pop(T* out) {
+    for (int spin = 0; spin < kSpinsBeforeWait; ++spin) {
+      if (TryPop(out)) return true;
+      if (closed_.load(std::memory_order_relaxed)) return TryPop(out);
+    }
+    return WaitToPop(out);
+  }
+
+  // After this, Push fails, and Pop fails once the queue is drained.
+  void Close() {
+    closed_.store(true, std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    can_pop_.notify_all();
+    can_push_.notify_all();
+  }
+
+  bool closed() const { return closed_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr int kSpinsBeforeWait = 128;
+
+  bool TryPushNoWake(T&& item) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == buffer_.size()) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == buffer_.size()) return false;
+    }
+    buffer_[tail & mask_] = std::move(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPopNoWake(T* out) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) return false;
+    }
+    *out = std::move(buffer_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Waiters register under the mutex before re-checking, and the fence
+  // orders the publication before the waiter-count load, so a publisher
+  // either sees the registration and notifies under the mutex or the
+  // waiter's re-check sees the publication; a wakeup cannot fall between.
+  void Wake(std::atomic<int>* waiters, std::condition_variable* cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      cv->notify_all();
+    }
+  }
+
+  bool WaitToPush(T* item) {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (true) {
+      push_waiters_.fetch_add(1, std::memory_order_seq_cst);
+      if (closed_.load(std::memory_order_relaxed)) {
+        push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+      }
+      if (TryPushNoWake(std::move(*item))) {
+        push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        can_pop_.notify_all();  // The mutex is already held.
+        return true;
+      }
+      can_push_.wait(lock);
+      push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  bool WaitToPop(T* out) {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (true) {
+      pop_waiters_.fetch_add(1, std::memory_order_seq_cst);
+      bool popped = TryPopNoWake(out);
+      if (popped || closed_.load(std::memory_order_relaxed)) {
+        pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        if (!popped) popped = TryPopNoWake(out);  // Drain after Close.
+        if (popped) can_push_.notify_all();  // The mutex is already held.
+        return popped;
+      }
+      can_pop_.wait(lock);
+      pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<T> buffer_;
+  uint64_t mask_ = 0;
+  // Producer and consumer counters on their own cache lines, so each
+  // side's publication does not invalidate the other side's hot line.
+  alignas(64) std::atomic<uint64_t> tail_{0};  // Next slot to write.
+  uint64_t cached_head_ = 0;                   // Producer's view of head_.
+  alignas(64) std::atomic<uint64_t> head_{0};  // Next slot to read.
+  uint64_t cached_tail_ = 0;                   // Consumer's view of tail_.
+
+  alignas(64) std::atomic<bool> closed_{false};
+  std::mutex wait_mutex_;
+  std::condition_variable can_push_;
+  std::condition_variable can_pop_;
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+};
+
+// Bounded lock-free multi-producer multi-consumer queue (the classic
+// sequence-numbered ring), for fan-in and fan-out stages: many recorders
+// feeding one writer, or a service draining requests from many actors.
+// Each slot carries a sequence counter, so producers and consumers claim
+// positions with one compare-and-swap and never wait on each other's
+// copies in progress. T must be default-constructible. Blocking, batch,
+// and Close() semantics are as on SpscQueue; the batch calls claim slots
+// one at a time but notify sleepers once per batch, which is where the
+// per-item cost goes at high rates.
+template <typename T>
+class MpmcQueue {
+ public:
+  explicit MpmcQueue(int capacity) {
+    int rounded = 1;
+    while (rounded < capacity) rounded *= 2;
+    cells_.reset(new Cell[rounded]);
+    for (int i = 0; i < rounded; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = rounded - 1;
+  }
+
+  int Capacity() const { return static_cast<int>(mask_ + 1); }
+
+  // Moves from `item` only on success; fails without queueing once the
+  // queue is closed.
+  bool TryPush(T&& item) {
+    if (closed_.load(std::memory_order_relaxed)) return false;
+    if (!TryPushNoWake(std::move(item))) return false;
+    Wake(&pop_waiters_, &can_pop_);
+    return true;
+  }
+
+  // Moves as many items as fit from the front of `*items`, erasing them;
+  // returns how many went in. Sleepers are notified once.
+  int TryPushBatch(std::vector<T>* items) {
+    if (closed_.load(std::memory_order_relaxed)) return 0;
+    int n = 0;
+    while (n < static_cast<int>(items->size()) &&
+           TryPushNoWake(std::move((*items)[n]))) {
+      ++n;
+    }
+    if (n == 0) return 0;
+    items->erase(items->begin(), items->begin() + n);
+    Wake(&pop_waiters_, &can_pop_);
+    return n;
+  }
+
+  bool TryPop(T* out) {
+    if (!TryPopNoWake(out)) return false;
+    Wake(&push_waiters_, &can_push_);
+    return true;
+  }
+
+  // Appends up to `max_items` items to `*out`; returns how many.
+  // Sleepers are notified once.
+  int TryPopBatch(std::vector<T>* out, int max_items) {
+    int n = 0;
+    T item;
+    while (n < max_items && TryPopNoWake(&item)) {
+      out->push_back(std::move(item));
+      ++n;
+    }
+    if (n > 0) Wake(&push_waiters_, &can_push_);
+    return n;
+  }
+
+  // Blocks until the item is queued; returns false (keeping the item
+  // unqueued) once the queue is closed.
+  bool Push(T item) {
+    for (int spin = 0; spin < kSpinsBeforeWait; ++spin) {
+      if (closed_.load(std::memory_order_relaxed)) return false;
+      if (TryPush(std::move(item))) return true;
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (true) {
+      push_waiters_.fetch_add(1, std::memory_order_seq_cst);
+      if (closed_.load(std::memory_order_relaxed)) {
+        push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+      }
+      if (TryPushNoWake(std::move(item))) {
+        push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        can_pop_.notify_all();  // The mutex is already held.
+        return true;
+      }
+      can_push_.wait(lock);
+      push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Blocks until an item arrives; returns false once the queue is closed
+  // and drained.
+  bool Pop(T* out) {
+    for (int spin = 0; spin < kSpinsBeforeWait; ++spin) {
+      if (TryPop(out)) return true;
+      if (closed_.load(std::memory_order_relaxed)) return TryPop(out);
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (true) {
+      pop_waiters_.fetch_add(1, std::memory_order_seq_cst);
+      bool popped = TryPopNoWake(out);
+      if (popped || closed_.load(std::memory_order_relaxed)) {
+        pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        if (!popped) popped = TryPopNoWake(out);  // Drain after Close.
+        if (popped) can_push_.notify_all();  // The mutex is already held.
+        return popped;
+      }
+      can_pop_.wait(lock);
+      pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // After this, Push fails, and Pop fails once the queue is drained.
+  void Close() {
+    closed_.store(true, std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    can_pop_.notify_all();
+    can_push_.notify_all();
+  }
+
+  bool closed() const { return closed_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr int kSpinsBeforeWait = 128;
+
+  struct Cell {
+    std::atomic<uint64_t> sequence;
+    T value;
+  };
+
+  bool TryPushNoWake(T&& item) {
+    Cell* cell;
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+      const int64_t dif =
+          static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (dif == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPopNoWake(T* out) {
+    Cell* cell;
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+      const int64_t dif =
+          static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // Empty: the slot has not been filled this lap.
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *out = std::move(cell->value);
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Same sleeper protocol as SpscQueue::Wake.
+  void Wake(std::atomic<int>* waiters, std::condition_variable* cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      cv->notify_all();
+    }
+  }
+
+  std::unique_ptr<Cell[]> cells_;
+  uint64_t mask_ = 0;
+  // The claim counters on their own cache lines; see SpscQueue.
+  alignas(64) std::atomic<uint64_t> enqueue_pos_{0};
+  alignas(64) std::atomic<uint64_t> dequeue_pos_{0};
+
+  alignas(64) std::atomic<bool> closed_{false};
+  std::mutex wait_mutex_;
+  std::condition_variable can_push_;
+  std::condition_variable can_pop_;
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+};
+
+// A shared work-stealing task pool for the parallel algorithm modes.
+// Each worker owns a deque of tasks: it pushes and pops its own work LIFO
+// (so recursively spawned subtasks run hot in cache) and steals the
+// oldest task from another worker when its deque runs dry. Waiting on a
+// TaskGroup executes queued tasks instead of blocking, so algorithms
+// that spawn from inside tasks compose: nested parallel sections share
+// the same fixed set of workers instead of each starting its own
+// threads and oversubscribing the machine.
+class TaskPool {
+ public:
+  // Creates the workers; `num_threads <= 0` means hardware concurrency.
+  explicit TaskPool(int num_threads = 0);
+  ~TaskPool();
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  // The process-wide pool shared by the parallel algorithm modes, sized
+  // to the hardware concurrency and created on first use.
+  static TaskPool* Global();
+
+  int NumWorkers() const { return static_cast<int>(workers_.size()); }
+
+  // Slot index for per-thread accumulators: tasks running on worker `i`
+  // see slot `i`, and any thread outside the pool (such as one executing
+  // tasks from inside TaskGroup::Sync) sees slot NumWorkers(). Size
+  // accumulator arrays NumSlots().
+  int NumSlots() const { return NumWorkers() + 1; }
+  int CurrentSlot() const;
+
+  // Pins worker i to online CPU i (wrapping when there are more workers
+  // than CPUs). With each worker fixed to one core, the per-slot arenas
+  // and accumulators the parallel solvers keep are touched by one thread
+  // only, so on multi-socket machines first-touch places their pages on
+  // that worker's own memory node instead of wherever the scheduler last
+  // migrated it. Linux only; a no-op elsewhere. Call once, before heavy
+  // use; leave unpinned on shared machines.
+  void PinWorkers();
+
+  // Trades throughput for scheduling-independent execution, for debugging
+  // parallel solvers: tasks are dealt round-robin in spawn order (never
+  // onto the spawning worker's own deque), each worker runs its deque in
+  // spawn order and never steals from the others, and a thread waiting in
+  // TaskGroup::Sync only executes tasks of its own deque (none at all
+  // from outside the pool) instead of draining whichever deque has work.
+  // The parallel solvers already reduce per-task results in a fixed order
+  // and derive their RNG streams from stable per-task ids, so with this
+  // mode on, a run whose groups are spawned from one thread at a time is
+  // bit-identical across executions. The cost is that idle workers can no
+  // longer help a loaded one; leave the mode off outside debugging.
+  // Toggle only while the pool is idle.
+  void SetDeterministic(bool deterministic);
+  bool IsDeterministic() const {
+    return deterministic_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  friend class TaskGroup;
+  struct Worker;
+
+  // Enqueues a task: onto the calling worker's own deque, or round-robin
+  // across the workers from outside the pool.
+  void Push(std::function<void()> task);
+
+  // Pops and runs one queued task if any is available anywhere; returns
+  // whether it did.
+  bool RunOneTask();
+
+  // Pops a task, preferring `start_index`'s own deque (newest first) and
+  // stealing the oldest task from the other workers otherwise.
+  std::function<void()> PopTask(int start_index);
+
+  void WorkerLoop(int worker_index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<int64_t> next_worker_{0};
+  std::atomic<bool> deterministic_{false};
+
+  // Guards the idle bookkeeping below; tasks themselves live in the
+  // per-worker deques under their own mutexes.
+  std::mutex idle_mutex_;
+  std::condition_variable work_cv_;
+  int64_t queued_count_ = 0;
+  bool shutdown_ = false;
+};
+
+// A set of tasks spawned together and waited on together. Sync (and the
+// destructor) executes queued tasks while it waits instead of blocking,
+// so a task may create and sync its own group without deadlock.
+class TaskGroup {
+ public:
+  explicit TaskGroup(TaskPool* pool) : pool_(pool) {}
+  ~TaskGroup() { Sync(); }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  // Schedules `task` on the pool. The group must outlive its tasks, and
+  // anything the task captures by reference must live until Sync returns.
+  void Spawn(std::function<void()> task);
+
+  // Returns once every spawned task has finished, executing queued tasks
+  // (not necessarily this group's) while it waits.
+  void Sync();
+
+ private:
+  TaskPool* pool_;
+  std::atomic<int64_t> pending_{0};
+};
+
+// A cooperative time budget for anytime algorithm entry points. Long
+// traversals poll Expired() at every node; to keep that affordable the
+// clock is only read once every kPollsPerClockCheck calls (a counter
+// decrement otherwise), so expiry is detected within that many polls of
+// the deadline rather than exactly at it. Once expired, a budget stays
+// expired. A default-constructed budget (or any negative number of
+// seconds) never expires, so APIs can take a TimeBudget* and treat
+// nullptr and an unlimited budget the same way.
+//
+// Not thread-safe: give each worker its own budget, or poll one budget
+// from a single thread.
+class TimeBudget {
+ public:
+  // A budget of `seconds` starting now; negative means unlimited.
+  explicit TimeBudget(double seconds = -1)
+      : seconds_(seconds), start_(std::chrono::steady_clock::now()) {}
+
+  // Amortized deadline check; see the class comment.
+  bool Expired() {
+    if (expired_) return true;
+    if (seconds_ < 0) return false;
+    if (--polls_until_check_ > 0) return false;
+    polls_until_check_ = kPollsPerClockCheck;
+    expired_ = ElapsedSeconds() >= seconds_;
+    return expired_;
+  }
+
+  // Precise check that always reads the clock, for call sites that poll
+  // rarely - say once per solver iteration - where the amortization
+  // above would overshoot. Const, and safe to call from several threads.
+  bool ExpiredNow() const { return RemainingSeconds() == 0; }
+
+  // Seconds left before expiry (zero once past it), or -1 when
+  // unlimited.
+  double RemainingSeconds() const {
+    if (seconds_ < 0) return -1;
+    return std::max(0.0, seconds_ - ElapsedSeconds());
+  }
+
+  // Seconds since construction. Always reads the clock.
+  double ElapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
+ private:
+  // How many Expired() calls share one clock read.
+  static constexpr int kPollsPerClockCheck = 256;
+
+  double seconds_;
+  std::chrono::steady_clock::time_point start_;
+  int polls_until_check_ = kPollsPerClockCheck;
+  bool expired_ = false;
+};
+
 // Helper function to determine the next player in a round robin.
 int NextPlayerRoundRobin(Player player, int nplayers);
 
@@ -183,6 +1191,39 @@ bool Near(T a, T b, T epsilon) {
   open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat( \
       __FILE__, ":", __LINE__, " CHECK_FALSE(", #x, ")"))
 
+// Hot-path tier of the checks above. SPIEL_CHECK_* is structural: it
+// guards API boundaries and inputs and stays in every build. The
+// SPIEL_DCHECK_* variants are for per-node invariants inside the hottest
+// loops — move application, board-cell access, per-sample bookkeeping —
+// where the branch and the error-string code cost measurable time and
+// icache. By default they are the same checks (the verification build);
+// compiling with -DOPEN_SPIEL_DISABLE_HOT_CHECKS turns them into nothing
+// for production runs. The arguments are not evaluated in that mode, so
+// they must be free of side effects.
+#ifndef OPEN_SPIEL_DISABLE_HOT_CHECKS
+
+#define SPIEL_DCHECK_GE(x, y) SPIEL_CHECK_GE(x, y)
+#define SPIEL_DCHECK_GT(x, y) SPIEL_CHECK_GT(x, y)
+#define SPIEL_DCHECK_LE(x, y) SPIEL_CHECK_LE(x, y)
+#define SPIEL_DCHECK_LT(x, y) SPIEL_CHECK_LT(x, y)
+#define SPIEL_DCHECK_EQ(x, y) SPIEL_CHECK_EQ(x, y)
+#define SPIEL_DCHECK_NE(x, y) SPIEL_CHECK_NE(x, y)
+#define SPIEL_DCHECK_TRUE(x) SPIEL_CHECK_TRUE(x)
+#define SPIEL_DCHECK_FALSE(x) SPIEL_CHECK_FALSE(x)
+
+#else  // OPEN_SPIEL_DISABLE_HOT_CHECKS
+
+#define SPIEL_DCHECK_GE(x, y)
+#define SPIEL_DCHECK_GT(x, y)
+#define SPIEL_DCHECK_LE(x, y)
+#define SPIEL_DCHECK_LT(x, y)
+#define SPIEL_DCHECK_EQ(x, y)
+#define SPIEL_DCHECK_NE(x, y)
+#define SPIEL_DCHECK_TRUE(x)
+#define SPIEL_DCHECK_FALSE(x)
+
+#endif  // OPEN_SPIEL_DISABLE_HOT_CHECKS
+
 // When an error is encountered, OpenSpiel code should call SpielFatalError()
 // which will forward the message to the current error handler.
 // The default error handler outputs the error message to stderr, and exits
@@ -194,9 +1235,11 @@ bool Near(T a, T b, T epsilon) {
 // Report a runtime error.
 [[noreturn]] void SpielFatalError(const std::string& error_msg);
 
-// Specify a new error handler.
+// Specify a new error handler. Returns the previously installed handler,
+// so a caller that wants to intercept errors temporarily (e.g. to turn
+// them into exceptions it can catch) can restore it afterwards.
 using ErrorHandler = void (*)(const std::string&);
-void SetErrorHandler(ErrorHandler error_handler);
+ErrorHandler SetErrorHandler(ErrorHandler error_handler);
 
 }  // namespace open_spiel
 
@@ -0,0 +1,103 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_TENSOR_SHAPE_H_
+#define THIRD_PARTY_OPEN_SPIEL_TENSOR_SHAPE_H_
+
+#include <vector>
+
+// Compile-time tensor shapes for the normalized-vector representations.
+//
+// Game::InformationStateNormalizedVectorShape() and its observation
+// counterpart return a heap std::vector<int> on every call, and callers then
+// multiply the extents out to recover the flat size. For most games the
+// extents are fixed constants, so templated code (see
+// algorithms/typed_rollout.h for the general pattern of opting in to static
+// dispatch) can instead work against a TensorShape whose size, strides and
+// offsets all fold to compile-time constants. Encode loops written against
+// these extents can be fully unrolled, and buffers can live on the stack.
+//
+// Everything here is opt-in; the virtual shape methods remain the source of
+// truth for code that only has a Game&.
+
+namespace open_spiel {
+
+// A tensor shape whose extents are template parameters. The flat layout is
+// row-major (last dimension fastest-varying), matching the layout written by
+// State::InformationStateAsNormalizedVector and
+// State::ObservationAsNormalizedVector.
+template <int... Extents>
+struct TensorShape {
+  static constexpr int kRank = sizeof...(Extents);
+  static constexpr int kSize = (1 * ... * Extents);
+
+  static constexpr int Extent(int dim) {
+    constexpr int extents[] = {Extents...};
+    return extents[dim];
+  }
+
+  // Number of flat elements between consecutive indices along `dim`.
+  static constexpr int Stride(int dim) {
+    int stride = 1;
+    for (int d = kRank - 1; d > dim; --d) stride *= Extent(d);
+    return stride;
+  }
+
+  // Flat offset of a multidimensional index; one integer per dimension.
+  template <typename... Ints>
+  static constexpr int Offset(Ints... index) {
+    static_assert(sizeof...(Ints) == kRank,
+                  "Offset takes one index per dimension.");
+    const int indices[] = {static_cast<int>(index)...};
+    int offset = 0;
+    for (int d = 0; d < kRank; ++d) offset += indices[d] * Stride(d);
+    return offset;
+  }
+
+  // The heap form returned by the virtual shape methods, so a game can define
+  // its extents once and serve both APIs from the same constants.
+  static std::vector<int> AsVector() { return {Extents...}; }
+};
+
+// A stack-allocated buffer sized for a static shape, for encoding without
+// touching the heap:
+//
+//   TensorBuffer<ObservationTensorTraits<GameT>::Shape> buffer;
+//   state.ObservationAsNormalizedVector(player, buffer.data);
+template <typename ShapeT>
+struct TensorBuffer {
+  double data[ShapeT::kSize];
+  static constexpr int size() { return ShapeT::kSize; }
+};
+
+// Opt-in shape traits. A game whose tensor extents do not depend on game
+// parameters specializes the relevant trait in its header (in the open_spiel
+// namespace, after the game class), exposing a `Shape` alias:
+//
+//   template <>
+//   struct ObservationTensorTraits<tic_tac_toe::TicTacToeGame> {
+//     using Shape = tic_tac_toe::ObservationShape;
+//   };
+//
+// Games with shape-affecting parameters (e.g. catch, breakthrough) have no
+// specialization and are only reachable through the virtual methods.
+template <typename GameT>
+struct InformationStateTensorTraits;
+
+template <typename GameT>
+struct ObservationTensorTraits;
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_TENSOR_SHAPE_H_
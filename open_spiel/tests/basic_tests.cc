@@ -14,10 +14,16 @@
 
 #include "open_spiel/tests/basic_tests.h"
 
+#include <atomic>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
@@ -133,6 +139,10 @@ void LegalActionsMaskTest(const Game& game, const State& state,
   }
 
   SPIEL_CHECK_EQ(num_ones, legal_actions.size());
+
+  // The no-argument form must agree with the generic one, in particular for
+  // games that override it to fill the mask directly from their board.
+  SPIEL_CHECK_EQ(state.LegalActionsMask(), legal_actions_mask);
 }
 
 bool IsPowerOfTwo(int n) { return n == 0 || (n & (n - 1)) == 0; }
@@ -276,7 +286,8 @@ void RandomSimBenchmark(const std::string& game_def, int num_sims,
 }
 
 void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
-                      bool serialize) {
+                      bool serialize, bool verbose = true,
+                      std::vector<Action>* action_log = nullptr) {
   std::vector<HistoryItem> history;
   std::vector<double> episode_returns(game.NumPlayers(), 0);
 
@@ -284,29 +295,37 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
       game.GetType().provides_information_state_as_normalized_vector
           ? game.InformationStateNormalizedVectorSize()
           : 0;
-  std::cout << "Information state vector size: " << infostate_vector_size
-            << std::endl;
+  if (verbose) {
+    std::cout << "Information state vector size: " << infostate_vector_size
+              << std::endl;
+  }
 
   int observation_vector_size =
       game.GetType().provides_observation_as_normalized_vector
           ? game.ObservationNormalizedVectorSize()
           : 0;
-  std::cout << "Observation vector size: " << observation_vector_size
-            << std::endl;
+  if (verbose) {
+    std::cout << "Observation vector size: " << observation_vector_size
+              << std::endl;
+  }
 
   SPIEL_CHECK_TRUE(game.MinUtility() < game.MaxUtility());
-  std::cout << "Utility range: " << game.MinUtility() << " "
-            << game.MaxUtility() << std::endl;
+  if (verbose) {
+    std::cout << "Utility range: " << game.MinUtility() << " "
+              << game.MaxUtility() << std::endl;
 
-  std::cout << "Starting new game.." << std::endl;
+    std::cout << "Starting new game.." << std::endl;
+  }
   std::unique_ptr<open_spiel::State> state = game.NewInitialState();
 
-  std::cout << "Initial state:" << std::endl;
-  std::cout << "State:" << std::endl << state->ToString() << std::endl;
+  if (verbose) {
+    std::cout << "Initial state:" << std::endl;
+    std::cout << "State:" << std::endl << state->ToString() << std::endl;
+  }
   int game_length = 0;
 
   while (!state->IsTerminal()) {
-    std::cout << "player " << state->CurrentPlayer() << std::endl;
+    if (verbose) std::cout << "player " << state->CurrentPlayer() << std::endl;
 
     LegalActionsIsEmptyForOtherPlayers(game, *state);
     LegalActionsAreSorted(game, *state);
@@ -326,10 +345,14 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
       Action action = open_spiel::SampleChanceOutcome(
           outcomes, std::uniform_real_distribution<double>(0.0, 1.0)(*rng));
 
-      std::cout << "sampled outcome: "
-                << state->ActionToString(kChancePlayerId, action) << std::endl;
+      if (verbose) {
+        std::cout << "sampled outcome: "
+                  << state->ActionToString(kChancePlayerId, action)
+                  << std::endl;
+      }
 
       history.emplace_back(state->Clone(), kChancePlayerId, action);
+      if (action_log != nullptr) action_log->push_back(action);
       state->ApplyAction(action);
 
       if (undo && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
@@ -338,7 +361,9 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     } else if (state->CurrentPlayer() == open_spiel::kSimultaneousPlayerId) {
       std::vector<double> rewards = state->Rewards();
       SPIEL_CHECK_EQ(rewards.size(), game.NumPlayers());
-      std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      if (verbose) {
+        std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      }
       for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
         episode_returns[p] += rewards[p];
       }
@@ -358,8 +383,11 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
         } else {
           history.emplace_back(nullptr, kInvalidHistoryPlayer, action);
         }
-        std::cout << "player " << p << " chose "
-                  << state->ActionToString(p, action) << std::endl;
+        if (action_log != nullptr) action_log->push_back(action);
+        if (verbose) {
+          std::cout << "player " << p << " chose "
+                    << state->ActionToString(p, action) << std::endl;
+        }
 
         // Check the information state, if supported.
         if (infostate_vector_size > 0) {
@@ -381,7 +409,9 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     } else {
       std::vector<double> rewards = state->Rewards();
       SPIEL_CHECK_EQ(rewards.size(), game.NumPlayers());
-      std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      if (verbose) {
+        std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      }
       for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
         episode_returns[p] += rewards[p];
       }
@@ -394,6 +424,12 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
         std::vector<double> infostate_vector;
         state->InformationStateAsNormalizedVector(player, &infostate_vector);
         SPIEL_CHECK_EQ(infostate_vector.size(), infostate_vector_size);
+
+        // The buffer-filling form must produce the same tensor.
+        std::vector<double> infostate_buffer(infostate_vector_size, -1.);
+        state->InformationStateAsNormalizedVector(player,
+                                                  infostate_buffer.data());
+        SPIEL_CHECK_TRUE(infostate_buffer == infostate_vector);
       }
 
       // Check the observation state vector, if supported.
@@ -401,6 +437,11 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
         std::vector<double> obs_vector;
         state->ObservationAsNormalizedVector(player, &obs_vector);
         SPIEL_CHECK_EQ(obs_vector.size(), observation_vector_size);
+
+        // The buffer-filling form must produce the same tensor.
+        std::vector<double> obs_buffer(observation_vector_size, -1.);
+        state->ObservationAsNormalizedVector(player, obs_buffer.data());
+        SPIEL_CHECK_TRUE(obs_buffer == obs_vector);
       }
 
       // Sample an action uniformly.
@@ -413,10 +454,13 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
       std::uniform_int_distribution<int> dis(0, actions.size() - 1);
       Action action = actions[dis(*rng)];
 
-      std::cout << "chose action: " << state->ActionToString(player, action)
-                << std::endl;
+      if (verbose) {
+        std::cout << "chose action: " << state->ActionToString(player, action)
+                  << std::endl;
+      }
 
       history.emplace_back(state->Clone(), player, action);
+      if (action_log != nullptr) action_log->push_back(action);
       ApplyActionTestClone(game, state.get(), action);
       game_length++;
 
@@ -425,15 +469,19 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
       }
     }
 
-    std::cout << "State: " << std::endl << state->ToString() << std::endl;
+    if (verbose) {
+      std::cout << "State: " << std::endl << state->ToString() << std::endl;
+    }
   }
 
   SPIEL_CHECK_LE(game_length, game.MaxGameLength());
 
-  std::cout << "Reached a terminal state!" << std::endl;
+  if (verbose) std::cout << "Reached a terminal state!" << std::endl;
   SPIEL_CHECK_EQ(state->CurrentPlayer(), kTerminalPlayerId);
   std::vector<double> rewards = state->Rewards();
-  std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+  if (verbose) {
+    std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+  }
 
   history.emplace_back(state->Clone(), kTerminalPlayerId,
                        kInvalidHistoryAction);
@@ -456,8 +504,10 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     SPIEL_CHECK_FLOAT_EQ(final_return, state->PlayerReturn(player));
     SPIEL_CHECK_GE(final_return, game.MinUtility());
     SPIEL_CHECK_LE(final_return, game.MaxUtility());
-    std::cout << "Final return to player " << player << " is " << final_return
-              << std::endl;
+    if (verbose) {
+      std::cout << "Final return to player " << player << " is "
+                << final_return << std::endl;
+    }
     episode_returns[player] += rewards[player];
     SPIEL_CHECK_TRUE(Near(episode_returns[player], final_return));
   }
@@ -482,6 +532,99 @@ void RandomSimTestWithUndo(const Game& game, int num_sims) {
   }
 }
 
+namespace {
+
+// Replays an action log recorded by RandomSimulation on a fresh state.
+// Simultaneous moves are recorded one action per player, so they are
+// re-applied in groups; a log cut off mid-joint-move stops before it.
+std::unique_ptr<State> ReplayActionLog(const Game& game,
+                                       const std::vector<Action>& actions) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  int i = 0;
+  while (i < actions.size() && !state->IsTerminal()) {
+    if (state->CurrentPlayer() == kSimultaneousPlayerId) {
+      if (i + game.NumPlayers() > actions.size()) break;
+      std::vector<Action> joint_action(actions.begin() + i,
+                                       actions.begin() + i + game.NumPlayers());
+      state->ApplyActions(joint_action);
+      i += game.NumPlayers();
+    } else {
+      state->ApplyAction(actions[i++]);
+    }
+  }
+  return state;
+}
+
+// Turns SPIEL_CHECK failures into exceptions the simulation workers can
+// catch, instead of the default handler's process exit.
+void ThrowingErrorHandler(const std::string& error_msg) {
+  throw std::runtime_error(error_msg);
+}
+
+}  // namespace
+
+void ParallelRandomSimTest(const Game& game, int num_sims, int num_threads) {
+  std::cout << "\nParallelRandomSimTest, game = " << game.GetType().short_name
+            << ", num_sims = " << num_sims << ", num_threads = " << num_threads
+            << std::endl;
+  ErrorHandler previous_handler = SetErrorHandler(ThrowingErrorHandler);
+
+  std::atomic<int> next_sim{0};
+  std::atomic<bool> failed{false};
+  std::mutex failure_mutex;
+  int failure_sim = -1;
+  std::string failure_message;
+  std::vector<Action> failure_log;
+
+  auto worker = [&]() {
+    for (int sim = next_sim++; sim < num_sims && !failed; sim = next_sim++) {
+      // Seeded by simulation index, not by thread, so the simulated games
+      // (and any failure) are reproducible regardless of num_threads.
+      std::mt19937 rng(sim);
+      std::vector<Action> action_log;
+      try {
+        RandomSimulation(&rng, game, /*undo=*/false, /*serialize=*/true,
+                         /*verbose=*/false, &action_log);
+      } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        // Keep the earliest failing simulation for determinism.
+        if (failure_sim < 0 || sim < failure_sim) {
+          failure_sim = sim;
+          failure_message = e.what();
+          failure_log = std::move(action_log);
+        }
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) threads.emplace_back(worker);
+  for (std::thread& thread : threads) thread.join();
+
+  SetErrorHandler(previous_handler);
+
+  if (failed) {
+    // The log holds the actions leading to the failing state: the minimal
+    // reproducer, since every earlier prefix passed the same checks during
+    // the simulation. Emit it in the binary serialization format.
+    std::unique_ptr<State> state = ReplayActionLog(game, failure_log);
+    const std::string filename =
+        absl::StrCat("/tmp/open_spiel_repro_", game.GetType().short_name,
+                     "_sim", failure_sim, ".bin");
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    const std::string serialized = state->SerializeBinary();
+    file.write(serialized.data(), serialized.size());
+    file.close();
+    SpielFatalError(absl::StrCat(
+        "ParallelRandomSimTest failed on simulation ", failure_sim, " (seed ",
+        failure_sim, "): ", failure_message, "\nReproducer (",
+        failure_log.size(), " actions, binary state serialization): ",
+        filename, "\nActions: ", absl::StrJoin(failure_log, " ")));
+  }
+}
+
 void RandomSimTestNoSerialize(const Game& game, int num_sims) {
   std::mt19937 rng;
   std::cout << "RandomSimTestNoSerialize, game = " << game.GetType().short_name
@@ -491,6 +634,75 @@ void RandomSimTestNoSerialize(const Game& game, int num_sims) {
   }
 }
 
+void ReturnsCostTest(const Game& game, int min_episode_length) {
+  std::mt19937 rng;
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  // Play one random episode, keeping a clone of an early state.
+  std::unique_ptr<State> state = game.NewInitialState();
+  std::unique_ptr<State> early_state;
+  int num_moves = 0;
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(SampleChanceOutcome(state->ChanceOutcomes(),
+                                             uniform(rng)));
+    } else if (state->IsSimultaneousNode()) {
+      std::vector<Action> joint_action;
+      for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
+        std::vector<Action> actions = state->LegalActions(p);
+        joint_action.push_back(
+            actions[absl::uniform_int_distribution<int>(
+                0, actions.size() - 1)(rng)]);
+      }
+      state->ApplyActions(joint_action);
+    } else {
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[absl::uniform_int_distribution<int>(
+          0, actions.size() - 1)(rng)]);
+    }
+    ++num_moves;
+    if (early_state == nullptr) early_state = state->Clone();
+  }
+  if (num_moves < min_episode_length) {
+    std::cout << "ReturnsCostTest, game = " << game.GetType().short_name
+              << ": episode of " << num_moves
+              << " moves is too short to be conclusive; skipping."
+              << std::endl;
+    return;
+  }
+
+  // Time Returns() at the early state vs. the terminal state. Take the
+  // minimum over a few rounds to damp scheduling noise.
+  constexpr int kCallsPerRound = 1000;
+  constexpr int kNumRounds = 3;
+  auto time_returns = [](const State& s) {
+    double best_seconds = std::numeric_limits<double>::infinity();
+    for (int round = 0; round < kNumRounds; ++round) {
+      absl::Time start = absl::Now();
+      for (int i = 0; i < kCallsPerRound; ++i) {
+        std::vector<double> returns = s.Returns();
+        // Keep the call from being optimized away.
+        if (returns.size() > 1000000) std::cout << returns[0];
+      }
+      best_seconds = std::min(best_seconds,
+                              absl::ToDoubleSeconds(absl::Now() - start));
+    }
+    return best_seconds;
+  };
+  double early_seconds = time_returns(*early_state);
+  double late_seconds = time_returns(*state);
+
+  // A hard failure here would be too flaky across machines; flag it.
+  constexpr double kCostGrowthFactor = 10.0;
+  if (late_seconds > kCostGrowthFactor * early_seconds) {
+    std::cerr << "WARNING: in game " << game.GetType().short_name
+              << ", Returns() took " << (late_seconds / early_seconds)
+              << "x longer after " << num_moves << " moves than after 1. "
+              << "Its cost appears to grow with history length; consider "
+              << "maintaining the returns incrementally." << std::endl;
+  }
+}
+
 // Format chance outcomes as a string, for error messages.
 std::string ChanceOutcomeStr(const ActionsAndProbs& chance_outcomes) {
   std::string str;
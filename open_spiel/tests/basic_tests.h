@@ -36,6 +36,17 @@ void NoChanceOutcomesTest(const Game& game);
 // Perform num_sims random simulations of the specified game.
 void RandomSimTest(const Game& game, int num_sims);
 
+// Perform num_sims random simulations of the specified game, spread over
+// num_threads workers with a per-simulation RNG (so the set of simulated
+// games does not depend on the thread count). Runs the same per-state
+// checks as RandomSimTest, but quietly, which makes it the right entry
+// point for long fuzzing runs. On a failure, the first failing simulation's
+// action prefix -- the actions leading to the failing state, which is the
+// minimal reproducer since every earlier prefix already passed the same
+// checks -- is replayed and written in the binary serialization format
+// (State::SerializeBinary) to a file named in the error message.
+void ParallelRandomSimTest(const Game& game, int num_sims, int num_threads);
+
 // Perform num_sims random simulations of the specified game. Also tests the
 // Undo function. Note: for every step in the simulation, the entire simulation
 // up to that point is rolled backward all the way to the beginning via undo,
@@ -53,6 +64,15 @@ void RandomSimBenchmark(const std::string& game_def, int num_sims,
 // used for smallish games.
 void CheckChanceOutcomes(const Game& game);
 
+// Flags games whose Returns() cost grows with the length of the history,
+// e.g. by re-summing an internal reward history on every call instead of
+// maintaining a running total. Plays one random episode and compares the
+// cost of Returns() near the start of the episode against the cost near
+// the end; a large ratio prints a warning (timing is too noisy across
+// machines for a hard failure). Episodes shorter than min_episode_length
+// moves are skipped as inconclusive.
+void ReturnsCostTest(const Game& game, int min_episode_length = 20);
+
 // Same as above but without checking the serialization functions. Every game
 // should support serialization: only use this function when developing a new
 // game, in order to test the implementation using the basic tests before having
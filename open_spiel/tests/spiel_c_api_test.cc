@@ -0,0 +1,152 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/spiel_c_api.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+void TestLoadGame() {
+  OpenSpielGame* game = open_spiel_load_game("tic_tac_toe");
+  SPIEL_CHECK_TRUE(game != nullptr);
+  SPIEL_CHECK_EQ(open_spiel_game_num_players(game), 2);
+  SPIEL_CHECK_EQ(open_spiel_game_num_distinct_actions(game), 9);
+  SPIEL_CHECK_EQ(open_spiel_game_max_game_length(game), 9);
+  char buffer[64];
+  int needed = open_spiel_game_to_string(game, buffer, sizeof(buffer));
+  SPIEL_CHECK_EQ(std::string(buffer), "tic_tac_toe()");
+  SPIEL_CHECK_EQ(needed, static_cast<int>(std::string("tic_tac_toe()").size()) + 1);
+  open_spiel_game_delete(game);
+
+  // Unknown names are the one recoverable error.
+  SPIEL_CHECK_TRUE(open_spiel_load_game("no_such_game") == nullptr);
+}
+
+void TestPlayThroughMatchesCpp() {
+  OpenSpielGame* c_game = open_spiel_load_game("kuhn_poker");
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  OpenSpielState* c_state = open_spiel_game_new_initial_state(c_game);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<int64_t> actions(open_spiel_game_num_distinct_actions(c_game) +
+                               open_spiel_game_max_chance_outcomes(c_game));
+  while (!state->IsTerminal()) {
+    SPIEL_CHECK_EQ(open_spiel_state_is_terminal(c_state), 0);
+    SPIEL_CHECK_EQ(open_spiel_state_current_player(c_state),
+                   state->CurrentPlayer());
+    SPIEL_CHECK_EQ(open_spiel_state_is_chance_node(c_state),
+                   state->IsChanceNode() ? 1 : 0);
+    int num_legal = open_spiel_state_legal_actions(c_state, actions.data(),
+                                                   actions.size());
+    std::vector<Action> legal = state->LegalActions();
+    SPIEL_CHECK_EQ(num_legal, static_cast<int>(legal.size()));
+    for (int i = 0; i < num_legal; ++i) SPIEL_CHECK_EQ(actions[i], legal[i]);
+    open_spiel_state_apply_action(c_state, legal[0]);
+    state->ApplyAction(legal[0]);
+  }
+  SPIEL_CHECK_EQ(open_spiel_state_is_terminal(c_state), 1);
+  std::vector<double> c_returns(open_spiel_game_num_players(c_game));
+  open_spiel_state_returns(c_state, c_returns.data());
+  SPIEL_CHECK_TRUE(c_returns == state->Returns());
+
+  std::vector<double> info_state(
+      open_spiel_game_information_state_size(c_game));
+  OpenSpielState* c_clone = open_spiel_state_clone(c_state);
+  open_spiel_state_information_state(c_clone, 0, info_state.data());
+  SPIEL_CHECK_TRUE(info_state ==
+                   state->InformationStateAsNormalizedVector(0));
+  open_spiel_state_delete(c_clone);
+  open_spiel_state_delete(c_state);
+  open_spiel_game_delete(c_game);
+}
+
+void TestBotPlaysLegally() {
+  OpenSpielGame* game = open_spiel_load_game("tic_tac_toe");
+  OpenSpielBot* bots[2] = {
+      open_spiel_make_uniform_random_bot(game, 0, /*seed=*/1234),
+      open_spiel_make_uniform_random_bot(game, 1, /*seed=*/5678)};
+  OpenSpielState* state = open_spiel_game_new_initial_state(game);
+  std::vector<int> mask(open_spiel_game_num_distinct_actions(game));
+  while (!open_spiel_state_is_terminal(state)) {
+    int player = open_spiel_state_current_player(state);
+    int64_t action = open_spiel_bot_step(bots[player], state);
+    open_spiel_state_legal_actions_mask(state, mask.data(), mask.size());
+    SPIEL_CHECK_EQ(mask[action], 1);
+    open_spiel_state_apply_action(state, action);
+  }
+  open_spiel_state_delete(state);
+  open_spiel_bot_delete(bots[0]);
+  open_spiel_bot_delete(bots[1]);
+  open_spiel_game_delete(game);
+}
+
+void TestBatchedEnvironment() {
+  constexpr int kBatchSize = 8;
+  OpenSpielGame* game = open_spiel_load_game("tic_tac_toe");
+  const int num_actions = open_spiel_game_num_distinct_actions(game);
+  const int num_players = open_spiel_game_num_players(game);
+  const int observation_size = open_spiel_game_observation_size(game);
+  OpenSpielBatchedEnvironment* env =
+      open_spiel_batched_environment_new(game, kBatchSize, /*seed=*/42);
+  SPIEL_CHECK_EQ(open_spiel_batched_environment_batch_size(env), kBatchSize);
+
+  std::vector<int> masks(kBatchSize * num_actions);
+  std::vector<int64_t> step_actions(kBatchSize);
+  std::vector<int> players(kBatchSize);
+  std::vector<double> rewards(kBatchSize * num_players);
+  std::vector<double> observations(kBatchSize * observation_size);
+  for (int step = 0; step < 20; ++step) {
+    open_spiel_batched_environment_fill_legal_actions_masks(env, masks.data());
+    open_spiel_batched_environment_current_players(env, players.data());
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (open_spiel_batched_environment_is_terminal(env, i)) continue;
+      SPIEL_CHECK_GE(players[i], 0);
+      // Take the first legal action of each live episode.
+      const int* mask = &masks[i * num_actions];
+      int chosen = -1;
+      for (int a = 0; a < num_actions; ++a) {
+        if (mask[a] == 1) {
+          chosen = a;
+          break;
+        }
+      }
+      SPIEL_CHECK_GE(chosen, 0);
+      step_actions[i] = chosen;
+    }
+    open_spiel_batched_environment_step_all(env, step_actions.data());
+    open_spiel_batched_environment_fill_rewards(env, rewards.data(),
+                                                num_players);
+    open_spiel_batched_environment_fill_observations(env, observations.data(),
+                                                     observation_size);
+    open_spiel_batched_environment_reset_terminals(env);
+  }
+  open_spiel_batched_environment_delete(env);
+  open_spiel_game_delete(game);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestLoadGame();
+  open_spiel::TestPlayThroughMatchesCpp();
+  open_spiel::TestBotPlaysLegally();
+  open_spiel::TestBatchedEnvironment();
+}
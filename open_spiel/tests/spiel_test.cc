@@ -14,12 +14,18 @@
 
 #include "open_spiel/spiel.h"
 
+#include <atomic>
+#include <cmath>
+#include <cstdio>
 #include <functional>
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
+#include <unordered_set>
 #include <vector>
 
+#include "open_spiel/batched_environment.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
 #include "open_spiel/games/liars_dice.h"
@@ -27,7 +33,9 @@
 #include "open_spiel/policy.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/tensor_shape.h"
 #include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/vectorized_game.h"
 
 namespace open_spiel {
 namespace testing {
@@ -51,10 +59,54 @@ void KuhnTests() {
   }
 }
 
+void ParallelRandomSimTests() {
+  // One deterministic game and one with chance nodes; the checks are the
+  // ones RandomSimTest runs, spread over worker threads.
+  ParallelRandomSimTest(*LoadGame("tic_tac_toe"), /*num_sims=*/40,
+                        /*num_threads=*/4);
+  ParallelRandomSimTest(*LoadGame("kuhn_poker"), /*num_sims=*/40,
+                        /*num_threads=*/4);
+}
+
 void TicTacToeTests() {
   auto tic_tac_toe = LoadGame("tic_tac_toe");
   NoChanceOutcomesTest(*tic_tac_toe);
   RandomSimTest(*tic_tac_toe, /*num_sims=*/100);
+
+  // The buffer-reuse form of ActionToString must agree with the
+  // allocating form.
+  std::unique_ptr<State> state = tic_tac_toe->NewInitialState();
+  std::string buffer;
+  for (Action action : state->LegalActions()) {
+    state->ActionToString(state->CurrentPlayer(), action, &buffer);
+    SPIEL_CHECK_EQ(buffer, state->ActionToString(state->CurrentPlayer(),
+                                                 action));
+  }
+}
+
+void StateArenaTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> root = game->NewInitialState();
+  StateArena arena;
+  {
+    ScopedStateArena scoped_arena(&arena);
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      for (Action action : root->LegalActions()) {
+        std::unique_ptr<State> child = root->Child(action);
+        SPIEL_CHECK_FALSE(child->IsTerminal());
+      }
+      arena.Reset();
+    }
+  }
+  // All iterations should fit within the initial block.
+  SPIEL_CHECK_EQ(arena.BytesReserved(), StateArena::kDefaultBlockSize);
+  // Heap-allocated states must still be deletable while an arena is active.
+  {
+    std::unique_ptr<State> heap_state = game->NewInitialState();
+    ScopedStateArena scoped_arena(&arena);
+    heap_state.reset();
+    arena.Reset();
+  }
 }
 
 // Dummy game to test flat joint action logic.
@@ -193,6 +245,1017 @@ void PolicyTest() {
   }
 }
 
+void FlatTabularPolicyTest() {
+  // The frozen form must agree with the map-backed policy entry for entry.
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  FlatTabularPolicy flat_policy(policy);
+  SPIEL_CHECK_EQ(flat_policy.NumEntries(),
+                 static_cast<int>(policy.PolicyTable().size()));
+  ActionsAndProbs buffer;
+  for (const auto& entry : policy.PolicyTable()) {
+    SPIEL_CHECK_TRUE(flat_policy.GetStatePolicy(entry.first) == entry.second);
+    flat_policy.GetStatePolicyInto(entry.first, &buffer);
+    SPIEL_CHECK_TRUE(buffer == entry.second);
+    for (const auto& action_and_prob : entry.second) {
+      SPIEL_CHECK_EQ(
+          flat_policy.GetActionProbability(entry.first, action_and_prob.first),
+          action_and_prob.second);
+    }
+  }
+  SPIEL_CHECK_TRUE(flat_policy.GetStatePolicy("no such infostate").empty());
+  SPIEL_CHECK_EQ(flat_policy.GetActionProbability("no such infostate", 0), -1.);
+}
+
+void MmapTabularPolicyTest() {
+  // A policy served from a mapped file must agree with the map-backed
+  // policy it was saved from, entry for entry.
+  const std::string filename = "/tmp/open_spiel_spiel_test_policy.bin";
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  SavePolicyToFile(policy, filename);
+  MmapTabularPolicy mapped_policy(filename);
+  SPIEL_CHECK_EQ(mapped_policy.NumEntries(),
+                 static_cast<int64_t>(policy.PolicyTable().size()));
+  ActionsAndProbs buffer;
+  for (const auto& entry : policy.PolicyTable()) {
+    SPIEL_CHECK_TRUE(mapped_policy.GetStatePolicy(entry.first) == entry.second);
+    mapped_policy.GetStatePolicyInto(entry.first, &buffer);
+    SPIEL_CHECK_TRUE(buffer == entry.second);
+    for (const auto& action_and_prob : entry.second) {
+      SPIEL_CHECK_EQ(mapped_policy.GetActionProbability(
+                         entry.first, action_and_prob.first),
+                     action_and_prob.second);
+    }
+  }
+  SPIEL_CHECK_TRUE(mapped_policy.GetStatePolicy("no such infostate").empty());
+  SPIEL_CHECK_EQ(mapped_policy.GetActionProbability("no such infostate", 0),
+                 -1.);
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+void OverlayPolicyTest() {
+  // An overlay with no overrides must agree with its base, and an override
+  // must mask exactly its own information state until it is removed.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TabularPolicy base = GetUniformPolicy(*game);
+  OverlayPolicy overlay(&base);
+  ActionsAndProbs buffer;
+  for (const auto& entry : base.PolicyTable()) {
+    SPIEL_CHECK_TRUE(overlay.GetStatePolicy(entry.first) == entry.second);
+    overlay.GetStatePolicyInto(entry.first, &buffer);
+    SPIEL_CHECK_TRUE(buffer == entry.second);
+  }
+
+  const std::string& info_state = base.PolicyTable().begin()->first;
+  const ActionsAndProbs base_probs = base.GetStatePolicy(info_state);
+  std::vector<Action> legal_actions;
+  for (const auto& action_and_prob : base_probs) {
+    legal_actions.push_back(action_and_prob.first);
+  }
+  overlay.SetOverride(info_state, legal_actions[0], legal_actions);
+  SPIEL_CHECK_EQ(overlay.Overrides().size(), 1);
+  SPIEL_CHECK_EQ(overlay.GetActionProbability(info_state, legal_actions[0]),
+                 1.0);
+  for (int i = 1; i < legal_actions.size(); ++i) {
+    SPIEL_CHECK_EQ(overlay.GetActionProbability(info_state, legal_actions[i]),
+                   0.0);
+  }
+  for (const auto& entry : base.PolicyTable()) {
+    if (entry.first == info_state) continue;
+    SPIEL_CHECK_TRUE(overlay.GetStatePolicy(entry.first) == entry.second);
+  }
+
+  SPIEL_CHECK_TRUE(overlay.RemoveOverride(info_state));
+  SPIEL_CHECK_FALSE(overlay.RemoveOverride(info_state));
+  SPIEL_CHECK_TRUE(overlay.GetStatePolicy(info_state) == base_probs);
+}
+
+void PolicyExportImportTest() {
+  // The transport container must round-trip a policy exactly at float64
+  // and to float precision at float32, including chunk boundaries (the
+  // chunk size is set well below the table size).
+  const std::string filename = "/tmp/open_spiel_spiel_test_export.bin";
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+
+  PolicyExportOptions options;
+  options.chunk_size = 16;
+  ExportPolicyToFile(policy, filename, options);
+  TabularPolicy imported = ImportPolicyFromFile(filename);
+  SPIEL_CHECK_EQ(imported.PolicyTable().size(), policy.PolicyTable().size());
+  for (const auto& entry : policy.PolicyTable()) {
+    SPIEL_CHECK_TRUE(imported.GetStatePolicy(entry.first) == entry.second);
+  }
+
+  options.float32_probs = true;
+  ExportPolicyToFile(policy, filename, options);
+  TabularPolicy quantized = ImportPolicyFromFile(filename);
+  SPIEL_CHECK_EQ(quantized.PolicyTable().size(), policy.PolicyTable().size());
+  for (const auto& entry : policy.PolicyTable()) {
+    const ActionsAndProbs imported_policy =
+        quantized.GetStatePolicy(entry.first);
+    SPIEL_CHECK_EQ(imported_policy.size(), entry.second.size());
+    for (int i = 0; i < entry.second.size(); ++i) {
+      SPIEL_CHECK_EQ(imported_policy[i].first, entry.second[i].first);
+      SPIEL_CHECK_TRUE(
+          Near(imported_policy[i].second, entry.second[i].second, 1e-6));
+    }
+  }
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+void PolicyCheckpointStreamTest() {
+  // A checkpoint stream must materialize every checkpoint exactly, from
+  // keyframes and delta records alike, including entry changes, removals
+  // and additions, and must keep its history when reopened for append.
+  const std::string filename = "/tmp/open_spiel_spiel_test_checkpoints.bin";
+  std::remove(filename.c_str());
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+
+  PolicyCheckpointOptions options;
+  options.export_options.chunk_size = 16;
+  options.keyframe_interval = 3;
+  std::vector<TabularPolicy> snapshots;
+  {
+    PolicyCheckpointWriter writer(filename, options);
+    TabularPolicy policy = GetRandomPolicy(*game);
+    std::string removed_key;
+    for (int checkpoint = 0; checkpoint < 8; ++checkpoint) {
+      // Perturb a different sliver of the table each step, and at one
+      // checkpoint remove an entry, restoring it at the next.
+      int i = 0;
+      for (auto& infostate_and_probs : policy.PolicyTable()) {
+        if (i++ % 7 != checkpoint % 7) continue;
+        double total = 0;
+        for (auto& action_and_prob : infostate_and_probs.second) {
+          action_and_prob.second = action_and_prob.second * 0.5 + 0.1;
+          total += action_and_prob.second;
+        }
+        for (auto& action_and_prob : infostate_and_probs.second) {
+          action_and_prob.second /= total;
+        }
+      }
+      TabularPolicy snapshot = policy;
+      if (checkpoint == 4) {
+        removed_key = snapshot.PolicyTable().begin()->first;
+        snapshot.PolicyTable().erase(removed_key);
+      }
+      writer.Append(snapshot);
+      snapshots.push_back(snapshot);
+    }
+    SPIEL_CHECK_EQ(writer.NumCheckpoints(), 8);
+  }
+
+  SPIEL_CHECK_EQ(NumPolicyCheckpoints(filename), 8);
+  for (int checkpoint = 0; checkpoint < 8; ++checkpoint) {
+    TabularPolicy materialized = ReadPolicyCheckpoint(filename, checkpoint);
+    const auto& expected = snapshots[checkpoint].PolicyTable();
+    SPIEL_CHECK_EQ(materialized.PolicyTable().size(), expected.size());
+    for (const auto& entry : expected) {
+      SPIEL_CHECK_TRUE(materialized.GetStatePolicy(entry.first) ==
+                       entry.second);
+    }
+  }
+
+  // Reopening picks up where the stream left off.
+  {
+    PolicyCheckpointWriter writer(filename, options);
+    SPIEL_CHECK_EQ(writer.NumCheckpoints(), 8);
+    writer.Append(snapshots.back());
+  }
+  SPIEL_CHECK_EQ(NumPolicyCheckpoints(filename), 9);
+  TabularPolicy tail = ReadPolicyCheckpoint(filename, 8);
+  SPIEL_CHECK_EQ(tail.PolicyTable().size(),
+                 snapshots.back().PolicyTable().size());
+  SPIEL_CHECK_EQ(std::remove(filename.c_str()), 0);
+}
+
+void CachedLegalActionsTest() {
+  // The cached list must track the real one across applies and undos.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_TRUE(state->CachedLegalActions() == state->LegalActions());
+  // A second query must serve the same cached storage.
+  const std::vector<Action>* cached = &state->CachedLegalActions();
+  SPIEL_CHECK_TRUE(cached == &state->CachedLegalActions());
+  while (!state->IsTerminal()) {
+    Player player = state->CurrentPlayer();
+    Action action = state->CachedLegalActions()[0];
+    state->ApplyAction(action);
+    SPIEL_CHECK_TRUE(state->CachedLegalActions() == state->LegalActions());
+    state->UndoAction(player, action);
+    SPIEL_CHECK_TRUE(state->CachedLegalActions() == state->LegalActions());
+    state->ApplyAction(action);
+  }
+}
+
+void SmallVectorTest() {
+  // The inline-storage vector must behave like std::vector across the
+  // spill from inline to heap storage.
+  SmallVector<Action, 4> actions;
+  SPIEL_CHECK_TRUE(actions.empty());
+  std::vector<Action> expected;
+  for (Action action = 0; action < 10; ++action) {
+    actions.push_back(action);
+    expected.push_back(action);
+  }
+  SPIEL_CHECK_EQ(actions.size(), 10);
+  SPIEL_CHECK_EQ(actions.back(), 9);
+  for (int i = 0; i < actions.size(); ++i) {
+    SPIEL_CHECK_EQ(actions[i], expected[i]);
+  }
+  // Round-trip through std::vector and copies preserve the contents.
+  std::vector<Action> converted = actions;
+  SPIEL_CHECK_TRUE(converted == expected);
+  SmallVector<Action, 4> from_vector(expected);
+  SPIEL_CHECK_TRUE(from_vector == actions);
+  SmallVector<Action, 4> copy = actions;
+  SPIEL_CHECK_TRUE(copy == actions);
+  copy.clear();
+  SPIEL_CHECK_TRUE(copy.empty());
+  SPIEL_CHECK_TRUE(copy != actions);
+}
+
+void SplittableRandomTest() {
+  // Same seed, same sequence.
+  SplittableRandom a(1234);
+  SplittableRandom b(1234);
+  for (int i = 0; i < 100; ++i) {
+    SPIEL_CHECK_EQ(a.NextUInt64(), b.NextUInt64());
+  }
+  // A split stream diverges from its parent.
+  SplittableRandom child = a.Split();
+  bool diverged = false;
+  for (int i = 0; i < 10; ++i) {
+    if (a.NextUInt64() != child.NextUInt64()) diverged = true;
+  }
+  SPIEL_CHECK_TRUE(diverged);
+  // Draws stay in range and hit every bucket of a small range.
+  std::vector<int> counts(7, 0);
+  for (int i = 0; i < 10000; ++i) {
+    const double draw = a.NextDouble();
+    SPIEL_CHECK_GE(draw, 0.0);
+    SPIEL_CHECK_LT(draw, 1.0);
+    const int n = a.NextInt(7);
+    SPIEL_CHECK_GE(n, 0);
+    SPIEL_CHECK_LT(n, 7);
+    ++counts[n];
+  }
+  for (int count : counts) SPIEL_CHECK_GT(count, 1000);
+}
+
+void StringInternPoolTest() {
+  StringInternPool pool;
+  // Ids are dense from zero and stable on re-intern.
+  SPIEL_CHECK_EQ(pool.Intern("first"), 0);
+  SPIEL_CHECK_EQ(pool.Intern("second"), 1);
+  SPIEL_CHECK_EQ(pool.Intern("first"), 0);
+  SPIEL_CHECK_EQ(pool.size(), 2);
+  // Find does not insert.
+  SPIEL_CHECK_EQ(pool.Find("second"), 1);
+  SPIEL_CHECK_EQ(pool.Find("third"), -1);
+  SPIEL_CHECK_EQ(pool.size(), 2);
+  // Views round-trip and stay valid as the pool grows.
+  absl::string_view first = pool.View(0);
+  for (int i = 0; i < 1000; ++i) pool.Intern(absl::StrCat("extra-", i));
+  SPIEL_CHECK_EQ(std::string(first), "first");
+  SPIEL_CHECK_EQ(std::string(pool.View(1)), "second");
+  SPIEL_CHECK_EQ(pool.Find(pool.View(500)), 500);
+}
+
+void BoundedCacheTest() {
+  // A cache bigger than the key range behaves like a map.
+  BoundedCache<int, int> small(256);
+  for (int i = 0; i < 100; ++i) small.Insert(i, i * i);
+  for (int i = 0; i < 100; ++i) {
+    int value = -1;
+    SPIEL_CHECK_TRUE(small.Lookup(i, &value));
+    SPIEL_CHECK_EQ(value, i * i);
+  }
+  int value = -1;
+  SPIEL_CHECK_FALSE(small.Lookup(1000, &value));
+  SPIEL_CHECK_EQ(small.Hits(), 100);
+  SPIEL_CHECK_EQ(small.Misses(), 1);
+
+  // Re-inserting a present key refreshes it in place.
+  small.Insert(3, 42);
+  SPIEL_CHECK_TRUE(small.Lookup(3, &value));
+  SPIEL_CHECK_EQ(value, 42);
+
+  // Overflowing a tiny cache evicts rather than grows, every stored value
+  // stays consistent with its key, and a hot key mostly survives: looking
+  // it up between inserts re-arms its reference bit, so the CLOCK hand
+  // usually takes a cold entry instead. (Not always — a sweep that finds
+  // every bit set clears them all — so the test bounds the eviction rate
+  // rather than demanding immortality.)
+  BoundedCache<int, int> tiny(8);
+  tiny.Insert(0, 0);
+  int hot_reinserts = 0;
+  for (int i = 1; i <= 1000; ++i) {
+    tiny.Insert(i, i * i);
+    if (!tiny.Lookup(0, &value)) {
+      tiny.Insert(0, 0);
+      ++hot_reinserts;
+    }
+  }
+  SPIEL_CHECK_LT(hot_reinserts, 250);
+  SPIEL_CHECK_GT(tiny.Evictions(), 0);
+  int present = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (tiny.Lookup(i, &value)) {
+      SPIEL_CHECK_EQ(value, i * i);
+      ++present;
+    }
+  }
+  SPIEL_CHECK_GT(present, 0);
+  SPIEL_CHECK_LE(present, tiny.Capacity());
+
+  // Striped mode: concurrent writers and readers over disjoint key ranges
+  // never see a value that does not match its key.
+  BoundedCache<int, int> striped(1024, /*num_stripes=*/8);
+  {
+    TaskGroup group(TaskPool::Global());
+    for (int t = 0; t < 4; ++t) {
+      group.Spawn([t, &striped]() {
+        for (int i = 0; i < 1000; ++i) {
+          const int key = t * 10000 + i;
+          striped.Insert(key, key + 7);
+          int got = -1;
+          if (striped.Lookup(key, &got)) SPIEL_CHECK_EQ(got, key + 7);
+        }
+      });
+    }
+    group.Sync();
+  }
+}
+
+// Recursive divide-and-conquer sum, exercising nested groups: every level
+// spawns one half and computes the other on the current thread.
+int64_t ParallelRangeSum(TaskPool* pool, int64_t begin, int64_t end) {
+  if (end - begin <= 1000) {
+    int64_t sum = 0;
+    for (int64_t i = begin; i < end; ++i) sum += i;
+    return sum;
+  }
+  const int64_t mid = begin + (end - begin) / 2;
+  int64_t left = 0;
+  TaskGroup group(pool);
+  group.Spawn([pool, begin, mid, &left]() {
+    left = ParallelRangeSum(pool, begin, mid);
+  });
+  const int64_t right = ParallelRangeSum(pool, mid, end);
+  group.Sync();
+  return left + right;
+}
+
+void TaskPoolTest() {
+  TaskPool pool(4);
+  SPIEL_CHECK_EQ(pool.NumWorkers(), 4);
+  const int64_t n = 1000000;
+  SPIEL_CHECK_EQ(ParallelRangeSum(&pool, 0, n), n * (n - 1) / 2);
+
+  // Flat fan-out with per-slot accumulators: slots never run two tasks at
+  // once, so the unsynchronized counts must add up exactly.
+  std::vector<int64_t> slot_counts(pool.NumSlots(), 0);
+  {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 1000; ++i) {
+      group.Spawn([&pool, &slot_counts]() {
+        const int slot = pool.CurrentSlot();
+        SPIEL_CHECK_GE(slot, 0);
+        SPIEL_CHECK_LT(slot, pool.NumSlots());
+        ++slot_counts[slot];
+      });
+    }
+  }
+  int64_t total = 0;
+  for (int64_t count : slot_counts) total += count;
+  SPIEL_CHECK_EQ(total, 1000);
+
+  // Deterministic mode: the round-robin partitioning repeats with the
+  // worker count, a second identical round lands every task on the same
+  // slot, and nested groups still complete (waiting workers drain their
+  // own deques).
+  pool.SetDeterministic(true);
+  SPIEL_CHECK_TRUE(pool.IsDeterministic());
+  SPIEL_CHECK_EQ(ParallelRangeSum(&pool, 0, n), n * (n - 1) / 2);
+  const int num_tasks = 8 * pool.NumWorkers();
+  std::vector<std::vector<int>> round_slots(
+      2, std::vector<int>(num_tasks, -1));
+  for (int round = 0; round < 2; ++round) {
+    TaskGroup det_group(&pool);
+    for (int i = 0; i < num_tasks; ++i) {
+      det_group.Spawn([&pool, &round_slots, round, i]() {
+        round_slots[round][i] = pool.CurrentSlot();
+      });
+    }
+    det_group.Sync();
+  }
+  for (int i = 0; i < num_tasks; ++i) {
+    SPIEL_CHECK_EQ(round_slots[0][i], round_slots[1][i]);
+    if (i >= pool.NumWorkers()) {
+      SPIEL_CHECK_EQ(round_slots[0][i],
+                     round_slots[0][i - pool.NumWorkers()]);
+    }
+  }
+  pool.SetDeterministic(false);
+
+  // The process-wide pool works the same way.
+  std::atomic<int> ran{0};
+  TaskGroup group(TaskPool::Global());
+  for (int i = 0; i < 10; ++i) group.Spawn([&ran]() { ran.fetch_add(1); });
+  group.Sync();
+  SPIEL_CHECK_EQ(ran.load(), 10);
+}
+
+void SpscQueueTest() {
+  // Capacity rounds up to a power of two.
+  SpscQueue<int> queue(6);
+  SPIEL_CHECK_EQ(queue.Capacity(), 8);
+
+  // Fill to capacity, overflow fails, drain in FIFO order.
+  for (int i = 0; i < 8; ++i) SPIEL_CHECK_TRUE(queue.TryPush(int{i}));
+  SPIEL_CHECK_FALSE(queue.TryPush(99));
+  int item;
+  for (int i = 0; i < 8; ++i) {
+    SPIEL_CHECK_TRUE(queue.TryPop(&item));
+    SPIEL_CHECK_EQ(item, i);
+  }
+  SPIEL_CHECK_FALSE(queue.TryPop(&item));
+
+  // Batch transfer moves as much of the prefix as fits.
+  std::vector<int> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  SPIEL_CHECK_EQ(queue.TryPushBatch(&in), 8);
+  SPIEL_CHECK_EQ(static_cast<int>(in.size()), 2);
+  SPIEL_CHECK_EQ(in[0], 8);
+  std::vector<int> out;
+  SPIEL_CHECK_EQ(queue.TryPopBatch(&out, 5), 5);
+  SPIEL_CHECK_EQ(queue.TryPopBatch(&out, 100), 3);
+  for (int i = 0; i < 8; ++i) SPIEL_CHECK_EQ(out[i], i);
+
+  // A producer and consumer hammering the blocking calls through a small
+  // ring agree on the total; Close lets the consumer drain the tail.
+  constexpr int kItems = 100000;
+  SpscQueue<int> pipe(64);
+  int64_t sum = 0;
+  std::thread consumer([&pipe, &sum]() {
+    int value;
+    std::vector<int> batch;
+    while (pipe.Pop(&value)) {
+      sum += value;
+      batch.clear();
+      pipe.TryPopBatch(&batch, 32);
+      for (int v : batch) sum += v;
+    }
+  });
+  for (int i = 0; i < kItems; ++i) SPIEL_CHECK_TRUE(pipe.Push(i));
+  pipe.Close();
+  consumer.join();
+  SPIEL_CHECK_EQ(sum, static_cast<int64_t>(kItems) * (kItems - 1) / 2);
+
+  // Pushing after Close fails.
+  SPIEL_CHECK_FALSE(pipe.Push(1));
+  SPIEL_CHECK_FALSE(pipe.TryPush(1));
+}
+
+void MpmcQueueTest() {
+  // Single-threaded edges behave like the SPSC ring.
+  MpmcQueue<int> queue(4);
+  SPIEL_CHECK_EQ(queue.Capacity(), 4);
+  for (int i = 0; i < 4; ++i) SPIEL_CHECK_TRUE(queue.TryPush(int{i}));
+  SPIEL_CHECK_FALSE(queue.TryPush(99));
+  int item;
+  for (int i = 0; i < 4; ++i) {
+    SPIEL_CHECK_TRUE(queue.TryPop(&item));
+    SPIEL_CHECK_EQ(item, i);
+  }
+  SPIEL_CHECK_FALSE(queue.TryPop(&item));
+
+  // Several producers fan in and several consumers fan out over a small
+  // ring; every pushed value is popped exactly once.
+  constexpr int kProducers = 3;
+  constexpr int kConsumers = 3;
+  constexpr int kPerProducer = 20000;
+  MpmcQueue<int> pipe(32);
+  std::atomic<int64_t> sum{0};
+  std::vector<std::thread> consumers;
+  for (int c = 0; c < kConsumers; ++c) {
+    consumers.emplace_back([&pipe, &sum]() {
+      int value;
+      int64_t local = 0;
+      while (pipe.Pop(&value)) local += value;
+      sum.fetch_add(local);
+    });
+  }
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&pipe]() {
+      for (int i = 0; i < kPerProducer; ++i) SPIEL_CHECK_TRUE(pipe.Push(i));
+    });
+  }
+  for (auto& t : producers) t.join();
+  pipe.Close();
+  for (auto& t : consumers) t.join();
+  SPIEL_CHECK_EQ(
+      sum.load(),
+      kProducers * static_cast<int64_t>(kPerProducer) * (kPerProducer - 1) / 2);
+}
+
+void TimeBudgetTest() {
+  // Unlimited budgets never expire.
+  TimeBudget unlimited;
+  for (int i = 0; i < 1000; ++i) SPIEL_CHECK_FALSE(unlimited.Expired());
+  SPIEL_CHECK_FALSE(unlimited.ExpiredNow());
+  SPIEL_CHECK_EQ(unlimited.RemainingSeconds(), -1);
+
+  // An already-expired budget is seen at once by the precise check and
+  // within one amortization stride by the cheap one.
+  TimeBudget expired(/*seconds=*/0.0);
+  SPIEL_CHECK_TRUE(expired.ExpiredNow());
+  SPIEL_CHECK_EQ(expired.RemainingSeconds(), 0);
+  bool seen = false;
+  for (int i = 0; i < 256 && !seen; ++i) seen = expired.Expired();
+  SPIEL_CHECK_TRUE(seen);
+  // Once expired, it stays expired.
+  SPIEL_CHECK_TRUE(expired.Expired());
+
+  SPIEL_CHECK_GE(expired.ElapsedSeconds(), 0.0);
+}
+
+void ActionHistoryTest() {
+  // The compact history must behave exactly as the std::vector<Action> it
+  // replaces, across both width promotions.
+  ActionHistory history;
+  std::vector<Action> reference;
+  auto check = [&]() {
+    SPIEL_CHECK_EQ(history.size(), reference.size());
+    SPIEL_CHECK_TRUE(history.ToVector() == reference);
+    for (int i = 0; i < reference.size(); ++i) {
+      SPIEL_CHECK_EQ(history[i], reference[i]);
+    }
+  };
+  for (Action action : {Action{0}, Action{3}, kInvalidAction, Action{65534}}) {
+    history.push_back(action);
+    reference.push_back(action);
+  }
+  check();  // Still 16-bit storage.
+  history.push_back(Action{1} << 20);  // Forces 32-bit storage.
+  reference.push_back(Action{1} << 20);
+  check();
+  history.push_back(Action{1} << 40);  // Forces full-width storage.
+  reference.push_back(Action{1} << 40);
+  history.push_back(kInvalidAction);
+  reference.push_back(kInvalidAction);
+  check();
+  history.pop_back();
+  reference.pop_back();
+  check();
+  SPIEL_CHECK_EQ(history.back(), Action{1} << 40);
+  std::vector<Action> iterated;
+  for (Action action : history) iterated.push_back(action);
+  SPIEL_CHECK_TRUE(iterated == reference);
+  history.clear();
+  SPIEL_CHECK_TRUE(history.empty());
+}
+
+void HistoryStringAndHashTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  const uint64_t empty_hash = state->HistoryHash();
+  std::vector<uint64_t> prefix_hashes = {empty_hash};
+  // The incremental string must match a full re-join after every apply.
+  for (Action action : {4, 0, 8, 2, 6}) {
+    state->ApplyAction(action);
+    SPIEL_CHECK_EQ(state->HistoryString(),
+                   absl::StrJoin(state->History(), " "));
+    prefix_hashes.push_back(state->HistoryHash());
+    SPIEL_CHECK_NE(prefix_hashes.back(),
+                   prefix_hashes[prefix_hashes.size() - 2]);
+  }
+  // Clones carry the caches and extend them independently.
+  std::unique_ptr<State> clone = state->Clone();
+  SPIEL_CHECK_EQ(clone->HistoryHash(), state->HistoryHash());
+  clone->ApplyAction(1);
+  SPIEL_CHECK_EQ(clone->HistoryString(),
+                 absl::StrJoin(clone->History(), " "));
+  SPIEL_CHECK_NE(clone->HistoryHash(), state->HistoryHash());
+  // Undo truncates both string and hash back to the cached prefix.
+  state->UndoAction(Player{0}, 6);
+  SPIEL_CHECK_EQ(state->HistoryString(),
+                 absl::StrJoin(state->History(), " "));
+  SPIEL_CHECK_EQ(state->HistoryHash(), prefix_hashes[4]);
+  // Re-applying a different action after the undo diverges.
+  state->ApplyAction(7);
+  SPIEL_CHECK_EQ(state->HistoryString(),
+                 absl::StrJoin(state->History(), " "));
+  SPIEL_CHECK_NE(state->HistoryHash(), prefix_hashes[5]);
+  // The sibling-iteration pattern: undo, then apply a different action
+  // with no read in between. The caches end up at the same length as the
+  // stale tail, so the mutation-time truncation is the only thing standing
+  // between this read and the previous sibling's history.
+  std::unique_ptr<State> sibling = game->NewInitialState();
+  for (Action action : {4, 0, 8}) sibling->ApplyAction(action);
+  SPIEL_CHECK_EQ(sibling->HistoryString(), "4 0 8");
+  const uint64_t sibling_hash = sibling->HistoryHash();
+  sibling->UndoAction(Player{0}, 8);
+  sibling->ApplyAction(2);
+  SPIEL_CHECK_EQ(sibling->HistoryString(), "4 0 2");
+  SPIEL_CHECK_NE(sibling->HistoryHash(), sibling_hash);
+}
+
+void BatchedEnvironmentTest() {
+  // Step a batch of catch episodes to completion; chance nodes must be
+  // resolved internally and resets must restart terminal episodes only.
+  std::shared_ptr<const Game> game = LoadGame("catch");
+  const int batch_size = 4;
+  BatchedEnvironment env(game, batch_size, /*seed=*/1234);
+  const int obs_size = game->ObservationNormalizedVectorSize();
+  std::vector<double> obs(batch_size * obs_size);
+  std::vector<Action> actions(batch_size);
+  for (int step = 0; step < 3 * game->MaxGameLength(); ++step) {
+    env.FillObservations(obs.data(), obs_size);
+    for (int i = 0; i < batch_size; ++i) {
+      if (env.IsTerminal(i)) continue;
+      const State& state = env.GetState(i);
+      SPIEL_CHECK_FALSE(state.IsChanceNode());
+      // The filled row must match the state's own encoding.
+      std::vector<double> expected =
+          state.ObservationAsNormalizedVector(state.CurrentPlayer());
+      for (int j = 0; j < obs_size; ++j) {
+        SPIEL_CHECK_EQ(obs[i * obs_size + j], expected[j]);
+      }
+      actions[i] = state.LegalActions()[0];
+    }
+    env.StepAll(actions);
+    int num_terminal = 0;
+    for (int i = 0; i < batch_size; ++i) num_terminal += env.IsTerminal(i);
+    SPIEL_CHECK_EQ(env.ResetTerminals(), num_terminal);
+    for (int i = 0; i < batch_size; ++i) SPIEL_CHECK_FALSE(env.IsTerminal(i));
+  }
+}
+
+void StepFilterTest() {
+  // Filters compose in order added and must see the raw rewards and the
+  // freshly filled observation row.
+  std::shared_ptr<const Game> game = LoadGame("catch");
+  const int batch_size = 3;
+  BatchedEnvironment env(game, batch_size, /*seed=*/77);
+  // A step-cost penalty, then a doubling: together r -> 2 * (r - 0.25).
+  StepFilter penalty;
+  penalty.shape_rewards = [](const State&, std::vector<double>* rewards) {
+    for (double& r : *rewards) r -= 0.25;
+  };
+  StepFilter doubler;
+  doubler.shape_rewards = [](const State&, std::vector<double>* rewards) {
+    for (double& r : *rewards) r *= 2;
+  };
+  // Observation post-processing: flip the encoding to -1/+1.
+  doubler.postprocess_observation = [](const State&, double* row, int size) {
+    for (int j = 0; j < size; ++j) row[j] = 2 * row[j] - 1;
+  };
+  env.AddStepFilter(penalty);
+  env.AddStepFilter(doubler);
+
+  const int obs_size = game->ObservationNormalizedVectorSize();
+  std::vector<double> obs(batch_size * obs_size);
+  std::vector<double> rewards(batch_size * game->NumPlayers());
+  std::vector<Action> actions(batch_size, 0);
+  for (int step = 0; step < game->MaxGameLength(); ++step) {
+    env.FillObservations(obs.data(), obs_size);
+    for (int i = 0; i < batch_size; ++i) {
+      if (env.IsTerminal(i)) continue;
+      const State& state = env.GetState(i);
+      std::vector<double> expected =
+          state.ObservationAsNormalizedVector(state.CurrentPlayer());
+      for (int j = 0; j < obs_size; ++j) {
+        SPIEL_CHECK_EQ(obs[i * obs_size + j], 2 * expected[j] - 1);
+      }
+      actions[i] = state.LegalActions()[0];
+    }
+    env.StepAll(actions);
+    env.FillRewards(rewards.data(), game->NumPlayers());
+    for (int i = 0; i < batch_size; ++i) {
+      std::vector<double> raw = env.GetState(i).Rewards();
+      for (int p = 0; p < game->NumPlayers(); ++p) {
+        SPIEL_CHECK_EQ(rewards[i * game->NumPlayers() + p],
+                       2 * (raw[p] - 0.25));
+      }
+    }
+  }
+  // The fixed policy above cannot win catch from every start; just check
+  // every episode actually finished with a shaped terminal reward.
+  for (int i = 0; i < batch_size; ++i) {
+    SPIEL_CHECK_TRUE(env.IsTerminal(i));
+  }
+}
+
+// Steps a VectorizedGame in lockstep with real states of the same game,
+// checking players, masks, returns and observations at every step. Chance
+// (catch's ball column) is sampled inside the vectorized batch, so the
+// reference state is synced by trying each chance outcome until the
+// observations agree.
+void TestVectorizedAgainstGame(const std::string& game_name, int num_steps) {
+  const int kBatchSize = 5;
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::unique_ptr<VectorizedGame> vectorized =
+      VectorizedGame::Make(game_name, kBatchSize, /*seed=*/42);
+  SPIEL_CHECK_EQ(vectorized->BatchSize(), kBatchSize);
+  SPIEL_CHECK_EQ(vectorized->NumPlayers(), game->NumPlayers());
+  SPIEL_CHECK_EQ(vectorized->NumDistinctActions(), game->NumDistinctActions());
+
+  const int observation_size = vectorized->ObservationSize();
+  const bool use_observation =
+      game->GetType().provides_observation_as_normalized_vector;
+  std::vector<double> observations(kBatchSize * observation_size);
+  std::vector<int> masks(kBatchSize * game->NumDistinctActions());
+  std::vector<double> reference(observation_size);
+  auto fill_reference = [&](const State& state) {
+    if (use_observation) {
+      state.ObservationAsNormalizedVector(state.CurrentPlayer(),
+                                          reference.data());
+    } else {
+      state.InformationStateAsNormalizedVector(state.CurrentPlayer(),
+                                               reference.data());
+    }
+  };
+
+  std::vector<std::unique_ptr<State>> states(kBatchSize);
+  auto sync_episode = [&](int i) {
+    states[i] = game->NewInitialState();
+    if (!states[i]->IsChanceNode()) return;
+    vectorized->FillObservations(observations.data(), observation_size);
+    const double* row = observations.data() + i * observation_size;
+    for (Action outcome : states[i]->LegalActions()) {
+      std::unique_ptr<State> candidate = states[i]->Child(outcome);
+      fill_reference(*candidate);
+      if (std::equal(reference.begin(), reference.end(), row)) {
+        states[i] = std::move(candidate);
+        return;
+      }
+    }
+    SpielFatalError("No chance outcome matches the vectorized episode.");
+  };
+  for (int i = 0; i < kBatchSize; ++i) sync_episode(i);
+
+  std::mt19937 rng(1234);
+  std::vector<Action> actions(kBatchSize, 0);
+  for (int step = 0; step < num_steps; ++step) {
+    vectorized->FillObservations(observations.data(), observation_size);
+    vectorized->FillLegalMasks(masks.data(), game->NumDistinctActions());
+    for (int i = 0; i < kBatchSize; ++i) {
+      SPIEL_CHECK_EQ(vectorized->IsTerminal(i), states[i]->IsTerminal());
+      SPIEL_CHECK_EQ(vectorized->CurrentPlayer(i), states[i]->CurrentPlayer());
+      if (vectorized->IsTerminal(i)) {
+        for (Player p = 0; p < game->NumPlayers(); ++p) {
+          SPIEL_CHECK_EQ(vectorized->PlayerReturn(i, p),
+                         states[i]->PlayerReturn(p));
+        }
+        continue;
+      }
+      const std::vector<int> reference_mask = states[i]->LegalActionsMask();
+      for (int a = 0; a < game->NumDistinctActions(); ++a) {
+        SPIEL_CHECK_EQ(masks[i * game->NumDistinctActions() + a],
+                       reference_mask[a]);
+      }
+      fill_reference(*states[i]);
+      for (int v = 0; v < observation_size; ++v) {
+        SPIEL_CHECK_EQ(observations[i * observation_size + v], reference[v]);
+      }
+      const std::vector<Action> legal = states[i]->LegalActions();
+      actions[i] = legal[std::uniform_int_distribution<int>(
+          0, legal.size() - 1)(rng)];
+    }
+    vectorized->StepAll(actions);
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (states[i]->IsTerminal()) continue;
+      states[i]->ApplyAction(actions[i]);
+    }
+    // Keep episodes flowing: replace finished ones after a step, as a
+    // training loop would.
+    if (step % 3 == 2) {
+      std::vector<bool> was_terminal(kBatchSize);
+      for (int i = 0; i < kBatchSize; ++i) {
+        was_terminal[i] = vectorized->IsTerminal(i);
+      }
+      vectorized->ResetTerminals();
+      for (int i = 0; i < kBatchSize; ++i) {
+        if (was_terminal[i]) sync_episode(i);
+      }
+    }
+  }
+}
+
+// Lockstep check for the simultaneous-move grid games, which thread chance
+// nodes through every step (initiative order, action failure, respawn
+// points), all sampled inside the vectorized batch. After each joint action
+// the reference is re-synced by searching the pending chance outcome
+// sequences for decision nodes matching the episode on every player's
+// tensor and returns. The tensors do not expose all hidden state (a
+// laser_tag player tagged before its turn move resolves keeps its old
+// orientation, which only the grid string shows), so every matching node
+// is kept as a candidate and the set is narrowed by the following steps.
+void TestVectorizedSimMoveAgainstGame(const std::string& game_name,
+                                      int num_steps) {
+  const int kBatchSize = 4;
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::unique_ptr<VectorizedGame> vectorized =
+      VectorizedGame::Make(game_name, kBatchSize, /*seed=*/42);
+  const int num_players = game->NumPlayers();
+  SPIEL_CHECK_EQ(vectorized->ActionsPerEpisode(), num_players);
+  const int observation_size = vectorized->ObservationSize();
+  const bool use_observation =
+      game->GetType().provides_observation_as_normalized_vector;
+
+  // One observation batch per viewing player; the grid games' returns
+  // accumulate per-step rewards, so they are compared up to summation
+  // order.
+  std::vector<std::vector<double>> observations(
+      num_players, std::vector<double>(kBatchSize * observation_size));
+  std::vector<double> reference(observation_size);
+  auto fill_batches = [&]() {
+    for (Player p = 0; p < num_players; ++p) {
+      vectorized->FillObservations(observations[p].data(), observation_size,
+                                   p);
+    }
+  };
+  auto returns_match = [&](const State& state, int i) {
+    for (Player p = 0; p < num_players; ++p) {
+      if (std::abs(state.PlayerReturn(p) - vectorized->PlayerReturn(i, p)) >
+          1e-9) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto matches = [&](const State& state, int i) {
+    if (!returns_match(state, i)) return false;
+    if (state.IsTerminal() || vectorized->IsTerminal(i)) {
+      return state.IsTerminal() && vectorized->IsTerminal(i);
+    }
+    for (Player p = 0; p < num_players; ++p) {
+      if (use_observation) {
+        state.ObservationAsNormalizedVector(p, reference.data());
+      } else {
+        state.InformationStateAsNormalizedVector(p, reference.data());
+      }
+      if (!std::equal(reference.begin(), reference.end(),
+                      observations[p].data() + i * observation_size)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Depth-first search over the chance outcomes pending under `state`,
+  // collecting (deduplicated) successors matching episode i. Some chance
+  // outcomes are no-ops that leave the state at an identical chance node
+  // (laser_tag redraws a spawn corner that is occupied), so the search is
+  // capped at a depth no genuine outcome sequence reaches.
+  constexpr int kMaxChanceDepth = 8;
+  std::vector<std::vector<std::unique_ptr<State>>> states(kBatchSize);
+  std::function<void(const State&, int, int,
+                     std::vector<std::unique_ptr<State>>*,
+                     std::unordered_set<std::string>*)>
+      sync = [&](const State& state, int i, int depth,
+                 std::vector<std::unique_ptr<State>>* found,
+                 std::unordered_set<std::string>* seen) {
+        if (state.IsTerminal() || !state.IsChanceNode()) {
+          if (matches(state, i) && seen->insert(state.ToString()).second) {
+            found->push_back(state.Clone());
+          }
+          return;
+        }
+        if (depth >= kMaxChanceDepth) return;
+        for (Action outcome : state.LegalActions()) {
+          sync(*state.Child(outcome), i, depth + 1, found, seen);
+        }
+      };
+  auto resync = [&](const std::vector<std::unique_ptr<State>>& from, int i) {
+    std::vector<std::unique_ptr<State>> found;
+    std::unordered_set<std::string> seen;
+    for (const std::unique_ptr<State>& state : from) {
+      sync(*state, i, 0, &found, &seen);
+    }
+    if (found.empty()) {
+      SpielFatalError(absl::StrCat("No chance outcomes match the vectorized ",
+                                   game_name, " episode."));
+    }
+    states[i] = std::move(found);
+  };
+  auto resync_initial = [&](int i) {
+    std::vector<std::unique_ptr<State>> initial;
+    initial.push_back(game->NewInitialState());
+    resync(initial, i);
+  };
+  fill_batches();
+  for (int i = 0; i < kBatchSize; ++i) resync_initial(i);
+
+  std::mt19937 rng(1234);
+  // Sized off the vectorized game: laser_tag's Game understates
+  // NumDistinctActions() (5, for a 10-action movement set), and the mask
+  // rows cover the full set.
+  const int num_distinct_actions = vectorized->NumDistinctActions();
+  std::vector<int> masks(kBatchSize * num_distinct_actions);
+  std::vector<Action> actions(kBatchSize * num_players, 0);
+  for (int step = 0; step < num_steps; ++step) {
+    vectorized->FillLegalMasks(masks.data(), num_distinct_actions);
+    std::vector<bool> was_terminal(kBatchSize);
+    for (int i = 0; i < kBatchSize; ++i) {
+      was_terminal[i] = vectorized->IsTerminal(i);
+      // All candidates matched the episode's tensors and returns, so any
+      // of them can stand in for the per-step checks.
+      const State& representative = *states[i].front();
+      SPIEL_CHECK_EQ(vectorized->IsTerminal(i), representative.IsTerminal());
+      SPIEL_CHECK_EQ(vectorized->CurrentPlayer(i),
+                     representative.CurrentPlayer());
+      SPIEL_CHECK_TRUE(returns_match(representative, i));
+      if (was_terminal[i]) continue;
+      for (Player p = 0; p < num_players; ++p) {
+        std::vector<int> reference_mask(num_distinct_actions, 0);
+        const std::vector<Action> legal = representative.LegalActions(p);
+        for (Action action : legal) reference_mask[action] = 1;
+        for (int a = 0; a < num_distinct_actions; ++a) {
+          SPIEL_CHECK_EQ(masks[i * num_distinct_actions + a],
+                         reference_mask[a]);
+        }
+        actions[i * num_players + p] = legal[std::uniform_int_distribution<int>(
+            0, legal.size() - 1)(rng)];
+      }
+    }
+    vectorized->StepAll(actions);
+    fill_batches();
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (was_terminal[i]) continue;
+      std::vector<std::unique_ptr<State>> stepped = std::move(states[i]);
+      for (std::unique_ptr<State>& candidate : stepped) {
+        candidate->ApplyActions(std::vector<Action>(
+            actions.begin() + i * num_players,
+            actions.begin() + (i + 1) * num_players));
+      }
+      resync(stepped, i);
+    }
+    // Replace finished episodes every few steps, as a training loop would.
+    if (step % 5 == 4) {
+      for (int i = 0; i < kBatchSize; ++i) {
+        was_terminal[i] = vectorized->IsTerminal(i);
+      }
+      vectorized->ResetTerminals();
+      fill_batches();
+      for (int i = 0; i < kBatchSize; ++i) {
+        if (was_terminal[i]) resync_initial(i);
+      }
+    }
+  }
+}
+
+void VectorizedGameTest() {
+  TestVectorizedAgainstGame("tic_tac_toe", /*num_steps=*/60);
+  TestVectorizedAgainstGame("connect_four", /*num_steps=*/120);
+  TestVectorizedAgainstGame("catch", /*num_steps=*/60);
+  TestVectorizedSimMoveAgainstGame("markov_soccer", /*num_steps=*/80);
+  TestVectorizedSimMoveAgainstGame("laser_tag", /*num_steps=*/80);
+  TestVectorizedSimMoveAgainstGame("coop_box_pushing", /*num_steps=*/60);
+}
+
+void LoadGameCacheTest() {
+  // Repeated loads of one parameterization must share the same instance,
+  // however the load is spelled.
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  SPIEL_CHECK_TRUE(game == LoadGame("leduc_poker"));
+  SPIEL_CHECK_TRUE(game == LoadGame("leduc_poker", {}));
+  std::shared_ptr<const Game> three_player =
+      LoadGame("leduc_poker", {{"players", GameParameter(3)}});
+  SPIEL_CHECK_TRUE(game != three_player);
+  SPIEL_CHECK_TRUE(three_player == LoadGame("leduc_poker(players=3)"));
+}
+
+void BinarySerializationTest() {
+  // Binary round-trips must reproduce the state, matching the text form.
+  for (const std::string& game_name : {"tic_tac_toe", "leduc_poker"}) {
+    std::shared_ptr<const Game> game = LoadGame(game_name);
+    std::unique_ptr<State> state = game->NewInitialState();
+    std::vector<const State*> state_ptrs;
+    std::vector<std::unique_ptr<State>> stored;
+    while (!state->IsTerminal()) {
+      stored.push_back(state->Clone());
+      state_ptrs.push_back(stored.back().get());
+      std::unique_ptr<State> deserialized =
+          game->DeserializeStateBinary(state->SerializeBinary());
+      SPIEL_CHECK_EQ(deserialized->ToString(), state->ToString());
+      SPIEL_CHECK_TRUE(deserialized->History() == state->History());
+      state->ApplyAction(state->LegalActions()[0]);
+    }
+    // Bulk form: every record must round-trip in order.
+    std::vector<std::unique_ptr<State>> restored =
+        DeserializeStatesBinary(*game, SerializeStatesBinary(state_ptrs));
+    SPIEL_CHECK_EQ(restored.size(), stored.size());
+    for (int i = 0; i < restored.size(); ++i) {
+      SPIEL_CHECK_EQ(restored[i]->ToString(), stored[i]->ToString());
+    }
+  }
+}
+
 void LeducPokerDeserializeTest() {
   // Example Leduc state: player 1 gets the 0th card, player 2 gets the 3rd card
   // and the first two actions are: check, check.
@@ -265,6 +1328,74 @@ void GameParametersTest() {
   SPIEL_CHECK_EQ(game2.size(), 2);
   SPIEL_CHECK_EQ(game2["name"].string_value(), "nested2");
   SPIEL_CHECK_EQ(game2["param"].string_value(), "val");
+
+  // A repeated parse is served from the cache and must be identical.
+  auto reparsed = GameParametersFromString(
+      "game_four(str=strval,int=42,float=-1.2,game1=nested(),"
+      "game2=nested2(param=val),bool1=True,bool2=False)");
+  SPIEL_CHECK_EQ(reparsed.size(), params.size());
+  for (const auto& [key, value] : params) {
+    SPIEL_CHECK_EQ(reparsed[key].ToReprString(), value.ToReprString());
+  }
+}
+
+void TensorShapeTest() {
+  // Compile-time queries fold to constants.
+  using Shape = ObservationTensorTraits<tic_tac_toe::TicTacToeGame>::Shape;
+  static_assert(Shape::kRank == 3, "rank");
+  static_assert(Shape::kSize == tic_tac_toe::kCellStates *
+                                    tic_tac_toe::kNumRows *
+                                    tic_tac_toe::kNumCols,
+                "size");
+  static_assert(Shape::Stride(2) == 1, "stride");
+  static_assert(Shape::Stride(1) == tic_tac_toe::kNumCols, "stride");
+  static_assert(Shape::Stride(0) ==
+                    tic_tac_toe::kNumRows * tic_tac_toe::kNumCols,
+                "stride");
+  static_assert(Shape::Offset(1, 2, 1) == Shape::Stride(0) + 2 * 3 + 1,
+                "offset");
+
+  // The static shape and the virtual shape methods agree.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_TRUE(game->ObservationNormalizedVectorShape() ==
+                   Shape::AsVector());
+  SPIEL_CHECK_EQ(game->ObservationNormalizedVectorSize(), Shape::kSize);
+
+  // Stack-based encoding matches the heap-based path.
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+  TensorBuffer<Shape> buffer;
+  state->ObservationAsNormalizedVector(Player{0}, buffer.data);
+  std::vector<double> heap;
+  state->ObservationAsNormalizedVector(Player{0}, &heap);
+  SPIEL_CHECK_EQ(heap.size(), buffer.size());
+  for (int i = 0; i < buffer.size(); ++i) {
+    SPIEL_CHECK_EQ(heap[i], buffer.data[i]);
+  }
+}
+
+void MemoryAccountingTest() {
+  // The base estimate covers the object and the history bookkeeping, so it
+  // must be positive and grow as the history does.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  const int64_t initial = state->EstimatedMemory();
+  SPIEL_CHECK_GT(initial, 0);
+  state->ApplyAction(0);
+  state->ApplyAction(4);
+  SPIEL_CHECK_GE(state->EstimatedMemory(), initial);
+
+  // Catch overrides with a constant-size estimate.
+  std::unique_ptr<State> catch_state = LoadGame("catch")->NewInitialState();
+  SPIEL_CHECK_GT(catch_state->EstimatedMemory(), 0);
+
+  // Policy table accounting publishes into the always-on gauge.
+  TabularPolicy policy(*game);
+  const int64_t policy_bytes = policy.EstimatedMemory();
+  SPIEL_CHECK_GT(policy_bytes,
+                 static_cast<int64_t>(policy.PolicyTable().size()));
+  SPIEL_CHECK_EQ(stats::SnapshotGauges()[stats::kPolicyTableBytes],
+                 policy_bytes);
 }
 
 }  // namespace
@@ -275,8 +1406,33 @@ int main(int argc, char** argv) {
   open_spiel::testing::GeneralTests();
   open_spiel::testing::KuhnTests();
   open_spiel::testing::TicTacToeTests();
+  open_spiel::testing::ParallelRandomSimTests();
+  open_spiel::testing::StateArenaTest();
   open_spiel::testing::FlatJointactionTest();
   open_spiel::testing::PolicyTest();
+  open_spiel::testing::FlatTabularPolicyTest();
+  open_spiel::testing::MmapTabularPolicyTest();
+  open_spiel::testing::OverlayPolicyTest();
+  open_spiel::testing::PolicyExportImportTest();
+  open_spiel::testing::PolicyCheckpointStreamTest();
+  open_spiel::testing::SmallVectorTest();
+  open_spiel::testing::SplittableRandomTest();
+  open_spiel::testing::StringInternPoolTest();
+  open_spiel::testing::BoundedCacheTest();
+  open_spiel::testing::TaskPoolTest();
+  open_spiel::testing::SpscQueueTest();
+  open_spiel::testing::MpmcQueueTest();
+  open_spiel::testing::TimeBudgetTest();
+  open_spiel::testing::ActionHistoryTest();
+  open_spiel::testing::HistoryStringAndHashTest();
+  open_spiel::testing::CachedLegalActionsTest();
+  open_spiel::testing::BatchedEnvironmentTest();
+  open_spiel::testing::StepFilterTest();
+  open_spiel::testing::VectorizedGameTest();
+  open_spiel::testing::LoadGameCacheTest();
+  open_spiel::testing::BinarySerializationTest();
   open_spiel::testing::LeducPokerDeserializeTest();
   open_spiel::testing::GameParametersTest();
+  open_spiel::testing::TensorShapeTest();
+  open_spiel::testing::MemoryAccountingTest();
 }
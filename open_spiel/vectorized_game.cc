@@ -0,0 +1,957 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/vectorized_game.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "open_spiel/games/catch.h"
+#include "open_spiel/games/connect_four.h"
+#include "open_spiel/games/tic_tac_toe.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+VectorizedGame::VectorizedGame(int batch_size, int num_players,
+                               int num_distinct_actions, int observation_size,
+                               int seed)
+    : batch_size_(batch_size),
+      num_players_(num_players),
+      num_distinct_actions_(num_distinct_actions),
+      observation_size_(observation_size),
+      current_player_(batch_size, 0),
+      terminal_(batch_size, 0),
+      returns_(batch_size * num_players, 0.),
+      rng_(seed) {
+  SPIEL_CHECK_GT(batch_size, 0);
+}
+
+void VectorizedGame::StepAll(const std::vector<Action>& actions) {
+  SPIEL_CHECK_EQ(actions.size(), batch_size_ * actions_per_episode_);
+  StepAll(actions.data());
+}
+
+int VectorizedGame::ResetTerminals() {
+  int num_reset = 0;
+  for (int i = 0; i < batch_size_; ++i) {
+    if (terminal_[i] != 0) {
+      ResetEpisode(i);
+      ++num_reset;
+    }
+  }
+  return num_reset;
+}
+
+void VectorizedGame::ResetAll() {
+  for (int i = 0; i < batch_size_; ++i) ResetEpisode(i);
+}
+
+namespace {
+
+// Shared board-game scaffolding: marks are stored one byte per cell with
+// the same values as the games' CellState enums (0 empty, 1 nought for
+// player 1, 2 cross for player 0), so observation fill is a direct read
+// of the board into the matching one-hot plane.
+inline int8_t PlayerMark(Player player) { return player == 0 ? 2 : 1; }
+
+// All N boards live in one contiguous array of batch_size * num_cells
+// cells; episode i's board is the slice starting at i * num_cells.
+
+class VectorizedTicTacToe : public VectorizedGame {
+ public:
+  VectorizedTicTacToe(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/2,
+                       /*num_distinct_actions=*/tic_tac_toe::kNumCells,
+                       /*observation_size=*/tic_tac_toe::kNumCells *
+                           tic_tac_toe::kCellStates,
+                       seed),
+        boards_(batch_size * tic_tac_toe::kNumCells, 0),
+        cells_filled_(batch_size, 0) {
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      int8_t* board = &boards_[i * tic_tac_toe::kNumCells];
+      const Action cell = actions[i];
+      SPIEL_CHECK_EQ(board[cell], 0);
+      const Player player = current_player_[i];
+      const int8_t mark = PlayerMark(player);
+      board[cell] = mark;
+      ++cells_filled_[i];
+      if (HasLine(board, mark)) {
+        terminal_[i] = 1;
+        returns_[i * 2 + player] = 1.0;
+        returns_[i * 2 + (1 - player)] = -1.0;
+      } else if (cells_filled_[i] == tic_tac_toe::kNumCells) {
+        terminal_[i] = 1;  // Draw; returns stay zero.
+      } else {
+        current_player_[i] = 1 - player;
+      }
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      const int8_t* board = &boards_[i * tic_tac_toe::kNumCells];
+      for (int cell = 0; cell < tic_tac_toe::kNumCells; ++cell) {
+        mask[cell] = terminal_[i] == 0 && board[cell] == 0 ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      const int8_t* board = &boards_[i * tic_tac_toe::kNumCells];
+      for (int cell = 0; cell < tic_tac_toe::kNumCells; ++cell) {
+        values[tic_tac_toe::kNumCells * board[cell] + cell] = 1.0;
+      }
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    std::fill_n(&boards_[i * tic_tac_toe::kNumCells], tic_tac_toe::kNumCells,
+                0);
+    cells_filled_[i] = 0;
+    current_player_[i] = 0;
+    terminal_[i] = 0;
+    returns_[i * 2] = returns_[i * 2 + 1] = 0.;
+  }
+
+ private:
+  static bool HasLine(const int8_t* b, int8_t c) {
+    return (b[0] == c && b[1] == c && b[2] == c) ||
+           (b[3] == c && b[4] == c && b[5] == c) ||
+           (b[6] == c && b[7] == c && b[8] == c) ||
+           (b[0] == c && b[3] == c && b[6] == c) ||
+           (b[1] == c && b[4] == c && b[7] == c) ||
+           (b[2] == c && b[5] == c && b[8] == c) ||
+           (b[0] == c && b[4] == c && b[8] == c) ||
+           (b[2] == c && b[4] == c && b[6] == c);
+  }
+
+  std::vector<int8_t> boards_;
+  std::vector<int8_t> cells_filled_;
+};
+
+class VectorizedConnectFour : public VectorizedGame {
+ public:
+  VectorizedConnectFour(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/2,
+                       /*num_distinct_actions=*/connect_four::kCols,
+                       /*observation_size=*/connect_four::kNumCells *
+                           connect_four::kCellStates,
+                       seed),
+        boards_(batch_size * connect_four::kNumCells, 0),
+        heights_(batch_size * connect_four::kCols, 0) {
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      int8_t* board = &boards_[i * connect_four::kNumCells];
+      int8_t* heights = &heights_[i * connect_four::kCols];
+      const int col = actions[i];
+      const int row = heights[col];
+      SPIEL_CHECK_LT(row, connect_four::kRows);
+      const Player player = current_player_[i];
+      const int8_t mark = PlayerMark(player);
+      board[row * connect_four::kCols + col] = mark;
+      ++heights[col];
+      if (HasLineFrom(board, row, col, mark)) {
+        terminal_[i] = 1;
+        returns_[i * 2 + player] = 1.0;
+        returns_[i * 2 + (1 - player)] = -1.0;
+      } else if (IsFull(heights)) {
+        terminal_[i] = 1;  // Draw; returns stay zero.
+      } else {
+        current_player_[i] = 1 - player;
+      }
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      const int8_t* heights = &heights_[i * connect_four::kCols];
+      for (int col = 0; col < connect_four::kCols; ++col) {
+        mask[col] =
+            terminal_[i] == 0 && heights[col] < connect_four::kRows ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      const int8_t* board = &boards_[i * connect_four::kNumCells];
+      for (int cell = 0; cell < connect_four::kNumCells; ++cell) {
+        values[connect_four::kNumCells * board[cell] + cell] = 1.0;
+      }
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    std::fill_n(&boards_[i * connect_four::kNumCells], connect_four::kNumCells,
+                0);
+    std::fill_n(&heights_[i * connect_four::kCols], connect_four::kCols, 0);
+    current_player_[i] = 0;
+    terminal_[i] = 0;
+    returns_[i * 2] = returns_[i * 2 + 1] = 0.;
+  }
+
+ private:
+  // Counts the run through the just-placed stone along each of the four
+  // directions; only lines through that stone can be new.
+  static bool HasLineFrom(const int8_t* board, int row, int col, int8_t mark) {
+    static constexpr int kDirections[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& direction : kDirections) {
+      int run = 1;
+      for (int sign : {1, -1}) {
+        int r = row + sign * direction[0];
+        int c = col + sign * direction[1];
+        while (r >= 0 && r < connect_four::kRows && c >= 0 &&
+               c < connect_four::kCols &&
+               board[r * connect_four::kCols + c] == mark) {
+          ++run;
+          r += sign * direction[0];
+          c += sign * direction[1];
+        }
+      }
+      if (run >= 4) return true;
+    }
+    return false;
+  }
+
+  static bool IsFull(const int8_t* heights) {
+    for (int col = 0; col < connect_four::kCols; ++col) {
+      if (heights[col] < connect_four::kRows) return false;
+    }
+    return true;
+  }
+
+  std::vector<int8_t> boards_;
+  std::vector<int8_t> heights_;  // Stones per column, batch_size * kCols.
+};
+
+class VectorizedCatch : public VectorizedGame {
+ public:
+  VectorizedCatch(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/1,
+                       /*num_distinct_actions=*/catch_::kNumActions,
+                       /*observation_size=*/catch_::kDefaultRows *
+                           catch_::kDefaultColumns,
+                       seed),
+        ball_row_(batch_size, 0),
+        ball_col_(batch_size, 0),
+        paddle_col_(batch_size, 0) {
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      ++ball_row_[i];
+      const int direction = static_cast<int>(actions[i]) - 1;
+      paddle_col_[i] = std::min(
+          std::max(paddle_col_[i] + direction, 0), catch_::kDefaultColumns - 1);
+      if (ball_row_[i] >= catch_::kDefaultRows - 1) {
+        terminal_[i] = 1;
+        returns_[i] = ball_col_[i] == paddle_col_[i] ? 1.0 : -1.0;
+      }
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      for (int action = 0; action < catch_::kNumActions; ++action) {
+        mask[action] = terminal_[i] == 0 ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      values[ball_row_[i] * catch_::kDefaultColumns + ball_col_[i]] = 1.0;
+      values[(catch_::kDefaultRows - 1) * catch_::kDefaultColumns +
+             paddle_col_[i]] = 1.0;
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    // The initial chance node (the ball's column) is sampled here, so
+    // every exposed episode is at a decision node.
+    ball_row_[i] = 0;
+    ball_col_[i] = std::uniform_int_distribution<int>(
+        0, catch_::kDefaultColumns - 1)(rng_);
+    paddle_col_[i] = catch_::kDefaultColumns / 2;
+    current_player_[i] = 0;
+    terminal_[i] = 0;
+    returns_[i] = 0.;
+  }
+
+ private:
+  std::vector<int> ball_row_;
+  std::vector<int> ball_col_;
+  std::vector<int> paddle_col_;
+};
+
+// Simultaneous-move grid games. Their board constants live in the game
+// translation units' anonymous namespaces, so the rules are restated here;
+// cells are stored as the games' observation plane indices, making the
+// observation fill a direct scatter of the board and keeping the conflict
+// resolution free of character dispatch. The per-step chance nodes of the
+// State implementations (initiative order, action failure, spawn points)
+// are sampled inline, so every exposed episode is at a joint decision node.
+
+class VectorizedMarkovSoccer : public VectorizedGame {
+ public:
+  // Cells hold the game's observation planes directly.
+  enum Cell : int8_t {
+    kAgentA = 0,      // 'a': A without the ball.
+    kAgentABall = 1,  // 'A'.
+    kAgentB = 2,      // 'b': B without the ball.
+    kAgentBBall = 3,  // 'B'.
+    kBall = 4,        // 'O'.
+    kEmpty = 5,       // '.'.
+  };
+
+  static constexpr int kRows = 4;
+  static constexpr int kCols = 5;
+  static constexpr int kNumCells = kRows * kCols;
+  static constexpr int kCellStates = 6;
+  static constexpr int kNumActions = 5;  // up, down, left, right, stand.
+  static constexpr int kDefaultHorizon = 1000;
+
+  VectorizedMarkovSoccer(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/2,
+                       /*num_distinct_actions=*/kNumActions,
+                       /*observation_size=*/kNumCells * kCellStates, seed),
+        grids_(batch_size * kNumCells, kEmpty),
+        rows_(batch_size * 2, 0),
+        cols_(batch_size * 2, 0),
+        total_moves_(batch_size, 0) {
+    actions_per_episode_ = 2;
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      const Action* moves = actions + i * 2;
+      int8_t* grid = &grids_[i * kNumCells];
+      int winner = kInvalidPlayer;
+      // The initiative chance node: which player's move resolves first.
+      const int first = std::uniform_int_distribution<int>(0, 1)(rng_);
+      ResolveMove(grid, &rows_[i * 2], &cols_[i * 2], first, moves[first],
+                  &winner);
+      ResolveMove(grid, &rows_[i * 2], &cols_[i * 2], 1 - first,
+                  moves[1 - first], &winner);
+      ++total_moves_[i];
+      if (total_moves_[i] >= kDefaultHorizon) {
+        // A draw, even over a goal on the same move: the game's Returns
+        // checks the horizon first.
+        terminal_[i] = 1;
+      } else if (winner != kInvalidPlayer) {
+        terminal_[i] = 1;
+        returns_[i * 2 + winner] = 1.0;
+        returns_[i * 2 + (1 - winner)] = -1.0;
+      }
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      for (int action = 0; action < kNumActions; ++action) {
+        mask[action] = terminal_[i] == 0 ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      const int8_t* grid = &grids_[i * kNumCells];
+      for (int cell = 0; cell < kNumCells; ++cell) {
+        values[grid[cell] * kNumCells + cell] = 1.0;
+      }
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    int8_t* grid = &grids_[i * kNumCells];
+    std::fill_n(grid, kNumCells, static_cast<int8_t>(kEmpty));
+    grid[2 * kCols + 1] = kAgentA;
+    rows_[i * 2] = 2;
+    cols_[i * 2] = 1;
+    grid[1 * kCols + 3] = kAgentB;
+    rows_[i * 2 + 1] = 1;
+    cols_[i * 2 + 1] = 3;
+    // The initial chance node: the ball starts at (1,2) or (2,2). Placing
+    // it counts as a move, as in the State implementation.
+    const int ball_row = 1 + std::uniform_int_distribution<int>(0, 1)(rng_);
+    grid[ball_row * kCols + 2] = kBall;
+    total_moves_[i] = 1;
+    current_player_[i] = kSimultaneousPlayerId;
+    terminal_[i] = 0;
+    returns_[i * 2] = returns_[i * 2 + 1] = 0.;
+  }
+
+ private:
+  static bool InBounds(int r, int c) {
+    return r >= 0 && c >= 0 && r < kRows && c < kCols;
+  }
+
+  static void ResolveMove(int8_t* grid, int* rows, int* cols, int player,
+                          int move, int* winner) {
+    static constexpr int kRowOffsets[kNumActions] = {-1, 1, 0, 0, 0};
+    static constexpr int kColOffsets[kNumActions] = {0, 0, -1, 1, 0};
+    const int old_row = rows[player];
+    const int old_col = cols[player];
+    const int new_row = old_row + kRowOffsets[move];
+    const int new_col = old_col + kColOffsets[move];
+    const int8_t from = grid[old_row * kCols + old_col];
+
+    if (!InBounds(new_row, new_col)) {
+      // Carrying the ball over the opponent's edge through the goal rows
+      // scores; any other out-of-bounds move does nothing.
+      if (from == kAgentABall && (new_row == 1 || new_row == 2) &&
+          new_col == kCols) {
+        grid[old_row * kCols + old_col] = kEmpty;
+        *winner = 0;
+      } else if (from == kAgentBBall && (new_row == 1 || new_row == 2) &&
+                 new_col == -1) {
+        grid[old_row * kCols + old_col] = kEmpty;
+        *winner = 1;
+      }
+      return;
+    }
+    if (new_row == old_row && new_col == old_col) return;  // Stand.
+
+    const int8_t to = grid[new_row * kCols + new_col];
+    if (to == kEmpty) {
+      grid[new_row * kCols + new_col] = from;
+      grid[old_row * kCols + old_col] = kEmpty;
+      rows[player] = new_row;
+      cols[player] = new_col;
+    } else if (to == kBall) {
+      grid[new_row * kCols + new_col] =
+          from == kAgentA ? kAgentABall : kAgentBBall;
+      grid[old_row * kCols + old_col] = kEmpty;
+      rows[player] = new_row;
+      cols[player] = new_col;
+    } else if (from == kAgentABall && to == kAgentB) {
+      // Running into the defender loses possession; nobody moves.
+      grid[old_row * kCols + old_col] = kAgentA;
+      grid[new_row * kCols + new_col] = kAgentBBall;
+    } else if (from == kAgentBBall && to == kAgentA) {
+      grid[old_row * kCols + old_col] = kAgentB;
+      grid[new_row * kCols + new_col] = kAgentABall;
+    }
+    // Moving onto the opponent without the ball changing hands: blocked.
+  }
+
+  std::vector<int8_t> grids_;
+  std::vector<int> rows_;  // batch_size * 2, per-player positions.
+  std::vector<int> cols_;
+  std::vector<int> total_moves_;
+};
+
+class VectorizedLaserTag : public VectorizedGame {
+ public:
+  enum Cell : int8_t {
+    kAgentA = 0,
+    kAgentB = 1,
+    kEmpty = 2,
+    kObstacle = 3,
+  };
+
+  static constexpr int kRows = 7;
+  static constexpr int kCols = 7;
+  static constexpr int kNumCells = kRows * kCols;
+  static constexpr int kCellStates = 4;
+  static constexpr int kNumActions = 10;
+  static constexpr int kDefaultHorizon = 1000;
+  static constexpr bool kDefaultZeroSum = false;
+
+  VectorizedLaserTag(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/2,
+                       /*num_distinct_actions=*/kNumActions,
+                       /*observation_size=*/kNumCells * kCellStates, seed),
+        grids_(batch_size * kNumCells, kEmpty),
+        rows_(batch_size * 2, 0),
+        cols_(batch_size * 2, 0),
+        facing_(batch_size * 2, kSouth),
+        total_moves_(batch_size, 0) {
+    actions_per_episode_ = 2;
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      const Action* moves = actions + i * 2;
+      int8_t* grid = &grids_[i * kNumCells];
+      int* rows = &rows_[i * 2];
+      int* cols = &cols_[i * 2];
+      int8_t* facing = &facing_[i * 2];
+      double rewards[2] = {0, 0};
+      // The initiative chance node; if the first move tags, the second
+      // player's move is dropped.
+      const int first = std::uniform_int_distribution<int>(0, 1)(rng_);
+      int tagged = kInvalidPlayer;
+      if (ResolveMove(grid, rows, cols, facing, first, moves[first],
+                      rewards)) {
+        tagged = 1 - first;
+      } else if (ResolveMove(grid, rows, cols, facing, 1 - first,
+                             moves[1 - first], rewards)) {
+        tagged = first;
+      }
+      returns_[i * 2] += rewards[0];
+      returns_[i * 2 + 1] += rewards[1];
+      ++total_moves_[i];
+      if (total_moves_[i] >= kDefaultHorizon) {
+        terminal_[i] = 1;
+      } else if (tagged != kInvalidPlayer) {
+        Spawn(grid, rows, cols, tagged);
+      }
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      for (int action = 0; action < kNumActions; ++action) {
+        mask[action] = terminal_[i] == 0 ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      const int8_t* grid = &grids_[i * kNumCells];
+      for (int cell = 0; cell < kNumCells; ++cell) {
+        values[grid[cell] * kNumCells + cell] = 1.0;
+      }
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    int8_t* grid = &grids_[i * kNumCells];
+    std::fill_n(grid, kNumCells, static_cast<int8_t>(kEmpty));
+    for (const int cell : {2 * kCols + 2, 3 * kCols + 2, 4 * kCols + 2,
+                           3 * kCols + 1, 2 * kCols + 4, 3 * kCols + 4,
+                           4 * kCols + 4, 3 * kCols + 5}) {
+      grid[cell] = kObstacle;
+    }
+    facing_[i * 2] = facing_[i * 2 + 1] = kSouth;
+    // Both players spawn from the corner chance nodes, B first as in the
+    // State implementation's respawn stack.
+    Spawn(grid, &rows_[i * 2], &cols_[i * 2], 1);
+    Spawn(grid, &rows_[i * 2], &cols_[i * 2], 0);
+    total_moves_[i] = 0;
+    current_player_[i] = kSimultaneousPlayerId;
+    terminal_[i] = 0;
+    returns_[i * 2] = returns_[i * 2 + 1] = 0.;
+  }
+
+ private:
+  enum Move {
+    kLeftTurn = 0,
+    kRightTurn = 1,
+    kForwardMove = 2,
+    kBackwardMove = 3,
+    kStepLeft = 4,
+    kStepRight = 5,
+    kStand = 6,
+    kForwardLeft = 7,
+    kForwardRight = 8,
+    kFire = 9,
+  };
+  enum Orientation { kNorth = 0, kSouth = 1, kEast = 2, kWest = 3 };
+
+  static bool InBounds(int r, int c) {
+    return r >= 0 && c >= 0 && r < kRows && c < kCols;
+  }
+
+  // Draws one of the four corners until a free one comes up, exactly the
+  // State implementation's occupied-corner chance no-op and redraw.
+  void Spawn(int8_t* grid, int* rows, int* cols, int player) {
+    static constexpr int kCorners[4][2] = {
+        {0, 0}, {0, kCols - 1}, {kRows - 1, 0}, {kRows - 1, kCols - 1}};
+    for (;;) {
+      const int corner = std::uniform_int_distribution<int>(0, 3)(rng_);
+      const int r = kCorners[corner][0];
+      const int c = kCorners[corner][1];
+      if (grid[r * kCols + c] != kEmpty) continue;
+      grid[r * kCols + c] = player == 0 ? kAgentA : kAgentB;
+      rows[player] = r;
+      cols[player] = c;
+      return;
+    }
+  }
+
+  // Returns true if the move tagged the opponent.
+  static bool ResolveMove(int8_t* grid, int* rows, int* cols, int8_t* facing,
+                          int player, int move, double* rewards) {
+    // Row/column deltas per orientation and move, as in the game.
+    static constexpr int kRowOffsets[4][kNumActions] = {
+        {0, 0, -1, 1, 0, 0, 0, -1, -1, 0},
+        {0, 0, 1, -1, 0, 0, 0, 1, 1, 0},
+        {0, 0, 0, 0, -1, 1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 1, -1, 0, 0, 0, 0}};
+    static constexpr int kColOffsets[4][kNumActions] = {
+        {0, 0, 0, 0, -1, 1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 1, -1, 0, 0, 0, 0},
+        {0, 0, 1, -1, 0, 0, 0, 1, 1, 0},
+        {0, 0, -1, 1, 0, 0, 0, -1, -1, 0}};
+    static constexpr int8_t kLeftOf[4] = {kWest, kEast, kNorth, kSouth};
+    static constexpr int8_t kRightOf[4] = {kEast, kWest, kSouth, kNorth};
+    static constexpr int kRayRow[4] = {-1, 1, 0, 0};
+    static constexpr int kRayCol[4] = {0, 0, 1, -1};
+
+    const int old_row = rows[player];
+    const int old_col = cols[player];
+    const int orientation = facing[player];
+    const int new_row = old_row + kRowOffsets[orientation][move];
+    const int new_col = old_col + kColOffsets[orientation][move];
+    if (!InBounds(new_row, new_col)) return false;
+
+    if (move == kLeftTurn) {
+      facing[player] = kLeftOf[orientation];
+    } else if (move == kRightTurn) {
+      facing[player] = kRightOf[orientation];
+    } else if (move == kForwardMove || move == kBackwardMove ||
+               move == kStepLeft || move == kForwardLeft ||
+               move == kForwardRight) {
+      // kStepRight is a no-op here, matching the game's ResolveMove.
+      if (grid[new_row * kCols + new_col] == kEmpty) {
+        grid[new_row * kCols + new_col] = grid[old_row * kCols + old_col];
+        grid[old_row * kCols + old_col] = kEmpty;
+        rows[player] = new_row;
+        cols[player] = new_col;
+        if (move == kForwardLeft) {
+          facing[player] = kLeftOf[orientation];
+        } else if (move == kForwardRight) {
+          facing[player] = kRightOf[orientation];
+        }
+      }
+    } else if (move == kFire) {
+      int r = old_row + kRayRow[orientation];
+      int c = old_col + kRayCol[orientation];
+      while (InBounds(r, c)) {
+        const int8_t hit = grid[r * kCols + c];
+        if (hit == kObstacle) return false;
+        if (hit == kAgentA || hit == kAgentB) {
+          const int got_tagged = hit == kAgentA ? 0 : 1;
+          grid[r * kCols + c] = kEmpty;
+          rows[got_tagged] = -1;
+          cols[got_tagged] = -1;
+          rewards[player] += 1;
+          if (kDefaultZeroSum) rewards[got_tagged] -= 1;
+          return true;
+        }
+        r += kRayRow[orientation];
+        c += kRayCol[orientation];
+      }
+    }
+    return false;
+  }
+
+  std::vector<int8_t> grids_;
+  std::vector<int> rows_;
+  std::vector<int> cols_;
+  std::vector<int8_t> facing_;
+  std::vector<int> total_moves_;
+};
+
+class VectorizedCoopBoxPushing : public VectorizedGame {
+ public:
+  // Field cells hold the viewer-independent observation planes; player
+  // cells are tracked separately since their planes depend on the viewer.
+  enum Cell : int8_t {
+    kFieldCell = 0,
+    kSmallBox = 1,
+    kBigBox = 2,
+    kPlayer0 = 3,
+    kPlayer1 = 4,
+  };
+
+  static constexpr int kRows = 8;
+  static constexpr int kCols = 8;
+  static constexpr int kNumCells = kRows * kCols;
+  static constexpr int kCellStates = 11;
+  static constexpr int kNumActions = 4;  // turn left/right, forward, stay.
+  static constexpr int kDefaultHorizon = 100;
+
+  static constexpr double kBumpPenalty = -5;
+  static constexpr double kDelayPenalty = -0.1;
+  static constexpr double kSmallBoxReward = 10;
+  static constexpr double kBigBoxReward = 100;
+
+  VectorizedCoopBoxPushing(int batch_size, int seed)
+      : VectorizedGame(batch_size, /*num_players=*/2,
+                       /*num_distinct_actions=*/kNumActions,
+                       /*observation_size=*/kNumCells * kCellStates, seed),
+        grids_(batch_size * kNumCells, kFieldCell),
+        rows_(batch_size * 2, 0),
+        cols_(batch_size * 2, 0),
+        facing_(batch_size * 2, kNorth),
+        total_moves_(batch_size, 0) {
+    actions_per_episode_ = 2;
+    ResetAll();
+  }
+
+  void StepAll(const Action* actions) override {
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      const Action* moves = actions + i * 2;
+      int8_t* grid = &grids_[i * kNumCells];
+      int* rows = &rows_[i * 2];
+      int* cols = &cols_[i * 2];
+      int8_t* facing = &facing_[i * 2];
+      // The three chance nodes of a step: each player's action succeeds
+      // with probability 0.9, and initiative decides resolution order.
+      bool success[2];
+      for (int p = 0; p < 2; ++p) {
+        success[p] =
+            std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < 0.9;
+      }
+      const int initiative = std::uniform_int_distribution<int>(0, 1)(rng_);
+      double reward = 0;
+
+      // A joint successful forward push moves the big box. Only the
+      // winning push ends the step here; a non-winning push still falls
+      // through to the independent resolution below (where each player's
+      // forward move now bumps into the pushed box), as in the State
+      // implementation.
+      if (moves[0] == kMoveForward && moves[1] == kMoveForward && success[0] &&
+          success[1] && TryPushBigBox(grid, rows, cols, facing, &reward)) {
+        // A win skips the delay penalty and the move count; the episode
+        // is over regardless.
+        returns_[i * 2] += reward;
+        returns_[i * 2 + 1] += reward;
+        terminal_[i] = 1;
+        continue;
+      }
+
+      for (int turn = 0; turn < 2; ++turn) {
+        const int p = (turn + initiative) % 2;
+        if (!success[p] || moves[p] == kStay) continue;
+        if (moves[p] == kTurnLeft || moves[p] == kTurnRight) {
+          facing[p] = Rotate(facing[p], moves[p]);
+        } else if (moves[p] == kMoveForward) {
+          MoveForward(grid, rows, cols, facing, p, &reward);
+        }
+      }
+      reward += kDelayPenalty;
+      returns_[i * 2] += reward;
+      returns_[i * 2 + 1] += reward;
+      if (++total_moves_[i] >= kDefaultHorizon) terminal_[i] = 1;
+    }
+  }
+
+  void FillLegalMasks(int* buffer, int stride) const override {
+    for (int i = 0; i < batch_size_; ++i) {
+      int* mask = buffer + i * stride;
+      for (int action = 0; action < kNumActions; ++action) {
+        mask[action] = terminal_[i] == 0 ? 1 : 0;
+      }
+    }
+  }
+
+  void FillObservations(double* buffer, int stride) const override {
+    FillObservations(buffer, stride, Player{0});
+  }
+
+  void FillObservations(double* buffer, int stride,
+                        Player player) const override {
+    // Plane of a player cell by orientation, for the viewer themselves;
+    // the other player's plane is one higher.
+    static constexpr int kSelfPlane[4] = {7, 5, 9, 3};  // N, E, S, W.
+    for (int i = 0; i < batch_size_; ++i) {
+      if (terminal_[i] != 0) continue;
+      double* values = buffer + i * stride;
+      std::fill(values, values + observation_size_, 0.);
+      const int8_t* grid = &grids_[i * kNumCells];
+      const int8_t* facing = &facing_[i * 2];
+      for (int cell = 0; cell < kNumCells; ++cell) {
+        int plane = grid[cell];
+        if (plane >= kPlayer0) {
+          const int p = plane - kPlayer0;
+          plane = kSelfPlane[facing[p]] + (p == player ? 0 : 1);
+        }
+        values[plane * kNumCells + cell] = 1.0;
+      }
+    }
+  }
+
+ protected:
+  void ResetEpisode(int i) override {
+    int8_t* grid = &grids_[i * kNumCells];
+    std::fill_n(grid, kNumCells, static_cast<int8_t>(kFieldCell));
+    grid[3 * kCols + 1] = kSmallBox;
+    grid[3 * kCols + 6] = kSmallBox;
+    grid[3 * kCols + 3] = kBigBox;
+    grid[3 * kCols + 4] = kBigBox;
+    grid[6 * kCols + 1] = kPlayer0;
+    rows_[i * 2] = 6;
+    cols_[i * 2] = 1;
+    facing_[i * 2] = kEast;
+    grid[6 * kCols + 6] = kPlayer1;
+    rows_[i * 2 + 1] = 6;
+    cols_[i * 2 + 1] = 6;
+    facing_[i * 2 + 1] = kWest;
+    total_moves_[i] = 0;
+    current_player_[i] = kSimultaneousPlayerId;
+    terminal_[i] = 0;
+    returns_[i * 2] = returns_[i * 2 + 1] = 0.;
+  }
+
+ private:
+  enum Move { kTurnLeft = 0, kTurnRight = 1, kMoveForward = 2, kStay = 3 };
+  enum Orientation { kNorth = 0, kEast = 1, kSouth = 2, kWest = 3 };
+  static constexpr int kRowOffsets[4] = {-1, 0, 1, 0};
+  static constexpr int kColOffsets[4] = {0, 1, 0, -1};
+
+  static bool InBounds(int r, int c) {
+    return r >= 0 && c >= 0 && r < kRows && c < kCols;
+  }
+
+  static int8_t Rotate(int8_t orientation, int move) {
+    if (move == kTurnLeft) {
+      return orientation == 0 ? 3 : orientation - 1;
+    }
+    return orientation == 3 ? 0 : orientation + 1;
+  }
+
+  // The joint big-box push; returns true only on the winning push to the
+  // goal row (any other outcome falls through to independent resolution).
+  static bool TryPushBigBox(int8_t* grid, int* rows, int* cols,
+                            const int8_t* facing, double* reward) {
+    int next_r[2], next_c[2], next_next_r[2], next_next_c[2];
+    for (int p = 0; p < 2; ++p) {
+      next_r[p] = rows[p] + kRowOffsets[facing[p]];
+      next_c[p] = cols[p] + kColOffsets[facing[p]];
+      next_next_r[p] = next_r[p] + kRowOffsets[facing[p]];
+      next_next_c[p] = next_c[p] + kColOffsets[facing[p]];
+      if (!InBounds(next_r[p], next_c[p]) ||
+          !InBounds(next_next_r[p], next_next_c[p]) ||
+          grid[next_r[p] * kCols + next_c[p]] != kBigBox ||
+          grid[next_next_r[p] * kCols + next_next_c[p]] != kFieldCell) {
+        return false;
+      }
+    }
+    for (int p = 0; p < 2; ++p) {
+      grid[next_next_r[p] * kCols + next_next_c[p]] = kBigBox;
+      grid[rows[p] * kCols + cols[p]] = kFieldCell;
+      grid[next_r[p] * kCols + next_c[p]] = p == 0 ? kPlayer0 : kPlayer1;
+      rows[p] = next_r[p];
+      cols[p] = next_c[p];
+    }
+    if (next_next_r[0] == 0 && next_r[0] != 0) {
+      *reward += kBigBoxReward;
+      return true;
+    }
+    return false;
+  }
+
+  static void MoveForward(int8_t* grid, int* rows, int* cols,
+                          const int8_t* facing, int p, double* reward) {
+    const int dir = facing[p];
+    const int next_r = rows[p] + kRowOffsets[dir];
+    const int next_c = cols[p] + kColOffsets[dir];
+    if (!InBounds(next_r, next_c)) {
+      *reward += kBumpPenalty;
+      return;
+    }
+    const int8_t next = grid[next_r * kCols + next_c];
+    if (next == kFieldCell) {
+      grid[rows[p] * kCols + cols[p]] = kFieldCell;
+      grid[next_r * kCols + next_c] = p == 0 ? kPlayer0 : kPlayer1;
+      rows[p] = next_r;
+      cols[p] = next_c;
+    } else if (next == kSmallBox) {
+      const int next_next_r = next_r + kRowOffsets[dir];
+      const int next_next_c = next_c + kColOffsets[dir];
+      if (!InBounds(next_next_r, next_next_c)) {
+        *reward += kBumpPenalty;
+      } else if (grid[next_next_r * kCols + next_next_c] == kFieldCell) {
+        grid[next_next_r * kCols + next_next_c] = kSmallBox;
+        grid[rows[p] * kCols + cols[p]] = kFieldCell;
+        grid[next_r * kCols + next_c] = p == 0 ? kPlayer0 : kPlayer1;
+        rows[p] = next_r;
+        cols[p] = next_c;
+        if (next_next_r == 0 && next_r != 0) *reward += kSmallBoxReward;
+      } else {
+        *reward += kBumpPenalty;
+      }
+    } else {
+      *reward += kBumpPenalty;
+    }
+  }
+
+  std::vector<int8_t> grids_;
+  std::vector<int> rows_;
+  std::vector<int> cols_;
+  std::vector<int8_t> facing_;
+  std::vector<int> total_moves_;
+};
+
+}  // namespace
+
+std::unique_ptr<VectorizedGame> VectorizedGame::Make(
+    const std::string& short_name, int batch_size, int seed) {
+  if (short_name == "tic_tac_toe") {
+    return std::make_unique<VectorizedTicTacToe>(batch_size, seed);
+  } else if (short_name == "connect_four") {
+    return std::make_unique<VectorizedConnectFour>(batch_size, seed);
+  } else if (short_name == "catch") {
+    return std::make_unique<VectorizedCatch>(batch_size, seed);
+  } else if (short_name == "markov_soccer") {
+    return std::make_unique<VectorizedMarkovSoccer>(batch_size, seed);
+  } else if (short_name == "laser_tag") {
+    return std::make_unique<VectorizedLaserTag>(batch_size, seed);
+  } else if (short_name == "coop_box_pushing") {
+    return std::make_unique<VectorizedCoopBoxPushing>(batch_size, seed);
+  }
+  SpielFatalError(
+      absl::StrCat("VectorizedGame does not support game '", short_name, "'."));
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,145 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_VECTORIZED_GAME_H_
+#define THIRD_PARTY_OPEN_SPIEL_VECTORIZED_GAME_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+
+// Structure-of-arrays episode batches for small fixed-size games.
+//
+// BatchedEnvironment steps a batch of State objects, paying virtual
+// dispatch and a heap-allocated State per episode; for the tiny games that
+// dominate RL training runs that overhead is most of the work.
+// VectorizedGame reimplements just the transition, legal-mask and
+// observation rules of selected games over contiguous arrays holding every
+// episode's board side by side, so stepping the whole batch is one tight
+// loop with no virtual calls inside it and no per-episode allocation.
+//
+// The stepping contract mirrors BatchedEnvironment: chance is resolved
+// internally by sampling (catch's initial ball drop, the grid games'
+// initiative order), actions supplied for terminal episodes are ignored,
+// and terminal episodes are replaced with fresh ones by ResetTerminals.
+// Players, masks, returns and observation tensors match the corresponding
+// State implementations exactly; the tests step a batch in lockstep with
+// real states to hold the two together.
+//
+// Simultaneous-move games (ActionsPerEpisode() > 1) take one action per
+// player per episode: StepAll expects batch_size * NumPlayers() entries,
+// episode-major, so episode i's joint action is actions[i * NumPlayers()]
+// through actions[i * NumPlayers() + NumPlayers() - 1]. Every exposed
+// episode sits at a joint decision node; the chance nodes these games
+// thread between moves (initiative order, action failure, spawn points)
+// are sampled inside StepAll.
+class VectorizedGame {
+ public:
+  virtual ~VectorizedGame() = default;
+
+  // The batch owns its episode arrays; no copies.
+  VectorizedGame(const VectorizedGame&) = delete;
+  VectorizedGame& operator=(const VectorizedGame&) = delete;
+
+  // Creates a batch of one of the supported games with its default
+  // parameters: "catch", "tic_tac_toe", "connect_four", or the
+  // simultaneous-move grid games "markov_soccer", "laser_tag" and
+  // "coop_box_pushing". Fatal for any other game; general games belong in
+  // BatchedEnvironment.
+  static std::unique_ptr<VectorizedGame> Make(const std::string& short_name,
+                                              int batch_size, int seed = 0);
+
+  int BatchSize() const { return batch_size_; }
+  int NumPlayers() const { return num_players_; }
+  int NumDistinctActions() const { return num_distinct_actions_; }
+
+  // Actions StepAll consumes per episode: 1 for turn-based games, one per
+  // player for simultaneous-move games.
+  int ActionsPerEpisode() const { return actions_per_episode_; }
+
+  // Flat size of one observation row; the layout of a row matches the
+  // game's normalized vector (the observation tensor where the game
+  // provides one, otherwise its information state tensor).
+  int ObservationSize() const { return observation_size_; }
+
+  bool IsTerminal(int i) const { return terminal_[i] != 0; }
+  Player CurrentPlayer(int i) const {
+    return terminal_[i] != 0 ? kTerminalPlayerId : current_player_[i];
+  }
+
+  // The return of episode i for `player`; zero until the episode ends.
+  double PlayerReturn(int i, Player player) const {
+    return returns_[i * num_players_ + player];
+  }
+
+  // Applies actions[i] to episode i (for simultaneous-move games, the
+  // joint action described above). `actions` must hold
+  // BatchSize() * ActionsPerEpisode() entries; entries for terminal
+  // episodes are ignored (reset them with ResetTerminals before or after
+  // stepping, as the pipeline prefers).
+  virtual void StepAll(const Action* actions) = 0;
+  void StepAll(const std::vector<Action>& actions);
+
+  // Replaces every terminal episode with a fresh one; returns the number
+  // of episodes reset.
+  int ResetTerminals();
+
+  // Restarts every episode from scratch.
+  void ResetAll();
+
+  // Writes episode i's legal action mask (NumDistinctActions() 0/1
+  // entries) into row i * stride of `buffer`; terminal episodes get an
+  // all-zero row. `stride` must be at least NumDistinctActions().
+  virtual void FillLegalMasks(int* buffer, int stride) const = 0;
+
+  // Writes episode i's observation (from its current player's view) into
+  // row i * stride of `buffer`; `stride` must be at least
+  // ObservationSize(). Terminal episodes leave their row untouched, as in
+  // BatchedEnvironment::FillObservations.
+  virtual void FillObservations(double* buffer, int stride) const = 0;
+
+  // As above, from `player`'s view. Games whose tensors do not depend on
+  // the viewer (all the turn-based ones here) serve every player the same
+  // rows; coop_box_pushing swaps its self/other planes.
+  virtual void FillObservations(double* buffer, int stride,
+                                Player player) const {
+    FillObservations(buffer, stride);
+  }
+
+ protected:
+  VectorizedGame(int batch_size, int num_players, int num_distinct_actions,
+                 int observation_size, int seed);
+
+  // Starts episode i from scratch, sampling any initial chance.
+  virtual void ResetEpisode(int i) = 0;
+
+  const int batch_size_;
+  const int num_players_;
+  const int num_distinct_actions_;
+  const int observation_size_;
+  int actions_per_episode_ = 1;  // Simultaneous subclasses set NumPlayers().
+  std::vector<Player> current_player_;
+  std::vector<uint8_t> terminal_;
+  std::vector<double> returns_;  // batch_size_ x num_players_.
+  std::mt19937 rng_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_VECTORIZED_GAME_H_